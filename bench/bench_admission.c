@@ -0,0 +1,250 @@
+/**
+ * @file bench_admission.c
+ * @brief Tick latency of a stream server under a connection stampede
+ *
+ * A server with CAPACITY established clients is hit by OVERLOAD times as
+ * many connections at once, as when every client reconnects at the top
+ * of the second. It then ticks every 100 ms. For every painted client and
+ * tick the latency is the kernel receive timestamp (SO_TIMESTAMPNS) minus
+ * the tick start, so reading the sockets afterwards does not skew it.
+ * Three runs: no stampede, stampede without limits, and stampede with
+ * --max-clients=CAPACITY --accept-rate=CAPACITY. Exits 1 if the limited
+ * run's p99 is more than twice the no-stampede p99 (plus 1 ms).
+ *
+ * Usage: bench_admission [CAPACITY] [OVERLOAD] [TICKS]   (default: 500 10 20)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <binary_clock_stream.h>
+
+#define TICK_US 100000
+
+typedef struct {
+    int fd;
+    bool painted;               // Has been sent a screen, so it gets ticks
+    bool sampled;               // Latency of the current tick recorded
+} bench_client_t;
+
+typedef struct {
+    const char* label;
+    size_t served;
+    uint64_t rejected;
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+} bench_result_t;
+
+static int64_t realtime_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    // Non-blocking: past the listen backlog the connect completes on a SYN retry
+    if (connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0 && errno != EINPROGRESS) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read what a client has; returns the kernel timestamp of the first
+// segment (0 if none), closing the client when the server hung up
+static int64_t drain(bench_client_t* client) {
+    int64_t stamp = 0;
+    for (;;) {
+        char buffer[4096];
+        char control[CMSG_SPACE(sizeof(struct timespec))];
+        struct iovec vector = {buffer, sizeof(buffer)};
+        struct msghdr message = {0};
+        message.msg_iov = &vector;
+        message.msg_iovlen = 1;
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        ssize_t got = recvmsg(client->fd, &message, 0);
+        if (got > 0) {
+            struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+            if (stamp == 0 && header != NULL && header->cmsg_level == SOL_SOCKET &&
+                header->cmsg_type == SO_TIMESTAMPNS) {
+                struct timespec received;
+                memcpy(&received, CMSG_DATA(header), sizeof(received));
+                stamp = (int64_t)received.tv_sec * 1000000000 + received.tv_nsec;
+            }
+            continue;
+        }
+        if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR && errno != ENOTCONN)) {
+            // Turned away (or never got in): no ticks will come
+            close(client->fd);
+            client->fd = -1;
+        }
+        return stamp;
+    }
+}
+
+static int compare_ns(const void* a, const void* b) {
+    int64_t x = *(const int64_t*)a;
+    int64_t y = *(const int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int run(bench_result_t* result, int capacity, int overload, int ticks, bool limited) {
+    binary_clock_stream_server_t server;
+    if (binary_clock_stream_server_open(&server, "127.0.0.1", 0, BINARY_CLOCK_RENDER_EMOJI) != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: cannot start the server\n");
+        return -1;
+    }
+    if (limited) {
+        binary_clock_admit_limits_t limits = {(size_t)capacity, 0, (uint32_t)capacity, (uint32_t)capacity};
+        binary_clock_stream_server_set_limits(&server, &limits);
+    }
+
+    int total = capacity * overload;
+    bench_client_t* clients = calloc((size_t)total, sizeof(*clients));
+    int64_t* samples = calloc((size_t)total * (size_t)ticks, sizeof(*samples));
+    if (clients == NULL || samples == NULL) {
+        return -1;
+    }
+    int64_t epoch = 1700000000LL;
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+    binary_clock_stream_server_tick(&server, &state);
+
+    // Established clients, then the stampede all at once
+    for (int i = 0; i < total; i++) {
+        clients[i].fd = connect_client(server.port);
+        if (clients[i].fd < 0) {
+            fprintf(stderr, "Error: client %d cannot connect: %s\n", i, strerror(errno));
+            return -1;
+        }
+        if (i == capacity - 1) {
+            while (server.client_count < (size_t)capacity) {
+                binary_clock_stream_server_poll(&server, 10);
+            }
+        }
+    }
+
+    size_t count = 0;
+    for (int t = 0; t < ticks; t++) {
+        // Between ticks: accept, turn away, flush; clients read their screens
+        int64_t window_end = realtime_ns() + (int64_t)TICK_US * 1000;
+        while (realtime_ns() < window_end) {
+            binary_clock_stream_server_poll(&server, 1);
+            for (int i = 0; i < total; i++) {
+                if (clients[i].fd >= 0 && drain(&clients[i]) != 0) {
+                    clients[i].painted = true;
+                }
+            }
+        }
+
+        int64_t start = realtime_ns();
+        state = binary_clock_state_from_epoch(++epoch, 0);
+        binary_clock_stream_server_tick(&server, &state);
+        for (int i = 0; i < total; i++) {
+            clients[i].sampled = false;
+        }
+        int64_t give_up = start + (int64_t)TICK_US * 1000;
+        bool waiting = true;
+        while (waiting && realtime_ns() < give_up) {
+            binary_clock_stream_server_poll(&server, 0);
+            waiting = false;
+            for (int i = 0; i < total; i++) {
+                bench_client_t* client = &clients[i];
+                if (client->fd < 0 || !client->painted || client->sampled) {
+                    continue;
+                }
+                int64_t stamp = drain(client);
+                if (stamp != 0) {
+                    samples[count++] = stamp - start;
+                    client->sampled = true;
+                } else {
+                    waiting = true;
+                }
+            }
+        }
+    }
+
+    qsort(samples, count, sizeof(*samples), compare_ns);
+    result->served = server.client_count;
+    result->rejected = server.admit.stats.rejected_full + server.admit.stats.rejected_address +
+                       server.admit.stats.rejected_rate;
+    result->p50_ms = count > 0 ? samples[count / 2] / 1e6 : 0;
+    result->p99_ms = count > 0 ? samples[count * 99 / 100] / 1e6 : 0;
+    result->max_ms = count > 0 ? samples[count - 1] / 1e6 : 0;
+
+    for (int i = 0; i < total; i++) {
+        if (clients[i].fd >= 0) {
+            close(clients[i].fd);
+        }
+    }
+    binary_clock_stream_server_close(&server);
+    free(samples);
+    free(clients);
+    return 0;
+}
+
+static void report(const bench_result_t* result) {
+    printf("  %-26s %6zu served %6llu turned away   p50 %6.2f ms   p99 %6.2f ms   max %6.2f ms\n",
+           result->label, result->served, (unsigned long long)result->rejected,
+           result->p50_ms, result->p99_ms, result->max_ms);
+}
+
+int main(int argc, char* argv[]) {
+    int capacity = argc > 1 ? atoi(argv[1]) : 500;
+    int overload = argc > 2 ? atoi(argv[2]) : 10;
+    int ticks = argc > 3 ? atoi(argv[3]) : 20;
+    if (capacity <= 0 || overload <= 0 || ticks <= 0) {
+        fprintf(stderr, "Usage: %s [CAPACITY] [OVERLOAD] [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    // Both ends of every connection live in this process
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && (rlim_t)capacity * overload * 2 + 16 > limit.rlim_cur) {
+        overload = (int)((limit.rlim_cur - 16) / 2 / (rlim_t)capacity);
+        fprintf(stderr, "Note: open file limit allows %dx overload\n", overload);
+    }
+
+    bench_result_t baseline = {"no stampede", 0, 0, 0, 0, 0};
+    bench_result_t unlimited = {"stampede, no limits", 0, 0, 0, 0, 0};
+    bench_result_t limited = {"stampede, limits", 0, 0, 0, 0, 0};
+    if (run(&baseline, capacity, 1, ticks, false) != 0 ||
+        run(&unlimited, capacity, overload, ticks, false) != 0 ||
+        run(&limited, capacity, overload, ticks, true) != 0) {
+        return 1;
+    }
+
+    printf("=== Stream server tick latency, %d clients, %dx stampede, %d ticks ===\n", capacity, overload, ticks);
+    report(&baseline);
+    report(&unlimited);
+    report(&limited);
+    bool bounded = limited.p99_ms <= 2 * baseline.p99_ms + 1.0;
+    printf("  limited p99 within 2x the no-stampede p99 (+1 ms): %s\n", bounded ? "PASS" : "FAIL");
+    return bounded ? 0 : 1;
+}
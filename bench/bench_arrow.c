@@ -0,0 +1,213 @@
+/**
+ * @file bench_arrow.c
+ * @brief Arrow IPC export vs NDJSON: output size, write and load time
+ *
+ * Exports the same range of seconds as NDJSON (binary_clock_display_json_line)
+ * and as an Arrow IPC file, then loads each back the way a consumer would:
+ * NDJSON is parsed line by line, the Arrow file is memory-mapped and its
+ * columns are read in place.
+ *
+ * Usage: bench_arrow [days]   (default: 7)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+#include <binary_clock_arrow.h>
+
+#define RANGE_START 1700000000LL
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static uint64_t read_le(const uint8_t* data, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= (uint64_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+static size_t fb_field(const uint8_t* buf, size_t table, int id) {
+    size_t vtable = table - (int32_t)read_le(buf + table, 4);
+    uint16_t vtable_size = (uint16_t)read_le(buf + vtable, 2);
+    if ((size_t)(4 + 2 * id) >= vtable_size) {
+        return 0;
+    }
+    uint16_t offset = (uint16_t)read_le(buf + vtable + 4 + 2 * id, 2);
+    return offset ? table + offset : 0;
+}
+
+static size_t fb_deref(const uint8_t* buf, size_t pos) {
+    return pos + (uint32_t)read_le(buf + pos, 4);
+}
+
+static const uint8_t* map_file(const char* path, size_t* size) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        return NULL;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    *size = (size_t)st.st_size;
+    return data;
+}
+
+// Parse every NDJSON line back into a packed LED mask
+static uint64_t load_ndjson(const char* path, long long* rows) {
+    size_t size = 0;
+    const uint8_t* data = map_file(path, &size);
+    uint64_t checksum = 0;
+    *rows = 0;
+    if (data == NULL) {
+        return 0;
+    }
+
+    const char* cursor = (const char*)data;
+    const char* end = cursor + size;
+    while (cursor < end) {
+        const char* line_end = memchr(cursor, '\n', (size_t)(end - cursor));
+        if (line_end == NULL) {
+            line_end = end;
+        }
+
+        const char* bits = strstr(cursor, "\"binary\"");
+        uint32_t packed = 0;
+        int digit_value = 0;
+        for (const char* p = bits; p != NULL && p < line_end; p++) {
+            if (*p == '[') {
+                digit_value = 0;
+            } else if (*p == '0' || *p == '1') {
+                digit_value = digit_value * 2 + (*p - '0');
+            } else if (*p == ']') {
+                packed = (packed << 4) | (uint32_t)digit_value;
+            }
+        }
+        checksum += packed + (uint64_t)strtoll(cursor + 13, NULL, 10);
+        (*rows)++;
+        cursor = line_end + 1;
+    }
+
+    munmap((void*)data, size);
+    return checksum;
+}
+
+// Memory-map the Arrow file and read the epoch and leds columns in place
+static uint64_t load_arrow(const char* path, long long* rows) {
+    size_t size = 0;
+    const uint8_t* data = map_file(path, &size);
+    uint64_t checksum = 0;
+    *rows = 0;
+    if (data == NULL) {
+        return 0;
+    }
+
+    uint32_t footer_size = (uint32_t)read_le(data + size - 10, 4);
+    const uint8_t* footer = data + size - 10 - footer_size;
+    size_t root = fb_deref(footer, 0);
+    size_t blocks = fb_deref(footer, fb_field(footer, root, 3));
+    uint32_t block_count = (uint32_t)read_le(footer + blocks, 4);
+
+    for (uint32_t i = 0; i < block_count; i++) {
+        const uint8_t* block = footer + blocks + 4 + 24 * i;
+        size_t offset = (size_t)read_le(block, 8);
+        uint32_t metadata_length = (uint32_t)read_le(block + 8, 4);
+        const uint8_t* meta = data + offset + 8;
+        const uint8_t* body = data + offset + metadata_length;
+
+        size_t message = fb_deref(meta, 0);
+        size_t batch = fb_deref(meta, fb_field(meta, message, 2));
+        int64_t length = (int64_t)read_le(meta + fb_field(meta, batch, 0), 8);
+        size_t buffers = fb_deref(meta, fb_field(meta, batch, 2));
+
+        const int64_t* epochs = (const int64_t*)(body + read_le(meta + buffers + 4 + 16 * 1, 8));
+        const uint32_t* leds = (const uint32_t*)(body + read_le(meta + buffers + 4 + 16 * 3, 8));
+        for (int64_t row = 0; row < length; row++) {
+            checksum += leds[row] + (uint64_t)epochs[row];
+        }
+        *rows += length;
+    }
+
+    munmap((void*)data, size);
+    return checksum;
+}
+
+static long file_size(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+int main(int argc, char* argv[]) {
+    long days = argc > 1 ? strtol(argv[1], NULL, 10) : 7;
+    long long range_end = RANGE_START + days * 86400LL;
+    char ndjson_path[] = "/tmp/bench_arrow_ndjson_XXXXXX";
+    char arrow_path[] = "/tmp/bench_arrow_file_XXXXXX";
+    long long ndjson_rows = 0;
+    long long arrow_rows = 0;
+
+    int ndjson_fd = mkstemp(ndjson_path);
+    int arrow_fd = mkstemp(arrow_path);
+    if (ndjson_fd < 0 || arrow_fd < 0) {
+        fprintf(stderr, "Error: failed to create temporary files\n");
+        return 1;
+    }
+
+    printf("=== Arrow IPC vs NDJSON (%ld days, %lld rows) ===\n", days, range_end - RANGE_START);
+
+    FILE* ndjson = fdopen(ndjson_fd, "wb");
+    double start = now_seconds();
+    for (long long epoch = RANGE_START; epoch < range_end; epoch++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+        binary_clock_display_json_line(&state, ndjson);
+    }
+    fclose(ndjson);
+    double ndjson_write = now_seconds() - start;
+
+    FILE* arrow = fdopen(arrow_fd, "wb");
+    start = now_seconds();
+    binary_clock_error_t error = binary_clock_arrow_write_range(arrow, RANGE_START, range_end, 0,
+                                                                BINARY_CLOCK_ARROW_FILE, 0);
+    fclose(arrow);
+    double arrow_write = now_seconds() - start;
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
+        return 1;
+    }
+
+    start = now_seconds();
+    uint64_t ndjson_checksum = load_ndjson(ndjson_path, &ndjson_rows);
+    double ndjson_load = now_seconds() - start;
+
+    start = now_seconds();
+    uint64_t arrow_checksum = load_arrow(arrow_path, &arrow_rows);
+    double arrow_load = now_seconds() - start;
+
+    printf("%-8s %14s %12s %12s %12s\n", "format", "bytes", "bytes/row", "write ms", "load ms");
+    printf("%-8s %14ld %12.2f %12.2f %12.2f\n", "ndjson", file_size(ndjson_path),
+           (double)file_size(ndjson_path) / (double)ndjson_rows, ndjson_write * 1e3, ndjson_load * 1e3);
+    printf("%-8s %14ld %12.2f %12.2f %12.2f\n", "arrow", file_size(arrow_path),
+           (double)file_size(arrow_path) / (double)arrow_rows, arrow_write * 1e3, arrow_load * 1e3);
+    printf("Rows match: %s, checksums match: %s\n",
+           ndjson_rows == arrow_rows ? "yes" : "NO",
+           ndjson_checksum == arrow_checksum ? "yes" : "NO");
+
+    unlink(ndjson_path);
+    unlink(arrow_path);
+    return (ndjson_rows == arrow_rows && ndjson_checksum == arrow_checksum) ? 0 : 1;
+}
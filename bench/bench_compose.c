@@ -0,0 +1,148 @@
+/**
+ * @file bench_compose.c
+ * @brief State construction: arithmetic, composed tables and a full table
+ *
+ * Builds states and packed LED masks for seconds of the day visited in
+ * order and at random, with the arithmetic path of the core API, the
+ * two-level composition tables of the table kernel (about 400 bytes) and
+ * a full table holding every second of the day. The full tables are
+ * far larger than L1, and the state one is larger than L2 on small cores,
+ * so random visits miss where the composition tables keep hitting.
+ *
+ * Usage: bench_compose [ROUNDS]   (default: 20 passes over the day)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <binary_clock_tune.h>
+
+#define DAY 86400
+#define BASE_EPOCH 1699920000LL  // A midnight UTC
+
+static binary_clock_state_t* state_table;
+static uint32_t* packed_table;
+static volatile uint64_t sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t state_digest(const binary_clock_state_t* state) {
+    return (uint64_t)state->hours_units.decimal_value + state->minutes_tens.bits[1] + state->seconds_units.bits[3] +
+           (uint64_t)state->timestamp;
+}
+
+static uint64_t arithmetic_state(int32_t second) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + second, 0);
+    return state_digest(&state);
+}
+
+static uint64_t from_time_state(int32_t second) {
+    time_components_t time_comp = {(uint8_t)(second / 3600), (uint8_t)(second / 60 % 60), (uint8_t)(second % 60)};
+    binary_clock_state_t state = binary_clock_state_from_time(&time_comp);
+    return state_digest(&state);
+}
+
+static uint64_t composed_state(int32_t second) {
+    binary_clock_state_t state = binary_clock_tune_state_from_epoch_table(BASE_EPOCH + second, 0);
+    return state_digest(&state);
+}
+
+static uint64_t full_table_state(int32_t second) {
+    binary_clock_state_t state = state_table[second];
+    state.timestamp = (binary_clock_time_t)(BASE_EPOCH + second);
+    return state_digest(&state);
+}
+
+static uint64_t arithmetic_packed(int32_t second) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + second, 0);
+    return binary_clock_pack_state(&state);
+}
+
+static uint64_t composed_packed(int32_t second) {
+    return binary_clock_tune_packed_from_epoch(BASE_EPOCH + second, 0);
+}
+
+static uint64_t full_table_packed(int32_t second) {
+    return packed_table[second];
+}
+
+static double measure(uint64_t (*build)(int32_t), const int32_t* order, int rounds) {
+    uint64_t total = 0;
+    double start = now_ns();
+    for (int round = 0; round < rounds; round++) {
+        for (int i = 0; i < DAY; i++) {
+            total += build(order[i]);
+        }
+    }
+    double elapsed = now_ns() - start;
+    sink += total;
+    return elapsed / ((double)rounds * DAY);
+}
+
+static void report(const char* name, size_t bytes, uint64_t (*build)(int32_t),
+                   const int32_t* sequential, const int32_t* random, int rounds) {
+    double in_order = measure(build, sequential, rounds);
+    double shuffled = measure(build, random, rounds);
+    printf("  %-30s %9lu B  %6.2f ns  %6.2f ns\n", name, (unsigned long)bytes, in_order, shuffled);
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 20;
+    int32_t* sequential = malloc(DAY * sizeof(int32_t));
+    int32_t* random = malloc(DAY * sizeof(int32_t));
+    state_table = malloc(DAY * sizeof(binary_clock_state_t));
+    packed_table = malloc(DAY * sizeof(uint32_t));
+    if (rounds <= 0 || sequential == NULL || random == NULL || state_table == NULL || packed_table == NULL) {
+        fprintf(stderr, "Usage: %s [ROUNDS]\n", argv[0]);
+        return 1;
+    }
+
+    uint64_t seed = 12345;
+    for (int i = 0; i < DAY; i++) {
+        sequential[i] = i;
+        random[i] = i;
+        state_table[i] = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+        packed_table[i] = binary_clock_pack_state(&state_table[i]);
+    }
+    for (int i = DAY - 1; i > 0; i--) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        int j = (int)((seed >> 33) % (uint64_t)(i + 1));
+        int32_t swap = random[i];
+        random[i] = random[j];
+        random[j] = swap;
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < DAY; i++) {
+        mismatches += composed_packed(i) != packed_table[i];
+    }
+    if (mismatches != 0) {
+        fprintf(stderr, "composed tables disagree with the arithmetic path on %d seconds\n", mismatches);
+        return 1;
+    }
+
+    printf("=== State construction, %d passes over a day ===\n", rounds);
+    printf("  %-30s %11s  %9s  %9s\n", "", "tables", "in order", "random");
+    report("state: state_from_time()", 0, from_time_state, sequential, random, rounds);
+    report("state: state_from_epoch()", 0, arithmetic_state, sequential, random, rounds);
+    report("state: composed tables", binary_clock_tune_convert_table_size(), composed_state,
+           sequential, random, rounds);
+    report("state: full table", DAY * sizeof(binary_clock_state_t), full_table_state, sequential, random, rounds);
+    report("LED mask: pack_state()", 0, arithmetic_packed, sequential, random, rounds);
+    report("LED mask: composed tables", binary_clock_tune_convert_table_size(), composed_packed,
+           sequential, random, rounds);
+    report("LED mask: full table", DAY * sizeof(uint32_t), full_table_packed, sequential, random, rounds);
+    printf("  (state_from_time() also reads the wall clock for the timestamp)\n");
+
+    free(packed_table);
+    free(state_table);
+    free(random);
+    free(sequential);
+    return 0;
+}
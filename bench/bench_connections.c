@@ -0,0 +1,151 @@
+/**
+ * @file bench_connections.c
+ * @brief Memory per idle connection on the stream server
+ *
+ * Connects N loopback clients that never read, ticks the server a few
+ * times, and reports what each connection costs
+ * this process: the server's own accounting of client slots, poll set
+ * and frame slabs, the malloc heap growth (glibc), and the resident set
+ * growth. Kernel socket memory is not included. Exits 1 if the server's
+ * accounting exceeds the 512-byte budget per connection.
+ *
+ * Usage: bench_connections [CLIENTS] [TICKS]   (default: 9000 clients, 30 ticks)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <binary_clock_stream.h>
+#ifdef __GLIBC__
+    #include <malloc.h>
+#endif
+
+#define BUDGET_BYTES 512
+
+// Bytes malloc has handed out, where the C library reports it
+static long long heap_bytes(void) {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return (long long)info.uordblks + (long long)info.hblkhd;
+#else
+    return -1;
+#endif
+}
+
+static long long resident_bytes(void) {
+    FILE* statm = fopen("/proc/self/statm", "r");
+    long long size = 0;
+    long long resident = -1;
+    if (statm != NULL) {
+        if (fscanf(statm, "%lld %lld", &size, &resident) != 2) {
+            resident = -1;
+        }
+        fclose(statm);
+    }
+    return resident < 0 ? -1 : resident * sysconf(_SC_PAGESIZE);
+}
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+static void report(const char* label, long long before, long long after, int count) {
+    if (before < 0 || after < 0) {
+        printf("  %-18s n/a\n", label);
+    } else {
+        printf("  %-18s %8.1f B/connection\n", label, (double)(after - before) / count);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 9000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 30;
+    if (count <= 0 || ticks <= 0) {
+        fprintf(stderr, "Usage: %s [CLIENTS] [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    // Both ends of every connection live in this process
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && (rlim_t)count * 2 + 16 > limit.rlim_cur) {
+        count = (int)((limit.rlim_cur - 16) / 2);
+        fprintf(stderr, "Note: open file limit allows %d clients\n", count);
+    }
+
+    int* fds = calloc((size_t)count, sizeof(int));
+    binary_clock_stream_server_t server;
+    if (fds == NULL ||
+        binary_clock_stream_server_open(&server, "127.0.0.1", 0, BINARY_CLOCK_RENDER_EMOJI) != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: cannot start the server\n");
+        return 1;
+    }
+    binary_clock_state_t state = binary_clock_state_from_epoch(1700000000LL, 0);
+    binary_clock_stream_server_tick(&server, &state);
+    long long heap_before = heap_bytes();
+    long long resident_before = resident_bytes();
+    size_t server_before = binary_clock_stream_server_memory(&server);
+
+    for (int i = 0; i < count; i++) {
+        fds[i] = connect_client(server.port);
+        if (fds[i] < 0) {
+            fprintf(stderr, "Error: client %d cannot connect: %s\n", i, strerror(errno));
+            return 1;
+        }
+        if (i % 128 == 127 || i == count - 1) {
+            binary_clock_stream_server_poll(&server, 0);
+        }
+    }
+    while (server.client_count < (size_t)count) {
+        binary_clock_stream_server_poll(&server, 10);
+    }
+
+    // The clients never read: ticks pile up in their socket buffers
+    for (int t = 1; t <= ticks; t++) {
+        state = binary_clock_state_from_epoch(1700000000LL + t, 0);
+        binary_clock_stream_server_tick(&server, &state);
+        binary_clock_stream_server_poll(&server, 0);
+    }
+
+    size_t server_after = binary_clock_stream_server_memory(&server);
+    double per_connection = (double)(server_after - server_before) / count;
+    printf("=== Stream server memory, %d idle connections, %d ticks ===\n", count, ticks);
+    printf("  client slot:       %8zu B (+ %zu B poll entry)\n", sizeof(binary_clock_stream_client_t),
+           sizeof(struct pollfd));
+    printf("  server accounting: %8.1f B/connection (%zu slots, %zu B in frame slabs)\n", per_connection,
+           server.client_capacity, server.pool.bytes);
+    report("malloc heap:", heap_before, heap_bytes(), count);
+    report("resident set:", resident_before, resident_bytes(), count);
+    printf("  budget:            %8d B/connection: %s\n", BUDGET_BYTES,
+           per_connection < BUDGET_BYTES ? "PASS" : "FAIL");
+
+    for (int i = 0; i < count; i++) {
+        close(fds[i]);
+    }
+    binary_clock_stream_server_close(&server);
+    free(fds);
+    return per_connection < BUDGET_BYTES ? 0 : 1;
+}
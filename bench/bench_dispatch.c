@@ -0,0 +1,111 @@
+/**
+ * @file bench_dispatch.c
+ * @brief Display dispatch: callbacks doing their own I/O against gathered slices
+ *
+ * Registers N displays that all go to one pipe (drained by a forked
+ * consumer) and dispatches ticks two ways:
+ * - function callbacks, each rendering and write()ing its own frame
+ * - buffer callbacks, whose slices the dispatcher sends with one writev()
+ * and reports time and system calls per tick.
+ *
+ * Usage: bench_dispatch [TICKS]   (default: 200000 ticks)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <binary_clock_display.h>
+
+#define BASE_EPOCH 1700000000LL
+
+static int sink_fd = -1;
+static uint64_t function_writes = 0;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Fork a consumer that reads the pipe to the end; returns the write end
+static int start_consumer(pid_t* pid) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    *pid = fork();
+    if (*pid == 0) {
+        close(fds[1]);
+        static char buffer[1024 * 1024];
+        while (read(fds[0], buffer, sizeof(buffer)) > 0) {
+        }
+        _exit(0);
+    }
+    close(fds[0]);
+    return fds[1];
+}
+
+static void write_own_frame(const binary_clock_state_t* state, void* context) {
+    (void)context;
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = binary_clock_display_render(state, BINARY_CLOCK_RENDER_COMPACT, frame, sizeof(frame));
+    if (write(sink_fd, frame, length) == (ssize_t)length) {
+        function_writes++;
+    }
+}
+
+static size_t render_slice(const binary_clock_state_t* state, void* context, char* buffer, size_t size,
+                           int* sink) {
+    (void)context;
+    *sink = sink_fd;
+    return binary_clock_display_render(state, BINARY_CLOCK_RENDER_COMPACT, buffer, size);
+}
+
+static void run(const char* name, int displays, bool gathered, long ticks) {
+    pid_t pid = 0;
+    sink_fd = start_consumer(&pid);
+    int ids[16];
+    for (int i = 0; i < displays; i++) {
+        ids[i] = gathered ? binary_clock_display_register_buffer(render_slice, NULL)
+                          : binary_clock_display_register(write_own_frame, NULL);
+    }
+
+    function_writes = 0;
+    binary_clock_display_dispatch_stats_t before = binary_clock_display_get_dispatch_stats();
+    double start = now_ns();
+    for (long i = 0; i < ticks; i++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+        binary_clock_display_update_all_with_state(&state);
+    }
+    double elapsed = now_ns() - start;
+    binary_clock_display_dispatch_stats_t after = binary_clock_display_get_dispatch_stats();
+    uint64_t calls = gathered ? after.system_calls - before.system_calls : function_writes;
+
+    for (int i = 0; i < displays; i++) {
+        binary_clock_display_unregister(ids[i]);
+    }
+    close(sink_fd);
+    waitpid(pid, NULL, 0);
+    printf("  %-2d displays  %-28s %8.0f ns/tick  %6.2f syscalls/tick\n", displays, name, elapsed / ticks,
+           (double)calls / ticks);
+}
+
+int main(int argc, char* argv[]) {
+    long ticks = argc > 1 ? atol(argv[1]) : 200000;
+    if (ticks <= 0) {
+        fprintf(stderr, "Usage: %s [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    printf("=== %ld ticks of compact frames into one pipe ===\n", ticks);
+    static const int counts[] = {1, 4, 16};
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        run("function callbacks, write()", counts[c], false, ticks);
+        run("buffer callbacks, writev()", counts[c], true, ticks);
+    }
+    return 0;
+}
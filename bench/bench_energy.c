@@ -0,0 +1,333 @@
+/**
+ * @file bench_energy.c
+ * @brief Energy and wakeups per hour for long-running CLI configurations
+ *
+ * Runs one long-running CLI configuration (e.g. `binary_clock --loop`) for a
+ * fixed period with stdout discarded and reports, scaled to one hour:
+ * - Joules from the Linux powercap RAPL package counters, when readable
+ *   (system-wide: keep the machine otherwise idle)
+ * - Wakeups of the process, from /proc/PID/schedstat (timeslices run)
+ * - Voluntary/involuntary context switches and CPU time, from wait4()
+ *
+ * With --idle-client, a server mode started on port 0 is found through
+ * /proc (its listening socket) and one client holds a connection open for
+ * the whole run, sending nothing and discarding whatever it is sent.
+ *
+ * Usage: bench_energy BINARY [SECONDS] [--idle-client] [-- ARGS...]   (default: 10 seconds)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define MAX_RAPL_DOMAINS 16
+#define LISTEN_WAIT_SECONDS 2.0
+
+/**
+ * @brief One RAPL package domain and its counter wrap range
+ */
+typedef struct {
+    char path[256];
+    unsigned long long max_range;
+} rapl_domain_t;
+
+static rapl_domain_t rapl_domains[MAX_RAPL_DOMAINS];
+static int rapl_domain_count = 0;
+
+static int read_ull(const char* path, unsigned long long* value) {
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    int ok = fscanf(file, "%llu", value) == 1;
+    fclose(file);
+    return ok ? 0 : -1;
+}
+
+// Package-level domains only (intel-rapl:N), sub-domains are included in them
+static void rapl_discover(void) {
+    glob_t matches;
+    if (glob("/sys/class/powercap/intel-rapl:[0-9]*", 0, NULL, &matches) != 0) {
+        return;
+    }
+    for (size_t i = 0; i < matches.gl_pathc && rapl_domain_count < MAX_RAPL_DOMAINS; i++) {
+        const char* name = strrchr(matches.gl_pathv[i], '/') + 1;
+        unsigned long long energy;
+        rapl_domain_t* domain = &rapl_domains[rapl_domain_count];
+        char range_path[300];
+
+        if (strchr(name + strlen("intel-rapl:"), ':') != NULL) {
+            continue; // Sub-domain such as intel-rapl:0:0
+        }
+        snprintf(domain->path, sizeof(domain->path), "%s/energy_uj", matches.gl_pathv[i]);
+        snprintf(range_path, sizeof(range_path), "%s/max_energy_range_uj", matches.gl_pathv[i]);
+        if (read_ull(domain->path, &energy) != 0 || read_ull(range_path, &domain->max_range) != 0) {
+            continue; // Present but not readable (usually needs root)
+        }
+        rapl_domain_count++;
+    }
+    globfree(&matches);
+}
+
+static void rapl_sample(unsigned long long* samples) {
+    for (int i = 0; i < rapl_domain_count; i++) {
+        if (read_ull(rapl_domains[i].path, &samples[i]) != 0) {
+            samples[i] = 0;
+        }
+    }
+}
+
+static double rapl_joules(const unsigned long long* before, const unsigned long long* after) {
+    double micro_joules = 0.0;
+    for (int i = 0; i < rapl_domain_count; i++) {
+        if (after[i] >= before[i]) {
+            micro_joules += (double)(after[i] - before[i]);
+        } else {
+            micro_joules += (double)(rapl_domains[i].max_range - before[i] + after[i]); // Wrapped
+        }
+    }
+    return micro_joules / 1e6;
+}
+
+// Third field of /proc/PID/schedstat: number of timeslices run (wakeups)
+static long long read_wakeups(pid_t pid) {
+    char path[64];
+    unsigned long long run_ns, wait_ns, slices;
+    snprintf(path, sizeof(path), "/proc/%d/schedstat", (int)pid);
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return -1;
+    }
+    int fields = fscanf(file, "%llu %llu %llu", &run_ns, &wait_ns, &slices);
+    fclose(file);
+    return fields == 3 ? (long long)slices : -1;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int owns_socket(pid_t pid, unsigned long inode) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/fd", (int)pid);
+    DIR* fds = opendir(path);
+    if (fds == NULL) {
+        return 0;
+    }
+    char expected[48];
+    snprintf(expected, sizeof(expected), "socket:[%lu]", inode);
+    int found = 0;
+    struct dirent* entry;
+    while (!found && (entry = readdir(fds)) != NULL) {
+        char fd_path[320];
+        char target[64];
+        snprintf(fd_path, sizeof(fd_path), "%s/%s", path, entry->d_name);
+        ssize_t length = readlink(fd_path, target, sizeof(target) - 1);
+        if (length > 0) {
+            target[length] = '\0';
+            found = strcmp(target, expected) == 0;
+        }
+    }
+    closedir(fds);
+    return found;
+}
+
+// Port of an IPv4 TCP socket the process listens on, 0 if none (yet).
+// /proc/PID/net/tcp lists the whole namespace: match socket inodes to PID.
+static unsigned listening_port(pid_t pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/net/tcp", (int)pid);
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return 0;
+    }
+    char line[512];
+    unsigned found = 0;
+    while (found == 0 && fgets(line, sizeof(line), file) != NULL) {
+        unsigned port, state;
+        unsigned long inode;
+        // sl: local rem st tx:rx tr:when retrnsmt uid timeout inode
+        if (sscanf(line, " %*d: %*x:%x %*x:%*x %x %*s %*s %*s %*s %*s %lu", &port, &state, &inode) == 3 &&
+            state == 0x0A && owns_socket(pid, inode)) {
+            found = port;
+        }
+    }
+    fclose(file);
+    return found;
+}
+
+static int connect_idle_client(pid_t pid, unsigned* port) {
+    double deadline = now_seconds() + LISTEN_WAIT_SECONDS;
+    struct timespec retry = {0, 10000000};
+    while ((*port = listening_port(pid)) == 0 && now_seconds() < deadline) {
+        nanosleep(&retry, NULL);
+    }
+    if (*port == 0) {
+        return -1;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)*port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+// Wait until the deadline, draining the client (if any) so a streaming
+// server never backs up on it; returns the bytes it was sent
+static unsigned long long hold_until(double deadline, int client) {
+    unsigned long long received = 0;
+    double remaining;
+    while ((remaining = deadline - now_seconds()) > 0) {
+        if (client < 0) {
+            struct timespec period = {(time_t)remaining, (long)((remaining - (double)(time_t)remaining) * 1e9)};
+            nanosleep(&period, NULL);
+            continue;
+        }
+        struct pollfd entry = {client, POLLIN, 0};
+        if (poll(&entry, 1, (int)(remaining * 1000) + 1) > 0) {
+            char buffer[4096];
+            ssize_t got = read(client, buffer, sizeof(buffer));
+            if (got <= 0) {
+                close(client); // Closed by the server: sleep out the rest
+                client = -1;
+            } else {
+                received += (unsigned long long)got;
+            }
+        }
+    }
+    if (client >= 0) {
+        close(client);
+    }
+    return received;
+}
+
+static int measure(char* const command[], double seconds, int idle_client) {
+    unsigned long long energy_before[MAX_RAPL_DOMAINS];
+    unsigned long long energy_after[MAX_RAPL_DOMAINS];
+    struct rusage usage;
+    int status;
+
+    rapl_sample(energy_before);
+    double start = now_seconds();
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    if (pid == 0) {
+        // Child: exec the CLI with stdout on /dev/null so terminal cost is excluded
+        int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDOUT_FILENO);
+            close(null_fd);
+        }
+        execv(command[0], command);
+        _exit(127);
+    }
+
+    unsigned port = 0;
+    int client = idle_client ? connect_idle_client(pid, &port) : -1;
+    // Sample wakeups just before stopping; schedstat vanishes on exit
+    unsigned long long received = hold_until(start + seconds, client);
+    long long wakeups = read_wakeups(pid);
+    kill(pid, SIGTERM);
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        perror("wait4");
+        return -1;
+    }
+
+    double elapsed = now_seconds() - start;
+    rapl_sample(energy_after);
+    double per_hour = 3600.0 / elapsed;
+    double cpu = (double)usage.ru_utime.tv_sec + (double)usage.ru_utime.tv_usec / 1e6 +
+                 (double)usage.ru_stime.tv_sec + (double)usage.ru_stime.tv_usec / 1e6;
+
+    printf("=== Energy per hour: %s", command[0]);
+    for (int i = 1; command[i] != NULL; i++) {
+        printf(" %s", command[i]);
+    }
+    printf(" (%.1fs) ===\n", elapsed);
+    if (rapl_domain_count > 0) {
+        printf("  energy           %10.1f J/hour (system-wide, %d RAPL domain%s)\n",
+               rapl_joules(energy_before, energy_after) * per_hour, rapl_domain_count,
+               rapl_domain_count == 1 ? "" : "s");
+    } else {
+        printf("  energy                  n/a (RAPL counters not readable)\n");
+    }
+    if (wakeups >= 0) {
+        printf("  wakeups          %10.0f /hour\n", (double)wakeups * per_hour);
+    } else {
+        printf("  wakeups                 n/a (/proc schedstat not available)\n");
+    }
+    printf("  context switches %10.0f /hour (%ld voluntary, %ld involuntary)\n",
+           (double)(usage.ru_nvcsw + usage.ru_nivcsw) * per_hour, usage.ru_nvcsw, usage.ru_nivcsw);
+    printf("  cpu time         %10.3f s/hour\n", cpu * per_hour);
+    if (idle_client && client >= 0) {
+        printf("  idle client      127.0.0.1:%u (%llu bytes received)\n", port, received);
+    } else if (idle_client) {
+        printf("  idle client             n/a (no listening TCP socket found)\n");
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s BINARY [SECONDS] [--idle-client] [-- ARGS...]\n", argv[0]);
+        return 1;
+    }
+
+    double seconds = 10.0;
+    int idle_client = 0;
+    int arg_start = argc;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--") == 0) {
+            arg_start = i + 1;
+            break;
+        }
+        if (strcmp(argv[i], "--idle-client") == 0) {
+            idle_client = 1;
+        } else {
+            seconds = atof(argv[i]);
+        }
+    }
+
+    // Child argv: binary followed by everything after "--"
+    char** child_argv = calloc((size_t)(argc - arg_start + 2), sizeof(char*));
+    if (child_argv == NULL || seconds <= 0.0) {
+        fprintf(stderr, "Error: invalid arguments or out of memory\n");
+        return 1;
+    }
+    child_argv[0] = argv[1];
+    for (int i = arg_start; i < argc; i++) {
+        child_argv[i - arg_start + 1] = argv[i];
+    }
+
+    rapl_discover();
+    int result = measure(child_argv, seconds, idle_client);
+    free(child_argv);
+    return result == 0 ? 0 : 1;
+}
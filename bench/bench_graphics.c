@@ -0,0 +1,111 @@
+/**
+ * @file bench_graphics.c
+ * @brief Graphics ticks: kitty placements and sixel glyphs against emoji repaints
+ *
+ * Encodes a run of consecutive seconds three ways and writes them to
+ * /dev/null (or the file given):
+ * - emoji: the loop's frame, a screen clear and every LED as an emoji
+ * - kitty: placements and deletions of the uploaded LED images that changed
+ * - sixel: the cached glyph of every LED that changed
+ * and reports the one-time setup bytes, bytes and time per tick, and LEDs
+ * drawn per tick. Bytes are what the terminal (or an ssh session in front
+ * of it) has to carry and parse every second.
+ *
+ * Usage: bench_graphics [TICKS [OUTPUT]]   (default: 86400 ticks, /dev/null)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <binary_clock_display.h>
+#include <binary_clock_graphics.h>
+
+#define BASE_EPOCH 1700006400LL  // Midnight UTC
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written <= 0) {
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+static void run_graphics(const char* name, binary_clock_graphics_protocol_t protocol, int fd, long ticks) {
+    static binary_clock_graphics_t graphics;
+    static char output[BINARY_CLOCK_GRAPHICS_BEGIN_SIZE];
+    binary_clock_graphics_init(&graphics, protocol);
+    size_t setup = binary_clock_graphics_begin(&graphics, output, sizeof(output));
+    write_all(fd, output, setup);
+
+    // The first tick draws every LED: count it with the setup
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    size_t length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+    write_all(fd, output, length);
+    setup += length;
+    binary_clock_graphics_stats_t before = graphics.stats;
+
+    double start = now_ns();
+    for (long i = 1; i <= ticks; i++) {
+        state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+        length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+        write_all(fd, output, length);
+    }
+    double elapsed = now_ns() - start;
+    printf("  %-8s %8lu %12.1f %12.0f %12.2f\n", name, (unsigned long)setup,
+           (double)(graphics.stats.bytes - before.bytes) / ticks, elapsed / ticks,
+           (double)(graphics.stats.leds_drawn - before.leds_drawn) / ticks);
+}
+
+int main(int argc, char* argv[]) {
+    long ticks = argc > 1 ? atol(argv[1]) : 86400;
+    const char* path = argc > 2 ? argv[2] : "/dev/null";
+    if (ticks <= 0) {
+        fprintf(stderr, "Usage: %s [TICKS [OUTPUT]]\n", argv[0]);
+        return 1;
+    }
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 1;
+    }
+
+    printf("=== %ld clock ticks from midnight into %s ===\n", ticks, path);
+    printf("  %-8s %8s %12s %12s %12s\n", "display", "setup", "bytes/tick", "ns/tick", "LEDs/tick");
+
+    // The emoji loop clears the screen and renders the whole frame
+    static const char clear[] = "\033[2J\033[H";
+    char frame[sizeof(clear) + BINARY_CLOCK_RENDER_MAX_SIZE];
+    uint64_t bytes = 0;
+    double start = now_ns();
+    for (long i = 1; i <= ticks; i++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+        memcpy(frame, clear, sizeof(clear) - 1);
+        size_t length = sizeof(clear) - 1 + binary_clock_display_render(&state, BINARY_CLOCK_RENDER_EMOJI,
+                                                                         frame + sizeof(clear) - 1,
+                                                                         BINARY_CLOCK_RENDER_MAX_SIZE);
+        write_all(fd, frame, length);
+        bytes += length;
+    }
+    double elapsed = now_ns() - start;
+    printf("  %-8s %8d %12.1f %12.0f %12.2f\n", "emoji", 0, (double)bytes / ticks, elapsed / ticks,
+           (double)BINARY_CLOCK_GRAPHICS_LEDS);
+
+    run_graphics("kitty", BINARY_CLOCK_GRAPHICS_KITTY, fd, ticks);
+    run_graphics("sixel", BINARY_CLOCK_GRAPHICS_SIXEL, fd, ticks);
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,287 @@
+/**
+ * @file bench_h2.c
+ * @brief /at queries over HTTP/1.1 connections against HTTP/2 streams
+ *
+ * Runs both servers in-process on loopback and sends the same /at queries:
+ * - HTTP/1.1: one connection per request, as the query server closes
+ *   each connection after its response
+ * - HTTP/2: one connection, up to 64 concurrent streams per batch
+ * then opens 64 /ticks streams and times the tick fan-out, which renders
+ * one payload per (zone, format) and frames it once per stream.
+ *
+ * Usage: bench_h2 [REQUESTS]   (default: 20000)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <binary_clock_h2.h>
+
+#define BASE_EPOCH 1700000000LL
+#define TICKS 2000
+
+static const char* const formats[] = {"json", "ndjson", "emoji", "binary"};
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int connect_loopback(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+static int target_of(long i, char* target, size_t size) {
+    return snprintf(target, size, "/at?t=%lld&fmt=%s", BASE_EPOCH + i % 3600, formats[i % 4]);
+}
+
+// One connection per request; returns response bytes received
+static uint64_t run_http1(binary_clock_query_t* query, long requests) {
+    binary_clock_query_server_t server;
+    if (binary_clock_query_server_open(&server, query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        return 0;
+    }
+    uint64_t bytes = 0;
+    char request[256];
+    char response[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE];
+    for (long i = 0; i < requests; i++) {
+        int fd = connect_loopback(server.port);
+        if (fd < 0) {
+            break;
+        }
+        char target[128];
+        target_of(i, target, sizeof(target));
+        int length = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: bench\r\n\r\n", target);
+        send(fd, request, (size_t)length, 0);
+        for (;;) {
+            binary_clock_query_server_poll(&server, 0);
+            ssize_t got = recv(fd, response, sizeof(response), 0);
+            if (got > 0) {
+                bytes += (uint64_t)got;
+            } else if (got == 0) {
+                break;
+            }
+        }
+        close(fd);
+    }
+    binary_clock_query_server_close(&server);
+    return bytes;
+}
+
+// Frames read off an HTTP/2 connection, counting ended streams
+typedef struct {
+    int fd;
+    size_t length;
+    uint64_t bytes;
+    long ended;
+    long data_frames;
+    uint8_t buffer[1 << 17];
+} h2_client_t;
+
+static void h2_read(h2_client_t* client) {
+    for (;;) {
+        ssize_t got = recv(client->fd, client->buffer + client->length, sizeof(client->buffer) - client->length, 0);
+        if (got <= 0) {
+            break;
+        }
+        client->length += (size_t)got;
+        client->bytes += (uint64_t)got;
+    }
+    size_t position = 0;
+    while (client->length - position >= BINARY_CLOCK_H2_FRAME_HEADER_SIZE) {
+        binary_clock_h2_frame_t frame = binary_clock_h2_frame_read(client->buffer + position);
+        if (client->length - position < BINARY_CLOCK_H2_FRAME_HEADER_SIZE + frame.length) {
+            break;
+        }
+        if (frame.type == BINARY_CLOCK_H2_DATA) {
+            client->data_frames++;
+            client->ended += (frame.flags & BINARY_CLOCK_H2_FLAG_END_STREAM) != 0;
+        }
+        position += BINARY_CLOCK_H2_FRAME_HEADER_SIZE + frame.length;
+    }
+    memmove(client->buffer, client->buffer + position, client->length - position);
+    client->length -= position;
+}
+
+static void h2_send_request(uint8_t* output, size_t* length, uint32_t stream, const char* path) {
+    uint8_t* frame = output + *length;
+    uint8_t* block = frame + BINARY_CLOCK_H2_FRAME_HEADER_SIZE;
+    size_t size = 256;
+    size_t block_length = binary_clock_h2_hpack_encode_indexed(block, size, 2);
+    block_length += binary_clock_h2_hpack_encode_indexed(block + block_length, size - block_length, 6);
+    block_length += binary_clock_h2_hpack_encode_literal(block + block_length, size - block_length, 4, NULL, path,
+                                                         strlen(path), true);
+    binary_clock_h2_frame_t header = {(uint32_t)block_length, BINARY_CLOCK_H2_HEADERS,
+                                      BINARY_CLOCK_H2_FLAG_END_HEADERS | BINARY_CLOCK_H2_FLAG_END_STREAM, stream};
+    binary_clock_h2_frame_write(frame, &header);
+    *length += BINARY_CLOCK_H2_FRAME_HEADER_SIZE + block_length;
+}
+
+static void send_all(int fd, const uint8_t* data, size_t length, binary_clock_h2_server_t* server) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, 0);
+        if (sent > 0) {
+            data += sent;
+            length -= (size_t)sent;
+        } else {
+            binary_clock_h2_server_poll(server, 1);
+        }
+    }
+}
+
+static h2_client_t* h2_open(binary_clock_h2_server_t* server) {
+    static h2_client_t client;
+    memset(&client, 0, sizeof(client));
+    client.fd = connect_loopback(server->port);
+    if (client.fd < 0) {
+        return NULL;
+    }
+    // Preface, empty SETTINGS, and a connection window that never runs out
+    uint8_t opening[64];
+    memcpy(opening, BINARY_CLOCK_H2_PREFACE, BINARY_CLOCK_H2_PREFACE_SIZE);
+    size_t length = BINARY_CLOCK_H2_PREFACE_SIZE;
+    binary_clock_h2_frame_t settings = {0, BINARY_CLOCK_H2_SETTINGS, 0, 0};
+    length += binary_clock_h2_frame_write(opening + length, &settings);
+    binary_clock_h2_frame_t update = {4, BINARY_CLOCK_H2_WINDOW_UPDATE, 0, 0};
+    length += binary_clock_h2_frame_write(opening + length, &update);
+    static const uint8_t increment[4] = {0x7f, 0xff, 0x00, 0x00};
+    memcpy(opening + length, increment, 4);
+    send_all(client.fd, opening, length + 4, server);
+    return &client;
+}
+
+// All requests on one connection, 64 streams at a time
+static uint64_t run_h2(binary_clock_query_t* query, long requests) {
+    binary_clock_h2_server_t server;
+    if (binary_clock_h2_server_open(&server, query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        return 0;
+    }
+    h2_client_t* client = h2_open(&server);
+    uint64_t bytes = 0;
+    if (client != NULL) {
+        static uint8_t output[BINARY_CLOCK_H2_MAX_STREAMS * 300];
+        uint32_t stream = 1;
+        for (long i = 0; i < requests;) {
+            size_t length = 0;
+            long batch = 0;
+            for (; batch < BINARY_CLOCK_H2_MAX_STREAMS && i < requests; batch++, i++, stream += 2) {
+                char target[128];
+                target_of(i, target, sizeof(target));
+                h2_send_request(output, &length, stream, target);
+            }
+            send_all(client->fd, output, length, &server);
+            long goal = client->ended + batch;
+            while (client->ended < goal) {
+                binary_clock_h2_server_poll(&server, 0);
+                h2_read(client);
+            }
+        }
+        bytes = client->bytes;
+        close(client->fd);
+    }
+    binary_clock_h2_server_close(&server);
+    return bytes;
+}
+
+// 64 tick streams over one format per stream group
+static void run_ticks(binary_clock_query_t* query, size_t format_count) {
+    binary_clock_h2_server_t server;
+    if (binary_clock_h2_server_open(&server, query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        return;
+    }
+    h2_client_t* client = h2_open(&server);
+    if (client == NULL) {
+        binary_clock_h2_server_close(&server);
+        return;
+    }
+    static uint8_t output[BINARY_CLOCK_H2_MAX_STREAMS * 300];
+    size_t length = 0;
+    for (uint32_t i = 0; i < BINARY_CLOCK_H2_MAX_STREAMS; i++) {
+        char path[64];
+        snprintf(path, sizeof(path), "/ticks?fmt=%s", formats[i % format_count]);
+        h2_send_request(output, &length, 1 + 2 * i, path);
+    }
+    send_all(client->fd, output, length, &server);
+    for (int round = 0; round < 20; round++) {
+        binary_clock_h2_server_poll(&server, 1);
+        h2_read(client);
+    }
+
+    // Stream windows are 65535 bytes: give every stream more each round
+    double elapsed = 0.0;
+    for (int tick = 0; tick < TICKS; tick++) {
+        double start = now_ns();
+        binary_clock_h2_server_tick(&server, BASE_EPOCH + tick);
+        elapsed += now_ns() - start;
+        h2_read(client);
+        if (tick % 50 == 49) {
+            length = 0;
+            for (uint32_t i = 0; i < BINARY_CLOCK_H2_MAX_STREAMS; i++) {
+                binary_clock_h2_frame_t update = {4, BINARY_CLOCK_H2_WINDOW_UPDATE, 0, 1 + 2 * i};
+                length += binary_clock_h2_frame_write(output + length, &update);
+                static const uint8_t increment[4] = {0x00, 0x01, 0x00, 0x00};
+                memcpy(output + length, increment, 4);
+                length += 4;
+            }
+            send_all(client->fd, output, length, &server);
+            binary_clock_h2_server_poll(&server, 0);
+            h2_read(client);
+        }
+    }
+    printf("  %2u streams, %lu format(s): %7.0f ns/tick  %5.2f payloads/tick  %5.1f frames/tick  %lu dropped\n",
+           (unsigned)BINARY_CLOCK_H2_MAX_STREAMS, (unsigned long)format_count, elapsed / TICKS,
+           (double)server.stats.payloads_rendered / TICKS, (double)server.stats.ticks / TICKS,
+           (unsigned long)server.stats.ticks_dropped);
+    close(client->fd);
+    binary_clock_h2_server_close(&server);
+}
+
+int main(int argc, char* argv[]) {
+    long requests = argc > 1 ? atol(argv[1]) : 20000;
+    if (requests <= 0) {
+        fprintf(stderr, "Usage: %s [REQUESTS]\n", argv[0]);
+        return 1;
+    }
+
+    binary_clock_query_t query;
+    binary_clock_query_init(&query, 4096, NULL);
+
+    printf("=== %ld /at queries over loopback ===\n", requests);
+    double start = now_ns();
+    uint64_t bytes = run_http1(&query, requests);
+    double elapsed = now_ns() - start;
+    printf("  %-32s %8.2f us/req  %7.0f req/s  %6.0f bytes/req\n", "HTTP/1.1, connection per request",
+           elapsed / requests / 1000.0, requests * 1e9 / elapsed, (double)bytes / requests);
+    start = now_ns();
+    bytes = run_h2(&query, requests);
+    elapsed = now_ns() - start;
+    printf("  %-32s %8.2f us/req  %7.0f req/s  %6.0f bytes/req\n", "HTTP/2, 64 streams per batch",
+           elapsed / requests / 1000.0, requests * 1e9 / elapsed, (double)bytes / requests);
+
+    printf("=== %d ticks fanned out to tick streams ===\n", TICKS);
+    run_ticks(&query, 1);
+    run_ticks(&query, 4);
+    binary_clock_query_free(&query);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file bench_multicast.c
+ * @brief Multicast tick fan-out cost and receive latency on loopback
+ *
+ * Joins N receivers to one group on 127.0.0.1 and sends ticks one at a
+ * time. Per tick it measures the sender's cost (the sendto() call, which
+ * on loopback also delivers to every member socket) and how long after the
+ * send the first and the last receiver had the tick applied.
+ *
+ * Usage: bench_multicast [TICKS]   (default: 2000 per receiver count)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <binary_clock_multicast.h>
+
+#define BENCH_GROUP "239.255.66.69"
+#define BENCH_PORT 42672
+#define MAX_RECEIVERS 128
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* label, double* samples, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    qsort(samples, (size_t)count, sizeof(double), compare_double);
+    printf("  %-14s mean %8.1f us   p50 %8.1f us   p99 %8.1f us\n", label,
+           sum / count, samples[count / 2], samples[(int)(count * 0.99)]);
+}
+
+static int run(int receiver_count, int ticks) {
+    static binary_clock_receiver_t receivers[MAX_RECEIVERS];
+    binary_clock_broadcaster_t broadcaster;
+    double* send_cost = malloc((size_t)ticks * sizeof(double));
+    double* first = malloc((size_t)ticks * sizeof(double));
+    double* last = malloc((size_t)ticks * sizeof(double));
+    int result = 0;
+
+    if (send_cost == NULL || first == NULL || last == NULL ||
+        binary_clock_broadcaster_open(&broadcaster, BENCH_GROUP, BENCH_PORT, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: cannot open broadcaster\n");
+        return -1;
+    }
+    for (int r = 0; r < receiver_count; r++) {
+        if (binary_clock_receiver_open(&receivers[r], BENCH_GROUP, BENCH_PORT, "127.0.0.1") != BINARY_CLOCK_SUCCESS) {
+            fprintf(stderr, "Error: cannot open receiver %d\n", r);
+            return -1;
+        }
+    }
+
+    uint32_t packed = 0;
+    for (int i = 0; i < ticks && result == 0; i++) {
+        double start = now_us();
+        if (binary_clock_broadcaster_send(&broadcaster, packed, 0) != BINARY_CLOCK_SUCCESS) {
+            result = -1;
+            break;
+        }
+        send_cost[i] = now_us() - start;
+
+        for (int r = 0; r < receiver_count; r++) {
+            binary_clock_tick_t tick;
+            if (binary_clock_receiver_receive(&receivers[r], &tick, NULL, 1000) != BINARY_CLOCK_SUCCESS) {
+                fprintf(stderr, "Error: receiver %d lost tick %d\n", r, i);
+                result = -1;
+                break;
+            }
+            if (r == 0) {
+                first[i] = now_us() - start;
+            }
+        }
+        last[i] = now_us() - start;
+        packed = binary_clock_packed_next_second(packed);
+    }
+
+    if (result == 0) {
+        printf("%d receiver%s (%d ticks)\n", receiver_count, receiver_count == 1 ? "" : "s", ticks);
+        report("send", send_cost, ticks);
+        report("first applied", first, ticks);
+        report("last applied", last, ticks);
+    }
+
+    for (int r = 0; r < receiver_count; r++) {
+        binary_clock_receiver_close(&receivers[r]);
+    }
+    binary_clock_broadcaster_close(&broadcaster);
+    free(send_cost);
+    free(first);
+    free(last);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? atoi(argv[1]) : 2000;
+    const int receiver_counts[] = {1, 8, 32, MAX_RECEIVERS};
+
+    if (ticks <= 0) {
+        fprintf(stderr, "Usage: %s [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    printf("=== Multicast tick fan-out on loopback (%d-byte datagrams) ===\n", BINARY_CLOCK_TICK_SIZE);
+    for (size_t i = 0; i < sizeof(receiver_counts) / sizeof(receiver_counts[0]); i++) {
+        if (run(receiver_counts[i], ticks) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
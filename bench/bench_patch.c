@@ -0,0 +1,76 @@
+/**
+ * @file bench_patch.c
+ * @brief Patch streams: merge patches against full NDJSON documents
+ *
+ * Encodes a run of consecutive seconds as:
+ * - ndjson: the full JSON line every second
+ * - patch: a document, then merge patches, resyncing every 60 updates
+ * - patch-sse: the same stream framed as Server-Sent Events
+ * - patch-once: one document, then only patches
+ * and reports bytes and time per update and the share of documents.
+ * Bytes are what every web client has to receive and parse each second.
+ *
+ * Usage: bench_patch [TICKS]   (default: 86400 ticks)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <binary_clock_display.h>
+#include <binary_clock_patch.h>
+
+#define BASE_EPOCH 1700006400LL  // Midnight UTC
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Keeps the compiler from dropping the encoded bytes
+static volatile char sink;
+
+static void run_patch(const char* name, binary_clock_patch_framing_t framing, uint32_t resync, long ticks) {
+    binary_clock_patch_t patch;
+    binary_clock_patch_init(&patch, framing, resync);
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    double start = now_ns();
+    for (long i = 0; i < ticks; i++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+        size_t length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+        sink = output[length - 1];
+    }
+    double elapsed = now_ns() - start;
+    printf("  %-11s %12.1f %12.0f %11.2f%%\n", name, (double)patch.stats.bytes / ticks, elapsed / ticks,
+           100.0 * (double)patch.stats.documents / ticks);
+}
+
+int main(int argc, char* argv[]) {
+    long ticks = argc > 1 ? atol(argv[1]) : 86400;
+    if (ticks <= 0) {
+        fprintf(stderr, "Usage: %s [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    printf("=== %ld clock ticks from midnight ===\n", ticks);
+    printf("  %-11s %12s %12s %12s\n", "stream", "bytes/tick", "ns/tick", "documents");
+
+    char output[BINARY_CLOCK_RENDER_MAX_SIZE];
+    uint64_t bytes = 0;
+    double start = now_ns();
+    for (long i = 0; i < ticks; i++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+        size_t length = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, output, sizeof(output));
+        sink = output[length - 1];
+        bytes += length;
+    }
+    double elapsed = now_ns() - start;
+    printf("  %-11s %12.1f %12.0f %11.2f%%\n", "ndjson", (double)bytes / ticks, elapsed / ticks, 100.0);
+
+    run_patch("patch", BINARY_CLOCK_PATCH_NDJSON, BINARY_CLOCK_PATCH_DEFAULT_RESYNC, ticks);
+    run_patch("patch-sse", BINARY_CLOCK_PATCH_SSE, BINARY_CLOCK_PATCH_DEFAULT_RESYNC, ticks);
+    run_patch("patch-once", BINARY_CLOCK_PATCH_NDJSON, 0, ticks);
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file bench_pipe.c
+ * @brief Range output into a pipe: per-frame write, buffered write, vmsplice
+ *
+ * A forked consumer drains a pipe with large read() calls while the parent
+ * generates --range output into it three ways: a write() per frame, the
+ * pipe writer copying full buffers with write(), and the pipe writer
+ * splicing them with vmsplice(). A second table sends pre-rendered buffers
+ * only, which isolates the transfer from rendering.
+ *
+ * Usage: bench_pipe [SECONDS]   (default: 2000000 seconds of range)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <binary_clock_pipe.h>
+#include <binary_clock_display.h>
+
+#define BASE_EPOCH 1700000000LL
+#define TRANSFER_BYTES (2048LL * 1024 * 1024)
+
+typedef enum {
+    SEND_PER_FRAME,
+    SEND_BUFFERED,
+    SEND_SPLICED
+} send_mode_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Fork a consumer that reads the pipe to the end; returns the write end
+static int start_consumer(pid_t* pid) {
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    *pid = fork();
+    if (*pid == 0) {
+        close(fds[1]);
+        static char buffer[1024 * 1024];
+        while (read(fds[0], buffer, sizeof(buffer)) > 0) {
+        }
+        _exit(0);
+    }
+    close(fds[0]);
+    return fds[1];
+}
+
+static int write_frame(int fd, const char* frame, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, frame, length);
+        if (written <= 0) {
+            return -1;
+        }
+        frame += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+// Render a range of seconds into a pipe; returns the bytes sent
+static uint64_t send_range(send_mode_t mode, int64_t seconds, double* elapsed, binary_clock_pipe_stats_t* stats) {
+    pid_t pid;
+    int fd = start_consumer(&pid);
+    uint64_t bytes = 0;
+    double start = now_ns();
+    if (mode == SEND_PER_FRAME) {
+        char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+        for (int64_t i = 0; i < seconds; i++) {
+            binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+            size_t length = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, frame, sizeof(frame));
+            write_frame(fd, frame, length);
+            bytes += length;
+        }
+        memset(stats, 0, sizeof(*stats));
+        stats->system_calls = (uint64_t)seconds;
+    } else {
+        binary_clock_pipe_writer_t writer;
+        binary_clock_pipe_writer_open(&writer, fd, 0, mode == SEND_SPLICED);
+        for (int64_t i = 0; i < seconds; i++) {
+            binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+            char* frame = binary_clock_pipe_writer_reserve(&writer, BINARY_CLOCK_RENDER_MAX_SIZE);
+            size_t length = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, frame,
+                                                        BINARY_CLOCK_RENDER_MAX_SIZE);
+            binary_clock_pipe_writer_commit(&writer, length);
+            bytes += length;
+        }
+        binary_clock_pipe_writer_close(&writer);
+        *stats = writer.stats;
+    }
+    close(fd);
+    waitpid(pid, NULL, 0);
+    *elapsed = now_ns() - start;
+    return bytes;
+}
+
+// Send pre-rendered bytes only
+static void send_prerendered(send_mode_t mode, const char* block, size_t block_size, double* elapsed,
+                             binary_clock_pipe_stats_t* stats) {
+    pid_t pid;
+    int fd = start_consumer(&pid);
+    double start = now_ns();
+    binary_clock_pipe_writer_t writer;
+    binary_clock_pipe_writer_open(&writer, fd, 0, mode == SEND_SPLICED);
+    for (long long sent = 0; sent < TRANSFER_BYTES; sent += (long long)block_size) {
+        binary_clock_pipe_writer_write(&writer, block, block_size);
+    }
+    binary_clock_pipe_writer_close(&writer);
+    *stats = writer.stats;
+    close(fd);
+    waitpid(pid, NULL, 0);
+    *elapsed = now_ns() - start;
+}
+
+static void report(const char* name, uint64_t bytes, double elapsed, const binary_clock_pipe_stats_t* stats) {
+    printf("  %-28s %7.2f GB/s  %9.0f ms  %10llu syscalls  %7llu spliced\n", name,
+           (double)bytes / elapsed, elapsed / 1e6, (unsigned long long)stats->system_calls,
+           (unsigned long long)stats->spliced);
+}
+
+int main(int argc, char* argv[]) {
+    long long seconds = argc > 1 ? atoll(argv[1]) : 2000000;
+    if (seconds <= 0) {
+        fprintf(stderr, "Usage: %s [SECONDS]\n", argv[0]);
+        return 1;
+    }
+
+    static const struct {
+        const char* name;
+        send_mode_t mode;
+    } modes[] = {
+        {"write() per frame", SEND_PER_FRAME},
+        {"buffered write()", SEND_BUFFERED},
+        {"vmsplice()", SEND_SPLICED},
+    };
+
+    printf("=== ndjson --range of %lld seconds into a pipe ===\n", seconds);
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        binary_clock_pipe_stats_t stats;
+        double elapsed;
+        uint64_t bytes = send_range(modes[m].mode, seconds, &elapsed, &stats);
+        report(modes[m].name, bytes, elapsed, &stats);
+    }
+
+    // A block of frames the size of a buffer, rendered once
+    size_t block_size = BINARY_CLOCK_PIPE_WRITE_BUFFER_SIZE;
+    char* block = malloc(block_size);
+    if (block == NULL) {
+        return 1;
+    }
+    for (size_t used = 0, i = 0; used < block_size; i++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + (int64_t)i, 0);
+        char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+        size_t length = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, frame, sizeof(frame));
+        length = length < block_size - used ? length : block_size - used;
+        memcpy(block + used, frame, length);
+        used += length;
+    }
+
+    printf("=== %lld MiB pre-rendered into a pipe ===\n", TRANSFER_BYTES / (1024 * 1024));
+    for (size_t m = 1; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        binary_clock_pipe_stats_t stats;
+        double elapsed;
+        send_prerendered(modes[m].mode, block, block_size, &elapsed, &stats);
+        report(modes[m].name, (uint64_t)TRANSFER_BYTES, elapsed, &stats);
+    }
+
+    free(block);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file bench_query.c
+ * @brief Query responder under a Zipfian workload
+ *
+ * Replays the same Zipf-distributed (s = 1) sequence of /at queries over
+ * an hour of seconds, several zones and every format against responders
+ * with no cache, a small cache and a large one, and reports the hit rate
+ * and response latency of each. System zones are used when the tz
+ * database is installed, fixed offsets otherwise.
+ *
+ * Usage: bench_query [REQUESTS]   (default: 500000)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <binary_clock_query.h>
+
+#define BASE_EPOCH 1700000000LL
+#define SECONDS 3600
+
+static const char* const zone_names[] = {
+    "UTC", "+05:30", "-08:00", "Europe/Berlin", "America/New_York", "Asia/Tokyo", "Australia/Sydney"
+};
+static const char* const zone_parameters[] = {
+    "UTC", "%2B05:30", "-08:00", "Europe/Berlin", "America/New_York", "Asia/Tokyo", "Australia/Sydney"
+};
+static const char* const formats[] = {"json", "ndjson", "emoji", "binary"};
+
+#define ZONE_COUNT (sizeof(zone_names) / sizeof(zone_names[0]))
+#define FORMAT_COUNT (sizeof(formats) / sizeof(formats[0]))
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t next_random(uint64_t* state) {
+    *state = *state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return *state >> 11;
+}
+
+// Zipf ranks for each request; rank r is drawn with weight 1 / (r + 1)
+static void zipf_sequence(uint32_t* sequence, size_t requests, size_t keys) {
+    double* cdf = malloc(keys * sizeof(double));
+    double total = 0.0;
+    for (size_t i = 0; i < keys; i++) {
+        total += 1.0 / (double)(i + 1);
+        cdf[i] = total;
+    }
+    uint64_t state = 42;
+    for (size_t i = 0; i < requests; i++) {
+        double u = (double)next_random(&state) / 9007199254740992.0 * total;
+        size_t low = 0, high = keys - 1;
+        while (low < high) {
+            size_t middle = (low + high) / 2;
+            if (cdf[middle] < u) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        sequence[i] = (uint32_t)low;
+    }
+    free(cdf);
+}
+
+int main(int argc, char* argv[]) {
+    long requests = argc > 1 ? atol(argv[1]) : 500000;
+    if (requests <= 0) {
+        fprintf(stderr, "Usage: %s [REQUESTS]\n", argv[0]);
+        return 1;
+    }
+
+    // Zones this system can load
+    size_t zones[ZONE_COUNT];
+    size_t zone_count = 0;
+    binary_clock_zone_t probe;
+    for (size_t i = 0; i < ZONE_COUNT; i++) {
+        if (binary_clock_zone_load(&probe, zone_names[i], NULL) == BINARY_CLOCK_SUCCESS) {
+            zones[zone_count++] = i;
+            binary_clock_zone_free(&probe);
+        }
+    }
+
+    // Popular keys are scattered over seconds, zones and formats
+    size_t keys = SECONDS * zone_count * FORMAT_COUNT;
+    uint32_t* key_of_rank = malloc(keys * sizeof(uint32_t));
+    uint32_t* sequence = malloc((size_t)requests * sizeof(uint32_t));
+    uint64_t state = 7;
+    for (size_t i = 0; i < keys; i++) {
+        key_of_rank[i] = (uint32_t)i;
+    }
+    for (size_t i = keys - 1; i > 0; i--) {
+        size_t j = (size_t)(next_random(&state) % (i + 1));
+        uint32_t swap = key_of_rank[i];
+        key_of_rank[i] = key_of_rank[j];
+        key_of_rank[j] = swap;
+    }
+    zipf_sequence(sequence, (size_t)requests, keys);
+
+    printf("=== Query responder, Zipf s=1 over %lu keys (%d s x %lu zones x %lu formats), %ld requests ===\n",
+           (unsigned long)keys, SECONDS, (unsigned long)zone_count, (unsigned long)FORMAT_COUNT, requests);
+
+    static const size_t cache_sizes[] = {0, 1024, 16384};
+    for (size_t c = 0; c < sizeof(cache_sizes) / sizeof(cache_sizes[0]); c++) {
+        binary_clock_query_t query;
+        binary_clock_query_init(&query, cache_sizes[c], NULL);
+        for (size_t z = 0; z < zone_count; z++) {
+            binary_clock_query_add_zone(&query, zone_names[zones[z]], NULL);
+        }
+
+        char target[128];
+        char response[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE];
+        size_t bytes = 0;
+        double start = now_ns();
+        for (long i = 0; i < requests; i++) {
+            uint32_t key = key_of_rank[sequence[i]];
+            int length = snprintf(target, sizeof(target), "/at?t=%lld&tz=%s&fmt=%s",
+                                  BASE_EPOCH + key % SECONDS,
+                                  zone_parameters[zones[key / SECONDS % zone_count]],
+                                  formats[key / SECONDS / zone_count]);
+            bytes += binary_clock_query_respond(&query, target, (size_t)length, response, sizeof(response));
+        }
+        double elapsed = now_ns() - start;
+
+        const binary_clock_query_stats_t* stats = &query.stats;
+        printf("  cache %5lu: %5.1f%% hits  mean %6.2f us  p50 < %6.2f us  p99 < %6.2f us  %7.0f req/s  (%lu KiB)\n",
+               (unsigned long)cache_sizes[c],
+               100.0 * (double)stats->hits / (double)stats->requests,
+               (double)stats->latency_ns / (double)stats->requests / 1000.0,
+               (double)binary_clock_query_latency_percentile(stats, 50) / 1000.0,
+               (double)binary_clock_query_latency_percentile(stats, 99) / 1000.0,
+               (double)requests * 1e9 / elapsed, (unsigned long)(query.cache.bytes / 1024));
+        if (bytes == 0) {
+            printf("  no responses written\n");
+        }
+        binary_clock_query_free(&query);
+    }
+
+    free(sequence);
+    free(key_of_rank);
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file bench_sim.c
+ * @brief Fleet simulation: per-clock structs against vector-stepped arrays
+ *
+ * Steps the same fleet of drifting clocks four ways and reports clock
+ * steps per second:
+ * - an array of per-clock structs advanced with binary_clock_packed_next_second()
+ * - the fleet arrays, one binary_clock_sim_step() per reference second
+ * - the fleet arrays, all steps per group of clocks in registers
+ * - the last split over 1, 2, 4... threads, up to the online CPUs
+ * Every method must leave every clock showing the same LEDs.
+ *
+ * Usage: bench_sim [CLOCKS [STEPS]]   (default: 1000000 clocks, 300 steps)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <binary_clock_sim.h>
+
+#define BASE_EPOCH 1700000000LL
+
+typedef struct {
+    uint32_t leds;
+    uint32_t phase;
+    int32_t rate;
+    uint32_t changed;
+    uint32_t toggles;
+} clock_record_t;
+
+typedef struct {
+    binary_clock_sim_t* sim;
+    size_t first;
+    size_t count;
+    uint32_t steps;
+} shard_job_t;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void set_fleet(binary_clock_sim_t* sim) {
+    for (size_t i = 0; i < sim->count; i++) {
+        double drift_ppm = (double)((int64_t)(i * 2654435761u % 2001) - 1000) / 10.0;  // +-100 ppm
+        binary_clock_sim_set_clock(sim, i, BASE_EPOCH, (int32_t)(i % 86400), drift_ppm, BINARY_CLOCK_SIM_24_HOUR);
+    }
+}
+
+static uint32_t bits(uint32_t x) {
+    uint32_t count = 0;
+    for (; x != 0; x &= x - 1) {
+        count++;
+    }
+    return count;
+}
+
+static void* run_shard(void* argument) {
+    shard_job_t* job = argument;
+    binary_clock_sim_step_range(job->sim, job->first, job->count, job->steps);
+    return NULL;
+}
+
+static int mismatches(const binary_clock_sim_t* sim, const uint32_t* reference) {
+    int count = 0;
+    for (size_t i = 0; i < sim->count; i++) {
+        count += sim->leds[i] != reference[i];
+    }
+    return count;
+}
+
+static void report(const char* name, size_t clocks, uint32_t steps, double elapsed) {
+    printf("  %-44s %6.0f M clock-steps/s  %8.2f ns/clock-step\n", name,
+           (double)clocks * steps / elapsed * 1e3, elapsed / ((double)clocks * steps));
+}
+
+int main(int argc, char* argv[]) {
+    long clocks = argc > 1 ? atol(argv[1]) : 1000000;
+    long steps = argc > 2 ? atol(argv[2]) : 300;
+    if (clocks <= 0 || steps <= 0) {
+        fprintf(stderr, "Usage: %s [CLOCKS [STEPS]]\n", argv[0]);
+        return 1;
+    }
+
+    binary_clock_sim_t sim;
+    if (binary_clock_sim_init(&sim, (size_t)clocks, true) != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Cannot allocate %ld clocks\n", clocks);
+        return 1;
+    }
+    clock_record_t* records = malloc((size_t)clocks * sizeof(clock_record_t));
+    uint32_t* reference = malloc((size_t)clocks * sizeof(uint32_t));
+    if (records == NULL || reference == NULL) {
+        return 1;
+    }
+    set_fleet(&sim);
+    for (long i = 0; i < clocks; i++) {
+        clock_record_t record = {sim.leds[i], 0, sim.rate[i], 0, 0};
+        records[i] = record;
+    }
+
+    printf("=== %ld clocks drifting up to 100 ppm, %ld steps (%lu bytes of fleet arrays) ===\n",
+           clocks, steps, (unsigned long)sim.bytes);
+
+    // Per-clock structs, one clock and one second at a time
+    double start = now_ns();
+    for (long s = 0; s < steps; s++) {
+        for (long i = 0; i < clocks; i++) {
+            clock_record_t* record = &records[i];
+            uint32_t phase = record->phase + (uint32_t)record->rate;
+            int ticks = 1 + (record->rate > 0 && phase < record->phase) - (record->rate < 0 && phase > record->phase);
+            record->phase = phase;
+            uint32_t leds = record->leds;
+            for (int t = 0; t < ticks; t++) {
+                leds = binary_clock_packed_next_second(leds);
+            }
+            record->changed = leds ^ record->leds;
+            record->toggles += bits(record->changed);
+            record->leds = leds;
+        }
+    }
+    report("structs + packed_next_second()", (size_t)clocks, (uint32_t)steps, now_ns() - start);
+    for (long i = 0; i < clocks; i++) {
+        reference[i] = records[i].leds;
+    }
+
+    start = now_ns();
+    for (long s = 0; s < steps; s++) {
+        binary_clock_sim_step(&sim);
+    }
+    report("arrays, one step per pass", (size_t)clocks, (uint32_t)steps, now_ns() - start);
+    int wrong = mismatches(&sim, reference);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) {
+        cpus = 1;
+    }
+    for (long threads = 1; threads <= cpus; threads *= 2) {
+        set_fleet(&sim);
+        pthread_t workers[256];
+        shard_job_t jobs[256];
+        int shards = threads > 256 ? 256 : (int)threads;
+        start = now_ns();
+        for (int t = 0; t < shards; t++) {
+            jobs[t].sim = &sim;
+            jobs[t].steps = (uint32_t)steps;
+            binary_clock_sim_shard(&sim, (unsigned)t, (unsigned)shards, &jobs[t].first, &jobs[t].count);
+            pthread_create(&workers[t], NULL, run_shard, &jobs[t]);
+        }
+        for (int t = 0; t < shards; t++) {
+            pthread_join(workers[t], NULL);
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "arrays, all steps in registers, %ld thread%s", threads, threads > 1 ? "s" : "");
+        report(name, (size_t)clocks, (uint32_t)steps, now_ns() - start);
+        wrong += mismatches(&sim, reference);
+    }
+    if (cpus == 1) {
+        printf("  (one CPU online: thread scaling not measured)\n");
+    }
+
+    uint64_t toggles = 0;
+    for (long i = 0; i < clocks; i++) {
+        toggles += records[i].toggles;
+    }
+    printf("  %.2f LED transitions per clock-second\n", (double)toggles / ((double)clocks * steps));
+    if (wrong != 0) {
+        fprintf(stderr, "%d clocks disagree with the per-clock reference\n", wrong);
+        return 1;
+    }
+
+    free(reference);
+    free(records);
+    binary_clock_sim_free(&sim);
+    return 0;
+}
@@ -0,0 +1,126 @@
+/* Generated by scripts/gen-spec.py from docs/binary_clock_api_spec.json - do not edit. */
+
+/**
+ * @file bench_spec.c
+ * @brief Per-function budgets from the API spec, and the generated codecs
+ *
+ * Times every function that has a performance entry in the spec against
+ * its max_execution_time_ms and prints its typical_execution_time_us for
+ * comparison; arguments come from the spec's unit test cases. Also times
+ * the generated record and JSON codecs. Exits 1 if a function is over budget.
+ *
+ * Usage: bench_spec [ITERATIONS]   (default: 1000000)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <binary_clock_spec.h>
+
+static const time_components_t sample_time = {14, 30, 45};
+static binary_value_t sample_binary;
+static volatile uint64_t sink;
+
+static int64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static int over_budget = 0;
+
+static void report(const char* name, double ns, long long budget_ns, long long typical_ns) {
+    if (budget_ns <= 0) {
+        printf("  %-34s %9.1f ns/call\n", name, ns);
+        return;
+    }
+    bool within = ns <= (double)budget_ns;
+    over_budget |= !within;
+    printf("  %-34s %9.1f ns/call   typical %7lld ns   budget %9lld ns: %s\n", name, ns, typical_ns, budget_ns,
+           within ? "PASS" : "FAIL");
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? atol(argv[1]) : 1000000;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [ITERATIONS]\n", argv[0]);
+        return 1;
+    }
+    sample_binary = binary_clock_to_binary(7, 4);
+    printf("=== Spec 1.0.0 budgets, %ld calls each ===\n", iterations);
+    int64_t start;
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        binary_clock_state_t result = binary_clock_get_current_state();
+        sink += (uint64_t)result.timestamp;
+    }
+    report("binary_clock_get_current_state()", (double)(now_ns() - start) / iterations,
+           BINARY_CLOCK_SPEC_BUDGET_NS_GET_CURRENT_STATE, BINARY_CLOCK_SPEC_TYPICAL_NS_GET_CURRENT_STATE);
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        binary_clock_state_t result = binary_clock_state_from_time(&sample_time);
+        sink += (uint64_t)result.timestamp;
+    }
+    report("binary_clock_state_from_time()", (double)(now_ns() - start) / iterations,
+           BINARY_CLOCK_SPEC_BUDGET_NS_STATE_FROM_TIME, BINARY_CLOCK_SPEC_TYPICAL_NS_STATE_FROM_TIME);
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        time_components_t result = binary_clock_get_current_time();
+        sink += result.seconds;
+    }
+    report("binary_clock_get_current_time()", (double)(now_ns() - start) / iterations,
+           BINARY_CLOCK_SPEC_BUDGET_NS_GET_CURRENT_TIME, BINARY_CLOCK_SPEC_TYPICAL_NS_GET_CURRENT_TIME);
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        binary_value_t result = binary_clock_to_binary(7, 4);
+        sink += result.decimal_value;
+    }
+    report("binary_clock_to_binary()", (double)(now_ns() - start) / iterations,
+           BINARY_CLOCK_SPEC_BUDGET_NS_TO_BINARY, BINARY_CLOCK_SPEC_TYPICAL_NS_TO_BINARY);
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        uint8_t result = binary_clock_to_decimal(&sample_binary);
+        sink += result;
+    }
+    report("binary_clock_to_decimal()", (double)(now_ns() - start) / iterations,
+           BINARY_CLOCK_SPEC_BUDGET_NS_TO_DECIMAL, BINARY_CLOCK_SPEC_TYPICAL_NS_TO_DECIMAL);
+
+    printf("Generated codecs (no budget in the spec):\n");
+    binary_clock_state_t state = binary_clock_state_from_time(&sample_time);
+    uint8_t record[BINARY_CLOCK_SPEC_STATE_RECORD_SIZE];
+    char json[BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE];
+    size_t json_length = binary_clock_spec_encode_state_json(&state, json, sizeof(json));
+    binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        state.timestamp += 1;
+        sink += binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+    }
+    report("encode_state_record()", (double)(now_ns() - start) / iterations, 0, 0);
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += (uint64_t)binary_clock_spec_decode_state_record(record, sizeof(record), &state);
+    }
+    report("decode_state_record()", (double)(now_ns() - start) / iterations, 0, 0);
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        state.timestamp += 1;
+        sink += binary_clock_spec_encode_state_json(&state, json, sizeof(json));
+    }
+    report("encode_state_json()", (double)(now_ns() - start) / iterations, 0, 0);
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += (uint64_t)binary_clock_spec_decode_state_json(json, json_length, &state);
+    }
+    report("decode_state_json()", (double)(now_ns() - start) / iterations, 0, 0);
+
+    return over_budget;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file bench_startup.c
+ * @brief Cold-start benchmark: exec-to-first-byte and total runtime
+ *
+ * Spawns the CLI many times in single-shot mode with stdout on a pipe and
+ * measures, per spawn, the time from posix_spawn() until the first output
+ * byte arrives and until the process has exited. Compare a default build
+ * with `make STATIC=1` and the --utc time basis.
+ *
+ * Usage: bench_startup BINARY [SPAWNS] [-- ARGS...]   (default: 2000 spawns)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <spawn.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+static double now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static void report(const char* label, double* samples, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    qsort(samples, (size_t)count, sizeof(double), compare_double);
+    printf("%-18s mean %8.1f us   p50 %8.1f us   p99 %8.1f us\n", label,
+           sum / count, samples[count / 2], samples[(int)(count * 0.99)]);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s BINARY [SPAWNS] [-- ARGS...]\n", argv[0]);
+        return 1;
+    }
+
+    int spawns = 2000;
+    int arg_start = argc;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--") == 0) {
+            arg_start = i + 1;
+            break;
+        }
+        spawns = atoi(argv[i]);
+    }
+
+    // Child argv: binary followed by everything after "--"
+    char** child_argv = calloc((size_t)(argc - arg_start + 2), sizeof(char*));
+    double* first_byte = malloc((size_t)spawns * sizeof(double));
+    double* total = malloc((size_t)spawns * sizeof(double));
+    if (child_argv == NULL || first_byte == NULL || total == NULL || spawns <= 0) {
+        fprintf(stderr, "Error: invalid arguments or out of memory\n");
+        return 1;
+    }
+    child_argv[0] = argv[1];
+    for (int i = arg_start; i < argc; i++) {
+        child_argv[i - arg_start + 1] = argv[i];
+    }
+
+    long long bytes = 0;
+    for (int run = 0; run < spawns; run++) {
+        int pipe_fds[2];
+        posix_spawn_file_actions_t actions;
+        pid_t pid;
+
+        if (pipe(pipe_fds) != 0) {
+            perror("pipe");
+            return 1;
+        }
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, pipe_fds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_addclose(&actions, pipe_fds[0]);
+
+        double start = now_us();
+        if (posix_spawn(&pid, argv[1], &actions, NULL, child_argv, environ) != 0) {
+            perror("posix_spawn");
+            return 1;
+        }
+        close(pipe_fds[1]);
+
+        char buffer[4096];
+        ssize_t got;
+        first_byte[run] = -1.0;
+        while ((got = read(pipe_fds[0], buffer, sizeof(buffer))) > 0) {
+            if (first_byte[run] < 0) {
+                first_byte[run] = now_us() - start;
+            }
+            bytes += got;
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        total[run] = now_us() - start;
+
+        close(pipe_fds[0]);
+        posix_spawn_file_actions_destroy(&actions);
+        if (first_byte[run] < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "Error: run %d produced no output or failed\n", run);
+            return 1;
+        }
+    }
+
+    printf("=== Cold start: %s", argv[1]);
+    for (int i = 1; child_argv[i] != NULL; i++) {
+        printf(" %s", child_argv[i]);
+    }
+    printf(" (%d spawns, %.0f bytes/run) ===\n", spawns, (double)bytes / spawns);
+    report("exec-to-first-byte", first_byte, spawns);
+    report("total", total, spawns);
+
+    free(child_argv);
+    free(first_byte);
+    free(total);
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file bench_stream.c
+ * @brief Terminal streaming cost per tick for thousands of clients
+ *
+ * Connects N loopback clients to a stream server and measures, per tick,
+ * the server's CPU time (encoding plus every send()) and the bytes it
+ * writes. Clients are drained between ticks outside the measurement.
+ * Two cases are compared:
+ * - synced: every client shows the previous tick and gets the shared diff
+ * - lagging: every client is behind and gets the full repaint
+ *
+ * Usage: bench_stream [CLIENTS] [TICKS]   (default: 5000 clients, 20 ticks)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <binary_clock_stream.h>
+
+// 2023-11-14 23:59:50 UTC, so the measured ticks cross midnight
+#define BENCH_EPOCH 1700006390LL
+
+static double cpu_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+static void drain(const int* fds, int count) {
+    char buffer[4096];
+    for (int i = 0; i < count; i++) {
+        while (recv(fds[i], buffer, sizeof(buffer), 0) > 0) {
+        }
+    }
+}
+
+// Flush everything pending; server CPU is accumulated into *cpu
+static void settle(binary_clock_stream_server_t* server, const int* fds, int count, double* cpu) {
+    do {
+        double start = cpu_us();
+        binary_clock_stream_server_poll(server, 0);
+        *cpu += cpu_us() - start;
+        drain(fds, count);
+    } while (binary_clock_stream_server_pending(server));
+}
+
+static void measure(binary_clock_stream_server_t* server, const int* fds, int count,
+                    int64_t* epoch, int ticks, bool lagging) {
+    binary_clock_stream_stats_t before = server->stats;
+    double cpu = 0.0;
+    for (int t = 0; t < ticks; t++, (*epoch)++) {
+        if (lagging) {
+            for (size_t i = 0; i < server->client_count; i++) {
+                server->clients[i].shown_tick = 0;
+            }
+        }
+        binary_clock_state_t state = binary_clock_state_from_epoch(*epoch, 0);
+        double start = cpu_us();
+        binary_clock_stream_server_tick(server, &state);
+        cpu += cpu_us() - start;
+        settle(server, fds, count, &cpu);
+    }
+
+    const binary_clock_stream_stats_t* after = &server->stats;
+    double sent = (double)(after->sent_bytes - before.sent_bytes) / ticks;
+    double encoded = (double)(after->encoded_bytes - before.encoded_bytes) / ticks;
+    printf("  %-8s %8.0f us CPU/tick  %6.0f ns/client  %9.0f B sent/tick  %5.1f B/client  "
+           "%5.0f B encoded/tick  %llu diff / %llu full\n",
+           lagging ? "lagging" : "synced", cpu / ticks, cpu * 1000.0 / ticks / count, sent, sent / count, encoded,
+           (unsigned long long)(after->diff_sends - before.diff_sends),
+           (unsigned long long)(after->full_sends - before.full_sends));
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 5000;
+    int ticks = argc > 2 ? atoi(argv[2]) : 20;
+    if (count <= 0 || ticks <= 0) {
+        fprintf(stderr, "Usage: %s [CLIENTS] [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    // Both ends of every connection live in this process
+    struct rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && (rlim_t)count * 2 + 16 > limit.rlim_cur) {
+        count = (int)((limit.rlim_cur - 16) / 2);
+        fprintf(stderr, "Note: open file limit allows %d clients\n", count);
+    }
+
+    binary_clock_stream_server_t server;
+    int* fds = calloc((size_t)count, sizeof(int));
+    if (fds == NULL ||
+        binary_clock_stream_server_open(&server, "127.0.0.1", 0, BINARY_CLOCK_RENDER_EMOJI) != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: cannot start the server\n");
+        return 1;
+    }
+
+    // Connect in batches the listen backlog can hold
+    double ignored = 0.0;
+    for (int i = 0; i < count; i++) {
+        fds[i] = connect_client(server.port);
+        if (fds[i] < 0) {
+            fprintf(stderr, "Error: client %d cannot connect: %s\n", i, strerror(errno));
+            return 1;
+        }
+        if (i % 128 == 127 || i == count - 1) {
+            binary_clock_stream_server_poll(&server, 0);
+        }
+    }
+    while (server.client_count < (size_t)count) {
+        binary_clock_stream_server_poll(&server, 10);
+    }
+    settle(&server, fds, count, &ignored);
+
+    printf("=== Terminal streaming, %d clients on loopback (emoji screen) ===\n", count);
+    int64_t epoch = BENCH_EPOCH;
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch++, 0);
+    binary_clock_stream_server_tick(&server, &state);  // Initial full repaint
+    settle(&server, fds, count, &ignored);
+
+    // Warm up caches and socket buffers before measuring
+    for (int t = 0; t < ticks; t++) {
+        state = binary_clock_state_from_epoch(epoch++ - 86400, 0);
+        binary_clock_stream_server_tick(&server, &state);
+        settle(&server, fds, count, &ignored);
+    }
+
+    measure(&server, fds, count, &epoch, ticks, false);
+    measure(&server, fds, count, &epoch, ticks, true);
+
+    for (int i = 0; i < count; i++) {
+        close(fds[i]);
+    }
+    binary_clock_stream_server_close(&server);
+    free(fds);
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file bench_trace.c
+ * @brief Cost of tracing, per event and per presented tick
+ *
+ * Measures a begin/end pair with tracing off and on, then the presenter
+ * pipeline (render, wait on a full-speed virtual clock, write to
+ * /dev/null) per tick with tracing off and on, and the time to write the
+ * full ring as Chrome trace-event JSON.
+ *
+ * Usage: bench_trace [TICKS]   (default: 200000)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <binary_clock_trace.h>
+#include <binary_clock_present.h>
+
+#define PAIRS 2000000
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static double pair_ns(void) {
+    double start = now_ns();
+    for (int i = 0; i < PAIRS; i++) {
+        binary_clock_trace_begin("bench", "span");
+        binary_clock_trace_end("bench", "span");
+    }
+    return (now_ns() - start) / PAIRS;
+}
+
+// Present TICKS frames on a full-speed virtual clock, like soak mode
+static double tick_ns(int sink, int ticks) {
+    binary_clock_virtual_clock_t clock;
+    binary_clock_virtual_clock_init(&clock, 1700000000LL * 1000000, 0);
+    binary_clock_present_clock_t source = binary_clock_virtual_clock_source(&clock);
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, sink);
+    binary_clock_presenter_set_clock(&presenter, &source);
+
+    double start = now_ns();
+    for (int i = 0; i < ticks; i++) {
+        int64_t second = 1700000001LL + i;
+        binary_clock_trace_begin("loop", "tick");
+        binary_clock_trace_begin("loop", "state");
+        binary_clock_state_t state = binary_clock_state_from_epoch(second, 0);
+        binary_clock_trace_end("loop", "state");
+        binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_EMOJI, "\033[2J\033[H", second * 1000000);
+        binary_clock_presenter_commit(&presenter, NULL);
+        binary_clock_trace_end("loop", "tick");
+    }
+    return (now_ns() - start) / ticks;
+}
+
+int main(int argc, char* argv[]) {
+    int ticks = argc > 1 ? atoi(argv[1]) : 200000;
+    int sink = open("/dev/null", O_WRONLY);
+    if (ticks <= 0 || sink < 0) {
+        fprintf(stderr, "Usage: %s [TICKS]\n", argv[0]);
+        return 1;
+    }
+
+    printf("=== Tracing overhead ===\n");
+    double off = pair_ns();
+    binary_clock_trace_start(0);
+    double on = pair_ns();
+    printf("  begin+end pair:  %6.1f ns off  %6.1f ns on\n", off, on);
+
+    binary_clock_trace_stop();
+    double tick_off = tick_ns(sink, ticks);
+    binary_clock_trace_start(0);
+    double tick_on = tick_ns(sink, ticks);
+    printf("  presented tick:  %6.0f ns off  %6.0f ns on  (+%.1f%%, %d ticks, 8 events/tick)\n",
+           tick_off, tick_on, tick_off > 0 ? (tick_on - tick_off) * 100.0 / tick_off : 0.0, ticks);
+
+    FILE* output = fopen("/dev/null", "w");
+    binary_clock_trace_stats_t stats = binary_clock_trace_get_stats();
+    double start = now_ns();
+    binary_clock_trace_write(output);
+    double write_ms = (now_ns() - start) / 1e6;
+    printf("  write JSON:      %6.1f ms for %zu events\n", write_ms, stats.capacity);
+
+    fclose(output);
+    close(sink);
+    binary_clock_trace_stop();
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file bench_waterfall.c
+ * @brief Waterfall ticks: redrawing the history against scrolling it
+ *
+ * For several history lengths, produces a tick's output two ways and
+ * writes it to /dev/null (or the file given):
+ * - redraw: home the cursor and render every row of the history again
+ * - scroll: the waterfall's tick, one row and the scroll-region shift
+ * and reports bytes and time per tick. Bytes are what a terminal (or an
+ * ssh session in front of it) has to carry and parse every second.
+ *
+ * Usage: bench_waterfall [TICKS [OUTPUT]]   (default: 20000 ticks, /dev/null)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <binary_clock_waterfall.h>
+
+#define BASE_EPOCH 1700000000LL
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written <= 0) {
+            return;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+}
+
+// Home the cursor and render every row, newest first, into one write
+static size_t redraw_tick(const binary_clock_waterfall_t* waterfall, int64_t newest, char* buffer) {
+    size_t length = (size_t)snprintf(buffer, 32, "\033[%d;1H", BINARY_CLOCK_WATERFALL_TOP_ROW);
+    for (uint32_t row = 0; row < waterfall->rows; row++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(newest - row, 0);
+        length += waterfall->render(&state, waterfall->format, buffer + length, BINARY_CLOCK_RENDER_MAX_SIZE);
+    }
+    return length;
+}
+
+int main(int argc, char* argv[]) {
+    long ticks = argc > 1 ? atol(argv[1]) : 20000;
+    const char* path = argc > 2 ? argv[2] : "/dev/null";
+    if (ticks <= 0) {
+        fprintf(stderr, "Usage: %s [TICKS [OUTPUT]]\n", argv[0]);
+        return 1;
+    }
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 1;
+    }
+
+    static const uint32_t histories[] = {20, 60, 200, 1000};
+    printf("=== %ld waterfall ticks (emoji rows) into %s ===\n", ticks, path);
+    printf("  %-8s %-8s %12s %12s\n", "history", "method", "bytes/tick", "ns/tick");
+    for (size_t h = 0; h < sizeof(histories) / sizeof(histories[0]); h++) {
+        binary_clock_waterfall_t waterfall;
+        binary_clock_waterfall_init(&waterfall, histories[h], BINARY_CLOCK_RENDER_EMOJI_LINE);
+        char* buffer = malloc((size_t)histories[h] * BINARY_CLOCK_RENDER_MAX_SIZE + 64);
+        if (buffer == NULL) {
+            return 1;
+        }
+
+        // Fewer redraws for long histories, so every row count runs about as long
+        long redraws = ticks * 20 / (long)histories[h] + 1;
+        uint64_t bytes = 0;
+        double start = now_ns();
+        for (long i = 0; i < redraws; i++) {
+            size_t length = redraw_tick(&waterfall, BASE_EPOCH + i, buffer);
+            write_all(fd, buffer, length);
+            bytes += length;
+        }
+        double elapsed = now_ns() - start;
+        printf("  %-8u %-8s %12.0f %12.0f\n", (unsigned)histories[h], "redraw", (double)bytes / redraws,
+               elapsed / redraws);
+
+        bytes = 0;
+        start = now_ns();
+        for (long i = 0; i < ticks; i++) {
+            binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + i, 0);
+            size_t length = binary_clock_waterfall_tick(&waterfall, &state, buffer, BINARY_CLOCK_WATERFALL_TICK_SIZE);
+            write_all(fd, buffer, length);
+            bytes += length;
+        }
+        elapsed = now_ns() - start;
+        printf("  %-8u %-8s %12.0f %12.0f\n", (unsigned)histories[h], "scroll", (double)bytes / ticks,
+               elapsed / ticks);
+        free(buffer);
+    }
+
+    close(fd);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file binary_clock_admit.h
+ * @brief Binary Clock Admission Control - Connection limits for the servers
+ * @version 1.0.0
+ *
+ * When every client reconnects at the top of the second, a server that
+ * accepts them all spends each tick on newcomers and its established
+ * clients fall behind. Admission control decides per new connection,
+ * before any frame is queued for it:
+ * - a cap on connected clients
+ * - a cap on connections from one IPv4 address
+ * - a token-bucket rate of new connections (sustained rate plus burst)
+ *
+ * Established clients are never evicted to make room. A rejected
+ * connection is told so with one short write and closed.
+ *
+ * The checks are plain bookkeeping with no sockets or clocks, so they
+ * work the same on every platform; the caller passes the time.
+ */
+
+#ifndef BINARY_CLOCK_ADMIT_H
+#define BINARY_CLOCK_ADMIT_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Limits; 0 leaves a limit off
+ */
+typedef struct {
+    size_t max_clients;         /**< Connected clients at most */
+    uint32_t max_per_address;   /**< Connected clients from one address at most */
+    uint32_t rate;              /**< New connections per second, sustained */
+    uint32_t burst;             /**< New connections at once (0 = rate) */
+} binary_clock_admit_limits_t;
+
+/**
+ * @brief Decision for a new connection
+ */
+typedef enum {
+    BINARY_CLOCK_ADMIT_OK = 0,          /**< Admitted and counted */
+    BINARY_CLOCK_ADMIT_FULL = 1,        /**< Client cap reached */
+    BINARY_CLOCK_ADMIT_ADDRESS = 2,     /**< Per-address cap reached */
+    BINARY_CLOCK_ADMIT_RATE = 3         /**< No token left in the bucket */
+} binary_clock_admit_verdict_t;
+
+/**
+ * @brief Admission counters
+ */
+typedef struct {
+    uint64_t admitted;          /**< Connections admitted */
+    uint64_t rejected_full;     /**< Rejected at the client cap */
+    uint64_t rejected_address;  /**< Rejected at the per-address cap */
+    uint64_t rejected_rate;     /**< Rejected by the rate limit */
+} binary_clock_admit_stats_t;
+
+/**
+ * @brief Connections from one address
+ */
+typedef struct {
+    uint32_t address;           /**< IPv4 address, host byte order */
+    uint32_t count;             /**< Connected clients, 0 = empty slot */
+} binary_clock_admit_entry_t;
+
+/**
+ * @brief Admission state
+ */
+typedef struct {
+    binary_clock_admit_limits_t limits;
+    size_t active;              /**< Connected clients counted */
+    int64_t tokens;             /**< Bucket level in millionths of a connection */
+    int64_t refilled_us;        /**< Time the bucket was last refilled */
+    binary_clock_admit_entry_t* addresses; /**< Per-address counts (open addressing) */
+    size_t address_capacity;    /**< Slots in addresses, a power of two */
+    size_t address_count;       /**< Addresses with connected clients */
+    binary_clock_admit_stats_t stats;
+} binary_clock_admit_t;
+
+/**
+ * @brief Initialize admission state
+ *
+ * The bucket starts full.
+ *
+ * @param admit State to initialize (must not be NULL)
+ * @param limits Limits, NULL for none
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NULL_POINTER
+ */
+binary_clock_error_t binary_clock_admit_init(binary_clock_admit_t* admit, const binary_clock_admit_limits_t* limits);
+
+/**
+ * @brief Decide on a new connection, counting it when admitted
+ *
+ * The client cap is checked first, then the per-address cap, then the
+ * rate, so connections rejected for another reason spend no token.
+ *
+ * @param admit Admission state (must not be NULL)
+ * @param address Peer IPv4 address, host byte order
+ * @param now_us Current time in microseconds (any monotonic origin)
+ * @return Verdict; BINARY_CLOCK_ADMIT_FULL also when memory runs out
+ */
+binary_clock_admit_verdict_t binary_clock_admit_check(binary_clock_admit_t* admit, uint32_t address, int64_t now_us);
+
+/**
+ * @brief Count a connection without checking the limits
+ *
+ * For clients that were connected before the limits were set.
+ *
+ * @return BINARY_CLOCK_SUCCESS, or BINARY_CLOCK_ERROR_OUTPUT when memory runs out
+ */
+binary_clock_error_t binary_clock_admit_add(binary_clock_admit_t* admit, uint32_t address);
+
+/**
+ * @brief Forget a connection that was admitted or added
+ */
+void binary_clock_admit_release(binary_clock_admit_t* admit, uint32_t address);
+
+/**
+ * @brief Heap bytes held for per-address counts
+ */
+size_t binary_clock_admit_memory(const binary_clock_admit_t* admit);
+
+/**
+ * @brief Free the per-address counts
+ */
+void binary_clock_admit_free(binary_clock_admit_t* admit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_ADMIT_H */
@@ -14,6 +14,12 @@
  * - C99 standard compatibility
  * - Pure data API (no visualization)
  * - High-performance state queries (< 1ms)
+ *
+ * Freestanding builds:
+ * Define BINARY_CLOCK_FREESTANDING to build the core API without any libc
+ * (no <time.h>, no stdio, no allocation). Functions that read the system
+ * clock are then unavailable; callers supply epoch seconds or drive the
+ * packed incremental path from their own tick source.
  */
 
 #ifndef BINARY_CLOCK_API_H
@@ -21,7 +27,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+#ifndef BINARY_CLOCK_FREESTANDING
 #include <time.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,13 +49,28 @@ typedef enum {
     BINARY_CLOCK_ERROR_INVALID_TIME = 1,   /**< Invalid time components provided */
     BINARY_CLOCK_ERROR_INVALID_BIT_COUNT = 2, /**< Bit count out of valid range (1-6) */
     BINARY_CLOCK_ERROR_NULL_POINTER = 3,   /**< Null pointer passed to function requiring valid pointer */
-    BINARY_CLOCK_ERROR_SYSTEM_TIME = 4     /**< System time retrieval failed */
+    BINARY_CLOCK_ERROR_SYSTEM_TIME = 4,    /**< System time retrieval failed */
+    BINARY_CLOCK_ERROR_OUTPUT = 5,         /**< Writing output or allocating an output buffer failed */
+    BINARY_CLOCK_ERROR_NETWORK = 6,        /**< Socket operation failed or is unsupported on this platform */
+    BINARY_CLOCK_ERROR_TIMEOUT = 7         /**< Nothing arrived before the timeout expired */
 } binary_clock_error_t;
 
 /* ========================================================================== */
 /* CORE DATA STRUCTURES                                                       */
 /* ========================================================================== */
 
+/**
+ * @brief Timestamp type used in binary clock states
+ *
+ * time_t in hosted builds; seconds since the epoch as int64_t in
+ * freestanding builds where <time.h> is not available.
+ */
+#ifdef BINARY_CLOCK_FREESTANDING
+typedef int64_t binary_clock_time_t;
+#else
+typedef time_t binary_clock_time_t;
+#endif
+
 /**
  * @brief Represents a binary value with configurable bit count
  * 
@@ -85,7 +110,7 @@ typedef struct {
     binary_value_t minutes_units;  /**< Minutes units digit (0-9, 4 bits) */
     binary_value_t seconds_tens;   /**< Seconds tens digit (0-5, 3 bits) */
     binary_value_t seconds_units;  /**< Seconds units digit (0-9, 4 bits) */
-    time_t timestamp;              /**< Unix timestamp when state was created */
+    binary_clock_time_t timestamp; /**< Unix timestamp when state was created */
 } binary_clock_state_t;
 
 
@@ -93,6 +118,8 @@ typedef struct {
 /* CORE API FUNCTIONS                                                         */
 /* ========================================================================== */
 
+#ifndef BINARY_CLOCK_FREESTANDING
+
 /**
  * @brief Get current binary clock state using system time
  * 
@@ -130,6 +157,8 @@ binary_clock_state_t binary_clock_state_from_time(const time_components_t* time_
  */
 time_components_t binary_clock_get_current_time(void);
 
+#endif /* BINARY_CLOCK_FREESTANDING */
+
 /* ========================================================================== */
 /* BINARY CONVERSION UTILITIES                                                */
 /* ========================================================================== */
@@ -161,6 +190,81 @@ binary_value_t binary_clock_to_binary(uint8_t value, uint8_t bit_count);
  */
 uint8_t binary_clock_to_decimal(const binary_value_t* binary);
 
+/* ========================================================================== */
+/* EPOCH AND PACKED REPRESENTATIONS                                           */
+/* ========================================================================== */
+
+/**
+ * @brief Bit position of each digit inside a packed state
+ *
+ * A packed state stores the six clock digits as BCD nibbles, so the
+ * packed value of 14:30:45 is 0x143045. Because every LED column is the
+ * binary form of one digit, the packed value doubles as the LED mask.
+ */
+#define BINARY_CLOCK_PACKED_HOURS_TENS_SHIFT    20
+#define BINARY_CLOCK_PACKED_HOURS_UNITS_SHIFT   16
+#define BINARY_CLOCK_PACKED_MINUTES_TENS_SHIFT  12
+#define BINARY_CLOCK_PACKED_MINUTES_UNITS_SHIFT  8
+#define BINARY_CLOCK_PACKED_SECONDS_TENS_SHIFT   4
+#define BINARY_CLOCK_PACKED_SECONDS_UNITS_SHIFT  0
+
+/**
+ * @brief Convert epoch seconds to time components with a fixed UTC offset
+ *
+ * Uses pure arithmetic (no timezone database, no libc time functions), so
+ * the result only depends on the arguments. Negative epochs are handled.
+ *
+ * @param epoch_seconds Seconds since 1970-01-01T00:00:00Z
+ * @param utc_offset_seconds Offset added to UTC (e.g. 3600 for UTC+1)
+ * @return Time of day at the given offset
+ * @performance Typical execution: < 0.1μs
+ */
+time_components_t binary_clock_time_from_epoch(int64_t epoch_seconds, int32_t utc_offset_seconds);
+
+/**
+ * @brief Create binary clock state from epoch seconds
+ *
+ * Equivalent to binary_clock_state_from_time() on the result of
+ * binary_clock_time_from_epoch(), except that the state timestamp is set
+ * to @p epoch_seconds rather than the current time. This is the building
+ * block for converting whole time ranges.
+ *
+ * @param epoch_seconds Seconds since 1970-01-01T00:00:00Z
+ * @param utc_offset_seconds Offset added to UTC (e.g. 3600 for UTC+1)
+ * @return Binary clock state for the given instant
+ */
+binary_clock_state_t binary_clock_state_from_epoch(int64_t epoch_seconds, int32_t utc_offset_seconds);
+
+/**
+ * @brief Pack a binary clock state into a 24-bit BCD LED mask
+ *
+ * @param state State to pack (must not be NULL)
+ * @return Packed digits (see BINARY_CLOCK_PACKED_*_SHIFT), 0 for NULL
+ */
+uint32_t binary_clock_pack_state(const binary_clock_state_t* state);
+
+/**
+ * @brief Create binary clock state from a packed LED mask
+ *
+ * @param packed Packed digits as returned by binary_clock_pack_state()
+ * @param timestamp Timestamp to store in the state
+ * @return Binary clock state, or state with timestamp=0 if a digit is out of range
+ */
+binary_clock_state_t binary_clock_state_from_packed(uint32_t packed, binary_clock_time_t timestamp);
+
+/**
+ * @brief Advance a packed LED mask by one second
+ *
+ * BCD increment with carry from seconds through hours, wrapping from
+ * 23:59:59 to 00:00:00. Lets tick-driven callers keep the display state
+ * without any division or time conversion.
+ *
+ * @param packed Valid packed digits
+ * @return Packed digits one second later
+ * @performance Typical execution: a few instructions
+ */
+uint32_t binary_clock_packed_next_second(uint32_t packed);
+
 
 /* ========================================================================== */
 /* UTILITY FUNCTIONS                                                          */
@@ -0,0 +1,83 @@
+/**
+ * @file binary_clock_arrow.h
+ * @brief Binary Clock Arrow Export - Columnar export of time ranges
+ * @version 1.0.0
+ *
+ * This module writes binary clock states for a range of epoch seconds in
+ * the Apache Arrow IPC format (streaming or file/random-access variant)
+ * without depending on any Arrow library. The output can be read directly
+ * by pyarrow, Polars, DuckDB and friends, and the file variant can be
+ * memory-mapped with zero copy.
+ *
+ * Schema (all columns non-nullable):
+ * - epoch          int64   Seconds since 1970-01-01T00:00:00Z
+ * - leds           uint32  Packed BCD LED mask (see binary_clock_pack_state)
+ * - hours_tens     uint8   Digit values, one column per clock digit
+ * - hours_units    uint8
+ * - minutes_tens   uint8
+ * - minutes_units  uint8
+ * - seconds_tens   uint8
+ * - seconds_units  uint8
+ */
+
+#ifndef BINARY_CLOCK_ARROW_H
+#define BINARY_CLOCK_ARROW_H
+
+#include <binary_clock_api.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Arrow IPC container variants
+ */
+typedef enum {
+    BINARY_CLOCK_ARROW_STREAM = 0,  /**< IPC streaming format (.arrows) */
+    BINARY_CLOCK_ARROW_FILE = 1     /**< IPC file format with footer (.arrow) */
+} binary_clock_arrow_format_t;
+
+/**
+ * @brief Default number of rows per record batch
+ */
+#define BINARY_CLOCK_ARROW_DEFAULT_BATCH_ROWS 65536
+
+/**
+ * @brief Write the states for a range of seconds as Arrow IPC
+ *
+ * Emits one row per second in [start_epoch, end_epoch). Rows are
+ * converted in batches of @p batch_rows and each batch is written as one
+ * record batch. Column buffers are allocated once per call
+ * (18 bytes per row of batch size). The file format lists every batch
+ * in its footer, so it holds at most UINT32_MAX batches.
+ *
+ * Example usage:
+ * @code
+ * FILE* file = fopen("day.arrow", "wb");
+ * binary_clock_arrow_write_range(file, 1700000000, 1700086400, 0,
+ *                                BINARY_CLOCK_ARROW_FILE, 0);
+ * fclose(file);
+ * @endcode
+ *
+ * @param output Binary stream to write to (must not be NULL)
+ * @param start_epoch First second to export (inclusive)
+ * @param end_epoch Last second to export (exclusive, >= start_epoch)
+ * @param utc_offset_seconds Fixed offset applied to every row
+ * @param format Stream or file container
+ * @param batch_rows Rows per record batch (0 for the default)
+ * @return BINARY_CLOCK_SUCCESS or error code (BINARY_CLOCK_ERROR_OUTPUT
+ *         for a file range of more batches than its footer can list)
+ */
+binary_clock_error_t binary_clock_arrow_write_range(FILE* output,
+                                                    int64_t start_epoch,
+                                                    int64_t end_epoch,
+                                                    int32_t utc_offset_seconds,
+                                                    binary_clock_arrow_format_t format,
+                                                    uint32_t batch_rows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_ARROW_H */
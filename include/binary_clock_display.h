@@ -43,6 +43,44 @@ extern "C" {
  */
 typedef void (*binary_clock_display_fn_t)(const binary_clock_state_t* state, void* context);
 
+/**
+ * @brief Largest slice a buffer display callback can fill (any rendered format fits)
+ */
+#define BINARY_CLOCK_DISPLAY_SLICE_SIZE 512
+
+/**
+ * @brief Sink (file descriptor) a slice goes to unless its callback picks another
+ */
+#define BINARY_CLOCK_DISPLAY_DEFAULT_SINK 1
+
+/**
+ * @brief Buffer display callback signature
+ * 
+ * Instead of doing its own I/O, a buffer display renders into a slice the
+ * dispatcher provides and names the sink the slice goes to. The
+ * dispatcher gathers the slices of every buffer display for a tick and
+ * sends each sink's slices with one writev(), in registration order.
+ * 
+ * @param state Current binary clock state (never NULL)
+ * @param context User-provided context data (may be NULL)
+ * @param buffer Slice to render into
+ * @param size Slice size (BINARY_CLOCK_DISPLAY_SLICE_SIZE)
+ * @param sink Destination file descriptor, preset to BINARY_CLOCK_DISPLAY_DEFAULT_SINK
+ * @return Bytes rendered, 0 to send nothing this tick
+ */
+typedef size_t (*binary_clock_display_buffer_fn_t)(const binary_clock_state_t* state, void* context,
+                                                   char* buffer, size_t size, int* sink);
+
+/**
+ * @brief Dispatcher counters for buffer displays
+ */
+typedef struct {
+    uint64_t slices;            /**< Slices rendered */
+    uint64_t bytes;             /**< Bytes sent */
+    uint64_t system_calls;      /**< writev() calls (more than one per sink only for partial writes) */
+    uint64_t errors;            /**< Slices dropped: oversized, negative sink, or failed write */
+} binary_clock_display_dispatch_stats_t;
+
 /**
  * @brief Register a display callback
  * 
@@ -57,6 +95,19 @@ typedef void (*binary_clock_display_fn_t)(const binary_clock_state_t* state, voi
  */
 int binary_clock_display_register(binary_clock_display_fn_t display_fn, void* context);
 
+/**
+ * @brief Register a buffer display callback
+ * 
+ * Shares the 16 registration slots and the IDs of
+ * binary_clock_display_register(), so binary_clock_display_unregister()
+ * removes either kind. Both kinds can be registered together.
+ * 
+ * @param render_fn Buffer display function to register (must not be NULL)
+ * @param context Context data to pass to the function (may be NULL)
+ * @return Registration ID for later removal, -1 on failure
+ */
+int binary_clock_display_register_buffer(binary_clock_display_buffer_fn_t render_fn, void* context);
+
 /**
  * @brief Remove a previously registered display callback
  * 
@@ -82,10 +133,79 @@ void binary_clock_display_update_all(void);
  * Calls all registered display functions with the provided state.
  * NULL pointer is silently ignored.
  * 
+ * Function callbacks run first, in registration order. Then stdout is
+ * flushed, if any ran, and the buffer displays' slices are sent with one
+ * writev() per sink (one write() of the joined slices on Windows).
+ * 
  * @param state State to display (may be NULL)
  */
 void binary_clock_display_update_all_with_state(const binary_clock_state_t* state);
 
+/**
+ * @brief Counters of the buffer display dispatcher since startup
+ */
+binary_clock_display_dispatch_stats_t binary_clock_display_get_dispatch_stats(void);
+
+/* ========================================================================== */
+/* BUFFER RENDERING                                                           */
+/* ========================================================================== */
+
+/**
+ * @brief Output formats supported by binary_clock_display_render()
+ */
+typedef enum {
+    BINARY_CLOCK_RENDER_EMOJI = 0,    /**< Same output as binary_clock_display_console_emoji */
+    BINARY_CLOCK_RENDER_ASCII = 1,    /**< Same output as binary_clock_display_console_ascii */
+    BINARY_CLOCK_RENDER_COMPACT = 2,  /**< Same output as binary_clock_display_compact */
+    BINARY_CLOCK_RENDER_JSON = 3,     /**< Same output as binary_clock_display_json */
+    BINARY_CLOCK_RENDER_JSON_LINE = 4, /**< Same output as binary_clock_display_json_line */
+    BINARY_CLOCK_RENDER_EMOJI_LINE = 5 /**< Compact layout with emoji, one line (status bars) */
+} binary_clock_render_format_t;
+
+/**
+ * @brief Buffer size that fits any rendered format
+ */
+#define BINARY_CLOCK_RENDER_MAX_SIZE 512
+
+/**
+ * @brief Render a state into a caller-provided buffer
+ * 
+ * Produces exactly the bytes the matching display function would print,
+ * without touching stdio, so the result can be emitted with a single
+ * write(). The built-in display functions are implemented on top of this.
+ * Thread-safe (no shared state).
+ * 
+ * @param state Binary clock state to render (must not be NULL)
+ * @param format Output format
+ * @param buffer Destination buffer (must not be NULL)
+ * @param buffer_size Size of buffer (BINARY_CLOCK_RENDER_MAX_SIZE always suffices)
+ * @return Number of bytes written (excluding the NUL terminator), 0 on failure
+ */
+size_t binary_clock_display_render(const binary_clock_state_t* state, binary_clock_render_format_t format,
+                                   char* buffer, size_t buffer_size);
+
+/**
+ * @brief Table-driven variant of binary_clock_display_render()
+ *
+ * Produces the same bytes, but copies each 3- and 4-bit digit column
+ * from a table of pre-rendered glyphs instead of emitting it bit by bit.
+ * Which variant is faster depends on the host (see binary_clock_tune.h).
+ * Thread-safe (the tables are constant).
+ */
+size_t binary_clock_display_render_table(const binary_clock_state_t* state, binary_clock_render_format_t format,
+                                         char* buffer, size_t buffer_size);
+
+/**
+ * @brief Bytes of glyph tables binary_clock_display_render_table() reads
+ */
+size_t binary_clock_display_table_size(void);
+
+/**
+ * @brief Signature shared by binary_clock_display_render() and its variants
+ */
+typedef size_t (*binary_clock_render_fn_t)(const binary_clock_state_t* state, binary_clock_render_format_t format,
+                                           char* buffer, size_t buffer_size);
+
 /* ========================================================================== */
 /* BUILT-IN DISPLAY FUNCTIONS                                                 */
 /* ========================================================================== */
@@ -148,6 +268,17 @@ void binary_clock_display_console_ascii(const binary_clock_state_t* state, void*
  */
 void binary_clock_display_json(const binary_clock_state_t* state, void* context);
 
+/**
+ * @brief Single-line JSON display (NDJSON)
+ * 
+ * Same document as binary_clock_display_json() without whitespace, one
+ * document per line. Suitable for newline-delimited JSON streams.
+ * 
+ * @param state Binary clock state to display (must not be NULL)
+ * @param context FILE* to write to (stdout if NULL)
+ */
+void binary_clock_display_json_line(const binary_clock_state_t* state, void* context);
+
 /**
  * @brief Compact one-line display for debugging
  * 
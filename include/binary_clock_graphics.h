@@ -0,0 +1,176 @@
+/**
+ * @file binary_clock_graphics.h
+ * @brief Binary Clock Graphics - LED images on kitty and sixel terminals
+ * @version 1.0.0
+ *
+ * Draws the clock's LEDs as images instead of emoji, in the emoji
+ * display's layout (a row per unit, three tens LEDs, a gap, four units
+ * LEDs). Images look the same whatever the font, and a tick only sends
+ * the LEDs that changed since the last one.
+ *
+ * - kitty graphics protocol: the off and on LED images are uploaded once,
+ *   at setup. The first tick places an off image on every LED; after
+ *   that, an LED turning on gets an on image placed above it and an LED
+ *   turning off has that placement deleted. Either is one short command
+ *   naming an image ID, so no pixels cross the terminal after setup.
+ * - sixel: there are no stored images, so both LEDs are encoded once at
+ *   initialization and the cached sixel bytes are written over each
+ *   changed LED.
+ *
+ * The screen is never cleared after setup, and of the time line only the
+ * characters from the first one that changed are rewritten.
+ */
+
+#ifndef BINARY_CLOCK_GRAPHICS_H
+#define BINARY_CLOCK_GRAPHICS_H
+
+#include <binary_clock_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief LEDs drawn: 3 tens and 4 units for hours, minutes and seconds
+ */
+#define BINARY_CLOCK_GRAPHICS_LEDS 21
+
+/**
+ * @brief kitty image ID of the off LED (the on LED is the next ID)
+ */
+#define BINARY_CLOCK_GRAPHICS_IMAGE_ID 4267001u
+
+/**
+ * @brief Side of the square kitty LED image, pixels (scaled to two cells)
+ */
+#define BINARY_CLOCK_GRAPHICS_IMAGE_SIZE 20
+
+/**
+ * @brief Sixel LED glyph width and height, pixels (two cells of 8 x 16)
+ */
+#define BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH 16
+#define BINARY_CLOCK_GRAPHICS_SIXEL_HEIGHT 12
+
+/**
+ * @brief Size of an encoded sixel LED glyph buffer
+ */
+#define BINARY_CLOCK_GRAPHICS_GLYPH_SIZE 256
+
+/**
+ * @brief Size of a cached LED command (cursor move plus placement or glyph)
+ */
+#define BINARY_CLOCK_GRAPHICS_COMMAND_SIZE 96
+
+/**
+ * @brief Largest setup output (title, labels and the kitty image uploads)
+ */
+#define BINARY_CLOCK_GRAPHICS_BEGIN_SIZE 8192
+
+/**
+ * @brief Largest tick output (every LED drawn, as on the first tick)
+ */
+#define BINARY_CLOCK_GRAPHICS_TICK_SIZE 8192
+
+/**
+ * @brief Screen row of the hours LEDs (minutes and seconds follow)
+ */
+#define BINARY_CLOCK_GRAPHICS_TOP_ROW 4
+
+/**
+ * @brief Graphics protocol a terminal speaks
+ */
+typedef enum {
+    BINARY_CLOCK_GRAPHICS_KITTY = 0,    /**< kitty graphics protocol (kitty, WezTerm, Ghostty) */
+    BINARY_CLOCK_GRAPHICS_SIXEL = 1     /**< DEC sixel (xterm -ti vt340, foot, mlterm, ...) */
+} binary_clock_graphics_protocol_t;
+
+/**
+ * @brief Output counters
+ */
+typedef struct {
+    uint64_t ticks;             /**< Ticks encoded */
+    uint64_t leds_drawn;        /**< LED placements, deletions or glyphs sent */
+    uint64_t bytes;             /**< Bytes of tick output */
+} binary_clock_graphics_stats_t;
+
+/**
+ * @brief A graphics display
+ */
+typedef struct {
+    binary_clock_graphics_protocol_t protocol;
+    bool placed;                /**< LEDs are on screen (false until the first tick) */
+    bool lit[BINARY_CLOCK_GRAPHICS_LEDS]; /**< What the screen shows, hours tens first */
+    char time[8];               /**< Time line the screen shows, HH:MM:SS */
+    char glyphs[2][BINARY_CLOCK_GRAPHICS_GLYPH_SIZE]; /**< Sixel: encoded off and on LEDs */
+    size_t glyph_lengths[2];    /**< Lengths of glyphs */
+    char commands[BINARY_CLOCK_GRAPHICS_LEDS][2][BINARY_CLOCK_GRAPHICS_COMMAND_SIZE]; /**< Turn each LED off, on */
+    uint8_t command_lengths[BINARY_CLOCK_GRAPHICS_LEDS][2]; /**< Lengths of commands */
+    binary_clock_graphics_stats_t stats;
+} binary_clock_graphics_t;
+
+/**
+ * @brief Pick a protocol from the terminal's environment
+ *
+ * kitty, WezTerm and Ghostty announce themselves through TERM,
+ * TERM_PROGRAM or KITTY_WINDOW_ID and get the kitty protocol; every
+ * other terminal gets sixel.
+ *
+ * @param term Value of TERM, or NULL
+ * @param term_program Value of TERM_PROGRAM, or NULL
+ * @param kitty_window_id Value of KITTY_WINDOW_ID, or NULL
+ */
+binary_clock_graphics_protocol_t binary_clock_graphics_detect(const char* term, const char* term_program,
+                                                              const char* kitty_window_id);
+
+/**
+ * @brief Initialize a graphics display
+ *
+ * Encodes the sixel glyphs and the command that turns each LED off and
+ * on, so a tick only copies the cached commands of the LEDs that changed.
+ *
+ * @param graphics Display to initialize (must not be NULL)
+ * @param protocol Protocol to speak
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_OUTPUT for an unknown protocol
+ */
+binary_clock_error_t binary_clock_graphics_init(binary_clock_graphics_t* graphics,
+                                                binary_clock_graphics_protocol_t protocol);
+
+/**
+ * @brief Encode the screen setup: clear, title, row labels, image uploads
+ *
+ * @param graphics Display (must not be NULL)
+ * @param output Output buffer (BINARY_CLOCK_GRAPHICS_BEGIN_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Bytes to write, or 0 on a NULL argument or a buffer too small
+ */
+size_t binary_clock_graphics_begin(binary_clock_graphics_t* graphics, char* output, size_t size);
+
+/**
+ * @brief Encode one tick: the time line and the LEDs that changed
+ *
+ * The display records what it encoded, so every returned tick must be
+ * written, in order.
+ *
+ * @param graphics Display (must not be NULL)
+ * @param state State to show (must not be NULL)
+ * @param output Output buffer (BINARY_CLOCK_GRAPHICS_TICK_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Bytes to write, or 0 on a NULL argument or a buffer too small
+ *         (the display is then unchanged)
+ */
+size_t binary_clock_graphics_tick(binary_clock_graphics_t* graphics, const binary_clock_state_t* state,
+                                  char* output, size_t size);
+
+/**
+ * @brief Encode the teardown: free uploaded images, cursor below the clock
+ *
+ * @return Bytes to write, or 0 on a NULL argument or a buffer too small
+ */
+size_t binary_clock_graphics_end(binary_clock_graphics_t* graphics, char* output, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_GRAPHICS_H */
@@ -0,0 +1,392 @@
+/**
+ * @file binary_clock_h2.h
+ * @brief Binary Clock HTTP/2 - Queries and tick streams over cleartext HTTP/2
+ * @version 1.0.0
+ *
+ * One connection carries any number of concurrent requests as streams:
+ *
+ *     GET /at?t=EPOCH&tz=ZONE&fmt=FORMAT   one response, as binary_clock_query.h
+ *     GET /ticks?tz=ZONE&fmt=FORMAT        a response that never ends: one
+ *                                          DATA frame with the frame of every
+ *                                          second (tz and fmt as for /at)
+ *
+ * so a dashboard showing several zones, or following the clock while it
+ * also asks for other seconds, needs one socket instead of one per view.
+ * Connections speak h2c with prior knowledge (curl --http2-prior-knowledge):
+ * the client starts with the HTTP/2 preface, there is no Upgrade from
+ * HTTP/1.1 and no TLS.
+ *
+ * Everything is implemented here, without external libraries: frame
+ * parsing, HPACK (static table, a dynamic table of the protocol's default
+ * 4096 bytes, Huffman strings) and flow control in both directions.
+ * Responses come from a binary_clock_query_t, so /at answers share its
+ * zones and response cache with the HTTP/1.1 server.
+ *
+ * On a tick, each (zone, format) followed by any stream is rendered once,
+ * and that payload is written to every stream following it. A stream or
+ * connection whose flow-control window cannot take a tick's frame skips
+ * that second instead of queueing it: a late second is worth nothing.
+ */
+
+#ifndef BINARY_CLOCK_H2_H
+#define BINARY_CLOCK_H2_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_query.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default listen address and port
+ */
+#define BINARY_CLOCK_H2_DEFAULT_ADDRESS "0.0.0.0"
+#define BINARY_CLOCK_H2_DEFAULT_PORT 4270
+
+/**
+ * @brief The client connection preface and its length
+ */
+#define BINARY_CLOCK_H2_PREFACE "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"
+#define BINARY_CLOCK_H2_PREFACE_SIZE 24
+
+/**
+ * @brief Frame header size and the largest frame payload (the protocol
+ *        default, which the server never raises)
+ */
+#define BINARY_CLOCK_H2_FRAME_HEADER_SIZE 9
+#define BINARY_CLOCK_H2_MAX_FRAME_SIZE 16384
+
+/**
+ * @brief Concurrent streams per connection (SETTINGS_MAX_CONCURRENT_STREAMS)
+ */
+#define BINARY_CLOCK_H2_MAX_STREAMS 64
+
+/**
+ * @brief HPACK dynamic table size the decoder accepts (the protocol default)
+ */
+#define BINARY_CLOCK_H2_HEADER_TABLE_SIZE 4096
+
+/**
+ * @brief Largest header block, HEADERS plus CONTINUATION payloads
+ */
+#define BINARY_CLOCK_H2_HEADER_BLOCK_SIZE 8192
+
+/**
+ * @brief Largest decoded header name plus value
+ */
+#define BINARY_CLOCK_H2_HEADER_FIELD_SIZE 2048
+
+/**
+ * @brief Frames queued for a connection but not yet written
+ */
+#define BINARY_CLOCK_H2_OUTPUT_SIZE (32 * 1024)
+
+/**
+ * @brief Flow-control window every stream and connection starts with
+ */
+#define BINARY_CLOCK_H2_INITIAL_WINDOW 65535
+
+/**
+ * @brief Distinct (zone, format) payloads rendered once per tick; further
+ *        ones are rendered once per stream
+ */
+#define BINARY_CLOCK_H2_TICK_PAYLOADS 16
+
+/**
+ * @brief Frame types (RFC 9113 section 6)
+ */
+typedef enum {
+    BINARY_CLOCK_H2_DATA = 0x0,
+    BINARY_CLOCK_H2_HEADERS = 0x1,
+    BINARY_CLOCK_H2_PRIORITY = 0x2,
+    BINARY_CLOCK_H2_RST_STREAM = 0x3,
+    BINARY_CLOCK_H2_SETTINGS = 0x4,
+    BINARY_CLOCK_H2_PUSH_PROMISE = 0x5,
+    BINARY_CLOCK_H2_PING = 0x6,
+    BINARY_CLOCK_H2_GOAWAY = 0x7,
+    BINARY_CLOCK_H2_WINDOW_UPDATE = 0x8,
+    BINARY_CLOCK_H2_CONTINUATION = 0x9
+} binary_clock_h2_frame_type_t;
+
+/**
+ * @brief Frame flags
+ */
+#define BINARY_CLOCK_H2_FLAG_END_STREAM 0x1
+#define BINARY_CLOCK_H2_FLAG_ACK 0x1
+#define BINARY_CLOCK_H2_FLAG_END_HEADERS 0x4
+#define BINARY_CLOCK_H2_FLAG_PADDED 0x8
+#define BINARY_CLOCK_H2_FLAG_PRIORITY 0x20
+
+/**
+ * @brief Settings identifiers
+ */
+#define BINARY_CLOCK_H2_SETTINGS_HEADER_TABLE_SIZE 0x1
+#define BINARY_CLOCK_H2_SETTINGS_ENABLE_PUSH 0x2
+#define BINARY_CLOCK_H2_SETTINGS_MAX_CONCURRENT_STREAMS 0x3
+#define BINARY_CLOCK_H2_SETTINGS_INITIAL_WINDOW_SIZE 0x4
+#define BINARY_CLOCK_H2_SETTINGS_MAX_FRAME_SIZE 0x5
+
+/**
+ * @brief Error codes carried by RST_STREAM and GOAWAY
+ */
+typedef enum {
+    BINARY_CLOCK_H2_NO_ERROR = 0x0,
+    BINARY_CLOCK_H2_PROTOCOL_ERROR = 0x1,
+    BINARY_CLOCK_H2_INTERNAL_ERROR = 0x2,
+    BINARY_CLOCK_H2_FLOW_CONTROL_ERROR = 0x3,
+    BINARY_CLOCK_H2_STREAM_CLOSED = 0x5,
+    BINARY_CLOCK_H2_FRAME_SIZE_ERROR = 0x6,
+    BINARY_CLOCK_H2_REFUSED_STREAM = 0x7,
+    BINARY_CLOCK_H2_COMPRESSION_ERROR = 0x9
+} binary_clock_h2_error_code_t;
+
+/* ========================================================================== */
+/* FRAMES                                                                     */
+/* ========================================================================== */
+
+/**
+ * @brief A frame header
+ */
+typedef struct {
+    uint32_t length;            /**< Payload length (24 bits) */
+    uint8_t type;               /**< binary_clock_h2_frame_type_t, or an unknown type */
+    uint8_t flags;              /**< BINARY_CLOCK_H2_FLAG_* */
+    uint32_t stream;            /**< Stream identifier (31 bits), 0 for the connection */
+} binary_clock_h2_frame_t;
+
+/**
+ * @brief Decode a frame header from BINARY_CLOCK_H2_FRAME_HEADER_SIZE bytes
+ */
+binary_clock_h2_frame_t binary_clock_h2_frame_read(const uint8_t* input);
+
+/**
+ * @brief Encode a frame header into BINARY_CLOCK_H2_FRAME_HEADER_SIZE bytes
+ *
+ * @return BINARY_CLOCK_H2_FRAME_HEADER_SIZE
+ */
+size_t binary_clock_h2_frame_write(uint8_t* output, const binary_clock_h2_frame_t* frame);
+
+/* ========================================================================== */
+/* HPACK                                                                      */
+/* ========================================================================== */
+
+/**
+ * @brief HPACK decoding context: the dynamic table of one connection
+ *
+ * Entries are stored oldest first in data; an entry costs its name and
+ * value plus 32 bytes against max_size, so at most max_size / 32 fit.
+ */
+typedef struct {
+    char data[BINARY_CLOCK_H2_HEADER_TABLE_SIZE]; /**< Names and values, oldest entry first */
+    struct {
+        uint16_t offset;        /**< Name position in data; the value follows it */
+        uint16_t name_length;
+        uint16_t value_length;
+    } entries[BINARY_CLOCK_H2_HEADER_TABLE_SIZE / 32]; /**< Oldest first */
+    uint32_t count;             /**< Entries in the table */
+    uint32_t size;              /**< Table size as HPACK counts it */
+    uint32_t max_size;          /**< Current limit, set by size updates */
+} binary_clock_h2_hpack_t;
+
+/**
+ * @brief Receives each decoded header field (strings are not terminated)
+ */
+typedef void (*binary_clock_h2_header_fn_t)(void* context, const char* name, size_t name_length,
+                                            const char* value, size_t value_length);
+
+/**
+ * @brief Start a decoding context with an empty table of the default size
+ */
+void binary_clock_h2_hpack_init(binary_clock_h2_hpack_t* table);
+
+/**
+ * @brief Decode a complete header block, updating the dynamic table
+ *
+ * Every representation is handled: indexed fields, literals with and
+ * without indexing, never-indexed literals and table size updates.
+ * A block must be decoded even when its request is refused, or the
+ * table goes out of step with the peer's.
+ *
+ * @param table Decoding context (must not be NULL)
+ * @param block Header block
+ * @param length Block length
+ * @param header_fn Called for every field in order (may be NULL)
+ * @param context Passed to header_fn
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT for a block
+ *         that is malformed (a COMPRESSION_ERROR for the connection)
+ */
+binary_clock_error_t binary_clock_h2_hpack_decode(binary_clock_h2_hpack_t* table, const uint8_t* block,
+                                                  size_t length, binary_clock_h2_header_fn_t header_fn,
+                                                  void* context);
+
+/**
+ * @brief Encode an indexed field (static table index 1-61, or dynamic)
+ *
+ * @return Bytes written, 0 if the buffer is too small
+ */
+size_t binary_clock_h2_hpack_encode_indexed(uint8_t* output, size_t size, uint32_t index);
+
+/**
+ * @brief Encode a literal field without indexing
+ *
+ * @param output Output buffer
+ * @param size Output buffer size
+ * @param name_index Index of the name, or 0 to send name as a literal
+ * @param name Field name when name_index is 0 (lower case)
+ * @param value Field value
+ * @param value_length Value length
+ * @param huffman Huffman-code the strings
+ * @return Bytes written, 0 if the buffer is too small
+ */
+size_t binary_clock_h2_hpack_encode_literal(uint8_t* output, size_t size, uint32_t name_index, const char* name,
+                                            const char* value, size_t value_length, bool huffman);
+
+/**
+ * @brief Huffman-decode a string
+ *
+ * @return Decoded length, or SIZE_MAX for invalid coding (EOS, or padding
+ *         that is longer than 7 bits or not all ones) or too small a buffer
+ */
+size_t binary_clock_h2_huffman_decode(const uint8_t* input, size_t length, char* output, size_t size);
+
+/**
+ * @brief Huffman-encode a string
+ *
+ * @return Encoded length, 0 if the buffer is too small
+ */
+size_t binary_clock_h2_huffman_encode(const char* input, size_t length, uint8_t* output, size_t size);
+
+/* ========================================================================== */
+/* SERVER                                                                     */
+/* ========================================================================== */
+
+/**
+ * @brief What a stream is doing
+ */
+typedef enum {
+    BINARY_CLOCK_H2_STREAM_FREE = 0, /**< Slot unused */
+    BINARY_CLOCK_H2_STREAM_RESPONDING, /**< Sending a response body as the windows allow */
+    BINARY_CLOCK_H2_STREAM_TICKING /**< Following the clock until reset */
+} binary_clock_h2_stream_state_t;
+
+/**
+ * @brief One stream of a connection
+ */
+typedef struct {
+    uint32_t id;                /**< Stream identifier */
+    uint8_t state;              /**< binary_clock_h2_stream_state_t */
+    uint16_t zone;              /**< Zone index in the responder (ticking) */
+    uint16_t format;            /**< Render format (ticking) */
+    int32_t window;             /**< Bytes the peer accepts on this stream */
+    uint16_t body_sent;         /**< Response body bytes sent (responding) */
+    uint16_t body_length;       /**< Response body length (responding) */
+    char body[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE]; /**< Response body (responding) */
+} binary_clock_h2_stream_t;
+
+/**
+ * @brief One HTTP/2 connection
+ */
+typedef struct {
+    int fd;                     /**< Socket */
+    bool preface;               /**< Client preface received */
+    bool closing;               /**< GOAWAY sent or received: write what is queued, then close */
+    int32_t window;             /**< Bytes the peer accepts on the connection */
+    int32_t initial_window;     /**< Peer's SETTINGS_INITIAL_WINDOW_SIZE */
+    uint32_t last_stream;       /**< Highest stream the client opened */
+    uint32_t header_stream;     /**< Stream whose header block awaits CONTINUATION, 0 if none */
+    bool header_end_stream;     /**< That block's HEADERS frame ended the stream */
+    size_t header_length;       /**< Header block bytes collected */
+    size_t received;            /**< Input bytes buffered */
+    size_t queued;              /**< Output bytes queued */
+    size_t sent;                /**< Queued output bytes written */
+    uint32_t stream_count;      /**< Streams in use */
+    binary_clock_h2_hpack_t decoder; /**< Request header decoding */
+    binary_clock_h2_stream_t streams[BINARY_CLOCK_H2_MAX_STREAMS];
+    uint8_t input[BINARY_CLOCK_H2_FRAME_HEADER_SIZE + BINARY_CLOCK_H2_MAX_FRAME_SIZE];
+    uint8_t header_block[BINARY_CLOCK_H2_HEADER_BLOCK_SIZE];
+    uint8_t output[BINARY_CLOCK_H2_OUTPUT_SIZE];
+} binary_clock_h2_connection_t;
+
+/**
+ * @brief Server counters
+ */
+typedef struct {
+    uint64_t connections;       /**< Connections accepted */
+    uint64_t streams;           /**< Streams opened */
+    uint64_t refused_streams;   /**< Streams over BINARY_CLOCK_H2_MAX_STREAMS, reset */
+    uint64_t protocol_errors;   /**< Connections ended with a GOAWAY error */
+    uint64_t ticks;             /**< Tick DATA frames queued */
+    uint64_t ticks_dropped;     /**< Tick frames skipped for want of window or output room */
+    uint64_t payloads_rendered; /**< Tick payloads rendered (each shared by its streams) */
+} binary_clock_h2_stats_t;
+
+/**
+ * @brief An h2c server answering /at and /ticks
+ */
+typedef struct {
+    int listen_fd;              /**< Listening socket, -1 when closed */
+    uint16_t port;              /**< Bound port (resolved when 0 was requested) */
+    binary_clock_query_t* query; /**< Responder */
+    binary_clock_h2_connection_t** connections; /**< Open connections */
+    size_t connection_count;
+    size_t connection_capacity;
+    void* poll_set;             /**< poll() set, sized with the connections */
+    binary_clock_h2_stats_t stats;
+} binary_clock_h2_server_t;
+
+/**
+ * @brief Start listening for HTTP/2 connections
+ *
+ * @param server Server to initialize (must not be NULL)
+ * @param query Responder the server answers with (must not be NULL)
+ * @param address Local IPv4 address, NULL for all
+ * @param port TCP port, 0 for any free port
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_h2_server_open(binary_clock_h2_server_t* server, binary_clock_query_t* query,
+                                                 const char* address, uint16_t port);
+
+/**
+ * @brief Accept connections, process frames, write what the windows allow
+ *
+ * A connection is closed when the peer closes it, and after a GOAWAY
+ * once everything queued before it is written. Each connection costs
+ * sizeof(binary_clock_h2_connection_t), charged to BINARY_CLOCK_MEM_QUEUES.
+ *
+ * @param server Open server (must not be NULL)
+ * @param timeout_ms Longest wait for activity, 0 to not wait, -1 forever
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_TIMEOUT when nothing
+ *         happened, or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_h2_server_poll(binary_clock_h2_server_t* server, int timeout_ms);
+
+/**
+ * @brief Send a second to every /ticks stream
+ *
+ * Queues the frames and writes what the sockets take now; the rest goes
+ * out from binary_clock_h2_server_poll().
+ *
+ * @param server Open server (must not be NULL)
+ * @param epoch Second to send, converted to each stream's zone
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NULL_POINTER
+ */
+binary_clock_error_t binary_clock_h2_server_tick(binary_clock_h2_server_t* server, int64_t epoch);
+
+/**
+ * @brief One-line summary: connections, streams, ticks sent and dropped
+ *
+ * @return Length written (truncated to fit)
+ */
+size_t binary_clock_h2_report(const binary_clock_h2_server_t* server, char* buffer, size_t size);
+
+/**
+ * @brief Close every connection and stop listening
+ */
+void binary_clock_h2_server_close(binary_clock_h2_server_t* server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_H2_H */
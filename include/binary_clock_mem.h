@@ -0,0 +1,152 @@
+/**
+ * @file binary_clock_mem.h
+ * @brief Binary Clock Memory Accounting - Bytes per subsystem, with caps
+ * @version 1.0.0
+ *
+ * The core API allocates nothing, but the modules around it hold lookup
+ * tables, frame caches, connection registries and queues. Each of them
+ * charges what it holds to one of four subsystems, so a small device can
+ * see where its memory goes and cap it:
+ * - tables: lookup tables the autotuned kernels read (binary_clock_tune.h),
+ *   zone transition tables (binary_clock_zone.h)
+ * - caches: stream frame slabs kept for reuse (binary_clock_stream.h),
+ *   cached query responses (binary_clock_query.h)
+ * - registry: per-address connection counts (binary_clock_admit.h),
+ *   simulated clock fleets (binary_clock_sim.h)
+ * - queues: stream, query and HTTP/2 connection slots and poll sets, the
+ *   trace ring, pipe output buffers (binary_clock_pipe.h)
+ *
+ * A cap does not make allocations fail. A subsystem that would exceed
+ * its cap switches to a leaner mode instead and charges what that uses:
+ * - tables: the scalar kernels compute instead of looking up (zone
+ *   tables have no lean mode)
+ * - caches: slabs are carved for one frame instead of a full slab; the
+ *   query cache holds fewer responses
+ * - registry: the address table fills to 3/4 instead of 1/2 before growing
+ *   (fleets have no lean mode)
+ * - queues: connection slots grow 16 at a time instead of doubling; the
+ *   trace ring is shrunk to fit; pipes are not enlarged (HTTP/2
+ *   connections have no lean mode)
+ *
+ * The counters are process-wide and updated only when memory is taken
+ * or given back, never per tick. They are not thread-safe.
+ */
+
+#ifndef BINARY_CLOCK_MEM_H
+#define BINARY_CLOCK_MEM_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Cap value meaning no cap (the default)
+ */
+#define BINARY_CLOCK_MEM_UNCAPPED ((size_t)-1)
+
+/**
+ * @brief Buffer size that fits binary_clock_mem_report()
+ */
+#define BINARY_CLOCK_MEM_REPORT_SIZE 512
+
+/**
+ * @brief Subsystems memory is charged to
+ */
+typedef enum {
+    BINARY_CLOCK_MEM_TABLES = 0,    /**< Lookup tables of the chosen kernels */
+    BINARY_CLOCK_MEM_CACHES = 1,    /**< Frames kept for reuse */
+    BINARY_CLOCK_MEM_REGISTRY = 2,  /**< Per-address connection counts, clock fleets */
+    BINARY_CLOCK_MEM_QUEUES = 3,    /**< Client slots, poll set, trace ring, pipe buffers */
+    BINARY_CLOCK_MEM_SUBSYSTEMS = 4
+} binary_clock_mem_subsystem_t;
+
+/**
+ * @brief Accounting of one subsystem
+ */
+typedef struct {
+    size_t used;                /**< Bytes held now */
+    size_t peak;                /**< Most bytes held at once */
+    size_t cap;                 /**< Cap, BINARY_CLOCK_MEM_UNCAPPED for none */
+    uint64_t lean;              /**< Times the cap switched it to its lean mode */
+} binary_clock_mem_usage_t;
+
+/**
+ * @brief Set a subsystem's cap
+ *
+ * Applies to memory taken from now on; nothing already held is given back.
+ *
+ * @param subsystem Subsystem to cap
+ * @param bytes Cap in bytes, BINARY_CLOCK_MEM_UNCAPPED to lift it
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT for an unknown subsystem
+ */
+binary_clock_error_t binary_clock_mem_set_cap(binary_clock_mem_subsystem_t subsystem, size_t bytes);
+
+/**
+ * @brief Charge bytes if they fit under the cap
+ *
+ * @return true if charged; false (counted as a switch to the lean mode)
+ *         if they would exceed the cap
+ */
+bool binary_clock_mem_reserve(binary_clock_mem_subsystem_t subsystem, size_t bytes);
+
+/**
+ * @brief Charge bytes regardless of the cap (what a lean mode still needs)
+ */
+void binary_clock_mem_charge(binary_clock_mem_subsystem_t subsystem, size_t bytes);
+
+/**
+ * @brief Give back bytes charged earlier
+ */
+void binary_clock_mem_release(binary_clock_mem_subsystem_t subsystem, size_t bytes);
+
+/**
+ * @brief Bytes a subsystem can still take under its cap
+ */
+size_t binary_clock_mem_available(binary_clock_mem_subsystem_t subsystem);
+
+/**
+ * @brief Accounting of one subsystem (all zero for an unknown one)
+ */
+binary_clock_mem_usage_t binary_clock_mem_get_usage(binary_clock_mem_subsystem_t subsystem);
+
+/**
+ * @brief Bytes held by every subsystem together
+ */
+size_t binary_clock_mem_total(void);
+
+/**
+ * @brief Subsystem name ("tables", "caches", "registry", "queues")
+ */
+const char* binary_clock_mem_subsystem_name(binary_clock_mem_subsystem_t subsystem);
+
+/**
+ * @brief Look a subsystem up by name
+ *
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT for an unknown name
+ */
+binary_clock_error_t binary_clock_mem_subsystem_from_name(const char* name, binary_clock_mem_subsystem_t* subsystem);
+
+/**
+ * @brief Table of used, peak and capped bytes and lean switches per subsystem
+ *
+ * @param buffer Output buffer (BINARY_CLOCK_MEM_REPORT_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Length written (truncated to fit)
+ */
+size_t binary_clock_mem_report(char* buffer, size_t size);
+
+/**
+ * @brief Forget all charges, peaks and switches and lift every cap
+ *
+ * Only for tests and benchmarks: memory still held is not given back.
+ */
+void binary_clock_mem_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_MEM_H */
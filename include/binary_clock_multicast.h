@@ -0,0 +1,220 @@
+/**
+ * @file binary_clock_multicast.h
+ * @brief Binary Clock Multicast - LAN-wide tick distribution
+ * @version 1.0.0
+ *
+ * One broadcaster sends a small datagram per tick to an IPv4 multicast
+ * group; any number of display nodes receive it instead of reading and
+ * converting the time themselves. Each tick carries the packed LED state,
+ * a sequence number for gap detection and the scheduled presentation time.
+ *
+ * Wire format (24 bytes, network byte order):
+ * - offset  0  uint32  magic "BCLK" (0x42434C4B)
+ * - offset  4  uint8   version (1)
+ * - offset  5  uint8   flags (0, reserved)
+ * - offset  6  uint16  reserved (0)
+ * - offset  8  uint32  packed state (see binary_clock_pack_state)
+ * - offset 12  uint32  sequence number (wraps)
+ * - offset 16  int64   presentation time, microseconds since the epoch
+ *
+ * Wall-clock time for presentation times comes from binary_clock_present.h.
+ * Sockets are supported on POSIX systems; on Windows the open functions
+ * return BINARY_CLOCK_ERROR_NETWORK while encoding and gap detection work
+ * everywhere.
+ */
+
+#ifndef BINARY_CLOCK_MULTICAST_H
+#define BINARY_CLOCK_MULTICAST_H
+
+#include <binary_clock_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ========================================================================== */
+/* TICK DATAGRAMS                                                             */
+/* ========================================================================== */
+
+#define BINARY_CLOCK_TICK_SIZE 24
+#define BINARY_CLOCK_TICK_MAGIC 0x42434C4Bu
+#define BINARY_CLOCK_TICK_VERSION 1
+
+/**
+ * @brief Default group, port and send lead time
+ */
+#define BINARY_CLOCK_MULTICAST_DEFAULT_GROUP "239.255.66.67"
+#define BINARY_CLOCK_MULTICAST_DEFAULT_PORT 4267
+#define BINARY_CLOCK_MULTICAST_DEFAULT_LEAD_MS 50
+
+/**
+ * @brief Ticks older than this many sequence numbers mean the broadcaster
+ *        restarted; the receiver resynchronizes instead of dropping them
+ */
+#define BINARY_CLOCK_RECEIVER_REORDER_WINDOW 64
+
+/**
+ * @brief One clock tick as carried on the wire
+ */
+typedef struct {
+    uint32_t sequence;          /**< Incremented by one per tick sent */
+    uint32_t packed;            /**< Packed BCD LED mask */
+    int64_t present_at_us;      /**< When to show it, microseconds since the epoch */
+} binary_clock_tick_t;
+
+/**
+ * @brief Encode a tick into its 24-byte wire format
+ *
+ * @param tick Tick to encode (must not be NULL)
+ * @param output Destination of BINARY_CLOCK_TICK_SIZE bytes (must not be NULL)
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_tick_encode(const binary_clock_tick_t* tick, uint8_t* output);
+
+/**
+ * @brief Decode and validate a tick datagram
+ *
+ * Rejects datagrams of the wrong size, magic or version and packed states
+ * with out-of-range digits.
+ *
+ * @param data Datagram bytes (must not be NULL)
+ * @param length Datagram length
+ * @param tick Decoded tick (must not be NULL)
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_INVALID_TIME for a
+ *         malformed datagram, or BINARY_CLOCK_ERROR_NULL_POINTER
+ */
+binary_clock_error_t binary_clock_tick_decode(const uint8_t* data, size_t length, binary_clock_tick_t* tick);
+
+/* ========================================================================== */
+/* BROADCASTER                                                                */
+/* ========================================================================== */
+
+/**
+ * @brief Sending side of a tick group
+ */
+typedef struct {
+    int fd;                     /**< UDP socket, -1 when closed */
+    uint32_t group;             /**< Group address, host byte order */
+    uint16_t port;              /**< Destination port */
+    uint32_t sequence;          /**< Sequence number of the next tick */
+} binary_clock_broadcaster_t;
+
+/**
+ * @brief Open a broadcaster for a multicast group
+ *
+ * @param broadcaster Broadcaster to initialize (must not be NULL)
+ * @param group IPv4 multicast group, e.g. BINARY_CLOCK_MULTICAST_DEFAULT_GROUP
+ * @param port Destination UDP port
+ * @param interface_address Local interface address, or NULL for the default route
+ * @param ttl Multicast TTL (1 keeps ticks on the local network)
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_broadcaster_open(binary_clock_broadcaster_t* broadcaster,
+                                                   const char* group, uint16_t port,
+                                                   const char* interface_address, int ttl);
+
+/**
+ * @brief Send one tick and advance the sequence number
+ *
+ * @param broadcaster Open broadcaster (must not be NULL)
+ * @param packed Packed state to show
+ * @param present_at_us Presentation time, microseconds since the epoch
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_broadcaster_send(binary_clock_broadcaster_t* broadcaster,
+                                                   uint32_t packed, int64_t present_at_us);
+
+/**
+ * @brief Close a broadcaster (safe to call on a closed one)
+ */
+void binary_clock_broadcaster_close(binary_clock_broadcaster_t* broadcaster);
+
+/* ========================================================================== */
+/* RECEIVER                                                                   */
+/* ========================================================================== */
+
+/**
+ * @brief Receiver counters
+ */
+typedef struct {
+    uint64_t applied;           /**< Ticks accepted in sequence order */
+    uint64_t lost;              /**< Sequence numbers skipped by accepted ticks */
+    uint64_t stale;             /**< Duplicate or reordered ticks dropped */
+    uint64_t invalid;           /**< Datagrams that failed to decode */
+    uint64_t resyncs;           /**< Broadcaster restarts detected */
+} binary_clock_receiver_stats_t;
+
+/**
+ * @brief Receiving side of a tick group
+ */
+typedef struct {
+    int fd;                     /**< UDP socket, -1 when not bound */
+    bool synced;                /**< A tick has been applied */
+    binary_clock_tick_t last;   /**< Most recently applied tick */
+    binary_clock_receiver_stats_t stats;
+} binary_clock_receiver_t;
+
+/**
+ * @brief Reset a receiver's sequence tracking and counters
+ *
+ * Enough on its own to use binary_clock_receiver_apply() with ticks that
+ * arrive by other means; leaves the socket untouched.
+ */
+void binary_clock_receiver_reset(binary_clock_receiver_t* receiver);
+
+/**
+ * @brief Join a multicast group
+ *
+ * Several receivers may join the same group and port on one host.
+ *
+ * @param receiver Receiver to initialize (must not be NULL)
+ * @param group IPv4 multicast group
+ * @param port UDP port
+ * @param interface_address Local interface address, or NULL for any
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_receiver_open(binary_clock_receiver_t* receiver,
+                                                const char* group, uint16_t port,
+                                                const char* interface_address);
+
+/**
+ * @brief Apply a tick with gap detection
+ *
+ * Sequence numbers are compared with serial-number arithmetic, so they may
+ * wrap. A tick behind the last applied one is dropped as stale unless it
+ * is further behind than BINARY_CLOCK_RECEIVER_REORDER_WINDOW, which is
+ * taken as a broadcaster restart.
+ *
+ * @param receiver Receiver (must not be NULL)
+ * @param tick Decoded tick (must not be NULL)
+ * @return Ticks missed just before this one (0 when in order), or -1 when
+ *         the tick was dropped as stale
+ */
+int binary_clock_receiver_apply(binary_clock_receiver_t* receiver, const binary_clock_tick_t* tick);
+
+/**
+ * @brief Wait for the next tick that applies
+ *
+ * Stale and malformed datagrams are counted and skipped.
+ *
+ * @param receiver Open receiver (must not be NULL)
+ * @param tick Applied tick (must not be NULL)
+ * @param gap Ticks missed before it (may be NULL)
+ * @param timeout_ms Milliseconds to wait, or -1 to wait forever
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_TIMEOUT or
+ *         BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_receiver_receive(binary_clock_receiver_t* receiver,
+                                                   binary_clock_tick_t* tick, int* gap,
+                                                   int timeout_ms);
+
+/**
+ * @brief Leave the group and close the socket (safe to call twice)
+ */
+void binary_clock_receiver_close(binary_clock_receiver_t* receiver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_MULTICAST_H */
@@ -0,0 +1,130 @@
+/**
+ * @file binary_clock_patch.h
+ * @brief Binary Clock Patch Streams - JSON Merge Patch deltas for web clients
+ * @version 1.0.0
+ *
+ * A dashboard fed the NDJSON document every second re-parses the whole
+ * thing to learn that a digit or two changed. A patch stream sends that
+ * document once, then RFC 7386 merge patches holding only what changed:
+ *
+ *   {"timestamp":1700000046,"time":"22:14:06","binary":{"seconds":{"units":[0,1,1,0]}}}
+ *
+ * Merge patches replace arrays whole, so a digit is the unit of change.
+ * The `"tens":[...]` and `"units":[...]` fragment for every digit value is
+ * encoded once at initialization; a patch is the timestamp, the time text
+ * and the cached fragments of the digits that changed. Every resync
+ * updates a full document is sent again, so a client that missed an
+ * update, or joined late, is whole again within a bounded time.
+ *
+ * A full document is itself a merge patch that sets every field, so a
+ * client applies every update the same way, from an empty object.
+ * Updates are framed one per line (NDJSON) or as Server-Sent Events.
+ */
+
+#ifndef BINARY_CLOCK_PATCH_H
+#define BINARY_CLOCK_PATCH_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Largest encoded update (a full document in SSE framing)
+ */
+#define BINARY_CLOCK_PATCH_MAX_SIZE (BINARY_CLOCK_RENDER_MAX_SIZE + 16)
+
+/**
+ * @brief Default updates from one full document to the next
+ */
+#define BINARY_CLOCK_PATCH_DEFAULT_RESYNC 60
+
+/**
+ * @brief Size of a cached digit fragment, e.g. "units":[0,1,1,0]
+ */
+#define BINARY_CLOCK_PATCH_FRAGMENT_SIZE 24
+
+/**
+ * @brief Digits of the clock: hours, minutes and seconds, tens and units
+ */
+#define BINARY_CLOCK_PATCH_DIGITS 6
+
+/**
+ * @brief How updates are framed
+ */
+typedef enum {
+    BINARY_CLOCK_PATCH_NDJSON = 0,      /**< One JSON object per line */
+    BINARY_CLOCK_PATCH_SSE = 1          /**< "data: <object>" and a blank line (text/event-stream) */
+} binary_clock_patch_framing_t;
+
+/**
+ * @brief Encoder counters
+ */
+typedef struct {
+    uint64_t documents;         /**< Full documents encoded */
+    uint64_t patches;           /**< Merge patches encoded */
+    uint64_t unchanged;         /**< States skipped because nothing changed */
+    uint64_t bytes;             /**< Bytes encoded, framing included */
+} binary_clock_patch_stats_t;
+
+/**
+ * @brief A patch stream encoder
+ */
+typedef struct {
+    binary_clock_patch_framing_t framing; /**< Update framing */
+    uint32_t resync;            /**< Updates from one full document to the next, 0 = first only */
+    uint32_t since_document;    /**< Patches since the last full document */
+    bool started;               /**< A full document has been encoded */
+    binary_clock_time_t timestamp; /**< Timestamp the client holds */
+    uint8_t digits[BINARY_CLOCK_PATCH_DIGITS]; /**< Digit values the client holds, hours tens first */
+    char fragments[BINARY_CLOCK_PATCH_DIGITS][10][BINARY_CLOCK_PATCH_FRAGMENT_SIZE]; /**< Per digit and value */
+    uint8_t fragment_lengths[BINARY_CLOCK_PATCH_DIGITS][10]; /**< Lengths of fragments */
+    binary_clock_render_fn_t render; /**< Full document kernel, binary_clock_display_render() by default */
+    binary_clock_patch_stats_t stats;
+} binary_clock_patch_t;
+
+/**
+ * @brief Initialize an encoder and its digit fragments
+ *
+ * @param patch Encoder to initialize (must not be NULL)
+ * @param framing Update framing
+ * @param resync Updates from one full document to the next (1 = every
+ *        update is a full document, 0 = only the first one is)
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_OUTPUT for an unknown framing
+ */
+binary_clock_error_t binary_clock_patch_init(binary_clock_patch_t* patch, binary_clock_patch_framing_t framing,
+                                             uint32_t resync);
+
+/**
+ * @brief Make the next update a full document (e.g. for a new subscriber)
+ */
+void binary_clock_patch_resync(binary_clock_patch_t* patch);
+
+/**
+ * @brief Encode the update for a state, if anything changed
+ *
+ * The update is a full document when none was sent yet or a resync is
+ * due, and otherwise a merge patch against the last update encoded. The
+ * encoder records what it encoded, so every returned update must be
+ * written, in order; a state that is never passed in is simply folded
+ * into the next update.
+ *
+ * @param patch Encoder (must not be NULL)
+ * @param state State to send (must not be NULL)
+ * @param output Output buffer (BINARY_CLOCK_PATCH_MAX_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Bytes to write, 0 when nothing changed, or (size_t)-1 on a NULL
+ *         argument, a digit out of range or a buffer too small (the
+ *         encoder is then unchanged)
+ */
+size_t binary_clock_patch_update(binary_clock_patch_t* patch, const binary_clock_state_t* state,
+                                 char* output, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_PATCH_H */
@@ -0,0 +1,137 @@
+/**
+ * @file binary_clock_pipe.h
+ * @brief Binary Clock Pipe Output - Batched frames, vmsplice into pipes
+ * @version 1.0.0
+ *
+ * Bulk output (--range) is rendered straight into large page-aligned
+ * buffers and handed to the kernel a buffer at a time instead of a frame
+ * at a time. When the output is a pipe on Linux, the pipe is enlarged
+ * with F_SETPIPE_SZ and full buffers are passed with vmsplice(), which
+ * maps their pages into the pipe instead of copying them.
+ *
+ * A spliced page stays referenced by the pipe until the reader consumes
+ * it, so it must not be rewritten before then. The writer alternates two
+ * buffers, each exactly the pipe's capacity, and splices only full ones:
+ * once a buffer has entered the pipe entirely, everything queued before
+ * it, including the other buffer, has been read. Partial buffers (an
+ * explicit flush, the end of the output) are copied with write(), and
+ * the buffers are mapped with mmap() so unmapping them at the end never
+ * hands pages still in a pipe to another allocation. Each buffer has a
+ * page of slack past its end, so a frame reserved near the end is still
+ * rendered in place; what overflows is carried to the next buffer after
+ * the full one has been handed over.
+ *
+ * Other outputs, and other systems, get plain write() of full buffers.
+ * Buffers are charged to BINARY_CLOCK_MEM_QUEUES; over its cap the pipe
+ * keeps its size and the buffers shrink to match.
+ */
+
+#ifndef BINARY_CLOCK_PIPE_H
+#define BINARY_CLOCK_PIPE_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pipe capacity asked for
+ *
+ * Both buffers then fit in L2 while frames are rendered into them; 1 MiB
+ * pipes (the unprivileged limit) measured slower in bench_pipe.
+ */
+#define BINARY_CLOCK_PIPE_DEFAULT_SIZE (256 * 1024)
+
+/**
+ * @brief Buffer size when the output is not spliced
+ */
+#define BINARY_CLOCK_PIPE_WRITE_BUFFER_SIZE (64 * 1024)
+
+/**
+ * @brief Largest reservation (the slack past each buffer)
+ */
+#define BINARY_CLOCK_PIPE_RESERVE_MAX 4096
+
+/**
+ * @brief Writer counters
+ */
+typedef struct {
+    uint64_t bytes;             /**< Bytes handed to the kernel */
+    uint64_t spliced;           /**< Buffers passed with vmsplice() */
+    uint64_t written;           /**< Buffers copied with write() */
+    uint64_t system_calls;      /**< vmsplice() and write() calls */
+} binary_clock_pipe_stats_t;
+
+/**
+ * @brief Buffered output to one file descriptor
+ */
+typedef struct {
+    int fd;                     /**< Output */
+    bool splice;                /**< Full buffers go through vmsplice() */
+    char* buffers[2];           /**< Page-aligned buffers plus slack; the second only when splicing */
+    size_t buffer_size;         /**< Bytes per buffer (the pipe capacity when splicing) */
+    int current;                /**< Buffer being filled */
+    size_t used;                /**< Bytes in the current buffer */
+    size_t bytes;               /**< Heap bytes held, charged to BINARY_CLOCK_MEM_QUEUES */
+    binary_clock_pipe_stats_t stats;
+} binary_clock_pipe_writer_t;
+
+/**
+ * @brief Set up a writer
+ *
+ * @param writer Writer to initialize (must not be NULL)
+ * @param fd Output file descriptor
+ * @param pipe_size Pipe capacity to ask for, 0 for BINARY_CLOCK_PIPE_DEFAULT_SIZE
+ * @param allow_splice Use vmsplice() when fd is a pipe and the system has it
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT if out of memory
+ */
+binary_clock_error_t binary_clock_pipe_writer_open(binary_clock_pipe_writer_t* writer, int fd, size_t pipe_size,
+                                                   bool allow_splice);
+
+/**
+ * @brief Space for the next frame, so it can be rendered in place
+ *
+ * Never flushes: the space may run into the buffer's slack. Follow with
+ * binary_clock_pipe_writer_commit().
+ *
+ * @return Space for length bytes, or NULL if length exceeds
+ *         BINARY_CLOCK_PIPE_RESERVE_MAX or the writer is closed
+ */
+char* binary_clock_pipe_writer_reserve(binary_clock_pipe_writer_t* writer, size_t length);
+
+/**
+ * @brief Keep length bytes of the reserved space, flushing a full buffer
+ *
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT
+ */
+binary_clock_error_t binary_clock_pipe_writer_commit(binary_clock_pipe_writer_t* writer, size_t length);
+
+/**
+ * @brief Copy bytes into the writer, flushing full buffers as they fill
+ *
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT
+ */
+binary_clock_error_t binary_clock_pipe_writer_write(binary_clock_pipe_writer_t* writer, const char* data,
+                                                    size_t length);
+
+/**
+ * @brief Hand everything buffered to the kernel
+ *
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT
+ */
+binary_clock_error_t binary_clock_pipe_writer_flush(binary_clock_pipe_writer_t* writer);
+
+/**
+ * @brief Flush and release the buffers (the descriptor stays open)
+ *
+ * @return Result of the final flush
+ */
+binary_clock_error_t binary_clock_pipe_writer_close(binary_clock_pipe_writer_t* writer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_PIPE_H */
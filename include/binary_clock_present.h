@@ -0,0 +1,227 @@
+/**
+ * @file binary_clock_present.h
+ * @brief Binary Clock Presentation - Frames committed at a scheduled instant
+ * @version 1.0.0
+ *
+ * Panels showing the same clock flip in unison only if each one writes its
+ * frame at the same wall-clock instant, not whenever its own render loop
+ * gets there. A presenter separates the two steps:
+ * - stage: render the frame for a presentation time ahead of it
+ * - commit: wait precisely for that time, then emit the staged frame
+ *   with a single write()
+ *
+ * The wait sleeps until shortly before the target and spins through the
+ * last BINARY_CLOCK_PRESENT_SPIN_US. Every commit records how far from
+ * the target the write completed.
+ *
+ * A slow sink (a serial console, a terminal behind a congested link)
+ * drains more slowly than frames arrive, and the frames queued in the
+ * kernel make the display lag by more and more. With a backlog limit set,
+ * commit first asks how many bytes are still queued on the descriptor and
+ * skips the frame when that is over the limit. Every frame repaints the
+ * whole clock, so the next frame that goes out brings the display up to
+ * date and the lag stays within the limit.
+ */
+
+#ifndef BINARY_CLOCK_PRESENT_H
+#define BINARY_CLOCK_PRESENT_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Final stretch of a precise wait that is spun instead of slept
+ */
+#define BINARY_CLOCK_PRESENT_SPIN_US 500
+
+/**
+ * @brief Size of a presenter's staging buffer (prefix plus rendered frame)
+ */
+#define BINARY_CLOCK_PRESENT_FRAME_SIZE (BINARY_CLOCK_RENDER_MAX_SIZE + 64)
+
+/**
+ * @brief Default backlog limit of the CLI's terminal displays: one frame
+ */
+#define BINARY_CLOCK_PRESENT_DEFAULT_BACKLOG BINARY_CLOCK_PRESENT_FRAME_SIZE
+
+/* ========================================================================== */
+/* TIMING                                                                     */
+/* ========================================================================== */
+
+/**
+ * @brief Wall-clock time in microseconds since the epoch
+ */
+int64_t binary_clock_present_now_us(void);
+
+/**
+ * @brief Sleep until a wall-clock time (coarse, scheduler resolution)
+ *
+ * Returns immediately when the time has already passed.
+ */
+void binary_clock_present_sleep_until_us(int64_t wake_at_us);
+
+/**
+ * @brief Wait until a wall-clock time as precisely as possible
+ *
+ * @param target_us Time to wait for, microseconds since the epoch
+ * @return Wall-clock time at which the wait ended
+ */
+int64_t binary_clock_present_wait_until_us(int64_t target_us);
+
+/**
+ * @brief Bytes written to a descriptor that its reader has not taken yet
+ *
+ * Asks the kernel for the output queue of a terminal or serial port
+ * (TIOCOUTQ) or the unread contents of a pipe (FIONREAD).
+ *
+ * @param fd Output file descriptor
+ * @return Bytes queued, or -1 when the descriptor cannot tell (a regular
+ *         file, or a platform without either request)
+ */
+long binary_clock_present_pending_output(int fd);
+
+/* ========================================================================== */
+/* CLOCK SOURCES                                                              */
+/* ========================================================================== */
+
+/**
+ * @brief Time source a presenter schedules against
+ *
+ * Both functions take and return microseconds since the epoch. A source
+ * with NULL functions is the wall clock.
+ */
+typedef struct {
+    int64_t (*now_us)(void* context);                       /**< Current time */
+    int64_t (*wait_until_us)(int64_t target_us, void* context); /**< Wait, return time reached */
+    void* context;                                          /**< Passed to both functions */
+} binary_clock_present_clock_t;
+
+/**
+ * @brief Virtual clock running at a multiple of real time
+ *
+ * With speed 0 the clock runs as fast as possible: waiting jumps straight
+ * to the target, so days of ticks pass in seconds.
+ */
+typedef struct {
+    int64_t virtual_origin_us;  /**< Virtual time at initialization */
+    int64_t real_origin_us;     /**< Wall-clock time at initialization */
+    uint32_t speed;             /**< Multiple of real time, 0 = as fast as possible */
+    int64_t now_us;             /**< Current virtual time (speed 0) */
+} binary_clock_virtual_clock_t;
+
+/**
+ * @brief Start a virtual clock at a given time
+ *
+ * @param clock Virtual clock to initialize (must not be NULL)
+ * @param start_us Initial virtual time, microseconds since the epoch
+ * @param speed Multiple of real time, 0 for as fast as possible
+ */
+void binary_clock_virtual_clock_init(binary_clock_virtual_clock_t* clock, int64_t start_us, uint32_t speed);
+
+/**
+ * @brief Clock source reading a virtual clock
+ *
+ * @param clock Virtual clock that must outlive the returned source
+ * @return Source for binary_clock_presenter_set_clock()
+ */
+binary_clock_present_clock_t binary_clock_virtual_clock_source(binary_clock_virtual_clock_t* clock);
+
+/* ========================================================================== */
+/* PRESENTER                                                                  */
+/* ========================================================================== */
+
+/**
+ * @brief Commit timing statistics
+ */
+typedef struct {
+    uint64_t commits;           /**< Frames committed */
+    uint64_t late;              /**< Commits whose target had passed before waiting */
+    uint64_t skipped;           /**< Frames dropped because the sink was backlogged */
+    long last_backlog;          /**< Bytes queued when the last frame was skipped */
+    int64_t last_error_us;      /**< Completion minus target of the last commit */
+    int64_t max_error_us;       /**< Largest absolute error seen */
+    int64_t total_error_us;     /**< Sum of absolute errors (mean = total / commits) */
+} binary_clock_present_stats_t;
+
+/**
+ * @brief A sink that commits staged frames at their presentation time
+ */
+typedef struct {
+    int fd;                     /**< Output file descriptor */
+    char frame[BINARY_CLOCK_PRESENT_FRAME_SIZE]; /**< Staged frame bytes */
+    size_t length;              /**< Staged frame length */
+    int64_t present_at_us;      /**< Presentation time of the staged frame */
+    bool staged;                /**< A frame is waiting to be committed */
+    binary_clock_present_clock_t clock; /**< Time source, wall clock by default */
+    binary_clock_render_fn_t render; /**< Render kernel, binary_clock_display_render() by default */
+    size_t max_backlog;         /**< Skip frames while more is queued, 0 = never skip (default) */
+    binary_clock_present_stats_t stats;
+} binary_clock_presenter_t;
+
+/**
+ * @brief Initialize a presenter writing to a file descriptor
+ *
+ * The presenter schedules against the wall clock until
+ * binary_clock_presenter_set_clock() selects another source.
+ *
+ * @param presenter Presenter to initialize (must not be NULL)
+ * @param fd Output file descriptor (e.g. 1 for stdout)
+ */
+void binary_clock_presenter_init(binary_clock_presenter_t* presenter, int fd);
+
+/**
+ * @brief Select the time source a presenter schedules against
+ *
+ * @param presenter Presenter (must not be NULL)
+ * @param clock Time source, or NULL for the wall clock
+ */
+void binary_clock_presenter_set_clock(binary_clock_presenter_t* presenter,
+                                      const binary_clock_present_clock_t* clock);
+
+/**
+ * @brief Current time on a presenter's clock, microseconds since the epoch
+ */
+int64_t binary_clock_presenter_now_us(const binary_clock_presenter_t* presenter);
+
+/**
+ * @brief Stage a rendered state for a presentation time
+ *
+ * Replaces any frame staged but not yet committed.
+ *
+ * @param presenter Presenter (must not be NULL)
+ * @param state State to render (must not be NULL)
+ * @param format Render format
+ * @param prefix Bytes emitted before the frame (e.g. a screen clear), or NULL
+ * @param present_at_us Presentation time, microseconds since the epoch
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_presenter_stage(binary_clock_presenter_t* presenter,
+                                                  const binary_clock_state_t* state,
+                                                  binary_clock_render_format_t format,
+                                                  const char* prefix,
+                                                  int64_t present_at_us);
+
+/**
+ * @brief Wait for the staged frame's presentation time and write it
+ *
+ * When max_backlog is set and more than that many bytes are still queued
+ * on the descriptor, the frame is dropped instead: stats.skipped counts
+ * it, the staged frame is discarded and the commit still succeeds.
+ *
+ * @param presenter Presenter with a staged frame (must not be NULL)
+ * @param error_us Completion minus target in microseconds (may be NULL)
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_INVALID_TIME when
+ *         nothing is staged, or BINARY_CLOCK_ERROR_OUTPUT
+ */
+binary_clock_error_t binary_clock_presenter_commit(binary_clock_presenter_t* presenter,
+                                                   int64_t* error_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_PRESENT_H */
@@ -0,0 +1,387 @@
+/**
+ * @file binary_clock_query.h
+ * @brief Binary Clock Queries - The clock at any second, in any zone, over HTTP
+ * @version 1.0.0
+ *
+ * A query asks for the binary state at an arbitrary epoch and zone:
+ *
+ *     GET /at?t=EPOCH&tz=ZONE&fmt=FORMAT
+ *
+ * t is required. tz defaults to UTC and takes tz database names
+ * ("Europe/Berlin") or fixed offsets ("+05:30", URL-encoded as %2B05:30).
+ * fmt is one of the CLI display names: json (default), ndjson, emoji or
+ * binary.
+ *
+ * The answer for a (second, zone, format) never changes, so whole HTTP
+ * responses are cached. The cache is split into shards by key hash, each
+ * an LRU list with its own mutex (pthread, or an SRWLOCK on Windows), so
+ * the cache functions may be called from several threads, lookups on
+ * different shards never contend and an eviction only touches one short
+ * list. Zones are loaded
+ * once (binary_clock_zone.h) and kept, so a miss costs a binary search,
+ * a conversion and a render. A server preloads the zones it serves and
+ * seals the table, so no request loads a file or takes a zone slot.
+ *
+ * The responder counts requests, hits and misses and keeps a log2
+ * histogram of response latency. A small single-threaded HTTP server
+ * (POSIX only) answers one query per connection.
+ */
+
+#ifndef BINARY_CLOCK_QUERY_H
+#define BINARY_CLOCK_QUERY_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+#include <binary_clock_zone.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default listen address and port
+ */
+#define BINARY_CLOCK_QUERY_DEFAULT_ADDRESS "0.0.0.0"
+#define BINARY_CLOCK_QUERY_DEFAULT_PORT 4269
+
+/**
+ * @brief Zones a responder keeps loaded
+ */
+#define BINARY_CLOCK_QUERY_MAX_ZONES 64
+
+/**
+ * @brief Cache shards (a power of two) and default cached responses
+ */
+#define BINARY_CLOCK_QUERY_CACHE_SHARDS 16
+#define BINARY_CLOCK_QUERY_DEFAULT_CACHE_ENTRIES 4096
+
+/**
+ * @brief Largest request head read and largest response written
+ */
+#define BINARY_CLOCK_QUERY_REQUEST_MAX_SIZE 1024
+#define BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE (BINARY_CLOCK_RENDER_MAX_SIZE + 128)
+
+/**
+ * @brief Latency histogram buckets: bucket i counts responses under 2^i ns
+ */
+#define BINARY_CLOCK_QUERY_LATENCY_BUCKETS 40
+
+/**
+ * @brief Buffer size that fits binary_clock_query_report()
+ */
+#define BINARY_CLOCK_QUERY_REPORT_SIZE 256
+
+/* ========================================================================== */
+/* REQUESTS                                                                   */
+/* ========================================================================== */
+
+/**
+ * @brief A parsed query
+ */
+typedef struct {
+    int64_t epoch;              /**< Second asked for */
+    char zone[BINARY_CLOCK_ZONE_NAME_SIZE]; /**< Zone name, "UTC" by default */
+    binary_clock_render_format_t format; /**< Response format */
+} binary_clock_query_request_t;
+
+/**
+ * @brief Parse a request target such as "/at?t=1700000000&tz=Asia/Tokyo"
+ *
+ * Parameters may come in any order; %XX escapes are decoded. Unknown
+ * parameters are ignored.
+ *
+ * @param target Request target (path and query string)
+ * @param length Target length
+ * @param request Parsed query (written only on success)
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_INVALID_TIME for a
+ *         missing or malformed t, or BINARY_CLOCK_ERROR_OUTPUT for another
+ *         path, an unknown format or an overlong zone name
+ */
+binary_clock_error_t binary_clock_query_parse(const char* target, size_t length, binary_clock_query_request_t* request);
+
+/* ========================================================================== */
+/* RESPONSE CACHE                                                             */
+/* ========================================================================== */
+
+/**
+ * @brief No entry (end of a list or chain)
+ */
+#define BINARY_CLOCK_QUERY_CACHE_NONE UINT32_MAX
+
+/**
+ * @brief One cached response
+ */
+typedef struct {
+    int64_t second;             /**< Key: epoch second */
+    uint16_t zone;              /**< Key: zone index in the responder */
+    uint16_t format;            /**< Key: render format */
+    uint32_t newer;             /**< LRU neighbours within the shard */
+    uint32_t older;
+    uint32_t chain;             /**< Next entry in the same hash bucket */
+    uint32_t length;            /**< Response length */
+    char data[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE]; /**< Response bytes */
+} binary_clock_query_entry_t;
+
+/**
+ * @brief One lock-protected LRU list
+ */
+typedef struct {
+    void* lock;                 /**< Its mutex, held for every lookup, insert and stats read */
+    binary_clock_query_entry_t* entries; /**< Entry slots */
+    uint32_t* buckets;          /**< Hash buckets: first entry of each chain */
+    uint32_t capacity;          /**< Entry slots */
+    uint32_t count;             /**< Entries in use */
+    uint32_t bucket_mask;       /**< Buckets - 1 */
+    uint32_t newest;            /**< Most recently used entry */
+    uint32_t oldest;            /**< Least recently used entry, evicted first */
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} binary_clock_query_shard_t;
+
+/**
+ * @brief Responses cached by (second, zone, format)
+ */
+typedef struct {
+    binary_clock_query_shard_t shards[BINARY_CLOCK_QUERY_CACHE_SHARDS];
+    size_t bytes;               /**< Heap bytes held, charged to BINARY_CLOCK_MEM_CACHES */
+    void* locks;                /**< The shards' mutexes (platform type), NULL when freed */
+} binary_clock_query_cache_t;
+
+/**
+ * @brief Cache counters summed over the shards
+ */
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t entries;             /**< Responses cached now */
+    size_t capacity;            /**< Responses the cache holds at most */
+} binary_clock_query_cache_stats_t;
+
+/**
+ * @brief Allocate a cache
+ *
+ * The entries are split evenly over the shards. While the memory would
+ * exceed the caches cap (binary_clock_mem.h), the entry count is halved,
+ * down to one entry per shard. Every shard gets its lock, also with 0
+ * entries.
+ *
+ * @param cache Cache to initialize (must not be NULL)
+ * @param entries Responses to hold, 0 for no cache (every lookup misses)
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT if out of memory
+ *         or a lock cannot be created
+ */
+binary_clock_error_t binary_clock_query_cache_init(binary_clock_query_cache_t* cache, size_t entries);
+
+/**
+ * @brief Copy out a cached response and mark it most recently used
+ *
+ * @return Response length, 0 on a miss or if it does not fit in size
+ */
+size_t binary_clock_query_cache_get(binary_clock_query_cache_t* cache, int64_t second, uint16_t zone,
+                                    uint16_t format, char* output, size_t size);
+
+/**
+ * @brief Cache a response, evicting the shard's least recently used one
+ *        when the shard is full
+ */
+void binary_clock_query_cache_put(binary_clock_query_cache_t* cache, int64_t second, uint16_t zone,
+                                  uint16_t format, const char* data, size_t length);
+
+/**
+ * @brief Counters summed over the shards
+ */
+binary_clock_query_cache_stats_t binary_clock_query_cache_get_stats(binary_clock_query_cache_t* cache);
+
+/**
+ * @brief Free the cache and destroy its locks
+ *
+ * A freed cache misses every lookup and may be freed again. No other
+ * thread may be using the cache.
+ */
+void binary_clock_query_cache_free(binary_clock_query_cache_t* cache);
+
+/* ========================================================================== */
+/* RESPONDER                                                                  */
+/* ========================================================================== */
+
+/**
+ * @brief Responder counters
+ */
+typedef struct {
+    uint64_t requests;          /**< Requests answered */
+    uint64_t hits;              /**< Answered from the cache */
+    uint64_t misses;            /**< Converted and rendered */
+    uint64_t bad_requests;      /**< Answered 400 */
+    uint64_t not_found;         /**< Answered 404 (other paths, unknown zones) */
+    uint64_t unavailable;       /**< Answered 503 (zone table full) */
+    uint64_t latency_ns;        /**< Total time spent responding */
+    uint64_t latency[BINARY_CLOCK_QUERY_LATENCY_BUCKETS]; /**< Responses per log2 ns bucket */
+} binary_clock_query_stats_t;
+
+/**
+ * @brief Answers queries from its zones and cache
+ */
+typedef struct {
+    binary_clock_zone_t zones[BINARY_CLOCK_QUERY_MAX_ZONES]; /**< Loaded zones */
+    size_t zone_count;          /**< Loaded zones */
+    bool zones_sealed;          /**< Requests get loaded zones only */
+    const char* zone_directory; /**< Zone files, NULL for TZDIR or the default */
+    binary_clock_query_cache_t cache; /**< Encoded responses */
+    binary_clock_render_fn_t render; /**< Render kernel, binary_clock_display_render() by default */
+    binary_clock_query_stats_t stats;
+} binary_clock_query_t;
+
+/**
+ * @brief Set up a responder with UTC loaded
+ *
+ * @param query Responder to initialize (must not be NULL)
+ * @param cache_entries Responses to cache, 0 for none
+ * @param zone_directory Zone files, NULL for TZDIR or the default
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_query_init(binary_clock_query_t* query, size_t cache_entries,
+                                             const char* zone_directory);
+
+/**
+ * @brief Load a zone now, so no request pays for it
+ *
+ * Until binary_clock_query_seal_zones(), zones not preloaded are loaded
+ * by the first request that names them.
+ *
+ * @param query Responder (must not be NULL)
+ * @param name Zone name
+ * @param index Zone index (may be NULL)
+ * @return BINARY_CLOCK_SUCCESS, a binary_clock_zone_load() error, or
+ *         BINARY_CLOCK_ERROR_OUTPUT when BINARY_CLOCK_QUERY_MAX_ZONES are loaded
+ */
+binary_clock_error_t binary_clock_query_add_zone(binary_clock_query_t* query, const char* name, size_t* index);
+
+/**
+ * @brief Serve the loaded zones only
+ *
+ * After this a request naming any other zone is answered 404, so
+ * requests never load zone files and cannot use up the zone table.
+ */
+void binary_clock_query_seal_zones(binary_clock_query_t* query);
+
+/**
+ * @brief Find the zone a request names, loading it if the table allows
+ *
+ * @param query Responder (must not be NULL)
+ * @param name Zone name
+ * @param index Zone index, set when 200 is returned
+ * @return HTTP status: 200, 404 for a zone that does not exist or is not
+ *         served (sealed), or 503 when the zone table is full
+ */
+int binary_clock_query_resolve_zone(binary_clock_query_t* query, const char* name, size_t* index);
+
+/**
+ * @brief Answer one request target with a complete HTTP response
+ *
+ * 200 with the rendered state, 400 for a malformed query, 404 for
+ * another path or an unknown zone, 503 when the zone table is full.
+ *
+ * @param query Responder (must not be NULL)
+ * @param target Request target
+ * @param length Target length
+ * @param output Response buffer
+ * @param size Response buffer size (BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE always suffices)
+ * @return Response length, 0 if the buffer is too small
+ */
+size_t binary_clock_query_respond(binary_clock_query_t* query, const char* target, size_t length,
+                                  char* output, size_t size);
+
+/**
+ * @brief Content type of 200 responses in a format
+ *
+ * @return A MIME type such as "application/json"
+ */
+const char* binary_clock_query_content_type(binary_clock_render_format_t format);
+
+/**
+ * @brief Upper bound of the latency below which a share of responses fell
+ *
+ * @param stats Responder counters
+ * @param percent Share of responses, 0-100
+ * @return Nanoseconds (a power of two), 0 before any response
+ */
+uint64_t binary_clock_query_latency_percentile(const binary_clock_query_stats_t* stats, double percent);
+
+/**
+ * @brief One-line summary: requests, hit rate, mean, p50 and p99 latency
+ *
+ * @return Length written (truncated to fit)
+ */
+size_t binary_clock_query_report(const binary_clock_query_t* query, char* buffer, size_t size);
+
+/**
+ * @brief Free the zones and the cache
+ */
+void binary_clock_query_free(binary_clock_query_t* query);
+
+/* ========================================================================== */
+/* SERVER                                                                     */
+/* ========================================================================== */
+
+/**
+ * @brief One HTTP connection
+ */
+typedef struct {
+    int fd;                     /**< Socket, -1 once closed */
+    size_t received;            /**< Request bytes read */
+    size_t sent;                /**< Response bytes written */
+    size_t response_length;     /**< Response length, 0 until answered */
+    char request[BINARY_CLOCK_QUERY_REQUEST_MAX_SIZE];
+    char response[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE];
+} binary_clock_query_connection_t;
+
+/**
+ * @brief An HTTP server answering /at queries
+ */
+typedef struct {
+    int listen_fd;              /**< Listening socket, -1 when closed */
+    uint16_t port;              /**< Bound port (resolved when 0 was requested) */
+    binary_clock_query_t* query; /**< Responder */
+    binary_clock_query_connection_t* connections; /**< Open connections */
+    size_t connection_count;
+    size_t connection_capacity;
+    void* poll_set;             /**< poll() set, sized with the connections */
+} binary_clock_query_server_t;
+
+/**
+ * @brief Start listening for queries
+ *
+ * @param server Server to initialize (must not be NULL)
+ * @param query Responder the server answers with (must not be NULL)
+ * @param address Local IPv4 address, NULL for all
+ * @param port TCP port, 0 for any free port
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_query_server_open(binary_clock_query_server_t* server, binary_clock_query_t* query,
+                                                    const char* address, uint16_t port);
+
+/**
+ * @brief Accept connections, read requests, write responses
+ *
+ * A connection is answered once its request head is complete and
+ * closed once the response is written.
+ *
+ * @param server Open server (must not be NULL)
+ * @param timeout_ms Longest wait for activity, 0 to not wait, -1 forever
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_TIMEOUT when nothing
+ *         happened, or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_query_server_poll(binary_clock_query_server_t* server, int timeout_ms);
+
+/**
+ * @brief Close every connection and stop listening
+ */
+void binary_clock_query_server_close(binary_clock_query_server_t* server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_QUERY_H */
@@ -0,0 +1,146 @@
+/**
+ * @file binary_clock_sim.h
+ * @brief Binary Clock Fleet Simulation - Many independent clocks stepped at once
+ * @version 1.0.0
+ *
+ * Steps large fleets of simulated clocks, each with its own offset, drift
+ * and layout, one reference second at a time, for predicting LED wear
+ * (transitions) and power (LED-seconds lit) across a display fleet.
+ *
+ * Clocks are stored as separate arrays (struct of arrays), so a step
+ * streams through memory and several clocks fit in one vector register.
+ * Each clock's LEDs are its packed BCD digits (see
+ * BINARY_CLOCK_PACKED_*_SHIFT) and a step is a BCD add of 0, 1 or 2
+ * seconds done on whole vectors: the digits are biased so each one carries
+ * in binary at its own base (10 or 6), the bias is taken back from digits
+ * that did not carry, and hours wrap at the layout's limit. On GCC and
+ * Clang four clocks are stepped per vector operation (SSE2, NEON); other
+ * compilers step them one at a time with the same arithmetic.
+ *
+ * Drift is a Q32 fraction of a second per reference second, accumulated
+ * per clock: a clock shows an extra second when its phase wraps forward
+ * and skips one when it wraps backward.
+ *
+ * Clocks are independent, so disjoint ranges can be stepped from separate
+ * threads without locking; binary_clock_sim_shard() splits a fleet into
+ * ranges that never share a cache line. The arrays are charged to
+ * BINARY_CLOCK_MEM_REGISTRY (no lean mode).
+ */
+
+#ifndef BINARY_CLOCK_SIM_H
+#define BINARY_CLOCK_SIM_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Layout flags
+ */
+#define BINARY_CLOCK_SIM_24_HOUR     0x00 /**< Hours 00-23 */
+#define BINARY_CLOCK_SIM_12_HOUR     0x01 /**< Hours 12, 01-11 and a PM LED */
+#define BINARY_CLOCK_SIM_NO_SECONDS  0x02 /**< No seconds columns */
+
+/**
+ * @brief PM LED of 12-hour layouts, above the packed digits
+ */
+#define BINARY_CLOCK_SIM_PM_BIT (1u << 24)
+
+/**
+ * @brief Clocks per shard boundary (one 64-byte line of 32-bit lanes)
+ */
+#define BINARY_CLOCK_SIM_SHARD_ALIGN 16
+
+/**
+ * @brief Largest drift, in parts per million either way
+ */
+#define BINARY_CLOCK_SIM_MAX_DRIFT_PPM 400000.0
+
+/**
+ * @brief A fleet of simulated clocks, one array entry per clock
+ */
+typedef struct {
+    size_t count;               /**< Clocks */
+    size_t capacity;            /**< Entries per array (count rounded up to a shard) */
+    uint32_t* leds;             /**< LEDs lit: packed digits, plus BINARY_CLOCK_SIM_PM_BIT */
+    uint32_t* phase;            /**< Fraction of a second accumulated, Q32 */
+    int32_t* rate;              /**< Drift per reference second, Q32 */
+    uint8_t* layout;            /**< BINARY_CLOCK_SIM_* flags */
+    uint32_t* changed;          /**< Visible LEDs that changed in the last step */
+    uint32_t* toggles;          /**< LED transitions so far (NULL unless accumulating) */
+    uint32_t* lit;              /**< LED-seconds lit so far (NULL unless accumulating) */
+    void* block;                /**< Allocation holding every array */
+    size_t bytes;               /**< Heap bytes held, charged to BINARY_CLOCK_MEM_REGISTRY */
+} binary_clock_sim_t;
+
+/**
+ * @brief Allocate a fleet; every clock starts at 00:00:00, 24-hour, no drift
+ *
+ * @param sim Fleet to initialize (must not be NULL)
+ * @param count Number of clocks
+ * @param accumulate Keep per-clock toggles and lit counters (32 bits, so
+ *        lit wraps after about five years of simulated time)
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_OUTPUT if out of memory
+ */
+binary_clock_error_t binary_clock_sim_init(binary_clock_sim_t* sim, size_t count, bool accumulate);
+
+/**
+ * @brief Set one clock
+ *
+ * @param sim Fleet
+ * @param index Clock index
+ * @param epoch_seconds Reference time the fleet is at
+ * @param offset_seconds Offset of this clock from UTC, errors included
+ * @param drift_ppm Rate error; positive runs fast
+ * @param layout BINARY_CLOCK_SIM_* flags
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_INVALID_TIME for a bad index, drift or layout
+ */
+binary_clock_error_t binary_clock_sim_set_clock(binary_clock_sim_t* sim, size_t index, int64_t epoch_seconds,
+                                                int32_t offset_seconds, double drift_ppm, uint8_t layout);
+
+/**
+ * @brief Advance every clock by one reference second
+ */
+void binary_clock_sim_step(binary_clock_sim_t* sim);
+
+/**
+ * @brief Advance clocks [first, first + count) by steps reference seconds
+ *
+ * Safe to call from several threads at once on disjoint ranges. After
+ * the call, changed holds each clock's mask from its last step.
+ */
+void binary_clock_sim_step_range(binary_clock_sim_t* sim, size_t first, size_t count, uint32_t steps);
+
+/**
+ * @brief Range of clocks for one of shards threads
+ *
+ * Boundaries are multiples of BINARY_CLOCK_SIM_SHARD_ALIGN; the last
+ * shard takes the rest. Empty ranges are possible for tiny fleets.
+ */
+void binary_clock_sim_shard(const binary_clock_sim_t* sim, unsigned shard, unsigned shards, size_t* first,
+                            size_t* count);
+
+/**
+ * @brief State a clock shows (12-hour clocks give their 12-hour digits)
+ *
+ * @param timestamp Timestamp to store in the state
+ * @return State, or state with timestamp=0 for a bad index
+ */
+binary_clock_state_t binary_clock_sim_state(const binary_clock_sim_t* sim, size_t index,
+                                            binary_clock_time_t timestamp);
+
+/**
+ * @brief Release the arrays
+ */
+void binary_clock_sim_free(binary_clock_sim_t* sim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_SIM_H */
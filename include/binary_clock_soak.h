@@ -0,0 +1,92 @@
+/**
+ * @file binary_clock_soak.h
+ * @brief Binary Clock Soak Checking - Validation of rendered output streams
+ * @version 1.0.0
+ *
+ * Checks a stream of rendered frames, one per presented second, the way a
+ * person watching for days would: every frame must be well formed, show
+ * the time of its second, and no second may be skipped or shown twice.
+ * Frames are parsed back from their bytes, so rendering and output bugs
+ * are caught as well as scheduling bugs.
+ *
+ * Every render format is understood: the frame's "HH:MM:SS" text is read
+ * first, then the 21 LED bits that follow it ('0'/'1' or 🌚/🌝), which must
+ * agree with the text. JSON frames must also carry the right timestamp.
+ */
+
+#ifndef BINARY_CLOCK_SOAK_H
+#define BINARY_CLOCK_SOAK_H
+
+#include <binary_clock_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Soak-test counters
+ */
+typedef struct {
+    uint64_t frames;            /**< Frames checked */
+    uint64_t bytes;             /**< Frame bytes checked */
+    uint64_t malformed;         /**< Unparseable or self-contradicting frames */
+    uint64_t mismatched;        /**< Well-formed frames showing the wrong time */
+    uint64_t skipped;           /**< Seconds that got no frame */
+    uint64_t duplicated;        /**< Seconds presented more than once (or out of order) */
+    uint64_t rollovers;         /**< Midnight rollovers seen */
+    uint64_t offset_changes;    /**< UTC offset changes (e.g. DST) seen */
+} binary_clock_soak_stats_t;
+
+/**
+ * @brief Soak checker state
+ */
+typedef struct {
+    binary_clock_soak_stats_t stats;
+    bool started;               /**< A frame has been checked */
+    int64_t last_epoch;         /**< Second of the previous frame */
+    int32_t last_offset;        /**< UTC offset of the previous frame */
+    uint32_t last_packed;       /**< Packed state shown by the previous frame */
+    int64_t first_failure_epoch; /**< Second of the first failure */
+    char first_failure[96];     /**< Description of the first failure, "" if none */
+} binary_clock_soak_t;
+
+/**
+ * @brief Reset a soak checker
+ */
+void binary_clock_soak_init(binary_clock_soak_t* soak);
+
+/**
+ * @brief Parse a rendered frame back into the state it shows
+ *
+ * @param frame Frame bytes (need not be NUL-terminated)
+ * @param length Frame length
+ * @param packed Packed state shown by the frame (must not be NULL)
+ * @param timestamp Timestamp carried by the frame, or -1 when the format
+ *        has none (may be NULL)
+ * @return true if the frame is well formed and its bits match its text
+ */
+bool binary_clock_soak_parse_frame(const char* frame, size_t length, uint32_t* packed, int64_t* timestamp);
+
+/**
+ * @brief Check the frame presented for one second
+ *
+ * @param soak Soak checker (must not be NULL)
+ * @param frame Frame bytes as written to the output
+ * @param length Frame length
+ * @param epoch Second the frame was scheduled for
+ * @param utc_offset_seconds UTC offset in effect at that second
+ * @return true if the frame passed every check
+ */
+bool binary_clock_soak_check_frame(binary_clock_soak_t* soak, const char* frame, size_t length,
+                                   int64_t epoch, int32_t utc_offset_seconds);
+
+/**
+ * @brief Whether every frame checked so far passed
+ */
+bool binary_clock_soak_passed(const binary_clock_soak_t* soak);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_SOAK_H */
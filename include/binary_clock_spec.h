@@ -0,0 +1,177 @@
+/* Generated by scripts/gen-spec.py from docs/binary_clock_api_spec.json - do not edit. */
+/**
+ * @file binary_clock_spec.h
+ * @brief Binary Clock Spec Serializers - Codecs and budgets generated from the API spec
+ * @version 1.0.0
+ *
+ * Every data structure in docs/binary_clock_api_spec.json gets two codecs:
+ * - record: fixed-size little-endian bytes, one per uint8_t field, the
+ *   six bits as one MSB-first byte, timestamps as int64
+ * - JSON: one compact object with the spec's field names, in spec order
+ *
+ * Encoders check the buffer once against the largest encoding and then
+ * write every field without branching on it. Decoders take exactly what
+ * the encoders write, and check every field constraint the spec gives.
+ *
+ * Field constraints and per-function budgets are exported as constants,
+ * so code and benchmarks follow the spec when it changes.
+ */
+
+#ifndef BINARY_CLOCK_SPEC_H
+#define BINARY_CLOCK_SPEC_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Spec version the codecs were generated from
+ */
+#define BINARY_CLOCK_SPEC_VERSION "1.0.0"
+
+/* ========================================================================== */
+/* FIELD CONSTRAINTS                                                          */
+/* ========================================================================== */
+
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_BIT_COUNT_MIN 1
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_BIT_COUNT_MAX 6
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_BITS_LENGTH 6
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_DECIMAL_VALUE_MIN 0
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_DECIMAL_VALUE_MAX 63
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_HOURS_MIN 0
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_HOURS_MAX 23
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_MINUTES_MIN 0
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_MINUTES_MAX 59
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_SECONDS_MIN 0
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_SECONDS_MAX 59
+#define BINARY_CLOCK_SPEC_STATE_HOURS_TENS_BIT_COUNT 3
+#define BINARY_CLOCK_SPEC_STATE_HOURS_UNITS_BIT_COUNT 4
+#define BINARY_CLOCK_SPEC_STATE_MINUTES_TENS_BIT_COUNT 3
+#define BINARY_CLOCK_SPEC_STATE_MINUTES_UNITS_BIT_COUNT 4
+#define BINARY_CLOCK_SPEC_STATE_SECONDS_TENS_BIT_COUNT 3
+#define BINARY_CLOCK_SPEC_STATE_SECONDS_UNITS_BIT_COUNT 4
+
+/* ========================================================================== */
+/* FUNCTION BUDGETS                                                           */
+/* ========================================================================== */
+
+/* max_execution_time_ms and typical_execution_time_us per call, in nanoseconds */
+#define BINARY_CLOCK_SPEC_BUDGET_NS_GET_CURRENT_STATE 1000000LL
+#define BINARY_CLOCK_SPEC_TYPICAL_NS_GET_CURRENT_STATE 50000LL
+#define BINARY_CLOCK_SPEC_BUDGET_NS_STATE_FROM_TIME 1000000LL
+#define BINARY_CLOCK_SPEC_TYPICAL_NS_STATE_FROM_TIME 10000LL
+#define BINARY_CLOCK_SPEC_BUDGET_NS_GET_CURRENT_TIME 1000000LL
+#define BINARY_CLOCK_SPEC_TYPICAL_NS_GET_CURRENT_TIME 20000LL
+#define BINARY_CLOCK_SPEC_BUDGET_NS_TO_BINARY 1000000LL
+#define BINARY_CLOCK_SPEC_TYPICAL_NS_TO_BINARY 5000LL
+#define BINARY_CLOCK_SPEC_BUDGET_NS_TO_DECIMAL 1000000LL
+#define BINARY_CLOCK_SPEC_TYPICAL_NS_TO_DECIMAL 5000LL
+
+/* ========================================================================== */
+/* CODECS                                                                     */
+/* ========================================================================== */
+
+/**
+ * @brief binary_value_t: record size and largest JSON encoding
+ */
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_RECORD_SIZE 3
+#define BINARY_CLOCK_SPEC_BINARY_VALUE_JSON_MAX_SIZE 82
+
+/**
+ * @brief time_components_t: record size and largest JSON encoding
+ */
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_RECORD_SIZE 3
+#define BINARY_CLOCK_SPEC_TIME_COMPONENTS_JSON_MAX_SIZE 41
+
+/**
+ * @brief binary_clock_state_t: record size and largest JSON encoding
+ */
+#define BINARY_CLOCK_SPEC_STATE_RECORD_SIZE 26
+#define BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE 621
+
+/**
+ * @brief Encode a binary_value_t as a record
+ * @return Bytes written (BINARY_CLOCK_SPEC_BINARY_VALUE_RECORD_SIZE), 0 on NULL or a small buffer
+ */
+size_t binary_clock_spec_encode_binary_value_record(const binary_value_t* binary_value, uint8_t* output, size_t size);
+
+/**
+ * @brief Decode a record into a binary_value_t
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER,
+ *         BINARY_CLOCK_ERROR_OUTPUT for a malformed record, or the error for
+ *         a field outside its spec constraints (the output is left untouched)
+ */
+binary_clock_error_t binary_clock_spec_decode_binary_value_record(const uint8_t* input, size_t length, binary_value_t* binary_value);
+
+/**
+ * @brief Encode a binary_value_t as JSON (not NUL-terminated)
+ * @return Bytes written, 0 on NULL or a buffer smaller than BINARY_CLOCK_SPEC_BINARY_VALUE_JSON_MAX_SIZE
+ */
+size_t binary_clock_spec_encode_binary_value_json(const binary_value_t* binary_value, char* output, size_t size);
+
+/**
+ * @brief Decode JSON written by binary_clock_spec_encode_binary_value_json()
+ * @return As binary_clock_spec_decode_binary_value_record()
+ */
+binary_clock_error_t binary_clock_spec_decode_binary_value_json(const char* input, size_t length, binary_value_t* binary_value);
+
+/**
+ * @brief Encode a time_components_t as a record
+ * @return Bytes written (BINARY_CLOCK_SPEC_TIME_COMPONENTS_RECORD_SIZE), 0 on NULL or a small buffer
+ */
+size_t binary_clock_spec_encode_time_components_record(const time_components_t* time_components, uint8_t* output, size_t size);
+
+/**
+ * @brief Decode a record into a time_components_t
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER,
+ *         BINARY_CLOCK_ERROR_OUTPUT for a malformed record, or the error for
+ *         a field outside its spec constraints (the output is left untouched)
+ */
+binary_clock_error_t binary_clock_spec_decode_time_components_record(const uint8_t* input, size_t length, time_components_t* time_components);
+
+/**
+ * @brief Encode a time_components_t as JSON (not NUL-terminated)
+ * @return Bytes written, 0 on NULL or a buffer smaller than BINARY_CLOCK_SPEC_TIME_COMPONENTS_JSON_MAX_SIZE
+ */
+size_t binary_clock_spec_encode_time_components_json(const time_components_t* time_components, char* output, size_t size);
+
+/**
+ * @brief Decode JSON written by binary_clock_spec_encode_time_components_json()
+ * @return As binary_clock_spec_decode_time_components_record()
+ */
+binary_clock_error_t binary_clock_spec_decode_time_components_json(const char* input, size_t length, time_components_t* time_components);
+
+/**
+ * @brief Encode a binary_clock_state_t as a record
+ * @return Bytes written (BINARY_CLOCK_SPEC_STATE_RECORD_SIZE), 0 on NULL or a small buffer
+ */
+size_t binary_clock_spec_encode_state_record(const binary_clock_state_t* state, uint8_t* output, size_t size);
+
+/**
+ * @brief Decode a record into a binary_clock_state_t
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER,
+ *         BINARY_CLOCK_ERROR_OUTPUT for a malformed record, or the error for
+ *         a field outside its spec constraints (the output is left untouched)
+ */
+binary_clock_error_t binary_clock_spec_decode_state_record(const uint8_t* input, size_t length, binary_clock_state_t* state);
+
+/**
+ * @brief Encode a binary_clock_state_t as JSON (not NUL-terminated)
+ * @return Bytes written, 0 on NULL or a buffer smaller than BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE
+ */
+size_t binary_clock_spec_encode_state_json(const binary_clock_state_t* state, char* output, size_t size);
+
+/**
+ * @brief Decode JSON written by binary_clock_spec_encode_state_json()
+ * @return As binary_clock_spec_decode_state_record()
+ */
+binary_clock_error_t binary_clock_spec_decode_state_json(const char* input, size_t length, binary_clock_state_t* state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_SPEC_H */
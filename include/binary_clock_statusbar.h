@@ -0,0 +1,95 @@
+/**
+ * @file binary_clock_statusbar.h
+ * @brief Binary Clock Status Bars - Persistent i3bar/swaybar and tmux producers
+ * @version 1.0.0
+ *
+ * Status bars that run a command every second pay for a process spawn,
+ * dynamic linking and a timezone load each time. A producer runs once
+ * and writes an update only when the visible text changes:
+ * - i3bar/swaybar: the JSON streaming protocol (header, then an endless
+ *   array of status lines, one block each)
+ * - tmux: one plain line per change, for `#()` in status-left/right
+ *
+ * Updates are encoded into a caller buffer with the buffer renderer, so
+ * the producer emits each one with a single write().
+ */
+
+#ifndef BINARY_CLOCK_STATUSBAR_H
+#define BINARY_CLOCK_STATUSBAR_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Largest encoded update (i3bar block around a rendered line)
+ */
+#define BINARY_CLOCK_STATUSBAR_MAX_SIZE (BINARY_CLOCK_RENDER_MAX_SIZE + 128)
+
+/**
+ * @brief Status bar protocols
+ */
+typedef enum {
+    BINARY_CLOCK_STATUSBAR_I3BAR = 0,   /**< i3bar/swaybar JSON streaming protocol */
+    BINARY_CLOCK_STATUSBAR_TMUX = 1     /**< One plain line per change */
+} binary_clock_statusbar_protocol_t;
+
+/**
+ * @brief Producer counters
+ */
+typedef struct {
+    uint64_t updates;           /**< Updates encoded */
+    uint64_t unchanged;         /**< States skipped because the text did not change */
+    uint64_t bytes;             /**< Bytes encoded, header included */
+} binary_clock_statusbar_stats_t;
+
+/**
+ * @brief A status bar producer
+ */
+typedef struct {
+    binary_clock_statusbar_protocol_t protocol; /**< Output protocol */
+    binary_clock_render_format_t format; /**< Line format: compact or emoji line */
+    binary_clock_render_fn_t render; /**< Render kernel, binary_clock_display_render() by default */
+    bool started;               /**< Header and first update written */
+    char last[BINARY_CLOCK_RENDER_MAX_SIZE]; /**< Text of the last update */
+    size_t last_length;         /**< Length of the last update's text */
+    binary_clock_statusbar_stats_t stats;
+} binary_clock_statusbar_t;
+
+/**
+ * @brief Initialize a producer
+ *
+ * @param statusbar Producer to initialize (must not be NULL)
+ * @param protocol Output protocol
+ * @param format BINARY_CLOCK_RENDER_COMPACT or BINARY_CLOCK_RENDER_EMOJI_LINE
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_OUTPUT for a protocol or multi-line format
+ *         status bars cannot show
+ */
+binary_clock_error_t binary_clock_statusbar_init(binary_clock_statusbar_t* statusbar,
+                                                 binary_clock_statusbar_protocol_t protocol,
+                                                 binary_clock_render_format_t format);
+
+/**
+ * @brief Encode the update for a state, if its text changed
+ *
+ * The first update of an i3bar producer starts with the protocol header.
+ *
+ * @param statusbar Producer (must not be NULL)
+ * @param state State to show (must not be NULL)
+ * @param output Output buffer (BINARY_CLOCK_STATUSBAR_MAX_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Bytes to write, 0 when the text is unchanged, or (size_t)-1 on
+ *         a NULL argument or a buffer too small
+ */
+size_t binary_clock_statusbar_update(binary_clock_statusbar_t* statusbar, const binary_clock_state_t* state,
+                                     char* output, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_STATUSBAR_H */
@@ -0,0 +1,262 @@
+/**
+ * @file binary_clock_stream.h
+ * @brief Binary Clock Streaming - Live terminal clock for many TCP clients
+ * @version 1.0.0
+ *
+ * A stream server keeps the terminal of every connected client (telnet,
+ * nc, ...) showing the live clock. Each tick is encoded once into two
+ * shared, reference-counted frames:
+ * - a diff that rewrites only the characters that changed
+ * - a full repaint that clears the screen and draws every line
+ *
+ * Clients whose screen shows the previous tick are sent the shared diff.
+ * Clients that are behind - just connected, or still writing an older
+ * frame when a tick arrived - finish that frame and then get the full
+ * repaint of the current tick. No per-client encoding happens.
+ *
+ * Memory stays small with many idle clients: a client is a 32-byte slot
+ * plus its poll entry, and frames come from per-server slabs in fixed
+ * size classes, recycled once their last reference goes, so steady
+ * ticking allocates nothing. Slabs count as caches and client slots as
+ * queues in binary_clock_mem.h, whose caps make both grow in smaller
+ * steps.
+ *
+ * Under a connection stampede the server keeps serving the clients it
+ * has: they are flushed before any new connection is accepted, accepts
+ * are taken in bounded batches, and optional admission limits
+ * (binary_clock_admit.h) turn surplus connections away with a one-line
+ * busy notice instead of a screen.
+ *
+ * Sockets are supported on POSIX systems; on Windows the open function
+ * returns BINARY_CLOCK_ERROR_NETWORK while frame encoding works everywhere.
+ */
+
+#ifndef BINARY_CLOCK_STREAM_H
+#define BINARY_CLOCK_STREAM_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+#include <binary_clock_admit.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default listen address and port
+ */
+#define BINARY_CLOCK_STREAM_DEFAULT_ADDRESS "0.0.0.0"
+#define BINARY_CLOCK_STREAM_DEFAULT_PORT 4268
+
+/**
+ * @brief Largest encoded frame (every line repainted, CR LF line ends)
+ */
+#define BINARY_CLOCK_STREAM_FRAME_MAX_SIZE (2 * BINARY_CLOCK_RENDER_MAX_SIZE + 64)
+
+/**
+ * @brief New connections taken per poll; the rest wait in the backlog
+ */
+#define BINARY_CLOCK_STREAM_ACCEPT_BATCH 64
+
+/**
+ * @brief Sent to a connection the admission limits turn away
+ */
+#define BINARY_CLOCK_STREAM_BUSY_MESSAGE "binary_clock: server busy, try again later\r\n"
+
+/* ========================================================================== */
+/* FRAME ENCODING                                                             */
+/* ========================================================================== */
+
+/**
+ * @brief Encode a full repaint of a rendered screen
+ *
+ * Homes the cursor, clears the screen and writes every line with CR LF
+ * line ends, as network terminals expect.
+ *
+ * @param screen Rendered screen ('\n' separated lines)
+ * @param length Screen length
+ * @param output Output buffer
+ * @param size Output buffer size
+ * @return Bytes written, 0 if the buffer is too small
+ */
+size_t binary_clock_stream_encode_full(const char* screen, size_t length, char* output, size_t size);
+
+/**
+ * @brief Encode the repaint that turns one rendered screen into another
+ *
+ * Only the characters that changed are rewritten: for each changed line
+ * the cursor moves to the first changed column and the changed span is
+ * written (or the rest of the line, then erase to end of line, when the
+ * span changes width). Lines the new screen no longer has are erased.
+ * Emoji count as two terminal columns.
+ *
+ * @param previous Screen the terminal shows
+ * @param previous_length Previous screen length
+ * @param screen Screen to show
+ * @param length Screen length
+ * @param output Output buffer
+ * @param size Output buffer size
+ * @return Bytes written (0 when nothing changed), or (size_t)-1 if the
+ *         buffer is too small
+ */
+size_t binary_clock_stream_encode_diff(const char* previous, size_t previous_length,
+                                       const char* screen, size_t length,
+                                       char* output, size_t size);
+
+/* ========================================================================== */
+/* SERVER                                                                     */
+/* ========================================================================== */
+
+/**
+ * @brief Frame size classes: data capacity of the frames in each class
+ */
+#define BINARY_CLOCK_STREAM_FRAME_CLASSES 3
+#define BINARY_CLOCK_STREAM_FRAME_CLASS_SIZES {128, 512, BINARY_CLOCK_STREAM_FRAME_MAX_SIZE}
+
+/**
+ * @brief Bytes per frame slab (each slab holds frames of one class)
+ */
+#define BINARY_CLOCK_STREAM_SLAB_SIZE 4096
+
+/**
+ * @brief Encoded bytes shared by every client they are sent to
+ */
+typedef struct binary_clock_stream_frame {
+    struct binary_clock_stream_frame* next_free; /**< Free-list link while pooled */
+    uint32_t refs;              /**< Holders: the server and each client writing it */
+    uint32_t size_class;        /**< Size class the frame was carved for */
+    uint64_t tick;              /**< Tick the frame leaves the screen showing, 0 = none */
+    size_t length;              /**< Frame length */
+    char data[];                /**< Frame bytes */
+} binary_clock_stream_frame_t;
+
+/**
+ * @brief Frames recycled per size class
+ */
+typedef struct {
+    binary_clock_stream_frame_t* free[BINARY_CLOCK_STREAM_FRAME_CLASSES]; /**< Free frames per class */
+    void* slabs;                /**< Allocated slabs, freed on close */
+    size_t bytes;               /**< Bytes held in slabs */
+} binary_clock_stream_pool_t;
+
+/**
+ * @brief One connected client
+ */
+typedef struct {
+    int fd;                     /**< Client socket, -1 once disconnected */
+    uint32_t address;           /**< Peer IPv4 address, host byte order */
+    binary_clock_stream_frame_t* sending; /**< Frame being written, NULL when idle */
+    size_t offset;              /**< Bytes of the frame already written */
+    uint64_t shown_tick;        /**< Tick the client's screen shows, 0 = none */
+} binary_clock_stream_client_t;
+
+/**
+ * @brief Server counters
+ */
+typedef struct {
+    uint64_t ticks;             /**< Ticks encoded */
+    uint64_t accepted;          /**< Clients accepted */
+    uint64_t disconnected;      /**< Clients that went away or failed */
+    uint64_t diff_sends;        /**< Diff frames queued */
+    uint64_t full_sends;        /**< Full repaints queued */
+    uint64_t busy;              /**< Ticks a client missed while still writing */
+    uint64_t encoded_bytes;     /**< Bytes encoded (once per tick, shared) */
+    uint64_t sent_bytes;        /**< Bytes written to clients */
+    uint64_t writes;            /**< send() calls */
+} binary_clock_stream_stats_t;
+
+/**
+ * @brief A server streaming the live clock to terminal clients
+ */
+typedef struct {
+    int listen_fd;              /**< Listening socket, -1 when closed */
+    uint16_t port;              /**< Bound port (resolved when 0 was requested) */
+    binary_clock_render_format_t format; /**< Screen render format */
+    binary_clock_render_fn_t render; /**< Render kernel, binary_clock_display_render() by default */
+    uint64_t tick;              /**< Current tick number, 0 before the first */
+    char screen[BINARY_CLOCK_RENDER_MAX_SIZE]; /**< Current rendered screen */
+    size_t screen_length;       /**< Current screen length */
+    binary_clock_stream_frame_t* greeting; /**< Terminal setup sent on connect */
+    binary_clock_stream_frame_t* full;     /**< Full repaint of the current tick */
+    binary_clock_stream_frame_t* diff;     /**< Diff from the previous tick, NULL if none */
+    binary_clock_stream_client_t* clients; /**< Connected clients */
+    size_t client_count;        /**< Connected clients */
+    size_t client_capacity;     /**< Allocated client slots */
+    void* poll_set;             /**< poll() set, sized with the clients */
+    binary_clock_stream_pool_t pool; /**< Frame slabs */
+    binary_clock_admit_t admit; /**< Admission limits, counts and rejections */
+    binary_clock_stream_stats_t stats;
+} binary_clock_stream_server_t;
+
+/**
+ * @brief Start listening for terminal clients
+ *
+ * @param server Server to initialize (must not be NULL)
+ * @param address Local IPv4 address to listen on, NULL for all
+ * @param port TCP port, 0 for any free port
+ * @param format Screen render format (emoji or ascii for terminals)
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_stream_server_open(binary_clock_stream_server_t* server,
+                                                     const char* address, uint16_t port,
+                                                     binary_clock_render_format_t format);
+
+/**
+ * @brief Set admission limits for new connections
+ *
+ * Clients already connected count against the limits but stay.
+ *
+ * @param server Server (must not be NULL)
+ * @param limits Limits, NULL to lift them all
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_stream_server_set_limits(binary_clock_stream_server_t* server,
+                                                           const binary_clock_admit_limits_t* limits);
+
+/**
+ * @brief Show a new state on every client
+ *
+ * Encodes the tick's shared frames and starts writing them to idle
+ * clients; busy clients catch up with a full repaint once idle.
+ *
+ * @param server Open server (must not be NULL)
+ * @param state State to show (must not be NULL)
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_stream_server_tick(binary_clock_stream_server_t* server,
+                                                     const binary_clock_state_t* state);
+
+/**
+ * @brief Accept clients, discard their input and flush pending frames
+ *
+ * @param server Open server (must not be NULL)
+ * @param timeout_ms Longest wait for activity, 0 to not wait, -1 forever
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_TIMEOUT when nothing
+ *         happened, or BINARY_CLOCK_ERROR_NETWORK
+ */
+binary_clock_error_t binary_clock_stream_server_poll(binary_clock_stream_server_t* server, int timeout_ms);
+
+/**
+ * @brief Whether any client still has frame bytes to write
+ */
+bool binary_clock_stream_server_pending(const binary_clock_stream_server_t* server);
+
+/**
+ * @brief Heap bytes the server holds: client slots, poll set, frame slabs
+ *        and per-address counts
+ *
+ * Divided by the connected clients this is the per-connection cost in
+ * this process; the kernel's socket buffers come on top.
+ */
+size_t binary_clock_stream_server_memory(const binary_clock_stream_server_t* server);
+
+/**
+ * @brief Disconnect every client and stop listening
+ */
+void binary_clock_stream_server_close(binary_clock_stream_server_t* server);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_STREAM_H */
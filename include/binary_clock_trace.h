@@ -0,0 +1,127 @@
+/**
+ * @file binary_clock_trace.h
+ * @brief Binary Clock Tracing - Timeline of ticks, callbacks and writes
+ * @version 1.0.0
+ *
+ * Records begin/end events into a bounded in-memory ring and writes them
+ * as Chrome trace-event JSON, which chrome://tracing and Perfetto
+ * (ui.perfetto.dev) open as a timeline with one track per thread.
+ *
+ * The presenter, the stream server and the CLI record their tick
+ * wakeups, state computation, rendering, display callbacks and sink
+ * writes. Tracing is off until binary_clock_trace_start() is called;
+ * while off, each instrumentation point costs one branch. While on, an
+ * event is a cycle counter read and a 32-byte store - cheap enough to
+ * leave on during benchmark runs. When the ring is full the oldest
+ * events are overwritten, so a trace always holds the latest activity.
+ */
+
+#ifndef BINARY_CLOCK_TRACE_H
+#define BINARY_CLOCK_TRACE_H
+
+#include <binary_clock_api.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Ring capacity used when 0 is passed to binary_clock_trace_start()
+ */
+#define BINARY_CLOCK_TRACE_DEFAULT_EVENTS 65536
+
+/**
+ * @brief One recorded event
+ */
+typedef struct {
+    uint64_t timestamp;         /**< Trace clock reading (cycle counter where available) */
+    const char* category;       /**< Category (string literal) */
+    const char* name;           /**< Span name (string literal) */
+    uint32_t thread_id;         /**< Recording thread */
+    char phase;                 /**< 'B' begin or 'E' end */
+} binary_clock_trace_event_t;
+
+/**
+ * @brief Trace counters
+ */
+typedef struct {
+    uint64_t recorded;          /**< Events recorded since start */
+    uint64_t overwritten;       /**< Oldest events lost to the bounded ring */
+    size_t capacity;            /**< Ring capacity in events, 0 when stopped */
+} binary_clock_trace_stats_t;
+
+/**
+ * @brief Start recording into a new ring, discarding any previous trace
+ *
+ * The ring is charged to BINARY_CLOCK_MEM_QUEUES (binary_clock_mem.h);
+ * over its cap the ring is halved until it fits, down to 64 events.
+ *
+ * @param capacity Events kept, 0 for BINARY_CLOCK_TRACE_DEFAULT_EVENTS
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT if the ring
+ *         cannot be allocated
+ */
+binary_clock_error_t binary_clock_trace_start(size_t capacity);
+
+/**
+ * @brief Stop recording and free the ring
+ */
+void binary_clock_trace_stop(void);
+
+/**
+ * @brief Whether events are being recorded
+ */
+bool binary_clock_trace_enabled(void);
+
+/**
+ * @brief Record the start of a span on the calling thread
+ *
+ * Spans nest per thread. Category and name are stored by pointer, so
+ * they must be string literals (or otherwise outlive the trace) and
+ * need no JSON escaping.
+ *
+ * @param category Event category, e.g. "tick" or "sink"
+ * @param name Span name
+ */
+void binary_clock_trace_begin(const char* category, const char* name);
+
+/**
+ * @brief Record the end of the innermost open span on the calling thread
+ *
+ * @param category Event category (same as the matching begin)
+ * @param name Span name (same as the matching begin)
+ */
+void binary_clock_trace_end(const char* category, const char* name);
+
+/**
+ * @brief Current trace counters
+ */
+binary_clock_trace_stats_t binary_clock_trace_get_stats(void);
+
+/**
+ * @brief Write the recorded events as Chrome trace-event JSON
+ *
+ * Events whose begin was overwritten are left out and spans still open
+ * are closed at the last timestamp, so every span in the output is
+ * complete. Safe to call while recording from the same thread; other
+ * threads should be idle.
+ *
+ * @param output Stream to write to (must not be NULL)
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_OUTPUT if writing fails
+ */
+binary_clock_error_t binary_clock_trace_write(FILE* output);
+
+/**
+ * @brief Write the recorded events to a file (see binary_clock_trace_write())
+ *
+ * @param path File to create or replace
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_trace_save(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_TRACE_H */
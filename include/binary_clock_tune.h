@@ -0,0 +1,209 @@
+/**
+ * @file binary_clock_tune.h
+ * @brief Binary Clock Autotuning - Fastest clock source and kernels per host
+ * @version 1.0.0
+ *
+ * The fastest way to read the time and to convert and render a state
+ * differs between x86 generations, ARM boards and VMs. The autotuner
+ * microbenchmarks each candidate for a few milliseconds at startup:
+ * - clock sources: time(), CLOCK_REALTIME, CLOCK_REALTIME_COARSE and the
+ *   CPU cycle counter (TSC / CNTVCT) anchored to CLOCK_REALTIME
+ * - conversion kernels: epoch seconds to state, scalar or table-driven
+ * - render kernels: binary_clock_display_render() or its table variant
+ *
+ * It picks the cheapest of each. A clock source is only eligible if it
+ * resolves BINARY_CLOCK_TUNE_MAX_RESOLUTION_US, so presentation timing
+ * never gets coarser. The decision can be cached in a small text file
+ * keyed by CPU model, so later starts skip the measurements.
+ *
+ * The tables the chosen kernels read are charged to
+ * BINARY_CLOCK_MEM_TABLES (binary_clock_mem.h). When they do not fit
+ * under its cap, the scalar kernels are used and the decision is kept,
+ * so the cache file still records what was fastest.
+ */
+
+#ifndef BINARY_CLOCK_TUNE_H
+#define BINARY_CLOCK_TUNE_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+#include <binary_clock_present.h>
+#include <binary_clock_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Coarsest clock resolution eligible for presentation timing
+ */
+#define BINARY_CLOCK_TUNE_MAX_RESOLUTION_US 50
+
+/**
+ * @brief Default measurement budget for binary_clock_tune_run()
+ */
+#define BINARY_CLOCK_TUNE_DEFAULT_BUDGET_MS 10
+
+/**
+ * @brief Candidate clock sources
+ */
+typedef enum {
+    BINARY_CLOCK_TUNE_CLOCK_TIME = 0,           /**< time(), whole seconds */
+    BINARY_CLOCK_TUNE_CLOCK_REALTIME = 1,       /**< clock_gettime(CLOCK_REALTIME) (the default) */
+    BINARY_CLOCK_TUNE_CLOCK_REALTIME_COARSE = 2, /**< clock_gettime(CLOCK_REALTIME_COARSE), Linux */
+    BINARY_CLOCK_TUNE_CLOCK_CYCLES = 3,         /**< Cycle counter anchored to CLOCK_REALTIME */
+    BINARY_CLOCK_TUNE_CLOCK_COUNT = 4
+} binary_clock_tune_clock_t;
+
+/**
+ * @brief Candidate conversion and render kernels
+ */
+typedef enum {
+    BINARY_CLOCK_TUNE_KERNEL_SCALAR = 0,        /**< Digit by digit, bit by bit */
+    BINARY_CLOCK_TUNE_KERNEL_TABLE = 1,         /**< Pre-computed digit columns */
+    BINARY_CLOCK_TUNE_KERNEL_COUNT = 2
+} binary_clock_tune_kernel_t;
+
+/**
+ * @brief Epoch-to-state conversion kernel signature
+ */
+typedef binary_clock_state_t (*binary_clock_convert_fn_t)(int64_t epoch_seconds, int32_t utc_offset_seconds);
+
+/**
+ * @brief Cycle counter anchored to the wall clock
+ *
+ * Reads convert counter ticks to microseconds since the epoch. The
+ * anchor is refreshed from CLOCK_REALTIME once a second, which also
+ * refines the rate and follows wall-clock adjustments.
+ */
+typedef struct {
+    uint64_t anchor_count;      /**< Counter at the anchor */
+    int64_t anchor_us;          /**< Wall clock at the anchor */
+    uint64_t origin_count;      /**< Counter at calibration (rate baseline) */
+    int64_t origin_us;          /**< Wall clock at calibration */
+    double us_per_count;        /**< Calibrated rate */
+    uint64_t reanchor_counts;   /**< Counter ticks between anchors (about 1 s) */
+} binary_clock_cycle_clock_t;
+
+/**
+ * @brief Autotuner decision and measurements
+ */
+typedef struct {
+    char cpu_model[96];         /**< Cache key: CPU model, "(VM)" under a hypervisor */
+    binary_clock_tune_clock_t clock; /**< Chosen clock source */
+    binary_clock_tune_kernel_t convert; /**< Chosen conversion kernel */
+    binary_clock_tune_kernel_t render;  /**< Chosen render kernel */
+    double clock_ns[BINARY_CLOCK_TUNE_CLOCK_COUNT]; /**< Cost per read, 0 = unavailable */
+    int64_t clock_resolution_ns[BINARY_CLOCK_TUNE_CLOCK_COUNT]; /**< Resolution, 0 = unavailable */
+    double convert_ns[BINARY_CLOCK_TUNE_KERNEL_COUNT]; /**< Cost per conversion */
+    double render_ns[BINARY_CLOCK_TUNE_KERNEL_COUNT];  /**< Cost per render (all formats) */
+    double tuning_ms;           /**< Time spent measuring, 0 when loaded */
+    bool cached;                /**< Decision loaded from the cache file */
+    binary_clock_cycle_clock_t cycles; /**< Cycle clock state (when available) */
+    size_t table_bytes;         /**< Table bytes charged to BINARY_CLOCK_MEM_TABLES */
+    bool tables_capped;         /**< Table kernels chosen but over the tables cap: scalar used */
+} binary_clock_tune_t;
+
+/**
+ * @brief Defaults without measuring: CLOCK_REALTIME and scalar kernels
+ *
+ * @param tune Tuner to initialize (must not be NULL)
+ */
+void binary_clock_tune_init(binary_clock_tune_t* tune);
+
+/**
+ * @brief Measure every candidate and pick the fastest of each kind
+ *
+ * @param tune Tuner (must not be NULL)
+ * @param budget_ms Total measurement time, 0 for the default
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_NULL_POINTER
+ */
+binary_clock_error_t binary_clock_tune_run(binary_clock_tune_t* tune, int budget_ms);
+
+/**
+ * @brief Load a cached decision made on the same CPU model
+ *
+ * @param tune Tuner (must not be NULL)
+ * @param path Cache file
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_OUTPUT if the file is
+ *         missing or unreadable, or BINARY_CLOCK_ERROR_INVALID_TIME if it
+ *         was written for another CPU model or names an unavailable choice
+ */
+binary_clock_error_t binary_clock_tune_load(binary_clock_tune_t* tune, const char* path);
+
+/**
+ * @brief Write the decision to a cache file
+ *
+ * @param tune Tuner (must not be NULL)
+ * @param path Cache file to create or replace
+ * @return BINARY_CLOCK_SUCCESS or BINARY_CLOCK_ERROR_OUTPUT
+ */
+binary_clock_error_t binary_clock_tune_save(const binary_clock_tune_t* tune, const char* path);
+
+/**
+ * @brief Clock source for binary_clock_presenter_set_clock()
+ *
+ * @param tune Tuner that must outlive the source (it holds the cycle clock)
+ * @return Source reading the chosen clock
+ */
+binary_clock_present_clock_t binary_clock_tune_clock_source(binary_clock_tune_t* tune);
+
+/**
+ * @brief Chosen conversion kernel (scalar when the tables are over their cap)
+ */
+binary_clock_convert_fn_t binary_clock_tune_convert_fn(const binary_clock_tune_t* tune);
+
+/**
+ * @brief Chosen render kernel (scalar when the tables are over their cap)
+ */
+binary_clock_render_fn_t binary_clock_tune_render_fn(const binary_clock_tune_t* tune);
+
+/**
+ * @brief Table-driven equivalent of binary_clock_state_from_epoch()
+ *
+ * Composed from two levels of small tables rather than one entry per
+ * second of the day: see binary_clock_tune_packed_from_epoch(), then one
+ * LED column per packed digit.
+ */
+binary_clock_state_t binary_clock_tune_state_from_epoch_table(int64_t epoch_seconds, int32_t utc_offset_seconds);
+
+/**
+ * @brief Packed LED mask of an epoch second, composed from tables
+ *
+ * A 24-entry hour table and 60-entry minute and second tables hold each
+ * component's BCD digits already shifted into place, so the mask is two
+ * divisions by a constant and three ORed lookups. Equal to
+ * binary_clock_pack_state() of binary_clock_state_from_epoch().
+ */
+uint32_t binary_clock_tune_packed_from_epoch(int64_t epoch_seconds, int32_t utc_offset_seconds);
+
+/**
+ * @brief Bytes of the tables the table conversion kernel reads
+ */
+size_t binary_clock_tune_convert_table_size(void);
+
+/**
+ * @brief Name of a clock source ("time", "realtime", "realtime-coarse", "cycles")
+ */
+const char* binary_clock_tune_clock_name(binary_clock_tune_clock_t clock);
+
+/**
+ * @brief Name of a kernel ("scalar", "table")
+ */
+const char* binary_clock_tune_kernel_name(binary_clock_tune_kernel_t kernel);
+
+/**
+ * @brief One-line summary of the decision and its measurements
+ *
+ * @param tune Tuner (must not be NULL)
+ * @param buffer Output buffer
+ * @param size Output buffer size
+ * @return Length written (truncated to fit)
+ */
+size_t binary_clock_tune_describe(const binary_clock_tune_t* tune, char* buffer, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_TUNE_H */
@@ -0,0 +1,120 @@
+/**
+ * @file binary_clock_waterfall.h
+ * @brief Binary Clock Waterfall - Scrolling history of LED rows
+ * @version 1.0.0
+ *
+ * Shows the last N seconds as one LED row per second, newest at the top,
+ * so bit patterns can be watched as they evolve. The history lives in a
+ * terminal scroll region: each tick moves to the top row and sends a
+ * reverse index, which makes the terminal shift every older row down by
+ * one (the oldest falls off the bottom), then writes the new row. A tick
+ * is the same number of bytes whatever the history length; redrawing N
+ * rows would cost N rows of output every second.
+ *
+ * Rows are rendered with the table kernel (binary_clock_display_render_table())
+ * in a one-line format, whose rows all have the same width, so the
+ * columns of successive seconds line up.
+ */
+
+#ifndef BINARY_CLOCK_WATERFALL_H
+#define BINARY_CLOCK_WATERFALL_H
+
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief History length used when none is given
+ */
+#define BINARY_CLOCK_WATERFALL_DEFAULT_ROWS 20
+
+/**
+ * @brief Shortest history (the row end must never reach the bottom margin)
+ */
+#define BINARY_CLOCK_WATERFALL_MIN_ROWS 2
+
+/**
+ * @brief Longest history
+ */
+#define BINARY_CLOCK_WATERFALL_MAX_ROWS 9999
+
+/**
+ * @brief Size of the per-tick escape sequence buffer
+ */
+#define BINARY_CLOCK_WATERFALL_SEQUENCE_SIZE 32
+
+/**
+ * @brief Largest tick (sequence plus rendered row)
+ */
+#define BINARY_CLOCK_WATERFALL_TICK_SIZE (BINARY_CLOCK_WATERFALL_SEQUENCE_SIZE + BINARY_CLOCK_RENDER_MAX_SIZE)
+
+/**
+ * @brief Screen row the history starts on (below the title and a blank row)
+ */
+#define BINARY_CLOCK_WATERFALL_TOP_ROW 3
+
+/**
+ * @brief A waterfall display
+ */
+typedef struct {
+    uint32_t rows;              /**< Seconds of history shown */
+    binary_clock_render_format_t format; /**< Row format: compact or emoji line */
+    binary_clock_render_fn_t render; /**< Render kernel, binary_clock_display_render_table() by default */
+    char prefix[BINARY_CLOCK_WATERFALL_SEQUENCE_SIZE]; /**< Sent before each row: top row, reverse index */
+    size_t prefix_length;       /**< Length of prefix */
+} binary_clock_waterfall_t;
+
+/**
+ * @brief Initialize a waterfall
+ *
+ * @param waterfall Waterfall to initialize (must not be NULL)
+ * @param rows Seconds of history, BINARY_CLOCK_WATERFALL_MIN_ROWS to
+ *        BINARY_CLOCK_WATERFALL_MAX_ROWS
+ * @param format BINARY_CLOCK_RENDER_COMPACT or BINARY_CLOCK_RENDER_EMOJI_LINE
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER, or
+ *         BINARY_CLOCK_ERROR_OUTPUT for a history length or multi-line
+ *         format the waterfall cannot show
+ */
+binary_clock_error_t binary_clock_waterfall_init(binary_clock_waterfall_t* waterfall, uint32_t rows,
+                                                 binary_clock_render_format_t format);
+
+/**
+ * @brief Encode the screen setup: clear, title, and the scroll region
+ *
+ * @param waterfall Waterfall (must not be NULL)
+ * @param output Output buffer (BINARY_CLOCK_WATERFALL_TICK_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Bytes to write, or 0 on a NULL argument or a buffer too small
+ */
+size_t binary_clock_waterfall_begin(const binary_clock_waterfall_t* waterfall, char* output, size_t size);
+
+/**
+ * @brief Encode one tick: shift the history down and write the new row
+ *
+ * The result is the prefix followed by the rendered row, so a presenter
+ * staging waterfall->format with waterfall->prefix sends the same bytes.
+ *
+ * @param waterfall Waterfall (must not be NULL)
+ * @param state State to show (must not be NULL)
+ * @param output Output buffer (BINARY_CLOCK_WATERFALL_TICK_SIZE always suffices)
+ * @param size Output buffer size
+ * @return Bytes to write, or 0 on a NULL argument or a buffer too small
+ */
+size_t binary_clock_waterfall_tick(const binary_clock_waterfall_t* waterfall, const binary_clock_state_t* state,
+                                   char* output, size_t size);
+
+/**
+ * @brief Encode the teardown: full-screen scrolling, cursor below the history
+ *
+ * @return Bytes to write, or 0 on a NULL argument or a buffer too small
+ */
+size_t binary_clock_waterfall_end(const binary_clock_waterfall_t* waterfall, char* output, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_WATERFALL_H */
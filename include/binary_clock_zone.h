@@ -0,0 +1,120 @@
+/**
+ * @file binary_clock_zone.h
+ * @brief Binary Clock Time Zones - UTC offsets from preloaded transition tables
+ * @version 1.0.0
+ *
+ * A zone is loaded once into a sorted table of the instants its UTC
+ * offset changes, after which the offset for any epoch is a binary
+ * search: no file access, no localtime() and no TZ environment.
+ *
+ * Zones come from the system's compiled tz database (TZif files under
+ * TZDIR or /usr/share/zoneinfo). The rule in a file's footer, which
+ * covers the years after its last listed transition, is expanded into
+ * explicit transitions through BINARY_CLOCK_ZONE_LAST_YEAR, so "slim"
+ * files that list no future transitions still give the right offsets.
+ * "UTC" and fixed offsets ("+05:30", "-08") need no file.
+ *
+ * Transition tables are charged to BINARY_CLOCK_MEM_TABLES
+ * (binary_clock_mem.h). They have no lean mode: a wrong offset is worse
+ * than the bytes.
+ */
+
+#ifndef BINARY_CLOCK_ZONE_H
+#define BINARY_CLOCK_ZONE_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Longest zone name, including the terminator
+ */
+#define BINARY_CLOCK_ZONE_NAME_SIZE 64
+
+/**
+ * @brief Last year footer rules are expanded through; the offset of the
+ *        final transition holds after it
+ */
+#define BINARY_CLOCK_ZONE_LAST_YEAR 2099
+
+/**
+ * @brief Default directory of compiled zone files (TZDIR overrides it)
+ */
+#define BINARY_CLOCK_ZONE_DEFAULT_DIRECTORY "/usr/share/zoneinfo"
+
+/**
+ * @brief A zone's UTC offsets over time
+ */
+typedef struct {
+    char name[BINARY_CLOCK_ZONE_NAME_SIZE]; /**< Name it was loaded by */
+    int64_t* transitions;       /**< Instants the offset changes, ascending */
+    int32_t* offsets;           /**< offsets[i] holds from transitions[i] on */
+    size_t count;               /**< Transitions */
+    int32_t initial_offset;     /**< Offset before the first transition */
+} binary_clock_zone_t;
+
+/**
+ * @brief Make a zone with one offset for all time
+ *
+ * @param zone Zone to initialize (must not be NULL)
+ * @param name Name to give it (truncated to fit)
+ * @param offset_seconds UTC offset, east positive
+ * @return BINARY_CLOCK_SUCCESS or error code
+ */
+binary_clock_error_t binary_clock_zone_init_fixed(binary_clock_zone_t* zone, const char* name, int32_t offset_seconds);
+
+/**
+ * @brief Build a zone from the contents of a TZif file
+ *
+ * Versions 1 to 4 are accepted; from version 2 on the 64-bit data and
+ * the footer rule are used.
+ *
+ * @param zone Zone to initialize (must not be NULL)
+ * @param name Name to give it
+ * @param data File contents
+ * @param length File length
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_OUTPUT for malformed
+ *         data, or BINARY_CLOCK_ERROR_SYSTEM_TIME if out of memory
+ */
+binary_clock_error_t binary_clock_zone_parse(binary_clock_zone_t* zone, const char* name,
+                                             const uint8_t* data, size_t length);
+
+/**
+ * @brief Load a zone by name
+ *
+ * "UTC", "Z" and "+HH[:MM]" / "-HH[:MM]" are fixed zones. Anything else
+ * is read from the zone directory. Names with ".." or a leading '/' are
+ * rejected.
+ *
+ * @param zone Zone to initialize (must not be NULL)
+ * @param name Zone name, e.g. "Europe/Berlin"
+ * @param directory Zone directory, NULL for TZDIR or the default
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_INVALID_TIME for an
+ *         unusable name, BINARY_CLOCK_ERROR_SYSTEM_TIME if the file cannot
+ *         be read, or BINARY_CLOCK_ERROR_OUTPUT if it is malformed
+ */
+binary_clock_error_t binary_clock_zone_load(binary_clock_zone_t* zone, const char* name, const char* directory);
+
+/**
+ * @brief UTC offset in force at an instant (east positive)
+ */
+int32_t binary_clock_zone_offset(const binary_clock_zone_t* zone, int64_t epoch_seconds);
+
+/**
+ * @brief Heap bytes of the zone's transition table
+ */
+size_t binary_clock_zone_memory(const binary_clock_zone_t* zone);
+
+/**
+ * @brief Free the transition table
+ */
+void binary_clock_zone_free(binary_clock_zone_t* zone);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_ZONE_H */
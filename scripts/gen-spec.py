@@ -0,0 +1,711 @@
+#!/usr/bin/env python3
+# Binary Clock Spec Code Generator
+# Reads docs/binary_clock_api_spec.json and writes:
+#   include/binary_clock_spec.h  constraints, budgets, record/JSON sizes, codec prototypes
+#   src/binary_clock_spec.c      record and JSON encoders/decoders for every data
+#                                structure, plus compile-time layout and error-code checks
+#   bench/bench_spec.c           one benchmark per budgeted function, failing over budget
+#
+# The build reruns this when the spec or this script changes; the outputs are
+# checked in so building needs no Python otherwise.
+#
+# Usage: scripts/gen-spec.py [--check]   (--check: exit 1 if the outputs are stale)
+
+import json
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SPEC = os.path.join(ROOT, "docs", "binary_clock_api_spec.json")
+HEADER = os.path.join(ROOT, "include", "binary_clock_spec.h")
+SOURCE = os.path.join(ROOT, "src", "binary_clock_spec.c")
+BENCH = os.path.join(ROOT, "bench", "bench_spec.c")
+
+BANNER = "/* Generated by scripts/gen-spec.py from docs/binary_clock_api_spec.json - do not edit. */\n"
+
+# Spec field type -> (C type, record bytes, longest JSON text)
+SCALARS = {
+    "uint8_t": ("uint8_t", 1, 3),
+    "bool[6]": ("bool", 1, len("[") + 6 * len("false") + 5 + len("]")),
+    "time_t": ("binary_clock_time_t", 8, 20),
+}
+
+
+def short_name(struct):
+    return re.sub(r"_t$", "", re.sub(r"^binary_clock_", "", struct))
+
+
+def macro(text):
+    return re.sub(r"[^A-Za-z0-9]", "_", text).upper()
+
+
+def c_string(text):
+    return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+
+class Struct:
+    def __init__(self, name, spec, known):
+        self.name = name
+        self.short = short_name(name)
+        self.size_bytes = spec["memory_layout"]["size_bytes"]
+        self.fields = []
+        for field, info in spec["fields"].items():
+            kind = info["type"]
+            if kind in SCALARS:
+                record, json_max = SCALARS[kind][1], SCALARS[kind][2]
+                # Sized for any value, not just valid ones: encoders do not validate
+                constraints = info.get("constraints", {})
+            elif kind in known:
+                record, json_max = known[kind].record_size, known[kind].json_max
+                constraints = {"bit_count": info["bit_count"]} if "bit_count" in info else {}
+            else:
+                sys.exit("gen-spec: %s.%s has unsupported type %s" % (name, field, kind))
+            self.fields.append((field, kind, constraints, record, json_max))
+        self.record_size = sum(f[3] for f in self.fields)
+        # {"field": value, ...}
+        self.json_max = 2 + sum(len(c_string(f[0])) + 1 + f[4] for f in self.fields) + len(self.fields) - 1
+
+
+def load_spec():
+    with open(SPEC) as spec_file:
+        return json.load(spec_file)
+
+
+def collect_structs(spec):
+    structs = {}
+    for name, info in spec["data_structures"].items():
+        if "fields" in info:  # Function pointer types carry no data
+            structs[name] = Struct(name, info, structs)
+    return list(structs.values())
+
+
+def collect_functions(spec):
+    functions = []
+    for group in spec["functions"].values():
+        for name, info in group.items():
+            if isinstance(info, dict) and "performance" in info:
+                functions.append((name, info))
+    return functions
+
+
+# ---------------------------------------------------------------------------
+# Header
+# ---------------------------------------------------------------------------
+
+def generate_header(spec, structs, functions):
+    api = spec["api_specification"]
+    out = [BANNER]
+    out.append("""/**
+ * @file binary_clock_spec.h
+ * @brief Binary Clock Spec Serializers - Codecs and budgets generated from the API spec
+ * @version %s
+ *
+ * Every data structure in docs/binary_clock_api_spec.json gets two codecs:
+ * - record: fixed-size little-endian bytes, one per uint8_t field, the
+ *   six bits as one MSB-first byte, timestamps as int64
+ * - JSON: one compact object with the spec's field names, in spec order
+ *
+ * Encoders check the buffer once against the largest encoding and then
+ * write every field without branching on it. Decoders take exactly what
+ * the encoders write, and check every field constraint the spec gives.
+ *
+ * Field constraints and per-function budgets are exported as constants,
+ * so code and benchmarks follow the spec when it changes.
+ */
+
+#ifndef BINARY_CLOCK_SPEC_H
+#define BINARY_CLOCK_SPEC_H
+
+#include <binary_clock_api.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Spec version the codecs were generated from
+ */
+#define BINARY_CLOCK_SPEC_VERSION %s
+""" % (api["version"], c_string(api["version"])))
+
+    out.append("""
+/* ========================================================================== */
+/* FIELD CONSTRAINTS                                                          */
+/* ========================================================================== */
+
+""")
+    for struct in structs:
+        for field, kind, constraints, _, _ in struct.fields:
+            for key in ("min", "max", "length", "bit_count"):
+                if key in constraints:
+                    out.append("#define BINARY_CLOCK_SPEC_%s_%s_%s %d\n" %
+                               (macro(struct.short), macro(field), macro(key), constraints[key]))
+
+    out.append("""
+/* ========================================================================== */
+/* FUNCTION BUDGETS                                                           */
+/* ========================================================================== */
+
+/* max_execution_time_ms and typical_execution_time_us per call, in nanoseconds */
+""")
+    for name, info in functions:
+        performance = info["performance"]
+        base = macro(re.sub(r"^binary_clock_", "", name))
+        out.append("#define BINARY_CLOCK_SPEC_BUDGET_NS_%s %dLL\n" % (base, performance["max_execution_time_ms"] * 1000000))
+        out.append("#define BINARY_CLOCK_SPEC_TYPICAL_NS_%s %dLL\n" % (base, performance["typical_execution_time_us"] * 1000))
+
+    out.append("""
+/* ========================================================================== */
+/* CODECS                                                                     */
+/* ========================================================================== */
+""")
+    for struct in structs:
+        upper = macro(struct.short)
+        out.append("""
+/**
+ * @brief %s: record size and largest JSON encoding
+ */
+#define BINARY_CLOCK_SPEC_%s_RECORD_SIZE %d
+#define BINARY_CLOCK_SPEC_%s_JSON_MAX_SIZE %d
+""" % (struct.name, upper, struct.record_size, upper, struct.json_max))
+
+    for struct in structs:
+        param = struct.short
+        out.append("""
+/**
+ * @brief Encode a %(name)s as a record
+ * @return Bytes written (BINARY_CLOCK_SPEC_%(upper)s_RECORD_SIZE), 0 on NULL or a small buffer
+ */
+size_t binary_clock_spec_encode_%(short)s_record(const %(name)s* %(param)s, uint8_t* output, size_t size);
+
+/**
+ * @brief Decode a record into a %(name)s
+ * @return BINARY_CLOCK_SUCCESS, BINARY_CLOCK_ERROR_NULL_POINTER,
+ *         BINARY_CLOCK_ERROR_OUTPUT for a malformed record, or the error for
+ *         a field outside its spec constraints (the output is left untouched)
+ */
+binary_clock_error_t binary_clock_spec_decode_%(short)s_record(const uint8_t* input, size_t length, %(name)s* %(param)s);
+
+/**
+ * @brief Encode a %(name)s as JSON (not NUL-terminated)
+ * @return Bytes written, 0 on NULL or a buffer smaller than BINARY_CLOCK_SPEC_%(upper)s_JSON_MAX_SIZE
+ */
+size_t binary_clock_spec_encode_%(short)s_json(const %(name)s* %(param)s, char* output, size_t size);
+
+/**
+ * @brief Decode JSON written by binary_clock_spec_encode_%(short)s_json()
+ * @return As binary_clock_spec_decode_%(short)s_record()
+ */
+binary_clock_error_t binary_clock_spec_decode_%(short)s_json(const char* input, size_t length, %(name)s* %(param)s);
+""" % {"name": struct.name, "short": struct.short, "upper": macro(struct.short), "param": param})
+
+    out.append("""
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BINARY_CLOCK_SPEC_H */
+""")
+    return "".join(out)
+
+
+# ---------------------------------------------------------------------------
+# Source
+# ---------------------------------------------------------------------------
+
+SOURCE_PROLOGUE = """
+/**
+ * @file binary_clock_spec.c
+ * @brief Binary Clock Spec Serializers Implementation (generated)
+ *
+ * Each field is written with straight-line code: constant key text,
+ * digits selected by arithmetic, booleans from a table. Constraint checks
+ * OR their failures into a mask that is tested once per value.
+ */
+
+#include <binary_clock_spec.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* SPEC CONFORMANCE (compile time)                                            */
+/* ========================================================================== */
+
+#define SPEC_ASSERT(name, condition) typedef char spec_assert_##name[(condition) ? 1 : -1]
+
+%(asserts)s
+/* ========================================================================== */
+/* FIELD CODECS                                                               */
+/* ========================================================================== */
+
+// Constraint failures, mapped to an error code once per value
+#define SPEC_BAD_SHAPE 1u
+#define SPEC_BAD_BIT_COUNT 2u
+#define SPEC_BAD_VALUE 4u
+
+static binary_clock_error_t spec_error(unsigned bad) {
+    if (bad & SPEC_BAD_SHAPE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    if (bad & SPEC_BAD_BIT_COUNT) {
+        return BINARY_CLOCK_ERROR_INVALID_BIT_COUNT;
+    }
+    return (bad & SPEC_BAD_VALUE) ? BINARY_CLOCK_ERROR_INVALID_TIME : BINARY_CLOCK_SUCCESS;
+}
+
+static uint8_t* put_record_i64(uint8_t* out, int64_t value) {
+    uint64_t bits = (uint64_t)value;
+    for (int i = 0; i < 8; i++) {
+        out[i] = (uint8_t)(bits >> (8 * i));
+    }
+    return out + 8;
+}
+
+static const uint8_t* take_record_i64(const uint8_t* in, int64_t* value) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= (uint64_t)in[i] << (8 * i);
+    }
+    *value = (int64_t)bits;
+    return in + 8;
+}
+
+static uint8_t pack_bits(const bool bits[6]) {
+    return (uint8_t)((bits[0] << 5) | (bits[1] << 4) | (bits[2] << 3) | (bits[3] << 2) | (bits[4] << 1) | bits[5]);
+}
+
+static void unpack_bits(uint8_t mask, bool bits[6]) {
+    for (int i = 0; i < 6; i++) {
+        bits[i] = (mask >> (5 - i)) & 1;
+    }
+}
+
+// Writers may store up to the field's longest text; callers checked the room
+static char* put_text(char* out, const char* text, size_t length) {
+    memcpy(out, text, length);
+    return out + length;
+}
+
+static char* put_u8(char* out, uint8_t value) {
+    char digits[3] = {(char)('0' + value / 100), (char)('0' + value / 10 % 10), (char)('0' + value % 10)};
+    size_t count = 1 + (value >= 10) + (value >= 100);
+    memcpy(out, digits + 3 - count, count);
+    return out + count;
+}
+
+static const char bool_text[2][5] = {{'f', 'a', 'l', 's', 'e'}, {'t', 'r', 'u', 'e', ','}};
+
+static char* put_bits(char* out, const bool bits[6]) {
+    *out++ = '[';
+    for (int i = 0; i < 6; i++) {
+        memcpy(out, bool_text[bits[i] != 0], 5);
+        out += 5 - bits[i];
+        *out++ = ',';
+    }
+    out[-1] = ']';
+    return out;
+}
+
+static char* put_i64(char* out, int64_t value) {
+    char digits[20];
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t count = 0;
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    *out = '-';
+    out += value < 0;
+    memcpy(out, digits + sizeof(digits) - count, count);
+    return out + count;
+}
+
+// JSON reader over exactly the text the encoders produce
+typedef struct {
+    const char* at;
+    const char* end;
+    unsigned bad;
+} spec_cursor_t;
+
+static void take_text(spec_cursor_t* in, const char* text, size_t length) {
+    if ((size_t)(in->end - in->at) < length || memcmp(in->at, text, length) != 0) {
+        in->bad |= SPEC_BAD_SHAPE;
+        in->at = in->end;
+        return;
+    }
+    in->at += length;
+}
+
+static uint64_t take_digits(spec_cursor_t* in, int max_digits) {
+    uint64_t value = 0;
+    int count = 0;
+    while (in->at < in->end && *in->at >= '0' && *in->at <= '9' && count < max_digits) {
+        value = value * 10 + (uint64_t)(*in->at++ - '0');
+        count++;
+    }
+    if (count == 0) {
+        in->bad |= SPEC_BAD_SHAPE;
+    }
+    return value;
+}
+
+static uint8_t take_u8(spec_cursor_t* in) {
+    uint64_t value = take_digits(in, 3);
+    if (value > 255) {
+        in->bad |= SPEC_BAD_SHAPE;
+    }
+    return (uint8_t)value;
+}
+
+static void take_bits(spec_cursor_t* in, bool bits[6]) {
+    take_text(in, "[", 1);
+    for (int i = 0; i < 6; i++) {
+        if (in->at < in->end && *in->at == 't') {
+            take_text(in, "true", 4);
+            bits[i] = true;
+        } else {
+            take_text(in, "false", 5);
+            bits[i] = false;
+        }
+        take_text(in, i < 5 ? "," : "]", 1);
+    }
+}
+
+static int64_t take_i64(spec_cursor_t* in) {
+    bool negative = in->at < in->end && *in->at == '-';
+    in->at += negative;
+    uint64_t magnitude = take_digits(in, 19);
+    if (magnitude > (uint64_t)INT64_MAX + negative) {
+        in->bad |= SPEC_BAD_SHAPE;
+    }
+    return negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+}
+"""
+
+
+def struct_codecs(struct, structs):
+    name, short = struct.name, struct.short
+    known = {s.name: s for s in structs}
+    lines = []
+    lines.append("\n/* " + "=" * 74 + " */\n")
+    lines.append("/* %-74s */\n" % name.upper())
+    lines.append("/* " + "=" * 74 + " */\n\n")
+
+    # Constraint check
+    lines.append("static unsigned check_%s(const %s* value) {\n    unsigned bad = 0;\n" % (short, name))
+    for field, kind, constraints, _, _ in struct.fields:
+        flag = "SPEC_BAD_BIT_COUNT" if field == "bit_count" else "SPEC_BAD_VALUE"
+        if kind in known:
+            lines.append("    bad |= check_%s(&value->%s);\n" % (known[kind].short, field))
+            if "bit_count" in constraints:
+                lines.append("    bad |= (value->%s.bit_count != %d) * SPEC_BAD_BIT_COUNT;\n" % (field, constraints["bit_count"]))
+        elif kind == "uint8_t":
+            if constraints.get("min", 0) > 0:
+                lines.append("    bad |= (value->%s < %d) * %s;\n" % (field, constraints["min"], flag))
+            if "max" in constraints:
+                lines.append("    bad |= (value->%s > %d) * %s;\n" % (field, constraints["max"], flag))
+    lines.append("    return bad;\n}\n\n")
+
+    # Record
+    lines.append("static uint8_t* put_%s_record(uint8_t* out, const %s* value) {\n" % (short, name))
+    for field, kind, _, _, _ in struct.fields:
+        if kind in known:
+            lines.append("    out = put_%s_record(out, &value->%s);\n" % (known[kind].short, field))
+        elif kind == "uint8_t":
+            lines.append("    *out++ = value->%s;\n" % field)
+        elif kind == "bool[6]":
+            lines.append("    *out++ = pack_bits(value->%s);\n" % field)
+        else:
+            lines.append("    out = put_record_i64(out, (int64_t)value->%s);\n" % field)
+    lines.append("    return out;\n}\n\n")
+
+    lines.append("static const uint8_t* take_%s_record(const uint8_t* in, %s* value, unsigned* bad) {\n" % (short, name))
+    if not any(kind in known or kind == "bool[6]" for _, kind, _, _, _ in struct.fields):
+        lines.append("    (void)bad;\n")
+    for field, kind, _, _, _ in struct.fields:
+        if kind in known:
+            lines.append("    in = take_%s_record(in, &value->%s, bad);\n" % (known[kind].short, field))
+        elif kind == "uint8_t":
+            lines.append("    value->%s = *in++;\n" % field)
+        elif kind == "bool[6]":
+            lines.append("    *bad |= (*in >= 64) * SPEC_BAD_SHAPE;\n")
+            lines.append("    unpack_bits(*in++, value->%s);\n" % field)
+        else:
+            lines.append("    int64_t %s;\n" % field)
+            lines.append("    in = take_record_i64(in, &%s);\n" % field)
+            lines.append("    value->%s = (binary_clock_time_t)%s;\n" % (field, field))
+    lines.append("    return in;\n}\n\n")
+
+    # JSON
+    lines.append("static char* put_%s_json(char* out, const %s* value) {\n" % (short, name))
+    for index, (field, kind, _, _, _) in enumerate(struct.fields):
+        key = ("{" if index == 0 else ",") + '"%s":' % field
+        lines.append("    out = put_text(out, %s, %d);\n" % (c_string(key), len(key)))
+        if kind in known:
+            lines.append("    out = put_%s_json(out, &value->%s);\n" % (known[kind].short, field))
+        elif kind == "uint8_t":
+            lines.append("    out = put_u8(out, value->%s);\n" % field)
+        elif kind == "bool[6]":
+            lines.append("    out = put_bits(out, value->%s);\n" % field)
+        else:
+            lines.append("    out = put_i64(out, (int64_t)value->%s);\n" % field)
+    lines.append("    *out++ = '}';\n    return out;\n}\n\n")
+
+    lines.append("static void take_%s_json(spec_cursor_t* in, %s* value) {\n" % (short, name))
+    for index, (field, kind, _, _, _) in enumerate(struct.fields):
+        key = ("{" if index == 0 else ",") + '"%s":' % field
+        lines.append("    take_text(in, %s, %d);\n" % (c_string(key), len(key)))
+        if kind in known:
+            lines.append("    take_%s_json(in, &value->%s);\n" % (known[kind].short, field))
+        elif kind == "uint8_t":
+            lines.append("    value->%s = take_u8(in);\n" % field)
+        elif kind == "bool[6]":
+            lines.append("    take_bits(in, value->%s);\n" % field)
+        else:
+            lines.append("    value->%s = (binary_clock_time_t)take_i64(in);\n" % field)
+    lines.append("    take_text(in, \"}\", 1);\n}\n\n")
+
+    # Public wrappers
+    upper = macro(short)
+    lines.append("""size_t binary_clock_spec_encode_%(short)s_record(const %(name)s* %(short)s, uint8_t* output, size_t size) {
+    if (%(short)s == NULL || output == NULL || size < BINARY_CLOCK_SPEC_%(upper)s_RECORD_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_%(short)s_record(output, %(short)s) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_%(short)s_record(const uint8_t* input, size_t length, %(name)s* %(short)s) {
+    if (input == NULL || %(short)s == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (length != BINARY_CLOCK_SPEC_%(upper)s_RECORD_SIZE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    %(name)s decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    unsigned bad = 0;
+    take_%(short)s_record(input, &decoded, &bad);
+    binary_clock_error_t error = spec_error(bad | check_%(short)s(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *%(short)s = decoded;
+    }
+    return error;
+}
+
+size_t binary_clock_spec_encode_%(short)s_json(const %(name)s* %(short)s, char* output, size_t size) {
+    if (%(short)s == NULL || output == NULL || size < BINARY_CLOCK_SPEC_%(upper)s_JSON_MAX_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_%(short)s_json(output, %(short)s) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_%(short)s_json(const char* input, size_t length, %(name)s* %(short)s) {
+    if (input == NULL || %(short)s == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    %(name)s decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    spec_cursor_t in = {input, input + length, 0};
+    take_%(short)s_json(&in, &decoded);
+    if (in.at != in.end) {
+        in.bad |= SPEC_BAD_SHAPE;
+    }
+    binary_clock_error_t error = spec_error(in.bad | check_%(short)s(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *%(short)s = decoded;
+    }
+    return error;
+}
+""" % {"short": short, "name": name, "upper": upper})
+    return "".join(lines)
+
+
+def generate_source(spec, structs):
+    asserts = []
+    for struct in structs:
+        asserts.append("SPEC_ASSERT(%s_size, sizeof(%s) == %d);\n" % (struct.short, struct.name, struct.size_bytes))
+    for enum in spec["error_codes"].values():
+        for name, info in enum["values"].items():
+            asserts.append("SPEC_ASSERT(%s, %s == %d);\n" % (name.lower(), name, info["value"]))
+    body = SOURCE_PROLOGUE.replace("%(asserts)s", "".join(asserts))
+    for struct in structs:
+        body += struct_codecs(struct, structs)
+    return BANNER + body
+
+
+# ---------------------------------------------------------------------------
+# Benchmarks
+# ---------------------------------------------------------------------------
+
+def sample_arguments(spec):
+    """Arguments for budget benchmarks, taken from the spec's own test cases."""
+    tests = spec["test_cases"]["unit_tests"]
+    conversion = tests["test_binary_conversion"]["cases"][0]["input"]
+    time_case = next(case["input"] for case in tests["test_time_components"]["cases"] if case["expected"] == "success")
+    return {
+        ("time", "const time_components_t*"): "&sample_time",
+        ("value", "uint8_t"): str(conversion["value"]),
+        ("bit_count", "uint8_t"): str(conversion["bit_count"]),
+        ("binary", "const binary_value_t*"): "&sample_binary",
+    }, time_case, conversion
+
+
+def generate_bench(spec, structs, functions):
+    samples, time_case, conversion = sample_arguments(spec)
+    out = [BANNER, """
+/**
+ * @file bench_spec.c
+ * @brief Per-function budgets from the API spec, and the generated codecs
+ *
+ * Times every function that has a performance entry in the spec against
+ * its max_execution_time_ms and prints its typical_execution_time_us for
+ * comparison; arguments come from the spec's unit test cases. Also times
+ * the generated record and JSON codecs. Exits 1 if a function is over budget.
+ *
+ * Usage: bench_spec [ITERATIONS]   (default: 1000000)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <binary_clock_spec.h>
+
+static const time_components_t sample_time = {%d, %d, %d};
+static binary_value_t sample_binary;
+static volatile uint64_t sink;
+
+static int64_t now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static int over_budget = 0;
+
+static void report(const char* name, double ns, long long budget_ns, long long typical_ns) {
+    if (budget_ns <= 0) {
+        printf("  %%-34s %%9.1f ns/call\\n", name, ns);
+        return;
+    }
+    bool within = ns <= (double)budget_ns;
+    over_budget |= !within;
+    printf("  %%-34s %%9.1f ns/call   typical %%7lld ns   budget %%9lld ns: %%s\\n", name, ns, typical_ns, budget_ns,
+           within ? "PASS" : "FAIL");
+}
+""" % (time_case["hours"], time_case["minutes"], time_case["seconds"])]
+
+    out.append("\nint main(int argc, char* argv[]) {\n")
+    out.append("    long iterations = argc > 1 ? atol(argv[1]) : 1000000;\n")
+    out.append("    if (iterations <= 0) {\n        fprintf(stderr, \"Usage: %s [ITERATIONS]\\n\", argv[0]);\n        return 1;\n    }\n")
+    out.append("    sample_binary = binary_clock_to_binary(%d, %d);\n" % (conversion["value"], conversion["bit_count"]))
+    out.append("    printf(\"=== Spec %s budgets, %%ld calls each ===\\n\", iterations);\n" % spec["api_specification"]["version"])
+    out.append("    int64_t start;\n")
+    for name, info in functions:
+        signature = info["signature"]
+        match = re.match(r"\s*(.+?)\s*\b%s\((.*)\)\s*$" % re.escape(name), signature)
+        if match is None:
+            sys.exit("gen-spec: cannot parse signature of %s" % name)
+        return_type, params = match.group(1), match.group(2).strip()
+        arguments = []
+        if params != "void":
+            for param in params.split(","):
+                param_match = re.match(r"\s*(.+?)\s*(\w+)\s*$", param)
+                param_type = re.sub(r"\s*\*", "*", param_match.group(1))
+                key = (param_match.group(2), param_type)
+                if key not in samples:
+                    sys.exit("gen-spec: no sample argument for %s %s of %s" % (key[1], key[0], name))
+                arguments.append(samples[key])
+        if return_type == "uint8_t":
+            fold = "result"
+        elif return_type == "binary_value_t":
+            fold = "result.decimal_value"
+        elif return_type == "time_components_t":
+            fold = "result.seconds"
+        else:
+            fold = "(uint64_t)result.timestamp"
+        base = macro(re.sub(r"^binary_clock_", "", name))
+        out.append("""
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        %s result = %s(%s);
+        sink += %s;
+    }
+    report("%s()", (double)(now_ns() - start) / iterations,
+           BINARY_CLOCK_SPEC_BUDGET_NS_%s, BINARY_CLOCK_SPEC_TYPICAL_NS_%s);
+""" % (return_type, name, ", ".join(arguments), fold, name, base, base))
+
+    out.append("""
+    printf("Generated codecs (no budget in the spec):\\n");
+    binary_clock_state_t state = binary_clock_state_from_time(&sample_time);
+    uint8_t record[BINARY_CLOCK_SPEC_STATE_RECORD_SIZE];
+    char json[BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE];
+    size_t json_length = binary_clock_spec_encode_state_json(&state, json, sizeof(json));
+    binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        state.timestamp += 1;
+        sink += binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+    }
+    report("encode_state_record()", (double)(now_ns() - start) / iterations, 0, 0);
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += (uint64_t)binary_clock_spec_decode_state_record(record, sizeof(record), &state);
+    }
+    report("decode_state_record()", (double)(now_ns() - start) / iterations, 0, 0);
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        state.timestamp += 1;
+        sink += binary_clock_spec_encode_state_json(&state, json, sizeof(json));
+    }
+    report("encode_state_json()", (double)(now_ns() - start) / iterations, 0, 0);
+    start = now_ns();
+    for (long i = 0; i < iterations; i++) {
+        sink += (uint64_t)binary_clock_spec_decode_state_json(json, json_length, &state);
+    }
+    report("decode_state_json()", (double)(now_ns() - start) / iterations, 0, 0);
+
+    return over_budget;
+}
+""")
+    return "".join(out)
+
+
+def main():
+    spec = load_spec()
+    structs = collect_structs(spec)
+    functions = collect_functions(spec)
+    outputs = {
+        HEADER: generate_header(spec, structs, functions),
+        SOURCE: generate_source(spec, structs),
+        BENCH: generate_bench(spec, structs, functions),
+    }
+    check = "--check" in sys.argv[1:]
+    stale = []
+    for path, text in outputs.items():
+        current = None
+        if os.path.exists(path):
+            with open(path) as existing:
+                current = existing.read()
+        if current == text:
+            if not check:
+                # Unchanged output still counts as rebuilt for make
+                os.utime(path, None)
+            continue
+        stale.append(os.path.relpath(path, ROOT))
+        if not check:
+            with open(path, "w") as output:
+                output.write(text)
+    if check and stale:
+        print("gen-spec: stale generated files: %s (run make generate)" % ", ".join(stale))
+        return 1
+    if not check:
+        print("gen-spec: %s" % (", ".join(stale) if stale else "up to date"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
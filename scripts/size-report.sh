@@ -0,0 +1,62 @@
+#!/bin/bash
+# Binary Clock Freestanding Size Report
+# Builds the core API in its freestanding profile and reports .text/.rodata/
+# .data/.bss per component, failing if a budget is exceeded.
+#
+# Budgets (bytes) can be overridden from the environment:
+#   TEXT_BUDGET, RODATA_BUDGET, RAM_BUDGET (.data + .bss)
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(cd "$SCRIPT_DIR/.." && pwd)"
+cd "$PROJECT_ROOT"
+
+CC=${CC:-gcc}
+SIZE=${SIZE:-size}
+BUILD_DIR=${BUILD_DIR:-build}
+TEXT_BUDGET=${TEXT_BUDGET:-2048}
+RODATA_BUDGET=${RODATA_BUDGET:-512}
+RAM_BUDGET=${RAM_BUDGET:-0}
+OBJ="$BUILD_DIR/binary_clock_api_freestanding.o"
+
+mkdir -p "$BUILD_DIR"
+$CC -std=c99 -Os -ffreestanding -fno-stack-protector -fno-asynchronous-unwind-tables \
+    -ffunction-sections -fdata-sections -DBINARY_CLOCK_FREESTANDING \
+    -Iinclude -c src/binary_clock_api.c -o "$OBJ"
+
+echo "📏 Freestanding core API size ($CC -Os, per component)"
+echo ""
+
+# Sections are per function (-ffunction-sections); map them to components
+$SIZE -A "$OBJ" | awk \
+    -v text_budget="$TEXT_BUDGET" -v rodata_budget="$RODATA_BUDGET" -v ram_budget="$RAM_BUDGET" '
+function component(name) {
+    if (name ~ /to_binary|to_decimal/) return "conversion"
+    if (name ~ /from_epoch|build_state/) return "epoch"
+    if (name ~ /pack|next_second/) return "packed"
+    return "utility"
+}
+$1 ~ /^\.(text|rodata|data|bss)/ && $2 > 0 {
+    split($1, parts, ".")
+    kind = parts[2]
+    comp = component($1)
+    size[comp, kind] += $2
+    total[kind] += $2
+    components[comp] = 1
+}
+END {
+    printf "%-12s %8s %8s %8s %8s\n", "component", ".text", ".rodata", ".data", ".bss"
+    for (comp in components) {
+        printf "%-12s %8d %8d %8d %8d\n", comp, size[comp, "text"], size[comp, "rodata"], size[comp, "data"], size[comp, "bss"]
+    }
+    printf "%-12s %8d %8d %8d %8d\n", "total", total["text"], total["rodata"], total["data"], total["bss"]
+    printf "\n"
+
+    failed = 0
+    if (total["text"] > text_budget) { printf "❌ .text %d exceeds budget %d\n", total["text"], text_budget; failed = 1 }
+    if (total["rodata"] > rodata_budget) { printf "❌ .rodata %d exceeds budget %d\n", total["rodata"], rodata_budget; failed = 1 }
+    if (total["data"] + total["bss"] > ram_budget) { printf "❌ RAM %d exceeds budget %d\n", total["data"] + total["bss"], ram_budget; failed = 1 }
+    if (!failed) printf "✅ Within budgets (.text <= %d, .rodata <= %d, RAM <= %d)\n", text_budget, rodata_budget, ram_budget
+    exit failed
+}'
@@ -2,16 +2,44 @@
 #include <stdlib.h>   // For exit
 #include <signal.h>   // For signal handling
 #include <string.h>   // For string comparison
+#include <errno.h>    // For EINTR and ERANGE
 #include <binary_clock_api.h>     // Core API (data only)
 #include <binary_clock_display.h> // Display utilities
+#include <binary_clock_mem.h>     // Memory accounting and caps
+#include <binary_clock_arrow.h>   // Arrow IPC export
+#include <binary_clock_multicast.h> // LAN tick broadcast
+#include <binary_clock_pipe.h>      // Batched output spliced into pipes
+#include <binary_clock_query.h>     // Arbitrary-time queries over HTTP
+#include <binary_clock_graphics.h>  // LED images on kitty and sixel terminals
+#include <binary_clock_h2.h>        // Queries and tick streams over HTTP/2
+#include <binary_clock_patch.h>     // JSON Merge Patch delta streams
+#include <binary_clock_present.h>   // Frames committed at a presentation time
+#include <binary_clock_soak.h>      // Output stream checks for soak runs
+#include <binary_clock_statusbar.h> // i3bar/swaybar and tmux producers
+#include <binary_clock_stream.h>    // Live terminal streaming over TCP
+#include <binary_clock_trace.h>     // Chrome trace-event timeline
+#include <binary_clock_tune.h>      // Per-host clock and kernel selection
+#include <binary_clock_waterfall.h> // Scrolling history of LED rows
 
 // Cross-platform compatibility
 #ifdef _WIN32
     #include <windows.h>  // For Sleep and WinAPI console functions
+    #include <io.h>       // For _setmode
+    #include <fcntl.h>    // For _O_BINARY
+    #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+        #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+    #endif
     #define SLEEP_FUNC(x) Sleep((x) * 1000)  // Windows Sleep uses milliseconds
+    #define PIPE_FUNC(fds) _pipe((fds), 4096, _O_BINARY)
+    #define READ_FUNC(fd, buf, size) _read((fd), (buf), (unsigned)(size))
+    #define CLOSE_FUNC(fd) _close(fd)
 #else
     #include <unistd.h>   // For sleep on Unix-like systems
+    #include <sys/ioctl.h> // For the terminal size
     #define SLEEP_FUNC(x) sleep(x)  // Unix sleep uses seconds
+    #define PIPE_FUNC(fds) pipe(fds)
+    #define READ_FUNC(fd, buf, size) read((fd), (buf), (size))
+    #define CLOSE_FUNC(fd) close(fd)
 #endif
 
 // Cross-platform console clear
@@ -41,26 +69,265 @@ static void clear_console(void) {
 #endif
 }
 
+// ANSI clear-screen prefix for presented frames, NULL if the console lacks it
+static const char* clear_sequence(void) {
+#ifdef _WIN32
+    HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (hConsole == INVALID_HANDLE_VALUE || !GetConsoleMode(hConsole, &mode) ||
+        !SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING)) {
+        return NULL;
+    }
+#endif
+    return "\033[2J\033[H";
+}
+
 // Display mode enumeration
 typedef enum {
     DISPLAY_EMOJI,   // Moon emojis (default)
     DISPLAY_BINARY,  // 0s and 1s
     DISPLAY_JSON,    // JSON format
-    DISPLAY_RAW      // Raw API data structures
+    DISPLAY_RAW,     // Raw API data structures
+    DISPLAY_NDJSON,  // One JSON document per line
+    DISPLAY_ARROW,   // Arrow IPC stream (range mode only)
+    DISPLAY_ARROW_FILE, // Arrow IPC file (range mode only)
+    DISPLAY_WATERFALL, // Scrolling history of LED rows (loop mode only)
+    DISPLAY_GRAPHICS, // LED images, kitty or sixel (loop mode only)
+    DISPLAY_PATCH    // Document then JSON merge patches (loop mode only)
 } display_mode_t;
 
 // Operation mode enumeration
 typedef enum {
     MODE_SINGLE,     // Output once and exit (default)
-    MODE_LOOP        // Continuous loop
+    MODE_LOOP,       // Continuous loop
+    MODE_RANGE,      // Every second of a fixed epoch range
+    MODE_BROADCAST,  // Send one multicast tick per second
+    MODE_RECEIVE,    // Display ticks received from a broadcaster
+    MODE_SOAK,       // Loop pipeline on a virtual clock, output checked
+    MODE_SERVE,      // Stream the live clock to TCP terminal clients
+    MODE_QUERY,      // Answer /at queries for any second and zone over HTTP
+    MODE_H2C,        // Answer /at and stream /ticks over cleartext HTTP/2
+    MODE_STATUSBAR   // Feed a status bar, one update per visible change
 } operation_mode_t;
 
 // Configuration structure
 typedef struct {
     display_mode_t display_mode;
     operation_mode_t operation_mode;
+    int64_t range_start;        // First epoch second (inclusive)
+    int64_t range_end;          // Last epoch second (exclusive)
+    int32_t utc_offset;         // Fixed offset used for range conversion
+    bool fixed_offset;          // Use utc_offset instead of the local timezone
+    bool splice;                // vmsplice() range output into a pipe on stdout
+    uint32_t waterfall_rows;    // Seconds of history shown (waterfall)
+    binary_clock_graphics_protocol_t graphics_protocol; // Protocol spoken (graphics)
+    bool graphics_detect;       // Pick the protocol from the environment (graphics)
+    binary_clock_patch_framing_t patch_framing; // NDJSON or Server-Sent Events (patch)
+    uint32_t patch_resync;      // Updates from one full document to the next (patch)
+    char group[64];             // Multicast group (broadcast/receive)
+    uint16_t port;              // Multicast port (broadcast/receive)
+    const char* interface;      // Local interface address, NULL for default
+    int ttl;                    // Multicast TTL (broadcast)
+    bool present_log;           // Report each frame's commit error on stderr
+    size_t max_backlog;         // Skip frames while more output is queued, 0 = never
+    int64_t soak_seconds;       // Virtual seconds to run (soak)
+    uint32_t soak_speed;        // Multiple of real time, 0 = as fast as possible (soak)
+    int64_t soak_start;         // Virtual start epoch, 0 = now (soak)
+    char serve_address[64];     // Listen address (serve)
+    uint16_t serve_port;        // Listen port (serve)
+    binary_clock_admit_limits_t serve_limits; // Admission limits, 0 = off (serve)
+    char query_address[64];     // Listen address (query)
+    uint16_t query_port;        // Listen port (query)
+    const char* query_zones;    // Comma-separated zones to preload, NULL = none (query, h2c)
+    size_t query_cache;         // Cached responses (query, h2c)
+    char h2_address[64];        // Listen address (h2c)
+    uint16_t h2_port;           // Listen port (h2c)
+    binary_clock_statusbar_protocol_t statusbar; // Status bar protocol (statusbar)
+    const char* trace_path;     // Chrome trace written at exit, NULL = no tracing
+    size_t trace_events;        // Trace ring capacity, 0 = default
+    bool autotune;              // Measure and pick the clock and kernels at startup
+    const char* autotune_cache; // Autotune cache file, NULL = ~/.binary_clock_tune
+    bool mem_stats;             // Report memory per subsystem at exit
+    size_t mem_caps[BINARY_CLOCK_MEM_SUBSYSTEMS]; // Per-subsystem caps, UNCAPPED = none
 } config_t;
 
+// Clock and kernels picked by --autotune; the defaults otherwise
+static binary_clock_tune_t tune;
+static bool tuned = false;
+static binary_clock_convert_fn_t convert_epoch = binary_clock_state_from_epoch;
+static binary_clock_render_fn_t render_frame = binary_clock_display_render;
+
+// Write the whole buffer to stdout with as few system calls as possible
+static int write_stdout(const char* data, size_t length) {
+#ifdef _WIN32
+    return (fwrite(data, 1, length, stdout) == length && fflush(stdout) == 0) ? 0 : -1;
+#else
+    while (length > 0) {
+        ssize_t written = write(STDOUT_FILENO, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+#endif
+}
+
+// Current state in the configured time basis
+static binary_clock_state_t current_state(const config_t* config) {
+    if (config->fixed_offset) {
+        // Skips localtime() and with it the timezone database lookup
+        time_t now = time(NULL);
+        if (now == (time_t)-1) {
+            binary_clock_state_t failed = {0};
+            return failed;
+        }
+        return convert_epoch((int64_t)now, config->utc_offset);
+    }
+    return binary_clock_get_current_state();
+}
+
+// State for a given epoch second in the configured time basis
+static binary_clock_state_t state_at(const config_t* config, int64_t epoch) {
+    if (config->fixed_offset) {
+        return convert_epoch(epoch, config->utc_offset);
+    }
+
+    binary_clock_state_t failed = {0};
+    time_t seconds = (time_t)epoch;
+    struct tm* local = localtime(&seconds);
+    if (local == NULL) {
+        return failed;
+    }
+    time_components_t components = {
+        (uint8_t)local->tm_hour,
+        (uint8_t)local->tm_min,
+        (uint8_t)(local->tm_sec > 59 ? 59 : local->tm_sec)  // Leap second
+    };
+    binary_clock_state_t state = binary_clock_state_from_time(&components);
+    state.timestamp = (binary_clock_time_t)epoch;
+    return state;
+}
+
+// Trace file written by save_trace() at exit
+static const char* trace_path = NULL;
+
+// Write the recorded trace; runs at exit, including Ctrl+C in loop modes
+static void save_trace(void) {
+    binary_clock_trace_stats_t stats = binary_clock_trace_get_stats();
+    binary_clock_error_t error = binary_clock_trace_save(trace_path);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot write trace '%s': %s\n", trace_path, binary_clock_get_error_string(error));
+        return;
+    }
+    fprintf(stderr, "Trace: latest %llu of %llu events written to %s\n",
+            (unsigned long long)(stats.recorded - stats.overwritten), (unsigned long long)stats.recorded,
+            trace_path);
+}
+
+// Report the memory each subsystem holds and held at most; runs at exit
+static void report_memory(void) {
+    char report[BINARY_CLOCK_MEM_REPORT_SIZE];
+    binary_clock_mem_report(report, sizeof(report));
+    fprintf(stderr, "Memory:\n%s", report);
+}
+
+// Responder reported by report_queries() at exit
+static binary_clock_query_t* query_responder = NULL;
+
+// Report query counts, cache hit rate and latency; runs at exit (Ctrl+C)
+static void report_queries(void) {
+    char report[BINARY_CLOCK_QUERY_REPORT_SIZE];
+    binary_clock_query_report(query_responder, report, sizeof(report));
+    fprintf(stderr, "Queries: %s\n", report);
+}
+
+// h2c server reported by report_h2() at exit
+static binary_clock_h2_server_t* h2_server = NULL;
+
+// Report connections, streams and ticks; runs at exit (Ctrl+C)
+static void report_h2(void) {
+    char report[256];
+    binary_clock_h2_report(h2_server, report, sizeof(report));
+    fprintf(stderr, "HTTP/2: %s\n", report);
+}
+
+// Waterfall whose scroll region end_waterfall() restores at exit
+static const binary_clock_waterfall_t* active_waterfall = NULL;
+
+// Give the terminal back its full-screen scrolling, once; runs at exit
+static void end_waterfall(void) {
+    char sequence[BINARY_CLOCK_WATERFALL_SEQUENCE_SIZE];
+    size_t length = binary_clock_waterfall_end(active_waterfall, sequence, sizeof(sequence));
+    active_waterfall = NULL;
+    if (length > 0) {
+        write_stdout(sequence, length);
+    }
+}
+
+// Graphics display whose images end_graphics() frees at exit
+static binary_clock_graphics_t* active_graphics = NULL;
+
+// Free the terminal's copies of the LED images, once; runs at exit
+static void end_graphics(void) {
+    char sequence[128];
+    size_t length = binary_clock_graphics_end(active_graphics, sequence, sizeof(sequence));
+    active_graphics = NULL;
+    if (length > 0) {
+        write_stdout(sequence, length);
+    }
+}
+
+// Pick the clock source and kernels for this host, reusing the cached
+// decision when it was made on the same CPU model
+static void autotune(const config_t* config) {
+    char default_cache[512];
+    const char* cache = config->autotune_cache;
+    if (cache == NULL) {
+#ifdef _WIN32
+        const char* home = getenv("USERPROFILE");
+#else
+        const char* home = getenv("HOME");
+#endif
+        if (home != NULL && home[0] != '\0' &&
+            snprintf(default_cache, sizeof(default_cache), "%s/.binary_clock_tune", home) < (int)sizeof(default_cache)) {
+            cache = default_cache;
+        }
+    }
+
+    binary_clock_tune_init(&tune);
+    if (cache == NULL || binary_clock_tune_load(&tune, cache) != BINARY_CLOCK_SUCCESS) {
+        binary_clock_tune_run(&tune, 0);
+        if (cache != NULL && binary_clock_tune_save(&tune, cache) != BINARY_CLOCK_SUCCESS) {
+            fprintf(stderr, "Warning: Cannot write autotune cache '%s'\n", cache);
+        }
+    }
+    convert_epoch = binary_clock_tune_convert_fn(&tune);
+    render_frame = binary_clock_tune_render_fn(&tune);
+    tuned = true;
+
+    // Soak mode reports the choice with its results
+    if (config->operation_mode != MODE_SOAK) {
+        char summary[512];
+        binary_clock_tune_describe(&tune, summary, sizeof(summary));
+        fprintf(stderr, "Autotune: %s\n", summary);
+    }
+}
+
+// Give a presenter the tuned render kernel and, unless it runs on its own
+// (virtual) clock, the tuned clock source
+static void apply_tuning(binary_clock_presenter_t* presenter, bool use_clock) {
+    presenter->render = render_frame;
+    if (tuned && use_clock) {
+        binary_clock_present_clock_t source = binary_clock_tune_clock_source(&tune);
+        binary_clock_presenter_set_clock(presenter, &source);
+    }
+}
+
 // Signal handler for graceful exit
 void signal_handler(int sig) {
     (void)sig; // Suppress unused parameter warning
@@ -68,6 +335,26 @@ void signal_handler(int sig) {
     exit(0);
 }
 
+// Status bars stop their producer with a signal: exit without writing
+// anything the bar would have to parse, but still run the atexit handlers
+static void statusbar_signal_handler(int sig) {
+    (void)sig;
+    exit(0);
+}
+
+// Ctrl+C in waterfall mode: leave the scroll region before the goodbye line,
+// which would otherwise land on a history row
+static void waterfall_signal_handler(int sig) {
+    end_waterfall();
+    signal_handler(sig);
+}
+
+// Ctrl+C in graphics mode: free the images and leave the clock's rows first
+static void graphics_signal_handler(int sig) {
+    end_graphics();
+    signal_handler(sig);
+}
+
 // Raw API display function
 void binary_clock_display_raw_api(const binary_clock_state_t* state, void* context) {
     (void)context; // Unused parameter
@@ -134,7 +421,63 @@ void print_usage(const char* program_name) {
     printf("                    binary: 0s and 1s\n");
     printf("                    json:   JSON format\n");
     printf("                    raw:    Raw API data structures\n");
+    printf("                    ndjson: One JSON document per line\n");
+    printf("                    arrow, arrow-file: Arrow IPC stream/file (--range only)\n");
+    printf("                    waterfall: Scrolling history of LED rows (--loop only)\n");
+    printf("                    graphics: LED images, kitty protocol or sixel as the\n");
+    printf("                    terminal supports; kitty, sixel to choose (--loop only)\n");
+    printf("                    patch: A JSON document, then merge patches of what\n");
+    printf("                    changed; patch-sse as Server-Sent Events (--loop only)\n");
     printf("  --loop            Run continuously (default: single output)\n");
+    printf("  --history=N       Seconds of history --display=waterfall shows (default: %d,\n",
+           BINARY_CLOCK_WATERFALL_DEFAULT_ROWS);
+    printf("                    at most what fits the terminal)\n");
+    printf("  --resync=N        Updates from one full --display=patch document to the next\n");
+    printf("                    (default: %d, 0 = first only)\n", BINARY_CLOCK_PATCH_DEFAULT_RESYNC);
+    printf("  --range=S:E       Output every second from epoch S up to (not incl.) E\n");
+    printf("  --no-splice       Copy --range output into pipes instead of vmsplice()\n");
+    printf("  --utc             Use UTC instead of the local timezone\n");
+    printf("  --utc-offset=SEC  Use a fixed UTC offset in seconds (range default: 0)\n");
+    printf("  --broadcast[=GROUP:PORT]  Send one multicast tick per second\n");
+    printf("                    (default group %s:%d)\n",
+           BINARY_CLOCK_MULTICAST_DEFAULT_GROUP, BINARY_CLOCK_MULTICAST_DEFAULT_PORT);
+    printf("  --receive[=GROUP:PORT]    Display ticks from a broadcaster\n");
+    printf("  --interface=ADDR  Local interface address for multicast\n");
+    printf("  --ttl=N           Multicast TTL for --broadcast (default: 1)\n");
+    printf("  --serve[=ADDR:PORT]       Stream the live clock to telnet/nc clients\n");
+    printf("                    (default %s:%d)\n",
+           BINARY_CLOCK_STREAM_DEFAULT_ADDRESS, BINARY_CLOCK_STREAM_DEFAULT_PORT);
+    printf("  --max-clients=N   Serve at most N clients; later ones are told the server is busy\n");
+    printf("  --max-per-ip=N    Serve at most N clients from one address\n");
+    printf("  --accept-rate=N[:BURST]  Admit N new clients per second, BURST at once\n");
+    printf("  --query[=ADDR:PORT]       Answer GET /at?t=EPOCH&tz=ZONE&fmt=FORMAT over HTTP\n");
+    printf("                    (default %s:%d)\n",
+           BINARY_CLOCK_QUERY_DEFAULT_ADDRESS, BINARY_CLOCK_QUERY_DEFAULT_PORT);
+    printf("  --h2c[=ADDR:PORT]         Answer /at and stream /ticks?tz=ZONE&fmt=FORMAT over\n");
+    printf("                    cleartext HTTP/2, many streams per connection (default %s:%d)\n",
+           BINARY_CLOCK_H2_DEFAULT_ADDRESS, BINARY_CLOCK_H2_DEFAULT_PORT);
+    printf("  --zones=LIST      Zones served besides UTC, e.g. Europe/Berlin,Asia/Tokyo,+05:30\n");
+    printf("  --query-cache=N   Responses kept in the query cache (default: %d, 0 = off)\n",
+           BINARY_CLOCK_QUERY_DEFAULT_CACHE_ENTRIES);
+    printf("  --statusbar=BAR   Feed a status bar until it exits, writing only when the\n");
+    printf("                    clock changes (i3bar, swaybar, tmux)\n");
+    printf("  --present-log     Report each frame's commit error on stderr\n");
+    printf("  --max-backlog=N   Skip a frame while more than N bytes of output are still\n");
+    printf("                    queued for the terminal (default: %d, 0 = never skip)\n",
+           BINARY_CLOCK_PRESENT_DEFAULT_BACKLOG);
+    printf("  --soak=DURATION   Run the loop pipeline on a virtual clock for DURATION\n");
+    printf("                    (seconds, or with an s/m/h/d suffix) and check every frame\n");
+    printf("  --speed=N         Soak speed as a multiple of real time (default: max)\n");
+    printf("  --start=EPOCH     Soak start time (default: now)\n");
+    printf("  --trace=FILE      Record ticks, callbacks and writes; write a Chrome\n");
+    printf("                    trace (open in ui.perfetto.dev) to FILE at exit\n");
+    printf("  --trace-events=N  Latest events kept for --trace (default: %d)\n",
+           BINARY_CLOCK_TRACE_DEFAULT_EVENTS);
+    printf("  --mem-stats       Report bytes used and peak per subsystem at exit\n");
+    printf("  --mem-cap=SUB:BYTES  Cap a subsystem (tables, caches, registry, queues);\n");
+    printf("                    over its cap it switches to a leaner mode (repeatable)\n");
+    printf("  --autotune[=FILE] Measure clock sources and kernels, use the fastest;\n");
+    printf("                    the choice is cached in FILE (default: ~/.binary_clock_tune)\n");
     printf("  --help, -h        Show this help message\n");
     printf("\n");
     printf("Examples:\n");
@@ -142,13 +485,111 @@ void print_usage(const char* program_name) {
     printf("  %s --loop                   # Continuous emoji display\n", program_name);
     printf("  %s --display=binary         # Single binary output\n", program_name);
     printf("  %s --display=json --loop    # Continuous JSON output\n", program_name);
+    printf("  %s --display=waterfall --loop --history=40   # Watch the bits evolve\n", program_name);
+    printf("  %s --display=graphics --loop   # Font-independent LEDs in kitty or a sixel terminal\n",
+           program_name);
+    printf("  %s --display=patch-sse --loop   # Deltas for an EventSource dashboard\n", program_name);
+    printf("  %s --display=arrow-file --range=1700000000:1700086400 > day.arrow\n", program_name);
+    printf("  %s --broadcast              # Drive every display on the LAN\n", program_name);
+    printf("  %s --receive --display=binary\n", program_name);
+    printf("  %s --serve                  # Then: telnet HOST %d\n", program_name, BINARY_CLOCK_STREAM_DEFAULT_PORT);
+    printf("  %s --query --zones=Europe/Berlin   # Then: curl 'HOST:%d/at?t=0&tz=Europe/Berlin'\n",
+           program_name, BINARY_CLOCK_QUERY_DEFAULT_PORT);
+    printf("  %s --h2c                    # Then: curl --http2-prior-knowledge -N 'HOST:%d/ticks'\n",
+           program_name, BINARY_CLOCK_H2_DEFAULT_PORT);
+    printf("  %s --soak=7d --display=json   # A week of ticks in seconds\n", program_name);
+    printf("  %s --statusbar=tmux --display=binary   # In tmux: #(binary_clock ...)\n", program_name);
+}
+
+// Parse a signed decimal integer, rejecting trailing garbage and values
+// out of range (strtoll() would clamp them)
+static int parse_int64(const char* text, int64_t* value) {
+    char* end = NULL;
+    errno = 0;
+    long long parsed = strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno == ERANGE) {
+        return -1;
+    }
+    *value = (int64_t)parsed;
+    return 0;
+}
+
+// Parse a HOST:PORT endpoint; a listener may ask for port 0 (any free port)
+static int parse_endpoint(const char* text, char* host, size_t host_size, uint16_t* port, bool listen) {
+    const char* separator = strrchr(text, ':');
+    int64_t value = 0;
+    if (separator == NULL || (size_t)(separator - text) >= host_size ||
+        parse_int64(separator + 1, &value) != 0 || value < (listen ? 0 : 1) || value > 65535) {
+        return -1;
+    }
+    memcpy(host, text, (size_t)(separator - text));
+    host[separator - text] = '\0';
+    *port = (uint16_t)value;
+    return 0;
+}
+
+// Parse a duration in seconds with an optional s/m/h/d suffix
+static int parse_duration(const char* text, int64_t* seconds) {
+    char number[32];
+    size_t length = strlen(text);
+    int64_t unit = 1;
+    if (length == 0 || length >= sizeof(number)) {
+        return -1;
+    }
+    memcpy(number, text, length + 1);
+    switch (number[length - 1]) {
+        case 's': unit = 1; break;
+        case 'm': unit = 60; break;
+        case 'h': unit = 3600; break;
+        case 'd': unit = 86400; break;
+        default: length++; break;  // No suffix
+    }
+    number[length - 1] = '\0';
+    if (parse_int64(number, seconds) != 0 || *seconds <= 0 || *seconds > INT64_MAX / 86400) {
+        return -1;
+    }
+    *seconds *= unit;
+    return 0;
 }
 
 // Parse command line arguments
 config_t parse_arguments(int argc, char* argv[]) {
     config_t config = {
         .display_mode = DISPLAY_EMOJI,  // Default to emoji
-        .operation_mode = MODE_SINGLE   // Default to single output
+        .operation_mode = MODE_SINGLE,  // Default to single output
+        .range_start = 0,
+        .range_end = 0,
+        .utc_offset = 0,
+        .fixed_offset = false,
+        .splice = true,
+        .waterfall_rows = BINARY_CLOCK_WATERFALL_DEFAULT_ROWS,
+        .patch_framing = BINARY_CLOCK_PATCH_NDJSON,
+        .patch_resync = BINARY_CLOCK_PATCH_DEFAULT_RESYNC,
+        .group = BINARY_CLOCK_MULTICAST_DEFAULT_GROUP,
+        .port = BINARY_CLOCK_MULTICAST_DEFAULT_PORT,
+        .interface = NULL,
+        .ttl = 1,
+        .present_log = false,
+        .max_backlog = BINARY_CLOCK_PRESENT_DEFAULT_BACKLOG,
+        .soak_seconds = 0,
+        .soak_speed = 0,
+        .soak_start = 0,
+        .serve_address = BINARY_CLOCK_STREAM_DEFAULT_ADDRESS,
+        .serve_port = BINARY_CLOCK_STREAM_DEFAULT_PORT,
+        .query_address = BINARY_CLOCK_QUERY_DEFAULT_ADDRESS,
+        .query_port = BINARY_CLOCK_QUERY_DEFAULT_PORT,
+        .query_zones = NULL,
+        .query_cache = BINARY_CLOCK_QUERY_DEFAULT_CACHE_ENTRIES,
+        .h2_address = BINARY_CLOCK_H2_DEFAULT_ADDRESS,
+        .h2_port = BINARY_CLOCK_H2_DEFAULT_PORT,
+        .statusbar = BINARY_CLOCK_STATUSBAR_I3BAR,
+        .trace_path = NULL,
+        .trace_events = 0,
+        .autotune = false,
+        .autotune_cache = NULL,
+        .mem_stats = false,
+        .mem_caps = {BINARY_CLOCK_MEM_UNCAPPED, BINARY_CLOCK_MEM_UNCAPPED,
+                     BINARY_CLOCK_MEM_UNCAPPED, BINARY_CLOCK_MEM_UNCAPPED}
     };
     
     for (int i = 1; i < argc; i++) {
@@ -173,11 +614,277 @@ config_t parse_arguments(int argc, char* argv[]) {
             else if (strcmp(mode, "raw") == 0) {
                 config.display_mode = DISPLAY_RAW;
             }
+            else if (strcmp(mode, "ndjson") == 0) {
+                config.display_mode = DISPLAY_NDJSON;
+            }
+            else if (strcmp(mode, "arrow") == 0) {
+                config.display_mode = DISPLAY_ARROW;
+            }
+            else if (strcmp(mode, "arrow-file") == 0) {
+                config.display_mode = DISPLAY_ARROW_FILE;
+            }
+            else if (strcmp(mode, "waterfall") == 0) {
+                config.display_mode = DISPLAY_WATERFALL;
+            }
+            else if (strcmp(mode, "graphics") == 0) {
+                config.display_mode = DISPLAY_GRAPHICS;
+                config.graphics_detect = true;
+            }
+            else if (strcmp(mode, "kitty") == 0 || strcmp(mode, "sixel") == 0) {
+                config.display_mode = DISPLAY_GRAPHICS;
+                config.graphics_detect = false;
+                config.graphics_protocol = strcmp(mode, "kitty") == 0 ? BINARY_CLOCK_GRAPHICS_KITTY
+                                                                      : BINARY_CLOCK_GRAPHICS_SIXEL;
+            }
+            else if (strcmp(mode, "patch") == 0 || strcmp(mode, "patch-sse") == 0) {
+                config.display_mode = DISPLAY_PATCH;
+                config.patch_framing = strcmp(mode, "patch") == 0 ? BINARY_CLOCK_PATCH_NDJSON
+                                                                  : BINARY_CLOCK_PATCH_SSE;
+            }
             else {
                 fprintf(stderr, "Error: Unknown display mode '%s'\n", mode);
-                fprintf(stderr, "Valid modes: emoji, binary, json, raw\n");
+                fprintf(stderr, "Valid modes: emoji, binary, json, raw, ndjson, arrow, arrow-file, waterfall,\n"
+                                "             graphics, kitty, sixel, patch, patch-sse\n");
+                exit(1);
+            }
+        }
+        else if (strncmp(argv[i], "--history=", 10) == 0) {
+            int64_t rows = 0;
+            if (parse_int64(argv[i] + 10, &rows) != 0 || rows < BINARY_CLOCK_WATERFALL_MIN_ROWS ||
+                rows > BINARY_CLOCK_WATERFALL_MAX_ROWS) {
+                fprintf(stderr, "Error: Invalid history '%s' (%d to %d seconds)\n", argv[i] + 10,
+                        BINARY_CLOCK_WATERFALL_MIN_ROWS, BINARY_CLOCK_WATERFALL_MAX_ROWS);
+                exit(1);
+            }
+            config.waterfall_rows = (uint32_t)rows;
+        }
+        else if (strncmp(argv[i], "--resync=", 9) == 0) {
+            int64_t updates = 0;
+            if (parse_int64(argv[i] + 9, &updates) != 0 || updates < 0 || updates > 1000000000) {
+                fprintf(stderr, "Error: Invalid resync '%s' (expected updates, 0 = first document only)\n",
+                        argv[i] + 9);
                 exit(1);
             }
+            config.patch_resync = (uint32_t)updates;
+        }
+        else if (strncmp(argv[i], "--range=", 8) == 0) {
+            char range[64];
+            strncpy(range, argv[i] + 8, sizeof(range) - 1);
+            range[sizeof(range) - 1] = '\0';
+            
+            char* separator = strchr(range, ':');
+            if (separator != NULL) {
+                *separator = '\0';
+            }
+            if (separator == NULL ||
+                parse_int64(range, &config.range_start) != 0 ||
+                parse_int64(separator + 1, &config.range_end) != 0 ||
+                config.range_end < config.range_start) {
+                fprintf(stderr, "Error: Invalid range '%s' (expected START:END epoch seconds)\n", argv[i] + 8);
+                exit(1);
+            }
+            config.operation_mode = MODE_RANGE;
+        }
+        else if (strcmp(argv[i], "--no-splice") == 0) {
+            config.splice = false;
+        }
+        else if (strncmp(argv[i], "--utc-offset=", 13) == 0) {
+            int64_t offset = 0;
+            if (parse_int64(argv[i] + 13, &offset) != 0 || offset < -86400 || offset > 86400) {
+                fprintf(stderr, "Error: Invalid UTC offset '%s' (expected seconds)\n", argv[i] + 13);
+                exit(1);
+            }
+            config.utc_offset = (int32_t)offset;
+            config.fixed_offset = true;
+        }
+        else if (strcmp(argv[i], "--utc") == 0) {
+            config.utc_offset = 0;
+            config.fixed_offset = true;
+        }
+        else if (strcmp(argv[i], "--broadcast") == 0 || strncmp(argv[i], "--broadcast=", 12) == 0 ||
+                 strcmp(argv[i], "--receive") == 0 || strncmp(argv[i], "--receive=", 10) == 0) {
+            bool broadcast = argv[i][2] == 'b';
+            const char* endpoint = strchr(argv[i], '=');
+            if (endpoint != NULL &&
+                parse_endpoint(endpoint + 1, config.group, sizeof(config.group), &config.port, false) != 0) {
+                fprintf(stderr, "Error: Invalid multicast endpoint '%s' (expected GROUP:PORT)\n", endpoint + 1);
+                exit(1);
+            }
+            config.operation_mode = broadcast ? MODE_BROADCAST : MODE_RECEIVE;
+        }
+        else if (strcmp(argv[i], "--serve") == 0 || strncmp(argv[i], "--serve=", 8) == 0) {
+            if (argv[i][7] == '=' &&
+                parse_endpoint(argv[i] + 8, config.serve_address, sizeof(config.serve_address),
+                               &config.serve_port, true) != 0) {
+                fprintf(stderr, "Error: Invalid listen endpoint '%s' (expected ADDRESS:PORT)\n", argv[i] + 8);
+                exit(1);
+            }
+            config.operation_mode = MODE_SERVE;
+        }
+        else if (strcmp(argv[i], "--query") == 0 || strncmp(argv[i], "--query=", 8) == 0) {
+            if (argv[i][7] == '=' &&
+                parse_endpoint(argv[i] + 8, config.query_address, sizeof(config.query_address),
+                               &config.query_port, true) != 0) {
+                fprintf(stderr, "Error: Invalid listen endpoint '%s' (expected ADDRESS:PORT)\n", argv[i] + 8);
+                exit(1);
+            }
+            config.operation_mode = MODE_QUERY;
+        }
+        else if (strcmp(argv[i], "--h2c") == 0 || strncmp(argv[i], "--h2c=", 6) == 0) {
+            if (argv[i][5] == '=' &&
+                parse_endpoint(argv[i] + 6, config.h2_address, sizeof(config.h2_address),
+                               &config.h2_port, true) != 0) {
+                fprintf(stderr, "Error: Invalid listen endpoint '%s' (expected ADDRESS:PORT)\n", argv[i] + 6);
+                exit(1);
+            }
+            config.operation_mode = MODE_H2C;
+        }
+        else if (strncmp(argv[i], "--zones=", 8) == 0) {
+            config.query_zones = argv[i] + 8;
+        }
+        else if (strncmp(argv[i], "--query-cache=", 14) == 0) {
+            int64_t entries = 0;
+            if (parse_int64(argv[i] + 14, &entries) != 0 || entries < 0 || entries > INT32_MAX) {
+                fprintf(stderr, "Error: Invalid query cache size '%s'\n", argv[i] + 14);
+                exit(1);
+            }
+            config.query_cache = (size_t)entries;
+        }
+        else if (strncmp(argv[i], "--statusbar=", 12) == 0) {
+            const char* protocol = argv[i] + 12;
+            if (strcmp(protocol, "i3bar") == 0 || strcmp(protocol, "swaybar") == 0) {
+                config.statusbar = BINARY_CLOCK_STATUSBAR_I3BAR;
+            } else if (strcmp(protocol, "tmux") == 0) {
+                config.statusbar = BINARY_CLOCK_STATUSBAR_TMUX;
+            } else {
+                fprintf(stderr, "Error: Unknown status bar '%s'\n", protocol);
+                fprintf(stderr, "Valid status bars: i3bar, swaybar, tmux\n");
+                exit(1);
+            }
+            config.operation_mode = MODE_STATUSBAR;
+        }
+        else if (strncmp(argv[i], "--interface=", 12) == 0) {
+            config.interface = argv[i] + 12;
+        }
+        else if (strcmp(argv[i], "--present-log") == 0) {
+            config.present_log = true;
+        }
+        else if (strncmp(argv[i], "--max-backlog=", 14) == 0) {
+            int64_t bytes = 0;
+            if (parse_int64(argv[i] + 14, &bytes) != 0 || bytes < 0 || bytes > 1000000000) {
+                fprintf(stderr, "Error: Invalid backlog '%s' (expected bytes, 0 = never skip)\n", argv[i] + 14);
+                exit(1);
+            }
+            config.max_backlog = (size_t)bytes;
+        }
+        else if (strncmp(argv[i], "--soak=", 7) == 0) {
+            if (parse_duration(argv[i] + 7, &config.soak_seconds) != 0) {
+                fprintf(stderr, "Error: Invalid soak duration '%s' (expected e.g. 3600, 90m, 7d)\n", argv[i] + 7);
+                exit(1);
+            }
+            config.operation_mode = MODE_SOAK;
+        }
+        else if (strncmp(argv[i], "--speed=", 8) == 0) {
+            int64_t speed = 0;
+            if (strcmp(argv[i] + 8, "max") != 0 &&
+                (parse_int64(argv[i] + 8, &speed) != 0 || speed < 0 || speed > 1000000000)) {
+                fprintf(stderr, "Error: Invalid speed '%s' (expected a multiple of real time or 'max')\n", argv[i] + 8);
+                exit(1);
+            }
+            config.soak_speed = (uint32_t)speed;
+        }
+        else if (strncmp(argv[i], "--start=", 8) == 0) {
+            if (parse_int64(argv[i] + 8, &config.soak_start) != 0 || config.soak_start <= 0) {
+                fprintf(stderr, "Error: Invalid start '%s' (expected epoch seconds)\n", argv[i] + 8);
+                exit(1);
+            }
+        }
+        else if (strncmp(argv[i], "--trace=", 8) == 0) {
+            if (argv[i][8] == '\0') {
+                fprintf(stderr, "Error: --trace needs a file name\n");
+                exit(1);
+            }
+            config.trace_path = argv[i] + 8;
+        }
+        else if (strncmp(argv[i], "--max-clients=", 14) == 0 || strncmp(argv[i], "--max-per-ip=", 13) == 0) {
+            const char* value = strchr(argv[i], '=') + 1;
+            int64_t limit = 0;
+            if (parse_int64(value, &limit) != 0 || limit <= 0 || limit > 100000000) {
+                fprintf(stderr, "Error: Invalid client limit '%s' (expected a client count)\n", value);
+                exit(1);
+            }
+            if (argv[i][6] == 'c') {
+                config.serve_limits.max_clients = (size_t)limit;
+            } else {
+                config.serve_limits.max_per_address = (uint32_t)limit;
+            }
+        }
+        else if (strncmp(argv[i], "--accept-rate=", 14) == 0) {
+            char rate[64];
+            strncpy(rate, argv[i] + 14, sizeof(rate) - 1);
+            rate[sizeof(rate) - 1] = '\0';
+            char* separator = strchr(rate, ':');
+            if (separator != NULL) {
+                *separator = '\0';
+            }
+            int64_t per_second = 0;
+            int64_t burst = 0;
+            if (parse_int64(rate, &per_second) != 0 || per_second <= 0 || per_second > 100000000 ||
+                (separator != NULL && (parse_int64(separator + 1, &burst) != 0 || burst <= 0 || burst > 100000000))) {
+                fprintf(stderr, "Error: Invalid accept rate '%s' (expected N or N:BURST)\n", argv[i] + 14);
+                exit(1);
+            }
+            config.serve_limits.rate = (uint32_t)per_second;
+            config.serve_limits.burst = (uint32_t)burst;
+        }
+        else if (strncmp(argv[i], "--trace-events=", 15) == 0) {
+            int64_t events = 0;
+            if (parse_int64(argv[i] + 15, &events) != 0 || events <= 0 || events > 100000000) {
+                fprintf(stderr, "Error: Invalid trace size '%s' (expected an event count)\n", argv[i] + 15);
+                exit(1);
+            }
+            config.trace_events = (size_t)events;
+        }
+        else if (strcmp(argv[i], "--autotune") == 0) {
+            config.autotune = true;
+        }
+        else if (strncmp(argv[i], "--autotune=", 11) == 0) {
+            if (argv[i][11] == '\0') {
+                fprintf(stderr, "Error: --autotune= needs a cache file name\n");
+                exit(1);
+            }
+            config.autotune = true;
+            config.autotune_cache = argv[i] + 11;
+        }
+        else if (strcmp(argv[i], "--mem-stats") == 0) {
+            config.mem_stats = true;
+        }
+        else if (strncmp(argv[i], "--mem-cap=", 10) == 0) {
+            char name[16];
+            strncpy(name, argv[i] + 10, sizeof(name) - 1);
+            name[sizeof(name) - 1] = '\0';
+            char* separator = strchr(name, ':');
+            const char* bytes_text = strchr(argv[i] + 10, ':');
+            if (separator != NULL) {
+                *separator = '\0';
+            }
+            binary_clock_mem_subsystem_t subsystem = BINARY_CLOCK_MEM_TABLES;
+            int64_t bytes = 0;
+            if (separator == NULL || binary_clock_mem_subsystem_from_name(name, &subsystem) != BINARY_CLOCK_SUCCESS ||
+                parse_int64(bytes_text + 1, &bytes) != 0 || bytes < 0) {
+                fprintf(stderr, "Error: Invalid memory cap '%s' (expected tables, caches, registry or queues:BYTES)\n",
+                        argv[i] + 10);
+                exit(1);
+            }
+            config.mem_caps[subsystem] = (size_t)bytes;
+        }
+        else if (strncmp(argv[i], "--ttl=", 6) == 0) {
+            int64_t ttl = 0;
+            if (parse_int64(argv[i] + 6, &ttl) != 0 || ttl < 0 || ttl > 255) {
+                fprintf(stderr, "Error: Invalid TTL '%s' (expected 0-255)\n", argv[i] + 6);
+                exit(1);
+            }
+            config.ttl = (int)ttl;
         }
         else {
             fprintf(stderr, "Error: Unknown option '%s'\n", argv[i]);
@@ -200,56 +907,887 @@ binary_clock_display_fn_t get_display_function(display_mode_t mode) {
             return binary_clock_display_json;
         case DISPLAY_RAW:
             return binary_clock_display_raw_api;
+        case DISPLAY_NDJSON:
+            return binary_clock_display_json_line;
         default:
             return binary_clock_display_console_emoji;
     }
 }
 
+// Get the buffer render format for a display mode, if it has one
+static bool get_render_format(display_mode_t mode, binary_clock_render_format_t* format) {
+    switch (mode) {
+        case DISPLAY_EMOJI:
+            *format = BINARY_CLOCK_RENDER_EMOJI;
+            return true;
+        case DISPLAY_BINARY:
+            *format = BINARY_CLOCK_RENDER_ASCII;
+            return true;
+        case DISPLAY_JSON:
+            *format = BINARY_CLOCK_RENDER_JSON;
+            return true;
+        case DISPLAY_NDJSON:
+            *format = BINARY_CLOCK_RENDER_JSON_LINE;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Whether frames repaint the screen (JSON streams are appended instead)
+static bool clears_screen(const config_t* config) {
+    return config->display_mode != DISPLAY_JSON && config->display_mode != DISPLAY_NDJSON;
+}
+
+// Display callback with its call recorded as a trace span
+static void call_display(binary_clock_display_fn_t display_fn, const binary_clock_state_t* state) {
+    binary_clock_trace_begin("display", "callback");
+    display_fn(state, NULL);
+    binary_clock_trace_end("display", "callback");
+}
+
+// Registered in place of a display function so the registry's calls are traced
+typedef struct {
+    binary_clock_display_fn_t display_fn;
+} traced_display_t;
+
+static void traced_display(const binary_clock_state_t* state, void* context) {
+    const traced_display_t* traced = context;
+    call_display(traced->display_fn, state);
+}
+
+// Log a frame dropped because the output was backlogged (--present-log)
+static void log_skipped(const config_t* config, int64_t present_at_us, long backlog, uint64_t skipped) {
+    if (config->present_log) {
+        fprintf(stderr, "present %lld.%06lld skipped backlog=%ld skipped=%llu\n",
+                (long long)(present_at_us / 1000000), (long long)(present_at_us % 1000000), backlog,
+                (unsigned long long)skipped);
+    }
+}
+
+// Skip a second while stdout holds more than --max-backlog unsent bytes.
+// Modes that write frames themselves call this on the second boundary;
+// the presenter makes the same check in binary_clock_presenter_commit().
+static bool skip_backlogged(const config_t* config, int64_t second, uint64_t* skipped) {
+    long backlog = binary_clock_present_pending_output(1);
+    if (config->max_backlog == 0 || backlog <= (long)config->max_backlog) {
+        return false;
+    }
+    (*skipped)++;
+    log_skipped(config, second * 1000000, backlog, *skipped);
+    return true;
+}
+
+// Stage a state for its presentation time and commit it at that instant.
+// The clear-screen prefix is part of the frame, so clear and repaint land
+// together; consoles without ANSI support (NULL prefix) are cleared first.
+static int present_frame(binary_clock_presenter_t* presenter, const config_t* config,
+                         const binary_clock_state_t* state, binary_clock_render_format_t format,
+                         const char* prefix, int64_t present_at_us) {
+    int64_t error_us = 0;
+    if (prefix == NULL && clears_screen(config)) {
+        clear_console();
+    }
+    uint64_t skipped = presenter->stats.skipped;
+    if (binary_clock_presenter_stage(presenter, state, format, prefix, present_at_us) != BINARY_CLOCK_SUCCESS ||
+        binary_clock_presenter_commit(presenter, &error_us) != BINARY_CLOCK_SUCCESS) {
+        return -1;
+    }
+    if (presenter->stats.skipped != skipped) {
+        log_skipped(config, present_at_us, presenter->stats.last_backlog, presenter->stats.skipped);
+    }
+    else if (config->present_log) {
+        fprintf(stderr, "present %lld.%06lld error_us=%lld\n", (long long)(present_at_us / 1000000),
+                (long long)(present_at_us % 1000000), (long long)error_us);
+    }
+    return 0;
+}
+
+// Broadcast mode: send each second's tick a little ahead of its presentation time
+static int run_broadcaster(const config_t* config) {
+    binary_clock_broadcaster_t broadcaster;
+    binary_clock_error_t error = binary_clock_broadcaster_open(&broadcaster, config->group, config->port,
+                                                               config->interface, config->ttl);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot broadcast to %s:%u: %s\n", config->group, (unsigned)config->port,
+                binary_clock_get_error_string(error));
+        return 1;
+    }
+    fprintf(stderr, "Broadcasting ticks to %s:%u\n", config->group, (unsigned)config->port);
+
+    const int64_t lead_us = BINARY_CLOCK_MULTICAST_DEFAULT_LEAD_MS * 1000;
+    int64_t last_second = 0;
+    while (1) {
+        int64_t second = binary_clock_present_now_us() / 1000000 + 1;
+        if (second <= last_second) {
+            second = last_second + 1;
+        }
+        binary_clock_trace_begin("tick", "wait");
+        binary_clock_present_sleep_until_us(second * 1000000 - lead_us);
+        binary_clock_trace_end("tick", "wait");
+
+        binary_clock_trace_begin("loop", "tick");
+        binary_clock_trace_begin("loop", "state");
+        binary_clock_state_t state = state_at(config, second);
+        binary_clock_trace_end("loop", "state");
+        binary_clock_trace_begin("sink", "send");
+        error = binary_clock_broadcaster_send(&broadcaster, binary_clock_pack_state(&state), second * 1000000);
+        binary_clock_trace_end("sink", "send");
+        binary_clock_trace_end("loop", "tick");
+        if (error != BINARY_CLOCK_SUCCESS) {
+            fprintf(stderr, "Warning: Tick %lld not sent: %s\n", (long long)second,
+                    binary_clock_get_error_string(error));
+        }
+        last_second = second;
+    }
+}
+
+// Receive mode: display every applied tick, reporting gaps on stderr
+static int run_receiver(const config_t* config, binary_clock_display_fn_t display_fn) {
+    binary_clock_receiver_t receiver;
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, 1);
+    apply_tuning(&presenter, true);
+    presenter.max_backlog = config->max_backlog;
+    const char* prefix = clears_screen(config) ? clear_sequence() : NULL;
+    binary_clock_error_t error = binary_clock_receiver_open(&receiver, config->group, config->port,
+                                                            config->interface);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot join %s:%u: %s\n", config->group, (unsigned)config->port,
+                binary_clock_get_error_string(error));
+        return 1;
+    }
+
+    while (1) {
+        binary_clock_tick_t tick;
+        int gap = 0;
+        binary_clock_trace_begin("tick", "receive");
+        error = binary_clock_receiver_receive(&receiver, &tick, &gap, -1);
+        binary_clock_trace_end("tick", "receive");
+        if (error != BINARY_CLOCK_SUCCESS) {
+            fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
+            binary_clock_receiver_close(&receiver);
+            return 1;
+        }
+        if (gap > 0) {
+            fprintf(stderr, "Warning: Missed %d tick%s before sequence %lu\n", gap, gap == 1 ? "" : "s",
+                    (unsigned long)tick.sequence);
+        }
+
+        // Ticks arrive ahead of time: stage now, commit at the presentation time
+        binary_clock_state_t state = binary_clock_state_from_packed(
+            tick.packed, (binary_clock_time_t)(tick.present_at_us / 1000000));
+        binary_clock_render_format_t format;
+        if (get_render_format(config->display_mode, &format)) {
+            if (present_frame(&presenter, config, &state, format, prefix, tick.present_at_us) != 0) {
+                binary_clock_receiver_close(&receiver);
+                return 1;
+            }
+        } else {
+            binary_clock_trace_begin("tick", "wait");
+            binary_clock_present_wait_until_us(tick.present_at_us);
+            binary_clock_trace_end("tick", "wait");
+            clear_console();
+            call_display(display_fn, &state);
+            fflush(stdout);
+        }
+    }
+}
+
+// Serve mode: tick every connected terminal on each second boundary and
+// service connections in between
+static int run_server(const config_t* config) {
+    binary_clock_render_format_t format;
+    if (config->display_mode != DISPLAY_EMOJI && config->display_mode != DISPLAY_BINARY) {
+        fprintf(stderr, "Error: --serve supports the emoji and binary displays\n");
+        return 1;
+    }
+    get_render_format(config->display_mode, &format);
+
+    binary_clock_stream_server_t server;
+    binary_clock_error_t error = binary_clock_stream_server_open(&server, config->serve_address,
+                                                                 config->serve_port, format);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot listen on %s:%u: %s\n", config->serve_address,
+                (unsigned)config->serve_port, binary_clock_get_error_string(error));
+        return 1;
+    }
+    server.render = render_frame;
+    binary_clock_stream_server_set_limits(&server, &config->serve_limits);
+    fprintf(stderr, "Serving the clock on %s:%u (connect with telnet or nc)\n",
+            config->serve_address, (unsigned)server.port);
+
+    int64_t last_second = 0;
+    while (1) {
+        int64_t second = binary_clock_present_now_us() / 1000000 + 1;
+        if (second <= last_second) {
+            second = last_second + 1;
+        }
+        // Poll until the final millisecond, then wait precisely
+        binary_clock_trace_begin("tick", "wait");
+        for (;;) {
+            int64_t remaining = second * 1000000 - binary_clock_present_now_us();
+            if (remaining <= 1000) {
+                break;
+            }
+            error = binary_clock_stream_server_poll(&server, (int)((remaining - 1000) / 1000));
+            if (error == BINARY_CLOCK_ERROR_NETWORK) {
+                fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
+                binary_clock_stream_server_close(&server);
+                return 1;
+            }
+        }
+        binary_clock_present_wait_until_us(second * 1000000);
+        binary_clock_trace_end("tick", "wait");
+
+        binary_clock_trace_begin("loop", "tick");
+        binary_clock_trace_begin("loop", "state");
+        binary_clock_state_t state = state_at(config, second);
+        binary_clock_trace_end("loop", "state");
+        binary_clock_stream_server_tick(&server, &state);
+        binary_clock_trace_end("loop", "tick");
+        last_second = second;
+    }
+}
+
+// Range mode: frames rendered straight into the pipe writer's buffers, which
+// are spliced into a pipe on stdout when possible; other displays print
+static int run_range(const config_t* config, binary_clock_display_fn_t display_fn) {
+    binary_clock_render_format_t format;
+    if (!get_render_format(config->display_mode, &format)) {
+        for (int64_t epoch = config->range_start; epoch < config->range_end; epoch++) {
+            binary_clock_state_t state = convert_epoch(epoch, config->utc_offset);
+            display_fn(&state, NULL);
+        }
+        return 0;
+    }
+
+#ifdef _WIN32
+    int fd = _fileno(stdout);
+#else
+    int fd = STDOUT_FILENO;
+#endif
+    binary_clock_pipe_writer_t writer;
+    binary_clock_error_t error = binary_clock_pipe_writer_open(&writer, fd, 0, config->splice);
+    for (int64_t epoch = config->range_start; epoch < config->range_end && error == BINARY_CLOCK_SUCCESS; epoch++) {
+        binary_clock_state_t state = convert_epoch(epoch, config->utc_offset);
+        char* frame = binary_clock_pipe_writer_reserve(&writer, BINARY_CLOCK_RENDER_MAX_SIZE);
+        size_t length = frame != NULL ? render_frame(&state, format, frame, BINARY_CLOCK_RENDER_MAX_SIZE) : 0;
+        error = length > 0 ? binary_clock_pipe_writer_commit(&writer, length) : BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    binary_clock_error_t closed = binary_clock_pipe_writer_close(&writer);
+    if (error == BINARY_CLOCK_SUCCESS) {
+        error = closed;
+    }
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
+        return 1;
+    }
+    return 0;
+}
+
+// Set up the responder of the query and h2c modes with the listed zones
+// preloaded and the table sealed: requests neither read zone files nor
+// take zone slots, so no client can fill the table for everyone else
+static int setup_responder(const config_t* config, binary_clock_query_t* query) {
+    binary_clock_error_t error = binary_clock_query_init(query, config->query_cache, NULL);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot set up queries: %s\n", binary_clock_get_error_string(error));
+        return 1;
+    }
+    query->render = render_frame;
+
+    const char* zones = config->query_zones != NULL ? config->query_zones : "";
+    while (*zones != '\0') {
+        size_t length = strcspn(zones, ",");
+        char name[BINARY_CLOCK_ZONE_NAME_SIZE];
+        if (length > 0) {
+            if (length >= sizeof(name)) {
+                fprintf(stderr, "Error: Zone name too long: '%.*s'\n", (int)length, zones);
+                return 1;
+            }
+            memcpy(name, zones, length);
+            name[length] = '\0';
+            error = binary_clock_query_add_zone(query, name, NULL);
+            if (error != BINARY_CLOCK_SUCCESS) {
+                fprintf(stderr, "Error: Cannot load zone '%s': %s\n", name, binary_clock_get_error_string(error));
+                return 1;
+            }
+        }
+        zones += length + (zones[length] == ',');
+    }
+    binary_clock_query_seal_zones(query);
+    return 0;
+}
+
+// Query mode: load the zones, then answer /at requests until interrupted
+static int run_query(const config_t* config) {
+    static binary_clock_query_t query;
+    if (setup_responder(config, &query) != 0) {
+        return 1;
+    }
+
+    binary_clock_query_server_t server;
+    binary_clock_error_t error = binary_clock_query_server_open(&server, &query, config->query_address, config->query_port);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot listen on %s:%u: %s\n", config->query_address,
+                (unsigned)config->query_port, binary_clock_get_error_string(error));
+        return 1;
+    }
+    query_responder = &query;
+    atexit(report_queries);
+    fprintf(stderr, "Answering queries on %s:%u (GET /at?t=EPOCH&tz=ZONE&fmt=FORMAT, %lu zones loaded)\n",
+            config->query_address, (unsigned)server.port, (unsigned long)query.zone_count);
+
+    while (1) {
+        error = binary_clock_query_server_poll(&server, 1000);
+        if (error == BINARY_CLOCK_ERROR_NETWORK) {
+            fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
+            binary_clock_query_server_close(&server);
+            return 1;
+        }
+    }
+}
+
+// h2c mode: answer /at streams as they come and send every second to the
+// /ticks streams on its boundary
+static int run_h2c(const config_t* config) {
+    static binary_clock_query_t query;
+    if (setup_responder(config, &query) != 0) {
+        return 1;
+    }
+
+    static binary_clock_h2_server_t server;
+    binary_clock_error_t error = binary_clock_h2_server_open(&server, &query, config->h2_address, config->h2_port);
+    if (error != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: Cannot listen on %s:%u: %s\n", config->h2_address,
+                (unsigned)config->h2_port, binary_clock_get_error_string(error));
+        return 1;
+    }
+    query_responder = &query;
+    h2_server = &server;
+    atexit(report_queries);
+    atexit(report_h2);
+    fprintf(stderr, "Answering HTTP/2 (h2c) on %s:%u (GET /at?t=EPOCH&tz=ZONE&fmt=FORMAT, "
+            "GET /ticks?tz=ZONE&fmt=FORMAT, %lu zones loaded)\n",
+            config->h2_address, (unsigned)server.port, (unsigned long)query.zone_count);
+
+    int64_t last_second = 0;
+    while (1) {
+        int64_t second = binary_clock_present_now_us() / 1000000 + 1;
+        if (second <= last_second) {
+            second = last_second + 1;
+        }
+        // Poll until the final millisecond, then wait precisely
+        for (;;) {
+            int64_t remaining = second * 1000000 - binary_clock_present_now_us();
+            if (remaining <= 1000) {
+                break;
+            }
+            error = binary_clock_h2_server_poll(&server, (int)((remaining - 1000) / 1000));
+            if (error == BINARY_CLOCK_ERROR_NETWORK) {
+                fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
+                binary_clock_h2_server_close(&server);
+                return 1;
+            }
+        }
+        binary_clock_present_wait_until_us(second * 1000000);
+        binary_clock_h2_server_tick(&server, second);
+        last_second = second;
+    }
+}
+
+// Status bar mode: render the current second and write it only if the
+// text changed, then sleep to the next second boundary. No spinning: a
+// bar has no use for microsecond precision, so each change costs one wakeup.
+static int run_statusbar(const config_t* config) {
+    binary_clock_render_format_t format;
+    if (config->display_mode == DISPLAY_EMOJI) {
+        format = BINARY_CLOCK_RENDER_EMOJI_LINE;
+    } else if (config->display_mode == DISPLAY_BINARY) {
+        format = BINARY_CLOCK_RENDER_COMPACT;
+    } else {
+        fprintf(stderr, "Error: --statusbar supports the emoji and binary displays\n");
+        return 1;
+    }
+
+    binary_clock_statusbar_t statusbar;
+    binary_clock_statusbar_init(&statusbar, config->statusbar, format);
+    statusbar.render = render_frame;
+    char output[BINARY_CLOCK_STATUSBAR_MAX_SIZE];
+    while (1) {
+        int64_t second = binary_clock_present_now_us() / 1000000;
+        binary_clock_trace_begin("loop", "tick");
+        binary_clock_trace_begin("loop", "state");
+        binary_clock_state_t state = state_at(config, second);
+        binary_clock_trace_end("loop", "state");
+        size_t length = binary_clock_statusbar_update(&statusbar, &state, output, sizeof(output));
+        if (length == (size_t)-1) {
+            binary_clock_trace_end("loop", "tick");
+            fprintf(stderr, "Error: Cannot render the status line\n");
+            return 1;
+        }
+        if (length > 0) {
+            binary_clock_trace_begin("sink", "write");
+            int result = write_stdout(output, length);
+            binary_clock_trace_end("sink", "write");
+            if (result != 0) {
+                binary_clock_trace_end("loop", "tick");
+                return 1;  // The bar went away
+            }
+        }
+        binary_clock_trace_end("loop", "tick");
+        binary_clock_trace_begin("tick", "wait");
+        binary_clock_present_sleep_until_us((second + 1) * 1000000);
+        binary_clock_trace_end("tick", "wait");
+    }
+}
+
+// One loop iteration: stage the next second on the presenter's clock and
+// commit it on the boundary. Shared by loop and soak mode. A display
+// catches up to the clock after a late tick; contiguous (soak) presents
+// every second in turn, and lateness only shows in presenter->stats.
+static int loop_tick(binary_clock_presenter_t* presenter, const config_t* config,
+                     binary_clock_render_format_t format, const char* prefix, bool contiguous,
+                     int64_t* last_second) {
+    int64_t second = *last_second + 1;
+    int64_t next = binary_clock_presenter_now_us(presenter) / 1000000 + 1;
+    if (!contiguous && next > second) {
+        second = next;
+    }
+    binary_clock_trace_begin("loop", "tick");
+    binary_clock_trace_begin("loop", "state");
+    binary_clock_state_t state = state_at(config, second);
+    binary_clock_trace_end("loop", "state");
+    *last_second = second;
+    int result = present_frame(presenter, config, &state, format, prefix, second * 1000000);
+    binary_clock_trace_end("loop", "tick");
+    return result;
+}
+
+// Loop mode: stage each second ahead and commit it on the second boundary
+static int run_loop(const config_t* config, binary_clock_display_fn_t display_fn) {
+    printf("🌚🌝 Binary Clock v%s 🌝🌚\n", binary_clock_get_version());
+    printf("Press Ctrl+C to exit\n\n");
+    fflush(stdout);
+
+    binary_clock_render_format_t format;
+    if (!get_render_format(config->display_mode, &format)) {
+        // Raw mode has no buffer renderer: dispatch through the display registry
+        traced_display_t traced = {display_fn};
+        int display_id = binary_clock_display_register(traced_display, &traced);
+        if (display_id == -1) {
+            printf("Error: Failed to register display function\n");
+            return 1;
+        }
+        while (1) {
+            clear_console();
+            binary_clock_trace_begin("loop", "tick");
+            binary_clock_trace_begin("loop", "state");
+            binary_clock_state_t state = current_state(config);
+            binary_clock_trace_end("loop", "state");
+            binary_clock_display_update_all_with_state(&state);
+            binary_clock_trace_end("loop", "tick");
+            binary_clock_trace_begin("tick", "wait");
+            SLEEP_FUNC(1);
+            binary_clock_trace_end("tick", "wait");
+        }
+    }
+
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, 1);
+    apply_tuning(&presenter, true);
+    presenter.max_backlog = config->max_backlog;
+    const char* prefix = clears_screen(config) ? clear_sequence() : NULL;
+    int64_t last_second = 0;
+    while (1) {
+        if (loop_tick(&presenter, config, format, prefix, false, &last_second) != 0) {
+            return 1;
+        }
+    }
+}
+
+// Rows the terminal on stdout has, 0 if unknown
+static int terminal_rows(void) {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+        return csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+    }
+#else
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0) {
+        return size.ws_row;
+    }
+#endif
+    return 0;
+}
+
+// Waterfall mode: the history is a scroll region, so each second sends one
+// row and the terminal shifts the older ones, whatever the history length
+static int run_waterfall(const config_t* config) {
+    if (clear_sequence() == NULL) {
+        fprintf(stderr, "Error: The waterfall display needs a terminal with ANSI escape sequences\n");
+        return 1;
+    }
+    // The region must fit on screen, with a row left below it for the cursor
+    uint32_t rows = config->waterfall_rows;
+    int available = terminal_rows() - BINARY_CLOCK_WATERFALL_TOP_ROW;
+    if (available > 0 && rows > (uint32_t)available) {
+        rows = (uint32_t)available;
+    }
+
+    static binary_clock_waterfall_t waterfall;
+    if (binary_clock_waterfall_init(&waterfall, rows, BINARY_CLOCK_RENDER_EMOJI_LINE) != BINARY_CLOCK_SUCCESS) {
+        fprintf(stderr, "Error: The terminal is too small for a waterfall\n");
+        return 1;
+    }
+    char setup[BINARY_CLOCK_WATERFALL_TICK_SIZE];
+    size_t length = binary_clock_waterfall_begin(&waterfall, setup, sizeof(setup));
+    if (length == 0 || write_stdout(setup, length) != 0) {
+        return 1;
+    }
+    active_waterfall = &waterfall;
+    atexit(end_waterfall);
+    signal(SIGINT, waterfall_signal_handler);
+
+    // Each frame is the waterfall's tick: its prefix, then a table-rendered row
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, 1);
+    apply_tuning(&presenter, true);
+    presenter.max_backlog = config->max_backlog;
+    presenter.render = waterfall.render;
+    int64_t last_second = 0;
+    while (1) {
+        if (loop_tick(&presenter, config, waterfall.format, waterfall.prefix, false, &last_second) != 0) {
+            return 1;
+        }
+    }
+}
+
+// Graphics mode: LED images placed by the terminal, so each second sends
+// the time line and the LEDs that changed
+static int run_graphics(const config_t* config) {
+    if (clear_sequence() == NULL) {
+        fprintf(stderr, "Error: The graphics display needs a terminal with ANSI escape sequences\n");
+        return 1;
+    }
+    binary_clock_graphics_protocol_t protocol = config->graphics_protocol;
+    if (config->graphics_detect) {
+        protocol = binary_clock_graphics_detect(getenv("TERM"), getenv("TERM_PROGRAM"), getenv("KITTY_WINDOW_ID"));
+    }
+
+    static binary_clock_graphics_t graphics;
+    static char output[BINARY_CLOCK_GRAPHICS_BEGIN_SIZE];
+    binary_clock_graphics_init(&graphics, protocol);
+    size_t length = binary_clock_graphics_begin(&graphics, output, sizeof(output));
+    if (length == 0 || write_stdout(output, length) != 0) {
+        return 1;
+    }
+    active_graphics = &graphics;
+    atexit(end_graphics);
+    signal(SIGINT, graphics_signal_handler);
+
+    // Encode the tick on the second boundary (it takes well under a
+    // microsecond) and write it. A tick is a diff against what the screen
+    // shows, so a backlogged terminal skips encoding altogether and the
+    // next tick that goes out carries every change since.
+    int64_t last_second = 0;
+    uint64_t skipped = 0;
+    while (1) {
+        int64_t second = binary_clock_present_now_us() / 1000000 + 1;
+        if (second <= last_second) {
+            second = last_second + 1;
+        }
+        last_second = second;
+        binary_clock_trace_begin("tick", "wait");
+        binary_clock_present_wait_until_us(second * 1000000);
+        binary_clock_trace_end("tick", "wait");
+        if (skip_backlogged(config, second, &skipped)) {
+            continue;
+        }
+        binary_clock_trace_begin("loop", "tick");
+        binary_clock_state_t state = state_at(config, second);
+        length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+        binary_clock_trace_end("loop", "tick");
+        if (length == 0 || write_stdout(output, length) != 0) {
+            return 1;
+        }
+    }
+}
+
+// Patch mode: a full JSON document, then each second a merge patch of the
+// digits that changed. Like the status bar it sleeps to each boundary:
+// web clients have no use for microsecond precision. A patch is a diff
+// against the last update written, so while the reader is backlogged the
+// seconds are skipped and the next patch carries every change since.
+static int run_patch(const config_t* config) {
+    binary_clock_patch_t patch;
+    binary_clock_patch_init(&patch, config->patch_framing, config->patch_resync);
+    patch.render = render_frame;
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    uint64_t skipped = 0;
+    while (1) {
+        int64_t second = binary_clock_present_now_us() / 1000000;
+        if (!skip_backlogged(config, second, &skipped)) {
+            binary_clock_trace_begin("loop", "tick");
+            binary_clock_trace_begin("loop", "state");
+            binary_clock_state_t state = state_at(config, second);
+            binary_clock_trace_end("loop", "state");
+            size_t length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+            if (length == (size_t)-1) {
+                binary_clock_trace_end("loop", "tick");
+                fprintf(stderr, "Error: Cannot encode the patch\n");
+                return 1;
+            }
+            if (length > 0) {
+                binary_clock_trace_begin("sink", "write");
+                int result = write_stdout(output, length);
+                binary_clock_trace_end("sink", "write");
+                if (result != 0) {
+                    binary_clock_trace_end("loop", "tick");
+                    return 1;  // The reader went away
+                }
+            }
+            binary_clock_trace_end("loop", "tick");
+        }
+        binary_clock_trace_begin("tick", "wait");
+        binary_clock_present_sleep_until_us((second + 1) * 1000000);
+        binary_clock_trace_end("tick", "wait");
+    }
+}
+
+// UTC offset of the local timezone at an epoch second
+static int32_t local_offset(int64_t epoch) {
+    time_t seconds = (time_t)epoch;
+    struct tm local_tm;
+    struct tm utc_tm;
+    struct tm* local = localtime(&seconds);
+    if (local == NULL) {
+        return 0;
+    }
+    local_tm = *local;
+    struct tm* utc = gmtime(&seconds);
+    if (utc == NULL) {
+        return 0;
+    }
+    utc_tm = *utc;
+
+    int days = local_tm.tm_yday - utc_tm.tm_yday;
+    if (local_tm.tm_year != utc_tm.tm_year) {
+        days = local_tm.tm_year > utc_tm.tm_year ? 1 : -1;
+    }
+    return (int32_t)(days * 86400 + (local_tm.tm_hour - utc_tm.tm_hour) * 3600 +
+                     (local_tm.tm_min - utc_tm.tm_min) * 60 + (local_tm.tm_sec - utc_tm.tm_sec));
+}
+
+// Soak mode: drive the loop pipeline from a virtual clock into a pipe and
+// check every frame that comes out the other end
+static int run_soak(const config_t* config) {
+    binary_clock_render_format_t format;
+    if (!get_render_format(config->display_mode, &format)) {
+        fprintf(stderr, "Error: --soak supports the emoji, binary, json and ndjson displays\n");
+        return 1;
+    }
+    int fds[2];
+    if (PIPE_FUNC(fds) != 0) {
+        fprintf(stderr, "Error: Cannot create the soak output pipe\n");
+        return 1;
+    }
+
+    int64_t start = config->soak_start > 0 ? config->soak_start : binary_clock_present_now_us() / 1000000;
+    binary_clock_virtual_clock_t clock;
+    binary_clock_virtual_clock_init(&clock, start * 1000000, config->soak_speed);
+    binary_clock_present_clock_t source = binary_clock_virtual_clock_source(&clock);
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, fds[1]);
+    binary_clock_presenter_set_clock(&presenter, &source);
+    apply_tuning(&presenter, false);
+    // Fixed prefix: the pipe is not a console, and the checker must see it
+    const char* prefix = clears_screen(config) ? "\033[2J\033[H" : NULL;
+
+    binary_clock_soak_t soak;
+    binary_clock_soak_init(&soak);
+    char frame[BINARY_CLOCK_PRESENT_FRAME_SIZE];
+    // Host jitter at high speeds spans whole virtual seconds: present each
+    // one anyway, so the checker only blames the pipeline
+    int64_t last_second = start;
+    int64_t real_start = binary_clock_present_now_us();
+    int status = 0;
+
+    while (last_second < start + config->soak_seconds) {
+        if (loop_tick(&presenter, config, format, prefix, true, &last_second) != 0) {
+            fprintf(stderr, "Error: Frame for %lld not presented\n", (long long)last_second);
+            status = 1;
+            break;
+        }
+        // Frames are smaller than the pipe buffer, so each one arrives whole
+        binary_clock_trace_begin("soak", "check");
+        long got = (long)READ_FUNC(fds[0], frame, sizeof(frame));
+        int32_t offset = config->fixed_offset ? config->utc_offset : local_offset(last_second);
+        binary_clock_soak_check_frame(&soak, frame, got > 0 ? (size_t)got : 0, last_second, offset);
+        binary_clock_trace_end("soak", "check");
+    }
+    CLOSE_FUNC(fds[0]);
+    CLOSE_FUNC(fds[1]);
+
+    double real_seconds = (double)(binary_clock_present_now_us() - real_start) / 1e6;
+    const binary_clock_soak_stats_t* stats = &soak.stats;
+    printf("Soak: %lld virtual seconds from %lld in %.3f s (%.0fx real time, %.0f frames/s)\n",
+           (long long)(last_second - start), (long long)start, real_seconds,
+           real_seconds > 0 ? (double)(last_second - start) / real_seconds : 0.0,
+           real_seconds > 0 ? (double)stats->frames / real_seconds : 0.0);
+    printf("  frames:         %llu (%llu bytes)\n", (unsigned long long)stats->frames,
+           (unsigned long long)stats->bytes);
+    printf("  malformed:      %llu\n", (unsigned long long)stats->malformed);
+    printf("  mismatched:     %llu\n", (unsigned long long)stats->mismatched);
+    printf("  skipped:        %llu\n", (unsigned long long)stats->skipped);
+    printf("  duplicated:     %llu\n", (unsigned long long)stats->duplicated);
+    printf("  rollovers:      %llu\n", (unsigned long long)stats->rollovers);
+    printf("  offset changes: %llu\n", (unsigned long long)stats->offset_changes);
+    printf("  late commits:   %llu (max error %lld us)\n", (unsigned long long)presenter.stats.late,
+           (long long)presenter.stats.max_error_us);
+    if (tuned) {
+        char summary[512];
+        binary_clock_tune_describe(&tune, summary, sizeof(summary));
+        printf("  autotune:       %s\n", summary);
+    }
+    if (!binary_clock_soak_passed(&soak)) {
+        printf("  first failure:  at %lld: %s\n", (long long)soak.first_failure_epoch, soak.first_failure);
+        status = 1;
+    }
+    printf("%s\n", status == 0 ? "PASS" : "FAIL");
+    return status;
+}
+
 int main(int argc, char* argv[]) {
     // Parse command line arguments
     config_t config = parse_arguments(argc, argv);
     
     // Set up signal handler for graceful exit (Ctrl+C) - only needed for loop mode
-    if (config.operation_mode == MODE_LOOP) {
+    if (config.operation_mode == MODE_LOOP || config.operation_mode == MODE_RECEIVE ||
+        config.operation_mode == MODE_SERVE || config.operation_mode == MODE_QUERY ||
+        config.operation_mode == MODE_H2C) {
         signal(SIGINT, signal_handler);
     }
+    if (config.operation_mode == MODE_STATUSBAR) {
+        signal(SIGINT, statusbar_signal_handler);
+        signal(SIGTERM, statusbar_signal_handler);
+    }
+    
+    bool arrow_output = config.display_mode == DISPLAY_ARROW || config.display_mode == DISPLAY_ARROW_FILE;
+    if (arrow_output && config.operation_mode != MODE_RANGE) {
+        fprintf(stderr, "Error: Arrow display modes require --range\n");
+        return 1;
+    }
+    if (config.display_mode == DISPLAY_WATERFALL && config.operation_mode != MODE_LOOP) {
+        fprintf(stderr, "Error: The waterfall display requires --loop\n");
+        return 1;
+    }
+    if (config.display_mode == DISPLAY_GRAPHICS && config.operation_mode != MODE_LOOP) {
+        fprintf(stderr, "Error: The graphics display requires --loop\n");
+        return 1;
+    }
+    if (config.display_mode == DISPLAY_PATCH && config.operation_mode != MODE_LOOP) {
+        fprintf(stderr, "Error: The patch display requires --loop\n");
+        return 1;
+    }
+    
+    // Caps first, so the trace ring and the autotuned tables are held to them
+    for (int i = 0; i < BINARY_CLOCK_MEM_SUBSYSTEMS; i++) {
+        binary_clock_mem_set_cap((binary_clock_mem_subsystem_t)i, config.mem_caps[i]);
+    }
+    if (config.mem_stats) {
+        atexit(report_memory);
+    }
+    
+    if (config.trace_path != NULL) {
+        binary_clock_error_t error = binary_clock_trace_start(config.trace_events);
+        if (error != BINARY_CLOCK_SUCCESS) {
+            fprintf(stderr, "Error: Cannot start tracing: %s\n", binary_clock_get_error_string(error));
+            return 1;
+        }
+        trace_path = config.trace_path;
+        atexit(save_trace);
+    }
+    
+    if (config.autotune) {
+        autotune(&config);
+    }
     
     // Get the appropriate display function
     binary_clock_display_fn_t display_fn = get_display_function(config.display_mode);
     
-    if (config.operation_mode == MODE_SINGLE) {
-        // Single output mode: get current state and display once
-        binary_clock_state_t state = binary_clock_get_current_state();
-        if (state.timestamp == 0) {
-            fprintf(stderr, "Error: Failed to get current time\n");
+    if (config.operation_mode == MODE_BROADCAST) {
+        return run_broadcaster(&config);
+    }
+    else if (config.operation_mode == MODE_RECEIVE) {
+        return run_receiver(&config, display_fn);
+    }
+    else if (config.operation_mode == MODE_SOAK) {
+        return run_soak(&config);
+    }
+    else if (config.operation_mode == MODE_SERVE) {
+        return run_server(&config);
+    }
+    else if (config.operation_mode == MODE_QUERY) {
+        return run_query(&config);
+    }
+    else if (config.operation_mode == MODE_H2C) {
+        return run_h2c(&config);
+    }
+    else if (config.operation_mode == MODE_STATUSBAR) {
+        return run_statusbar(&config);
+    }
+    else if (config.operation_mode == MODE_RANGE && arrow_output) {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        binary_clock_error_t error = binary_clock_arrow_write_range(
+            stdout, config.range_start, config.range_end, config.utc_offset,
+            config.display_mode == DISPLAY_ARROW_FILE ? BINARY_CLOCK_ARROW_FILE : BINARY_CLOCK_ARROW_STREAM,
+            0);
+        if (error != BINARY_CLOCK_SUCCESS) {
+            fprintf(stderr, "Error: %s\n", binary_clock_get_error_string(error));
             return 1;
         }
-        display_fn(&state, NULL);
     }
-    else {
-        // Loop mode: continuous display
-        printf("🌚🌝 Binary Clock v%s 🌝🌚\n", binary_clock_get_version());
-        printf("Press Ctrl+C to exit\n\n");
-        
-        // Register the selected display function
-        int display_id = binary_clock_display_register(display_fn, NULL);
-        if (display_id == -1) {
-            printf("Error: Failed to register display function\n");
+    else if (config.operation_mode == MODE_RANGE) {
+        return run_range(&config, display_fn);
+    }
+    else if (config.operation_mode == MODE_SINGLE) {
+        // Single output mode: get current state and display once
+        binary_clock_state_t state = current_state(&config);
+        if (state.timestamp == 0) {
+            fprintf(stderr, "Error: Failed to get current time\n");
             return 1;
         }
         
-        while (1) { // Infinite loop to keep clock running
-            // Clear screen (cross-platform) - only for non-JSON mode to avoid cluttering
-            if (config.display_mode != DISPLAY_JSON) {
-                clear_console();
+        // Cold-start path: render into one buffer and emit it with a single
+        // write, keeping stdio off the path entirely
+        binary_clock_render_format_t format;
+        if (get_render_format(config.display_mode, &format)) {
+            char buffer[BINARY_CLOCK_RENDER_MAX_SIZE];
+            size_t length = render_frame(&state, format, buffer, sizeof(buffer));
+            if (length == 0 || write_stdout(buffer, length) != 0) {
+                return 1;
             }
-            
-            // Update all registered displays with current time
-            binary_clock_display_update_all();
-            
-            SLEEP_FUNC(1); // Wait 1 second (cross-platform)
+        } else {
+            display_fn(&state, NULL);
         }
     }
+    else if (config.display_mode == DISPLAY_WATERFALL) {
+        return run_waterfall(&config);
+    }
+    else if (config.display_mode == DISPLAY_GRAPHICS) {
+        return run_graphics(&config);
+    }
+    else if (config.display_mode == DISPLAY_PATCH) {
+        return run_patch(&config);
+    }
+    else {
+        return run_loop(&config, display_fn);
+    }
     
     return 0;
 }
@@ -0,0 +1,197 @@
+/**
+ * @file binary_clock_admit.c
+ * @brief Binary Clock Admission Control Implementation
+ *
+ * Per-address counts live in a linear-probing table keyed by the IPv4
+ * address, grown at half load; a removal shifts the following entries
+ * back, so lookups never walk over tombstones. The table is only kept
+ * while a per-address cap is set. It is charged to
+ * BINARY_CLOCK_MEM_REGISTRY; when a doubled table would exceed that cap,
+ * it fills to three quarters before growing.
+ */
+
+#include <binary_clock_admit.h>
+#include <binary_clock_mem.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TOKEN_SCALE 1000000LL
+#define ADDRESS_INITIAL_CAPACITY 64
+
+static int64_t bucket_size(const binary_clock_admit_limits_t* limits) {
+    return (int64_t)(limits->burst > 0 ? limits->burst : limits->rate) * TOKEN_SCALE;
+}
+
+binary_clock_error_t binary_clock_admit_init(binary_clock_admit_t* admit, const binary_clock_admit_limits_t* limits) {
+    if (admit == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(admit, 0, sizeof(*admit));
+    if (limits != NULL) {
+        admit->limits = *limits;
+    }
+    admit->tokens = bucket_size(&admit->limits);
+    admit->refilled_us = INT64_MIN;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+static size_t address_home(const binary_clock_admit_t* admit, uint32_t address) {
+    return (size_t)((address * 2654435761u) & (admit->address_capacity - 1));
+}
+
+// Slot holding the address, or the empty slot where it belongs
+static size_t address_slot(const binary_clock_admit_t* admit, uint32_t address) {
+    size_t mask = admit->address_capacity - 1;
+    size_t slot = address_home(admit, address);
+    while (admit->addresses[slot].count != 0 && admit->addresses[slot].address != address) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Grow at half load, or at three quarters while the registry is over its cap
+static int grow_addresses(binary_clock_admit_t* admit) {
+    size_t needed = admit->address_count + 1;
+    if (needed * 2 <= admit->address_capacity) {
+        return 0;
+    }
+    size_t capacity = admit->address_capacity > 0 ? admit->address_capacity * 2 : ADDRESS_INITIAL_CAPACITY;
+    size_t bytes = capacity * sizeof(binary_clock_admit_entry_t);
+    if (!binary_clock_mem_reserve(BINARY_CLOCK_MEM_REGISTRY, bytes)) {
+        if (needed * 4 <= admit->address_capacity * 3) {
+            return 0;
+        }
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_REGISTRY, bytes);
+    }
+    binary_clock_admit_entry_t* old = admit->addresses;
+    size_t old_capacity = admit->address_capacity;
+    admit->addresses = calloc(capacity, sizeof(*admit->addresses));
+    if (admit->addresses == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_REGISTRY, bytes);
+        admit->addresses = old;
+        return -1;
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_REGISTRY, old_capacity * sizeof(*old));
+    admit->address_capacity = capacity;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i].count != 0) {
+            admit->addresses[address_slot(admit, old[i].address)] = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+static uint32_t address_count(const binary_clock_admit_t* admit, uint32_t address) {
+    if (admit->address_capacity == 0) {
+        return 0;
+    }
+    return admit->addresses[address_slot(admit, address)].count;
+}
+
+binary_clock_error_t binary_clock_admit_add(binary_clock_admit_t* admit, uint32_t address) {
+    if (admit == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (admit->limits.max_per_address > 0) {
+        if (grow_addresses(admit) != 0) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        binary_clock_admit_entry_t* entry = &admit->addresses[address_slot(admit, address)];
+        if (entry->count == 0) {
+            entry->address = address;
+            admit->address_count++;
+        }
+        entry->count++;
+    }
+    admit->active++;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+// Top the bucket up for the time since the last refill
+static void refill(binary_clock_admit_t* admit, int64_t now_us) {
+    int64_t size = bucket_size(&admit->limits);
+    int64_t elapsed = admit->refilled_us == INT64_MIN ? 0 : now_us - admit->refilled_us;
+    admit->refilled_us = now_us;
+    if (elapsed <= 0) {
+        return;
+    }
+    if (elapsed >= size / admit->limits.rate) {
+        admit->tokens = size;
+    } else {
+        admit->tokens += elapsed * admit->limits.rate;
+        if (admit->tokens > size) {
+            admit->tokens = size;
+        }
+    }
+}
+
+binary_clock_admit_verdict_t binary_clock_admit_check(binary_clock_admit_t* admit, uint32_t address, int64_t now_us) {
+    const binary_clock_admit_limits_t* limits = &admit->limits;
+    if (limits->max_clients > 0 && admit->active >= limits->max_clients) {
+        admit->stats.rejected_full++;
+        return BINARY_CLOCK_ADMIT_FULL;
+    }
+    if (limits->max_per_address > 0 && address_count(admit, address) >= limits->max_per_address) {
+        admit->stats.rejected_address++;
+        return BINARY_CLOCK_ADMIT_ADDRESS;
+    }
+    if (limits->rate > 0) {
+        refill(admit, now_us);
+        if (admit->tokens < TOKEN_SCALE) {
+            admit->stats.rejected_rate++;
+            return BINARY_CLOCK_ADMIT_RATE;
+        }
+    }
+    if (binary_clock_admit_add(admit, address) != BINARY_CLOCK_SUCCESS) {
+        admit->stats.rejected_full++;
+        return BINARY_CLOCK_ADMIT_FULL;
+    }
+    if (limits->rate > 0) {
+        admit->tokens -= TOKEN_SCALE;
+    }
+    admit->stats.admitted++;
+    return BINARY_CLOCK_ADMIT_OK;
+}
+
+void binary_clock_admit_release(binary_clock_admit_t* admit, uint32_t address) {
+    if (admit == NULL || admit->active == 0) {
+        return;
+    }
+    admit->active--;
+    if (admit->address_capacity == 0) {
+        return;
+    }
+    size_t mask = admit->address_capacity - 1;
+    size_t hole = address_slot(admit, address);
+    if (admit->addresses[hole].count == 0 || --admit->addresses[hole].count > 0) {
+        return;
+    }
+
+    // Shift back every following entry that may sit in the hole
+    admit->address_count--;
+    for (size_t next = (hole + 1) & mask; admit->addresses[next].count != 0; next = (next + 1) & mask) {
+        size_t home = address_home(admit, admit->addresses[next].address);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            admit->addresses[hole] = admit->addresses[next];
+            hole = next;
+        }
+    }
+    admit->addresses[hole].count = 0;
+}
+
+size_t binary_clock_admit_memory(const binary_clock_admit_t* admit) {
+    return admit == NULL ? 0 : admit->address_capacity * sizeof(binary_clock_admit_entry_t);
+}
+
+void binary_clock_admit_free(binary_clock_admit_t* admit) {
+    if (admit == NULL) {
+        return;
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_REGISTRY, binary_clock_admit_memory(admit));
+    free(admit->addresses);
+    admit->addresses = NULL;
+    admit->address_capacity = 0;
+    admit->address_count = 0;
+    admit->active = 0;
+}
@@ -5,13 +5,16 @@
  * Cross-platform implementation of the binary clock API with separated
  * visualization layer. Provides thread-safe, high-performance functions
  * for binary time representation and display management.
+ *
+ * Builds without libc when BINARY_CLOCK_FREESTANDING is defined; only the
+ * system clock functions depend on <time.h>.
  */
 
 #include <binary_clock_api.h>
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
+
+#ifndef BINARY_CLOCK_FREESTANDING
 #include <time.h>
+#endif
 
 /* ========================================================================== */
 /* CONSTANTS                                                                  */
@@ -72,6 +75,26 @@ uint8_t binary_clock_to_decimal(const binary_value_t* binary) {
 /* TIME MANAGEMENT                                                            */
 /* ========================================================================== */
 
+/**
+ * @brief Build a state from validated time components
+ */
+static binary_clock_state_t build_state(const time_components_t* time_comp, binary_clock_time_t timestamp) {
+    binary_clock_state_t result;
+    
+    // Split each component into tens and units and convert to binary
+    result.hours_tens = binary_clock_to_binary(time_comp->hours / 10, 3);       // 0-2 needs 3 bits
+    result.hours_units = binary_clock_to_binary(time_comp->hours % 10, 4);      // 0-9 needs 4 bits
+    result.minutes_tens = binary_clock_to_binary(time_comp->minutes / 10, 3);   // 0-5 needs 3 bits
+    result.minutes_units = binary_clock_to_binary(time_comp->minutes % 10, 4);  // 0-9 needs 4 bits
+    result.seconds_tens = binary_clock_to_binary(time_comp->seconds / 10, 3);   // 0-5 needs 3 bits
+    result.seconds_units = binary_clock_to_binary(time_comp->seconds % 10, 4);  // 0-9 needs 4 bits
+    result.timestamp = timestamp;
+    
+    return result;
+}
+
+#ifndef BINARY_CLOCK_FREESTANDING
+
 time_components_t binary_clock_get_current_time(void) {
     time_components_t result = {0};
     
@@ -104,30 +127,7 @@ binary_clock_state_t binary_clock_state_from_time(const time_components_t* time_
         return result; // Return with timestamp=0 on failure
     }
     
-    // Split hours into tens and units
-    uint8_t hours_tens = time_comp->hours / 10;
-    uint8_t hours_units = time_comp->hours % 10;
-    
-    // Split minutes into tens and units
-    uint8_t minutes_tens = time_comp->minutes / 10;
-    uint8_t minutes_units = time_comp->minutes % 10;
-    
-    // Split seconds into tens and units
-    uint8_t seconds_tens = time_comp->seconds / 10;
-    uint8_t seconds_units = time_comp->seconds % 10;
-    
-    // Convert to binary representations
-    result.hours_tens = binary_clock_to_binary(hours_tens, 3);     // 0-2 needs 3 bits
-    result.hours_units = binary_clock_to_binary(hours_units, 4);   // 0-9 needs 4 bits
-    result.minutes_tens = binary_clock_to_binary(minutes_tens, 3); // 0-5 needs 3 bits
-    result.minutes_units = binary_clock_to_binary(minutes_units, 4); // 0-9 needs 4 bits
-    result.seconds_tens = binary_clock_to_binary(seconds_tens, 3); // 0-5 needs 3 bits
-    result.seconds_units = binary_clock_to_binary(seconds_units, 4); // 0-9 needs 4 bits
-    
-    // Set timestamp
-    result.timestamp = time(NULL);
-    
-    return result;
+    return build_state(time_comp, time(NULL));
 }
 
 binary_clock_state_t binary_clock_get_current_state(void) {
@@ -146,6 +146,90 @@ binary_clock_state_t binary_clock_get_current_state(void) {
     return binary_clock_state_from_time(&current_time);
 }
 
+#endif /* BINARY_CLOCK_FREESTANDING */
+
+/* ========================================================================== */
+/* EPOCH AND PACKED REPRESENTATIONS                                           */
+/* ========================================================================== */
+
+#define SECONDS_PER_DAY 86400
+
+time_components_t binary_clock_time_from_epoch(int64_t epoch_seconds, int32_t utc_offset_seconds) {
+    time_components_t result;
+
+    // Floor modulo so that times before 1970 still map into 0..86399.
+    // Each operand is reduced first: the sum could overflow near INT64_MAX.
+    int64_t second_of_day = (epoch_seconds % SECONDS_PER_DAY + utc_offset_seconds % SECONDS_PER_DAY) % SECONDS_PER_DAY;
+    if (second_of_day < 0) {
+        second_of_day += SECONDS_PER_DAY;
+    }
+
+    result.hours = (uint8_t)(second_of_day / 3600);
+    result.minutes = (uint8_t)((second_of_day / 60) % 60);
+    result.seconds = (uint8_t)(second_of_day % 60);
+
+    return result;
+}
+
+binary_clock_state_t binary_clock_state_from_epoch(int64_t epoch_seconds, int32_t utc_offset_seconds) {
+    time_components_t time_comp = binary_clock_time_from_epoch(epoch_seconds, utc_offset_seconds);
+
+    return build_state(&time_comp, (binary_clock_time_t)epoch_seconds);
+}
+
+uint32_t binary_clock_pack_state(const binary_clock_state_t* state) {
+    if (state == NULL) {
+        return 0;
+    }
+
+    return ((uint32_t)state->hours_tens.decimal_value << BINARY_CLOCK_PACKED_HOURS_TENS_SHIFT) |
+           ((uint32_t)state->hours_units.decimal_value << BINARY_CLOCK_PACKED_HOURS_UNITS_SHIFT) |
+           ((uint32_t)state->minutes_tens.decimal_value << BINARY_CLOCK_PACKED_MINUTES_TENS_SHIFT) |
+           ((uint32_t)state->minutes_units.decimal_value << BINARY_CLOCK_PACKED_MINUTES_UNITS_SHIFT) |
+           ((uint32_t)state->seconds_tens.decimal_value << BINARY_CLOCK_PACKED_SECONDS_TENS_SHIFT) |
+           ((uint32_t)state->seconds_units.decimal_value << BINARY_CLOCK_PACKED_SECONDS_UNITS_SHIFT);
+}
+
+binary_clock_state_t binary_clock_state_from_packed(uint32_t packed, binary_clock_time_t timestamp) {
+    binary_clock_state_t result = {0};
+    time_components_t time_comp;
+    uint8_t minutes_units = (packed >> BINARY_CLOCK_PACKED_MINUTES_UNITS_SHIFT) & 0xF;
+    uint8_t seconds_units = (packed >> BINARY_CLOCK_PACKED_SECONDS_UNITS_SHIFT) & 0xF;
+    uint8_t hours_units = (packed >> BINARY_CLOCK_PACKED_HOURS_UNITS_SHIFT) & 0xF;
+    
+    // Reject non-BCD digits; tens digits are range-checked below
+    if (packed > 0xFFFFFF || hours_units > 9 || minutes_units > 9 || seconds_units > 9) {
+        return result; // Return with timestamp=0 on failure
+    }
+    
+    time_comp.hours = (uint8_t)(((packed >> BINARY_CLOCK_PACKED_HOURS_TENS_SHIFT) & 0xF) * 10 + hours_units);
+    time_comp.minutes = (uint8_t)(((packed >> BINARY_CLOCK_PACKED_MINUTES_TENS_SHIFT) & 0xF) * 10 + minutes_units);
+    time_comp.seconds = (uint8_t)(((packed >> BINARY_CLOCK_PACKED_SECONDS_TENS_SHIFT) & 0xF) * 10 + seconds_units);
+    
+    if (time_comp.hours > 23 || time_comp.minutes > 59 || time_comp.seconds > 59) {
+        return result; // Return with timestamp=0 on failure
+    }
+    
+    return build_state(&time_comp, timestamp);
+}
+
+uint32_t binary_clock_packed_next_second(uint32_t packed) {
+    // Propagate the carry digit by digit: units roll over at 9, tens at 5
+    if ((packed & 0x00000F) < 0x000009) return packed + 0x000001;
+    packed &= ~0x00000Fu;
+    if ((packed & 0x0000F0) < 0x000050) return packed + 0x000010;
+    packed &= ~0x0000F0u;
+    if ((packed & 0x000F00) < 0x000900) return packed + 0x000100;
+    packed &= ~0x000F00u;
+    if ((packed & 0x00F000) < 0x005000) return packed + 0x001000;
+    packed &= ~0x00F000u;
+    
+    // Hours run 00-23, so they wrap at 23 rather than 59
+    if (packed == 0x230000) return 0;
+    if ((packed & 0x0F0000) < 0x090000) return packed + 0x010000;
+    return (packed & ~0x0F0000u) + 0x100000;
+}
+
 
 /* ========================================================================== */
 /* UTILITY FUNCTIONS                                                          */
@@ -163,6 +247,12 @@ const char* binary_clock_get_error_string(binary_clock_error_t error) {
             return "Null pointer passed to function requiring valid pointer";
         case BINARY_CLOCK_ERROR_SYSTEM_TIME:
             return "System time retrieval failed";
+        case BINARY_CLOCK_ERROR_OUTPUT:
+            return "Writing output or allocating an output buffer failed";
+        case BINARY_CLOCK_ERROR_NETWORK:
+            return "Socket operation failed or is unsupported on this platform";
+        case BINARY_CLOCK_ERROR_TIMEOUT:
+            return "Nothing arrived before the timeout expired";
         default:
             return "Unknown error";
     }
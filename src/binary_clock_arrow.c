@@ -0,0 +1,547 @@
+/**
+ * @file binary_clock_arrow.c
+ * @brief Binary Clock Arrow Export Implementation
+ *
+ * Dependency-free Arrow IPC writer. Arrow metadata is encoded as
+ * FlatBuffers; this file contains just enough of a FlatBuffers builder to
+ * emit the Schema, RecordBatch and Footer tables used by the exporter.
+ *
+ * The builder lays buffers out front to back: every table is preceded by
+ * its vtable and followed by the objects it references, whose uoffsets are
+ * patched in once their position is known.
+ */
+
+#include <binary_clock_arrow.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* ARROW FORMAT CONSTANTS                                                     */
+/* ========================================================================== */
+
+#define ARROW_MAGIC "ARROW1"
+#define ARROW_CONTINUATION 0xFFFFFFFFu
+#define ARROW_METADATA_V5 4
+#define ARROW_HEADER_SCHEMA 1
+#define ARROW_HEADER_RECORD_BATCH 3
+#define ARROW_TYPE_INT 2
+#define ARROW_ENDIAN_LITTLE 0
+#define ARROW_ENDIAN_BIG 1
+
+#define ARROW_COLUMN_COUNT 8
+
+/**
+ * @brief Exported column description
+ */
+typedef struct {
+    const char* name;
+    uint8_t bit_width;
+    bool is_signed;
+} arrow_column_t;
+
+static const arrow_column_t arrow_columns[ARROW_COLUMN_COUNT] = {
+    {"epoch", 64, true},
+    {"leds", 32, false},
+    {"hours_tens", 8, false},
+    {"hours_units", 8, false},
+    {"minutes_tens", 8, false},
+    {"minutes_units", 8, false},
+    {"seconds_tens", 8, false},
+    {"seconds_units", 8, false}
+};
+
+/* ========================================================================== */
+/* MINIMAL FLATBUFFERS BUILDER                                                */
+/* ========================================================================== */
+
+typedef struct {
+    uint8_t* data;
+    size_t len;
+    size_t cap;
+    bool failed;
+} fb_builder_t;
+
+/**
+ * @brief Scalar or offset field of a table being written
+ *
+ * size is 0 for absent fields. For offset fields (size 4, is_offset set)
+ * the value is ignored and pos receives the slot to patch later.
+ */
+typedef struct {
+    uint8_t size;
+    bool is_offset;
+    uint64_t value;
+    size_t pos;
+} fb_field_t;
+
+static void fb_reserve(fb_builder_t* fb, size_t extra) {
+    if (fb->failed || fb->len + extra <= fb->cap) {
+        return;
+    }
+
+    size_t new_cap = fb->cap ? fb->cap : 512;
+    while (new_cap < fb->len + extra) {
+        new_cap *= 2;
+    }
+
+    uint8_t* data = realloc(fb->data, new_cap);
+    if (data == NULL) {
+        fb->failed = true;
+        return;
+    }
+    fb->data = data;
+    fb->cap = new_cap;
+}
+
+static void fb_put_le(fb_builder_t* fb, uint64_t value, size_t size) {
+    fb_reserve(fb, size);
+    if (fb->failed) {
+        return;
+    }
+    for (size_t i = 0; i < size; i++) {
+        fb->data[fb->len++] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void fb_set_le(fb_builder_t* fb, size_t pos, uint64_t value, size_t size) {
+    if (fb->failed) {
+        return;
+    }
+    for (size_t i = 0; i < size; i++) {
+        fb->data[pos + i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static size_t fb_align(fb_builder_t* fb, size_t alignment) {
+    while (fb->len % alignment != 0) {
+        fb_put_le(fb, 0, 1);
+    }
+    return fb->len;
+}
+
+static void fb_patch_offset(fb_builder_t* fb, size_t slot, size_t target) {
+    fb_set_le(fb, slot, (uint64_t)(target - slot), 4);
+}
+
+static size_t fb_table(fb_builder_t* fb, fb_field_t* fields, int count) {
+    uint16_t offsets[8] = {0};
+    size_t table_size = 4; // soffset to vtable
+
+    // Lay out fields largest first so every scalar is naturally aligned
+    for (uint8_t size = 8; size >= 1; size /= 2) {
+        for (int i = 0; i < count; i++) {
+            if (fields[i].size == size) {
+                table_size = (table_size + size - 1) / size * size;
+                offsets[i] = (uint16_t)table_size;
+                table_size += size;
+            }
+        }
+    }
+
+    size_t vtable_pos = fb_align(fb, 2);
+    fb_put_le(fb, 4 + 2 * (uint64_t)count, 2);
+    fb_put_le(fb, table_size, 2);
+    for (int i = 0; i < count; i++) {
+        fb_put_le(fb, offsets[i], 2);
+    }
+
+    size_t table_pos = fb_align(fb, 8);
+    fb_put_le(fb, (uint64_t)(table_pos - vtable_pos), 4);
+    for (size_t i = 4; i < table_size; i++) {
+        fb_put_le(fb, 0, 1);
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (fields[i].size == 0) {
+            continue;
+        }
+        fields[i].pos = table_pos + offsets[i];
+        if (!fields[i].is_offset) {
+            fb_set_le(fb, fields[i].pos, fields[i].value, fields[i].size);
+        }
+    }
+
+    return table_pos;
+}
+
+static size_t fb_string(fb_builder_t* fb, const char* str) {
+    size_t length = strlen(str);
+    size_t pos = fb_align(fb, 4);
+
+    fb_put_le(fb, length, 4);
+    for (size_t i = 0; i <= length; i++) {
+        fb_put_le(fb, (uint8_t)str[i], 1);
+    }
+    return pos;
+}
+
+/**
+ * @brief Start a vector whose elements need 8-byte alignment
+ *
+ * @return Position of the length prefix (target of the uoffset)
+ */
+static size_t fb_vector8(fb_builder_t* fb, size_t count) {
+    while (fb->len % 8 != 4) {
+        fb_put_le(fb, 0, 1);
+    }
+    size_t pos = fb->len;
+    fb_put_le(fb, count, 4);
+    return pos;
+}
+
+/* ========================================================================== */
+/* ARROW METADATA                                                             */
+/* ========================================================================== */
+
+static bool host_is_little_endian(void) {
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 1;
+}
+
+/**
+ * @brief Write a Schema table (used by schema messages and the file footer)
+ */
+static size_t arrow_write_schema(fb_builder_t* fb) {
+    fb_field_t schema[2] = {
+        {2, false, host_is_little_endian() ? ARROW_ENDIAN_LITTLE : ARROW_ENDIAN_BIG, 0},
+        {4, true, 0, 0}
+    };
+    size_t schema_pos = fb_table(fb, schema, 2);
+
+    size_t fields_pos = fb_align(fb, 4);
+    fb_put_le(fb, ARROW_COLUMN_COUNT, 4);
+    size_t slots_pos = fb->len;
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        fb_put_le(fb, 0, 4);
+    }
+    fb_patch_offset(fb, schema[1].pos, fields_pos);
+
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        // Field: name, nullable, type_type, type, dictionary, children
+        fb_field_t field[6] = {
+            {4, true, 0, 0},
+            {1, false, 0, 0},
+            {1, false, ARROW_TYPE_INT, 0},
+            {4, true, 0, 0},
+            {0, false, 0, 0},
+            {4, true, 0, 0}
+        };
+        size_t field_pos = fb_table(fb, field, 6);
+        fb_patch_offset(fb, slots_pos + 4 * (size_t)i, field_pos);
+
+        fb_patch_offset(fb, field[0].pos, fb_string(fb, arrow_columns[i].name));
+
+        fb_field_t int_type[2] = {
+            {4, false, arrow_columns[i].bit_width, 0},
+            {1, false, arrow_columns[i].is_signed ? 1 : 0, 0}
+        };
+        fb_patch_offset(fb, field[3].pos, fb_table(fb, int_type, 2));
+
+        // Readers require a children vector even for primitive types
+        size_t children_pos = fb_align(fb, 4);
+        fb_put_le(fb, 0, 4);
+        fb_patch_offset(fb, field[5].pos, children_pos);
+    }
+
+    return schema_pos;
+}
+
+/**
+ * @brief Start a Message table and return the slot for its header offset
+ */
+static size_t arrow_write_message(fb_builder_t* fb, uint8_t header_type, int64_t body_length) {
+    fb_put_le(fb, 0, 4); // Root table offset
+
+    fb_field_t message[4] = {
+        {2, false, ARROW_METADATA_V5, 0},
+        {1, false, header_type, 0},
+        {4, true, 0, 0},
+        {8, false, (uint64_t)body_length, 0}
+    };
+    fb_patch_offset(fb, 0, fb_table(fb, message, 4));
+
+    return message[2].pos;
+}
+
+/* ========================================================================== */
+/* IPC STREAM OUTPUT                                                          */
+/* ========================================================================== */
+
+/**
+ * @brief Location of a record batch in the output (footer Block struct)
+ */
+typedef struct {
+    int64_t offset;
+    int32_t metadata_length;
+    int64_t body_length;
+} arrow_block_t;
+
+typedef struct {
+    FILE* output;
+    int64_t offset;
+    bool failed;
+} arrow_sink_t;
+
+static void sink_write(arrow_sink_t* sink, const void* data, size_t size) {
+    if (sink->failed || size == 0) {
+        return;
+    }
+    if (fwrite(data, 1, size, sink->output) != size) {
+        sink->failed = true;
+        return;
+    }
+    sink->offset += (int64_t)size;
+}
+
+static void sink_pad(arrow_sink_t* sink, size_t alignment) {
+    static const uint8_t zeros[8] = {0};
+    size_t padding = (alignment - (size_t)(sink->offset % (int64_t)alignment)) % alignment;
+    sink_write(sink, zeros, padding);
+}
+
+/**
+ * @brief Write an encapsulated message prefix and metadata
+ *
+ * @return Metadata length including prefix and padding (for footer blocks)
+ */
+static int32_t sink_write_metadata(arrow_sink_t* sink, fb_builder_t* fb) {
+    uint32_t padded = (uint32_t)((fb->len + 7) / 8 * 8);
+    uint8_t prefix[8];
+
+    for (int i = 0; i < 4; i++) {
+        prefix[i] = (uint8_t)(ARROW_CONTINUATION >> (8 * i));
+        prefix[4 + i] = (uint8_t)(padded >> (8 * i));
+    }
+
+    sink_write(sink, prefix, sizeof(prefix));
+    sink_write(sink, fb->data, fb->len);
+    sink_pad(sink, 8);
+
+    return (int32_t)(padded + sizeof(prefix));
+}
+
+static size_t padded_size(size_t size) {
+    return (size + 7) / 8 * 8;
+}
+
+/**
+ * @brief Column storage for one record batch
+ */
+typedef struct {
+    int64_t* epoch;
+    uint32_t* leds;
+    uint8_t* digits[6];
+} arrow_batch_t;
+
+static void arrow_fill_batch(arrow_batch_t* batch, int64_t start_epoch, uint32_t rows, int32_t utc_offset_seconds) {
+    for (uint32_t row = 0; row < rows; row++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(start_epoch + row, utc_offset_seconds);
+        uint32_t packed = binary_clock_pack_state(&state);
+
+        batch->epoch[row] = start_epoch + row;
+        batch->leds[row] = packed;
+        for (int digit = 0; digit < 6; digit++) {
+            batch->digits[digit][row] = (uint8_t)((packed >> (20 - 4 * digit)) & 0xF);
+        }
+    }
+}
+
+static arrow_block_t arrow_write_batch(arrow_sink_t* sink, fb_builder_t* fb, const arrow_batch_t* batch, uint32_t rows) {
+    arrow_block_t block = {0, 0, 0};
+    const void* data[ARROW_COLUMN_COUNT];
+    size_t sizes[ARROW_COLUMN_COUNT];
+    int64_t body_length = 0;
+
+    data[0] = batch->epoch;
+    data[1] = batch->leds;
+    for (int i = 0; i < 6; i++) {
+        data[2 + i] = batch->digits[i];
+    }
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        sizes[i] = (size_t)rows * (arrow_columns[i].bit_width / 8);
+        body_length += (int64_t)padded_size(sizes[i]);
+    }
+
+    fb->len = 0;
+    size_t header_slot = arrow_write_message(fb, ARROW_HEADER_RECORD_BATCH, body_length);
+
+    // RecordBatch: length, nodes, buffers
+    fb_field_t record_batch[3] = {
+        {8, false, rows, 0},
+        {4, true, 0, 0},
+        {4, true, 0, 0}
+    };
+    fb_patch_offset(fb, header_slot, fb_table(fb, record_batch, 3));
+
+    fb_patch_offset(fb, record_batch[1].pos, fb_vector8(fb, ARROW_COLUMN_COUNT));
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        fb_put_le(fb, rows, 8);  // FieldNode.length
+        fb_put_le(fb, 0, 8);     // FieldNode.null_count
+    }
+
+    fb_patch_offset(fb, record_batch[2].pos, fb_vector8(fb, 2 * ARROW_COLUMN_COUNT));
+    uint64_t body_offset = 0;
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        fb_put_le(fb, body_offset, 8);  // Validity bitmap (omitted, no nulls)
+        fb_put_le(fb, 0, 8);
+        fb_put_le(fb, body_offset, 8);  // Values
+        fb_put_le(fb, sizes[i], 8);
+        body_offset += padded_size(sizes[i]);
+    }
+
+    if (fb->failed) {
+        sink->failed = true;
+        return block;
+    }
+
+    block.offset = sink->offset;
+    block.metadata_length = sink_write_metadata(sink, fb);
+    block.body_length = body_length;
+
+    for (int i = 0; i < ARROW_COLUMN_COUNT; i++) {
+        sink_write(sink, data[i], sizes[i]);
+        sink_pad(sink, 8);
+    }
+
+    return block;
+}
+
+static void arrow_write_footer(arrow_sink_t* sink, fb_builder_t* fb, const arrow_block_t* blocks, size_t block_count) {
+    fb->len = 0;
+    fb_put_le(fb, 0, 4); // Root table offset
+
+    // Footer: version, schema, dictionaries, recordBatches
+    fb_field_t footer[4] = {
+        {2, false, ARROW_METADATA_V5, 0},
+        {4, true, 0, 0},
+        {4, true, 0, 0},
+        {4, true, 0, 0}
+    };
+    fb_patch_offset(fb, 0, fb_table(fb, footer, 4));
+    fb_patch_offset(fb, footer[1].pos, arrow_write_schema(fb));
+
+    fb_patch_offset(fb, footer[2].pos, fb_vector8(fb, 0));
+
+    fb_patch_offset(fb, footer[3].pos, fb_vector8(fb, block_count));
+    for (size_t i = 0; i < block_count; i++) {
+        fb_put_le(fb, (uint64_t)blocks[i].offset, 8);
+        fb_put_le(fb, (uint32_t)blocks[i].metadata_length, 4);
+        fb_put_le(fb, 0, 4);
+        fb_put_le(fb, (uint64_t)blocks[i].body_length, 8);
+    }
+
+    if (fb->failed) {
+        sink->failed = true;
+        return;
+    }
+
+    uint8_t length[4];
+    for (int i = 0; i < 4; i++) {
+        length[i] = (uint8_t)(fb->len >> (8 * i));
+    }
+    sink_write(sink, fb->data, fb->len);
+    sink_write(sink, length, sizeof(length));
+    sink_write(sink, ARROW_MAGIC, 6);
+}
+
+/* ========================================================================== */
+/* PUBLIC API                                                                 */
+/* ========================================================================== */
+
+binary_clock_error_t binary_clock_arrow_write_range(FILE* output,
+                                                    int64_t start_epoch,
+                                                    int64_t end_epoch,
+                                                    int32_t utc_offset_seconds,
+                                                    binary_clock_arrow_format_t format,
+                                                    uint32_t batch_rows) {
+    if (output == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (end_epoch < start_epoch) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+    if (batch_rows == 0) {
+        batch_rows = BINARY_CLOCK_ARROW_DEFAULT_BATCH_ROWS;
+    }
+
+    // Unsigned: the span of a wide range does not fit in int64_t
+    uint64_t total_rows = (uint64_t)end_epoch - (uint64_t)start_epoch;
+    uint64_t batches = total_rows / batch_rows + (total_rows % batch_rows != 0 ? 1 : 0);
+    // The footer's block vector has a 32-bit length
+    if (format == BINARY_CLOCK_ARROW_FILE &&
+        (batches > UINT32_MAX || batches > SIZE_MAX / sizeof(arrow_block_t))) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    size_t block_capacity = (size_t)batches;
+
+    arrow_sink_t sink = {output, 0, false};
+    fb_builder_t fb = {NULL, 0, 0, false};
+    arrow_batch_t batch;
+    uint8_t* column_memory = malloc((size_t)batch_rows * 18);
+    arrow_block_t* blocks = NULL;
+
+    if (format == BINARY_CLOCK_ARROW_FILE && block_capacity > 0) {
+        blocks = malloc(block_capacity * sizeof(arrow_block_t));
+    }
+    if (column_memory == NULL || (format == BINARY_CLOCK_ARROW_FILE && block_capacity > 0 && blocks == NULL)) {
+        free(column_memory);
+        free(blocks);
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    // Widest columns first keeps every column naturally aligned
+    batch.epoch = (int64_t*)column_memory;
+    batch.leds = (uint32_t*)(column_memory + (size_t)batch_rows * 8);
+    for (int i = 0; i < 6; i++) {
+        batch.digits[i] = column_memory + (size_t)batch_rows * (12 + i);
+    }
+
+    if (format == BINARY_CLOCK_ARROW_FILE) {
+        sink_write(&sink, ARROW_MAGIC "\0\0", 8);
+    }
+
+    size_t header_slot = arrow_write_message(&fb, ARROW_HEADER_SCHEMA, 0);
+    fb_patch_offset(&fb, header_slot, arrow_write_schema(&fb));
+    if (fb.failed) {
+        sink.failed = true;
+    } else {
+        sink_write_metadata(&sink, &fb);
+    }
+
+    // Count rows down rather than advancing epoch past end_epoch, which
+    // would overflow for a range ending near INT64_MAX
+    size_t block_count = 0;
+    int64_t epoch = start_epoch;
+    uint64_t remaining = total_rows;
+    while (remaining > 0 && !sink.failed) {
+        uint32_t rows = remaining < batch_rows ? (uint32_t)remaining : batch_rows;
+
+        arrow_fill_batch(&batch, epoch, rows, utc_offset_seconds);
+        arrow_block_t block = arrow_write_batch(&sink, &fb, &batch, rows);
+        if (blocks != NULL) {
+            blocks[block_count] = block;
+        }
+        block_count++;
+        remaining -= rows;
+        if (remaining > 0) {
+            epoch += rows;
+        }
+    }
+
+    // End-of-stream marker
+    const uint8_t eos[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0};
+    sink_write(&sink, eos, sizeof(eos));
+
+    if (format == BINARY_CLOCK_ARROW_FILE) {
+        arrow_write_footer(&sink, &fb, blocks, block_count);
+    }
+
+    free(fb.data);
+    free(blocks);
+    free(column_memory);
+
+    if (sink.failed || fflush(output) != 0) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
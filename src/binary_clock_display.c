@@ -7,11 +7,20 @@
  * core API for all data access and focuses purely on presentation.
  */
 
+#define _DEFAULT_SOURCE
+
 #include <binary_clock_display.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
 
+#ifdef _WIN32
+    #include <io.h>       // For _write
+#else
+    #include <errno.h>
+    #include <sys/uio.h>  // For writev
+#endif
+
 /* ========================================================================== */
 /* DISPLAY CALLBACK SYSTEM (OPTIONAL)                                        */
 /* ========================================================================== */
@@ -23,6 +32,7 @@
  */
 typedef struct {
     binary_clock_display_fn_t display_fn;
+    binary_clock_display_buffer_fn_t buffer_fn; // Set instead of display_fn for buffer displays
     void* context;
     bool active;
     int id;
@@ -33,16 +43,15 @@ typedef struct {
  */
 static display_entry_t display_registry[MAX_REGISTERED_DISPLAYS];
 static int next_registration_id = 0;
+static binary_clock_display_dispatch_stats_t dispatch_stats;
 
-int binary_clock_display_register(binary_clock_display_fn_t display_fn, void* context) {
-    if (display_fn == NULL) {
-        return -1;
-    }
-    
+static int register_entry(binary_clock_display_fn_t display_fn, binary_clock_display_buffer_fn_t buffer_fn,
+                          void* context) {
     // Find empty slot
     for (int i = 0; i < MAX_REGISTERED_DISPLAYS; i++) {
         if (!display_registry[i].active) {
             display_registry[i].display_fn = display_fn;
+            display_registry[i].buffer_fn = buffer_fn;
             display_registry[i].context = context;
             display_registry[i].active = true;
             display_registry[i].id = next_registration_id;
@@ -53,6 +62,20 @@ int binary_clock_display_register(binary_clock_display_fn_t display_fn, void* co
     return -1; // No slots available
 }
 
+int binary_clock_display_register(binary_clock_display_fn_t display_fn, void* context) {
+    if (display_fn == NULL) {
+        return -1;
+    }
+    return register_entry(display_fn, NULL, context);
+}
+
+int binary_clock_display_register_buffer(binary_clock_display_buffer_fn_t render_fn, void* context) {
+    if (render_fn == NULL) {
+        return -1;
+    }
+    return register_entry(NULL, render_fn, context);
+}
+
 binary_clock_error_t binary_clock_display_unregister(int registration_id) {
     if (registration_id < 0) {
         return BINARY_CLOCK_ERROR_INVALID_TIME; // Invalid ID parameter
@@ -63,6 +86,7 @@ binary_clock_error_t binary_clock_display_unregister(int registration_id) {
         if (display_registry[i].active && display_registry[i].id == registration_id) {
             display_registry[i].active = false;
             display_registry[i].display_fn = NULL;
+            display_registry[i].buffer_fn = NULL;
             display_registry[i].context = NULL;
             display_registry[i].id = -1;
             return BINARY_CLOCK_SUCCESS;
@@ -78,233 +102,427 @@ void binary_clock_display_update_all(void) {
     binary_clock_display_update_all_with_state(&state);
 }
 
+/**
+ * @brief A rendered slice waiting for its sink's gathered write
+ */
+typedef struct {
+    const char* data;
+    size_t length;
+    int sink;
+} display_slice_t;
+
+#ifdef _WIN32
+
+// No writev: join the sink's slices and write them at once
+static int write_gathered(int sink, const display_slice_t* slices, const int* picked, int count) {
+    char joined[MAX_REGISTERED_DISPLAYS * BINARY_CLOCK_DISPLAY_SLICE_SIZE];
+    size_t length = 0;
+    for (int i = 0; i < count; i++) {
+        memcpy(joined + length, slices[picked[i]].data, slices[picked[i]].length);
+        length += slices[picked[i]].length;
+    }
+    dispatch_stats.system_calls++;
+    return _write(sink, joined, (unsigned int)length) == (int)length ? 0 : -1;
+}
+
+#else
+
+static int write_gathered(int sink, const display_slice_t* slices, const int* picked, int count) {
+    struct iovec vectors[MAX_REGISTERED_DISPLAYS];
+    struct iovec* next = vectors;
+    for (int i = 0; i < count; i++) {
+        vectors[i].iov_base = (void*)slices[picked[i]].data;
+        vectors[i].iov_len = slices[picked[i]].length;
+    }
+    while (count > 0) {
+        ssize_t written = writev(sink, next, count);
+        dispatch_stats.system_calls++;
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        // Skip the slices written whole, then trim the one written in part
+        while (count > 0 && (size_t)written >= next->iov_len) {
+            written -= (ssize_t)next->iov_len;
+            next++;
+            count--;
+        }
+        if (count > 0) {
+            next->iov_base = (char*)next->iov_base + written;
+            next->iov_len -= (size_t)written;
+        }
+    }
+    return 0;
+}
+
+#endif
+
 void binary_clock_display_update_all_with_state(const binary_clock_state_t* state) {
     if (state == NULL) {
         return; // Silently ignore null pointer
     }
     
-    // Call all active display functions
+    // Call all active display functions; buffer displays render into slices
+    char buffers[MAX_REGISTERED_DISPLAYS][BINARY_CLOCK_DISPLAY_SLICE_SIZE];
+    display_slice_t slices[MAX_REGISTERED_DISPLAYS];
+    int slice_count = 0;
+    bool called = false;
     for (int i = 0; i < MAX_REGISTERED_DISPLAYS; i++) {
-        if (display_registry[i].active && display_registry[i].display_fn != NULL) {
+        if (!display_registry[i].active) {
+            continue;
+        }
+        if (display_registry[i].display_fn != NULL) {
             display_registry[i].display_fn(state, display_registry[i].context);
+            called = true;
+        } else if (display_registry[i].buffer_fn != NULL) {
+            int sink = BINARY_CLOCK_DISPLAY_DEFAULT_SINK;
+            size_t length = display_registry[i].buffer_fn(state, display_registry[i].context, buffers[slice_count],
+                                                          BINARY_CLOCK_DISPLAY_SLICE_SIZE, &sink);
+            if (length == 0) {
+                continue;
+            }
+            dispatch_stats.slices++;
+            if (length > BINARY_CLOCK_DISPLAY_SLICE_SIZE || sink < 0) {
+                dispatch_stats.errors++;
+                continue;
+            }
+            slices[slice_count].data = buffers[slice_count];
+            slices[slice_count].length = length;
+            slices[slice_count].sink = sink;
+            slice_count++;
+        }
+    }
+    if (slice_count == 0) {
+        return;
+    }
+    
+    // What function callbacks left in stdio goes out before the slices
+    if (called) {
+        fflush(stdout);
+    }
+    
+    // One gathered write per sink, sinks in order of their first slice
+    bool sent[MAX_REGISTERED_DISPLAYS] = {false};
+    for (int first = 0; first < slice_count; first++) {
+        if (sent[first]) {
+            continue;
+        }
+        int picked[MAX_REGISTERED_DISPLAYS];
+        int count = 0;
+        size_t bytes = 0;
+        for (int i = first; i < slice_count; i++) {
+            if (!sent[i] && slices[i].sink == slices[first].sink) {
+                sent[i] = true;
+                picked[count++] = i;
+                bytes += slices[i].length;
+            }
+        }
+        if (write_gathered(slices[first].sink, slices, picked, count) == 0) {
+            dispatch_stats.bytes += bytes;
+        } else {
+            dispatch_stats.errors += (uint64_t)count;
         }
     }
 }
 
+binary_clock_display_dispatch_stats_t binary_clock_display_get_dispatch_stats(void) {
+    return dispatch_stats;
+}
+
 /* ========================================================================== */
-/* BUILT-IN DISPLAY FUNCTIONS                                                 */
+/* BUFFER RENDERING                                                           */
 /* ========================================================================== */
 
-void binary_clock_display_console_emoji(const binary_clock_state_t* state, void* context) {
-    (void)context; // Unused parameter
-    
-    if (state == NULL) {
+/**
+ * @brief Bounded output buffer used by the renderers
+ */
+typedef struct {
+    char* data;
+    size_t size;
+    size_t length;
+    bool overflow;
+    bool tables;                // Copy digit columns from the glyph tables
+} render_buffer_t;
+
+/*
+ * Glyph tables for the table kernel: every 3- and 4-bit digit column
+ * pre-rendered in each glyph set the renderers use
+ */
+#define GLYPH_EMOJI(bit) GLYPH_EMOJI_##bit
+#define GLYPH_EMOJI_0 "🌚"
+#define GLYPH_EMOJI_1 "🌝"
+#define GLYPH_DIGIT(bit) GLYPH_DIGIT_##bit
+#define GLYPH_DIGIT_0 "0"
+#define GLYPH_DIGIT_1 "1"
+
+#define COLUMNS3(F) F(0,0,0) F(0,0,1) F(0,1,0) F(0,1,1) F(1,0,0) F(1,0,1) F(1,1,0) F(1,1,1)
+#define COLUMNS4(F) \
+    F(0,0,0,0) F(0,0,0,1) F(0,0,1,0) F(0,0,1,1) F(0,1,0,0) F(0,1,0,1) F(0,1,1,0) F(0,1,1,1) \
+    F(1,0,0,0) F(1,0,0,1) F(1,0,1,0) F(1,0,1,1) F(1,1,0,0) F(1,1,0,1) F(1,1,1,0) F(1,1,1,1)
+
+#define EMOJI3(a, b, c) GLYPH_EMOJI(a) GLYPH_EMOJI(b) GLYPH_EMOJI(c),
+#define EMOJI4(a, b, c, d) GLYPH_EMOJI(a) GLYPH_EMOJI(b) GLYPH_EMOJI(c) GLYPH_EMOJI(d),
+#define DIGITS3(a, b, c) GLYPH_DIGIT(a) GLYPH_DIGIT(b) GLYPH_DIGIT(c),
+#define DIGITS4(a, b, c, d) GLYPH_DIGIT(a) GLYPH_DIGIT(b) GLYPH_DIGIT(c) GLYPH_DIGIT(d),
+#define LIST3(a, b, c) GLYPH_DIGIT(a) "," GLYPH_DIGIT(b) "," GLYPH_DIGIT(c),
+#define LIST4(a, b, c, d) GLYPH_DIGIT(a) "," GLYPH_DIGIT(b) "," GLYPH_DIGIT(c) "," GLYPH_DIGIT(d),
+
+static const char emoji_columns3[8][13] = { COLUMNS3(EMOJI3) };
+static const char emoji_columns4[16][17] = { COLUMNS4(EMOJI4) };
+static const char digit_columns3[8][4] = { COLUMNS3(DIGITS3) };
+static const char digit_columns4[16][5] = { COLUMNS4(DIGITS4) };
+static const char list_columns3[8][6] = { COLUMNS3(LIST3) };
+static const char list_columns4[16][8] = { COLUMNS4(LIST4) };
+
+static void render_bytes(render_buffer_t* out, const char* bytes, size_t count) {
+    if (out->overflow || out->length + count >= out->size) {
+        out->overflow = true;
         return;
     }
+    memcpy(out->data + out->length, bytes, count);
+    out->length += count;
+}
+
+static void render_string(render_buffer_t* out, const char* str) {
+    render_bytes(out, str, strlen(str));
+}
+
+static void render_two_digits(render_buffer_t* out, int value) {
+    char digits[2] = {(char)('0' + value / 10), (char)('0' + value % 10)};
+    render_bytes(out, digits, 2);
+}
+
+static void render_long(render_buffer_t* out, long value) {
+    char digits[24];
+    int pos = (int)sizeof(digits);
+    unsigned long magnitude = value < 0 ? 0UL - (unsigned long)value : (unsigned long)value;
     
-    // Calculate readable time from binary data
-    int hours = state->hours_tens.decimal_value * 10 + state->hours_units.decimal_value;
-    int minutes = state->minutes_tens.decimal_value * 10 + state->minutes_units.decimal_value;
-    int seconds = state->seconds_tens.decimal_value * 10 + state->seconds_units.decimal_value;
-    
-    // Display header
-    printf("🌝 Binary Clock 🌚\n");
-    printf("Time: %02d:%02d:%02d\n", hours, minutes, seconds);
-    printf("\n");
-    
-    // Hours
-    printf("Hours   : ");
-    for (int i = 0; i < state->hours_tens.bit_count; i++) {
-        printf("%s", state->hours_tens.bits[i] ? "🌝" : "🌚");
-    }
-    printf(" ");
-    for (int i = 0; i < state->hours_units.bit_count; i++) {
-        printf("%s", state->hours_units.bits[i] ? "🌝" : "🌚");
-    }
-    printf("\n");
-    
-    // Minutes
-    printf("Minutes : ");
-    for (int i = 0; i < state->minutes_tens.bit_count; i++) {
-        printf("%s", state->minutes_tens.bits[i] ? "🌝" : "🌚");
-    }
-    printf(" ");
-    for (int i = 0; i < state->minutes_units.bit_count; i++) {
-        printf("%s", state->minutes_units.bits[i] ? "🌝" : "🌚");
+    do {
+        digits[--pos] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        digits[--pos] = '-';
+    }
+    render_bytes(out, digits + pos, sizeof(digits) - (size_t)pos);
+}
+
+static void render_time(render_buffer_t* out, const binary_clock_state_t* state) {
+    render_two_digits(out, state->hours_tens.decimal_value * 10 + state->hours_units.decimal_value);
+    render_bytes(out, ":", 1);
+    render_two_digits(out, state->minutes_tens.decimal_value * 10 + state->minutes_units.decimal_value);
+    render_bytes(out, ":", 1);
+    render_two_digits(out, state->seconds_tens.decimal_value * 10 + state->seconds_units.decimal_value);
+}
+
+// Table kernel: copy a whole digit column, false if no table covers it
+static bool render_bits_table(render_buffer_t* out, const binary_value_t* value,
+                              const char* on, const char* separator) {
+    if (value->bit_count != 3 && value->bit_count != 4) {
+        return false;
     }
-    printf("\n");
-    
-    // Seconds
-    printf("Seconds : ");
-    for (int i = 0; i < state->seconds_tens.bit_count; i++) {
-        printf("%s", state->seconds_tens.bits[i] ? "🌝" : "🌚");
+    unsigned index = 0;
+    for (int i = 0; i < value->bit_count; i++) {
+        index = index << 1 | (value->bits[i] ? 1u : 0u);
     }
-    printf(" ");
-    for (int i = 0; i < state->seconds_units.bit_count; i++) {
-        printf("%s", state->seconds_units.bits[i] ? "🌝" : "🌚");
+
+    bool four = value->bit_count == 4;
+    if (separator == NULL && strcmp(on, GLYPH_EMOJI_1) == 0) {
+        render_bytes(out, four ? emoji_columns4[index] : emoji_columns3[index], four ? 16 : 12);
+    } else if (separator == NULL && strcmp(on, GLYPH_DIGIT_1) == 0) {
+        render_bytes(out, four ? digit_columns4[index] : digit_columns3[index], four ? 4 : 3);
+    } else if (separator != NULL && strcmp(separator, ",") == 0 && strcmp(on, GLYPH_DIGIT_1) == 0) {
+        render_bytes(out, four ? list_columns4[index] : list_columns3[index], four ? 7 : 5);
+    } else {
+        return false;
     }
-    printf("\n");
+    return true;
 }
 
-void binary_clock_display_console_ascii(const binary_clock_state_t* state, void* context) {
-    (void)context; // Unused parameter
-    
-    if (state == NULL) {
+// Bits as glyphs (emoji or 0/1) with an optional separator between bits
+static void render_bits(render_buffer_t* out, const binary_value_t* value,
+                        const char* on, const char* off, const char* separator) {
+    if (out->tables && render_bits_table(out, value, on, separator)) {
         return;
     }
-    
-    // Calculate readable time from binary data
-    int hours = state->hours_tens.decimal_value * 10 + state->hours_units.decimal_value;
-    int minutes = state->minutes_tens.decimal_value * 10 + state->minutes_units.decimal_value;
-    int seconds = state->seconds_tens.decimal_value * 10 + state->seconds_units.decimal_value;
-    
-    // Display header
-    printf("Binary Clock (ASCII)\n");
-    printf("Time: %02d:%02d:%02d\n", hours, minutes, seconds);
-    printf("\n");
-    
-    // Hours
-    printf("Hours   : ");
-    for (int i = 0; i < state->hours_tens.bit_count; i++) {
-        printf("%d", state->hours_tens.bits[i] ? 1 : 0);
-    }
-    printf(" ");
-    for (int i = 0; i < state->hours_units.bit_count; i++) {
-        printf("%d", state->hours_units.bits[i] ? 1 : 0);
+    for (int i = 0; i < value->bit_count; i++) {
+        if (i > 0 && separator != NULL) {
+            render_string(out, separator);
+        }
+        render_string(out, value->bits[i] ? on : off);
     }
-    printf("\n");
+}
+
+static void render_console(render_buffer_t* out, const binary_clock_state_t* state,
+                           const char* title, const char* on, const char* off) {
+    const char* labels[3] = {"Hours   : ", "Minutes : ", "Seconds : "};
+    const binary_value_t* digits[6] = {
+        &state->hours_tens, &state->hours_units,
+        &state->minutes_tens, &state->minutes_units,
+        &state->seconds_tens, &state->seconds_units
+    };
     
-    // Minutes
-    printf("Minutes : ");
-    for (int i = 0; i < state->minutes_tens.bit_count; i++) {
-        printf("%d", state->minutes_tens.bits[i] ? 1 : 0);
-    }
-    printf(" ");
-    for (int i = 0; i < state->minutes_units.bit_count; i++) {
-        printf("%d", state->minutes_units.bits[i] ? 1 : 0);
-    }
-    printf("\n");
+    render_string(out, title);
+    render_string(out, "Time: ");
+    render_time(out, state);
+    render_string(out, "\n\n");
     
-    // Seconds
-    printf("Seconds : ");
-    for (int i = 0; i < state->seconds_tens.bit_count; i++) {
-        printf("%d", state->seconds_tens.bits[i] ? 1 : 0);
+    for (int row = 0; row < 3; row++) {
+        render_string(out, labels[row]);
+        render_bits(out, digits[2 * row], on, off, NULL);
+        render_bytes(out, " ", 1);
+        render_bits(out, digits[2 * row + 1], on, off, NULL);
+        render_bytes(out, "\n", 1);
     }
-    printf(" ");
-    for (int i = 0; i < state->seconds_units.bit_count; i++) {
-        printf("%d", state->seconds_units.bits[i] ? 1 : 0);
-    }
-    printf("\n");
 }
 
-void binary_clock_display_json(const binary_clock_state_t* state, void* context) {
-    FILE* output = (FILE*)context;
-    if (output == NULL) {
-        output = stdout;
-    }
-    
-    if (state == NULL) {
-        return;
-    }
-    
-    // Calculate readable time from binary data
-    int hours = state->hours_tens.decimal_value * 10 + state->hours_units.decimal_value;
-    int minutes = state->minutes_tens.decimal_value * 10 + state->minutes_units.decimal_value;
-    int seconds = state->seconds_tens.decimal_value * 10 + state->seconds_units.decimal_value;
-    
-    fprintf(output, "{\n");
-    fprintf(output, "  \"timestamp\": %ld,\n", (long)state->timestamp);
-    fprintf(output, "  \"time\": \"%02d:%02d:%02d\",\n", hours, minutes, seconds);
-    fprintf(output, "  \"binary\": {\n");
+static void render_compact(render_buffer_t* out, const binary_clock_state_t* state,
+                           const char* on, const char* off) {
+    render_time(out, state);
+    render_string(out, " [");
+    render_bits(out, &state->hours_tens, on, off, NULL);
+    render_bytes(out, " ", 1);
+    render_bits(out, &state->hours_units, on, off, NULL);
+    render_string(out, " : ");
+    render_bits(out, &state->minutes_tens, on, off, NULL);
+    render_bytes(out, " ", 1);
+    render_bits(out, &state->minutes_units, on, off, NULL);
+    render_string(out, " : ");
+    render_bits(out, &state->seconds_tens, on, off, NULL);
+    render_bytes(out, " ", 1);
+    render_bits(out, &state->seconds_units, on, off, NULL);
+    render_string(out, "]\n");
+}
+
+static void render_json(render_buffer_t* out, const binary_clock_state_t* state, bool pretty) {
+    const char* names[3] = {"hours", "minutes", "seconds"};
+    const binary_value_t* digits[6] = {
+        &state->hours_tens, &state->hours_units,
+        &state->minutes_tens, &state->minutes_units,
+        &state->seconds_tens, &state->seconds_units
+    };
     
-    // Hours
-    fprintf(output, "    \"hours\": {\n");
-    fprintf(output, "      \"tens\": [");
-    for (int i = 0; i < state->hours_tens.bit_count; i++) {
-        fprintf(output, "%s%d", (i > 0) ? "," : "", state->hours_tens.bits[i] ? 1 : 0);
-    }
-    fprintf(output, "],\n");
-    fprintf(output, "      \"units\": [");
-    for (int i = 0; i < state->hours_units.bit_count; i++) {
-        fprintf(output, "%s%d", (i > 0) ? "," : "", state->hours_units.bits[i] ? 1 : 0);
-    }
-    fprintf(output, "]\n");
-    fprintf(output, "    },\n");
+    render_string(out, pretty ? "{\n  \"timestamp\": " : "{\"timestamp\":");
+    render_long(out, (long)state->timestamp);
+    render_string(out, pretty ? ",\n  \"time\": \"" : ",\"time\":\"");
+    render_time(out, state);
+    render_string(out, pretty ? "\",\n  \"binary\": {\n" : "\",\"binary\":{");
     
-    // Minutes
-    fprintf(output, "    \"minutes\": {\n");
-    fprintf(output, "      \"tens\": [");
-    for (int i = 0; i < state->minutes_tens.bit_count; i++) {
-        fprintf(output, "%s%d", (i > 0) ? "," : "", state->minutes_tens.bits[i] ? 1 : 0);
-    }
-    fprintf(output, "],\n");
-    fprintf(output, "      \"units\": [");
-    for (int i = 0; i < state->minutes_units.bit_count; i++) {
-        fprintf(output, "%s%d", (i > 0) ? "," : "", state->minutes_units.bits[i] ? 1 : 0);
+    for (int i = 0; i < 3; i++) {
+        if (pretty) {
+            render_string(out, "    \"");
+            render_string(out, names[i]);
+            render_string(out, "\": {\n      \"tens\": [");
+            render_bits(out, digits[2 * i], "1", "0", ",");
+            render_string(out, "],\n      \"units\": [");
+            render_bits(out, digits[2 * i + 1], "1", "0", ",");
+            render_string(out, i < 2 ? "]\n    },\n" : "]\n    }\n");
+        } else {
+            render_string(out, i > 0 ? ",\"" : "\"");
+            render_string(out, names[i]);
+            render_string(out, "\":{\"tens\":[");
+            render_bits(out, digits[2 * i], "1", "0", ",");
+            render_string(out, "],\"units\":[");
+            render_bits(out, digits[2 * i + 1], "1", "0", ",");
+            render_string(out, "]}");
+        }
     }
-    fprintf(output, "]\n");
-    fprintf(output, "    },\n");
     
-    // Seconds
-    fprintf(output, "    \"seconds\": {\n");
-    fprintf(output, "      \"tens\": [");
-    for (int i = 0; i < state->seconds_tens.bit_count; i++) {
-        fprintf(output, "%s%d", (i > 0) ? "," : "", state->seconds_tens.bits[i] ? 1 : 0);
-    }
-    fprintf(output, "],\n");
-    fprintf(output, "      \"units\": [");
-    for (int i = 0; i < state->seconds_units.bit_count; i++) {
-        fprintf(output, "%s%d", (i > 0) ? "," : "", state->seconds_units.bits[i] ? 1 : 0);
-    }
-    fprintf(output, "]\n");
-    fprintf(output, "    }\n");
-    fprintf(output, "  }\n");
-    fprintf(output, "}\n");
+    render_string(out, pretty ? "  }\n}\n" : "}}\n");
 }
 
-void binary_clock_display_compact(const binary_clock_state_t* state, void* context) {
-    (void)context; // Unused parameter
-    
-    if (state == NULL) {
-        return;
+static size_t render(const binary_clock_state_t* state, binary_clock_render_format_t format,
+                     char* buffer, size_t buffer_size, bool tables) {
+    if (state == NULL || buffer == NULL || buffer_size == 0) {
+        return 0;
     }
     
-    // Calculate readable time from binary data
-    int hours = state->hours_tens.decimal_value * 10 + state->hours_units.decimal_value;
-    int minutes = state->minutes_tens.decimal_value * 10 + state->minutes_units.decimal_value;
-    int seconds = state->seconds_tens.decimal_value * 10 + state->seconds_units.decimal_value;
-    
-    printf("%02d:%02d:%02d [", hours, minutes, seconds);
+    render_buffer_t out = {buffer, buffer_size, 0, false, tables};
     
-    // Hours
-    for (int i = 0; i < state->hours_tens.bit_count; i++) {
-        printf("%d", state->hours_tens.bits[i] ? 1 : 0);
-    }
-    printf(" ");
-    for (int i = 0; i < state->hours_units.bit_count; i++) {
-        printf("%d", state->hours_units.bits[i] ? 1 : 0);
+    switch (format) {
+        case BINARY_CLOCK_RENDER_EMOJI:
+            render_console(&out, state, "🌝 Binary Clock 🌚\n", "🌝", "🌚");
+            break;
+        case BINARY_CLOCK_RENDER_ASCII:
+            render_console(&out, state, "Binary Clock (ASCII)\n", "1", "0");
+            break;
+        case BINARY_CLOCK_RENDER_COMPACT:
+            render_compact(&out, state, "1", "0");
+            break;
+        case BINARY_CLOCK_RENDER_EMOJI_LINE:
+            render_compact(&out, state, "🌝", "🌚");
+            break;
+        case BINARY_CLOCK_RENDER_JSON:
+            render_json(&out, state, true);
+            break;
+        case BINARY_CLOCK_RENDER_JSON_LINE:
+            render_json(&out, state, false);
+            break;
+        default:
+            return 0;
     }
-    printf(" : ");
     
-    // Minutes
-    for (int i = 0; i < state->minutes_tens.bit_count; i++) {
-        printf("%d", state->minutes_tens.bits[i] ? 1 : 0);
+    if (out.overflow) {
+        buffer[0] = '\0';
+        return 0;
     }
-    printf(" ");
-    for (int i = 0; i < state->minutes_units.bit_count; i++) {
-        printf("%d", state->minutes_units.bits[i] ? 1 : 0);
-    }
-    printf(" : ");
+    buffer[out.length] = '\0';
+    return out.length;
+}
+
+size_t binary_clock_display_render(const binary_clock_state_t* state, binary_clock_render_format_t format,
+                                   char* buffer, size_t buffer_size) {
+    return render(state, format, buffer, buffer_size, false);
+}
+
+size_t binary_clock_display_render_table(const binary_clock_state_t* state, binary_clock_render_format_t format,
+                                         char* buffer, size_t buffer_size) {
+    return render(state, format, buffer, buffer_size, true);
+}
+
+size_t binary_clock_display_table_size(void) {
+    return sizeof(emoji_columns3) + sizeof(emoji_columns4) + sizeof(digit_columns3) +
+           sizeof(digit_columns4) + sizeof(list_columns3) + sizeof(list_columns4);
+}
+
+/* ========================================================================== */
+/* BUILT-IN DISPLAY FUNCTIONS                                                 */
+/* ========================================================================== */
+
+static void display_rendered(const binary_clock_state_t* state, binary_clock_render_format_t format, FILE* output) {
+    char buffer[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = binary_clock_display_render(state, format, buffer, sizeof(buffer));
     
-    // Seconds
-    for (int i = 0; i < state->seconds_tens.bit_count; i++) {
-        printf("%d", state->seconds_tens.bits[i] ? 1 : 0);
-    }
-    printf(" ");
-    for (int i = 0; i < state->seconds_units.bit_count; i++) {
-        printf("%d", state->seconds_units.bits[i] ? 1 : 0);
+    if (length > 0) {
+        fwrite(buffer, 1, length, output);
     }
-    printf("]\n");
+}
+
+void binary_clock_display_console_emoji(const binary_clock_state_t* state, void* context) {
+    (void)context; // Unused parameter
+    display_rendered(state, BINARY_CLOCK_RENDER_EMOJI, stdout);
+}
+
+void binary_clock_display_console_ascii(const binary_clock_state_t* state, void* context) {
+    (void)context; // Unused parameter
+    display_rendered(state, BINARY_CLOCK_RENDER_ASCII, stdout);
+}
+
+void binary_clock_display_json(const binary_clock_state_t* state, void* context) {
+    FILE* output = (FILE*)context;
+    display_rendered(state, BINARY_CLOCK_RENDER_JSON, output != NULL ? output : stdout);
+}
+
+void binary_clock_display_json_line(const binary_clock_state_t* state, void* context) {
+    FILE* output = (FILE*)context;
+    display_rendered(state, BINARY_CLOCK_RENDER_JSON_LINE, output != NULL ? output : stdout);
+}
+
+void binary_clock_display_compact(const binary_clock_state_t* state, void* context) {
+    (void)context; // Unused parameter
+    display_rendered(state, BINARY_CLOCK_RENDER_COMPACT, stdout);
 }
 
 /* ========================================================================== */
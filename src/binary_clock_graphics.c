@@ -0,0 +1,310 @@
+/**
+ * @file binary_clock_graphics.c
+ * @brief Binary Clock Graphics Implementation
+ *
+ * kitty commands are APC sequences (ESC _ G keys ; payload ESC \). Every
+ * command carries q=2 so the terminal sends no replies to stdin. LED n
+ * uses placement ID n + 1 for both images: the off placement stays for
+ * the life of the display, below the text (z=-1), and the on placement is
+ * created on top of it and deleted again (d=i keeps the image data).
+ * c=2,r=1 scales the image to the two cells an emoji LED takes. Every
+ * placement starts with a cursor move, so where a placement leaves the
+ * cursor does not matter; the time line is written last and leaves the
+ * cursor at its end.
+ *
+ * Sixel glyphs use a transparent background (P2 = 1), so only the disc is
+ * painted. The off and on discs have the same shape, which makes either
+ * one fully cover the other.
+ */
+
+#include <binary_clock_graphics.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char title[] = "\033[2J\033[H🌝 Binary Clock 🌚\nTime: \n";
+static const char* const labels[3] = {"Hours   : ", "Minutes : ", "Seconds : "};
+
+// First screen column of the LEDs, after the label
+#define LED_COLUMN 11
+
+// kitty LED colors, RGB
+static const uint8_t image_colors[2][3] = {{58, 58, 72}, {255, 214, 64}};
+
+// The same colors in sixel's percentages
+static const uint8_t sixel_colors[2][3] = {{23, 23, 28}, {100, 84, 25}};
+
+binary_clock_graphics_protocol_t binary_clock_graphics_detect(const char* term, const char* term_program,
+                                                              const char* kitty_window_id) {
+    if ((kitty_window_id != NULL && kitty_window_id[0] != '\0') ||
+        (term != NULL && (strstr(term, "kitty") != NULL || strstr(term, "ghostty") != NULL)) ||
+        (term_program != NULL && (strcmp(term_program, "WezTerm") == 0 || strcmp(term_program, "ghostty") == 0))) {
+        return BINARY_CLOCK_GRAPHICS_KITTY;
+    }
+    return BINARY_CLOCK_GRAPHICS_SIXEL;
+}
+
+// Sixel for one LED: a disc of radius 5.5 centered in the glyph, with
+// runs of a repeated column written as !count
+static size_t encode_sixel(const uint8_t color[3], char* output, size_t size) {
+    int length = snprintf(output, size, "\033P0;1;0q\"1;1;%d;%d#1;2;%u;%u;%u", BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH,
+                          BINARY_CLOCK_GRAPHICS_SIXEL_HEIGHT, (unsigned)color[0], (unsigned)color[1],
+                          (unsigned)color[2]);
+    if (length <= 0 || (size_t)length >= size) {
+        return 0;
+    }
+    size_t used = (size_t)length;
+    for (int band = 0; band < BINARY_CLOCK_GRAPHICS_SIXEL_HEIGHT / 6; band++) {
+        char columns[BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH];
+        for (int x = 0; x < BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH; x++) {
+            int bits = 0;
+            for (int k = 0; k < 6; k++) {
+                int dx = 2 * x - (BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH - 1);
+                int dy = 2 * (band * 6 + k) - (BINARY_CLOCK_GRAPHICS_SIXEL_HEIGHT - 1);
+                if (dx * dx + dy * dy <= 121) {
+                    bits |= 1 << k;
+                }
+            }
+            columns[x] = (char)('?' + bits);
+        }
+        length = snprintf(output + used, size - used, "%s#1", band > 0 ? "-" : "");
+        if (length <= 0 || (size_t)length >= size - used) {
+            return 0;
+        }
+        used += (size_t)length;
+        for (int x = 0; x < BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH;) {
+            int run = 1;
+            while (x + run < BINARY_CLOCK_GRAPHICS_SIXEL_WIDTH && columns[x + run] == columns[x]) {
+                run++;
+            }
+            length = run > 3 ? snprintf(output + used, size - used, "!%d%c", run, columns[x])
+                             : snprintf(output + used, size - used, "%.*s", run, columns + x);
+            if (length <= 0 || (size_t)length >= size - used) {
+                return 0;
+            }
+            used += (size_t)length;
+            x += run;
+        }
+    }
+    if (size - used < 3) {
+        return 0;
+    }
+    memcpy(output + used, "\033\\", 3);
+    return used + 2;
+}
+
+// Base64 of the LED image, RGBA: a disc of radius 9 with a softer rim
+static size_t encode_image(const uint8_t color[3], char* output, size_t size) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint8_t pixels[BINARY_CLOCK_GRAPHICS_IMAGE_SIZE * BINARY_CLOCK_GRAPHICS_IMAGE_SIZE * 4];
+    size_t count = 0;
+    for (int y = 0; y < BINARY_CLOCK_GRAPHICS_IMAGE_SIZE; y++) {
+        for (int x = 0; x < BINARY_CLOCK_GRAPHICS_IMAGE_SIZE; x++) {
+            int dx = 2 * x - (BINARY_CLOCK_GRAPHICS_IMAGE_SIZE - 1);
+            int dy = 2 * y - (BINARY_CLOCK_GRAPHICS_IMAGE_SIZE - 1);
+            int distance = dx * dx + dy * dy;
+            pixels[count++] = color[0];
+            pixels[count++] = color[1];
+            pixels[count++] = color[2];
+            pixels[count++] = distance <= 18 * 18 ? 255 : (distance <= 20 * 20 ? 96 : 0);
+        }
+    }
+    size_t length = (count + 2) / 3 * 4;
+    if (length >= size) {
+        return 0;
+    }
+    size_t used = 0;
+    for (size_t i = 0; i < count; i += 3) {
+        uint32_t group = (uint32_t)pixels[i] << 16 | (i + 1 < count ? (uint32_t)pixels[i + 1] << 8 : 0) |
+                         (i + 2 < count ? pixels[i + 2] : 0);
+        output[used++] = alphabet[group >> 18 & 63];
+        output[used++] = alphabet[group >> 12 & 63];
+        output[used++] = i + 1 < count ? alphabet[group >> 6 & 63] : '=';
+        output[used++] = i + 2 < count ? alphabet[group & 63] : '=';
+    }
+    return used;
+}
+
+size_t binary_clock_graphics_begin(binary_clock_graphics_t* graphics, char* output, size_t size) {
+    if (graphics == NULL || output == NULL) {
+        return 0;
+    }
+    int length = snprintf(output, size, "%s\033[%d;1H%s\n%s\n%s", title, BINARY_CLOCK_GRAPHICS_TOP_ROW, labels[0],
+                          labels[1], labels[2]);
+    if (length <= 0 || (size_t)length >= size) {
+        return 0;
+    }
+    size_t used = (size_t)length;
+    if (graphics->protocol == BINARY_CLOCK_GRAPHICS_KITTY) {
+        // Transmit both images once; placements refer to them by ID
+        for (int on = 0; on < 2; on++) {
+            length = snprintf(output + used, size - used, "\033_Ga=t,f=32,s=%d,v=%d,i=%u,q=2;",
+                              BINARY_CLOCK_GRAPHICS_IMAGE_SIZE, BINARY_CLOCK_GRAPHICS_IMAGE_SIZE,
+                              BINARY_CLOCK_GRAPHICS_IMAGE_ID + (unsigned)on);
+            if (length <= 0 || (size_t)length >= size - used) {
+                return 0;
+            }
+            used += (size_t)length;
+            size_t data = encode_image(image_colors[on], output + used, size - used);
+            if (data == 0 || size - used - data < 3) {
+                return 0;
+            }
+            used += data;
+            memcpy(output + used, "\033\\", 2);
+            used += 2;
+        }
+    }
+    graphics->placed = false;
+    return used;
+}
+
+// Append a cursor move to an LED's first cell
+static int move_to_led(char* output, size_t size, int led) {
+    int row = led / 7;
+    int index = led % 7;
+    return snprintf(output, size, "\033[%d;%dH", BINARY_CLOCK_GRAPHICS_TOP_ROW + row,
+                    LED_COLUMN + 2 * index + (index >= 3 ? 1 : 0));
+}
+
+// Append what turns LED led off or on (or draws it, the first time)
+static int draw_led(const binary_clock_graphics_t* graphics, int led, bool on, bool first, char* output,
+                    size_t size) {
+    unsigned placement = (unsigned)led + 1;
+    if (graphics->protocol == BINARY_CLOCK_GRAPHICS_SIXEL) {
+        int length = move_to_led(output, size, led);
+        size_t glyph = graphics->glyph_lengths[on ? 1 : 0];
+        if (length <= 0 || (size_t)length + glyph >= size) {
+            return -1;
+        }
+        memcpy(output + length, graphics->glyphs[on ? 1 : 0], glyph + 1);
+        return length + (int)glyph;
+    }
+    if (!on && !first) {
+        return snprintf(output, size, "\033_Ga=d,d=i,i=%u,p=%u,q=2\033\\", BINARY_CLOCK_GRAPHICS_IMAGE_ID + 1,
+                        placement);
+    }
+    int length = move_to_led(output, size, led);
+    if (length <= 0 || (size_t)length >= size) {
+        return -1;
+    }
+    int command = 0;
+    if (first) {
+        command = snprintf(output + length, size - (size_t)length, "\033_Ga=p,i=%u,p=%u,c=2,r=1,z=-1,q=2\033\\",
+                           BINARY_CLOCK_GRAPHICS_IMAGE_ID, placement);
+        if (command <= 0 || (size_t)command >= size - (size_t)length) {
+            return -1;
+        }
+        length += command;
+        if (!on) {
+            return length;
+        }
+    }
+    command = snprintf(output + length, size - (size_t)length, "\033_Ga=p,i=%u,p=%u,c=2,r=1,q=2\033\\",
+                       BINARY_CLOCK_GRAPHICS_IMAGE_ID + 1, placement);
+    return command > 0 ? length + command : -1;
+}
+
+binary_clock_error_t binary_clock_graphics_init(binary_clock_graphics_t* graphics,
+                                                binary_clock_graphics_protocol_t protocol) {
+    if (graphics == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(graphics, 0, sizeof(*graphics));
+    graphics->protocol = protocol;
+    if (protocol == BINARY_CLOCK_GRAPHICS_SIXEL) {
+        for (int on = 0; on < 2; on++) {
+            graphics->glyph_lengths[on] = encode_sixel(sixel_colors[on], graphics->glyphs[on],
+                                                       sizeof(graphics->glyphs[on]));
+        }
+    } else if (protocol != BINARY_CLOCK_GRAPHICS_KITTY) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    for (int led = 0; led < BINARY_CLOCK_GRAPHICS_LEDS; led++) {
+        for (int on = 0; on < 2; on++) {
+            int length = draw_led(graphics, led, on == 1, false, graphics->commands[led][on],
+                                  BINARY_CLOCK_GRAPHICS_COMMAND_SIZE);
+            graphics->command_lengths[led][on] = length > 0 ? (uint8_t)length : 0;
+        }
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+size_t binary_clock_graphics_tick(binary_clock_graphics_t* graphics, const binary_clock_state_t* state,
+                                  char* output, size_t size) {
+    if (graphics == NULL || state == NULL || output == NULL) {
+        return 0;
+    }
+    const binary_value_t* digits[6] = {&state->hours_tens, &state->hours_units, &state->minutes_tens,
+                                       &state->minutes_units, &state->seconds_tens, &state->seconds_units};
+    bool lit[BINARY_CLOCK_GRAPHICS_LEDS];
+    for (int row = 0; row < 3; row++) {
+        for (int i = 0; i < 3; i++) {
+            lit[row * 7 + i] = digits[row * 2]->bits[i];
+        }
+        for (int i = 0; i < 4; i++) {
+            lit[row * 7 + 3 + i] = digits[row * 2 + 1]->bits[i];
+        }
+    }
+
+    size_t used = 0;
+    uint64_t drawn = 0;
+    bool first = !graphics->placed;
+    for (int led = 0; led < BINARY_CLOCK_GRAPHICS_LEDS; led++) {
+        if (!first && lit[led] == graphics->lit[led]) {
+            continue;
+        }
+        if (first) {
+            int length = draw_led(graphics, led, lit[led], true, output + used, size - used);
+            if (length <= 0 || (size_t)length >= size - used) {
+                return 0;
+            }
+            used += (size_t)length;
+        } else {
+            size_t length = graphics->command_lengths[led][lit[led] ? 1 : 0];
+            if (length >= size - used) {
+                return 0;
+            }
+            memcpy(output + used, graphics->commands[led][lit[led] ? 1 : 0], length);
+            used += length;
+        }
+        drawn++;
+    }
+
+    // The time line from its first changed character (at least the last)
+    char time[8] = {(char)('0' + digits[0]->decimal_value), (char)('0' + digits[1]->decimal_value), ':',
+                    (char)('0' + digits[2]->decimal_value), (char)('0' + digits[3]->decimal_value), ':',
+                    (char)('0' + digits[4]->decimal_value), (char)('0' + digits[5]->decimal_value)};
+    int from = 0;
+    while (!first && from < 7 && time[from] == graphics->time[from]) {
+        from++;
+    }
+    int length = snprintf(output + used, size - used, "\033[2;%dH%.*s", 7 + from, 8 - from, time + from);
+    if (length <= 0 || (size_t)length >= size - used) {
+        return 0;
+    }
+    used += (size_t)length;
+
+    memcpy(graphics->time, time, sizeof(time));
+    memcpy(graphics->lit, lit, sizeof(lit));
+    graphics->placed = true;
+    graphics->stats.ticks++;
+    graphics->stats.leds_drawn += drawn;
+    graphics->stats.bytes += used;
+    return used;
+}
+
+size_t binary_clock_graphics_end(binary_clock_graphics_t* graphics, char* output, size_t size) {
+    if (graphics == NULL || output == NULL) {
+        return 0;
+    }
+    int length = 0;
+    if (graphics->protocol == BINARY_CLOCK_GRAPHICS_KITTY) {
+        // d=I frees the image data along with every placement
+        length = snprintf(output, size, "\033_Ga=d,d=I,i=%u,q=2\033\\\033_Ga=d,d=I,i=%u,q=2\033\\\033[%d;1H",
+                          BINARY_CLOCK_GRAPHICS_IMAGE_ID, BINARY_CLOCK_GRAPHICS_IMAGE_ID + 1,
+                          BINARY_CLOCK_GRAPHICS_TOP_ROW + 3);
+    } else {
+        length = snprintf(output, size, "\033[%d;1H", BINARY_CLOCK_GRAPHICS_TOP_ROW + 3);
+    }
+    graphics->placed = false;
+    return length > 0 && (size_t)length < size ? (size_t)length : 0;
+}
@@ -0,0 +1,1456 @@
+/**
+ * @file binary_clock_h2.c
+ * @brief Binary Clock HTTP/2 Implementation
+ *
+ * HPACK's Huffman code is canonical (codes of one length are consecutive
+ * and ordered by symbol), so decoding needs no tree: bits are shifted in
+ * until the code falls in the range of its length, which gives the
+ * symbol's position in a list sorted by code.
+ *
+ * The server is a single-threaded poll() loop over non-blocking sockets
+ * (POSIX only), like the HTTP/1.1 query server. Each connection has one
+ * input buffer holding at most a whole frame and one output queue. Frames
+ * are only processed while the queue has room for what they may answer,
+ * and tick frames only take up its first half, so a client that stops
+ * reading stops being read and never makes a reply impossible to queue.
+ * Response bodies wait on their stream until both windows admit them.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_h2.h>
+#include <binary_clock_mem.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+#endif
+
+// Largest window either side may reach
+#define H2_MAX_WINDOW 0x7fffffffL
+
+/* ========================================================================== */
+/* FRAMES                                                                     */
+/* ========================================================================== */
+
+binary_clock_h2_frame_t binary_clock_h2_frame_read(const uint8_t* input) {
+    binary_clock_h2_frame_t frame;
+    frame.length = (uint32_t)input[0] << 16 | (uint32_t)input[1] << 8 | input[2];
+    frame.type = input[3];
+    frame.flags = input[4];
+    frame.stream = ((uint32_t)input[5] << 24 | (uint32_t)input[6] << 16 | (uint32_t)input[7] << 8 | input[8]) &
+                   0x7fffffffu;
+    return frame;
+}
+
+size_t binary_clock_h2_frame_write(uint8_t* output, const binary_clock_h2_frame_t* frame) {
+    output[0] = (uint8_t)(frame->length >> 16);
+    output[1] = (uint8_t)(frame->length >> 8);
+    output[2] = (uint8_t)frame->length;
+    output[3] = frame->type;
+    output[4] = frame->flags;
+    output[5] = (uint8_t)(frame->stream >> 24 & 0x7f);
+    output[6] = (uint8_t)(frame->stream >> 16);
+    output[7] = (uint8_t)(frame->stream >> 8);
+    output[8] = (uint8_t)frame->stream;
+    return BINARY_CLOCK_H2_FRAME_HEADER_SIZE;
+}
+
+static uint32_t read_u32(const uint8_t* input) {
+    return (uint32_t)input[0] << 24 | (uint32_t)input[1] << 16 | (uint32_t)input[2] << 8 | input[3];
+}
+
+static void write_u32(uint8_t* output, uint32_t value) {
+    output[0] = (uint8_t)(value >> 24);
+    output[1] = (uint8_t)(value >> 16);
+    output[2] = (uint8_t)(value >> 8);
+    output[3] = (uint8_t)value;
+}
+
+/* ========================================================================== */
+/* HUFFMAN                                                                    */
+/* ========================================================================== */
+
+// Code and length of each symbol; 256 is EOS, which only ever appears as padding
+static const uint32_t huffman_codes[257] = {
+    0x1ff8, 0x7fffd8, 0xfffffe2, 0xfffffe3, 0xfffffe4, 0xfffffe5, 0xfffffe6, 0xfffffe7,
+    0xfffffe8, 0xffffea, 0x3ffffffc, 0xfffffe9, 0xfffffea, 0x3ffffffd, 0xfffffeb, 0xfffffec,
+    0xfffffed, 0xfffffee, 0xfffffef, 0xffffff0, 0xffffff1, 0xffffff2, 0x3ffffffe, 0xffffff3,
+    0xffffff4, 0xffffff5, 0xffffff6, 0xffffff7, 0xffffff8, 0xffffff9, 0xffffffa, 0xffffffb,
+    0x14, 0x3f8, 0x3f9, 0xffa, 0x1ff9, 0x15, 0xf8, 0x7fa,
+    0x3fa, 0x3fb, 0xf9, 0x7fb, 0xfa, 0x16, 0x17, 0x18,
+    0x0, 0x1, 0x2, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x5c, 0xfb, 0x7ffc, 0x20, 0xffb, 0x3fc,
+    0x1ffa, 0x21, 0x5d, 0x5e, 0x5f, 0x60, 0x61, 0x62,
+    0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a,
+    0x6b, 0x6c, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0xfc, 0x73, 0xfd, 0x1ffb, 0x7fff0, 0x1ffc, 0x3ffc, 0x22,
+    0x7ffd, 0x3, 0x23, 0x4, 0x24, 0x5, 0x25, 0x26,
+    0x27, 0x6, 0x74, 0x75, 0x28, 0x29, 0x2a, 0x7,
+    0x2b, 0x76, 0x2c, 0x8, 0x9, 0x2d, 0x77, 0x78,
+    0x79, 0x7a, 0x7b, 0x7ffe, 0x7fc, 0x3ffd, 0x1ffd, 0xffffffc,
+    0xfffe6, 0x3fffd2, 0xfffe7, 0xfffe8, 0x3fffd3, 0x3fffd4, 0x3fffd5, 0x7fffd9,
+    0x3fffd6, 0x7fffda, 0x7fffdb, 0x7fffdc, 0x7fffdd, 0x7fffde, 0xffffeb, 0x7fffdf,
+    0xffffec, 0xffffed, 0x3fffd7, 0x7fffe0, 0xffffee, 0x7fffe1, 0x7fffe2, 0x7fffe3,
+    0x7fffe4, 0x1fffdc, 0x3fffd8, 0x7fffe5, 0x3fffd9, 0x7fffe6, 0x7fffe7, 0xffffef,
+    0x3fffda, 0x1fffdd, 0xfffe9, 0x3fffdb, 0x3fffdc, 0x7fffe8, 0x7fffe9, 0x1fffde,
+    0x7fffea, 0x3fffdd, 0x3fffde, 0xfffff0, 0x1fffdf, 0x3fffdf, 0x7fffeb, 0x7fffec,
+    0x1fffe0, 0x1fffe1, 0x3fffe0, 0x1fffe2, 0x7fffed, 0x3fffe1, 0x7fffee, 0x7fffef,
+    0xfffea, 0x3fffe2, 0x3fffe3, 0x3fffe4, 0x7ffff0, 0x3fffe5, 0x3fffe6, 0x7ffff1,
+    0x3ffffe0, 0x3ffffe1, 0xfffeb, 0x7fff1, 0x3fffe7, 0x7ffff2, 0x3fffe8, 0x1ffffec,
+    0x3ffffe2, 0x3ffffe3, 0x3ffffe4, 0x7ffffde, 0x7ffffdf, 0x3ffffe5, 0xfffff1, 0x1ffffed,
+    0x7fff2, 0x1fffe3, 0x3ffffe6, 0x7ffffe0, 0x7ffffe1, 0x3ffffe7, 0x7ffffe2, 0xfffff2,
+    0x1fffe4, 0x1fffe5, 0x3ffffe8, 0x3ffffe9, 0xffffffd, 0x7ffffe3, 0x7ffffe4, 0x7ffffe5,
+    0xfffec, 0xfffff3, 0xfffed, 0x1fffe6, 0x3fffe9, 0x1fffe7, 0x1fffe8, 0x7ffff3,
+    0x3fffea, 0x3fffeb, 0x1ffffee, 0x1ffffef, 0xfffff4, 0xfffff5, 0x3ffffea, 0x7ffff4,
+    0x3ffffeb, 0x7ffffe6, 0x3ffffec, 0x3ffffed, 0x7ffffe7, 0x7ffffe8, 0x7ffffe9, 0x7ffffea,
+    0x7ffffeb, 0xffffffe, 0x7ffffec, 0x7ffffed, 0x7ffffee, 0x7ffffef, 0x7fffff0, 0x3ffffee,
+    0x3fffffff
+};
+static const uint8_t huffman_lengths[257] = {
+    13, 23, 28, 28, 28, 28, 28, 28, 28, 24, 30, 28, 28, 30, 28, 28,
+    28, 28, 28, 28, 28, 28, 30, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+    6, 10, 10, 12, 13, 6, 8, 11, 10, 10, 8, 11, 8, 6, 6, 6,
+    5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 7, 8, 15, 6, 12, 10,
+    13, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 13, 19, 13, 14, 6,
+    15, 5, 6, 5, 6, 5, 6, 6, 6, 5, 7, 7, 6, 6, 6, 5,
+    6, 7, 6, 5, 5, 6, 7, 7, 7, 7, 7, 15, 11, 14, 13, 28,
+    20, 22, 20, 20, 22, 22, 22, 23, 22, 23, 23, 23, 23, 23, 24, 23,
+    24, 24, 22, 23, 24, 23, 23, 23, 23, 21, 22, 23, 22, 23, 23, 24,
+    22, 21, 20, 22, 22, 23, 23, 21, 23, 22, 22, 24, 21, 22, 23, 23,
+    21, 21, 22, 21, 23, 22, 23, 23, 20, 22, 22, 22, 23, 22, 22, 23,
+    26, 26, 20, 19, 22, 23, 22, 25, 26, 26, 26, 27, 27, 26, 24, 25,
+    19, 21, 26, 27, 27, 26, 27, 24, 21, 21, 26, 26, 28, 27, 27, 27,
+    20, 24, 20, 21, 22, 21, 21, 23, 22, 22, 25, 25, 24, 24, 26, 23,
+    26, 27, 26, 26, 27, 27, 27, 27, 27, 28, 27, 27, 27, 27, 27, 26,
+    30
+};
+
+// Canonical decoding: codes of one length are consecutive, so a code of
+// length L is symbol huffman_symbols[offset[L] + code - first[L]]
+static const uint16_t huffman_symbols[257] = {
+    48, 49, 50, 97, 99, 101, 105, 111, 115, 116, 32, 37, 45, 46, 47, 51,
+    52, 53, 54, 55, 56, 57, 61, 65, 95, 98, 100, 102, 103, 104, 108, 109,
+    110, 112, 114, 117, 58, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76,
+    77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 89, 106, 107, 113, 118,
+    119, 120, 121, 122, 38, 42, 44, 59, 88, 90, 33, 34, 40, 41, 63, 39,
+    43, 124, 35, 62, 0, 36, 64, 91, 93, 126, 94, 125, 60, 96, 123, 92,
+    195, 208, 128, 130, 131, 162, 184, 194, 224, 226, 153, 161, 167, 172, 176, 177,
+    179, 209, 216, 217, 227, 229, 230, 129, 132, 133, 134, 136, 146, 154, 156, 160,
+    163, 164, 169, 170, 173, 178, 181, 185, 186, 187, 189, 190, 196, 198, 228, 232,
+    233, 1, 135, 137, 138, 139, 140, 141, 143, 147, 149, 150, 151, 152, 155, 157,
+    158, 165, 166, 168, 174, 175, 180, 182, 183, 188, 191, 197, 231, 239, 9, 142,
+    144, 145, 148, 159, 171, 206, 215, 225, 236, 237, 199, 207, 234, 235, 192, 193,
+    200, 201, 202, 205, 210, 213, 218, 219, 238, 240, 242, 243, 255, 203, 204, 211,
+    212, 214, 221, 222, 223, 241, 244, 245, 246, 247, 248, 250, 251, 252, 253, 254,
+    2, 3, 4, 5, 6, 7, 8, 11, 12, 14, 15, 16, 17, 18, 19, 20,
+    21, 23, 24, 25, 26, 27, 28, 29, 30, 31, 127, 220, 249, 10, 13, 22,
+    256
+};
+static const uint32_t huffman_first[31] = {
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x14, 0x5c,
+    0xf8, 0x0, 0x3f8, 0x7fa, 0xffa, 0x1ff8, 0x3ffc, 0x7ffc,
+    0x0, 0x0, 0x0, 0x7fff0, 0xfffe6, 0x1fffdc, 0x3fffd2, 0x7fffd8,
+    0xffffea, 0x1ffffec, 0x3ffffe0, 0x7ffffde, 0xfffffe2, 0x0, 0x3ffffffc
+};
+static const uint16_t huffman_count[31] = {
+    0, 0, 0, 0, 0, 10, 26, 32, 6, 0, 5, 3, 2, 6, 2, 3,
+    0, 0, 0, 3, 8, 13, 26, 29, 12, 4, 15, 19, 29, 0, 4
+};
+static const uint16_t huffman_offset[31] = {
+    0, 0, 0, 0, 0, 0, 10, 36, 68, 0, 74, 79, 82, 84, 90, 92,
+    0, 0, 0, 95, 98, 106, 119, 145, 174, 186, 190, 205, 224, 0, 253
+};
+
+size_t binary_clock_h2_huffman_decode(const uint8_t* input, size_t length, char* output, size_t size) {
+    if (input == NULL || output == NULL) {
+        return SIZE_MAX;
+    }
+    size_t written = 0;
+    uint32_t code = 0;
+    int bits = 0;
+    for (size_t i = 0; i < length; i++) {
+        for (int bit = 7; bit >= 0; bit--) {
+            code = code << 1 | (uint32_t)(input[i] >> bit & 1);
+            bits++;
+            if (code - huffman_first[bits] < huffman_count[bits] && code >= huffman_first[bits]) {
+                uint16_t symbol = huffman_symbols[huffman_offset[bits] + code - huffman_first[bits]];
+                if (symbol == 256 || written == size) {
+                    return SIZE_MAX;
+                }
+                output[written++] = (char)symbol;
+                code = 0;
+                bits = 0;
+            } else if (bits == 30) {
+                return SIZE_MAX;
+            }
+        }
+    }
+    // What is left must be a prefix of EOS: at most 7 one bits
+    if (bits > 7 || code != (1u << bits) - 1) {
+        return SIZE_MAX;
+    }
+    return written;
+}
+
+size_t binary_clock_h2_huffman_encode(const char* input, size_t length, uint8_t* output, size_t size) {
+    if (input == NULL || output == NULL) {
+        return 0;
+    }
+    size_t written = 0;
+    uint64_t pending = 0;
+    int bits = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t symbol = (uint8_t)input[i];
+        pending = pending << huffman_lengths[symbol] | huffman_codes[symbol];
+        bits += huffman_lengths[symbol];
+        while (bits >= 8) {
+            if (written == size) {
+                return 0;
+            }
+            bits -= 8;
+            output[written++] = (uint8_t)(pending >> bits);
+        }
+    }
+    if (bits > 0) {
+        // Pad with the most significant bits of EOS, which are all ones
+        if (written == size) {
+            return 0;
+        }
+        output[written++] = (uint8_t)(pending << (8 - bits) | (0xffu >> bits));
+    }
+    return written;
+}
+
+/* ========================================================================== */
+/* HPACK                                                                      */
+/* ========================================================================== */
+
+#define HPACK_STATIC_ENTRIES 61
+#define HPACK_ENTRY_OVERHEAD 32
+
+static const struct { const char* name; const char* value; } static_table[HPACK_STATIC_ENTRIES] = {
+    {":authority", ""},
+    {":method", "GET"},
+    {":method", "POST"},
+    {":path", "/"},
+    {":path", "/index.html"},
+    {":scheme", "http"},
+    {":scheme", "https"},
+    {":status", "200"},
+    {":status", "204"},
+    {":status", "206"},
+    {":status", "304"},
+    {":status", "400"},
+    {":status", "404"},
+    {":status", "500"},
+    {"accept-charset", ""},
+    {"accept-encoding", "gzip, deflate"},
+    {"accept-language", ""},
+    {"accept-ranges", ""},
+    {"accept", ""},
+    {"access-control-allow-origin", ""},
+    {"age", ""},
+    {"allow", ""},
+    {"authorization", ""},
+    {"cache-control", ""},
+    {"content-disposition", ""},
+    {"content-encoding", ""},
+    {"content-language", ""},
+    {"content-length", ""},
+    {"content-location", ""},
+    {"content-range", ""},
+    {"content-type", ""},
+    {"cookie", ""},
+    {"date", ""},
+    {"etag", ""},
+    {"expect", ""},
+    {"expires", ""},
+    {"from", ""},
+    {"host", ""},
+    {"if-match", ""},
+    {"if-modified-since", ""},
+    {"if-none-match", ""},
+    {"if-range", ""},
+    {"if-unmodified-since", ""},
+    {"last-modified", ""},
+    {"link", ""},
+    {"location", ""},
+    {"max-forwards", ""},
+    {"proxy-authenticate", ""},
+    {"proxy-authorization", ""},
+    {"range", ""},
+    {"referer", ""},
+    {"refresh", ""},
+    {"retry-after", ""},
+    {"server", ""},
+    {"set-cookie", ""},
+    {"strict-transport-security", ""},
+    {"transfer-encoding", ""},
+    {"user-agent", ""},
+    {"vary", ""},
+    {"via", ""},
+    {"www-authenticate", ""},
+};
+
+// Decode an integer with an N-bit prefix; returns bytes used, 0 if
+// truncated or larger than 32 bits
+static size_t decode_integer(const uint8_t* input, size_t length, int prefix, uint32_t* value) {
+    if (length == 0) {
+        return 0;
+    }
+    uint32_t limit = (1u << prefix) - 1;
+    uint64_t result = input[0] & limit;
+    if (result < limit) {
+        *value = (uint32_t)result;
+        return 1;
+    }
+    for (size_t i = 1; i < length && i <= 5; i++) {
+        result += (uint64_t)(input[i] & 0x7f) << (7 * (i - 1));
+        if (result > UINT32_MAX) {
+            return 0;
+        }
+        if ((input[i] & 0x80) == 0) {
+            *value = (uint32_t)result;
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static size_t encode_integer(uint8_t* output, size_t size, uint8_t pattern, int prefix, uint32_t value) {
+    uint32_t limit = (1u << prefix) - 1;
+    if (size == 0) {
+        return 0;
+    }
+    if (value < limit) {
+        output[0] = (uint8_t)(pattern | value);
+        return 1;
+    }
+    output[0] = (uint8_t)(pattern | limit);
+    value -= limit;
+    size_t written = 1;
+    while (written < size) {
+        if (value < 0x80) {
+            output[written++] = (uint8_t)value;
+            return written;
+        }
+        output[written++] = (uint8_t)(0x80 | (value & 0x7f));
+        value >>= 7;
+    }
+    return 0;
+}
+
+// Decode a string literal into output; returns bytes used, 0 if malformed
+static size_t decode_string(const uint8_t* input, size_t length, char* output, size_t size, size_t* decoded) {
+    uint32_t string_length = 0;
+    size_t used = decode_integer(input, length, 7, &string_length);
+    if (used == 0 || string_length > length - used) {
+        return 0;
+    }
+    if (input[0] & 0x80) {
+        *decoded = binary_clock_h2_huffman_decode(input + used, string_length, output, size);
+        if (*decoded == SIZE_MAX) {
+            return 0;
+        }
+    } else {
+        if (string_length > size) {
+            return 0;
+        }
+        memcpy(output, input + used, string_length);
+        *decoded = string_length;
+    }
+    return used + string_length;
+}
+
+static size_t encode_string(uint8_t* output, size_t size, const char* value, size_t length, bool huffman) {
+    if (huffman) {
+        uint8_t coded[BINARY_CLOCK_H2_HEADER_FIELD_SIZE];
+        size_t coded_length = binary_clock_h2_huffman_encode(value, length, coded, sizeof(coded));
+        // Huffman only pays off when it is shorter
+        if (coded_length > 0 && coded_length < length) {
+            size_t used = encode_integer(output, size, 0x80, 7, (uint32_t)coded_length);
+            if (used == 0 || coded_length > size - used) {
+                return 0;
+            }
+            memcpy(output + used, coded, coded_length);
+            return used + coded_length;
+        }
+    }
+    size_t used = encode_integer(output, size, 0x00, 7, (uint32_t)length);
+    if (used == 0 || length > size - used) {
+        return 0;
+    }
+    memcpy(output + used, value, length);
+    return used + length;
+}
+
+void binary_clock_h2_hpack_init(binary_clock_h2_hpack_t* table) {
+    if (table == NULL) {
+        return;
+    }
+    table->count = 0;
+    table->size = 0;
+    table->max_size = BINARY_CLOCK_H2_HEADER_TABLE_SIZE;
+}
+
+// Drop the oldest entries until the table size is at most limit
+static void evict(binary_clock_h2_hpack_t* table, uint32_t limit) {
+    uint32_t dropped = 0;
+    size_t dropped_bytes = 0;
+    while (dropped < table->count && table->size > limit) {
+        size_t bytes = (size_t)table->entries[dropped].name_length + table->entries[dropped].value_length;
+        table->size -= (uint32_t)bytes + HPACK_ENTRY_OVERHEAD;
+        dropped_bytes += bytes;
+        dropped++;
+    }
+    if (dropped == 0) {
+        return;
+    }
+    size_t kept_bytes = 0;
+    for (uint32_t i = dropped; i < table->count; i++) {
+        kept_bytes += (size_t)table->entries[i].name_length + table->entries[i].value_length;
+    }
+    memmove(table->data, table->data + dropped_bytes, kept_bytes);
+    table->count -= dropped;
+    for (uint32_t i = 0; i < table->count; i++) {
+        table->entries[i] = table->entries[i + dropped];
+        table->entries[i].offset = (uint16_t)(table->entries[i].offset - dropped_bytes);
+    }
+}
+
+static void insert(binary_clock_h2_hpack_t* table, const char* name, size_t name_length, const char* value,
+                   size_t value_length) {
+    size_t entry_size = name_length + value_length + HPACK_ENTRY_OVERHEAD;
+    if (entry_size > table->max_size) {
+        // Not an error: the table just ends up empty
+        evict(table, 0);
+        return;
+    }
+    evict(table, table->max_size - (uint32_t)entry_size);
+    size_t end = 0;
+    if (table->count > 0) {
+        end = table->entries[table->count - 1].offset + (size_t)table->entries[table->count - 1].name_length +
+              table->entries[table->count - 1].value_length;
+    }
+    memcpy(table->data + end, name, name_length);
+    memcpy(table->data + end + name_length, value, value_length);
+    table->entries[table->count].offset = (uint16_t)end;
+    table->entries[table->count].name_length = (uint16_t)name_length;
+    table->entries[table->count].value_length = (uint16_t)value_length;
+    table->count++;
+    table->size += (uint32_t)entry_size;
+}
+
+// Look up a field by index: the static table, then the dynamic table newest first
+static bool lookup(const binary_clock_h2_hpack_t* table, uint32_t index, const char** name, size_t* name_length,
+                   const char** value, size_t* value_length) {
+    if (index == 0) {
+        return false;
+    }
+    if (index <= HPACK_STATIC_ENTRIES) {
+        *name = static_table[index - 1].name;
+        *name_length = strlen(*name);
+        *value = static_table[index - 1].value;
+        *value_length = strlen(*value);
+        return true;
+    }
+    uint32_t position = index - HPACK_STATIC_ENTRIES - 1;
+    if (position >= table->count) {
+        return false;
+    }
+    uint32_t entry = table->count - 1 - position;
+    *name = table->data + table->entries[entry].offset;
+    *name_length = table->entries[entry].name_length;
+    *value = *name + *name_length;
+    *value_length = table->entries[entry].value_length;
+    return true;
+}
+
+binary_clock_error_t binary_clock_h2_hpack_decode(binary_clock_h2_hpack_t* table, const uint8_t* block,
+                                                  size_t length, binary_clock_h2_header_fn_t header_fn,
+                                                  void* context) {
+    if (table == NULL || (block == NULL && length > 0)) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    char field[BINARY_CLOCK_H2_HEADER_FIELD_SIZE];
+    size_t position = 0;
+    while (position < length) {
+        const uint8_t* input = block + position;
+        size_t left = length - position;
+        uint32_t index = 0;
+        size_t used = 0;
+        const char* name = NULL;
+        const char* value = NULL;
+        size_t name_length = 0;
+        size_t value_length = 0;
+
+        if (input[0] & 0x80) {
+            // Indexed field
+            used = decode_integer(input, left, 7, &index);
+            if (used == 0 || !lookup(table, index, &name, &name_length, &value, &value_length)) {
+                return BINARY_CLOCK_ERROR_OUTPUT;
+            }
+            if (header_fn != NULL) {
+                header_fn(context, name, name_length, value, value_length);
+            }
+            position += used;
+            continue;
+        }
+        if ((input[0] & 0xe0) == 0x20) {
+            // Dynamic table size update
+            used = decode_integer(input, left, 5, &index);
+            if (used == 0 || index > BINARY_CLOCK_H2_HEADER_TABLE_SIZE) {
+                return BINARY_CLOCK_ERROR_OUTPUT;
+            }
+            table->max_size = index;
+            evict(table, index);
+            position += used;
+            continue;
+        }
+
+        // Literal: with incremental indexing (01), without (0000) or never indexed (0001)
+        bool indexing = (input[0] & 0xc0) == 0x40;
+        used = decode_integer(input, left, indexing ? 6 : 4, &index);
+        if (used == 0) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        if (index > 0) {
+            const char* indexed_value = NULL;
+            size_t indexed_value_length = 0;
+            if (!lookup(table, index, &name, &name_length, &indexed_value, &indexed_value_length) ||
+                name_length > sizeof(field)) {
+                return BINARY_CLOCK_ERROR_OUTPUT;
+            }
+            // Copied, as inserting the field may evict the entry named
+            memcpy(field, name, name_length);
+        } else {
+            size_t string_used = decode_string(input + used, left - used, field, sizeof(field), &name_length);
+            if (string_used == 0) {
+                return BINARY_CLOCK_ERROR_OUTPUT;
+            }
+            used += string_used;
+        }
+        size_t string_used = decode_string(input + used, left - used, field + name_length,
+                                           sizeof(field) - name_length, &value_length);
+        if (string_used == 0) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        used += string_used;
+        if (indexing) {
+            insert(table, field, name_length, field + name_length, value_length);
+        }
+        if (header_fn != NULL) {
+            header_fn(context, field, name_length, field + name_length, value_length);
+        }
+        position += used;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+size_t binary_clock_h2_hpack_encode_indexed(uint8_t* output, size_t size, uint32_t index) {
+    if (output == NULL || index == 0) {
+        return 0;
+    }
+    return encode_integer(output, size, 0x80, 7, index);
+}
+
+size_t binary_clock_h2_hpack_encode_literal(uint8_t* output, size_t size, uint32_t name_index, const char* name,
+                                            const char* value, size_t value_length, bool huffman) {
+    if (output == NULL || value == NULL || (name_index == 0 && name == NULL)) {
+        return 0;
+    }
+    size_t written = encode_integer(output, size, 0x00, 4, name_index);
+    if (written == 0) {
+        return 0;
+    }
+    if (name_index == 0) {
+        size_t used = encode_string(output + written, size - written, name, strlen(name), huffman);
+        if (used == 0) {
+            return 0;
+        }
+        written += used;
+    }
+    size_t used = encode_string(output + written, size - written, value, value_length, huffman);
+    return used > 0 ? written + used : 0;
+}
+
+/* ========================================================================== */
+/* SERVER                                                                     */
+/* ========================================================================== */
+
+size_t binary_clock_h2_report(const binary_clock_h2_server_t* server, char* buffer, size_t size) {
+    if (server == NULL || buffer == NULL || size == 0) {
+        return 0;
+    }
+    const binary_clock_h2_stats_t* stats = &server->stats;
+    int length = snprintf(buffer, size,
+                          "%llu connections, %llu streams (%llu refused), %llu ticks sent, %llu dropped, "
+                          "%llu payloads rendered, %llu protocol errors",
+                          (unsigned long long)stats->connections, (unsigned long long)stats->streams,
+                          (unsigned long long)stats->refused_streams, (unsigned long long)stats->ticks,
+                          (unsigned long long)stats->ticks_dropped, (unsigned long long)stats->payloads_rendered,
+                          (unsigned long long)stats->protocol_errors);
+    if (length < 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return (size_t)length < size ? (size_t)length : size - 1;
+}
+
+#ifdef _WIN32
+
+binary_clock_error_t binary_clock_h2_server_open(binary_clock_h2_server_t* server, binary_clock_query_t* query,
+                                                 const char* address, uint16_t port) {
+    (void)address; (void)port;
+    if (server == NULL || query == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->query = query;
+    return BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_h2_server_poll(binary_clock_h2_server_t* server, int timeout_ms) {
+    (void)timeout_ms;
+    return server == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_h2_server_tick(binary_clock_h2_server_t* server, int64_t epoch) {
+    (void)epoch;
+    return server == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_h2_server_close(binary_clock_h2_server_t* server) {
+    (void)server;
+}
+
+#else
+
+#ifdef MSG_NOSIGNAL
+    #define H2_SEND_FLAGS MSG_NOSIGNAL
+#else
+    #define H2_SEND_FLAGS 0  // SO_NOSIGPIPE is set per socket instead
+#endif
+
+// New connections taken per poll
+#define H2_ACCEPT_BATCH 64
+
+// Output room a frame needs before it is processed: enough for everything
+// one frame can answer (a HEADERS response, a reset, an ack)
+#define H2_CONTROL_ROOM 1024
+
+// Tick frames are queued only while the output is less than half full
+#define H2_TICK_ROOM (BINARY_CLOCK_H2_OUTPUT_SIZE / 2)
+
+static const char method_not_allowed_body[] = "method not allowed\n";
+static const char bad_ticks_body[] = "bad ticks query: expected /ticks[?tz=ZONE][&fmt=json|ndjson|emoji|binary]\n";
+static const char unknown_zone_body[] = "unknown zone\n";
+static const char zone_table_full_body[] = "zone table full\n";
+static const char text_type[] = "text/plain; charset=utf-8";
+
+// Header fields of a request that matter here
+typedef struct {
+    bool get;                   /**< :method is GET */
+    bool has_method;
+    size_t path_length;         /**< 0 without a :path */
+    char path[BINARY_CLOCK_QUERY_REQUEST_MAX_SIZE];
+} request_fields_t;
+
+static void collect_field(void* context, const char* name, size_t name_length, const char* value,
+                          size_t value_length) {
+    request_fields_t* fields = context;
+    if (name_length == 7 && memcmp(name, ":method", 7) == 0) {
+        fields->has_method = true;
+        fields->get = value_length == 3 && memcmp(value, "GET", 3) == 0;
+    } else if (name_length == 5 && memcmp(name, ":path", 5) == 0 && value_length > 0 &&
+               value_length <= sizeof(fields->path)) {
+        memcpy(fields->path, value, value_length);
+        fields->path_length = value_length;
+    }
+}
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+static size_t output_room(const binary_clock_h2_connection_t* connection) {
+    return sizeof(connection->output) - connection->queued;
+}
+
+static bool queue_frame(binary_clock_h2_connection_t* connection, uint8_t type, uint8_t flags, uint32_t stream,
+                        const void* payload, size_t length) {
+    if (output_room(connection) < BINARY_CLOCK_H2_FRAME_HEADER_SIZE + length) {
+        return false;
+    }
+    binary_clock_h2_frame_t frame = {(uint32_t)length, type, flags, stream};
+    uint8_t* output = connection->output + connection->queued;
+    binary_clock_h2_frame_write(output, &frame);
+    if (length > 0) {
+        memcpy(output + BINARY_CLOCK_H2_FRAME_HEADER_SIZE, payload, length);
+    }
+    connection->queued += BINARY_CLOCK_H2_FRAME_HEADER_SIZE + length;
+    return true;
+}
+
+// Write what is queued; -1 once the socket has failed
+static int flush(binary_clock_h2_connection_t* connection) {
+    while (connection->sent < connection->queued) {
+        ssize_t sent = send(connection->fd, connection->output + connection->sent,
+                            connection->queued - connection->sent, H2_SEND_FLAGS);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            return -1;
+        }
+        connection->sent += (size_t)sent;
+    }
+    if (connection->sent > 0) {
+        memmove(connection->output, connection->output + connection->sent, connection->queued - connection->sent);
+        connection->queued -= connection->sent;
+        connection->sent = 0;
+    }
+    return 0;
+}
+
+// End the connection: GOAWAY naming the last stream processed, then close once written
+static void connection_error(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                             binary_clock_h2_error_code_t code) {
+    uint8_t payload[8];
+    write_u32(payload, connection->last_stream);
+    write_u32(payload + 4, (uint32_t)code);
+    queue_frame(connection, BINARY_CLOCK_H2_GOAWAY, 0, 0, payload, sizeof(payload));
+    connection->closing = true;
+    if (code != BINARY_CLOCK_H2_NO_ERROR) {
+        server->stats.protocol_errors++;
+    }
+}
+
+static void reset_stream(binary_clock_h2_connection_t* connection, uint32_t stream,
+                         binary_clock_h2_error_code_t code) {
+    uint8_t payload[4];
+    write_u32(payload, (uint32_t)code);
+    queue_frame(connection, BINARY_CLOCK_H2_RST_STREAM, 0, stream, payload, sizeof(payload));
+}
+
+static binary_clock_h2_stream_t* find_stream(binary_clock_h2_connection_t* connection, uint32_t id) {
+    for (uint32_t i = 0; i < BINARY_CLOCK_H2_MAX_STREAMS; i++) {
+        if (connection->streams[i].state != BINARY_CLOCK_H2_STREAM_FREE && connection->streams[i].id == id) {
+            return &connection->streams[i];
+        }
+    }
+    return NULL;
+}
+
+static void free_stream(binary_clock_h2_connection_t* connection, binary_clock_h2_stream_t* stream) {
+    stream->state = BINARY_CLOCK_H2_STREAM_FREE;
+    stream->id = 0;
+    connection->stream_count--;
+}
+
+// Queue a response's HEADERS frame; the body is held on the stream. An
+// empty body ends the stream with the headers.
+static void respond(binary_clock_h2_connection_t* connection, binary_clock_h2_stream_t* stream, int status,
+                    const char* type, size_t type_length, const char* body, size_t body_length, bool ticking) {
+    uint8_t block[256];
+    size_t length = 0;
+    // :status 200, 400 and 404 are in the static table
+    uint32_t index = status == 200 ? 8 : status == 400 ? 12 : status == 404 ? 13 : 0;
+    if (index > 0) {
+        length += binary_clock_h2_hpack_encode_indexed(block, sizeof(block), index);
+    } else {
+        char code[8];
+        snprintf(code, sizeof(code), "%03u", (unsigned)status % 1000u);
+        length += binary_clock_h2_hpack_encode_literal(block, sizeof(block), 8, NULL, code, 3, false);
+    }
+    // content-type (31) and content-length (28) names from the static table
+    length += binary_clock_h2_hpack_encode_literal(block + length, sizeof(block) - length, 31, NULL, type,
+                                                   type_length, true);
+    if (!ticking) {
+        char digits[16];
+        int digit_count = snprintf(digits, sizeof(digits), "%lu", (unsigned long)body_length);
+        length += binary_clock_h2_hpack_encode_literal(block + length, sizeof(block) - length, 28, NULL, digits,
+                                                       (size_t)digit_count, true);
+    }
+    bool ends = !ticking && body_length == 0;
+    queue_frame(connection, BINARY_CLOCK_H2_HEADERS,
+                (uint8_t)(BINARY_CLOCK_H2_FLAG_END_HEADERS | (ends ? BINARY_CLOCK_H2_FLAG_END_STREAM : 0)),
+                stream->id, block, length);
+    if (ends) {
+        free_stream(connection, stream);
+        return;
+    }
+    if (ticking) {
+        stream->state = BINARY_CLOCK_H2_STREAM_TICKING;
+        return;
+    }
+    stream->state = BINARY_CLOCK_H2_STREAM_RESPONDING;
+    memcpy(stream->body, body, body_length);
+    stream->body_length = (uint16_t)body_length;
+    stream->body_sent = 0;
+}
+
+// Send the HTTP/1.1 answer of the responder as HEADERS and a body
+static void respond_query(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                          binary_clock_h2_stream_t* stream, const char* path, size_t path_length) {
+    char response[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE];
+    size_t length = binary_clock_query_respond(server->query, path, path_length, response, sizeof(response));
+    const char* head_end = NULL;
+    for (size_t i = 0; i + 4 <= length && head_end == NULL; i++) {
+        if (memcmp(response + i, "\r\n\r\n", 4) == 0) {
+            head_end = response + i;
+        }
+    }
+    if (length < 12 || head_end == NULL) {
+        reset_stream(connection, stream->id, BINARY_CLOCK_H2_INTERNAL_ERROR);
+        free_stream(connection, stream);
+        return;
+    }
+    int status = atoi(response + 9);
+    const char* type = text_type;
+    size_t type_length = sizeof(text_type) - 1;
+    const char* field = strstr(response, "Content-Type: ");
+    if (field != NULL && field < head_end) {
+        type = field + 14;
+        type_length = strcspn(type, "\r");
+    }
+    const char* body = head_end + 4;
+    respond(connection, stream, status, type, type_length, body, (size_t)(response + length - body), false);
+}
+
+// Start a /ticks stream: its zone and format are parsed as /at parameters
+static void start_ticks(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                        binary_clock_h2_stream_t* stream, const char* path, size_t path_length) {
+    char target[BINARY_CLOCK_QUERY_REQUEST_MAX_SIZE + 16];
+    const char* parameters = memchr(path, '?', path_length);
+    size_t parameters_length = parameters != NULL ? path_length - (size_t)(parameters + 1 - path) : 0;
+    int length = snprintf(target, sizeof(target), "/at?t=0&%.*s", (int)parameters_length,
+                          parameters != NULL ? parameters + 1 : "");
+    binary_clock_query_request_t request;
+    size_t zone = 0;
+    if (length < 0 || (size_t)length >= sizeof(target) ||
+        binary_clock_query_parse(target, (size_t)length, &request) != BINARY_CLOCK_SUCCESS) {
+        respond(connection, stream, 400, text_type, sizeof(text_type) - 1, bad_ticks_body,
+                sizeof(bad_ticks_body) - 1, false);
+        return;
+    }
+    int zone_status = binary_clock_query_resolve_zone(server->query, request.zone, &zone);
+    if (zone_status == 503) {
+        server->query->stats.unavailable++;
+        respond(connection, stream, 503, text_type, sizeof(text_type) - 1, zone_table_full_body,
+                sizeof(zone_table_full_body) - 1, false);
+        return;
+    }
+    if (zone_status != 200) {
+        server->query->stats.not_found++;
+        respond(connection, stream, 404, text_type, sizeof(text_type) - 1, unknown_zone_body,
+                sizeof(unknown_zone_body) - 1, false);
+        return;
+    }
+    stream->zone = (uint16_t)zone;
+    stream->format = (uint16_t)request.format;
+    const char* type = binary_clock_query_content_type(request.format);
+    respond(connection, stream, 200, type, strlen(type), NULL, 0, true);
+}
+
+// A request's header block is complete: decode it and answer
+static void open_stream(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection, uint32_t id,
+                        const uint8_t* block, size_t length) {
+    request_fields_t fields;
+    fields.get = false;
+    fields.has_method = false;
+    fields.path_length = 0;
+    if (binary_clock_h2_hpack_decode(&connection->decoder, block, length, collect_field, &fields) !=
+        BINARY_CLOCK_SUCCESS) {
+        connection_error(server, connection, BINARY_CLOCK_H2_COMPRESSION_ERROR);
+        return;
+    }
+    if (connection->stream_count == BINARY_CLOCK_H2_MAX_STREAMS) {
+        server->stats.refused_streams++;
+        reset_stream(connection, id, BINARY_CLOCK_H2_REFUSED_STREAM);
+        return;
+    }
+    if (!fields.has_method || fields.path_length == 0) {
+        reset_stream(connection, id, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        return;
+    }
+
+    binary_clock_h2_stream_t* stream = &connection->streams[0];
+    while (stream->state != BINARY_CLOCK_H2_STREAM_FREE) {
+        stream++;
+    }
+    stream->id = id;
+    stream->state = BINARY_CLOCK_H2_STREAM_RESPONDING;
+    stream->window = connection->initial_window;
+    connection->stream_count++;
+    server->stats.streams++;
+
+    const char* path = fields.path;
+    size_t path_length = fields.path_length;
+    if (!fields.get) {
+        respond(connection, stream, 405, text_type, sizeof(text_type) - 1, method_not_allowed_body,
+                sizeof(method_not_allowed_body) - 1, false);
+    } else if (path_length >= 6 && memcmp(path, "/ticks", 6) == 0 && (path_length == 6 || path[6] == '?')) {
+        start_ticks(server, connection, stream, path, path_length);
+    } else {
+        respond_query(server, connection, stream, path, path_length);
+    }
+}
+
+// Add to a window; false if it would pass 2^31 - 1
+static bool grow_window(int32_t* window, int64_t increment) {
+    int64_t grown = (int64_t)*window + increment;
+    if (grown > H2_MAX_WINDOW) {
+        return false;
+    }
+    *window = (int32_t)grown;
+    return true;
+}
+
+static void apply_settings(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                           const uint8_t* payload, size_t length) {
+    for (size_t i = 0; i + 6 <= length; i += 6) {
+        uint16_t id = (uint16_t)(payload[i] << 8 | payload[i + 1]);
+        uint32_t value = read_u32(payload + i + 2);
+        if (id == BINARY_CLOCK_H2_SETTINGS_INITIAL_WINDOW_SIZE) {
+            if (value > H2_MAX_WINDOW) {
+                connection_error(server, connection, BINARY_CLOCK_H2_FLOW_CONTROL_ERROR);
+                return;
+            }
+            // Every open stream's window moves by the change
+            int64_t delta = (int64_t)value - connection->initial_window;
+            for (uint32_t s = 0; s < BINARY_CLOCK_H2_MAX_STREAMS; s++) {
+                if (connection->streams[s].state != BINARY_CLOCK_H2_STREAM_FREE &&
+                    !grow_window(&connection->streams[s].window, delta)) {
+                    connection_error(server, connection, BINARY_CLOCK_H2_FLOW_CONTROL_ERROR);
+                    return;
+                }
+            }
+            connection->initial_window = (int32_t)value;
+        } else if ((id == BINARY_CLOCK_H2_SETTINGS_ENABLE_PUSH && value > 1) ||
+                   (id == BINARY_CLOCK_H2_SETTINGS_MAX_FRAME_SIZE &&
+                    (value < BINARY_CLOCK_H2_MAX_FRAME_SIZE || value > 0xffffff))) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+            return;
+        }
+        // The header table size only limits an encoder's dynamic table, and
+        // responses are encoded without one
+    }
+    queue_frame(connection, BINARY_CLOCK_H2_SETTINGS, BINARY_CLOCK_H2_FLAG_ACK, 0, NULL, 0);
+}
+
+static void window_update(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                          const binary_clock_h2_frame_t* frame, const uint8_t* payload) {
+    uint32_t increment = read_u32(payload) & 0x7fffffffu;
+    if (frame->stream == 0) {
+        if (increment == 0 || !grow_window(&connection->window, increment)) {
+            connection_error(server, connection,
+                             increment == 0 ? BINARY_CLOCK_H2_PROTOCOL_ERROR : BINARY_CLOCK_H2_FLOW_CONTROL_ERROR);
+        }
+        return;
+    }
+    binary_clock_h2_stream_t* stream = find_stream(connection, frame->stream);
+    if (stream == NULL) {
+        return;
+    }
+    if (increment == 0 || !grow_window(&stream->window, increment)) {
+        reset_stream(connection, stream->id,
+                     increment == 0 ? BINARY_CLOCK_H2_PROTOCOL_ERROR : BINARY_CLOCK_H2_FLOW_CONTROL_ERROR);
+        free_stream(connection, stream);
+    }
+}
+
+// Collect a header block fragment; decode and answer once it is complete
+static void header_fragment(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                            uint32_t stream, uint8_t flags, const uint8_t* fragment, size_t length) {
+    if (length > sizeof(connection->header_block) - connection->header_length) {
+        connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        return;
+    }
+    memcpy(connection->header_block + connection->header_length, fragment, length);
+    connection->header_length += length;
+    if ((flags & BINARY_CLOCK_H2_FLAG_END_HEADERS) == 0) {
+        connection->header_stream = stream;
+        return;
+    }
+    connection->header_stream = 0;
+    open_stream(server, connection, stream, connection->header_block, connection->header_length);
+    connection->header_length = 0;
+}
+
+static void process_frame(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection,
+                          const binary_clock_h2_frame_t* frame, const uint8_t* payload) {
+    // A header block in progress admits nothing but its CONTINUATION frames
+    if (connection->header_stream != 0 &&
+        (frame->type != BINARY_CLOCK_H2_CONTINUATION || frame->stream != connection->header_stream)) {
+        connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        return;
+    }
+    bool on_connection = frame->stream == 0;
+    switch (frame->type) {
+    case BINARY_CLOCK_H2_DATA:
+        if (on_connection) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else if (frame->length > 0) {
+            // Request bodies are ignored, but their bytes are given back
+            uint8_t increment[4];
+            write_u32(increment, frame->length);
+            queue_frame(connection, BINARY_CLOCK_H2_WINDOW_UPDATE, 0, 0, increment, sizeof(increment));
+        }
+        break;
+    case BINARY_CLOCK_H2_HEADERS: {
+        // Clients open odd streams in increasing order, and send no trailers here
+        if (on_connection || (frame->stream & 1) == 0 || frame->stream <= connection->last_stream) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+            break;
+        }
+        connection->last_stream = frame->stream;
+        size_t start = 0;
+        size_t padding = 0;
+        if (frame->flags & BINARY_CLOCK_H2_FLAG_PADDED) {
+            padding = frame->length > 0 ? payload[0] : 0;
+            start = 1;
+        }
+        if (frame->flags & BINARY_CLOCK_H2_FLAG_PRIORITY) {
+            start += 5;
+        }
+        if (start + padding > frame->length) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+            break;
+        }
+        header_fragment(server, connection, frame->stream, frame->flags, payload + start,
+                        frame->length - start - padding);
+        break;
+    }
+    case BINARY_CLOCK_H2_CONTINUATION:
+        if (connection->header_stream == 0) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else {
+            header_fragment(server, connection, frame->stream, frame->flags, payload, frame->length);
+        }
+        break;
+    case BINARY_CLOCK_H2_PRIORITY:
+        if (on_connection) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else if (frame->length != 5) {
+            reset_stream(connection, frame->stream, BINARY_CLOCK_H2_FRAME_SIZE_ERROR);
+        }
+        break;
+    case BINARY_CLOCK_H2_RST_STREAM:
+        if (on_connection) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else if (frame->length != 4) {
+            connection_error(server, connection, BINARY_CLOCK_H2_FRAME_SIZE_ERROR);
+        } else {
+            binary_clock_h2_stream_t* stream = find_stream(connection, frame->stream);
+            if (stream != NULL) {
+                free_stream(connection, stream);
+            }
+        }
+        break;
+    case BINARY_CLOCK_H2_SETTINGS:
+        if (!on_connection) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else if ((frame->flags & BINARY_CLOCK_H2_FLAG_ACK) ? frame->length != 0 : frame->length % 6 != 0) {
+            connection_error(server, connection, BINARY_CLOCK_H2_FRAME_SIZE_ERROR);
+        } else if ((frame->flags & BINARY_CLOCK_H2_FLAG_ACK) == 0) {
+            apply_settings(server, connection, payload, frame->length);
+        }
+        break;
+    case BINARY_CLOCK_H2_PUSH_PROMISE:
+        connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        break;
+    case BINARY_CLOCK_H2_PING:
+        if (!on_connection) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else if (frame->length != 8) {
+            connection_error(server, connection, BINARY_CLOCK_H2_FRAME_SIZE_ERROR);
+        } else if ((frame->flags & BINARY_CLOCK_H2_FLAG_ACK) == 0) {
+            queue_frame(connection, BINARY_CLOCK_H2_PING, BINARY_CLOCK_H2_FLAG_ACK, 0, payload, 8);
+        }
+        break;
+    case BINARY_CLOCK_H2_GOAWAY:
+        if (!on_connection) {
+            connection_error(server, connection, BINARY_CLOCK_H2_PROTOCOL_ERROR);
+        } else {
+            connection->closing = true;
+        }
+        break;
+    case BINARY_CLOCK_H2_WINDOW_UPDATE:
+        if (frame->length != 4) {
+            connection_error(server, connection, BINARY_CLOCK_H2_FRAME_SIZE_ERROR);
+        } else {
+            window_update(server, connection, frame, payload);
+        }
+        break;
+    default:
+        // Unknown frame types are ignored
+        break;
+    }
+}
+
+// Process the whole frames buffered, while the output has room for what
+// they answer; -1 for a client that is not speaking HTTP/2
+static int process_input(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection) {
+    size_t position = 0;
+    if (!connection->preface) {
+        if (connection->received < BINARY_CLOCK_H2_PREFACE_SIZE) {
+            return memcmp(connection->input, BINARY_CLOCK_H2_PREFACE, connection->received) == 0 ? 0 : -1;
+        }
+        if (memcmp(connection->input, BINARY_CLOCK_H2_PREFACE, BINARY_CLOCK_H2_PREFACE_SIZE) != 0) {
+            return -1;
+        }
+        connection->preface = true;
+        position = BINARY_CLOCK_H2_PREFACE_SIZE;
+    }
+    while (!connection->closing && output_room(connection) >= H2_CONTROL_ROOM &&
+           connection->received - position >= BINARY_CLOCK_H2_FRAME_HEADER_SIZE) {
+        binary_clock_h2_frame_t frame = binary_clock_h2_frame_read(connection->input + position);
+        if (frame.length > BINARY_CLOCK_H2_MAX_FRAME_SIZE) {
+            connection_error(server, connection, BINARY_CLOCK_H2_FRAME_SIZE_ERROR);
+            break;
+        }
+        if (connection->received - position < BINARY_CLOCK_H2_FRAME_HEADER_SIZE + frame.length) {
+            break;
+        }
+        process_frame(server, connection, &frame, connection->input + position + BINARY_CLOCK_H2_FRAME_HEADER_SIZE);
+        position += BINARY_CLOCK_H2_FRAME_HEADER_SIZE + frame.length;
+    }
+    memmove(connection->input, connection->input + position, connection->received - position);
+    connection->received -= position;
+    return 0;
+}
+
+// Send response bodies as far as both windows and the output allow
+static void send_bodies(binary_clock_h2_connection_t* connection) {
+    for (uint32_t i = 0; i < BINARY_CLOCK_H2_MAX_STREAMS && connection->window > 0; i++) {
+        binary_clock_h2_stream_t* stream = &connection->streams[i];
+        if (stream->state != BINARY_CLOCK_H2_STREAM_RESPONDING || stream->window <= 0) {
+            continue;
+        }
+        size_t room = output_room(connection);
+        if (room <= BINARY_CLOCK_H2_FRAME_HEADER_SIZE) {
+            return;
+        }
+        size_t chunk = (size_t)(stream->body_length - stream->body_sent);
+        if (chunk > (size_t)stream->window) {
+            chunk = (size_t)stream->window;
+        }
+        if (chunk > (size_t)connection->window) {
+            chunk = (size_t)connection->window;
+        }
+        if (chunk > room - BINARY_CLOCK_H2_FRAME_HEADER_SIZE) {
+            chunk = room - BINARY_CLOCK_H2_FRAME_HEADER_SIZE;
+        }
+        bool last = stream->body_sent + chunk == stream->body_length;
+        queue_frame(connection, BINARY_CLOCK_H2_DATA, last ? BINARY_CLOCK_H2_FLAG_END_STREAM : 0, stream->id,
+                    stream->body + stream->body_sent, chunk);
+        stream->body_sent = (uint16_t)(stream->body_sent + chunk);
+        stream->window -= (int32_t)chunk;
+        connection->window -= (int32_t)chunk;
+        if (last) {
+            free_stream(connection, stream);
+        }
+    }
+}
+
+// Read what arrived, answer it and write what is due; -1 once the connection is done
+static int service(binary_clock_h2_server_t* server, binary_clock_h2_connection_t* connection) {
+    for (;;) {
+        if (process_input(server, connection) != 0) {
+            return -1;
+        }
+        send_bodies(connection);
+        if (flush(connection) != 0) {
+            return -1;
+        }
+        if (connection->closing) {
+            return connection->queued == 0 ? -1 : 0;
+        }
+        size_t room = sizeof(connection->input) - connection->received;
+        if (room == 0 || output_room(connection) < H2_CONTROL_ROOM) {
+            return 0;
+        }
+        ssize_t got = recv(connection->fd, connection->input + connection->received, room, 0);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        if (got == 0) {
+            return -1;
+        }
+        connection->received += (size_t)got;
+    }
+}
+
+static void close_connection(binary_clock_h2_connection_t* connection) {
+    close(connection->fd);
+    free(connection);
+    binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, sizeof(*connection));
+}
+
+// Connection pointers plus the poll set, with one extra poll slot for the listening socket
+static size_t slot_bytes(size_t capacity) {
+    return capacity > 0 ? capacity * sizeof(binary_clock_h2_connection_t*) + (capacity + 1) * sizeof(struct pollfd)
+                        : 0;
+}
+
+static int grow_connections(binary_clock_h2_server_t* server) {
+    size_t capacity = server->connection_capacity > 0 ? server->connection_capacity * 2 : 16;
+    size_t held = slot_bytes(server->connection_capacity);
+    binary_clock_h2_connection_t** connections = realloc(server->connections, capacity * sizeof(*connections));
+    if (connections == NULL) {
+        return -1;
+    }
+    server->connections = connections;
+    struct pollfd* poll_set = realloc(server->poll_set, (capacity + 1) * sizeof(*poll_set));
+    if (poll_set == NULL) {
+        return -1;
+    }
+    server->poll_set = poll_set;
+    server->connection_capacity = capacity;
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, slot_bytes(capacity) - held);
+    return 0;
+}
+
+static void accept_connections(binary_clock_h2_server_t* server) {
+    // The server's settings: only the stream limit differs from the defaults
+    uint8_t settings[6] = {0, BINARY_CLOCK_H2_SETTINGS_MAX_CONCURRENT_STREAMS, 0, 0, 0, BINARY_CLOCK_H2_MAX_STREAMS};
+    for (int taken = 0; taken < H2_ACCEPT_BATCH; taken++) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        binary_clock_h2_connection_t* connection = NULL;
+        if (set_nonblocking(fd) != 0 ||
+            (server->connection_count == server->connection_capacity && grow_connections(server) != 0) ||
+            (connection = malloc(sizeof(*connection))) == NULL) {
+            close(fd);
+            continue;
+        }
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, sizeof(*connection));
+        connection->fd = fd;
+        connection->preface = false;
+        connection->closing = false;
+        connection->window = BINARY_CLOCK_H2_INITIAL_WINDOW;
+        connection->initial_window = BINARY_CLOCK_H2_INITIAL_WINDOW;
+        connection->last_stream = 0;
+        connection->header_stream = 0;
+        connection->header_length = 0;
+        connection->received = 0;
+        connection->queued = 0;
+        connection->sent = 0;
+        connection->stream_count = 0;
+        for (uint32_t i = 0; i < BINARY_CLOCK_H2_MAX_STREAMS; i++) {
+            connection->streams[i].state = BINARY_CLOCK_H2_STREAM_FREE;
+            connection->streams[i].id = 0;
+        }
+        binary_clock_h2_hpack_init(&connection->decoder);
+        queue_frame(connection, BINARY_CLOCK_H2_SETTINGS, 0, 0, settings, sizeof(settings));
+        server->connections[server->connection_count++] = connection;
+        server->stats.connections++;
+    }
+}
+
+binary_clock_error_t binary_clock_h2_server_open(binary_clock_h2_server_t* server, binary_clock_query_t* query,
+                                                 const char* address, uint16_t port) {
+    if (server == NULL || query == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->query = query;
+
+    struct sockaddr_in local = {0};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (address != NULL && inet_pton(AF_INET, address, &local.sin_addr) != 1) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+    int reuse = 1;
+    socklen_t bound_length = sizeof(local);
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(fd, (const struct sockaddr*)&local, sizeof(local)) != 0 ||
+        listen(fd, SOMAXCONN) != 0 || set_nonblocking(fd) != 0 ||
+        getsockname(fd, (struct sockaddr*)&local, &bound_length) != 0 ||
+        grow_connections(server) != 0) {
+        close(fd);
+        binary_clock_h2_server_close(server);
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+    server->listen_fd = fd;
+    server->port = ntohs(local.sin_port);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_h2_server_poll(binary_clock_h2_server_t* server, int timeout_ms) {
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (server->listen_fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    struct pollfd* poll_set = server->poll_set;
+    size_t count = server->connection_count;
+    poll_set[0].fd = server->listen_fd;
+    poll_set[0].events = POLLIN;
+    for (size_t i = 0; i < count; i++) {
+        const binary_clock_h2_connection_t* connection = server->connections[i];
+        bool reading = !connection->closing && connection->received < sizeof(connection->input) &&
+                       output_room(connection) >= H2_CONTROL_ROOM;
+        poll_set[i + 1].fd = connection->fd;
+        poll_set[i + 1].events = (short)((reading ? POLLIN : 0) | (connection->queued > 0 ? POLLOUT : 0));
+    }
+
+    int ready = poll(poll_set, (nfds_t)(count + 1), timeout_ms);
+    if (ready < 0) {
+        return errno == EINTR ? BINARY_CLOCK_ERROR_TIMEOUT : BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    // Connections first, keeping the open ones in order: accepting may
+    // reallocate the poll set. One that a tick found dead, or that has
+    // written its GOAWAY, goes even without activity.
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        binary_clock_h2_connection_t* connection = server->connections[i];
+        short revents = poll_set[i + 1].revents;
+        bool done = (revents & (POLLERR | POLLNVAL)) != 0 ||
+                    ((revents != 0 || connection->closing) && service(server, connection) != 0);
+        if (done) {
+            close_connection(connection);
+        } else {
+            server->connections[kept++] = connection;
+        }
+    }
+    server->connection_count = kept;
+    if (ready > 0 && (poll_set[0].revents & POLLIN)) {
+        accept_connections(server);
+    }
+    return ready == 0 ? BINARY_CLOCK_ERROR_TIMEOUT : BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_h2_server_tick(binary_clock_h2_server_t* server, int64_t epoch) {
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    struct {
+        uint16_t zone;
+        uint16_t format;
+        size_t length;
+        char data[BINARY_CLOCK_RENDER_MAX_SIZE];
+    } payloads[BINARY_CLOCK_H2_TICK_PAYLOADS];
+    size_t payload_count = 0;
+    char scratch[BINARY_CLOCK_RENDER_MAX_SIZE];
+    binary_clock_query_t* query = server->query;
+
+    for (size_t c = 0; c < server->connection_count; c++) {
+        binary_clock_h2_connection_t* connection = server->connections[c];
+        if (connection->closing) {
+            continue;
+        }
+        for (uint32_t s = 0; s < BINARY_CLOCK_H2_MAX_STREAMS; s++) {
+            binary_clock_h2_stream_t* stream = &connection->streams[s];
+            if (stream->state != BINARY_CLOCK_H2_STREAM_TICKING) {
+                continue;
+            }
+            // Render each (zone, format) once; past the table, once per stream
+            size_t p = 0;
+            while (p < payload_count && (payloads[p].zone != stream->zone || payloads[p].format != stream->format)) {
+                p++;
+            }
+            const char* data = NULL;
+            size_t length = 0;
+            if (p < payload_count) {
+                data = payloads[p].data;
+                length = payloads[p].length;
+            } else {
+                binary_clock_state_t state =
+                    binary_clock_state_from_epoch(epoch, binary_clock_zone_offset(&query->zones[stream->zone], epoch));
+                char* target = payload_count < BINARY_CLOCK_H2_TICK_PAYLOADS ? payloads[payload_count].data : scratch;
+                length = query->render(&state, (binary_clock_render_format_t)stream->format, target,
+                                       BINARY_CLOCK_RENDER_MAX_SIZE);
+                data = target;
+                server->stats.payloads_rendered++;
+                if (target != scratch) {
+                    payloads[payload_count].zone = stream->zone;
+                    payloads[payload_count].format = stream->format;
+                    payloads[payload_count].length = length;
+                    payload_count++;
+                }
+            }
+            if (length == 0) {
+                continue;
+            }
+            // Hand what is queued to the socket before judging the room left
+            if (connection->queued + BINARY_CLOCK_H2_FRAME_HEADER_SIZE + length > H2_TICK_ROOM &&
+                flush(connection) != 0) {
+                break;
+            }
+            if ((size_t)stream->window < length || (size_t)connection->window < length ||
+                connection->queued + BINARY_CLOCK_H2_FRAME_HEADER_SIZE + length > H2_TICK_ROOM) {
+                server->stats.ticks_dropped++;
+                continue;
+            }
+            queue_frame(connection, BINARY_CLOCK_H2_DATA, 0, stream->id, data, length);
+            stream->window -= (int32_t)length;
+            connection->window -= (int32_t)length;
+            server->stats.ticks++;
+        }
+        if (flush(connection) != 0) {
+            // Closed by the next poll
+            connection->closing = true;
+            connection->queued = 0;
+        }
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_h2_server_close(binary_clock_h2_server_t* server) {
+    if (server == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < server->connection_count; i++) {
+        close_connection(server->connections[i]);
+    }
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, slot_bytes(server->connection_capacity));
+    free(server->connections);
+    free(server->poll_set);
+    binary_clock_query_t* query = server->query;
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->query = query;
+}
+
+#endif
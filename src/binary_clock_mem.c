@@ -0,0 +1,150 @@
+/**
+ * @file binary_clock_mem.c
+ * @brief Binary Clock Memory Accounting Implementation
+ *
+ * One counter set per subsystem. Releases saturate at zero, so a module
+ * that gives back more than it charged cannot wrap the count around.
+ */
+
+#include <binary_clock_mem.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char* const subsystem_names[BINARY_CLOCK_MEM_SUBSYSTEMS] = {
+    "tables", "caches", "registry", "queues"
+};
+
+static binary_clock_mem_usage_t usage[BINARY_CLOCK_MEM_SUBSYSTEMS] = {
+    {0, 0, BINARY_CLOCK_MEM_UNCAPPED, 0}, {0, 0, BINARY_CLOCK_MEM_UNCAPPED, 0},
+    {0, 0, BINARY_CLOCK_MEM_UNCAPPED, 0}, {0, 0, BINARY_CLOCK_MEM_UNCAPPED, 0}
+};
+
+static bool known(binary_clock_mem_subsystem_t subsystem) {
+    return (unsigned)subsystem < BINARY_CLOCK_MEM_SUBSYSTEMS;
+}
+
+binary_clock_error_t binary_clock_mem_set_cap(binary_clock_mem_subsystem_t subsystem, size_t bytes) {
+    if (!known(subsystem)) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    usage[subsystem].cap = bytes;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+size_t binary_clock_mem_available(binary_clock_mem_subsystem_t subsystem) {
+    if (!known(subsystem)) {
+        return 0;
+    }
+    const binary_clock_mem_usage_t* entry = &usage[subsystem];
+    return entry->used >= entry->cap ? 0 : entry->cap - entry->used;
+}
+
+void binary_clock_mem_charge(binary_clock_mem_subsystem_t subsystem, size_t bytes) {
+    if (!known(subsystem)) {
+        return;
+    }
+    binary_clock_mem_usage_t* entry = &usage[subsystem];
+    entry->used += bytes;
+    if (entry->used > entry->peak) {
+        entry->peak = entry->used;
+    }
+}
+
+bool binary_clock_mem_reserve(binary_clock_mem_subsystem_t subsystem, size_t bytes) {
+    if (!known(subsystem)) {
+        return false;
+    }
+    if (bytes > binary_clock_mem_available(subsystem)) {
+        usage[subsystem].lean++;
+        return false;
+    }
+    binary_clock_mem_charge(subsystem, bytes);
+    return true;
+}
+
+void binary_clock_mem_release(binary_clock_mem_subsystem_t subsystem, size_t bytes) {
+    if (!known(subsystem)) {
+        return;
+    }
+    binary_clock_mem_usage_t* entry = &usage[subsystem];
+    entry->used = bytes > entry->used ? 0 : entry->used - bytes;
+}
+
+binary_clock_mem_usage_t binary_clock_mem_get_usage(binary_clock_mem_subsystem_t subsystem) {
+    binary_clock_mem_usage_t none = {0, 0, 0, 0};
+    return known(subsystem) ? usage[subsystem] : none;
+}
+
+size_t binary_clock_mem_total(void) {
+    size_t total = 0;
+    for (int i = 0; i < BINARY_CLOCK_MEM_SUBSYSTEMS; i++) {
+        total += usage[i].used;
+    }
+    return total;
+}
+
+const char* binary_clock_mem_subsystem_name(binary_clock_mem_subsystem_t subsystem) {
+    return known(subsystem) ? subsystem_names[subsystem] : "unknown";
+}
+
+binary_clock_error_t binary_clock_mem_subsystem_from_name(const char* name, binary_clock_mem_subsystem_t* subsystem) {
+    if (name == NULL || subsystem == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    for (int i = 0; i < BINARY_CLOCK_MEM_SUBSYSTEMS; i++) {
+        if (strcmp(name, subsystem_names[i]) == 0) {
+            *subsystem = (binary_clock_mem_subsystem_t)i;
+            return BINARY_CLOCK_SUCCESS;
+        }
+    }
+    return BINARY_CLOCK_ERROR_OUTPUT;
+}
+
+// Append formatted text, keeping the length at most size - 1 when truncated
+static size_t append(char* buffer, size_t size, size_t length, const char* format, ...) {
+    if (length + 1 >= size) {
+        return length;
+    }
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + length, size - length, format, args);
+    va_end(args);
+    if (written < 0) {
+        return length;
+    }
+    return (size_t)written < size - length ? length + (size_t)written : size - 1;
+}
+
+size_t binary_clock_mem_report(char* buffer, size_t size) {
+    if (buffer == NULL || size == 0) {
+        return 0;
+    }
+    buffer[0] = '\0';
+    size_t length = append(buffer, size, 0, "%-10s %12s %12s %12s %8s\n", "subsystem", "used", "peak", "cap", "lean");
+    size_t used = 0;
+    size_t peak = 0;
+    for (int i = 0; i < BINARY_CLOCK_MEM_SUBSYSTEMS; i++) {
+        const binary_clock_mem_usage_t* entry = &usage[i];
+        char cap[24] = "-";
+        if (entry->cap != BINARY_CLOCK_MEM_UNCAPPED) {
+            snprintf(cap, sizeof(cap), "%llu", (unsigned long long)entry->cap);
+        }
+        length = append(buffer, size, length, "%-10s %12llu %12llu %12s %8llu\n", subsystem_names[i],
+                        (unsigned long long)entry->used, (unsigned long long)entry->peak, cap,
+                        (unsigned long long)entry->lean);
+        used += entry->used;
+        peak += entry->peak;
+    }
+    return append(buffer, size, length, "%-10s %12llu %12llu\n", "total", (unsigned long long)used,
+                  (unsigned long long)peak);
+}
+
+void binary_clock_mem_reset(void) {
+    for (int i = 0; i < BINARY_CLOCK_MEM_SUBSYSTEMS; i++) {
+        usage[i].used = 0;
+        usage[i].peak = 0;
+        usage[i].cap = BINARY_CLOCK_MEM_UNCAPPED;
+        usage[i].lean = 0;
+    }
+}
@@ -0,0 +1,362 @@
+/**
+ * @file binary_clock_multicast.c
+ * @brief Binary Clock Multicast Implementation
+ *
+ * Tick encoding, sequence gap detection and the UDP multicast sockets used
+ * to fan ticks out to display nodes. The encoding and gap detection are
+ * platform independent; socket code is POSIX only.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_multicast.h>
+#include <binary_clock_present.h>
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+#endif
+
+/* ========================================================================== */
+/* TICK DATAGRAMS                                                             */
+/* ========================================================================== */
+
+static void put_be(uint8_t* output, uint64_t value, int size) {
+    for (int i = size - 1; i >= 0; i--) {
+        output[i] = (uint8_t)(value & 0xFF);
+        value >>= 8;
+    }
+}
+
+static uint64_t get_be(const uint8_t* data, int size) {
+    uint64_t value = 0;
+    for (int i = 0; i < size; i++) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+binary_clock_error_t binary_clock_tick_encode(const binary_clock_tick_t* tick, uint8_t* output) {
+    if (tick == NULL || output == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+
+    put_be(output, BINARY_CLOCK_TICK_MAGIC, 4);
+    output[4] = BINARY_CLOCK_TICK_VERSION;
+    output[5] = 0;
+    put_be(output + 6, 0, 2);
+    put_be(output + 8, tick->packed, 4);
+    put_be(output + 12, tick->sequence, 4);
+    put_be(output + 16, (uint64_t)tick->present_at_us, 8);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_tick_decode(const uint8_t* data, size_t length, binary_clock_tick_t* tick) {
+    if (data == NULL || tick == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (length != BINARY_CLOCK_TICK_SIZE ||
+        get_be(data, 4) != BINARY_CLOCK_TICK_MAGIC ||
+        data[4] != BINARY_CLOCK_TICK_VERSION) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+
+    uint32_t packed = (uint32_t)get_be(data + 8, 4);
+    if (binary_clock_state_from_packed(packed, 1).timestamp == 0) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME; // Digit out of range
+    }
+
+    tick->packed = packed;
+    tick->sequence = (uint32_t)get_be(data + 12, 4);
+    tick->present_at_us = (int64_t)get_be(data + 16, 8);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+/* ========================================================================== */
+/* GAP DETECTION                                                              */
+/* ========================================================================== */
+
+void binary_clock_receiver_reset(binary_clock_receiver_t* receiver) {
+    if (receiver == NULL) {
+        return;
+    }
+    binary_clock_tick_t empty = {0};
+    binary_clock_receiver_stats_t zero = {0};
+    receiver->synced = false;
+    receiver->last = empty;
+    receiver->stats = zero;
+}
+
+int binary_clock_receiver_apply(binary_clock_receiver_t* receiver, const binary_clock_tick_t* tick) {
+    if (receiver == NULL || tick == NULL) {
+        return -1;
+    }
+
+    int gap = 0;
+    if (receiver->synced) {
+        // Serial-number distance, correct across sequence wrap
+        int32_t distance = (int32_t)(tick->sequence - receiver->last.sequence);
+        if (distance < -BINARY_CLOCK_RECEIVER_REORDER_WINDOW) {
+            receiver->stats.resyncs++;
+        } else if (distance <= 0) {
+            receiver->stats.stale++;
+            return -1;
+        } else {
+            gap = distance - 1;
+            receiver->stats.lost += (uint64_t)gap;
+        }
+    }
+
+    receiver->synced = true;
+    receiver->last = *tick;
+    receiver->stats.applied++;
+    return gap;
+}
+
+/* ========================================================================== */
+/* SOCKETS                                                                    */
+/* ========================================================================== */
+
+#ifdef _WIN32
+
+binary_clock_error_t binary_clock_broadcaster_open(binary_clock_broadcaster_t* broadcaster,
+                                                   const char* group, uint16_t port,
+                                                   const char* interface_address, int ttl) {
+    (void)group; (void)port; (void)interface_address; (void)ttl;
+    if (broadcaster == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    broadcaster->fd = -1;
+    return BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_broadcaster_send(binary_clock_broadcaster_t* broadcaster,
+                                                   uint32_t packed, int64_t present_at_us) {
+    (void)packed; (void)present_at_us;
+    return broadcaster == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_ERROR_NETWORK;
+}
+
+void binary_clock_broadcaster_close(binary_clock_broadcaster_t* broadcaster) {
+    (void)broadcaster;
+}
+
+binary_clock_error_t binary_clock_receiver_open(binary_clock_receiver_t* receiver,
+                                                const char* group, uint16_t port,
+                                                const char* interface_address) {
+    (void)group; (void)port; (void)interface_address;
+    if (receiver == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    binary_clock_receiver_reset(receiver);
+    receiver->fd = -1;
+    return BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_receiver_receive(binary_clock_receiver_t* receiver,
+                                                   binary_clock_tick_t* tick, int* gap,
+                                                   int timeout_ms) {
+    (void)tick; (void)gap; (void)timeout_ms;
+    return receiver == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_ERROR_NETWORK;
+}
+
+void binary_clock_receiver_close(binary_clock_receiver_t* receiver) {
+    (void)receiver;
+}
+
+#else
+
+// Parse a dotted IPv4 address; NULL selects INADDR_ANY
+static int parse_address(const char* text, struct in_addr* address) {
+    if (text == NULL) {
+        address->s_addr = htonl(INADDR_ANY);
+        return 0;
+    }
+    return inet_pton(AF_INET, text, address) == 1 ? 0 : -1;
+}
+
+binary_clock_error_t binary_clock_broadcaster_open(binary_clock_broadcaster_t* broadcaster,
+                                                   const char* group, uint16_t port,
+                                                   const char* interface_address, int ttl) {
+    if (broadcaster == NULL || group == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    broadcaster->fd = -1;
+    broadcaster->sequence = 0;
+
+    struct in_addr group_address;
+    struct in_addr interface;
+    if (parse_address(group, &group_address) != 0 || !IN_MULTICAST(ntohl(group_address.s_addr)) ||
+        parse_address(interface_address, &interface) != 0 || ttl < 0 || ttl > 255) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    unsigned char ttl_value = (unsigned char)ttl;
+    unsigned char loop = 1;  // Let receivers on the sending host see the ticks
+    if (setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl_value, sizeof(ttl_value)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0 ||
+        (interface_address != NULL &&
+         setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) != 0)) {
+        close(fd);
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    broadcaster->fd = fd;
+    broadcaster->group = ntohl(group_address.s_addr);
+    broadcaster->port = port;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_broadcaster_send(binary_clock_broadcaster_t* broadcaster,
+                                                   uint32_t packed, int64_t present_at_us) {
+    if (broadcaster == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (broadcaster->fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    binary_clock_tick_t tick = {broadcaster->sequence, packed, present_at_us};
+    uint8_t datagram[BINARY_CLOCK_TICK_SIZE];
+    binary_clock_tick_encode(&tick, datagram);
+
+    struct sockaddr_in destination = {0};
+    destination.sin_family = AF_INET;
+    destination.sin_addr.s_addr = htonl(broadcaster->group);
+    destination.sin_port = htons(broadcaster->port);
+
+    ssize_t sent;
+    do {
+        sent = sendto(broadcaster->fd, datagram, sizeof(datagram), 0,
+                      (const struct sockaddr*)&destination, sizeof(destination));
+    } while (sent < 0 && errno == EINTR);
+    if (sent != (ssize_t)sizeof(datagram)) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    broadcaster->sequence++;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_broadcaster_close(binary_clock_broadcaster_t* broadcaster) {
+    if (broadcaster != NULL && broadcaster->fd >= 0) {
+        close(broadcaster->fd);
+        broadcaster->fd = -1;
+    }
+}
+
+binary_clock_error_t binary_clock_receiver_open(binary_clock_receiver_t* receiver,
+                                                const char* group, uint16_t port,
+                                                const char* interface_address) {
+    if (receiver == NULL || group == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    binary_clock_receiver_reset(receiver);
+    receiver->fd = -1;
+
+    struct ip_mreq membership;
+    if (parse_address(group, &membership.imr_multiaddr) != 0 ||
+        !IN_MULTICAST(ntohl(membership.imr_multiaddr.s_addr)) ||
+        parse_address(interface_address, &membership.imr_interface) != 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    // Bind to the group address so only this group's datagrams arrive
+    int reuse = 1;
+    struct sockaddr_in local = {0};
+    local.sin_family = AF_INET;
+    local.sin_addr = membership.imr_multiaddr;
+    local.sin_port = htons(port);
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+#ifdef __APPLE__
+        setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) != 0 ||
+#endif
+        bind(fd, (const struct sockaddr*)&local, sizeof(local)) != 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+        close(fd);
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    receiver->fd = fd;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_receiver_receive(binary_clock_receiver_t* receiver,
+                                                   binary_clock_tick_t* tick, int* gap,
+                                                   int timeout_ms) {
+    if (receiver == NULL || tick == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (receiver->fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    int64_t deadline = binary_clock_present_now_us() + (int64_t)timeout_ms * 1000;
+    for (;;) {
+        int wait_ms = -1;
+        if (timeout_ms >= 0) {
+            int64_t remaining = deadline - binary_clock_present_now_us();
+            wait_ms = remaining > 0 ? (int)((remaining + 999) / 1000) : 0;
+        }
+
+        struct pollfd pfd = {receiver->fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, wait_ms);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready < 0) {
+            return BINARY_CLOCK_ERROR_NETWORK;
+        }
+        if (ready == 0) {
+            return BINARY_CLOCK_ERROR_TIMEOUT;
+        }
+
+        // One spare byte so oversized datagrams are detected, not truncated
+        uint8_t datagram[BINARY_CLOCK_TICK_SIZE + 1];
+        ssize_t length = recv(receiver->fd, datagram, sizeof(datagram), 0);
+        if (length < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            return BINARY_CLOCK_ERROR_NETWORK;
+        }
+
+        binary_clock_tick_t received;
+        if (binary_clock_tick_decode(datagram, (size_t)length, &received) != BINARY_CLOCK_SUCCESS) {
+            receiver->stats.invalid++;
+            continue;
+        }
+        int missed = binary_clock_receiver_apply(receiver, &received);
+        if (missed < 0) {
+            continue;
+        }
+
+        *tick = received;
+        if (gap != NULL) {
+            *gap = missed;
+        }
+        return BINARY_CLOCK_SUCCESS;
+    }
+}
+
+void binary_clock_receiver_close(binary_clock_receiver_t* receiver) {
+    if (receiver != NULL && receiver->fd >= 0) {
+        close(receiver->fd);  // Closing the socket leaves the group
+        receiver->fd = -1;
+    }
+}
+
+#endif
@@ -0,0 +1,195 @@
+/**
+ * @file binary_clock_patch.c
+ * @brief Binary Clock Patch Stream Implementation
+ *
+ * Full documents come from the JSON line renderer. Patches are assembled
+ * from the cached digit fragments: a patch for the usual second copies
+ * one fragment, and the timestamp and time text are the only bytes
+ * formatted per update.
+ */
+
+#include <binary_clock_patch.h>
+#include <string.h>
+
+static const char* const group_names[3] = {"\"hours\":{", "\"minutes\":{", "\"seconds\":{"};
+
+// Bits of each digit in the document: 3 for tens, 4 for units
+static const uint8_t digit_bits[BINARY_CLOCK_PATCH_DIGITS] = {3, 4, 3, 4, 3, 4};
+
+static const char sse_data[] = "data: ";
+
+static uint8_t digit_value(const binary_clock_state_t* state, int digit) {
+    const binary_value_t* digits[BINARY_CLOCK_PATCH_DIGITS] = {
+        &state->hours_tens, &state->hours_units,
+        &state->minutes_tens, &state->minutes_units,
+        &state->seconds_tens, &state->seconds_units
+    };
+    return digits[digit]->decimal_value;
+}
+
+binary_clock_error_t binary_clock_patch_init(binary_clock_patch_t* patch, binary_clock_patch_framing_t framing,
+                                             uint32_t resync) {
+    if (patch == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(patch, 0, sizeof(*patch));
+    patch->framing = framing;
+    patch->resync = resync;
+    patch->render = binary_clock_display_render;
+    if (framing != BINARY_CLOCK_PATCH_NDJSON && framing != BINARY_CLOCK_PATCH_SSE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    // "tens":[b,b,b] and "units":[b,b,b,b], most significant bit first
+    for (int digit = 0; digit < BINARY_CLOCK_PATCH_DIGITS; digit++) {
+        int bits = digit_bits[digit];
+        for (int value = 0; value < 10 && value < (1 << bits); value++) {
+            char* fragment = patch->fragments[digit][value];
+            size_t length = 0;
+            const char* name = digit % 2 == 0 ? "\"tens\":[" : "\"units\":[";
+            memcpy(fragment, name, strlen(name));
+            length += strlen(name);
+            for (int bit = bits - 1; bit >= 0; bit--) {
+                fragment[length++] = (char)('0' + ((value >> bit) & 1));
+                fragment[length++] = bit > 0 ? ',' : ']';
+            }
+            patch->fragment_lengths[digit][value] = (uint8_t)length;
+        }
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_patch_resync(binary_clock_patch_t* patch) {
+    if (patch != NULL) {
+        patch->started = false;
+    }
+}
+
+static size_t append(char* output, size_t length, const char* bytes, size_t count) {
+    memcpy(output + length, bytes, count);
+    return length + count;
+}
+
+static size_t append_timestamp(char* output, size_t length, binary_clock_time_t timestamp) {
+    char digits[24];
+    int pos = (int)sizeof(digits);
+    uint64_t magnitude = timestamp < 0 ? 0 - (uint64_t)timestamp : (uint64_t)timestamp;
+    do {
+        digits[--pos] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (timestamp < 0) {
+        digits[--pos] = '-';
+    }
+    return append(output, length, digits + pos, sizeof(digits) - (size_t)pos);
+}
+
+// Close an update: SSE ends an event with a blank line
+static size_t append_end(const binary_clock_patch_t* patch, char* output, size_t length) {
+    return append(output, length, patch->framing == BINARY_CLOCK_PATCH_SSE ? "\n\n" : "\n",
+                  patch->framing == BINARY_CLOCK_PATCH_SSE ? 2 : 1);
+}
+
+static void record(binary_clock_patch_t* patch, const binary_clock_state_t* state, const uint8_t* digits) {
+    patch->timestamp = state->timestamp;
+    memcpy(patch->digits, digits, sizeof(patch->digits));
+}
+
+size_t binary_clock_patch_update(binary_clock_patch_t* patch, const binary_clock_state_t* state,
+                                 char* output, size_t size) {
+    if (patch == NULL || state == NULL || output == NULL) {
+        return (size_t)-1;
+    }
+    uint8_t digits[BINARY_CLOCK_PATCH_DIGITS];
+    for (int digit = 0; digit < BINARY_CLOCK_PATCH_DIGITS; digit++) {
+        digits[digit] = digit_value(state, digit);
+        if (digits[digit] >= 10 || patch->fragment_lengths[digit][digits[digit]] == 0) {
+            return (size_t)-1;
+        }
+    }
+    size_t prefix = patch->framing == BINARY_CLOCK_PATCH_SSE ? sizeof(sse_data) - 1 : 0;
+    if (size < prefix) {
+        return (size_t)-1;
+    }
+    memcpy(output, sse_data, prefix);
+
+    // Full document: the JSON line, its line end replaced by the framing's
+    if (!patch->started || (patch->resync > 0 && patch->since_document + 1 >= patch->resync)) {
+        size_t rendered = patch->render(state, BINARY_CLOCK_RENDER_JSON_LINE, output + prefix, size - prefix);
+        if (rendered < 2 || prefix + rendered + 1 > size) {
+            return (size_t)-1;
+        }
+        size_t length = append_end(patch, output, prefix + rendered - 1);
+        record(patch, state, digits);
+        patch->started = true;
+        patch->since_document = 0;
+        patch->stats.documents++;
+        patch->stats.bytes += length;
+        return length;
+    }
+
+    bool changed[BINARY_CLOCK_PATCH_DIGITS];
+    bool any = false;
+    for (int digit = 0; digit < BINARY_CLOCK_PATCH_DIGITS; digit++) {
+        changed[digit] = digits[digit] != patch->digits[digit];
+        any = any || changed[digit];
+    }
+    if (!any && state->timestamp == patch->timestamp) {
+        patch->stats.unchanged++;
+        return 0;
+    }
+
+    // Worst case: timestamp, time and every fragment with its group
+    char buffer[BINARY_CLOCK_PATCH_MAX_SIZE];
+    size_t length = append(buffer, 0, "{\"timestamp\":", 13);
+    length = append_timestamp(buffer, length, state->timestamp);
+    if (any) {
+        char time[8] = {
+            (char)('0' + digits[0]), (char)('0' + digits[1]), ':',
+            (char)('0' + digits[2]), (char)('0' + digits[3]), ':',
+            (char)('0' + digits[4]), (char)('0' + digits[5])
+        };
+        length = append(buffer, length, ",\"time\":\"", 9);
+        length = append(buffer, length, time, sizeof(time));
+        length = append(buffer, length, "\",\"binary\":{", 12);
+        bool first_group = true;
+        for (int group = 0; group < 3; group++) {
+            int tens = 2 * group;
+            int units = tens + 1;
+            if (!changed[tens] && !changed[units]) {
+                continue;
+            }
+            if (!first_group) {
+                length = append(buffer, length, ",", 1);
+            }
+            first_group = false;
+            length = append(buffer, length, group_names[group], strlen(group_names[group]));
+            if (changed[tens]) {
+                length = append(buffer, length, patch->fragments[tens][digits[tens]],
+                                patch->fragment_lengths[tens][digits[tens]]);
+            }
+            if (changed[tens] && changed[units]) {
+                length = append(buffer, length, ",", 1);
+            }
+            if (changed[units]) {
+                length = append(buffer, length, patch->fragments[units][digits[units]],
+                                patch->fragment_lengths[units][digits[units]]);
+            }
+            length = append(buffer, length, "}", 1);
+        }
+        length = append(buffer, length, "}", 1);
+    }
+    length = append(buffer, length, "}", 1);
+
+    size_t end = patch->framing == BINARY_CLOCK_PATCH_SSE ? 2 : 1;
+    if (prefix + length + end > size) {
+        return (size_t)-1;
+    }
+    memcpy(output + prefix, buffer, length);
+    length = append_end(patch, output, prefix + length);
+    record(patch, state, digits);
+    patch->since_document++;
+    patch->stats.patches++;
+    patch->stats.bytes += length;
+    return length;
+}
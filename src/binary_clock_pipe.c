@@ -0,0 +1,251 @@
+/**
+ * @file binary_clock_pipe.c
+ * @brief Binary Clock Pipe Output Implementation
+ *
+ * The current buffer is never in a pipe; the other one may be, until
+ * the next full buffer has been spliced behind it. Only full buffers are
+ * spliced, so that invariant holds without asking the kernel how much of
+ * the pipe has been read.
+ */
+
+#define _GNU_SOURCE  // vmsplice() and F_SETPIPE_SZ
+
+#include <binary_clock_pipe.h>
+#include <binary_clock_mem.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+#if defined(__linux__) && defined(F_SETPIPE_SZ)
+    #include <sys/uio.h>
+    #define PIPE_HAS_SPLICE 1
+#else
+    #define PIPE_HAS_SPLICE 0
+#endif
+
+static char* map_buffer(size_t size) {
+#ifdef _WIN32
+    return malloc(size);
+#else
+    void* buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return buffer == MAP_FAILED ? NULL : buffer;
+#endif
+}
+
+static void unmap_buffer(char* buffer, size_t size) {
+    if (buffer == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    (void)size;
+    free(buffer);
+#else
+    munmap(buffer, size);
+#endif
+}
+
+#if PIPE_HAS_SPLICE
+// Enlarge the pipe if the queues cap allows both buffers at that size;
+// returns the capacity it ends up with
+static size_t size_pipe(int fd, size_t wanted) {
+    int current = fcntl(fd, F_GETPIPE_SZ);
+    if (current <= 0) {
+        return 0;
+    }
+    if (wanted > (size_t)current && binary_clock_mem_reserve(BINARY_CLOCK_MEM_QUEUES, 2 * wanted)) {
+        // Charged again below at whatever size the kernel grants
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, 2 * wanted);
+        int resized = fcntl(fd, F_SETPIPE_SZ, (int)wanted);
+        if (resized > 0) {
+            current = resized;
+        }
+    }
+    return (size_t)current;
+}
+#endif
+
+binary_clock_error_t binary_clock_pipe_writer_open(binary_clock_pipe_writer_t* writer, int fd, size_t pipe_size,
+                                                   bool allow_splice) {
+    if (writer == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(writer, 0, sizeof(*writer));
+    writer->fd = fd;
+    writer->buffer_size = BINARY_CLOCK_PIPE_WRITE_BUFFER_SIZE;
+
+#if PIPE_HAS_SPLICE
+    struct stat info;
+    if (allow_splice && fstat(fd, &info) == 0 && S_ISFIFO(info.st_mode)) {
+        size_t capacity = size_pipe(fd, pipe_size > 0 ? pipe_size : BINARY_CLOCK_PIPE_DEFAULT_SIZE);
+        if (capacity > 0) {
+            writer->splice = true;
+            writer->buffer_size = capacity;
+        }
+    }
+#else
+    (void)pipe_size;
+    (void)allow_splice;
+#endif
+
+    int count = writer->splice ? 2 : 1;
+    size_t mapped = writer->buffer_size + BINARY_CLOCK_PIPE_RESERVE_MAX;
+    for (int i = 0; i < count; i++) {
+        writer->buffers[i] = map_buffer(mapped);
+        if (writer->buffers[i] == NULL) {
+            unmap_buffer(writer->buffers[0], mapped);
+            writer->buffers[0] = NULL;
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+    }
+    writer->bytes = (size_t)count * mapped;
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, writer->bytes);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+static int write_all(binary_clock_pipe_writer_t* writer, const char* data, size_t length) {
+    while (length > 0) {
+#ifdef _WIN32
+        int written = _write(writer->fd, data, (unsigned)length);
+#else
+        ssize_t written = write(writer->fd, data, length);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+#endif
+        writer->stats.system_calls++;
+        if (written <= 0) {
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+#if PIPE_HAS_SPLICE
+// Map a full buffer into the pipe; falls back to write() if refused
+static int splice_all(binary_clock_pipe_writer_t* writer, char* data, size_t length) {
+    struct iovec chunk = {data, length};
+    while (chunk.iov_len > 0) {
+        ssize_t spliced = vmsplice(writer->fd, &chunk, 1, 0);
+        writer->stats.system_calls++;
+        if (spliced < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EINVAL || errno == ENOSYS) {
+                writer->splice = false;
+                return write_all(writer, chunk.iov_base, chunk.iov_len);
+            }
+            return -1;
+        }
+        chunk.iov_base = (char*)chunk.iov_base + spliced;
+        chunk.iov_len -= (size_t)spliced;
+    }
+    return 0;
+}
+#endif
+
+// Hand up to a buffer's worth to the kernel; spliced buffers are swapped
+// out and any overflow in the slack moves to the start of the next one
+static int flush_current(binary_clock_pipe_writer_t* writer) {
+    char* buffer = writer->buffers[writer->current];
+    size_t length = writer->used < writer->buffer_size ? writer->used : writer->buffer_size;
+    size_t overflow = writer->used - length;
+    if (length == 0) {
+        return 0;
+    }
+    int result;
+#if PIPE_HAS_SPLICE
+    if (writer->splice && length == writer->buffer_size) {
+        result = splice_all(writer, buffer, length);
+        writer->stats.spliced++;
+        writer->current ^= 1;
+    } else
+#endif
+    {
+        result = write_all(writer, buffer, length);
+        writer->stats.written++;
+    }
+    memmove(writer->buffers[writer->current], buffer + length, overflow);
+    writer->used = overflow;
+    if (result == 0) {
+        writer->stats.bytes += length;
+    }
+    return result;
+}
+
+char* binary_clock_pipe_writer_reserve(binary_clock_pipe_writer_t* writer, size_t length) {
+    if (writer == NULL || writer->buffers[0] == NULL || length > BINARY_CLOCK_PIPE_RESERVE_MAX) {
+        return NULL;
+    }
+    return writer->buffers[writer->current] + writer->used;
+}
+
+binary_clock_error_t binary_clock_pipe_writer_commit(binary_clock_pipe_writer_t* writer, size_t length) {
+    if (writer == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (writer->buffers[0] == NULL || length > BINARY_CLOCK_PIPE_RESERVE_MAX) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    writer->used += length;
+    if (writer->used >= writer->buffer_size && flush_current(writer) != 0) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_pipe_writer_write(binary_clock_pipe_writer_t* writer, const char* data,
+                                                    size_t length) {
+    if (writer == NULL || data == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (writer->buffers[0] == NULL) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    while (length > 0) {
+        size_t room = writer->buffer_size - writer->used;
+        size_t chunk = length < room ? length : room;
+        memcpy(writer->buffers[writer->current] + writer->used, data, chunk);
+        writer->used += chunk;
+        data += chunk;
+        length -= chunk;
+        if (writer->used == writer->buffer_size && flush_current(writer) != 0) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_pipe_writer_flush(binary_clock_pipe_writer_t* writer) {
+    if (writer == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    return flush_current(writer) == 0 ? BINARY_CLOCK_SUCCESS : BINARY_CLOCK_ERROR_OUTPUT;
+}
+
+binary_clock_error_t binary_clock_pipe_writer_close(binary_clock_pipe_writer_t* writer) {
+    if (writer == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    binary_clock_error_t error = binary_clock_pipe_writer_flush(writer);
+    // Unmapping leaves pages still in the pipe to the pipe
+    for (int i = 0; i < 2; i++) {
+        unmap_buffer(writer->buffers[i], writer->buffer_size + BINARY_CLOCK_PIPE_RESERVE_MAX);
+        writer->buffers[i] = NULL;
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, writer->bytes);
+    writer->bytes = 0;
+    writer->used = 0;
+    return error;
+}
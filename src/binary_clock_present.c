@@ -0,0 +1,309 @@
+/**
+ * @file binary_clock_present.c
+ * @brief Binary Clock Presentation Implementation
+ *
+ * Wall-clock helpers and the stage/commit presenter. Frames are rendered
+ * with binary_clock_display_render() so staging never touches stdio, and
+ * committed with one write() so the whole frame lands at once.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_present.h>
+#include <binary_clock_trace.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>  // For GetSystemTimeAsFileTime and Sleep
+    #include <io.h>       // For _write
+#else
+    #include <errno.h>
+    #include <sched.h>
+    #include <time.h>
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/stat.h>
+#endif
+
+/* ========================================================================== */
+/* TIMING                                                                     */
+/* ========================================================================== */
+
+#ifdef _WIN32
+
+int64_t binary_clock_present_now_us(void) {
+    // FILETIME counts 100 ns intervals since 1601-01-01
+    FILETIME file_time;
+    GetSystemTimeAsFileTime(&file_time);
+    uint64_t ticks = ((uint64_t)file_time.dwHighDateTime << 32) | file_time.dwLowDateTime;
+    return (int64_t)(ticks / 10) - 11644473600000000LL;
+}
+
+void binary_clock_present_sleep_until_us(int64_t wake_at_us) {
+    int64_t remaining = wake_at_us - binary_clock_present_now_us();
+    if (remaining > 0) {
+        Sleep((DWORD)(remaining / 1000));
+    }
+}
+
+static void yield_cpu(void) {
+    SwitchToThread();
+}
+
+static int write_frame(int fd, const char* data, size_t length) {
+    return _write(fd, data, (unsigned int)length) == (int)length ? 0 : -1;
+}
+
+long binary_clock_present_pending_output(int fd) {
+    (void)fd;
+    return -1;
+}
+
+#else
+
+int64_t binary_clock_present_now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+void binary_clock_present_sleep_until_us(int64_t wake_at_us) {
+    // Relative sleeps re-checked against the wall clock (survives EINTR)
+    for (;;) {
+        int64_t remaining = wake_at_us - binary_clock_present_now_us();
+        if (remaining <= 0) {
+            return;
+        }
+        struct timespec ts = {(time_t)(remaining / 1000000), (long)(remaining % 1000000) * 1000};
+        nanosleep(&ts, NULL);
+    }
+}
+
+static void yield_cpu(void) {
+    sched_yield();
+}
+
+static int write_frame(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+long binary_clock_present_pending_output(int fd) {
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        return -1;
+    }
+    int pending = 0;
+    // FIONREAD on a terminal or socket is the input queue, so only pipes use it
+    if (S_ISFIFO(info.st_mode)) {
+        return ioctl(fd, FIONREAD, &pending) == 0 ? (long)pending : -1;
+    }
+#ifdef TIOCOUTQ
+    if (S_ISCHR(info.st_mode) || S_ISSOCK(info.st_mode)) {
+        return ioctl(fd, TIOCOUTQ, &pending) == 0 ? (long)pending : -1;
+    }
+#endif
+    return -1;
+}
+
+#endif
+
+int64_t binary_clock_present_wait_until_us(int64_t target_us) {
+    // Sleep through most of the wait, spin through the final stretch. The
+    // spin yields so presenters sharing a CPU all get to see the instant.
+    binary_clock_present_sleep_until_us(target_us - BINARY_CLOCK_PRESENT_SPIN_US);
+
+    int64_t now = binary_clock_present_now_us();
+    while (now < target_us) {
+        yield_cpu();
+        now = binary_clock_present_now_us();
+    }
+    return now;
+}
+
+/* ========================================================================== */
+/* CLOCK SOURCES                                                              */
+/* ========================================================================== */
+
+void binary_clock_virtual_clock_init(binary_clock_virtual_clock_t* clock, int64_t start_us, uint32_t speed) {
+    if (clock == NULL) {
+        return;
+    }
+    clock->virtual_origin_us = start_us;
+    clock->real_origin_us = binary_clock_present_now_us();
+    clock->speed = speed;
+    clock->now_us = start_us;
+}
+
+static int64_t virtual_now_us(void* context) {
+    binary_clock_virtual_clock_t* clock = context;
+    if (clock->speed == 0) {
+        return clock->now_us;
+    }
+    return clock->virtual_origin_us +
+           (binary_clock_present_now_us() - clock->real_origin_us) * (int64_t)clock->speed;
+}
+
+static int64_t virtual_wait_until_us(int64_t target_us, void* context) {
+    binary_clock_virtual_clock_t* clock = context;
+    if (clock->speed == 0) {
+        if (target_us > clock->now_us) {
+            clock->now_us = target_us;
+        }
+        return clock->now_us;
+    }
+
+    // Round the real deadline up so the virtual target is never undershot
+    int64_t virtual_wait = target_us - clock->virtual_origin_us;
+    int64_t real_wait = (virtual_wait + (int64_t)clock->speed - 1) / (int64_t)clock->speed;
+    binary_clock_present_wait_until_us(clock->real_origin_us + real_wait);
+    return virtual_now_us(clock);
+}
+
+binary_clock_present_clock_t binary_clock_virtual_clock_source(binary_clock_virtual_clock_t* clock) {
+    binary_clock_present_clock_t source = {virtual_now_us, virtual_wait_until_us, clock};
+    return source;
+}
+
+static int64_t wall_wait_until_us(int64_t target_us, void* context) {
+    (void)context;
+    return binary_clock_present_wait_until_us(target_us);
+}
+
+static int64_t wall_now_us(void* context) {
+    (void)context;
+    return binary_clock_present_now_us();
+}
+
+/* ========================================================================== */
+/* PRESENTER                                                                  */
+/* ========================================================================== */
+
+void binary_clock_presenter_init(binary_clock_presenter_t* presenter, int fd) {
+    if (presenter == NULL) {
+        return;
+    }
+    binary_clock_present_stats_t zero = {0};
+    presenter->fd = fd;
+    presenter->length = 0;
+    presenter->present_at_us = 0;
+    presenter->staged = false;
+    presenter->render = binary_clock_display_render;
+    presenter->max_backlog = 0;
+    presenter->stats = zero;
+    binary_clock_presenter_set_clock(presenter, NULL);
+}
+
+void binary_clock_presenter_set_clock(binary_clock_presenter_t* presenter,
+                                      const binary_clock_present_clock_t* clock) {
+    if (presenter == NULL) {
+        return;
+    }
+    if (clock == NULL || clock->now_us == NULL || clock->wait_until_us == NULL) {
+        binary_clock_present_clock_t wall = {wall_now_us, wall_wait_until_us, NULL};
+        presenter->clock = wall;
+    } else {
+        presenter->clock = *clock;
+    }
+}
+
+int64_t binary_clock_presenter_now_us(const binary_clock_presenter_t* presenter) {
+    if (presenter == NULL) {
+        return binary_clock_present_now_us();
+    }
+    return presenter->clock.now_us(presenter->clock.context);
+}
+
+binary_clock_error_t binary_clock_presenter_stage(binary_clock_presenter_t* presenter,
+                                                  const binary_clock_state_t* state,
+                                                  binary_clock_render_format_t format,
+                                                  const char* prefix,
+                                                  int64_t present_at_us) {
+    if (presenter == NULL || state == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+
+    size_t prefix_length = prefix != NULL ? strlen(prefix) : 0;
+    if (prefix_length >= sizeof(presenter->frame) - BINARY_CLOCK_RENDER_MAX_SIZE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    if (prefix_length > 0) {
+        memcpy(presenter->frame, prefix, prefix_length);
+    }
+
+    binary_clock_trace_begin("present", "render");
+    size_t length = presenter->render(state, format, presenter->frame + prefix_length,
+                                      sizeof(presenter->frame) - prefix_length);
+    binary_clock_trace_end("present", "render");
+    if (length == 0) {
+        presenter->staged = false;
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    presenter->length = prefix_length + length;
+    presenter->present_at_us = present_at_us;
+    presenter->staged = true;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_presenter_commit(binary_clock_presenter_t* presenter,
+                                                   int64_t* error_us) {
+    if (presenter == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (!presenter->staged) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+
+    const binary_clock_present_clock_t* clock = &presenter->clock;
+    if (clock->now_us(clock->context) > presenter->present_at_us) {
+        presenter->stats.late++;
+    }
+    binary_clock_trace_begin("tick", "wait");
+    clock->wait_until_us(presenter->present_at_us, clock->context);
+    binary_clock_trace_end("tick", "wait");
+    if (presenter->max_backlog > 0) {
+        // Queued behind the backlog the frame would show late: drop it, the
+        // next frame repaints everything anyway
+        long backlog = binary_clock_present_pending_output(presenter->fd);
+        if (backlog > (long)presenter->max_backlog) {
+            presenter->staged = false;
+            presenter->stats.skipped++;
+            presenter->stats.last_backlog = backlog;
+            if (error_us != NULL) {
+                *error_us = clock->now_us(clock->context) - presenter->present_at_us;
+            }
+            return BINARY_CLOCK_SUCCESS;
+        }
+    }
+    binary_clock_trace_begin("sink", "write");
+    int failed = write_frame(presenter->fd, presenter->frame, presenter->length);
+    binary_clock_trace_end("sink", "write");
+    int64_t error = clock->now_us(clock->context) - presenter->present_at_us;
+    presenter->staged = false;
+    if (failed) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    int64_t magnitude = error < 0 ? -error : error;
+    presenter->stats.commits++;
+    presenter->stats.last_error_us = error;
+    presenter->stats.total_error_us += magnitude;
+    if (magnitude > presenter->stats.max_error_us) {
+        presenter->stats.max_error_us = magnitude;
+    }
+    if (error_us != NULL) {
+        *error_us = error;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
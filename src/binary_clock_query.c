@@ -0,0 +1,890 @@
+/**
+ * @file binary_clock_query.c
+ * @brief Binary Clock Queries Implementation
+ *
+ * Each cache shard is a fixed array of entries with a chained hash index
+ * and an intrusive doubly linked LRU list, all addressed by 32-bit
+ * indices. A shard's lock is a mutex held for a chain walk and one
+ * response copy, so it is almost never contended and taking it costs an
+ * uncontended atomic exchange.
+ *
+ * The server is a single-threaded poll() loop over non-blocking sockets
+ * (POSIX only). A connection reads its request head, gets one response
+ * and is closed; connection slots are charged to BINARY_CLOCK_MEM_QUEUES
+ * like the stream server's and grow 16 at a time over that cap.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_query.h>
+#include <binary_clock_mem.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>  // For QueryPerformanceCounter
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <time.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <pthread.h>
+#endif
+
+#ifdef _WIN32
+    typedef SRWLOCK query_lock_t;
+    #define QUERY_LOCK_INIT(lock) (InitializeSRWLock(lock), 0)
+    #define QUERY_LOCK_DESTROY(lock) ((void)(lock))
+    #define QUERY_LOCK(lock) AcquireSRWLockExclusive(lock)
+    #define QUERY_UNLOCK(lock) ReleaseSRWLockExclusive(lock)
+#else
+    typedef pthread_mutex_t query_lock_t;
+    #define QUERY_LOCK_INIT(lock) pthread_mutex_init((lock), NULL)
+    #define QUERY_LOCK_DESTROY(lock) pthread_mutex_destroy(lock)
+    #define QUERY_LOCK(lock) pthread_mutex_lock(lock)
+    #define QUERY_UNLOCK(lock) pthread_mutex_unlock(lock)
+#endif
+
+// Largest |t| accepted: the end of year 9999
+#define QUERY_MAX_EPOCH 253402300799LL
+
+static int64_t monotonic_ns(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (counter.QuadPart / frequency.QuadPart) * 1000000000LL +
+           (counter.QuadPart % frequency.QuadPart) * 1000000000LL / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+/* ========================================================================== */
+/* REQUESTS                                                                   */
+/* ========================================================================== */
+
+static const struct {
+    const char* name;
+    binary_clock_render_format_t format;
+    const char* content_type;
+} query_formats[] = {
+    {"json", BINARY_CLOCK_RENDER_JSON, "application/json"},
+    {"ndjson", BINARY_CLOCK_RENDER_JSON_LINE, "application/json"},
+    {"emoji", BINARY_CLOCK_RENDER_EMOJI, "text/plain; charset=utf-8"},
+    {"binary", BINARY_CLOCK_RENDER_ASCII, "text/plain; charset=utf-8"}
+};
+
+#define QUERY_FORMAT_COUNT (sizeof(query_formats) / sizeof(query_formats[0]))
+
+static bool is_at_path(const char* target, size_t length) {
+    return length >= 3 && memcmp(target, "/at", 3) == 0 && (length == 3 || target[3] == '?');
+}
+
+static int hex_value(char digit) {
+    if (digit >= '0' && digit <= '9') {
+        return digit - '0';
+    }
+    if (digit >= 'a' && digit <= 'f') {
+        return digit - 'a' + 10;
+    }
+    if (digit >= 'A' && digit <= 'F') {
+        return digit - 'A' + 10;
+    }
+    return -1;
+}
+
+// Decode %XX escapes into a terminated string; -1 if malformed or too long
+static int decode(const char* text, size_t length, char* output, size_t size) {
+    size_t written = 0;
+    for (size_t i = 0; i < length; i++) {
+        char byte = text[i];
+        if (byte == '%') {
+            int high = i + 2 < length ? hex_value(text[i + 1]) : -1;
+            int low = high >= 0 ? hex_value(text[i + 2]) : -1;
+            if (low < 0 || high * 16 + low == 0) {
+                return -1;
+            }
+            byte = (char)(high * 16 + low);
+            i += 2;
+        }
+        if (written + 1 >= size) {
+            return -1;
+        }
+        output[written++] = byte;
+    }
+    output[written] = '\0';
+    return (int)written;
+}
+
+static int parse_epoch(const char* text, int64_t* epoch) {
+    char* end = NULL;
+    long long value = strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || value > QUERY_MAX_EPOCH || value < -QUERY_MAX_EPOCH) {
+        return -1;
+    }
+    *epoch = (int64_t)value;
+    return 0;
+}
+
+binary_clock_error_t binary_clock_query_parse(const char* target, size_t length, binary_clock_query_request_t* request) {
+    if (target == NULL || request == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (!is_at_path(target, length)) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    binary_clock_query_request_t parsed;
+    memset(&parsed, 0, sizeof(parsed));
+    strcpy(parsed.zone, "UTC");
+    parsed.format = BINARY_CLOCK_RENDER_JSON;
+    bool has_time = false;
+
+    for (size_t position = 4; position < length;) {
+        const char* parameter = target + position;
+        const char* end = memchr(parameter, '&', length - position);
+        size_t parameter_length = end != NULL ? (size_t)(end - parameter) : length - position;
+        position += parameter_length + 1;
+        const char* equals = memchr(parameter, '=', parameter_length);
+        if (equals == NULL) {
+            continue;
+        }
+        size_t name_length = (size_t)(equals - parameter);
+        char value[BINARY_CLOCK_ZONE_NAME_SIZE];
+        int value_length = decode(equals + 1, parameter_length - name_length - 1, value, sizeof(value));
+
+        if (name_length == 1 && parameter[0] == 't') {
+            if (value_length <= 0 || parse_epoch(value, &parsed.epoch) != 0) {
+                return BINARY_CLOCK_ERROR_INVALID_TIME;
+            }
+            has_time = true;
+        } else if (name_length == 2 && memcmp(parameter, "tz", 2) == 0) {
+            if (value_length <= 0) {
+                return BINARY_CLOCK_ERROR_OUTPUT;
+            }
+            memcpy(parsed.zone, value, (size_t)value_length + 1);
+        } else if (name_length == 3 && memcmp(parameter, "fmt", 3) == 0) {
+            size_t i = 0;
+            while (i < QUERY_FORMAT_COUNT && (value_length < 0 || strcmp(value, query_formats[i].name) != 0)) {
+                i++;
+            }
+            if (i == QUERY_FORMAT_COUNT) {
+                return BINARY_CLOCK_ERROR_OUTPUT;
+            }
+            parsed.format = query_formats[i].format;
+        }
+    }
+    if (!has_time) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+    *request = parsed;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+/* ========================================================================== */
+/* RESPONSE CACHE                                                             */
+/* ========================================================================== */
+
+static uint64_t key_hash(int64_t second, uint16_t zone, uint16_t format) {
+    uint64_t hash = (uint64_t)second * 0x9E3779B97F4A7C15ULL ^
+                    ((uint64_t)zone << 16 | format) * 0xC2B2AE3D27D4EB4FULL;
+    return hash ^ hash >> 29;
+}
+
+// Shards from the high half of the hash, buckets from the low half
+static binary_clock_query_shard_t* shard_for(binary_clock_query_cache_t* cache, uint64_t hash) {
+    return &cache->shards[(hash >> 32) & (BINARY_CLOCK_QUERY_CACHE_SHARDS - 1)];
+}
+
+static uint32_t bucket_count(size_t entries) {
+    uint32_t buckets = 1;
+    while (buckets < entries) {
+        buckets *= 2;
+    }
+    return buckets;
+}
+
+static size_t cache_bytes(size_t per_shard) {
+    return BINARY_CLOCK_QUERY_CACHE_SHARDS *
+           (per_shard * sizeof(binary_clock_query_entry_t) + bucket_count(per_shard) * sizeof(uint32_t));
+}
+
+binary_clock_error_t binary_clock_query_cache_init(binary_clock_query_cache_t* cache, size_t entries) {
+    if (cache == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(cache, 0, sizeof(*cache));
+    // The lock type stays out of the header, so callers need no thread headers
+    query_lock_t* locks = malloc(BINARY_CLOCK_QUERY_CACHE_SHARDS * sizeof(*locks));
+    if (locks == NULL) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        cache->shards[i].newest = BINARY_CLOCK_QUERY_CACHE_NONE;
+        cache->shards[i].oldest = BINARY_CLOCK_QUERY_CACHE_NONE;
+        if (QUERY_LOCK_INIT(&locks[i]) != 0) {
+            while (--i >= 0) {
+                QUERY_LOCK_DESTROY(&locks[i]);
+            }
+            free(locks);
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        cache->shards[i].lock = &locks[i];
+    }
+    cache->locks = locks;
+    if (entries == 0) {
+        return BINARY_CLOCK_SUCCESS;
+    }
+
+    size_t per_shard = (entries + BINARY_CLOCK_QUERY_CACHE_SHARDS - 1) / BINARY_CLOCK_QUERY_CACHE_SHARDS;
+    if (per_shard > UINT32_MAX / 2) {
+        per_shard = UINT32_MAX / 2;
+    }
+    // Over the caches cap, hold fewer responses
+    if (!binary_clock_mem_reserve(BINARY_CLOCK_MEM_CACHES, cache_bytes(per_shard))) {
+        while (per_shard > 1 && cache_bytes(per_shard) > binary_clock_mem_available(BINARY_CLOCK_MEM_CACHES)) {
+            per_shard /= 2;
+        }
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_CACHES, cache_bytes(per_shard));
+    }
+    cache->bytes = cache_bytes(per_shard);
+
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        binary_clock_query_shard_t* shard = &cache->shards[i];
+        uint32_t buckets = bucket_count(per_shard);
+        shard->entries = malloc(per_shard * sizeof(*shard->entries));
+        shard->buckets = malloc(buckets * sizeof(*shard->buckets));
+        if (shard->entries == NULL || shard->buckets == NULL) {
+            binary_clock_query_cache_free(cache);
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        memset(shard->buckets, 0xFF, buckets * sizeof(*shard->buckets)); // BINARY_CLOCK_QUERY_CACHE_NONE
+        shard->capacity = (uint32_t)per_shard;
+        shard->bucket_mask = buckets - 1;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+static uint32_t find_entry(const binary_clock_query_shard_t* shard, uint64_t hash,
+                           int64_t second, uint16_t zone, uint16_t format) {
+    uint32_t index = shard->buckets[hash & shard->bucket_mask];
+    while (index != BINARY_CLOCK_QUERY_CACHE_NONE) {
+        const binary_clock_query_entry_t* entry = &shard->entries[index];
+        if (entry->second == second && entry->zone == zone && entry->format == format) {
+            return index;
+        }
+        index = entry->chain;
+    }
+    return BINARY_CLOCK_QUERY_CACHE_NONE;
+}
+
+static void unlink_entry(binary_clock_query_shard_t* shard, uint32_t index) {
+    binary_clock_query_entry_t* entry = &shard->entries[index];
+    if (entry->newer != BINARY_CLOCK_QUERY_CACHE_NONE) {
+        shard->entries[entry->newer].older = entry->older;
+    } else {
+        shard->newest = entry->older;
+    }
+    if (entry->older != BINARY_CLOCK_QUERY_CACHE_NONE) {
+        shard->entries[entry->older].newer = entry->newer;
+    } else {
+        shard->oldest = entry->newer;
+    }
+}
+
+static void push_newest(binary_clock_query_shard_t* shard, uint32_t index) {
+    binary_clock_query_entry_t* entry = &shard->entries[index];
+    entry->newer = BINARY_CLOCK_QUERY_CACHE_NONE;
+    entry->older = shard->newest;
+    if (shard->newest != BINARY_CLOCK_QUERY_CACHE_NONE) {
+        shard->entries[shard->newest].newer = index;
+    } else {
+        shard->oldest = index;
+    }
+    shard->newest = index;
+}
+
+// Take the least recently used entry out of its list and hash chain
+static uint32_t evict_oldest(binary_clock_query_shard_t* shard) {
+    uint32_t index = shard->oldest;
+    binary_clock_query_entry_t* entry = &shard->entries[index];
+    unlink_entry(shard, index);
+    uint32_t* link = &shard->buckets[key_hash(entry->second, entry->zone, entry->format) & shard->bucket_mask];
+    while (*link != index) {
+        link = &shard->entries[*link].chain;
+    }
+    *link = entry->chain;
+    shard->evictions++;
+    return index;
+}
+
+size_t binary_clock_query_cache_get(binary_clock_query_cache_t* cache, int64_t second, uint16_t zone,
+                                    uint16_t format, char* output, size_t size) {
+    if (cache == NULL || output == NULL || cache->locks == NULL) {
+        return 0;
+    }
+    uint64_t hash = key_hash(second, zone, format);
+    binary_clock_query_shard_t* shard = shard_for(cache, hash);
+    size_t length = 0;
+    QUERY_LOCK((query_lock_t*)shard->lock);
+    uint32_t index = shard->capacity > 0 ? find_entry(shard, hash, second, zone, format) : BINARY_CLOCK_QUERY_CACHE_NONE;
+    if (index != BINARY_CLOCK_QUERY_CACHE_NONE && shard->entries[index].length <= size) {
+        unlink_entry(shard, index);
+        push_newest(shard, index);
+        length = shard->entries[index].length;
+        memcpy(output, shard->entries[index].data, length);
+        shard->hits++;
+    } else {
+        shard->misses++;
+    }
+    QUERY_UNLOCK((query_lock_t*)shard->lock);
+    return length;
+}
+
+void binary_clock_query_cache_put(binary_clock_query_cache_t* cache, int64_t second, uint16_t zone,
+                                  uint16_t format, const char* data, size_t length) {
+    if (cache == NULL || data == NULL || length > BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE || cache->locks == NULL) {
+        return;
+    }
+    uint64_t hash = key_hash(second, zone, format);
+    binary_clock_query_shard_t* shard = shard_for(cache, hash);
+    QUERY_LOCK((query_lock_t*)shard->lock);
+    if (shard->capacity == 0) {
+        QUERY_UNLOCK((query_lock_t*)shard->lock);
+        return;
+    }
+    uint32_t index = find_entry(shard, hash, second, zone, format);
+    if (index != BINARY_CLOCK_QUERY_CACHE_NONE) {
+        unlink_entry(shard, index);
+    } else {
+        index = shard->count < shard->capacity ? shard->count++ : evict_oldest(shard);
+        binary_clock_query_entry_t* entry = &shard->entries[index];
+        entry->second = second;
+        entry->zone = zone;
+        entry->format = format;
+        entry->chain = shard->buckets[hash & shard->bucket_mask];
+        shard->buckets[hash & shard->bucket_mask] = index;
+    }
+    memcpy(shard->entries[index].data, data, length);
+    shard->entries[index].length = (uint32_t)length;
+    push_newest(shard, index);
+    QUERY_UNLOCK((query_lock_t*)shard->lock);
+}
+
+binary_clock_query_cache_stats_t binary_clock_query_cache_get_stats(binary_clock_query_cache_t* cache) {
+    binary_clock_query_cache_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    if (cache == NULL || cache->locks == NULL) {
+        return stats;
+    }
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        binary_clock_query_shard_t* shard = &cache->shards[i];
+        QUERY_LOCK((query_lock_t*)shard->lock);
+        stats.hits += shard->hits;
+        stats.misses += shard->misses;
+        stats.evictions += shard->evictions;
+        stats.entries += shard->count;
+        stats.capacity += shard->capacity;
+        QUERY_UNLOCK((query_lock_t*)shard->lock);
+    }
+    return stats;
+}
+
+void binary_clock_query_cache_free(binary_clock_query_cache_t* cache) {
+    if (cache == NULL) {
+        return;
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_CACHES, cache->bytes);
+    query_lock_t* locks = cache->locks;
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        free(cache->shards[i].entries);
+        free(cache->shards[i].buckets);
+        if (locks != NULL) {
+            QUERY_LOCK_DESTROY(&locks[i]);
+        }
+    }
+    free(locks);
+    memset(cache, 0, sizeof(*cache));
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        cache->shards[i].newest = BINARY_CLOCK_QUERY_CACHE_NONE;
+        cache->shards[i].oldest = BINARY_CLOCK_QUERY_CACHE_NONE;
+    }
+}
+
+/* ========================================================================== */
+/* RESPONDER                                                                  */
+/* ========================================================================== */
+
+static const char bad_request_body[] =
+    "bad query: expected /at?t=EPOCH[&tz=ZONE][&fmt=json|ndjson|emoji|binary]\n";
+
+binary_clock_error_t binary_clock_query_init(binary_clock_query_t* query, size_t cache_entries,
+                                             const char* zone_directory) {
+    if (query == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(query, 0, sizeof(*query));
+    query->zone_directory = zone_directory;
+    query->render = binary_clock_display_render;
+    binary_clock_zone_init_fixed(&query->zones[0], "UTC", 0);
+    query->zone_count = 1;
+    return binary_clock_query_cache_init(&query->cache, cache_entries);
+}
+
+binary_clock_error_t binary_clock_query_add_zone(binary_clock_query_t* query, const char* name, size_t* index) {
+    if (query == NULL || name == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    size_t found = 0;
+    while (found < query->zone_count && strcmp(query->zones[found].name, name) != 0) {
+        found++;
+    }
+    if (found == query->zone_count) {
+        if (query->zone_count == BINARY_CLOCK_QUERY_MAX_ZONES) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        binary_clock_error_t error = binary_clock_zone_load(&query->zones[found], name, query->zone_directory);
+        if (error != BINARY_CLOCK_SUCCESS) {
+            return error;
+        }
+        query->zone_count++;
+    }
+    if (index != NULL) {
+        *index = found;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_query_seal_zones(binary_clock_query_t* query) {
+    if (query != NULL) {
+        query->zones_sealed = true;
+    }
+}
+
+int binary_clock_query_resolve_zone(binary_clock_query_t* query, const char* name, size_t* index) {
+    size_t found = 0;
+    while (found < query->zone_count && strcmp(query->zones[found].name, name) != 0) {
+        found++;
+    }
+    if (found == query->zone_count) {
+        if (query->zones_sealed) {
+            return 404;
+        }
+        // A full table is the server's limit, not the client's mistake
+        if (query->zone_count == BINARY_CLOCK_QUERY_MAX_ZONES) {
+            return 503;
+        }
+        if (binary_clock_query_add_zone(query, name, &found) != BINARY_CLOCK_SUCCESS) {
+            return 404;
+        }
+    }
+    *index = found;
+    return 200;
+}
+
+static size_t build_response(char* output, size_t size, const char* status, const char* content_type,
+                             const char* body, size_t body_length) {
+    int header = snprintf(output, size,
+                          "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %lu\r\nConnection: close\r\n\r\n",
+                          status, content_type, (unsigned long)body_length);
+    if (header < 0 || (size_t)header >= size || body_length > size - (size_t)header) {
+        return 0;
+    }
+    memcpy(output + header, body, body_length);
+    return (size_t)header + body_length;
+}
+
+const char* binary_clock_query_content_type(binary_clock_render_format_t format) {
+    for (size_t i = 0; i < QUERY_FORMAT_COUNT; i++) {
+        if (query_formats[i].format == format) {
+            return query_formats[i].content_type;
+        }
+    }
+    return "text/plain; charset=utf-8";
+}
+
+static void record_latency(binary_clock_query_stats_t* stats, int64_t start_ns) {
+    uint64_t elapsed = (uint64_t)(monotonic_ns() - start_ns);
+    int bucket = 0;
+    while (bucket < BINARY_CLOCK_QUERY_LATENCY_BUCKETS - 1 && (elapsed >> bucket) != 0) {
+        bucket++;
+    }
+    stats->latency[bucket]++;
+    stats->latency_ns += elapsed;
+    stats->requests++;
+}
+
+// Convert, render and cache the response for a parsed query
+static size_t answer(binary_clock_query_t* query, const binary_clock_query_request_t* request, size_t zone,
+                     char* output, size_t size) {
+    int32_t offset = binary_clock_zone_offset(&query->zones[zone], request->epoch);
+    binary_clock_state_t state = binary_clock_state_from_epoch(request->epoch, offset);
+    char body[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t body_length = query->render(&state, request->format, body, sizeof(body));
+    size_t length = build_response(output, size, "200 OK", binary_clock_query_content_type(request->format), body, body_length);
+    if (length > 0) {
+        binary_clock_query_cache_put(&query->cache, request->epoch, (uint16_t)zone, (uint16_t)request->format,
+                                     output, length);
+    }
+    return length;
+}
+
+size_t binary_clock_query_respond(binary_clock_query_t* query, const char* target, size_t length,
+                                  char* output, size_t size) {
+    if (query == NULL || target == NULL || output == NULL) {
+        return 0;
+    }
+    int64_t start_ns = monotonic_ns();
+    const char* text = "text/plain; charset=utf-8";
+    binary_clock_query_request_t request;
+    size_t zone = 0;
+    size_t written = 0;
+    int zone_status = 0;
+
+    if (!is_at_path(target, length)) {
+        query->stats.not_found++;
+        written = build_response(output, size, "404 Not Found", text, "not found\n", 10);
+    } else if (binary_clock_query_parse(target, length, &request) != BINARY_CLOCK_SUCCESS) {
+        query->stats.bad_requests++;
+        written = build_response(output, size, "400 Bad Request", text, bad_request_body, sizeof(bad_request_body) - 1);
+    } else if ((zone_status = binary_clock_query_resolve_zone(query, request.zone, &zone)) == 503) {
+        query->stats.unavailable++;
+        written = build_response(output, size, "503 Service Unavailable", text, "zone table full\n", 16);
+    } else if (zone_status != 200) {
+        query->stats.not_found++;
+        written = build_response(output, size, "404 Not Found", text, "unknown zone\n", 13);
+    } else {
+        written = binary_clock_query_cache_get(&query->cache, request.epoch, (uint16_t)zone,
+                                               (uint16_t)request.format, output, size);
+        if (written > 0) {
+            query->stats.hits++;
+        } else {
+            query->stats.misses++;
+            written = answer(query, &request, zone, output, size);
+        }
+    }
+    record_latency(&query->stats, start_ns);
+    return written;
+}
+
+uint64_t binary_clock_query_latency_percentile(const binary_clock_query_stats_t* stats, double percent) {
+    if (stats == NULL) {
+        return 0;
+    }
+    uint64_t total = 0;
+    for (int i = 0; i < BINARY_CLOCK_QUERY_LATENCY_BUCKETS; i++) {
+        total += stats->latency[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    double wanted = (double)total * percent / 100.0;
+    uint64_t seen = 0;
+    for (int i = 0; i < BINARY_CLOCK_QUERY_LATENCY_BUCKETS; i++) {
+        seen += stats->latency[i];
+        if ((double)seen >= wanted && seen > 0) {
+            return (uint64_t)1 << i;
+        }
+    }
+    return (uint64_t)1 << (BINARY_CLOCK_QUERY_LATENCY_BUCKETS - 1);
+}
+
+size_t binary_clock_query_report(const binary_clock_query_t* query, char* buffer, size_t size) {
+    if (query == NULL || buffer == NULL || size == 0) {
+        return 0;
+    }
+    const binary_clock_query_stats_t* stats = &query->stats;
+    uint64_t answered = stats->hits + stats->misses;
+    int length = snprintf(buffer, size,
+                          "%llu requests, %.1f%% cache hits, mean %.2f us, p50 < %.2f us, p99 < %.2f us, "
+                          "%lu zones loaded",
+                          (unsigned long long)stats->requests,
+                          answered > 0 ? 100.0 * (double)stats->hits / (double)answered : 0.0,
+                          stats->requests > 0 ? (double)stats->latency_ns / (double)stats->requests / 1000.0 : 0.0,
+                          (double)binary_clock_query_latency_percentile(stats, 50) / 1000.0,
+                          (double)binary_clock_query_latency_percentile(stats, 99) / 1000.0,
+                          (unsigned long)query->zone_count);
+    if (length < 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return (size_t)length < size ? (size_t)length : size - 1;
+}
+
+void binary_clock_query_free(binary_clock_query_t* query) {
+    if (query == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < query->zone_count; i++) {
+        binary_clock_zone_free(&query->zones[i]);
+    }
+    query->zone_count = 0;
+    binary_clock_query_cache_free(&query->cache);
+}
+
+/* ========================================================================== */
+/* SERVER                                                                     */
+/* ========================================================================== */
+
+#ifdef _WIN32
+
+binary_clock_error_t binary_clock_query_server_open(binary_clock_query_server_t* server, binary_clock_query_t* query,
+                                                    const char* address, uint16_t port) {
+    (void)address; (void)port;
+    if (server == NULL || query == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->query = query;
+    return BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_query_server_poll(binary_clock_query_server_t* server, int timeout_ms) {
+    (void)timeout_ms;
+    return server == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_ERROR_NETWORK;
+}
+
+void binary_clock_query_server_close(binary_clock_query_server_t* server) {
+    (void)server;
+}
+
+#else
+
+#ifdef MSG_NOSIGNAL
+    #define QUERY_SEND_FLAGS MSG_NOSIGNAL
+#else
+    #define QUERY_SEND_FLAGS 0  // SO_NOSIGPIPE is set per socket instead
+#endif
+
+// New connections taken per poll, and slots added at a time over the queues cap
+#define QUERY_ACCEPT_BATCH 64
+#define CONNECTION_LEAN_GROWTH 16
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// Connection slots plus the poll set, with one extra poll slot for the listening socket
+static size_t connection_bytes(size_t capacity) {
+    return capacity > 0 ? capacity * sizeof(binary_clock_query_connection_t) + (capacity + 1) * sizeof(struct pollfd) : 0;
+}
+
+static int grow_connections(binary_clock_query_server_t* server) {
+    size_t capacity = server->connection_capacity > 0 ? server->connection_capacity * 2 : 16;
+    size_t held = connection_bytes(server->connection_capacity);
+    if (!binary_clock_mem_reserve(BINARY_CLOCK_MEM_QUEUES, connection_bytes(capacity) - held)) {
+        capacity = server->connection_capacity + CONNECTION_LEAN_GROWTH;
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, connection_bytes(capacity) - held);
+    }
+    binary_clock_query_connection_t* connections = realloc(server->connections, capacity * sizeof(*connections));
+    if (connections == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, connection_bytes(capacity) - held);
+        return -1;
+    }
+    server->connections = connections;
+    struct pollfd* poll_set = realloc(server->poll_set, (capacity + 1) * sizeof(*poll_set));
+    if (poll_set == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, connection_bytes(capacity) - held);
+        return -1;
+    }
+    server->poll_set = poll_set;
+    server->connection_capacity = capacity;
+    return 0;
+}
+
+// Answer a complete request head: "GET <target> HTTP/1.x"
+static void answer_request(binary_clock_query_server_t* server, binary_clock_query_connection_t* connection) {
+    const char* line = connection->request;
+    const char* line_end = memchr(line, '\r', connection->received);
+    const char* target = line + 4;
+    const char* target_end = line_end != NULL ? memchr(target, ' ', (size_t)(line_end - target)) : NULL;
+    if (connection->received < 4 || memcmp(line, "GET ", 4) != 0 || target_end == NULL) {
+        server->query->stats.bad_requests++;
+        connection->response_length = build_response(connection->response, sizeof(connection->response),
+                                                     "400 Bad Request", "text/plain; charset=utf-8",
+                                                     bad_request_body, sizeof(bad_request_body) - 1);
+        return;
+    }
+    connection->response_length = binary_clock_query_respond(server->query, target, (size_t)(target_end - target),
+                                                             connection->response, sizeof(connection->response));
+}
+
+// Read what arrived and write what is due; -1 once the connection is done
+static int service(binary_clock_query_server_t* server, binary_clock_query_connection_t* connection) {
+    while (connection->response_length == 0) {
+        size_t room = sizeof(connection->request) - connection->received;
+        ssize_t got = recv(connection->fd, connection->request + connection->received, room, 0);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        if (got == 0) {
+            return -1;
+        }
+        size_t searched = connection->received >= 3 ? connection->received - 3 : 0;
+        connection->received += (size_t)got;
+        bool complete = false;
+        for (size_t i = searched; i + 4 <= connection->received && !complete; i++) {
+            complete = memcmp(connection->request + i, "\r\n\r\n", 4) == 0;
+        }
+        if (complete || connection->received == sizeof(connection->request)) {
+            // An oversized head is answered from its request line alone
+            answer_request(server, connection);
+            if (connection->response_length == 0) {
+                return -1;
+            }
+        }
+    }
+    while (connection->sent < connection->response_length) {
+        ssize_t sent = send(connection->fd, connection->response + connection->sent,
+                            connection->response_length - connection->sent, QUERY_SEND_FLAGS);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        connection->sent += (size_t)sent;
+    }
+    return -1;
+}
+
+static void accept_connections(binary_clock_query_server_t* server) {
+    for (int taken = 0; taken < QUERY_ACCEPT_BATCH; taken++) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        if (set_nonblocking(fd) != 0 ||
+            (server->connection_count == server->connection_capacity && grow_connections(server) != 0)) {
+            close(fd);
+            continue;
+        }
+        binary_clock_query_connection_t* connection = &server->connections[server->connection_count++];
+        connection->fd = fd;
+        connection->received = 0;
+        connection->sent = 0;
+        connection->response_length = 0;
+    }
+}
+
+binary_clock_error_t binary_clock_query_server_open(binary_clock_query_server_t* server, binary_clock_query_t* query,
+                                                    const char* address, uint16_t port) {
+    if (server == NULL || query == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->query = query;
+
+    struct sockaddr_in local = {0};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (address != NULL && inet_pton(AF_INET, address, &local.sin_addr) != 1) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+    int reuse = 1;
+    socklen_t bound_length = sizeof(local);
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(fd, (const struct sockaddr*)&local, sizeof(local)) != 0 ||
+        listen(fd, SOMAXCONN) != 0 || set_nonblocking(fd) != 0 ||
+        getsockname(fd, (struct sockaddr*)&local, &bound_length) != 0 ||
+        grow_connections(server) != 0) {
+        close(fd);
+        binary_clock_query_server_close(server);
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+    server->listen_fd = fd;
+    server->port = ntohs(local.sin_port);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_query_server_poll(binary_clock_query_server_t* server, int timeout_ms) {
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (server->listen_fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    struct pollfd* poll_set = server->poll_set;
+    size_t count = server->connection_count;
+    poll_set[0].fd = server->listen_fd;
+    poll_set[0].events = POLLIN;
+    for (size_t i = 0; i < count; i++) {
+        poll_set[i + 1].fd = server->connections[i].fd;
+        poll_set[i + 1].events = server->connections[i].response_length > 0 ? POLLOUT : POLLIN;
+    }
+
+    int ready = poll(poll_set, (nfds_t)(count + 1), timeout_ms);
+    if (ready < 0) {
+        return errno == EINTR ? BINARY_CLOCK_ERROR_TIMEOUT : BINARY_CLOCK_ERROR_NETWORK;
+    }
+    if (ready == 0) {
+        return BINARY_CLOCK_ERROR_TIMEOUT;
+    }
+
+    // Connections first, keeping the open ones in order: accepting may
+    // reallocate the poll set
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        binary_clock_query_connection_t* connection = &server->connections[i];
+        short revents = poll_set[i + 1].revents;
+        bool done = (revents & (POLLERR | POLLNVAL)) != 0 || (revents != 0 && service(server, connection) != 0);
+        if (done) {
+            close(connection->fd);
+        } else if (kept != i) {
+            server->connections[kept++] = *connection;
+        } else {
+            kept++;
+        }
+    }
+    server->connection_count = kept;
+    if (poll_set[0].revents & POLLIN) {
+        accept_connections(server);
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_query_server_close(binary_clock_query_server_t* server) {
+    if (server == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < server->connection_count; i++) {
+        close(server->connections[i].fd);
+    }
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, connection_bytes(server->connection_capacity));
+    free(server->connections);
+    free(server->poll_set);
+    binary_clock_query_t* query = server->query;
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->query = query;
+}
+
+#endif
@@ -0,0 +1,303 @@
+/**
+ * @file binary_clock_sim.c
+ * @brief Binary Clock Fleet Simulation Implementation
+ *
+ * Each group of clocks is loaded once, stepped as many times as asked in
+ * registers, and stored once, so long runs cost no memory traffic per
+ * step. The vector and scalar kernels share their constants and do the
+ * same operations; the scalar one handles range ends that do not fill a
+ * vector, and every clock on compilers without vector extensions.
+ */
+
+#include <binary_clock_sim.h>
+#include <binary_clock_mem.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Added before a step so every digit carries in binary at its own base:
+// 6 on units (base 10), 10 on minute and second tens (base 6)
+#define DIGIT_BIAS 0x06A6A6u
+// Lowest bit of each digit that can receive a carry
+#define CARRY_BITS 0x111110u
+// Carries out of digits biased by 6 and by 10
+#define CARRY_BITS_6 0x101010u
+#define CARRY_BITS_10 0x010100u
+
+#define HOURS_MASK 0xFF0000u
+#define HOURS_LIMIT_24 0x240000u
+#define HOURS_LIMIT_12 0x130000u
+#define HOURS_NOON 0x120000u
+#define HOURS_RESET_12 0x010000u
+#define SECONDS_MASK 0x0000FFu
+#define ALL_LEDS (0xFFFFFFu | BINARY_CLOCK_SIM_PM_BIT)
+
+#define ARRAY_ALIGN 64
+
+#if defined(__GNUC__) && !defined(BINARY_CLOCK_SIM_SCALAR)
+    #define SIM_HAS_VECTORS 1
+    #define LANES 4
+typedef uint32_t lanes_t __attribute__((vector_size(16)));
+typedef int32_t signed_lanes_t __attribute__((vector_size(16)));
+#else
+    #define SIM_HAS_VECTORS 0
+#endif
+
+static size_t align_up(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+binary_clock_error_t binary_clock_sim_init(binary_clock_sim_t* sim, size_t count, bool accumulate) {
+    if (sim == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(sim, 0, sizeof(*sim));
+    if (count > (SIZE_MAX - 2 * ARRAY_ALIGN) / 32) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    size_t capacity = align_up(count > 0 ? count : 1, BINARY_CLOCK_SIM_SHARD_ALIGN);
+    size_t words = align_up(capacity * sizeof(uint32_t), ARRAY_ALIGN);
+    size_t bytes = align_up(capacity, ARRAY_ALIGN);
+    int word_arrays = accumulate ? 6 : 4;
+    size_t size = (size_t)word_arrays * words + bytes + ARRAY_ALIGN;
+    sim->block = calloc(1, size);
+    if (sim->block == NULL) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    // Every array starts on its own cache line
+    char* next = (char*)sim->block + (ARRAY_ALIGN - (size_t)((uintptr_t)sim->block % ARRAY_ALIGN)) % ARRAY_ALIGN;
+    sim->leds = (uint32_t*)(void*)next;
+    next += words;
+    sim->phase = (uint32_t*)(void*)next;
+    next += words;
+    sim->rate = (int32_t*)(void*)next;
+    next += words;
+    sim->changed = (uint32_t*)(void*)next;
+    next += words;
+    if (accumulate) {
+        sim->toggles = (uint32_t*)(void*)next;
+        next += words;
+        sim->lit = (uint32_t*)(void*)next;
+        next += words;
+    }
+    sim->layout = (uint8_t*)next;
+
+    sim->count = count;
+    sim->capacity = capacity;
+    sim->bytes = size;
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_REGISTRY, size);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_sim_set_clock(binary_clock_sim_t* sim, size_t index, int64_t epoch_seconds,
+                                                int32_t offset_seconds, double drift_ppm, uint8_t layout) {
+    if (sim == NULL || sim->block == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (index >= sim->count || !(drift_ppm >= -BINARY_CLOCK_SIM_MAX_DRIFT_PPM &&
+                                 drift_ppm <= BINARY_CLOCK_SIM_MAX_DRIFT_PPM) ||
+        (layout & ~(BINARY_CLOCK_SIM_12_HOUR | BINARY_CLOCK_SIM_NO_SECONDS)) != 0) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch_seconds, offset_seconds);
+    uint32_t leds = binary_clock_pack_state(&state);
+    if (layout & BINARY_CLOCK_SIM_12_HOUR) {
+        uint32_t hours = (uint32_t)state.hours_tens.decimal_value * 10 + state.hours_units.decimal_value;
+        uint32_t shown = hours % 12 == 0 ? 12 : hours % 12;
+        leds = (leds & ~HOURS_MASK) | (shown / 10) << BINARY_CLOCK_PACKED_HOURS_TENS_SHIFT |
+               (shown % 10) << BINARY_CLOCK_PACKED_HOURS_UNITS_SHIFT;
+        if (hours >= 12) {
+            leds |= BINARY_CLOCK_SIM_PM_BIT;
+        }
+    }
+
+    double rate = drift_ppm * 4294.967296;  // 2^32 / 10^6
+    sim->leds[index] = leds;
+    sim->phase[index] = 0;
+    sim->rate[index] = (int32_t)(rate < 0 ? rate - 0.5 : rate + 0.5);
+    sim->layout[index] = layout;
+    sim->changed[index] = 0;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+static uint32_t popcount(uint32_t x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    return (x * 0x01010101u) >> 24;
+}
+
+// One clock, steps times
+static void step_clock(binary_clock_sim_t* sim, size_t i, uint32_t steps) {
+    uint32_t leds = sim->leds[i];
+    uint32_t phase = sim->phase[i];
+    int32_t rate = sim->rate[i];
+    uint32_t twelve = (sim->layout[i] & BINARY_CLOCK_SIM_12_HOUR) ? ~0u : 0;
+    uint32_t visible = (sim->layout[i] & BINARY_CLOCK_SIM_NO_SECONDS) ? ALL_LEDS & ~SECONDS_MASK : ALL_LEDS;
+    uint32_t limit = twelve ? HOURS_LIMIT_12 : HOURS_LIMIT_24;
+    uint32_t reset = twelve & HOURS_RESET_12;
+    uint32_t changed = 0, toggles = 0, lit = 0;
+
+    for (uint32_t s = 0; s < steps; s++) {
+        uint32_t next_phase = phase + (uint32_t)rate;
+        uint32_t ticks = 1 + (rate > 0 && next_phase < phase) - (rate < 0 && next_phase > phase);
+        phase = next_phase;
+
+        uint32_t biased = leds + DIGIT_BIAS;
+        uint32_t sum = biased + ticks;
+        uint32_t kept = ~(sum ^ biased ^ ticks) & CARRY_BITS;
+        uint32_t next = sum - ((kept & CARRY_BITS_6) >> 2 | (kept & CARRY_BITS_6) >> 3 |
+                               (kept & CARRY_BITS_10) >> 1 | (kept & CARRY_BITS_10) >> 3);
+        if ((next & HOURS_MASK) == limit) {
+            next = (next & ~HOURS_MASK) | reset;
+        }
+        if (twelve && (next & HOURS_MASK) == HOURS_NOON && (leds & HOURS_MASK) != HOURS_NOON) {
+            next ^= BINARY_CLOCK_SIM_PM_BIT;
+        }
+
+        changed = (leds ^ next) & visible;
+        toggles += popcount(changed);
+        lit += popcount(next & visible);
+        leds = next;
+    }
+
+    sim->leds[i] = leds;
+    sim->phase[i] = phase;
+    sim->changed[i] = changed;
+    if (sim->toggles != NULL) {
+        sim->toggles[i] += toggles;
+        sim->lit[i] += lit;
+    }
+}
+
+#if SIM_HAS_VECTORS
+// Shifts and adds only: SSE2 has no 32-bit lane multiply
+static lanes_t popcount_lanes(lanes_t x) {
+    x = x - ((x >> 1) & 0x55555555u);
+    x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+    x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+    x += x >> 8;
+    x += x >> 16;
+    return x & 0x3F;
+}
+
+// LANES clocks from i, steps times; comparisons give -1 for true lanes
+static void step_lanes(binary_clock_sim_t* sim, size_t i, uint32_t steps) {
+    lanes_t leds, phase;
+    signed_lanes_t rate;
+    memcpy(&leds, sim->leds + i, sizeof(leds));
+    memcpy(&phase, sim->phase + i, sizeof(phase));
+    memcpy(&rate, sim->rate + i, sizeof(rate));
+    lanes_t flags;
+    for (int lane = 0; lane < LANES; lane++) {
+        flags[lane] = sim->layout[i + lane];
+    }
+
+    lanes_t twelve = -(flags & BINARY_CLOCK_SIM_12_HOUR);
+    lanes_t visible = ALL_LEDS & ~(-((flags >> 1) & 1) & SECONDS_MASK);
+    lanes_t limit = HOURS_LIMIT_24 - (twelve & (HOURS_LIMIT_24 - HOURS_LIMIT_12));
+    lanes_t reset = twelve & HOURS_RESET_12;
+    // Adding a negative rate as unsigned carries unless the phase wraps back
+    lanes_t base = 1 + (lanes_t)(rate < 0);
+    lanes_t addend = (lanes_t)rate;
+    lanes_t changed = {0}, toggles = {0}, lit = {0};
+
+    for (uint32_t s = 0; s < steps; s++) {
+        lanes_t next_phase = phase + addend;
+        lanes_t ticks = base + (((phase & addend) | ((phase | addend) & ~next_phase)) >> 31);
+        phase = next_phase;
+
+        lanes_t biased = leds + DIGIT_BIAS;
+        lanes_t sum = biased + ticks;
+        lanes_t kept = ~(sum ^ biased ^ ticks) & CARRY_BITS;
+        lanes_t next = sum - ((kept & CARRY_BITS_6) >> 2 | (kept & CARRY_BITS_6) >> 3 |
+                              (kept & CARRY_BITS_10) >> 1 | (kept & CARRY_BITS_10) >> 3);
+        lanes_t wrap = (lanes_t)((next & HOURS_MASK) == limit);
+        next = (next & ~(wrap & HOURS_MASK)) | (wrap & reset);
+        lanes_t noon = (lanes_t)((next & HOURS_MASK) == HOURS_NOON) & (lanes_t)((leds & HOURS_MASK) != HOURS_NOON);
+        next ^= twelve & noon & BINARY_CLOCK_SIM_PM_BIT;
+
+        changed = (leds ^ next) & visible;
+        toggles += popcount_lanes(changed);
+        lit += popcount_lanes(next & visible);
+        leds = next;
+    }
+
+    memcpy(sim->leds + i, &leds, sizeof(leds));
+    memcpy(sim->phase + i, &phase, sizeof(phase));
+    memcpy(sim->changed + i, &changed, sizeof(changed));
+    if (sim->toggles != NULL) {
+        lanes_t total;
+        memcpy(&total, sim->toggles + i, sizeof(total));
+        total += toggles;
+        memcpy(sim->toggles + i, &total, sizeof(total));
+        memcpy(&total, sim->lit + i, sizeof(total));
+        total += lit;
+        memcpy(sim->lit + i, &total, sizeof(total));
+    }
+}
+#endif
+
+void binary_clock_sim_step_range(binary_clock_sim_t* sim, size_t first, size_t count, uint32_t steps) {
+    if (sim == NULL || sim->block == NULL || first >= sim->count || steps == 0) {
+        return;
+    }
+    size_t end = count < sim->count - first ? first + count : sim->count;
+    size_t i = first;
+#if SIM_HAS_VECTORS
+    for (; i < end && i % LANES != 0; i++) {
+        step_clock(sim, i, steps);
+    }
+    for (; i + LANES <= end; i += LANES) {
+        step_lanes(sim, i, steps);
+    }
+#endif
+    for (; i < end; i++) {
+        step_clock(sim, i, steps);
+    }
+}
+
+void binary_clock_sim_step(binary_clock_sim_t* sim) {
+    if (sim != NULL) {
+        binary_clock_sim_step_range(sim, 0, sim->count, 1);
+    }
+}
+
+void binary_clock_sim_shard(const binary_clock_sim_t* sim, unsigned shard, unsigned shards, size_t* first,
+                            size_t* count) {
+    if (first == NULL || count == NULL) {
+        return;
+    }
+    *first = 0;
+    *count = 0;
+    if (sim == NULL || shards == 0 || shard >= shards) {
+        return;
+    }
+    size_t lines = (sim->count + BINARY_CLOCK_SIM_SHARD_ALIGN - 1) / BINARY_CLOCK_SIM_SHARD_ALIGN;
+    size_t start = lines * shard / shards * BINARY_CLOCK_SIM_SHARD_ALIGN;
+    size_t end = shard + 1 == shards ? sim->count : lines * (shard + 1) / shards * BINARY_CLOCK_SIM_SHARD_ALIGN;
+    if (start < sim->count) {
+        *first = start;
+        *count = (end < sim->count ? end : sim->count) - start;
+    }
+}
+
+binary_clock_state_t binary_clock_sim_state(const binary_clock_sim_t* sim, size_t index,
+                                            binary_clock_time_t timestamp) {
+    if (sim == NULL || sim->block == NULL || index >= sim->count) {
+        binary_clock_state_t none = {0};
+        return none;
+    }
+    return binary_clock_state_from_packed(sim->leds[index] & ~BINARY_CLOCK_SIM_PM_BIT, timestamp);
+}
+
+void binary_clock_sim_free(binary_clock_sim_t* sim) {
+    if (sim == NULL || sim->block == NULL) {
+        return;
+    }
+    free(sim->block);
+    binary_clock_mem_release(BINARY_CLOCK_MEM_REGISTRY, sim->bytes);
+    memset(sim, 0, sizeof(*sim));
+}
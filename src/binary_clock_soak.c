@@ -0,0 +1,204 @@
+/**
+ * @file binary_clock_soak.c
+ * @brief Binary Clock Soak Checking Implementation
+ *
+ * Frames are parsed back without knowing their format: the first
+ * "HH:MM:SS" gives the digits, the LED bits after it must spell the same
+ * digits, and a JSON "timestamp" member is picked up when present. The
+ * expected state comes from binary_clock_state_from_epoch(), independent
+ * of the localtime() path the CLI renders with.
+ */
+
+#include <binary_clock_soak.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SOAK_BIT_COUNT 21
+
+// UTF-8 encodings of the LED emojis
+static const char moon_on[] = "\xF0\x9F\x8C\x9D";   // 🌝
+static const char moon_off[] = "\xF0\x9F\x8C\x9A";  // 🌚
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Position of the first "DD:DD:DD" in the frame, or -1
+static long find_time(const char* frame, size_t length) {
+    for (size_t i = 0; i + 8 <= length; i++) {
+        if (is_digit(frame[i]) && is_digit(frame[i + 1]) && frame[i + 2] == ':' &&
+            is_digit(frame[i + 3]) && is_digit(frame[i + 4]) && frame[i + 5] == ':' &&
+            is_digit(frame[i + 6]) && is_digit(frame[i + 7])) {
+            return (long)i;
+        }
+    }
+    return -1;
+}
+
+// Value of a JSON "timestamp" member, or -1 when there is none
+static int64_t find_timestamp(const char* frame, size_t length) {
+    static const char key[] = "\"timestamp\"";
+    size_t key_length = sizeof(key) - 1;
+
+    for (size_t i = 0; i + key_length <= length; i++) {
+        if (memcmp(frame + i, key, key_length) != 0) {
+            continue;
+        }
+        size_t pos = i + key_length;
+        while (pos < length && (frame[pos] == ' ' || frame[pos] == ':')) {
+            pos++;
+        }
+        int64_t value = 0;
+        size_t start = pos;
+        while (pos < length && is_digit(frame[pos])) {
+            value = value * 10 + (frame[pos] - '0');
+            pos++;
+        }
+        return pos > start ? value : -1;
+    }
+    return -1;
+}
+
+bool binary_clock_soak_parse_frame(const char* frame, size_t length, uint32_t* packed, int64_t* timestamp) {
+    static const uint8_t widths[6] = {3, 4, 3, 4, 3, 4};
+
+    if (frame == NULL || packed == NULL) {
+        return false;
+    }
+
+    long time_pos = find_time(frame, length);
+    if (time_pos < 0) {
+        return false;
+    }
+    const char* text = frame + time_pos;
+    uint8_t digits[6] = {
+        (uint8_t)(text[0] - '0'), (uint8_t)(text[1] - '0'),
+        (uint8_t)(text[3] - '0'), (uint8_t)(text[4] - '0'),
+        (uint8_t)(text[6] - '0'), (uint8_t)(text[7] - '0')
+    };
+
+    // Collect the LED bits after the time text
+    uint8_t bits[SOAK_BIT_COUNT];
+    int bit_count = 0;
+    for (size_t pos = (size_t)time_pos + 8; pos < length; pos++) {
+        int bit = -1;
+        if (frame[pos] == '0' || frame[pos] == '1') {
+            bit = frame[pos] - '0';
+        } else if (pos + 4 <= length && memcmp(frame + pos, moon_on, 4) == 0) {
+            bit = 1;
+            pos += 3;
+        } else if (pos + 4 <= length && memcmp(frame + pos, moon_off, 4) == 0) {
+            bit = 0;
+            pos += 3;
+        }
+        if (bit >= 0) {
+            if (bit_count == SOAK_BIT_COUNT) {
+                return false; // More LEDs than a clock has
+            }
+            bits[bit_count++] = (uint8_t)bit;
+        }
+    }
+    if (bit_count != SOAK_BIT_COUNT) {
+        return false;
+    }
+
+    // Bits are most significant first within each digit group
+    uint32_t value = 0;
+    int bit = 0;
+    for (int digit = 0; digit < 6; digit++) {
+        uint8_t decoded = 0;
+        for (int i = 0; i < widths[digit]; i++) {
+            decoded = (uint8_t)((decoded << 1) | bits[bit++]);
+        }
+        if (decoded != digits[digit]) {
+            return false;
+        }
+        value = (value << 4) | decoded;
+    }
+    if (binary_clock_state_from_packed(value, 1).timestamp == 0) {
+        return false; // Digits out of range, e.g. 25:61:00
+    }
+
+    *packed = value;
+    if (timestamp != NULL) {
+        *timestamp = find_timestamp(frame, length);
+    }
+    return true;
+}
+
+void binary_clock_soak_init(binary_clock_soak_t* soak) {
+    if (soak == NULL) {
+        return;
+    }
+    memset(soak, 0, sizeof(*soak));
+}
+
+static void record_failure(binary_clock_soak_t* soak, int64_t epoch, const char* description) {
+    if (soak->first_failure[0] == '\0') {
+        soak->first_failure_epoch = epoch;
+        snprintf(soak->first_failure, sizeof(soak->first_failure), "%s", description);
+    }
+}
+
+bool binary_clock_soak_check_frame(binary_clock_soak_t* soak, const char* frame, size_t length,
+                                   int64_t epoch, int32_t utc_offset_seconds) {
+    if (soak == NULL) {
+        return false;
+    }
+    char description[96];
+    bool passed = true;
+    soak->stats.frames++;
+    soak->stats.bytes += length;
+
+    // Presentation order: exactly one frame per second
+    if (soak->started) {
+        if (epoch <= soak->last_epoch) {
+            soak->stats.duplicated++;
+            snprintf(description, sizeof(description), "second %lld presented again after %lld",
+                     (long long)epoch, (long long)soak->last_epoch);
+            record_failure(soak, epoch, description);
+            passed = false;
+        } else if (epoch > soak->last_epoch + 1) {
+            soak->stats.skipped += (uint64_t)(epoch - soak->last_epoch - 1);
+            snprintf(description, sizeof(description), "seconds %lld..%lld never presented",
+                     (long long)(soak->last_epoch + 1), (long long)(epoch - 1));
+            record_failure(soak, epoch, description);
+            passed = false;
+        }
+        if (utc_offset_seconds != soak->last_offset) {
+            soak->stats.offset_changes++;
+        }
+    }
+
+    // Content: well formed and showing this second
+    uint32_t packed = 0;
+    int64_t timestamp = -1;
+    if (frame == NULL || !binary_clock_soak_parse_frame(frame, length, &packed, &timestamp)) {
+        soak->stats.malformed++;
+        record_failure(soak, epoch, "malformed frame");
+        passed = false;
+    } else {
+        binary_clock_state_t expected_state = binary_clock_state_from_epoch(epoch, utc_offset_seconds);
+        uint32_t expected = binary_clock_pack_state(&expected_state);
+        if (packed != expected || (timestamp >= 0 && timestamp != epoch)) {
+            soak->stats.mismatched++;
+            snprintf(description, sizeof(description), "shows %06lX (timestamp %lld), expected %06lX",
+                     (unsigned long)packed, (long long)timestamp, (unsigned long)expected);
+            record_failure(soak, epoch, description);
+            passed = false;
+        }
+        if (soak->started && packed < soak->last_packed && utc_offset_seconds == soak->last_offset) {
+            soak->stats.rollovers++;
+        }
+        soak->last_packed = packed;
+    }
+
+    soak->started = true;
+    soak->last_epoch = epoch;
+    soak->last_offset = utc_offset_seconds;
+    return passed;
+}
+
+bool binary_clock_soak_passed(const binary_clock_soak_t* soak) {
+    return soak != NULL && soak->first_failure[0] == '\0';
+}
@@ -0,0 +1,503 @@
+/* Generated by scripts/gen-spec.py from docs/binary_clock_api_spec.json - do not edit. */
+
+/**
+ * @file binary_clock_spec.c
+ * @brief Binary Clock Spec Serializers Implementation (generated)
+ *
+ * Each field is written with straight-line code: constant key text,
+ * digits selected by arithmetic, booleans from a table. Constraint checks
+ * OR their failures into a mask that is tested once per value.
+ */
+
+#include <binary_clock_spec.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* SPEC CONFORMANCE (compile time)                                            */
+/* ========================================================================== */
+
+#define SPEC_ASSERT(name, condition) typedef char spec_assert_##name[(condition) ? 1 : -1]
+
+SPEC_ASSERT(binary_value_size, sizeof(binary_value_t) == 8);
+SPEC_ASSERT(time_components_size, sizeof(time_components_t) == 3);
+SPEC_ASSERT(state_size, sizeof(binary_clock_state_t) == 56);
+SPEC_ASSERT(binary_clock_success, BINARY_CLOCK_SUCCESS == 0);
+SPEC_ASSERT(binary_clock_error_invalid_time, BINARY_CLOCK_ERROR_INVALID_TIME == 1);
+SPEC_ASSERT(binary_clock_error_invalid_bit_count, BINARY_CLOCK_ERROR_INVALID_BIT_COUNT == 2);
+SPEC_ASSERT(binary_clock_error_null_pointer, BINARY_CLOCK_ERROR_NULL_POINTER == 3);
+SPEC_ASSERT(binary_clock_error_system_time, BINARY_CLOCK_ERROR_SYSTEM_TIME == 4);
+
+/* ========================================================================== */
+/* FIELD CODECS                                                               */
+/* ========================================================================== */
+
+// Constraint failures, mapped to an error code once per value
+#define SPEC_BAD_SHAPE 1u
+#define SPEC_BAD_BIT_COUNT 2u
+#define SPEC_BAD_VALUE 4u
+
+static binary_clock_error_t spec_error(unsigned bad) {
+    if (bad & SPEC_BAD_SHAPE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    if (bad & SPEC_BAD_BIT_COUNT) {
+        return BINARY_CLOCK_ERROR_INVALID_BIT_COUNT;
+    }
+    return (bad & SPEC_BAD_VALUE) ? BINARY_CLOCK_ERROR_INVALID_TIME : BINARY_CLOCK_SUCCESS;
+}
+
+static uint8_t* put_record_i64(uint8_t* out, int64_t value) {
+    uint64_t bits = (uint64_t)value;
+    for (int i = 0; i < 8; i++) {
+        out[i] = (uint8_t)(bits >> (8 * i));
+    }
+    return out + 8;
+}
+
+static const uint8_t* take_record_i64(const uint8_t* in, int64_t* value) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        bits |= (uint64_t)in[i] << (8 * i);
+    }
+    *value = (int64_t)bits;
+    return in + 8;
+}
+
+static uint8_t pack_bits(const bool bits[6]) {
+    return (uint8_t)((bits[0] << 5) | (bits[1] << 4) | (bits[2] << 3) | (bits[3] << 2) | (bits[4] << 1) | bits[5]);
+}
+
+static void unpack_bits(uint8_t mask, bool bits[6]) {
+    for (int i = 0; i < 6; i++) {
+        bits[i] = (mask >> (5 - i)) & 1;
+    }
+}
+
+// Writers may store up to the field's longest text; callers checked the room
+static char* put_text(char* out, const char* text, size_t length) {
+    memcpy(out, text, length);
+    return out + length;
+}
+
+static char* put_u8(char* out, uint8_t value) {
+    char digits[3] = {(char)('0' + value / 100), (char)('0' + value / 10 % 10), (char)('0' + value % 10)};
+    size_t count = 1 + (value >= 10) + (value >= 100);
+    memcpy(out, digits + 3 - count, count);
+    return out + count;
+}
+
+static const char bool_text[2][5] = {{'f', 'a', 'l', 's', 'e'}, {'t', 'r', 'u', 'e', ','}};
+
+static char* put_bits(char* out, const bool bits[6]) {
+    *out++ = '[';
+    for (int i = 0; i < 6; i++) {
+        memcpy(out, bool_text[bits[i] != 0], 5);
+        out += 5 - bits[i];
+        *out++ = ',';
+    }
+    out[-1] = ']';
+    return out;
+}
+
+static char* put_i64(char* out, int64_t value) {
+    char digits[20];
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t count = 0;
+    do {
+        digits[sizeof(digits) - 1 - count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    *out = '-';
+    out += value < 0;
+    memcpy(out, digits + sizeof(digits) - count, count);
+    return out + count;
+}
+
+// JSON reader over exactly the text the encoders produce
+typedef struct {
+    const char* at;
+    const char* end;
+    unsigned bad;
+} spec_cursor_t;
+
+static void take_text(spec_cursor_t* in, const char* text, size_t length) {
+    if ((size_t)(in->end - in->at) < length || memcmp(in->at, text, length) != 0) {
+        in->bad |= SPEC_BAD_SHAPE;
+        in->at = in->end;
+        return;
+    }
+    in->at += length;
+}
+
+static uint64_t take_digits(spec_cursor_t* in, int max_digits) {
+    uint64_t value = 0;
+    int count = 0;
+    while (in->at < in->end && *in->at >= '0' && *in->at <= '9' && count < max_digits) {
+        value = value * 10 + (uint64_t)(*in->at++ - '0');
+        count++;
+    }
+    if (count == 0) {
+        in->bad |= SPEC_BAD_SHAPE;
+    }
+    return value;
+}
+
+static uint8_t take_u8(spec_cursor_t* in) {
+    uint64_t value = take_digits(in, 3);
+    if (value > 255) {
+        in->bad |= SPEC_BAD_SHAPE;
+    }
+    return (uint8_t)value;
+}
+
+static void take_bits(spec_cursor_t* in, bool bits[6]) {
+    take_text(in, "[", 1);
+    for (int i = 0; i < 6; i++) {
+        if (in->at < in->end && *in->at == 't') {
+            take_text(in, "true", 4);
+            bits[i] = true;
+        } else {
+            take_text(in, "false", 5);
+            bits[i] = false;
+        }
+        take_text(in, i < 5 ? "," : "]", 1);
+    }
+}
+
+static int64_t take_i64(spec_cursor_t* in) {
+    bool negative = in->at < in->end && *in->at == '-';
+    in->at += negative;
+    uint64_t magnitude = take_digits(in, 19);
+    if (magnitude > (uint64_t)INT64_MAX + negative) {
+        in->bad |= SPEC_BAD_SHAPE;
+    }
+    return negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+}
+
+/* ========================================================================== */
+/* BINARY_VALUE_T                                                             */
+/* ========================================================================== */
+
+static unsigned check_binary_value(const binary_value_t* value) {
+    unsigned bad = 0;
+    bad |= (value->bit_count < 1) * SPEC_BAD_BIT_COUNT;
+    bad |= (value->bit_count > 6) * SPEC_BAD_BIT_COUNT;
+    bad |= (value->decimal_value > 63) * SPEC_BAD_VALUE;
+    return bad;
+}
+
+static uint8_t* put_binary_value_record(uint8_t* out, const binary_value_t* value) {
+    *out++ = value->bit_count;
+    *out++ = pack_bits(value->bits);
+    *out++ = value->decimal_value;
+    return out;
+}
+
+static const uint8_t* take_binary_value_record(const uint8_t* in, binary_value_t* value, unsigned* bad) {
+    value->bit_count = *in++;
+    *bad |= (*in >= 64) * SPEC_BAD_SHAPE;
+    unpack_bits(*in++, value->bits);
+    value->decimal_value = *in++;
+    return in;
+}
+
+static char* put_binary_value_json(char* out, const binary_value_t* value) {
+    out = put_text(out, "{\"bit_count\":", 13);
+    out = put_u8(out, value->bit_count);
+    out = put_text(out, ",\"bits\":", 8);
+    out = put_bits(out, value->bits);
+    out = put_text(out, ",\"decimal_value\":", 17);
+    out = put_u8(out, value->decimal_value);
+    *out++ = '}';
+    return out;
+}
+
+static void take_binary_value_json(spec_cursor_t* in, binary_value_t* value) {
+    take_text(in, "{\"bit_count\":", 13);
+    value->bit_count = take_u8(in);
+    take_text(in, ",\"bits\":", 8);
+    take_bits(in, value->bits);
+    take_text(in, ",\"decimal_value\":", 17);
+    value->decimal_value = take_u8(in);
+    take_text(in, "}", 1);
+}
+
+size_t binary_clock_spec_encode_binary_value_record(const binary_value_t* binary_value, uint8_t* output, size_t size) {
+    if (binary_value == NULL || output == NULL || size < BINARY_CLOCK_SPEC_BINARY_VALUE_RECORD_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_binary_value_record(output, binary_value) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_binary_value_record(const uint8_t* input, size_t length, binary_value_t* binary_value) {
+    if (input == NULL || binary_value == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (length != BINARY_CLOCK_SPEC_BINARY_VALUE_RECORD_SIZE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    binary_value_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    unsigned bad = 0;
+    take_binary_value_record(input, &decoded, &bad);
+    binary_clock_error_t error = spec_error(bad | check_binary_value(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *binary_value = decoded;
+    }
+    return error;
+}
+
+size_t binary_clock_spec_encode_binary_value_json(const binary_value_t* binary_value, char* output, size_t size) {
+    if (binary_value == NULL || output == NULL || size < BINARY_CLOCK_SPEC_BINARY_VALUE_JSON_MAX_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_binary_value_json(output, binary_value) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_binary_value_json(const char* input, size_t length, binary_value_t* binary_value) {
+    if (input == NULL || binary_value == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    binary_value_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    spec_cursor_t in = {input, input + length, 0};
+    take_binary_value_json(&in, &decoded);
+    if (in.at != in.end) {
+        in.bad |= SPEC_BAD_SHAPE;
+    }
+    binary_clock_error_t error = spec_error(in.bad | check_binary_value(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *binary_value = decoded;
+    }
+    return error;
+}
+
+/* ========================================================================== */
+/* TIME_COMPONENTS_T                                                          */
+/* ========================================================================== */
+
+static unsigned check_time_components(const time_components_t* value) {
+    unsigned bad = 0;
+    bad |= (value->hours > 23) * SPEC_BAD_VALUE;
+    bad |= (value->minutes > 59) * SPEC_BAD_VALUE;
+    bad |= (value->seconds > 59) * SPEC_BAD_VALUE;
+    return bad;
+}
+
+static uint8_t* put_time_components_record(uint8_t* out, const time_components_t* value) {
+    *out++ = value->hours;
+    *out++ = value->minutes;
+    *out++ = value->seconds;
+    return out;
+}
+
+static const uint8_t* take_time_components_record(const uint8_t* in, time_components_t* value, unsigned* bad) {
+    (void)bad;
+    value->hours = *in++;
+    value->minutes = *in++;
+    value->seconds = *in++;
+    return in;
+}
+
+static char* put_time_components_json(char* out, const time_components_t* value) {
+    out = put_text(out, "{\"hours\":", 9);
+    out = put_u8(out, value->hours);
+    out = put_text(out, ",\"minutes\":", 11);
+    out = put_u8(out, value->minutes);
+    out = put_text(out, ",\"seconds\":", 11);
+    out = put_u8(out, value->seconds);
+    *out++ = '}';
+    return out;
+}
+
+static void take_time_components_json(spec_cursor_t* in, time_components_t* value) {
+    take_text(in, "{\"hours\":", 9);
+    value->hours = take_u8(in);
+    take_text(in, ",\"minutes\":", 11);
+    value->minutes = take_u8(in);
+    take_text(in, ",\"seconds\":", 11);
+    value->seconds = take_u8(in);
+    take_text(in, "}", 1);
+}
+
+size_t binary_clock_spec_encode_time_components_record(const time_components_t* time_components, uint8_t* output, size_t size) {
+    if (time_components == NULL || output == NULL || size < BINARY_CLOCK_SPEC_TIME_COMPONENTS_RECORD_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_time_components_record(output, time_components) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_time_components_record(const uint8_t* input, size_t length, time_components_t* time_components) {
+    if (input == NULL || time_components == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (length != BINARY_CLOCK_SPEC_TIME_COMPONENTS_RECORD_SIZE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    time_components_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    unsigned bad = 0;
+    take_time_components_record(input, &decoded, &bad);
+    binary_clock_error_t error = spec_error(bad | check_time_components(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *time_components = decoded;
+    }
+    return error;
+}
+
+size_t binary_clock_spec_encode_time_components_json(const time_components_t* time_components, char* output, size_t size) {
+    if (time_components == NULL || output == NULL || size < BINARY_CLOCK_SPEC_TIME_COMPONENTS_JSON_MAX_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_time_components_json(output, time_components) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_time_components_json(const char* input, size_t length, time_components_t* time_components) {
+    if (input == NULL || time_components == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    time_components_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    spec_cursor_t in = {input, input + length, 0};
+    take_time_components_json(&in, &decoded);
+    if (in.at != in.end) {
+        in.bad |= SPEC_BAD_SHAPE;
+    }
+    binary_clock_error_t error = spec_error(in.bad | check_time_components(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *time_components = decoded;
+    }
+    return error;
+}
+
+/* ========================================================================== */
+/* BINARY_CLOCK_STATE_T                                                       */
+/* ========================================================================== */
+
+static unsigned check_state(const binary_clock_state_t* value) {
+    unsigned bad = 0;
+    bad |= check_binary_value(&value->hours_tens);
+    bad |= (value->hours_tens.bit_count != 3) * SPEC_BAD_BIT_COUNT;
+    bad |= check_binary_value(&value->hours_units);
+    bad |= (value->hours_units.bit_count != 4) * SPEC_BAD_BIT_COUNT;
+    bad |= check_binary_value(&value->minutes_tens);
+    bad |= (value->minutes_tens.bit_count != 3) * SPEC_BAD_BIT_COUNT;
+    bad |= check_binary_value(&value->minutes_units);
+    bad |= (value->minutes_units.bit_count != 4) * SPEC_BAD_BIT_COUNT;
+    bad |= check_binary_value(&value->seconds_tens);
+    bad |= (value->seconds_tens.bit_count != 3) * SPEC_BAD_BIT_COUNT;
+    bad |= check_binary_value(&value->seconds_units);
+    bad |= (value->seconds_units.bit_count != 4) * SPEC_BAD_BIT_COUNT;
+    return bad;
+}
+
+static uint8_t* put_state_record(uint8_t* out, const binary_clock_state_t* value) {
+    out = put_binary_value_record(out, &value->hours_tens);
+    out = put_binary_value_record(out, &value->hours_units);
+    out = put_binary_value_record(out, &value->minutes_tens);
+    out = put_binary_value_record(out, &value->minutes_units);
+    out = put_binary_value_record(out, &value->seconds_tens);
+    out = put_binary_value_record(out, &value->seconds_units);
+    out = put_record_i64(out, (int64_t)value->timestamp);
+    return out;
+}
+
+static const uint8_t* take_state_record(const uint8_t* in, binary_clock_state_t* value, unsigned* bad) {
+    in = take_binary_value_record(in, &value->hours_tens, bad);
+    in = take_binary_value_record(in, &value->hours_units, bad);
+    in = take_binary_value_record(in, &value->minutes_tens, bad);
+    in = take_binary_value_record(in, &value->minutes_units, bad);
+    in = take_binary_value_record(in, &value->seconds_tens, bad);
+    in = take_binary_value_record(in, &value->seconds_units, bad);
+    int64_t timestamp;
+    in = take_record_i64(in, &timestamp);
+    value->timestamp = (binary_clock_time_t)timestamp;
+    return in;
+}
+
+static char* put_state_json(char* out, const binary_clock_state_t* value) {
+    out = put_text(out, "{\"hours_tens\":", 14);
+    out = put_binary_value_json(out, &value->hours_tens);
+    out = put_text(out, ",\"hours_units\":", 15);
+    out = put_binary_value_json(out, &value->hours_units);
+    out = put_text(out, ",\"minutes_tens\":", 16);
+    out = put_binary_value_json(out, &value->minutes_tens);
+    out = put_text(out, ",\"minutes_units\":", 17);
+    out = put_binary_value_json(out, &value->minutes_units);
+    out = put_text(out, ",\"seconds_tens\":", 16);
+    out = put_binary_value_json(out, &value->seconds_tens);
+    out = put_text(out, ",\"seconds_units\":", 17);
+    out = put_binary_value_json(out, &value->seconds_units);
+    out = put_text(out, ",\"timestamp\":", 13);
+    out = put_i64(out, (int64_t)value->timestamp);
+    *out++ = '}';
+    return out;
+}
+
+static void take_state_json(spec_cursor_t* in, binary_clock_state_t* value) {
+    take_text(in, "{\"hours_tens\":", 14);
+    take_binary_value_json(in, &value->hours_tens);
+    take_text(in, ",\"hours_units\":", 15);
+    take_binary_value_json(in, &value->hours_units);
+    take_text(in, ",\"minutes_tens\":", 16);
+    take_binary_value_json(in, &value->minutes_tens);
+    take_text(in, ",\"minutes_units\":", 17);
+    take_binary_value_json(in, &value->minutes_units);
+    take_text(in, ",\"seconds_tens\":", 16);
+    take_binary_value_json(in, &value->seconds_tens);
+    take_text(in, ",\"seconds_units\":", 17);
+    take_binary_value_json(in, &value->seconds_units);
+    take_text(in, ",\"timestamp\":", 13);
+    value->timestamp = (binary_clock_time_t)take_i64(in);
+    take_text(in, "}", 1);
+}
+
+size_t binary_clock_spec_encode_state_record(const binary_clock_state_t* state, uint8_t* output, size_t size) {
+    if (state == NULL || output == NULL || size < BINARY_CLOCK_SPEC_STATE_RECORD_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_state_record(output, state) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_state_record(const uint8_t* input, size_t length, binary_clock_state_t* state) {
+    if (input == NULL || state == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (length != BINARY_CLOCK_SPEC_STATE_RECORD_SIZE) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    binary_clock_state_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    unsigned bad = 0;
+    take_state_record(input, &decoded, &bad);
+    binary_clock_error_t error = spec_error(bad | check_state(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *state = decoded;
+    }
+    return error;
+}
+
+size_t binary_clock_spec_encode_state_json(const binary_clock_state_t* state, char* output, size_t size) {
+    if (state == NULL || output == NULL || size < BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE) {
+        return 0;
+    }
+    return (size_t)(put_state_json(output, state) - output);
+}
+
+binary_clock_error_t binary_clock_spec_decode_state_json(const char* input, size_t length, binary_clock_state_t* state) {
+    if (input == NULL || state == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    binary_clock_state_t decoded;
+    memset(&decoded, 0, sizeof(decoded));
+    spec_cursor_t in = {input, input + length, 0};
+    take_state_json(&in, &decoded);
+    if (in.at != in.end) {
+        in.bad |= SPEC_BAD_SHAPE;
+    }
+    binary_clock_error_t error = spec_error(in.bad | check_state(&decoded));
+    if (error == BINARY_CLOCK_SUCCESS) {
+        *state = decoded;
+    }
+    return error;
+}
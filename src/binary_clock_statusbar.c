@@ -0,0 +1,91 @@
+/**
+ * @file binary_clock_statusbar.c
+ * @brief Binary Clock Status Bar Implementation
+ *
+ * The rendered line (compact or emoji) is compared with the last one
+ * sent, so a producer woken by a signal or a late timer never repeats
+ * an update. Lines hold digits, brackets, colons, spaces and emoji only,
+ * so they go into the i3bar JSON without escaping.
+ */
+
+#include <binary_clock_statusbar.h>
+#include <string.h>
+
+// Protocol version 1, no click events, then the start of the endless array
+static const char i3bar_header[] = "{\"version\":1}\n[\n";
+static const char i3bar_block_start[] = "[{\"name\":\"binary_clock\",\"full_text\":\"";
+static const char i3bar_short_text[] = "\",\"short_text\":\"";
+static const char i3bar_block_end[] = "\"}]\n";
+
+// Both line formats start with HH:MM:SS, the short text for narrow bars
+#define SHORT_TEXT_LENGTH 8
+
+binary_clock_error_t binary_clock_statusbar_init(binary_clock_statusbar_t* statusbar,
+                                                 binary_clock_statusbar_protocol_t protocol,
+                                                 binary_clock_render_format_t format) {
+    if (statusbar == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(statusbar, 0, sizeof(*statusbar));
+    statusbar->protocol = protocol;
+    statusbar->format = format;
+    statusbar->render = binary_clock_display_render;
+    if ((protocol != BINARY_CLOCK_STATUSBAR_I3BAR && protocol != BINARY_CLOCK_STATUSBAR_TMUX) ||
+        (format != BINARY_CLOCK_RENDER_COMPACT && format != BINARY_CLOCK_RENDER_EMOJI_LINE)) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+static size_t append(char* output, size_t length, const char* bytes, size_t count) {
+    memcpy(output + length, bytes, count);
+    return length + count;
+}
+
+size_t binary_clock_statusbar_update(binary_clock_statusbar_t* statusbar, const binary_clock_state_t* state,
+                                     char* output, size_t size) {
+    if (statusbar == NULL || state == NULL || output == NULL) {
+        return (size_t)-1;
+    }
+
+    char line[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = statusbar->render(state, statusbar->format, line, sizeof(line));
+    if (length < SHORT_TEXT_LENGTH + 1) {
+        return (size_t)-1;
+    }
+    length--;  // The line end belongs to the protocol, not the text
+    if (statusbar->started && length == statusbar->last_length && memcmp(line, statusbar->last, length) == 0) {
+        statusbar->stats.unchanged++;
+        return 0;
+    }
+
+    size_t written = 0;
+    if (statusbar->protocol == BINARY_CLOCK_STATUSBAR_TMUX) {
+        if (length + 1 > size) {
+            return (size_t)-1;
+        }
+        written = append(output, written, line, length);
+        written = append(output, written, "\n", 1);
+    } else {
+        size_t needed = (statusbar->started ? 1 : sizeof(i3bar_header) - 1) + sizeof(i3bar_block_start) - 1 +
+                        length + sizeof(i3bar_short_text) - 1 + SHORT_TEXT_LENGTH + sizeof(i3bar_block_end) - 1;
+        if (needed > size) {
+            return (size_t)-1;
+        }
+        // Every status line after the first continues the array
+        written = statusbar->started ? append(output, written, ",", 1)
+                                     : append(output, written, i3bar_header, sizeof(i3bar_header) - 1);
+        written = append(output, written, i3bar_block_start, sizeof(i3bar_block_start) - 1);
+        written = append(output, written, line, length);
+        written = append(output, written, i3bar_short_text, sizeof(i3bar_short_text) - 1);
+        written = append(output, written, line, SHORT_TEXT_LENGTH);
+        written = append(output, written, i3bar_block_end, sizeof(i3bar_block_end) - 1);
+    }
+
+    memcpy(statusbar->last, line, length);
+    statusbar->last_length = length;
+    statusbar->started = true;
+    statusbar->stats.updates++;
+    statusbar->stats.bytes += written;
+    return written;
+}
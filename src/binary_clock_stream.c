@@ -0,0 +1,725 @@
+/**
+ * @file binary_clock_stream.c
+ * @brief Binary Clock Streaming Implementation
+ *
+ * Frame encoding is platform independent. The server is a single-threaded
+ * poll() loop over non-blocking sockets (POSIX only): every frame is
+ * encoded once per tick and shared by reference between the clients
+ * writing it, so the per-client cost is the send() call alone.
+ *
+ * Frames are carved from 4 KiB slabs into per-class free lists. A tick
+ * takes two frames and releases the previous tick's two once their last
+ * client is done, so the slabs stop growing after the first few ticks.
+ * Slabs are charged to BINARY_CLOCK_MEM_CACHES and client slots with the
+ * poll set to BINARY_CLOCK_MEM_QUEUES; over their caps, slabs are carved
+ * for one frame and client slots grow 16 at a time.
+ *
+ * Rejected connections never get a client slot or a frame: the busy
+ * notice is a single non-blocking send() of a constant before close().
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_stream.h>
+#include <binary_clock_trace.h>
+#include <binary_clock_mem.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <time.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+#endif
+
+/* ========================================================================== */
+/* FRAME ENCODING                                                             */
+/* ========================================================================== */
+
+#define STREAM_MAX_LINES 32
+
+// Output cursor that records overflow instead of writing past the end
+typedef struct {
+    char* data;
+    size_t size;
+    size_t length;
+    bool overflow;
+} stream_buffer_t;
+
+static void put_bytes(stream_buffer_t* out, const char* bytes, size_t length) {
+    if (out->overflow || length > out->size - out->length) {
+        out->overflow = true;
+        return;
+    }
+    memcpy(out->data + out->length, bytes, length);
+    out->length += length;
+}
+
+static void put_cursor(stream_buffer_t* out, size_t row, size_t column) {
+    char sequence[32];
+    int length = snprintf(sequence, sizeof(sequence), "\033[%lu;%luH", (unsigned long)row, (unsigned long)column);
+    put_bytes(out, sequence, (size_t)length);
+}
+
+// Terminal columns taken by UTF-8 text: emoji (4-byte sequences) are
+// double width, continuation bytes take none
+static size_t display_width(const char* text, size_t length) {
+    size_t width = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char byte = (unsigned char)text[i];
+        if ((byte & 0xC0) != 0x80) {
+            width += byte >= 0xF0 ? 2 : 1;
+        }
+    }
+    return width;
+}
+
+static bool is_continuation(char byte) {
+    return ((unsigned char)byte & 0xC0) == 0x80;
+}
+
+// Rewrite the part of a line that changed: the span between the common
+// prefix and suffix when it keeps its width, else everything after the prefix
+static void put_line_change(stream_buffer_t* out, size_t row,
+                            const char* old_line, size_t old_length,
+                            const char* line, size_t length) {
+    size_t start = 0;
+    while (start < length && start < old_length && line[start] == old_line[start]) {
+        start++;
+    }
+    while (start > 0 && start < length && is_continuation(line[start])) {
+        start--;
+    }
+
+    size_t suffix = 0;
+    while (suffix < length - start && suffix < old_length - start &&
+           line[length - 1 - suffix] == old_line[old_length - 1 - suffix]) {
+        suffix++;
+    }
+    while (suffix > 0 && is_continuation(line[length - suffix])) {
+        suffix--;
+    }
+
+    size_t end = length - suffix;
+    size_t old_end = old_length - suffix;
+    put_cursor(out, row, display_width(line, start) + 1);
+    if (display_width(line + start, end - start) == display_width(old_line + start, old_end - start)) {
+        put_bytes(out, line + start, end - start);
+    } else {
+        put_bytes(out, line + start, length - start);
+        put_bytes(out, "\033[K", 3);
+    }
+}
+
+// Split a screen into lines; a trailing '\n' does not start a new line
+static size_t split_lines(const char* screen, size_t length, const char** lines, size_t* lengths) {
+    size_t count = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= length && count < STREAM_MAX_LINES; i++) {
+        if (i == length || screen[i] == '\n') {
+            if (i == length && start == length) {
+                break;
+            }
+            lines[count] = screen + start;
+            lengths[count] = i - start;
+            count++;
+            start = i + 1;
+        }
+    }
+    return count;
+}
+
+size_t binary_clock_stream_encode_full(const char* screen, size_t length, char* output, size_t size) {
+    if (screen == NULL || output == NULL) {
+        return 0;
+    }
+    stream_buffer_t out = {output, size, 0, false};
+    put_bytes(&out, "\033[H\033[2J", 7);
+
+    size_t start = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (screen[i] == '\n') {
+            put_bytes(&out, screen + start, i - start);
+            put_bytes(&out, "\r\n", 2);
+            start = i + 1;
+        }
+    }
+    put_bytes(&out, screen + start, length - start);
+    return out.overflow ? 0 : out.length;
+}
+
+size_t binary_clock_stream_encode_diff(const char* previous, size_t previous_length,
+                                       const char* screen, size_t length,
+                                       char* output, size_t size) {
+    if (previous == NULL || screen == NULL || output == NULL) {
+        return (size_t)-1;
+    }
+    const char* old_lines[STREAM_MAX_LINES];
+    size_t old_lengths[STREAM_MAX_LINES];
+    const char* new_lines[STREAM_MAX_LINES];
+    size_t new_lengths[STREAM_MAX_LINES];
+    size_t old_count = split_lines(previous, previous_length, old_lines, old_lengths);
+    size_t new_count = split_lines(screen, length, new_lines, new_lengths);
+
+    stream_buffer_t out = {output, size, 0, false};
+    for (size_t i = 0; i < new_count; i++) {
+        if (i >= old_count) {
+            put_cursor(&out, i + 1, 1);
+            put_bytes(&out, new_lines[i], new_lengths[i]);
+            put_bytes(&out, "\033[K", 3);
+        } else if (old_lengths[i] != new_lengths[i] ||
+                   memcmp(old_lines[i], new_lines[i], new_lengths[i]) != 0) {
+            put_line_change(&out, i + 1, old_lines[i], old_lengths[i], new_lines[i], new_lengths[i]);
+        }
+    }
+    if (old_count > new_count) {
+        put_cursor(&out, new_count + 1, 1);
+        put_bytes(&out, "\033[J", 3);
+    }
+    if (out.length > 0) {
+        // Park the cursor where a full repaint leaves it
+        put_cursor(&out, new_count + 1, 1);
+    }
+    return out.overflow ? (size_t)-1 : out.length;
+}
+
+/* ========================================================================== */
+/* SERVER                                                                     */
+/* ========================================================================== */
+
+#ifdef _WIN32
+
+binary_clock_error_t binary_clock_stream_server_open(binary_clock_stream_server_t* server,
+                                                     const char* address, uint16_t port,
+                                                     binary_clock_render_format_t format) {
+    (void)address; (void)port;
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->format = format;
+    server->render = binary_clock_display_render;
+    binary_clock_admit_init(&server->admit, NULL);
+    return BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_stream_server_set_limits(binary_clock_stream_server_t* server,
+                                                           const binary_clock_admit_limits_t* limits) {
+    return server == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : binary_clock_admit_init(&server->admit, limits);
+}
+
+binary_clock_error_t binary_clock_stream_server_tick(binary_clock_stream_server_t* server,
+                                                     const binary_clock_state_t* state) {
+    (void)state;
+    return server == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_ERROR_NETWORK;
+}
+
+binary_clock_error_t binary_clock_stream_server_poll(binary_clock_stream_server_t* server, int timeout_ms) {
+    (void)timeout_ms;
+    return server == NULL ? BINARY_CLOCK_ERROR_NULL_POINTER : BINARY_CLOCK_ERROR_NETWORK;
+}
+
+bool binary_clock_stream_server_pending(const binary_clock_stream_server_t* server) {
+    (void)server;
+    return false;
+}
+
+size_t binary_clock_stream_server_memory(const binary_clock_stream_server_t* server) {
+    (void)server;
+    return 0;
+}
+
+void binary_clock_stream_server_close(binary_clock_stream_server_t* server) {
+    (void)server;
+}
+
+#else
+
+/* ========================================================================== */
+/* SHARED FRAMES                                                              */
+/* ========================================================================== */
+
+static const size_t frame_class_sizes[BINARY_CLOCK_STREAM_FRAME_CLASSES] = BINARY_CLOCK_STREAM_FRAME_CLASS_SIZES;
+
+// Slab link, padded so the frames after it stay aligned
+typedef union stream_slab {
+    union stream_slab* next;
+    uint64_t align;
+    double align_double;
+} stream_slab_t;
+
+// Carve a new slab into free frames of one class
+static int pool_refill(binary_clock_stream_pool_t* pool, size_t size_class) {
+    size_t stride = sizeof(binary_clock_stream_frame_t) + frame_class_sizes[size_class];
+    stride = (stride + sizeof(stream_slab_t) - 1) / sizeof(stream_slab_t) * sizeof(stream_slab_t);
+    size_t count = (BINARY_CLOCK_STREAM_SLAB_SIZE - sizeof(stream_slab_t)) / stride;
+    size_t size = sizeof(stream_slab_t) + count * stride;
+    // Over the caches cap, carve a slab for just the frame needed
+    if (!binary_clock_mem_reserve(BINARY_CLOCK_MEM_CACHES, size)) {
+        count = 1;
+        size = sizeof(stream_slab_t) + stride;
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_CACHES, size);
+    }
+    stream_slab_t* slab = malloc(size);
+    if (slab == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_CACHES, size);
+        return -1;
+    }
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->bytes += size;
+    char* frames = (char*)(slab + 1);
+    for (size_t i = 0; i < count; i++) {
+        binary_clock_stream_frame_t* frame = (binary_clock_stream_frame_t*)(void*)(frames + i * stride);
+        frame->size_class = (uint32_t)size_class;
+        frame->next_free = pool->free[size_class];
+        pool->free[size_class] = frame;
+    }
+    return 0;
+}
+
+static binary_clock_stream_frame_t* frame_create(binary_clock_stream_pool_t* pool, uint64_t tick,
+                                                 const char* data, size_t length) {
+    size_t size_class = 0;
+    while (size_class < BINARY_CLOCK_STREAM_FRAME_CLASSES && length > frame_class_sizes[size_class]) {
+        size_class++;
+    }
+    if (size_class == BINARY_CLOCK_STREAM_FRAME_CLASSES ||
+        (pool->free[size_class] == NULL && pool_refill(pool, size_class) != 0)) {
+        return NULL;
+    }
+    binary_clock_stream_frame_t* frame = pool->free[size_class];
+    pool->free[size_class] = frame->next_free;
+    frame->next_free = NULL;
+    frame->refs = 1;
+    frame->tick = tick;
+    frame->length = length;
+    memcpy(frame->data, data, length);
+    return frame;
+}
+
+static void frame_release(binary_clock_stream_pool_t* pool, binary_clock_stream_frame_t* frame) {
+    if (frame != NULL && --frame->refs == 0) {
+        frame->next_free = pool->free[frame->size_class];
+        pool->free[frame->size_class] = frame;
+    }
+}
+
+static void pool_free(binary_clock_stream_pool_t* pool) {
+    binary_clock_mem_release(BINARY_CLOCK_MEM_CACHES, pool->bytes);
+    stream_slab_t* slab = pool->slabs;
+    while (slab != NULL) {
+        stream_slab_t* next = slab->next;
+        free(slab);
+        slab = next;
+    }
+    memset(pool, 0, sizeof(*pool));
+}
+
+#ifdef MSG_NOSIGNAL
+    #define STREAM_SEND_FLAGS MSG_NOSIGNAL
+#else
+    #define STREAM_SEND_FLAGS 0  // SO_NOSIGPIPE is set per socket instead
+#endif
+
+// Telnet: server echoes and suppresses go-ahead (character mode), then
+// the cursor is hidden for the rest of the session
+static const char greeting[] = "\xFF\xFB\x01\xFF\xFB\x03\033[?25l";
+
+static const char busy_message[] = BINARY_CLOCK_STREAM_BUSY_MESSAGE;
+
+// Client slots added at a time while the queues are over their cap
+#define CLIENT_LEAN_GROWTH 16
+
+static int64_t monotonic_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags < 0 ? -1 : fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// Start writing the frame a client needs next, if any
+static void queue_next(binary_clock_stream_server_t* server, binary_clock_stream_client_t* client) {
+    if (server->tick == 0 || client->shown_tick == server->tick) {
+        return;
+    }
+    binary_clock_stream_frame_t* frame = server->full;
+    if (server->diff != NULL && client->shown_tick == server->tick - 1) {
+        if (server->diff->length == 0) {
+            client->shown_tick = server->tick; // Nothing changed on screen
+            return;
+        }
+        frame = server->diff;
+        server->stats.diff_sends++;
+    } else {
+        server->stats.full_sends++;
+    }
+    frame->refs++;
+    client->sending = frame;
+    client->offset = 0;
+}
+
+static void disconnect(binary_clock_stream_server_t* server, binary_clock_stream_client_t* client) {
+    close(client->fd);
+    client->fd = -1;
+    binary_clock_admit_release(&server->admit, client->address);
+    frame_release(&server->pool, client->sending);
+    client->sending = NULL;
+    server->stats.disconnected++;
+}
+
+// Write as much as the socket takes; -1 when the client is gone
+static int flush_client(binary_clock_stream_server_t* server, binary_clock_stream_client_t* client) {
+    while (client->sending != NULL) {
+        binary_clock_stream_frame_t* frame = client->sending;
+        ssize_t sent = send(client->fd, frame->data + client->offset, frame->length - client->offset,
+                            STREAM_SEND_FLAGS);
+        server->stats.writes++;
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+        }
+        server->stats.sent_bytes += (uint64_t)sent;
+        client->offset += (size_t)sent;
+        if (client->offset < frame->length) {
+            return 0; // Socket buffer full, wait for POLLOUT
+        }
+
+        // Frame complete: catch up with the current tick if it moved on
+        client->shown_tick = frame->tick;
+        client->sending = NULL;
+        frame_release(&server->pool, frame);
+        queue_next(server, client);
+    }
+    return 0;
+}
+
+// Drop disconnected clients, keeping the others in order
+static void compact_clients(binary_clock_stream_server_t* server) {
+    size_t kept = 0;
+    for (size_t i = 0; i < server->client_count; i++) {
+        if (server->clients[i].fd >= 0) {
+            server->clients[kept++] = server->clients[i];
+        }
+    }
+    server->client_count = kept;
+}
+
+// Client slots plus the poll set, with one extra poll slot for the listening socket
+static size_t client_bytes(size_t capacity) {
+    return capacity > 0 ? capacity * sizeof(binary_clock_stream_client_t) + (capacity + 1) * sizeof(struct pollfd) : 0;
+}
+
+static int grow_clients(binary_clock_stream_server_t* server) {
+    size_t capacity = server->client_capacity > 0 ? server->client_capacity * 2 : 64;
+    size_t held = client_bytes(server->client_capacity);
+    if (!binary_clock_mem_reserve(BINARY_CLOCK_MEM_QUEUES, client_bytes(capacity) - held)) {
+        capacity = server->client_capacity + CLIENT_LEAN_GROWTH;
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, client_bytes(capacity) - held);
+    }
+    binary_clock_stream_client_t* clients = realloc(server->clients, capacity * sizeof(*clients));
+    if (clients == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, client_bytes(capacity) - held);
+        return -1;
+    }
+    server->clients = clients;
+    struct pollfd* poll_set = realloc(server->poll_set, (capacity + 1) * sizeof(*poll_set));
+    if (poll_set == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, client_bytes(capacity) - held);
+        return -1;
+    }
+    server->poll_set = poll_set;
+    server->client_capacity = capacity;
+    return 0;
+}
+
+// Take a bounded batch from the backlog, so a stampede cannot hold off
+// the next tick; the rest are accepted on later polls
+static void accept_clients(binary_clock_stream_server_t* server) {
+    int64_t now_us = monotonic_us();
+    for (int taken = 0; taken < BINARY_CLOCK_STREAM_ACCEPT_BATCH; taken++) {
+        struct sockaddr_in peer;
+        socklen_t peer_length = sizeof(peer);
+        int fd = accept(server->listen_fd, (struct sockaddr*)&peer, &peer_length);
+        if (fd < 0) {
+            return; // EAGAIN: backlog drained; anything else: retry next poll
+        }
+        uint32_t address = peer.sin_family == AF_INET ? ntohl(peer.sin_addr.s_addr) : 0;
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        if (binary_clock_admit_check(&server->admit, address, now_us) != BINARY_CLOCK_ADMIT_OK) {
+            // Fast path: no slot, no frame, just the notice if the socket takes it
+            ssize_t sent = send(fd, busy_message, sizeof(busy_message) - 1, MSG_DONTWAIT | STREAM_SEND_FLAGS);
+            (void)sent;
+            close(fd);
+            continue;
+        }
+        if (set_nonblocking(fd) != 0 ||
+            (server->client_count == server->client_capacity && grow_clients(server) != 0)) {
+            binary_clock_admit_release(&server->admit, address);
+            close(fd);
+            continue;
+        }
+        binary_clock_stream_client_t* client = &server->clients[server->client_count++];
+        client->fd = fd;
+        client->address = address;
+        client->offset = 0;
+        client->shown_tick = 0;
+        client->sending = server->greeting;
+        server->greeting->refs++;
+        server->stats.accepted++;
+        if (flush_client(server, client) != 0) {
+            disconnect(server, client);
+        }
+    }
+}
+
+binary_clock_error_t binary_clock_stream_server_open(binary_clock_stream_server_t* server,
+                                                     const char* address, uint16_t port,
+                                                     binary_clock_render_format_t format) {
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+    server->format = format;
+    server->render = binary_clock_display_render;
+    binary_clock_admit_init(&server->admit, NULL);
+
+    struct sockaddr_in local = {0};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (address != NULL && inet_pton(AF_INET, address, &local.sin_addr) != 1) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+    int reuse = 1;
+    socklen_t bound_length = sizeof(local);
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+        bind(fd, (const struct sockaddr*)&local, sizeof(local)) != 0 ||
+        listen(fd, SOMAXCONN) != 0 || set_nonblocking(fd) != 0 ||
+        getsockname(fd, (struct sockaddr*)&local, &bound_length) != 0) {
+        close(fd);
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    server->greeting = frame_create(&server->pool, 0, greeting, sizeof(greeting) - 1);
+    if (server->greeting == NULL || grow_clients(server) != 0) {
+        close(fd);
+        binary_clock_stream_server_close(server);
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+    server->listen_fd = fd;
+    server->port = ntohs(local.sin_port);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_stream_server_set_limits(binary_clock_stream_server_t* server,
+                                                           const binary_clock_admit_limits_t* limits) {
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    binary_clock_admit_stats_t stats = server->admit.stats;
+    binary_clock_admit_free(&server->admit);
+    binary_clock_admit_init(&server->admit, limits);
+    server->admit.stats = stats;
+    for (size_t i = 0; i < server->client_count; i++) {
+        if (binary_clock_admit_add(&server->admit, server->clients[i].address) != BINARY_CLOCK_SUCCESS) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_stream_server_tick(binary_clock_stream_server_t* server,
+                                                     const binary_clock_state_t* state) {
+    if (server == NULL || state == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (server->listen_fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    binary_clock_trace_begin("stream", "encode");
+    char screen[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = server->render(state, server->format, screen, sizeof(screen));
+    if (length == 0) {
+        binary_clock_trace_end("stream", "encode");
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    // Encode this tick's shared frames once
+    char encoded[BINARY_CLOCK_STREAM_FRAME_MAX_SIZE];
+    uint64_t tick = server->tick + 1;
+    size_t full_length = binary_clock_stream_encode_full(screen, length, encoded, sizeof(encoded));
+    binary_clock_stream_frame_t* full = full_length > 0 ? frame_create(&server->pool, tick, encoded, full_length) : NULL;
+    if (full == NULL) {
+        binary_clock_trace_end("stream", "encode");
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    binary_clock_stream_frame_t* diff = NULL;
+    if (server->tick > 0) {
+        size_t diff_length = binary_clock_stream_encode_diff(server->screen, server->screen_length,
+                                                             screen, length, encoded, sizeof(encoded));
+        diff = diff_length != (size_t)-1 ? frame_create(&server->pool, tick, encoded, diff_length) : NULL;
+        if (diff == NULL) {
+            frame_release(&server->pool, full);
+            binary_clock_trace_end("stream", "encode");
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+    }
+
+    frame_release(&server->pool, server->full);
+    frame_release(&server->pool, server->diff);
+    server->full = full;
+    server->diff = diff;
+    server->tick = tick;
+    memcpy(server->screen, screen, length);
+    server->screen_length = length;
+    server->stats.ticks++;
+    server->stats.encoded_bytes += full->length + (diff != NULL ? diff->length : 0);
+    binary_clock_trace_end("stream", "encode");
+
+    // Idle clients start on the new frame now; busy ones catch up when idle
+    binary_clock_trace_begin("sink", "send");
+    bool lost = false;
+    for (size_t i = 0; i < server->client_count; i++) {
+        binary_clock_stream_client_t* client = &server->clients[i];
+        if (client->sending != NULL) {
+            server->stats.busy++;
+            continue;
+        }
+        queue_next(server, client);
+        if (flush_client(server, client) != 0) {
+            disconnect(server, client);
+            lost = true;
+        }
+    }
+    if (lost) {
+        compact_clients(server);
+    }
+    binary_clock_trace_end("sink", "send");
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_stream_server_poll(binary_clock_stream_server_t* server, int timeout_ms) {
+    if (server == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (server->listen_fd < 0) {
+        return BINARY_CLOCK_ERROR_NETWORK;
+    }
+
+    struct pollfd* poll_set = server->poll_set;
+    size_t count = server->client_count;
+    poll_set[0].fd = server->listen_fd;
+    poll_set[0].events = POLLIN;
+    for (size_t i = 0; i < count; i++) {
+        poll_set[i + 1].fd = server->clients[i].fd;
+        poll_set[i + 1].events = (short)(POLLIN | (server->clients[i].sending != NULL ? POLLOUT : 0));
+    }
+
+    int ready = poll(poll_set, (nfds_t)(count + 1), timeout_ms);
+    if (ready < 0) {
+        return errno == EINTR ? BINARY_CLOCK_ERROR_TIMEOUT : BINARY_CLOCK_ERROR_NETWORK;
+    }
+    if (ready == 0) {
+        return BINARY_CLOCK_ERROR_TIMEOUT;
+    }
+
+    // Clients first: accepting may reallocate the poll set
+    binary_clock_trace_begin("sink", "flush");
+    bool lost = false;
+    for (size_t i = 0; i < count; i++) {
+        short revents = poll_set[i + 1].revents;
+        binary_clock_stream_client_t* client = &server->clients[i];
+        if (revents == 0) {
+            continue;
+        }
+        bool gone = (revents & (POLLERR | POLLNVAL)) != 0;
+        if (!gone && (revents & (POLLIN | POLLHUP))) {
+            // Input (telnet negotiation, keystrokes) is read and discarded
+            char discard[512];
+            ssize_t got;
+            while ((got = recv(client->fd, discard, sizeof(discard), 0)) > 0) {
+            }
+            gone = got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+        }
+        if (!gone && (revents & POLLOUT)) {
+            gone = flush_client(server, client) != 0;
+        }
+        if (gone) {
+            disconnect(server, client);
+            lost = true;
+        }
+    }
+    if (lost) {
+        compact_clients(server);
+    }
+    binary_clock_trace_end("sink", "flush");
+    if (poll_set[0].revents & POLLIN) {
+        accept_clients(server);
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+bool binary_clock_stream_server_pending(const binary_clock_stream_server_t* server) {
+    if (server == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < server->client_count; i++) {
+        if (server->clients[i].sending != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t binary_clock_stream_server_memory(const binary_clock_stream_server_t* server) {
+    if (server == NULL) {
+        return 0;
+    }
+    return client_bytes(server->client_capacity) + server->pool.bytes + binary_clock_admit_memory(&server->admit);
+}
+
+void binary_clock_stream_server_close(binary_clock_stream_server_t* server) {
+    if (server == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < server->client_count; i++) {
+        close(server->clients[i].fd);
+    }
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+    }
+    // Every frame lives in a slab: freeing the slabs frees them all
+    pool_free(&server->pool);
+    binary_clock_admit_free(&server->admit);
+    binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, client_bytes(server->client_capacity));
+    free(server->clients);
+    free(server->poll_set);
+    memset(server, 0, sizeof(*server));
+    server->listen_fd = -1;
+}
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file binary_clock_trace.c
+ * @brief Binary Clock Tracing Implementation
+ *
+ * One process-wide ring of fixed-size events. Recording claims a slot
+ * with an atomic increment where the compiler provides one, so threads
+ * can record concurrently; the JSON writer pairs begins and ends per
+ * thread when the trace is written, not while it is recorded.
+ *
+ * Events are stamped with the CPU's cycle counter where there is one
+ * (x86 TSC, ARM64 virtual counter), which reads several times faster
+ * than clock_gettime() in VMs. Counter readings are converted to
+ * monotonic nanoseconds when the trace is written, using the rate
+ * measured between start and write.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_trace.h>
+#include <binary_clock_mem.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+    #include <windows.h>  // For QueryPerformanceCounter and thread/process ids
+#else
+    #include <time.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+#if defined(__GNUC__)
+    #define TRACE_CLAIM(counter) __sync_fetch_and_add((counter), 1)
+    #define TRACE_THREAD_LOCAL __thread
+#else
+    #define TRACE_CLAIM(counter) ((*(counter))++)
+#endif
+
+// Threads told apart when pairing begins and ends in the output
+#define TRACE_MAX_THREADS 64
+
+// Smallest ring kept when the queues cap shrinks it
+#define TRACE_MIN_EVENTS 64
+
+static struct {
+    binary_clock_trace_event_t* events;
+    size_t capacity;            // Power of two
+    uint64_t recorded;
+    uint64_t origin_counter;    // Counter and clock read together at start
+    int64_t origin_ns;
+} trace;
+
+/* ========================================================================== */
+/* CLOCK AND THREAD IDS                                                       */
+/* ========================================================================== */
+
+#ifdef _WIN32
+
+static int64_t monotonic_ns(void) {
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (counter.QuadPart / frequency.QuadPart) * 1000000000LL +
+           (counter.QuadPart % frequency.QuadPart) * 1000000000LL / frequency.QuadPart;
+}
+
+static uint32_t system_thread_id(void) {
+    return (uint32_t)GetCurrentThreadId();
+}
+
+static unsigned long process_id(void) {
+    return (unsigned long)GetCurrentProcessId();
+}
+
+#else
+
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static uint32_t system_thread_id(void) {
+#ifdef __linux__
+    return (uint32_t)syscall(SYS_gettid);
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+static unsigned long process_id(void) {
+    return (unsigned long)getpid();
+}
+
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define TRACE_CYCLE_COUNTER
+static uint64_t read_counter(void) {
+    return __builtin_ia32_rdtsc();
+}
+#elif defined(__GNUC__) && defined(__aarch64__)
+    #define TRACE_CYCLE_COUNTER
+static uint64_t read_counter(void) {
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+}
+#else
+static uint64_t read_counter(void) {
+    return (uint64_t)monotonic_ns();
+}
+#endif
+
+// The thread id lookup is a system call on Linux: cache it per thread
+static uint32_t current_thread_id(void) {
+#ifdef TRACE_THREAD_LOCAL
+    static TRACE_THREAD_LOCAL uint32_t cached;
+    if (cached == 0) {
+        cached = system_thread_id();
+    }
+    return cached;
+#else
+    return system_thread_id();
+#endif
+}
+
+/* ========================================================================== */
+/* RECORDING                                                                  */
+/* ========================================================================== */
+
+binary_clock_error_t binary_clock_trace_start(size_t capacity) {
+    binary_clock_trace_stop();
+    if (capacity == 0) {
+        capacity = BINARY_CLOCK_TRACE_DEFAULT_EVENTS;
+    }
+    // A power of two turns the slot index into a mask
+    size_t rounded = 1;
+    while (rounded < capacity && rounded <= (size_t)-1 / 2 / sizeof(binary_clock_trace_event_t)) {
+        rounded *= 2;
+    }
+
+    // Over the queues cap, keep as many of the latest events as fit
+    if (!binary_clock_mem_reserve(BINARY_CLOCK_MEM_QUEUES, rounded * sizeof(binary_clock_trace_event_t))) {
+        size_t available = binary_clock_mem_available(BINARY_CLOCK_MEM_QUEUES) / sizeof(binary_clock_trace_event_t);
+        while (rounded > TRACE_MIN_EVENTS && rounded > available) {
+            rounded /= 2;
+        }
+        binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, rounded * sizeof(binary_clock_trace_event_t));
+    }
+
+    binary_clock_trace_event_t* events = malloc(rounded * sizeof(*events));
+    if (events == NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, rounded * sizeof(*events));
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    trace.recorded = 0;
+    trace.capacity = rounded;
+    trace.origin_ns = monotonic_ns();
+    trace.origin_counter = read_counter();
+    trace.events = events;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+void binary_clock_trace_stop(void) {
+    if (trace.events != NULL) {
+        binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, trace.capacity * sizeof(*trace.events));
+    }
+    free(trace.events);
+    trace.events = NULL;
+    trace.capacity = 0;
+    trace.recorded = 0;
+}
+
+bool binary_clock_trace_enabled(void) {
+    return trace.events != NULL;
+}
+
+static void record(const char* category, const char* name, char phase) {
+    if (trace.events == NULL) {
+        return;
+    }
+    uint64_t index = TRACE_CLAIM(&trace.recorded);
+    binary_clock_trace_event_t* event = &trace.events[index & (trace.capacity - 1)];
+    event->timestamp = read_counter();
+    event->category = category;
+    event->name = name;
+    event->thread_id = current_thread_id();
+    event->phase = phase;
+}
+
+void binary_clock_trace_begin(const char* category, const char* name) {
+    record(category, name, 'B');
+}
+
+void binary_clock_trace_end(const char* category, const char* name) {
+    record(category, name, 'E');
+}
+
+binary_clock_trace_stats_t binary_clock_trace_get_stats(void) {
+    binary_clock_trace_stats_t stats;
+    stats.recorded = trace.recorded;
+    stats.overwritten = trace.recorded > trace.capacity ? trace.recorded - trace.capacity : 0;
+    stats.capacity = trace.capacity;
+    return stats;
+}
+
+/* ========================================================================== */
+/* CHROME TRACE-EVENT JSON                                                    */
+/* ========================================================================== */
+
+typedef struct {
+    uint32_t thread_id;
+    uint64_t depth;             // Spans open on this thread
+} thread_depth_t;
+
+static thread_depth_t* find_thread(thread_depth_t* threads, size_t* count, uint32_t thread_id) {
+    for (size_t i = 0; i < *count; i++) {
+        if (threads[i].thread_id == thread_id) {
+            return &threads[i];
+        }
+    }
+    if (*count == TRACE_MAX_THREADS) {
+        return NULL;
+    }
+    threads[*count].thread_id = thread_id;
+    threads[*count].depth = 0;
+    return &threads[(*count)++];
+}
+
+static void write_event(FILE* output, bool* first, const char* category, const char* name,
+                        char phase, int64_t timestamp_ns, unsigned long pid, uint32_t thread_id) {
+    // Chrome traces count microseconds; keep the nanoseconds as a fraction
+    fprintf(output, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%lld.%03d,\"pid\":%lu,\"tid\":%lu}",
+            *first ? "" : ",", name != NULL ? name : "", category != NULL ? category : "", phase,
+            (long long)(timestamp_ns / 1000), (int)(timestamp_ns % 1000), pid, (unsigned long)thread_id);
+    *first = false;
+}
+
+binary_clock_error_t binary_clock_trace_write(FILE* output) {
+    if (output == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+
+    uint64_t end = trace.recorded;
+    uint64_t start = end > trace.capacity ? end - trace.capacity : 0;
+
+    // Counter ticks per nanosecond over the whole recording
+    double ns_per_count = 1.0;
+#ifdef TRACE_CYCLE_COUNTER
+    int64_t elapsed_ns = monotonic_ns() - trace.origin_ns;
+    uint64_t elapsed_count = read_counter() - trace.origin_counter;
+    if (elapsed_ns > 0 && elapsed_count > 0) {
+        ns_per_count = (double)elapsed_ns / (double)elapsed_count;
+    }
+#endif
+    unsigned long pid = process_id();
+    thread_depth_t threads[TRACE_MAX_THREADS];
+    size_t thread_count = 0;
+    int64_t last_ns = 0;
+    bool first = true;
+
+    fputs("{\"traceEvents\":[", output);
+    for (uint64_t i = start; i < end; i++) {
+        const binary_clock_trace_event_t* event = &trace.events[i & (trace.capacity - 1)];
+        thread_depth_t* thread = find_thread(threads, &thread_count, event->thread_id);
+        if (thread != NULL) {
+            // An end whose begin was overwritten would close nothing
+            if (event->phase == 'E' && thread->depth == 0) {
+                continue;
+            }
+            thread->depth += event->phase == 'B' ? 1 : (uint64_t)-1;
+        }
+        int64_t timestamp_ns = trace.origin_ns +
+                               (int64_t)((double)(int64_t)(event->timestamp - trace.origin_counter) * ns_per_count);
+        write_event(output, &first, event->category, event->name, event->phase,
+                    timestamp_ns, pid, event->thread_id);
+        last_ns = timestamp_ns > last_ns ? timestamp_ns : last_ns;
+    }
+    for (size_t t = 0; t < thread_count; t++) {
+        for (uint64_t d = 0; d < threads[t].depth; d++) {
+            write_event(output, &first, NULL, NULL, 'E', last_ns, pid, threads[t].thread_id);
+        }
+    }
+
+    binary_clock_trace_stats_t stats = binary_clock_trace_get_stats();
+    fprintf(output, "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"recorded\":%llu,\"overwritten\":%llu}}\n",
+            (unsigned long long)stats.recorded, (unsigned long long)stats.overwritten);
+    return ferror(output) ? BINARY_CLOCK_ERROR_OUTPUT : BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_trace_save(const char* path) {
+    if (path == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    FILE* output = fopen(path, "w");
+    if (output == NULL) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    binary_clock_error_t error = binary_clock_trace_write(output);
+    if (fclose(output) != 0 && error == BINARY_CLOCK_SUCCESS) {
+        error = BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    return error;
+}
@@ -0,0 +1,689 @@
+/**
+ * @file binary_clock_tune.c
+ * @brief Binary Clock Autotuning Implementation
+ *
+ * Candidates of one kind are measured in interleaved rounds and the best
+ * round of each counts, so a burst of noise cannot favour whichever ran
+ * first. Kernels must produce identical results; only their cost differs.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <binary_clock_tune.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>  // For QueryPerformanceCounter and SwitchToThread
+#else
+    #include <sched.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define TUNE_CYCLE_COUNTER
+static uint64_t read_counter(void) {
+    return __builtin_ia32_rdtsc();
+}
+#elif defined(__GNUC__) && defined(__aarch64__)
+    #define TUNE_CYCLE_COUNTER
+static uint64_t read_counter(void) {
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+}
+#endif
+
+#define TUNE_ROUNDS 3
+#define TUNE_BATCH 64
+#define TUNE_STATES 64
+#define CYCLE_CALIBRATION_US 1000
+
+static const char* const clock_names[BINARY_CLOCK_TUNE_CLOCK_COUNT] = {
+    "time", "realtime", "realtime-coarse", "cycles"
+};
+static const char* const kernel_names[BINARY_CLOCK_TUNE_KERNEL_COUNT] = {"scalar", "table"};
+
+/* ========================================================================== */
+/* TIMING                                                                     */
+/* ========================================================================== */
+
+#ifdef _WIN32
+
+static int64_t elapsed_ns(void) {
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (counter.QuadPart / frequency.QuadPart) * 1000000000LL +
+           (counter.QuadPart % frequency.QuadPart) * 1000000000LL / frequency.QuadPart;
+}
+
+static void yield_cpu(void) {
+    SwitchToThread();
+}
+
+#else
+
+static int64_t elapsed_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static void yield_cpu(void) {
+    sched_yield();
+}
+
+#endif
+
+/* ========================================================================== */
+/* CLOCK SOURCES                                                              */
+/* ========================================================================== */
+
+static int64_t time_now_us(void* context) {
+    (void)context;
+    return (int64_t)time(NULL) * 1000000;
+}
+
+static int64_t realtime_now_us(void* context) {
+    (void)context;
+    return binary_clock_present_now_us();
+}
+
+#if !defined(_WIN32) && defined(CLOCK_REALTIME_COARSE)
+    #define TUNE_COARSE_CLOCK
+static int64_t coarse_now_us(void* context) {
+    (void)context;
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#endif
+
+#ifdef TUNE_CYCLE_COUNTER
+
+// Re-anchor to the wall clock, refining the rate over the whole run
+static int64_t cycle_reanchor(binary_clock_cycle_clock_t* cycles) {
+    int64_t now = binary_clock_present_now_us();
+    uint64_t count = read_counter();
+    if (count > cycles->origin_count && now > cycles->origin_us) {
+        cycles->us_per_count = (double)(now - cycles->origin_us) / (double)(count - cycles->origin_count);
+    }
+    cycles->anchor_count = count;
+    cycles->anchor_us = now;
+    return now;
+}
+
+static int64_t cycle_now_us(void* context) {
+    binary_clock_cycle_clock_t* cycles = context;
+    uint64_t count = read_counter();
+    if (count - cycles->anchor_count >= cycles->reanchor_counts) {
+        return cycle_reanchor(cycles);
+    }
+    return cycles->anchor_us + (int64_t)((double)(count - cycles->anchor_count) * cycles->us_per_count);
+}
+
+// Measure the counter rate against the wall clock; false if it does not tick
+static bool cycle_calibrate(binary_clock_cycle_clock_t* cycles) {
+    cycles->origin_us = binary_clock_present_now_us();
+    cycles->origin_count = read_counter();
+    int64_t now = cycles->origin_us;
+    while (now < cycles->origin_us + CYCLE_CALIBRATION_US) {
+        now = binary_clock_present_now_us();
+    }
+    uint64_t count = read_counter();
+    if (count <= cycles->origin_count) {
+        return false;
+    }
+    cycles->us_per_count = (double)(now - cycles->origin_us) / (double)(count - cycles->origin_count);
+    cycles->reanchor_counts = (uint64_t)(1000000.0 / cycles->us_per_count);
+    cycles->anchor_count = count;
+    cycles->anchor_us = now;
+    return cycles->reanchor_counts > 0;
+}
+
+#endif
+
+// Read function of a clock source, NULL when the host lacks it
+static int64_t (*clock_reader(binary_clock_tune_clock_t clock))(void*) {
+    switch (clock) {
+        case BINARY_CLOCK_TUNE_CLOCK_TIME:
+            return time_now_us;
+        case BINARY_CLOCK_TUNE_CLOCK_REALTIME:
+            return realtime_now_us;
+#ifdef TUNE_COARSE_CLOCK
+        case BINARY_CLOCK_TUNE_CLOCK_REALTIME_COARSE:
+            return coarse_now_us;
+#endif
+#ifdef TUNE_CYCLE_COUNTER
+        case BINARY_CLOCK_TUNE_CLOCK_CYCLES:
+            return cycle_now_us;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+// Smallest step a clock can show
+static int64_t clock_resolution_ns(binary_clock_tune_clock_t clock) {
+    switch (clock) {
+        case BINARY_CLOCK_TUNE_CLOCK_TIME:
+            return 1000000000LL;
+        case BINARY_CLOCK_TUNE_CLOCK_CYCLES:
+            // The counter resolves far finer than the microseconds it reports
+            return 1000;
+        default:
+            break;
+    }
+#ifndef _WIN32
+    struct timespec res;
+    clockid_t id = CLOCK_REALTIME;
+#ifdef TUNE_COARSE_CLOCK
+    if (clock == BINARY_CLOCK_TUNE_CLOCK_REALTIME_COARSE) {
+        id = CLOCK_REALTIME_COARSE;
+    }
+#endif
+    if (clock_getres(id, &res) == 0) {
+        int64_t ns = (int64_t)res.tv_sec * 1000000000LL + res.tv_nsec;
+        return ns < 1000 ? 1000 : ns;  // Sources report whole microseconds
+    }
+    return 0;
+#else
+    // Watch the wall clock step (GetSystemTimeAsFileTime ticks coarsely)
+    int64_t first = realtime_now_us(NULL);
+    int64_t deadline = elapsed_ns() + 20000000LL;
+    int64_t now = first;
+    while (now == first && elapsed_ns() < deadline) {
+        now = realtime_now_us(NULL);
+    }
+    return now > first ? (now - first) * 1000 : 20000000LL;
+#endif
+}
+
+/* ========================================================================== */
+/* CONVERSION KERNELS                                                         */
+/* ========================================================================== */
+
+// Two levels, all L1-resident (about 400 bytes): each time component
+// maps to its pre-shifted BCD digit pair, which ORed together is the
+// packed LED mask; each digit of that maps to its LED column
+#define BCD(v) ((((v) / 10) << 4) | ((v) % 10))
+#define BCD6(v) BCD(v), BCD((v) + 1), BCD((v) + 2), BCD((v) + 3), BCD((v) + 4), BCD((v) + 5)
+#define HOUR6(v) (uint32_t)BCD(v) << 16, (uint32_t)BCD((v) + 1) << 16, (uint32_t)BCD((v) + 2) << 16, \
+                 (uint32_t)BCD((v) + 3) << 16, (uint32_t)BCD((v) + 4) << 16, (uint32_t)BCD((v) + 5) << 16
+#define MINUTE6(v) (uint16_t)(BCD(v) << 8), (uint16_t)(BCD((v) + 1) << 8), (uint16_t)(BCD((v) + 2) << 8), \
+                   (uint16_t)(BCD((v) + 3) << 8), (uint16_t)(BCD((v) + 4) << 8), (uint16_t)(BCD((v) + 5) << 8)
+
+static const uint32_t hour_patterns[24] = {HOUR6(0), HOUR6(6), HOUR6(12), HOUR6(18)};
+static const uint16_t minute_patterns[60] = {
+    MINUTE6(0), MINUTE6(6), MINUTE6(12), MINUTE6(18), MINUTE6(24),
+    MINUTE6(30), MINUTE6(36), MINUTE6(42), MINUTE6(48), MINUTE6(54)
+};
+static const uint8_t second_patterns[60] = {
+    BCD6(0), BCD6(6), BCD6(12), BCD6(18), BCD6(24), BCD6(30), BCD6(36), BCD6(42), BCD6(48), BCD6(54)
+};
+
+#define COLUMN3(v) {3, {((v) >> 2) & 1, ((v) >> 1) & 1, (v) & 1, false, false, false}, (v)}
+#define COLUMN4(v) {4, {((v) >> 3) & 1, ((v) >> 2) & 1, ((v) >> 1) & 1, (v) & 1, false, false}, (v)}
+
+static const binary_value_t tens_columns[6] = {
+    COLUMN3(0), COLUMN3(1), COLUMN3(2), COLUMN3(3), COLUMN3(4), COLUMN3(5)
+};
+static const binary_value_t units_columns[10] = {
+    COLUMN4(0), COLUMN4(1), COLUMN4(2), COLUMN4(3), COLUMN4(4),
+    COLUMN4(5), COLUMN4(6), COLUMN4(7), COLUMN4(8), COLUMN4(9)
+};
+
+#define CONVERT_TABLE_BYTES (sizeof(hour_patterns) + sizeof(minute_patterns) + sizeof(second_patterns) + \
+                             sizeof(tens_columns) + sizeof(units_columns))
+
+uint32_t binary_clock_tune_packed_from_epoch(int64_t epoch_seconds, int32_t utc_offset_seconds) {
+    // Floor modulo of the reduced operands, as binary_clock_time_from_epoch()
+    int64_t second_of_day = (epoch_seconds % 86400 + utc_offset_seconds % 86400) % 86400;
+    if (second_of_day < 0) {
+        second_of_day += 86400;
+    }
+    uint32_t seconds = (uint32_t)second_of_day;
+    uint32_t hours = seconds / 3600;
+    seconds -= hours * 3600;
+    uint32_t minutes = seconds / 60;
+    seconds -= minutes * 60;
+    return hour_patterns[hours] | minute_patterns[minutes] | second_patterns[seconds];
+}
+
+binary_clock_state_t binary_clock_tune_state_from_epoch_table(int64_t epoch_seconds, int32_t utc_offset_seconds) {
+    uint32_t packed = binary_clock_tune_packed_from_epoch(epoch_seconds, utc_offset_seconds);
+    binary_clock_state_t state;
+    // memcpy rather than assignment: compilers pair assigned columns into
+    // 16-byte moves through the stack, which stalls store forwarding
+    memcpy(&state.hours_tens, &tens_columns[packed >> BINARY_CLOCK_PACKED_HOURS_TENS_SHIFT], sizeof(binary_value_t));
+    memcpy(&state.hours_units, &units_columns[(packed >> BINARY_CLOCK_PACKED_HOURS_UNITS_SHIFT) & 0xF],
+           sizeof(binary_value_t));
+    memcpy(&state.minutes_tens, &tens_columns[(packed >> BINARY_CLOCK_PACKED_MINUTES_TENS_SHIFT) & 0xF],
+           sizeof(binary_value_t));
+    memcpy(&state.minutes_units, &units_columns[(packed >> BINARY_CLOCK_PACKED_MINUTES_UNITS_SHIFT) & 0xF],
+           sizeof(binary_value_t));
+    memcpy(&state.seconds_tens, &tens_columns[(packed >> BINARY_CLOCK_PACKED_SECONDS_TENS_SHIFT) & 0xF],
+           sizeof(binary_value_t));
+    memcpy(&state.seconds_units, &units_columns[packed & 0xF], sizeof(binary_value_t));
+    state.timestamp = (binary_clock_time_t)epoch_seconds;
+    return state;
+}
+
+size_t binary_clock_tune_convert_table_size(void) {
+    return CONVERT_TABLE_BYTES;
+}
+
+static const binary_clock_convert_fn_t convert_kernels[BINARY_CLOCK_TUNE_KERNEL_COUNT] = {
+    binary_clock_state_from_epoch, binary_clock_tune_state_from_epoch_table
+};
+static const binary_clock_render_fn_t render_kernels[BINARY_CLOCK_TUNE_KERNEL_COUNT] = {
+    binary_clock_display_render, binary_clock_display_render_table
+};
+
+/* ========================================================================== */
+/* MEASUREMENT                                                                */
+/* ========================================================================== */
+
+// Results feed this so the measured calls cannot be optimized away
+static volatile uint64_t tune_sink;
+
+static double measure_clock(int64_t (*now_us)(void*), void* context, int64_t slice_ns) {
+    uint64_t sum = 0;
+    uint64_t calls = 0;
+    int64_t start = elapsed_ns();
+    int64_t elapsed;
+    do {
+        for (int i = 0; i < TUNE_BATCH; i++) {
+            sum += (uint64_t)now_us(context);
+        }
+        calls += TUNE_BATCH;
+        elapsed = elapsed_ns() - start;
+    } while (elapsed < slice_ns);
+    tune_sink += sum;
+    return (double)elapsed / (double)calls;
+}
+
+static double measure_convert(binary_clock_convert_fn_t convert, int64_t slice_ns) {
+    uint64_t sum = 0;
+    uint64_t calls = 0;
+    int64_t start = elapsed_ns();
+    int64_t elapsed;
+    do {
+        for (int i = 0; i < TUNE_BATCH; i++) {
+            binary_clock_state_t state = convert(1700000000LL + (int64_t)(calls + (uint64_t)i) * 7919, 0);
+            sum += state.seconds_units.decimal_value + state.hours_tens.bits[1];
+        }
+        calls += TUNE_BATCH;
+        elapsed = elapsed_ns() - start;
+    } while (elapsed < slice_ns);
+    tune_sink += sum;
+    return (double)elapsed / (double)calls;
+}
+
+static double measure_render(binary_clock_render_fn_t render, const binary_clock_state_t* states, int64_t slice_ns) {
+    char buffer[BINARY_CLOCK_RENDER_MAX_SIZE];
+    uint64_t sum = 0;
+    uint64_t calls = 0;
+    int64_t start = elapsed_ns();
+    int64_t elapsed;
+    do {
+        // One call renders the state in every format
+        const binary_clock_state_t* state = &states[calls % TUNE_STATES];
+        for (int format = BINARY_CLOCK_RENDER_EMOJI; format <= BINARY_CLOCK_RENDER_EMOJI_LINE; format++) {
+            sum += render(state, (binary_clock_render_format_t)format, buffer, sizeof(buffer));
+        }
+        calls++;
+        elapsed = elapsed_ns() - start;
+    } while (elapsed < slice_ns);
+    tune_sink += sum;
+    return (double)elapsed / (double)calls;
+}
+
+static double keep_best(double best, double measured) {
+    return best == 0.0 || measured < best ? measured : best;
+}
+
+/* ========================================================================== */
+/* CPU MODEL                                                                  */
+/* ========================================================================== */
+
+static void trim(char* text) {
+    size_t length = strlen(text);
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r' || text[length - 1] == ' ')) {
+        text[--length] = '\0';
+    }
+}
+
+// Value of "key : value" if the line has that key
+static const char* cpuinfo_value(const char* line, const char* key) {
+    size_t length = strlen(key);
+    if (strncmp(line, key, length) != 0) {
+        return NULL;
+    }
+    const char* colon = strchr(line + length, ':');
+    if (colon == NULL) {
+        return NULL;
+    }
+    colon++;
+    while (*colon == ' ' || *colon == '\t') {
+        colon++;
+    }
+    return colon;
+}
+
+static void detect_cpu_model(char* model, size_t size) {
+    snprintf(model, size, "unknown");
+#ifdef _WIN32
+    const char* identifier = getenv("PROCESSOR_IDENTIFIER");
+    if (identifier != NULL) {
+        snprintf(model, size, "%s", identifier);
+    }
+#else
+    FILE* cpuinfo = fopen("/proc/cpuinfo", "r");
+    if (cpuinfo == NULL) {
+        return;
+    }
+    char line[1024];
+    char name[96] = "";
+    char implementer[16] = "";
+    char part[16] = "";
+    bool virtualized = false;
+    while (fgets(line, sizeof(line), cpuinfo) != NULL) {
+        const char* value;
+        trim(line);
+        if (name[0] == '\0' && ((value = cpuinfo_value(line, "model name")) != NULL ||
+                                (value = cpuinfo_value(line, "Hardware")) != NULL)) {
+            snprintf(name, sizeof(name), "%s", value);
+        } else if (implementer[0] == '\0' && (value = cpuinfo_value(line, "CPU implementer")) != NULL) {
+            snprintf(implementer, sizeof(implementer), "%s", value);
+        } else if (part[0] == '\0' && (value = cpuinfo_value(line, "CPU part")) != NULL) {
+            snprintf(part, sizeof(part), "%s", value);
+        } else if ((value = cpuinfo_value(line, "flags")) != NULL && strstr(value, " hypervisor") != NULL) {
+            virtualized = true;
+        }
+    }
+    fclose(cpuinfo);
+
+    if (name[0] == '\0' && implementer[0] != '\0') {
+        // Many ARM kernels name no model: identify the core instead
+        snprintf(name, sizeof(name), "arm %s/%s", implementer, part);
+    }
+    if (name[0] != '\0') {
+        snprintf(model, size, "%s%s", name, virtualized ? " (VM)" : "");
+    }
+#endif
+}
+
+/* ========================================================================== */
+/* TUNER                                                                      */
+/* ========================================================================== */
+
+// Charge the tables the chosen kernels read; over the cap, the scalar
+// kernels are used instead (the decision itself is kept for the cache)
+static void charge_tables(binary_clock_tune_t* tune) {
+    binary_clock_mem_release(BINARY_CLOCK_MEM_TABLES, tune->table_bytes);
+    size_t bytes = 0;
+    if (tune->convert == BINARY_CLOCK_TUNE_KERNEL_TABLE) {
+        bytes += CONVERT_TABLE_BYTES;
+    }
+    if (tune->render == BINARY_CLOCK_TUNE_KERNEL_TABLE) {
+        bytes += binary_clock_display_table_size();
+    }
+    tune->tables_capped = bytes > 0 && !binary_clock_mem_reserve(BINARY_CLOCK_MEM_TABLES, bytes);
+    tune->table_bytes = tune->tables_capped ? 0 : bytes;
+}
+
+// Kernel actually used for a choice
+static binary_clock_tune_kernel_t used_kernel(const binary_clock_tune_t* tune, binary_clock_tune_kernel_t kernel) {
+    return tune == NULL || tune->tables_capped ? BINARY_CLOCK_TUNE_KERNEL_SCALAR : kernel;
+}
+
+void binary_clock_tune_init(binary_clock_tune_t* tune) {
+    if (tune == NULL) {
+        return;
+    }
+    memset(tune, 0, sizeof(*tune));
+    detect_cpu_model(tune->cpu_model, sizeof(tune->cpu_model));
+    tune->clock = BINARY_CLOCK_TUNE_CLOCK_REALTIME;
+    tune->convert = BINARY_CLOCK_TUNE_KERNEL_SCALAR;
+    tune->render = BINARY_CLOCK_TUNE_KERNEL_SCALAR;
+}
+
+binary_clock_error_t binary_clock_tune_run(binary_clock_tune_t* tune, int budget_ms) {
+    if (tune == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    if (budget_ms <= 0) {
+        budget_ms = BINARY_CLOCK_TUNE_DEFAULT_BUDGET_MS;
+    }
+    int64_t started = elapsed_ns();
+    // Half the budget for the clocks, a quarter each for the kernels
+    int64_t clock_slice = (int64_t)budget_ms * 500000 / (TUNE_ROUNDS * BINARY_CLOCK_TUNE_CLOCK_COUNT);
+    int64_t kernel_slice = (int64_t)budget_ms * 250000 / (TUNE_ROUNDS * BINARY_CLOCK_TUNE_KERNEL_COUNT);
+
+    void* contexts[BINARY_CLOCK_TUNE_CLOCK_COUNT] = {NULL, NULL, NULL, NULL};
+    bool available[BINARY_CLOCK_TUNE_CLOCK_COUNT];
+    for (int c = 0; c < BINARY_CLOCK_TUNE_CLOCK_COUNT; c++) {
+        available[c] = clock_reader((binary_clock_tune_clock_t)c) != NULL;
+        tune->clock_ns[c] = 0.0;
+        tune->clock_resolution_ns[c] = 0;
+    }
+#ifdef TUNE_CYCLE_COUNTER
+    available[BINARY_CLOCK_TUNE_CLOCK_CYCLES] = cycle_calibrate(&tune->cycles);
+    contexts[BINARY_CLOCK_TUNE_CLOCK_CYCLES] = &tune->cycles;
+#endif
+
+    for (int round = 0; round < TUNE_ROUNDS; round++) {
+        for (int c = 0; c < BINARY_CLOCK_TUNE_CLOCK_COUNT; c++) {
+            if (available[c]) {
+                double cost = measure_clock(clock_reader((binary_clock_tune_clock_t)c), contexts[c], clock_slice);
+                tune->clock_ns[c] = keep_best(tune->clock_ns[c], cost);
+            }
+        }
+    }
+
+    // Cheapest clock that still resolves presentation times; wall clock otherwise
+    tune->clock = BINARY_CLOCK_TUNE_CLOCK_REALTIME;
+    for (int c = 0; c < BINARY_CLOCK_TUNE_CLOCK_COUNT; c++) {
+        if (!available[c]) {
+            continue;
+        }
+        tune->clock_resolution_ns[c] = clock_resolution_ns((binary_clock_tune_clock_t)c);
+        bool eligible = tune->clock_resolution_ns[c] > 0 &&
+                        tune->clock_resolution_ns[c] <= BINARY_CLOCK_TUNE_MAX_RESOLUTION_US * 1000LL;
+        if (eligible && tune->clock_ns[c] < tune->clock_ns[tune->clock]) {
+            tune->clock = (binary_clock_tune_clock_t)c;
+        }
+    }
+
+    binary_clock_state_t states[TUNE_STATES];
+    for (int i = 0; i < TUNE_STATES; i++) {
+        states[i] = binary_clock_state_from_epoch(1700000000LL + (int64_t)i * 4099, 0);
+    }
+    for (int k = 0; k < BINARY_CLOCK_TUNE_KERNEL_COUNT; k++) {
+        tune->convert_ns[k] = 0.0;
+        tune->render_ns[k] = 0.0;
+    }
+    for (int round = 0; round < TUNE_ROUNDS; round++) {
+        for (int k = 0; k < BINARY_CLOCK_TUNE_KERNEL_COUNT; k++) {
+            tune->convert_ns[k] = keep_best(tune->convert_ns[k], measure_convert(convert_kernels[k], kernel_slice));
+            tune->render_ns[k] = keep_best(tune->render_ns[k], measure_render(render_kernels[k], states, kernel_slice));
+        }
+    }
+    tune->convert = BINARY_CLOCK_TUNE_KERNEL_SCALAR;
+    tune->render = BINARY_CLOCK_TUNE_KERNEL_SCALAR;
+    for (int k = 1; k < BINARY_CLOCK_TUNE_KERNEL_COUNT; k++) {
+        if (tune->convert_ns[k] < tune->convert_ns[tune->convert]) {
+            tune->convert = (binary_clock_tune_kernel_t)k;
+        }
+        if (tune->render_ns[k] < tune->render_ns[tune->render]) {
+            tune->render = (binary_clock_tune_kernel_t)k;
+        }
+    }
+
+    charge_tables(tune);
+    tune->cached = false;
+    tune->tuning_ms = (double)(elapsed_ns() - started) / 1e6;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+/* ========================================================================== */
+/* CACHE FILE                                                                 */
+/* ========================================================================== */
+
+static int parse_choice(const char* value, const char* const* names, int count) {
+    for (int i = 0; i < count; i++) {
+        if (strcmp(value, names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+binary_clock_error_t binary_clock_tune_load(binary_clock_tune_t* tune, const char* path) {
+    if (tune == NULL || path == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    FILE* file = fopen(path, "r");
+    if (file == NULL) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    char line[256];
+    bool same_cpu = false;
+    int clock = -1;
+    int convert = -1;
+    int render = -1;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        trim(line);
+        if (strncmp(line, "cpu=", 4) == 0) {
+            same_cpu = strcmp(line + 4, tune->cpu_model) == 0;
+        } else if (strncmp(line, "clock=", 6) == 0) {
+            clock = parse_choice(line + 6, clock_names, BINARY_CLOCK_TUNE_CLOCK_COUNT);
+        } else if (strncmp(line, "convert=", 8) == 0) {
+            convert = parse_choice(line + 8, kernel_names, BINARY_CLOCK_TUNE_KERNEL_COUNT);
+        } else if (strncmp(line, "render=", 7) == 0) {
+            render = parse_choice(line + 7, kernel_names, BINARY_CLOCK_TUNE_KERNEL_COUNT);
+        }
+    }
+    fclose(file);
+
+    if (!same_cpu || clock < 0 || convert < 0 || render < 0 ||
+        clock_reader((binary_clock_tune_clock_t)clock) == NULL) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+#ifdef TUNE_CYCLE_COUNTER
+    // The rate is not cached: it is measured again on every start
+    if (clock == BINARY_CLOCK_TUNE_CLOCK_CYCLES && !cycle_calibrate(&tune->cycles)) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+#endif
+
+    tune->clock = (binary_clock_tune_clock_t)clock;
+    tune->convert = (binary_clock_tune_kernel_t)convert;
+    tune->render = (binary_clock_tune_kernel_t)render;
+    charge_tables(tune);
+    tune->cached = true;
+    tune->tuning_ms = 0.0;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+binary_clock_error_t binary_clock_tune_save(const binary_clock_tune_t* tune, const char* path) {
+    if (tune == NULL || path == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    fprintf(file, "# binary_clock autotune decision, remeasured when the CPU model changes\n");
+    fprintf(file, "cpu=%s\nclock=%s\nconvert=%s\nrender=%s\n", tune->cpu_model,
+            clock_names[tune->clock], kernel_names[tune->convert], kernel_names[tune->render]);
+    bool failed = ferror(file) != 0;
+    if (fclose(file) != 0 || failed) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    return BINARY_CLOCK_SUCCESS;
+}
+
+/* ========================================================================== */
+/* CHOICES                                                                    */
+/* ========================================================================== */
+
+static int64_t tuned_now_us(void* context) {
+    binary_clock_tune_t* tune = context;
+    return clock_reader(tune->clock)(&tune->cycles);
+}
+
+static int64_t tuned_wait_until_us(int64_t target_us, void* context) {
+    // Same shape as binary_clock_present_wait_until_us(), spinning on the tuned clock
+    binary_clock_present_sleep_until_us(target_us - BINARY_CLOCK_PRESENT_SPIN_US);
+    int64_t now = tuned_now_us(context);
+    while (now < target_us) {
+        yield_cpu();
+        now = tuned_now_us(context);
+    }
+    return now;
+}
+
+binary_clock_present_clock_t binary_clock_tune_clock_source(binary_clock_tune_t* tune) {
+    binary_clock_present_clock_t source = {NULL, NULL, NULL};
+    // The wall clock is the presenter default; only other choices need a source
+    if (tune != NULL && tune->clock != BINARY_CLOCK_TUNE_CLOCK_REALTIME && clock_reader(tune->clock) != NULL) {
+        source.now_us = tuned_now_us;
+        source.wait_until_us = tuned_wait_until_us;
+        source.context = tune;
+    }
+    return source;
+}
+
+binary_clock_convert_fn_t binary_clock_tune_convert_fn(const binary_clock_tune_t* tune) {
+    return convert_kernels[used_kernel(tune, tune != NULL ? tune->convert : BINARY_CLOCK_TUNE_KERNEL_SCALAR)];
+}
+
+binary_clock_render_fn_t binary_clock_tune_render_fn(const binary_clock_tune_t* tune) {
+    return render_kernels[used_kernel(tune, tune != NULL ? tune->render : BINARY_CLOCK_TUNE_KERNEL_SCALAR)];
+}
+
+const char* binary_clock_tune_clock_name(binary_clock_tune_clock_t clock) {
+    return clock >= 0 && clock < BINARY_CLOCK_TUNE_CLOCK_COUNT ? clock_names[clock] : "unknown";
+}
+
+const char* binary_clock_tune_kernel_name(binary_clock_tune_kernel_t kernel) {
+    return kernel >= 0 && kernel < BINARY_CLOCK_TUNE_KERNEL_COUNT ? kernel_names[kernel] : "unknown";
+}
+
+size_t binary_clock_tune_describe(const binary_clock_tune_t* tune, char* buffer, size_t size) {
+    if (tune == NULL || buffer == NULL || size == 0) {
+        return 0;
+    }
+    int length = snprintf(buffer, size, "clock=%s convert=%s render=%s", clock_names[tune->clock],
+                          kernel_names[tune->convert], kernel_names[tune->render]);
+    if (tune->tables_capped) {
+        length += snprintf(buffer + length, size > (size_t)length ? size - (size_t)length : 0,
+                           " (tables over the memory cap: scalar used)");
+    }
+    if (tune->cached) {
+        length += snprintf(buffer + length, size > (size_t)length ? size - (size_t)length : 0,
+                           " (cached for %s)", tune->cpu_model);
+    } else {
+        length += snprintf(buffer + length, size > (size_t)length ? size - (size_t)length : 0, " | ns/read:");
+        for (int c = 0; c < BINARY_CLOCK_TUNE_CLOCK_COUNT; c++) {
+            size_t left = size > (size_t)length ? size - (size_t)length : 0;
+            if (tune->clock_ns[c] > 0.0) {
+                length += snprintf(buffer + length, left, " %s %.1f", clock_names[c], tune->clock_ns[c]);
+            } else {
+                length += snprintf(buffer + length, left, " %s n/a", clock_names[c]);
+            }
+        }
+        length += snprintf(buffer + length, size > (size_t)length ? size - (size_t)length : 0,
+                           " | convert ns: scalar %.1f table %.1f | render ns: scalar %.0f table %.0f"
+                           " | %.1f ms on %s",
+                           tune->convert_ns[0], tune->convert_ns[1], tune->render_ns[0], tune->render_ns[1],
+                           tune->tuning_ms, tune->cpu_model);
+    }
+    return (size_t)length < size ? (size_t)length : size - 1;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file binary_clock_waterfall.c
+ * @brief Binary Clock Waterfall Implementation
+ *
+ * The history is rows TOP_ROW to TOP_ROW + rows - 1, set as the scroll
+ * region (DECSTBM). A reverse index (ESC M) on the region's top row
+ * scrolls the region down by one and leaves the cursor on the now blank
+ * top row, where the new row is written. The row's line end only moves
+ * the cursor to the second row, which is why a history has at least two.
+ */
+
+#include <binary_clock_waterfall.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char title[] = "\033[2J\033[H🌝 Binary Clock Waterfall 🌚 (newest first)\n";
+
+binary_clock_error_t binary_clock_waterfall_init(binary_clock_waterfall_t* waterfall, uint32_t rows,
+                                                 binary_clock_render_format_t format) {
+    if (waterfall == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(waterfall, 0, sizeof(*waterfall));
+    waterfall->rows = rows;
+    waterfall->format = format;
+    waterfall->render = binary_clock_display_render_table;
+    if (rows < BINARY_CLOCK_WATERFALL_MIN_ROWS || rows > BINARY_CLOCK_WATERFALL_MAX_ROWS ||
+        (format != BINARY_CLOCK_RENDER_COMPACT && format != BINARY_CLOCK_RENDER_EMOJI_LINE)) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    // Cursor to the top of the history, then reverse index
+    waterfall->prefix_length = (size_t)snprintf(waterfall->prefix, sizeof(waterfall->prefix), "\033[%d;1H\033M",
+                                                BINARY_CLOCK_WATERFALL_TOP_ROW);
+    return BINARY_CLOCK_SUCCESS;
+}
+
+size_t binary_clock_waterfall_begin(const binary_clock_waterfall_t* waterfall, char* output, size_t size) {
+    if (waterfall == NULL || output == NULL) {
+        return 0;
+    }
+    // Title, then the region (which homes the cursor) and the cursor back at its top
+    int length = snprintf(output, size, "%s\033[%d;%ur\033[%d;1H", title, BINARY_CLOCK_WATERFALL_TOP_ROW,
+                          (unsigned)(BINARY_CLOCK_WATERFALL_TOP_ROW - 1 + waterfall->rows),
+                          BINARY_CLOCK_WATERFALL_TOP_ROW);
+    return length > 0 && (size_t)length < size ? (size_t)length : 0;
+}
+
+size_t binary_clock_waterfall_tick(const binary_clock_waterfall_t* waterfall, const binary_clock_state_t* state,
+                                   char* output, size_t size) {
+    if (waterfall == NULL || state == NULL || output == NULL || size <= waterfall->prefix_length) {
+        return 0;
+    }
+    memcpy(output, waterfall->prefix, waterfall->prefix_length);
+    size_t length = waterfall->render(state, waterfall->format, output + waterfall->prefix_length,
+                                      size - waterfall->prefix_length);
+    return length > 0 ? waterfall->prefix_length + length : 0;
+}
+
+size_t binary_clock_waterfall_end(const binary_clock_waterfall_t* waterfall, char* output, size_t size) {
+    if (waterfall == NULL || output == NULL) {
+        return 0;
+    }
+    // Whole screen scrolls again; continue on the line after the history
+    int length = snprintf(output, size, "\033[r\033[%u;1H",
+                          (unsigned)(BINARY_CLOCK_WATERFALL_TOP_ROW + waterfall->rows));
+    return length > 0 && (size_t)length < size ? (size_t)length : 0;
+}
@@ -0,0 +1,478 @@
+/**
+ * @file binary_clock_zone.c
+ * @brief Binary Clock Time Zones Implementation
+ *
+ * TZif files (RFC 8536) list transitions with an index into a table of
+ * local time types. Loading resolves every index to its UTC offset, so
+ * a lookup is one binary search over the instants and one array read.
+ *
+ * The footer is a POSIX TZ string ("CET-1CEST,M3.5.0,M10.5.0/3"). Its
+ * daylight saving rule is expanded year by year from 1970, and every
+ * instant after the file's last transition that changes the offset is
+ * appended to the table.
+ */
+
+#include <binary_clock_zone.h>
+#include <binary_clock_mem.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TZIF_HEADER_SIZE 44
+#define TZIF_TYPE_SIZE 6
+
+// Zone files are a few KB; anything far larger is not one
+#define ZONE_MAX_FILE_SIZE (1 << 20)
+
+// First year footer rules are expanded for
+#define ZONE_FIRST_RULE_YEAR 1970
+
+// POSIX TZ footer: transition day and local time of a rule
+typedef struct {
+    char kind;                  // 'M' month.week.day, 'J' Julian 1-365, 'D' zero-based day
+    int month;
+    int week;
+    int day;
+    int32_t time;               // Local seconds after midnight, 02:00 by default
+} zone_rule_t;
+
+typedef struct {
+    int32_t standard;           // UTC offsets, east positive
+    int32_t daylight;
+    bool has_daylight;
+    zone_rule_t start;          // Daylight saving starts, in standard time
+    zone_rule_t end;            // Daylight saving ends, in daylight time
+} zone_footer_t;
+
+static void set_name(binary_clock_zone_t* zone, const char* name) {
+    if (name != NULL) {
+        strncpy(zone->name, name, sizeof(zone->name) - 1);
+        zone->name[sizeof(zone->name) - 1] = '\0';
+    }
+}
+
+static size_t table_bytes(size_t count) {
+    return count * (sizeof(int64_t) + sizeof(int32_t));
+}
+
+binary_clock_error_t binary_clock_zone_init_fixed(binary_clock_zone_t* zone, const char* name, int32_t offset_seconds) {
+    if (zone == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(zone, 0, sizeof(*zone));
+    set_name(zone, name);
+    zone->initial_offset = offset_seconds;
+    return BINARY_CLOCK_SUCCESS;
+}
+
+/* ========================================================================== */
+/* FOOTER RULES                                                               */
+/* ========================================================================== */
+
+static int64_t days_from_civil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+static bool is_leap(int64_t year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Day (since the epoch) a rule falls on in a year
+static int64_t rule_day(const zone_rule_t* rule, int64_t year) {
+    static const int month_days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int64_t january = days_from_civil(year, 1, 1);
+    if (rule->kind == 'J') {
+        // February 29 is never counted
+        return january + rule->day - 1 + (is_leap(year) && rule->day >= 60);
+    }
+    if (rule->kind == 'D') {
+        return january + rule->day;
+    }
+    int64_t first = days_from_civil(year, rule->month, 1);
+    int weekday = (int)((first % 7 + 11) % 7); // 1970-01-01 was a Thursday
+    int day = 1 + (rule->day - weekday + 7) % 7 + 7 * (rule->week - 1);
+    int length = month_days[rule->month - 1] + (rule->month == 2 && is_leap(year));
+    while (day > length) {
+        day -= 7; // Week 5 means the last such weekday
+    }
+    return first + day - 1;
+}
+
+static const char* parse_number(const char* text, int* value) {
+    if (*text < '0' || *text > '9') {
+        return NULL;
+    }
+    *value = 0;
+    while (*text >= '0' && *text <= '9' && *value < 10000) {
+        *value = *value * 10 + (*text++ - '0');
+    }
+    return text;
+}
+
+// Abbreviation: three or more letters, or anything in angle brackets
+static const char* parse_abbreviation(const char* text) {
+    if (*text == '<') {
+        const char* close = strchr(text, '>');
+        return close != NULL ? close + 1 : NULL;
+    }
+    const char* start = text;
+    while ((*text >= 'A' && *text <= 'Z') || (*text >= 'a' && *text <= 'z')) {
+        text++;
+    }
+    return text - start >= 3 ? text : NULL;
+}
+
+// [+-]hh[:mm[:ss]]
+static const char* parse_duration(const char* text, int32_t* seconds) {
+    static const int32_t units[3] = {3600, 60, 1};
+    int32_t sign = *text == '-' ? -1 : 1;
+    if (*text == '+' || *text == '-') {
+        text++;
+    }
+    int32_t total = 0;
+    for (int part = 0; part < 3; part++) {
+        if (part > 0) {
+            if (*text != ':') {
+                break;
+            }
+            text++;
+        }
+        int value = 0;
+        text = parse_number(text, &value);
+        if (text == NULL || value > 999) {
+            return NULL;
+        }
+        total += value * units[part];
+    }
+    *seconds = sign * total;
+    return text;
+}
+
+static const char* parse_rule(const char* text, zone_rule_t* rule) {
+    rule->kind = *text == 'M' || *text == 'J' ? *text++ : 'D';
+    if (rule->kind == 'M') {
+        int* parts[3] = {&rule->month, &rule->week, &rule->day};
+        for (int i = 0; i < 3; i++) {
+            if (i > 0 && *text++ != '.') {
+                return NULL;
+            }
+            text = parse_number(text, parts[i]);
+            if (text == NULL) {
+                return NULL;
+            }
+        }
+        if (rule->month < 1 || rule->month > 12 || rule->week < 1 || rule->week > 5 || rule->day > 6) {
+            return NULL;
+        }
+    } else {
+        text = parse_number(text, &rule->day);
+        if (text == NULL || rule->day > 365 || (rule->kind == 'J' && rule->day < 1)) {
+            return NULL;
+        }
+    }
+    rule->time = 7200;
+    if (*text == '/') {
+        text = parse_duration(text + 1, &rule->time);
+    }
+    return text;
+}
+
+// POSIX offsets count west positive
+static bool parse_footer(const char* text, zone_footer_t* footer) {
+    int32_t offset = 0;
+    memset(footer, 0, sizeof(*footer));
+    text = parse_abbreviation(text);
+    text = text != NULL ? parse_duration(text, &offset) : NULL;
+    if (text == NULL) {
+        return false;
+    }
+    footer->standard = -offset;
+    if (*text == '\0') {
+        return true;
+    }
+
+    text = parse_abbreviation(text);
+    if (text == NULL) {
+        return false;
+    }
+    footer->has_daylight = true;
+    footer->daylight = footer->standard + 3600;
+    if (*text != ',' && *text != '\0') {
+        text = parse_duration(text, &offset);
+        if (text == NULL) {
+            return false;
+        }
+        footer->daylight = -offset;
+    }
+    // A daylight name without rules gets the POSIX default (US rules)
+    const char* rules = *text == '\0' ? ",M3.2.0,M11.1.0" : text;
+    if (*rules != ',' || (rules = parse_rule(rules + 1, &footer->start)) == NULL ||
+        *rules != ',' || (rules = parse_rule(rules + 1, &footer->end)) == NULL) {
+        return false;
+    }
+    return *rules == '\0';
+}
+
+// Instants a footer rule changes the offset, after the file's own transitions
+static void expand_footer(binary_clock_zone_t* zone, const zone_footer_t* footer) {
+    int64_t last = zone->count > 0 ? zone->transitions[zone->count - 1] : INT64_MIN;
+    int32_t current = zone->count > 0 ? zone->offsets[zone->count - 1] : zone->initial_offset;
+    for (int64_t year = ZONE_FIRST_RULE_YEAR; year <= BINARY_CLOCK_ZONE_LAST_YEAR; year++) {
+        int64_t start = rule_day(&footer->start, year) * 86400 + footer->start.time - footer->standard;
+        int64_t end = rule_day(&footer->end, year) * 86400 + footer->end.time - footer->daylight;
+        int64_t instants[2] = {start, end};
+        int32_t offsets[2] = {footer->daylight, footer->standard};
+        if (end < start) {
+            // Southern hemisphere: daylight time spans the new year
+            instants[0] = end;
+            instants[1] = start;
+            offsets[0] = footer->standard;
+            offsets[1] = footer->daylight;
+        }
+        for (int i = 0; i < 2; i++) {
+            if (instants[i] > last && offsets[i] != current) {
+                zone->transitions[zone->count] = instants[i];
+                zone->offsets[zone->count] = offsets[i];
+                zone->count++;
+                current = offsets[i];
+            }
+        }
+    }
+}
+
+/* ========================================================================== */
+/* TZIF FILES                                                                 */
+/* ========================================================================== */
+
+static uint32_t read_u32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | bytes[3];
+}
+
+static int64_t read_time(const uint8_t* bytes, size_t size) {
+    if (size == 4) {
+        return (int32_t)read_u32(bytes);
+    }
+    return (int64_t)((uint64_t)read_u32(bytes) << 32 | read_u32(bytes + 4));
+}
+
+typedef struct {
+    size_t utc_flags;
+    size_t standard_flags;
+    size_t leaps;
+    size_t times;
+    size_t types;
+    size_t chars;
+} tzif_counts_t;
+
+static tzif_counts_t read_counts(const uint8_t* header) {
+    tzif_counts_t counts = {
+        read_u32(header + 20), read_u32(header + 24), read_u32(header + 28),
+        read_u32(header + 32), read_u32(header + 36), read_u32(header + 40)
+    };
+    return counts;
+}
+
+// Data block size for 4- or 8-byte times, 0 if the counts are implausible
+static size_t block_size(const tzif_counts_t* counts, size_t time_size) {
+    if (counts->types == 0 || counts->types > 256 || counts->times > 65536 || counts->leaps > 65536 ||
+        counts->chars > 65536 || counts->utc_flags > 256 || counts->standard_flags > 256) {
+        return 0;
+    }
+    return counts->times * (time_size + 1) + counts->types * TZIF_TYPE_SIZE + counts->chars +
+           counts->leaps * (time_size + 4) + counts->standard_flags + counts->utc_flags;
+}
+
+binary_clock_error_t binary_clock_zone_parse(binary_clock_zone_t* zone, const char* name,
+                                             const uint8_t* data, size_t length) {
+    if (zone == NULL || data == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    memset(zone, 0, sizeof(*zone));
+    set_name(zone, name);
+    if (length < TZIF_HEADER_SIZE || memcmp(data, "TZif", 4) != 0) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+
+    // Version 2 and later repeat the data with 64-bit times, then a footer
+    tzif_counts_t counts = read_counts(data);
+    size_t size = block_size(&counts, 4);
+    size_t time_size = 4;
+    const uint8_t* header = data;
+    if (size == 0) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    if (data[4] >= '2') {
+        header = data + TZIF_HEADER_SIZE + size;
+        if (TZIF_HEADER_SIZE + size + TZIF_HEADER_SIZE > length || memcmp(header, "TZif", 4) != 0) {
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        counts = read_counts(header);
+        time_size = 8;
+        size = block_size(&counts, time_size);
+    }
+    const uint8_t* times = header + TZIF_HEADER_SIZE;
+    if (size == 0 || (size_t)(times - data) + size > length) {
+        return BINARY_CLOCK_ERROR_OUTPUT;
+    }
+    const uint8_t* indices = times + counts.times * time_size;
+    const uint8_t* types = indices + counts.times;
+
+    zone_footer_t footer;
+    bool has_rule = false;
+    if (time_size == 8) {
+        const char* text = (const char*)(times + size);
+        size_t left = length - (size_t)(times - data) - size;
+        const char* close = left > 1 && text[0] == '\n' ? memchr(text + 1, '\n', left - 1) : NULL;
+        char rule[128];
+        if (close != NULL && (size_t)(close - text) <= sizeof(rule)) {
+            memcpy(rule, text + 1, (size_t)(close - text) - 1);
+            rule[close - text - 1] = '\0';
+            has_rule = rule[0] != '\0' && parse_footer(rule, &footer) && footer.has_daylight;
+        }
+    }
+
+    size_t capacity = counts.times + (has_rule ? 2 * (BINARY_CLOCK_ZONE_LAST_YEAR - ZONE_FIRST_RULE_YEAR + 1) : 0);
+    zone->initial_offset = (int32_t)read_u32(types);
+    if (capacity == 0) {
+        return BINARY_CLOCK_SUCCESS;
+    }
+    zone->transitions = malloc(capacity * sizeof(*zone->transitions));
+    zone->offsets = malloc(capacity * sizeof(*zone->offsets));
+    if (zone->transitions == NULL || zone->offsets == NULL) {
+        binary_clock_zone_free(zone);
+        return BINARY_CLOCK_ERROR_SYSTEM_TIME;
+    }
+    for (size_t i = 0; i < counts.times; i++) {
+        if (indices[i] >= counts.types) {
+            binary_clock_zone_free(zone);
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+        zone->transitions[i] = read_time(times + i * time_size, time_size);
+        zone->offsets[i] = (int32_t)read_u32(types + indices[i] * TZIF_TYPE_SIZE);
+        if (i > 0 && zone->transitions[i] <= zone->transitions[i - 1]) {
+            binary_clock_zone_free(zone);
+            return BINARY_CLOCK_ERROR_OUTPUT;
+        }
+    }
+    zone->count = counts.times;
+    if (has_rule) {
+        expand_footer(zone, &footer);
+    }
+
+    // Give back what the expansion did not use
+    if (zone->count < capacity && zone->count > 0) {
+        int64_t* transitions = realloc(zone->transitions, zone->count * sizeof(*transitions));
+        zone->transitions = transitions != NULL ? transitions : zone->transitions;
+        int32_t* offsets = realloc(zone->offsets, zone->count * sizeof(*offsets));
+        zone->offsets = offsets != NULL ? offsets : zone->offsets;
+    }
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_TABLES, binary_clock_zone_memory(zone));
+    return BINARY_CLOCK_SUCCESS;
+}
+
+// "+HH", "+HH:MM" or "+HHMM", east positive
+static int parse_fixed(const char* name, int32_t* offset) {
+    int hours = 0;
+    int minutes = 0;
+    const char* text = parse_number(name + 1, &hours);
+    if (text == NULL || text - name != 3) {
+        return -1;
+    }
+    if (*text != '\0') {
+        text = parse_number(text + (*text == ':'), &minutes);
+        if (text == NULL || *text != '\0') {
+            return -1;
+        }
+    }
+    if (hours > 23 || minutes > 59) {
+        return -1;
+    }
+    *offset = (name[0] == '-' ? -1 : 1) * (hours * 3600 + minutes * 60);
+    return 0;
+}
+
+binary_clock_error_t binary_clock_zone_load(binary_clock_zone_t* zone, const char* name, const char* directory) {
+    if (zone == NULL || name == NULL) {
+        return BINARY_CLOCK_ERROR_NULL_POINTER;
+    }
+    size_t name_length = strlen(name);
+    if (name_length == 0 || name_length >= BINARY_CLOCK_ZONE_NAME_SIZE) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+    if (strcmp(name, "UTC") == 0 || strcmp(name, "Z") == 0) {
+        return binary_clock_zone_init_fixed(zone, name, 0);
+    }
+    if (name[0] == '+' || name[0] == '-') {
+        int32_t offset = 0;
+        if (parse_fixed(name, &offset) != 0) {
+            return BINARY_CLOCK_ERROR_INVALID_TIME;
+        }
+        return binary_clock_zone_init_fixed(zone, name, offset);
+    }
+    if (name[0] == '/' || strstr(name, "..") != NULL) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+
+    if (directory == NULL) {
+        directory = getenv("TZDIR");
+        if (directory == NULL || directory[0] == '\0') {
+            directory = BINARY_CLOCK_ZONE_DEFAULT_DIRECTORY;
+        }
+    }
+    char path[512];
+    if (snprintf(path, sizeof(path), "%s/%s", directory, name) >= (int)sizeof(path)) {
+        return BINARY_CLOCK_ERROR_INVALID_TIME;
+    }
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return BINARY_CLOCK_ERROR_SYSTEM_TIME;
+    }
+    uint8_t* data = malloc(ZONE_MAX_FILE_SIZE);
+    size_t length = data != NULL ? fread(data, 1, ZONE_MAX_FILE_SIZE, file) : 0;
+    fclose(file);
+    if (data == NULL) {
+        return BINARY_CLOCK_ERROR_SYSTEM_TIME;
+    }
+    binary_clock_error_t error = binary_clock_zone_parse(zone, name, data, length);
+    free(data);
+    return error;
+}
+
+int32_t binary_clock_zone_offset(const binary_clock_zone_t* zone, int64_t epoch_seconds) {
+    if (zone == NULL) {
+        return 0;
+    }
+    // First transition after the instant; the one before it is in force
+    size_t low = 0;
+    size_t high = zone->count;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (zone->transitions[middle] <= epoch_seconds) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low == 0 ? zone->initial_offset : zone->offsets[low - 1];
+}
+
+size_t binary_clock_zone_memory(const binary_clock_zone_t* zone) {
+    return zone != NULL ? table_bytes(zone->count) : 0;
+}
+
+void binary_clock_zone_free(binary_clock_zone_t* zone) {
+    if (zone == NULL) {
+        return;
+    }
+    binary_clock_mem_release(BINARY_CLOCK_MEM_TABLES, binary_clock_zone_memory(zone));
+    free(zone->transitions);
+    free(zone->offsets);
+    zone->transitions = NULL;
+    zone->offsets = NULL;
+    zone->count = 0;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_binary_clock_admit.c
+ * @brief Test suite for Binary Clock admission control
+ *
+ * Drives the limits with a synthetic clock: the client cap, the
+ * per-address cap (including table growth and removal), and the token
+ * bucket's burst and refill.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_admit.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+// 10.0.0.1
+#define ADDRESS 0x0A000001u
+
+void test_unlimited(void) {
+    printf("\n=== Testing Without Limits ===\n");
+
+    binary_clock_admit_t admit;
+    ASSERT_EQ(binary_clock_admit_init(&admit, NULL), BINARY_CLOCK_SUCCESS, "initialized without limits");
+    int admitted = 0;
+    for (int i = 0; i < 10000; i++) {
+        admitted += binary_clock_admit_check(&admit, ADDRESS, 0) == BINARY_CLOCK_ADMIT_OK;
+    }
+    ASSERT_EQ(admitted, 10000, "everyone admitted");
+    ASSERT_EQ(admit.active, 10000, "connections counted");
+    ASSERT_EQ(binary_clock_admit_memory(&admit), 0, "no per-address table without a per-address cap");
+    for (int i = 0; i < 10000; i++) {
+        binary_clock_admit_release(&admit, ADDRESS);
+    }
+    binary_clock_admit_release(&admit, ADDRESS);
+    ASSERT_EQ(admit.active, 0, "releases counted, never below zero");
+    binary_clock_admit_free(&admit);
+}
+
+void test_client_cap(void) {
+    printf("\n=== Testing Client Cap ===\n");
+
+    binary_clock_admit_limits_t limits = {3, 0, 0, 0};
+    binary_clock_admit_t admit;
+    binary_clock_admit_init(&admit, &limits);
+    for (uint32_t i = 0; i < 3; i++) {
+        binary_clock_admit_check(&admit, ADDRESS + i, 0);
+    }
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS + 3, 0), BINARY_CLOCK_ADMIT_FULL, "fourth client rejected");
+    ASSERT_EQ(admit.active, 3, "rejected client not counted");
+    binary_clock_admit_release(&admit, ADDRESS + 1);
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS + 3, 0), BINARY_CLOCK_ADMIT_OK, "departure frees a place");
+    ASSERT_EQ(admit.stats.admitted, 4, "admissions counted");
+    ASSERT_EQ(admit.stats.rejected_full, 1, "rejections counted");
+    binary_clock_admit_free(&admit);
+}
+
+void test_address_cap(void) {
+    printf("\n=== Testing Per-Address Cap ===\n");
+
+    binary_clock_admit_limits_t limits = {0, 2, 0, 0};
+    binary_clock_admit_t admit;
+    binary_clock_admit_init(&admit, &limits);
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, 0), BINARY_CLOCK_ADMIT_OK, "first from an address");
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, 0), BINARY_CLOCK_ADMIT_OK, "second from an address");
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, 0), BINARY_CLOCK_ADMIT_ADDRESS, "third from an address rejected");
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS + 1, 0), BINARY_CLOCK_ADMIT_OK, "other address admitted");
+
+    // Many addresses: the table grows and every count survives
+    for (uint32_t i = 2; i < 5000; i++) {
+        binary_clock_admit_check(&admit, ADDRESS + i * 256, 0);
+        binary_clock_admit_check(&admit, ADDRESS + i * 256, 0);
+    }
+    ASSERT_EQ(admit.address_count, 5000, "addresses tracked");
+    ASSERT_TRUE(admit.address_capacity >= 10000, "table kept at most half full");
+    int capped = 1;
+    for (uint32_t i = 2; i < 5000; i++) {
+        capped &= binary_clock_admit_check(&admit, ADDRESS + i * 256, 0) == BINARY_CLOCK_ADMIT_ADDRESS;
+    }
+    ASSERT_TRUE(capped, "every address at its cap after growth");
+
+    // Emptying addresses in any order leaves the others findable
+    for (uint32_t i = 2; i < 5000; i += 2) {
+        binary_clock_admit_release(&admit, ADDRESS + i * 256);
+        binary_clock_admit_release(&admit, ADDRESS + i * 256);
+    }
+    ASSERT_EQ(admit.address_count, 2501, "emptied addresses removed");
+    int found = 1;
+    for (uint32_t i = 3; i < 5000; i += 2) {
+        found &= binary_clock_admit_check(&admit, ADDRESS + i * 256, 0) == BINARY_CLOCK_ADMIT_ADDRESS;
+    }
+    ASSERT_TRUE(found, "remaining addresses still at their cap");
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS + 2 * 256, 0), BINARY_CLOCK_ADMIT_OK, "emptied address admitted again");
+    ASSERT_EQ(binary_clock_admit_memory(&admit), admit.address_capacity * sizeof(binary_clock_admit_entry_t),
+              "memory counts the table");
+
+    ASSERT_EQ(binary_clock_admit_add(&admit, ADDRESS), BINARY_CLOCK_SUCCESS, "add ignores the limits");
+    binary_clock_admit_free(&admit);
+    ASSERT_EQ(binary_clock_admit_memory(&admit), 0, "table freed");
+}
+
+void test_rate(void) {
+    printf("\n=== Testing Token Bucket ===\n");
+
+    binary_clock_admit_limits_t limits = {0, 0, 10, 5};
+    binary_clock_admit_t admit;
+    binary_clock_admit_init(&admit, &limits);
+    int64_t now = 1000000;
+    int admitted = 0;
+    for (int i = 0; i < 20; i++) {
+        admitted += binary_clock_admit_check(&admit, ADDRESS, now) == BINARY_CLOCK_ADMIT_OK;
+    }
+    ASSERT_EQ(admitted, 5, "burst admitted at once");
+    ASSERT_EQ(admit.stats.rejected_rate, 15, "rest of the burst rejected");
+
+    now += 100000;  // 0.1 s at 10/s: one token
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now), BINARY_CLOCK_ADMIT_OK, "token refilled");
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now), BINARY_CLOCK_ADMIT_RATE, "only one token refilled");
+    now += 50000;
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now), BINARY_CLOCK_ADMIT_RATE, "half a token is not enough");
+    now += 50000;
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now), BINARY_CLOCK_ADMIT_OK, "partial refills add up");
+
+    now += 3600LL * 1000000;
+    admitted = 0;
+    for (int i = 0; i < 20; i++) {
+        admitted += binary_clock_admit_check(&admit, ADDRESS, now) == BINARY_CLOCK_ADMIT_OK;
+    }
+    ASSERT_EQ(admitted, 5, "long idle refills to the burst only");
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now - 1000000), BINARY_CLOCK_ADMIT_RATE,
+              "clock going back adds no tokens");
+
+    // Rejections for other reasons spend no token
+    binary_clock_admit_limits_t capped = {1, 0, 10, 1};
+    binary_clock_admit_init(&admit, &capped);
+    binary_clock_admit_add(&admit, ADDRESS);
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now), BINARY_CLOCK_ADMIT_FULL, "cap checked before rate");
+    binary_clock_admit_release(&admit, ADDRESS);
+    ASSERT_EQ(binary_clock_admit_check(&admit, ADDRESS, now), BINARY_CLOCK_ADMIT_OK, "token still there");
+
+    limits.burst = 0;
+    binary_clock_admit_init(&admit, &limits);
+    admitted = 0;
+    for (int i = 0; i < 20; i++) {
+        admitted += binary_clock_admit_check(&admit, ADDRESS, now) == BINARY_CLOCK_ADMIT_OK;
+    }
+    ASSERT_EQ(admitted, 10, "burst defaults to the rate");
+}
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_admit_limits_t limits = {0, 0, 0, 0};
+    ASSERT_EQ(binary_clock_admit_init(NULL, &limits), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL state rejected");
+    ASSERT_EQ(binary_clock_admit_add(NULL, ADDRESS), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL add rejected");
+    binary_clock_admit_release(NULL, ADDRESS);
+    binary_clock_admit_free(NULL);
+    ASSERT_EQ(binary_clock_admit_memory(NULL), 0, "NULL state holds no memory");
+}
+
+int main(void) {
+    printf("=== Binary Clock Admission Control Test Suite ===\n");
+
+    test_unlimited();
+    test_client_cap();
+    test_address_cap();
+    test_rate();
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All admission control tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
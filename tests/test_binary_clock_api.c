@@ -199,6 +199,61 @@ void test_data_integrity(void) {
     ASSERT_EQ(state.seconds_units.decimal_value, 9, "seconds_units decimal matches");
 }
 
+// Test epoch conversion and packed representation
+void test_epoch_and_packed(void) {
+    printf("\n=== Testing Epoch and Packed Representations ===\n");
+    
+    // 2023-11-14T22:13:20Z
+    time_components_t time_comp = binary_clock_time_from_epoch(1700000000, 0);
+    ASSERT_EQ(time_comp.hours, 22, "epoch hours at UTC");
+    ASSERT_EQ(time_comp.minutes, 13, "epoch minutes at UTC");
+    ASSERT_EQ(time_comp.seconds, 20, "epoch seconds at UTC");
+    
+    time_comp = binary_clock_time_from_epoch(1700000000, 2 * 3600);
+    ASSERT_EQ(time_comp.hours, 0, "positive offset wraps past midnight");
+    
+    time_comp = binary_clock_time_from_epoch(1700000000, -23 * 3600);
+    ASSERT_EQ(time_comp.hours, 23, "negative offset wraps before midnight");
+    
+    time_comp = binary_clock_time_from_epoch(-1, 0);
+    ASSERT_TRUE(time_comp.hours == 23 && time_comp.minutes == 59 && time_comp.seconds == 59,
+                "negative epoch maps to 23:59:59");
+    
+    // Operands are reduced before adding: no overflow at the int64 extremes
+    time_comp = binary_clock_time_from_epoch(INT64_MAX, 3600);
+    ASSERT_TRUE(time_comp.hours == 16 && time_comp.minutes == 30 && time_comp.seconds == 7,
+                "INT64_MAX plus an hour maps to 16:30:07");
+    time_comp = binary_clock_time_from_epoch(INT64_MAX - 1, 86399);
+    ASSERT_TRUE(time_comp.hours == 15 && time_comp.minutes == 30 && time_comp.seconds == 5,
+                "INT64_MAX - 1 plus a day less a second maps to 15:30:05");
+    time_comp = binary_clock_time_from_epoch(INT64_MIN, -86399);
+    ASSERT_TRUE(time_comp.hours == 8 && time_comp.minutes == 29 && time_comp.seconds == 53,
+                "INT64_MIN minus a day less a second maps to 08:29:53");
+    
+    binary_clock_state_t state = binary_clock_state_from_epoch(1700000000, 0);
+    ASSERT_TRUE(state.timestamp == (time_t)1700000000, "state timestamp equals epoch");
+    ASSERT_EQ(state.hours_tens.decimal_value, 2, "epoch state hours_tens");
+    ASSERT_EQ(state.seconds_units.decimal_value, 0, "epoch state seconds_units");
+    
+    time_components_t test_time = {14, 30, 45};
+    state = binary_clock_state_from_time(&test_time);
+    ASSERT_EQ(binary_clock_pack_state(&state), 0x143045, "packed state is BCD of HHMMSS");
+    ASSERT_EQ(binary_clock_pack_state(NULL), 0, "packed NULL state is 0");
+    
+    // Incremental path carries through every digit
+    ASSERT_EQ(binary_clock_packed_next_second(0x143045), 0x143046, "next second increments units");
+    ASSERT_EQ(binary_clock_packed_next_second(0x095959), 0x100000, "next second carries into hours tens");
+    ASSERT_EQ(binary_clock_packed_next_second(0x235959), 0x000000, "next second wraps at midnight");
+    
+    state = binary_clock_state_from_packed(0x143045, 1700000000);
+    ASSERT_EQ(binary_clock_pack_state(&state), 0x143045, "packed round trip");
+    ASSERT_TRUE(state.timestamp == 1700000000, "state from packed keeps timestamp");
+    state = binary_clock_state_from_packed(0x1430A0, 1700000000);
+    ASSERT_EQ(state.timestamp, 0, "non-BCD packed digit rejected");
+    state = binary_clock_state_from_packed(0x146000, 1700000000);
+    ASSERT_EQ(state.timestamp, 0, "packed minutes out of range rejected");
+}
+
 // Test utility functions
 void test_utility_functions(void) {
     printf("\n=== Testing Utility Functions ===\n");
@@ -258,6 +313,7 @@ int main(void) {
     test_binary_conversion();
     test_time_management();
     test_data_integrity();
+    test_epoch_and_packed();
     test_utility_functions();
     test_performance();
     
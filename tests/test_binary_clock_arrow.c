@@ -0,0 +1,293 @@
+/**
+ * @file test_binary_clock_arrow.c
+ * @brief Test suite for the Binary Clock Arrow export
+ *
+ * Writes Arrow IPC streams and files to temporary files and walks them
+ * back with a minimal FlatBuffers reader to verify framing, metadata and
+ * column contents.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_arrow.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+/* ========================================================================== */
+/* MINIMAL FLATBUFFERS READER                                                 */
+/* ========================================================================== */
+
+static uint64_t read_le(const uint8_t* data, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= (uint64_t)data[i] << (8 * i);
+    }
+    return value;
+}
+
+// Position of field `id` within the table at `table`, or 0 when absent
+static size_t fb_field(const uint8_t* buf, size_t table, int id) {
+    size_t vtable = table - (int32_t)read_le(buf + table, 4);
+    uint16_t vtable_size = (uint16_t)read_le(buf + vtable, 2);
+    if ((size_t)(4 + 2 * id) >= vtable_size) {
+        return 0;
+    }
+    uint16_t offset = (uint16_t)read_le(buf + vtable + 4 + 2 * id, 2);
+    return offset ? table + offset : 0;
+}
+
+static size_t fb_deref(const uint8_t* buf, size_t pos) {
+    return pos + (uint32_t)read_le(buf + pos, 4);
+}
+
+/* ========================================================================== */
+/* HELPERS                                                                    */
+/* ========================================================================== */
+
+static uint8_t* write_to_memory(int64_t start, int64_t end, binary_clock_arrow_format_t format,
+                                uint32_t batch_rows, size_t* size) {
+    FILE* file = tmpfile();
+    if (file == NULL) {
+        return NULL;
+    }
+    if (binary_clock_arrow_write_range(file, start, end, 0, format, batch_rows) != BINARY_CLOCK_SUCCESS) {
+        fclose(file);
+        return NULL;
+    }
+
+    long length = ftell(file);
+    uint8_t* data = malloc((size_t)length);
+    rewind(file);
+    if (data == NULL || fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+
+    *size = (size_t)length;
+    return data;
+}
+
+/**
+ * @brief Walk an IPC stream starting at `pos`, checking every batch
+ *
+ * @return Total number of rows seen, or -1 on a framing error
+ */
+static long long walk_stream(const uint8_t* data, size_t size, size_t pos, int64_t start, int* batches) {
+    long long rows_seen = 0;
+    int message_index = 0;
+
+    while (pos + 8 <= size) {
+        if (read_le(data + pos, 4) != 0xFFFFFFFFu) {
+            return -1;
+        }
+        uint32_t metadata_size = (uint32_t)read_le(data + pos + 4, 4);
+        if (metadata_size == 0) {
+            return rows_seen; // End-of-stream marker
+        }
+        if (metadata_size % 8 != 0) {
+            return -1;
+        }
+
+        const uint8_t* meta = data + pos + 8;
+        size_t message = fb_deref(meta, 0);
+        uint8_t header_type = meta[fb_field(meta, message, 1)];
+        int64_t body_length = (int64_t)read_le(meta + fb_field(meta, message, 3), 8);
+        size_t body = pos + 8 + metadata_size;
+
+        if (message_index == 0 && header_type != 1) {
+            return -1; // First message must be the schema
+        }
+
+        if (header_type == 3) {
+            size_t batch = fb_deref(meta, fb_field(meta, message, 2));
+            int64_t length = (int64_t)read_le(meta + fb_field(meta, batch, 0), 8);
+            size_t buffers = fb_deref(meta, fb_field(meta, batch, 2));
+
+            // Buffer 1 is the epoch column, buffer 3 the packed LEDs
+            uint64_t epoch_offset = read_le(meta + buffers + 4 + 16 * 1, 8);
+            uint64_t leds_offset = read_le(meta + buffers + 4 + 16 * 3, 8);
+            for (int64_t row = 0; row < length; row++) {
+                int64_t epoch = (int64_t)read_le(data + body + epoch_offset + 8 * row, 8);
+                uint32_t leds = (uint32_t)read_le(data + body + leds_offset + 4 * row, 4);
+                binary_clock_state_t state = binary_clock_state_from_epoch(start + rows_seen + row, 0);
+                if (epoch != start + rows_seen + row || leds != binary_clock_pack_state(&state)) {
+                    return -1;
+                }
+            }
+            rows_seen += length;
+            (*batches)++;
+        }
+
+        pos = body + (size_t)body_length;
+        message_index++;
+    }
+
+    return -1; // Missing end-of-stream marker
+}
+
+/* ========================================================================== */
+/* TESTS                                                                      */
+/* ========================================================================== */
+
+void test_stream_format(void) {
+    printf("\n=== Testing Arrow IPC Stream Format ===\n");
+
+    size_t size = 0;
+    int batches = 0;
+    uint8_t* data = write_to_memory(1700000000, 1700001000, BINARY_CLOCK_ARROW_STREAM, 300, &size);
+    ASSERT_TRUE(data != NULL, "stream written successfully");
+    if (data == NULL) {
+        return;
+    }
+
+    ASSERT_EQ(read_le(data, 4), 0xFFFFFFFFu, "stream starts with continuation marker");
+    ASSERT_EQ(walk_stream(data, size, 0, 1700000000, &batches), 1000, "stream contains every row in order");
+    ASSERT_EQ(batches, 4, "rows split into record batches of batch_rows");
+    ASSERT_EQ(read_le(data + size - 4, 4), 0, "stream ends with end-of-stream marker");
+    free(data);
+
+    data = write_to_memory(1700000000, 1700000000, BINARY_CLOCK_ARROW_STREAM, 0, &size);
+    batches = 0;
+    ASSERT_TRUE(data != NULL, "empty range written successfully");
+    if (data != NULL) {
+        ASSERT_EQ(walk_stream(data, size, 0, 1700000000, &batches), 0, "empty range has no rows");
+        ASSERT_EQ(batches, 0, "empty range has no record batches");
+        free(data);
+    }
+}
+
+void test_file_format(void) {
+    printf("\n=== Testing Arrow IPC File Format ===\n");
+
+    size_t size = 0;
+    int batches = 0;
+    uint8_t* data = write_to_memory(-5000, 5000, BINARY_CLOCK_ARROW_FILE, 4096, &size);
+    ASSERT_TRUE(data != NULL, "file written successfully");
+    if (data == NULL) {
+        return;
+    }
+
+    ASSERT_TRUE(memcmp(data, "ARROW1\0\0", 8) == 0, "file starts with padded magic");
+    ASSERT_TRUE(memcmp(data + size - 6, "ARROW1", 6) == 0, "file ends with magic");
+    ASSERT_EQ(walk_stream(data, size, 8, -5000, &batches), 10000, "file body contains every row");
+    ASSERT_EQ(batches, 3, "file body has three record batches");
+
+    // Footer blocks must point at the record batch messages
+    uint32_t footer_size = (uint32_t)read_le(data + size - 10, 4);
+    const uint8_t* footer = data + size - 10 - footer_size;
+    size_t root = fb_deref(footer, 0);
+    size_t blocks = fb_deref(footer, fb_field(footer, root, 3));
+    ASSERT_EQ(read_le(footer + blocks, 4), 3, "footer lists three blocks");
+
+    int blocks_valid = 1;
+    for (int i = 0; i < 3; i++) {
+        uint64_t offset = read_le(footer + blocks + 4 + 24 * i, 8);
+        uint32_t metadata_length = (uint32_t)read_le(footer + blocks + 4 + 24 * i + 8, 4);
+        if (read_le(data + offset, 4) != 0xFFFFFFFFu ||
+            read_le(data + offset + 4, 4) + 8 != metadata_length) {
+            blocks_valid = 0;
+        }
+    }
+    ASSERT_TRUE(blocks_valid, "footer blocks point at record batch messages");
+    free(data);
+}
+
+void test_range_limits(void) {
+    printf("\n=== Testing Ranges at the int64 Limits ===\n");
+
+    // A batch past the last one would start beyond INT64_MAX
+    size_t size = 0;
+    int batches = 0;
+    uint8_t* data = write_to_memory(INT64_MAX - 1, INT64_MAX, BINARY_CLOCK_ARROW_STREAM, 0, &size);
+    ASSERT_TRUE(data != NULL, "stream ending at INT64_MAX written");
+    if (data != NULL) {
+        ASSERT_EQ(walk_stream(data, size, 0, INT64_MAX - 1, &batches), 1, "stream holds the row before INT64_MAX");
+        free(data);
+    }
+
+    batches = 0;
+    data = write_to_memory(INT64_MAX - 5, INT64_MAX, BINARY_CLOCK_ARROW_FILE, 2, &size);
+    ASSERT_TRUE(data != NULL, "file ending at INT64_MAX written");
+    if (data != NULL) {
+        ASSERT_EQ(walk_stream(data, size, 8, INT64_MAX - 5, &batches), 5, "file holds every row up to INT64_MAX");
+        ASSERT_EQ(batches, 3, "last partial batch ends at INT64_MAX");
+        uint32_t footer_size = (uint32_t)read_le(data + size - 10, 4);
+        const uint8_t* footer = data + size - 10 - footer_size;
+        size_t root = fb_deref(footer, 0);
+        ASSERT_EQ(read_le(footer + fb_deref(footer, fb_field(footer, root, 3)), 4), 3, "footer lists three blocks");
+        free(data);
+    }
+
+    // The full int64 span does not fit in int64_t, nor its blocks in a footer
+    FILE* file = tmpfile();
+    if (file != NULL) {
+        ASSERT_EQ(binary_clock_arrow_write_range(file, INT64_MIN, INT64_MAX, 0, BINARY_CLOCK_ARROW_FILE, 0),
+                  BINARY_CLOCK_ERROR_OUTPUT, "full int64 span refused without overflow");
+        fclose(file);
+    }
+}
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    ASSERT_EQ(binary_clock_arrow_write_range(NULL, 0, 10, 0, BINARY_CLOCK_ARROW_STREAM, 0),
+              BINARY_CLOCK_ERROR_NULL_POINTER, "NULL output rejected");
+
+    FILE* file = tmpfile();
+    if (file != NULL) {
+        ASSERT_EQ(binary_clock_arrow_write_range(file, 10, 0, 0, BINARY_CLOCK_ARROW_STREAM, 0),
+                  BINARY_CLOCK_ERROR_INVALID_TIME, "reversed range rejected");
+        fclose(file);
+    }
+}
+
+int main(void) {
+    printf("=== Binary Clock Arrow Export Test Suite ===\n");
+
+    test_stream_format();
+    test_file_format();
+    test_range_limits();
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All Arrow tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,283 @@
+/**
+ * @file test_binary_clock_display.c
+ * @brief Test suite for the Binary Clock display utilities
+ *
+ * Checks the buffer renderers byte for byte, since the built-in display
+ * functions and the CLI single-shot path both emit exactly their output,
+ * and the dispatcher's gathered writes for buffer displays.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <binary_clock_api.h>
+#include <binary_clock_display.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %d, got %d)\n", tests_run, message, (int)(expected), (int)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if (strcmp((actual), (expected)) == 0) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected '%s', got '%s')\n", tests_run, message, expected, actual); \
+        } \
+    } while(0)
+
+// 14:30:45 at a fixed timestamp
+static binary_clock_state_t sample_state(void) {
+    return binary_clock_state_from_epoch(1700058645, 0);
+}
+
+void test_render_formats(void) {
+    printf("\n=== Testing Buffer Rendering ===\n");
+
+    binary_clock_state_t state = sample_state();
+    char buffer[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length;
+
+    length = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_COMPACT, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "14:30:45 [001 0100 : 011 0000 : 100 0101]\n", "compact format");
+    ASSERT_EQ(length, strlen(buffer), "compact length excludes terminator");
+
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_EMOJI_LINE, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer, "14:30:45 [🌚🌚🌝 🌚🌝🌚🌚 : 🌚🌝🌝 🌚🌚🌚🌚 : 🌝🌚🌚 🌚🌝🌚🌝]\n", "emoji line format");
+
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_ASCII, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer,
+                  "Binary Clock (ASCII)\nTime: 14:30:45\n\n"
+                  "Hours   : 001 0100\nMinutes : 011 0000\nSeconds : 100 0101\n",
+                  "ascii format");
+
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_EMOJI, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer,
+                  "🌝 Binary Clock 🌚\nTime: 14:30:45\n\n"
+                  "Hours   : 🌚🌚🌝 🌚🌝🌚🌚\nMinutes : 🌚🌝🌝 🌚🌚🌚🌚\nSeconds : 🌝🌚🌚 🌚🌝🌚🌝\n",
+                  "emoji format");
+
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer,
+                  "{\"timestamp\":1700058645,\"time\":\"14:30:45\",\"binary\":{"
+                  "\"hours\":{\"tens\":[0,0,1],\"units\":[0,1,0,0]},"
+                  "\"minutes\":{\"tens\":[0,1,1],\"units\":[0,0,0,0]},"
+                  "\"seconds\":{\"tens\":[1,0,0],\"units\":[0,1,0,1]}}}\n",
+                  "json line format");
+
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON, buffer, sizeof(buffer));
+    ASSERT_STR_EQ(buffer,
+                  "{\n  \"timestamp\": 1700058645,\n  \"time\": \"14:30:45\",\n  \"binary\": {\n"
+                  "    \"hours\": {\n      \"tens\": [0,0,1],\n      \"units\": [0,1,0,0]\n    },\n"
+                  "    \"minutes\": {\n      \"tens\": [0,1,1],\n      \"units\": [0,0,0,0]\n    },\n"
+                  "    \"seconds\": {\n      \"tens\": [1,0,0],\n      \"units\": [0,1,0,1]\n    }\n"
+                  "  }\n}\n",
+                  "json format");
+}
+
+void test_render_errors(void) {
+    printf("\n=== Testing Rendering Errors ===\n");
+
+    binary_clock_state_t state = sample_state();
+    char buffer[16];
+
+    ASSERT_EQ(binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON, buffer, sizeof(buffer)), 0,
+              "too small buffer returns 0");
+    ASSERT_STR_EQ(buffer, "", "too small buffer left empty");
+    ASSERT_EQ(binary_clock_display_render(NULL, BINARY_CLOCK_RENDER_JSON, buffer, sizeof(buffer)), 0,
+              "NULL state returns 0");
+    ASSERT_EQ(binary_clock_display_render(&state, (binary_clock_render_format_t)99, buffer, sizeof(buffer)), 0,
+              "unknown format returns 0");
+}
+
+#ifndef _WIN32
+
+// A buffer display that renders one format into one sink
+typedef struct {
+    int sink;
+    binary_clock_render_format_t format;
+} sink_display_t;
+
+static size_t render_to_sink(const binary_clock_state_t* state, void* context, char* buffer, size_t size,
+                             int* sink) {
+    const sink_display_t* display = context;
+    *sink = display->sink;
+    return binary_clock_display_render(state, display->format, buffer, size);
+}
+
+static size_t render_nothing(const binary_clock_state_t* state, void* context, char* buffer, size_t size,
+                             int* sink) {
+    (void)state;
+    (void)context;
+    (void)buffer;
+    (void)size;
+    (void)sink;
+    return 0;
+}
+
+static int function_calls = 0;
+
+static void count_call(const binary_clock_state_t* state, void* context) {
+    (void)state;
+    (void)context;
+    function_calls++;
+}
+
+// Everything waiting in a non-blocking pipe, NUL-terminated
+static size_t drain(int fd, char* buffer, size_t size) {
+    ssize_t got = read(fd, buffer, size - 1);
+    size_t length = got > 0 ? (size_t)got : 0;
+    buffer[length] = '\0';
+    return length;
+}
+
+void test_buffer_dispatch(void) {
+    printf("\n=== Testing Buffer Display Dispatch ===\n");
+
+    int a[2];
+    int b[2];
+    if (pipe(a) != 0 || pipe(b) != 0) {
+        ASSERT_TRUE(false, "pipes created");
+        return;
+    }
+    fcntl(a[0], F_SETFL, O_NONBLOCK);
+    fcntl(b[0], F_SETFL, O_NONBLOCK);
+
+    binary_clock_state_t state = sample_state();
+    sink_display_t compact = {a[1], BINARY_CLOCK_RENDER_COMPACT};
+    sink_display_t json = {b[1], BINARY_CLOCK_RENDER_JSON_LINE};
+    sink_display_t emoji = {a[1], BINARY_CLOCK_RENDER_EMOJI_LINE};
+    char expected[3 * BINARY_CLOCK_RENDER_MAX_SIZE];
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+    char output[4 * BINARY_CLOCK_RENDER_MAX_SIZE];
+
+    ASSERT_EQ(binary_clock_display_register_buffer(NULL, NULL), -1, "NULL buffer display rejected");
+    int ids[5];
+    ids[0] = binary_clock_display_register_buffer(render_to_sink, &compact);
+    ids[1] = binary_clock_display_register(count_call, NULL);
+    ids[2] = binary_clock_display_register_buffer(render_to_sink, &json);
+    ids[3] = binary_clock_display_register_buffer(render_nothing, NULL);
+    ids[4] = binary_clock_display_register_buffer(render_to_sink, &emoji);
+    ASSERT_TRUE(ids[0] >= 0 && ids[1] > ids[0] && ids[2] > ids[1] && ids[3] > ids[2] && ids[4] > ids[3],
+                "both kinds share the registration IDs");
+
+    binary_clock_display_dispatch_stats_t before = binary_clock_display_get_dispatch_stats();
+    binary_clock_display_update_all_with_state(&state);
+    binary_clock_display_dispatch_stats_t after = binary_clock_display_get_dispatch_stats();
+    ASSERT_EQ(function_calls, 1, "function callback still called");
+    ASSERT_EQ(after.slices - before.slices, 3, "three slices rendered, empty one skipped");
+    ASSERT_EQ(after.system_calls - before.system_calls, 2, "one writev per sink");
+    ASSERT_EQ(after.errors - before.errors, 0, "no errors");
+
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_COMPACT, expected, sizeof(expected));
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_EMOJI_LINE, frame, sizeof(frame));
+    strcat(expected, frame);
+    size_t sent = drain(a[0], output, sizeof(output));
+    ASSERT_STR_EQ(output, expected, "first sink gets its slices in registration order");
+    binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, expected, sizeof(expected));
+    sent += drain(b[0], output, sizeof(output));
+    ASSERT_STR_EQ(output, expected, "second sink gets its slice");
+    ASSERT_EQ(after.bytes - before.bytes, sent, "bytes counted");
+
+    // Removing the first sink's displays leaves one write for the other
+    binary_clock_display_unregister(ids[0]);
+    binary_clock_display_unregister(ids[4]);
+    before = binary_clock_display_get_dispatch_stats();
+    binary_clock_display_update_all_with_state(&state);
+    after = binary_clock_display_get_dispatch_stats();
+    ASSERT_EQ(after.system_calls - before.system_calls, 1, "unregistered buffer displays not dispatched");
+    ASSERT_EQ(drain(a[0], output, sizeof(output)), 0, "first sink gets nothing");
+    ASSERT_TRUE(drain(b[0], output, sizeof(output)) > 0, "second sink still served");
+    ASSERT_EQ(function_calls, 2, "function callback called each tick");
+
+    // Slices that cannot be sent are counted and dropped
+    sink_display_t nowhere = {-1, BINARY_CLOCK_RENDER_COMPACT};
+    sink_display_t closed = {b[1], BINARY_CLOCK_RENDER_COMPACT};
+    binary_clock_display_unregister(ids[2]);
+    int bad = binary_clock_display_register_buffer(render_to_sink, &nowhere);
+    int gone = binary_clock_display_register_buffer(render_to_sink, &closed);
+    close(b[1]);
+    closed.sink = 1000;  // Never opened
+    before = binary_clock_display_get_dispatch_stats();
+    binary_clock_display_update_all_with_state(&state);
+    after = binary_clock_display_get_dispatch_stats();
+    ASSERT_EQ(after.errors - before.errors, 2, "negative sink and failed write counted");
+    ASSERT_EQ(after.system_calls - before.system_calls, 1, "negative sink never written");
+    ASSERT_EQ(after.bytes - before.bytes, 0, "nothing counted as sent");
+
+    // Both kinds fill the same 16 slots
+    int filled[16];
+    int count = 0;
+    for (int id; count < 16 && (id = binary_clock_display_register_buffer(render_nothing, NULL)) != -1;) {
+        filled[count++] = id;
+    }
+    ASSERT_EQ(count, 16 - 4, "slots shared with function callbacks");
+    ASSERT_EQ(binary_clock_display_register(count_call, NULL), -1, "full registry rejects function callbacks");
+    for (int i = 0; i < count; i++) {
+        binary_clock_display_unregister(filled[i]);
+    }
+    binary_clock_display_unregister(bad);
+    binary_clock_display_unregister(gone);
+    binary_clock_display_unregister(ids[1]);
+    binary_clock_display_unregister(ids[3]);
+    close(a[0]);
+    close(a[1]);
+    close(b[0]);
+}
+
+#endif
+
+int main(void) {
+    printf("=== Binary Clock Display Test Suite ===\n");
+
+    test_render_formats();
+    test_render_errors();
+#ifndef _WIN32
+    test_buffer_dispatch();
+#endif
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All display tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
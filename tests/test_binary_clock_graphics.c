@@ -0,0 +1,455 @@
+/**
+ * @file test_binary_clock_graphics.c
+ * @brief Test suite for the Binary Clock graphics display
+ *
+ * Checks protocol detection, the uploaded kitty images and cached sixel
+ * glyphs, and that each tick sends only the LEDs that changed. A small
+ * terminal model applies the cursor moves, kitty placements and sixel
+ * glyphs of a day of ticks and compares every LED with the emoji
+ * display of the same second.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_graphics.h>
+#include <binary_clock_display.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+// 14:30:45 UTC
+#define BASE_EPOCH 1700058645LL
+
+#define ON_MOON "\xF0\x9F\x8C\x9D"
+#define OFF_MOON "\xF0\x9F\x8C\x9A"
+
+static size_t count_of(const char* text, size_t length, const char* needle) {
+    size_t count = 0;
+    size_t needle_length = strlen(needle);
+    for (size_t i = 0; i + needle_length <= length; i++) {
+        if (memcmp(text + i, needle, needle_length) == 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// LEDs of a state as the emoji display shows them, hours tens first
+static void emoji_leds(const binary_clock_state_t* state, bool leds[BINARY_CLOCK_GRAPHICS_LEDS]) {
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = binary_clock_display_render(state, BINARY_CLOCK_RENDER_EMOJI, frame, sizeof(frame));
+    static const char* const labels[3] = {"Hours   : ", "Minutes : ", "Seconds : "};
+    for (int row = 0; row < 3; row++) {
+        const char* at = strstr(frame, labels[row]);
+        int led = 0;
+        for (at = at != NULL ? at + 10 : frame + length; at < frame + length && *at != '\n' && led < 7;) {
+            if (memcmp(at, ON_MOON, 4) == 0 || memcmp(at, OFF_MOON, 4) == 0) {
+                leds[row * 7 + led++] = memcmp(at, ON_MOON, 4) == 0;
+                at += 4;
+            } else {
+                at++;
+            }
+        }
+    }
+}
+
+/*
+ * Terminal model: the cursor, the kitty placements (image and z per
+ * placement ID) and the last sixel glyph drawn in each cell
+ */
+typedef struct {
+    int row;
+    int column;
+    int off_row[BINARY_CLOCK_GRAPHICS_LEDS + 1];    // Placement position of the off image, 0 if none
+    int off_column[BINARY_CLOCK_GRAPHICS_LEDS + 1];
+    int on_row[BINARY_CLOCK_GRAPHICS_LEDS + 1];     // Placement position of the on image, 0 if none
+    int on_column[BINARY_CLOCK_GRAPHICS_LEDS + 1];
+    int glyph[10][40];                              // Sixel: -1 none, 0 off, 1 on
+    char time[9];
+    int commands;
+    int unknown;
+} screen_t;
+
+static void screen_reset(screen_t* screen) {
+    memset(screen, 0, sizeof(*screen));
+    memset(screen->glyph, 0xff, sizeof(screen->glyph));
+    screen->row = 1;
+    screen->column = 1;
+}
+
+static unsigned key_of(const char* keys, const char* key) {
+    const char* at = strstr(keys, key);
+    return at != NULL ? (unsigned)strtoul(at + strlen(key), NULL, 10) : 0;
+}
+
+static void screen_write(screen_t* screen, const binary_clock_graphics_t* graphics, const char* data, size_t length) {
+    size_t i = 0;
+    while (i < length) {
+        if (data[i] == '\033' && i + 1 < length && data[i + 1] == '[') {
+            int row = 0, column = 0, used = 0;
+            if (sscanf(data + i, "\033[%d;%dH%n", &row, &column, &used) == 2 && used > 0) {
+                screen->row = row;
+                screen->column = column;
+                i += (size_t)used;
+                continue;
+            }
+            // The setup's screen clear and cursor home
+            if (strncmp(data + i, "\033[2J", 4) == 0 || strncmp(data + i, "\033[H", 3) == 0) {
+                screen->row = 1;
+                screen->column = 1;
+                i += data[i + 2] == 'H' ? 3 : 4;
+                continue;
+            }
+            screen->unknown++;
+            i += 2;
+        } else if (data[i] == '\033' && i + 1 < length && data[i + 1] == '_') {
+            const char* end = strstr(data + i, "\033\\");
+            char keys[128];
+            size_t key_length = (size_t)(end - (data + i + 3));
+            const char* semicolon = memchr(data + i + 3, ';', key_length);
+            if (semicolon != NULL) {
+                key_length = (size_t)(semicolon - (data + i + 3));
+            }
+            snprintf(keys, sizeof(keys), ",%.*s,", (int)key_length, data + i + 3);
+            unsigned image = key_of(keys, ",i=");
+            unsigned placement = key_of(keys, ",p=");
+            bool on = image == BINARY_CLOCK_GRAPHICS_IMAGE_ID + 1;
+            if (placement > BINARY_CLOCK_GRAPHICS_LEDS || strstr(keys, ",q=2,") == NULL) {
+                screen->unknown++;
+            } else if (strstr(keys, ",a=p,") != NULL) {
+                if (on == (strstr(keys, ",z=-1,") != NULL)) {
+                    screen->unknown++;
+                }
+                (on ? screen->on_row : screen->off_row)[placement] = screen->row;
+                (on ? screen->on_column : screen->off_column)[placement] = screen->column;
+            } else if (strstr(keys, ",a=d,d=i,") != NULL) {
+                (on ? screen->on_row : screen->off_row)[placement] = 0;
+            } else if (strstr(keys, ",a=t,") == NULL && strstr(keys, ",a=d,d=I,") == NULL) {
+                screen->unknown++;
+            }
+            screen->commands++;
+            i = (size_t)(end + 2 - data);
+        } else if (data[i] == '\033' && i + 1 < length && data[i + 1] == 'P') {
+            int which = -1;
+            for (int on = 0; on < 2; on++) {
+                if (length - i >= graphics->glyph_lengths[on] &&
+                    memcmp(data + i, graphics->glyphs[on], graphics->glyph_lengths[on]) == 0) {
+                    which = on;
+                }
+            }
+            if (which < 0 || screen->row >= 10 || screen->column >= 40) {
+                screen->unknown++;
+                i += 2;
+                continue;
+            }
+            screen->glyph[screen->row][screen->column] = which;
+            screen->commands++;
+            i += graphics->glyph_lengths[which];
+        } else if (data[i] == '\n') {
+            screen->row++;
+            screen->column = 1;
+            i++;
+        } else {
+            if (screen->row == 2 && screen->column >= 7 && screen->column < 15) {
+                screen->time[screen->column - 7] = data[i];
+            }
+            screen->column++;
+            i++;
+        }
+    }
+}
+
+// What the model shows at an LED: 1 on, 0 off, -1 nothing or a mismatch
+static int screen_led(const screen_t* screen, int led, bool sixel) {
+    int row = BINARY_CLOCK_GRAPHICS_TOP_ROW + led / 7;
+    int column = 11 + 2 * (led % 7) + (led % 7 >= 3 ? 1 : 0);
+    if (sixel) {
+        return screen->glyph[row][column];
+    }
+    int placement = led + 1;
+    if (screen->off_row[placement] != row || screen->off_column[placement] != column) {
+        return -1;
+    }
+    if (screen->on_row[placement] == 0) {
+        return 0;
+    }
+    return screen->on_row[placement] == row && screen->on_column[placement] == column ? 1 : -1;
+}
+
+void test_detect(void) {
+    printf("\n=== Testing Protocol Detection ===\n");
+
+    ASSERT_EQ(binary_clock_graphics_detect("xterm-kitty", NULL, NULL), BINARY_CLOCK_GRAPHICS_KITTY, "kitty TERM");
+    ASSERT_EQ(binary_clock_graphics_detect("xterm-256color", NULL, "3"), BINARY_CLOCK_GRAPHICS_KITTY,
+              "kitty window ID");
+    ASSERT_EQ(binary_clock_graphics_detect("xterm-256color", "WezTerm", NULL), BINARY_CLOCK_GRAPHICS_KITTY, "WezTerm");
+    ASSERT_EQ(binary_clock_graphics_detect("xterm-ghostty", NULL, NULL), BINARY_CLOCK_GRAPHICS_KITTY, "Ghostty");
+    ASSERT_EQ(binary_clock_graphics_detect("foot", NULL, NULL), BINARY_CLOCK_GRAPHICS_SIXEL, "foot gets sixel");
+    ASSERT_EQ(binary_clock_graphics_detect("xterm-256color", "Apple_Terminal", ""), BINARY_CLOCK_GRAPHICS_SIXEL,
+              "empty window ID ignored");
+    ASSERT_EQ(binary_clock_graphics_detect(NULL, NULL, NULL), BINARY_CLOCK_GRAPHICS_SIXEL, "no environment");
+}
+
+void test_images(void) {
+    printf("\n=== Testing Images and Glyphs ===\n");
+
+    static binary_clock_graphics_t graphics;
+    static char output[BINARY_CLOCK_GRAPHICS_BEGIN_SIZE];
+    ASSERT_EQ(binary_clock_graphics_init(&graphics, BINARY_CLOCK_GRAPHICS_KITTY), BINARY_CLOCK_SUCCESS, "kitty init");
+    size_t length = binary_clock_graphics_begin(&graphics, output, sizeof(output));
+    ASSERT_TRUE(length > 0 && length < BINARY_CLOCK_GRAPHICS_BEGIN_SIZE, "setup fits its buffer");
+    ASSERT_TRUE(strncmp(output, "\033[2J\033[H", 7) == 0, "setup clears the screen");
+    ASSERT_EQ(count_of(output, length, "\033_Ga=t,f=32,s=20,v=20,"), 2, "two images transmitted");
+    ASSERT_EQ(count_of(output, length, "Seconds : "), 1, "row labels drawn");
+
+    // Decode the on image's base64 and look at its pixels
+    const char* data = strstr(output, "i=4267002,q=2;");
+    ASSERT_TRUE(data != NULL, "on image has its ID");
+    data += strlen("i=4267002,q=2;");
+    const char* end = strstr(data, "\033\\");
+    ASSERT_EQ(end - data, (20 * 20 * 4 + 2) / 3 * 4, "base64 of 20 x 20 RGBA");
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static uint8_t pixels[20 * 20 * 4 + 3];
+    size_t count = 0;
+    for (const char* at = data; at + 4 <= end; at += 4) {
+        uint32_t group = 0;
+        for (int k = 0; k < 4; k++) {
+            const char* digit = at[k] == '=' ? alphabet : strchr(alphabet, at[k]);
+            group = group << 6 | (uint32_t)(digit - alphabet);
+        }
+        pixels[count++] = (uint8_t)(group >> 16);
+        pixels[count++] = (uint8_t)(group >> 8);
+        pixels[count++] = (uint8_t)group;
+    }
+    const uint8_t* center = pixels + (10 * 20 + 10) * 4;
+    ASSERT_TRUE(center[0] == 255 && center[1] == 214 && center[2] == 64 && center[3] == 255, "center is lit, opaque");
+    ASSERT_EQ(pixels[3], 0, "corner is transparent");
+    ASSERT_EQ(pixels[(10 * 20 + 0) * 4 + 3], 96, "rim is translucent");
+
+    ASSERT_EQ(binary_clock_graphics_end(&graphics, output, sizeof(output)) > 0, 1, "teardown encoded");
+    ASSERT_EQ(count_of(output, strlen(output), "a=d,d=I,"), 2, "teardown frees both images");
+    ASSERT_TRUE(strstr(output, "\033[7;1H") != NULL, "cursor below the clock");
+
+    // Sixel glyphs: same shape, different colors, transparent background
+    ASSERT_EQ(binary_clock_graphics_init(&graphics, BINARY_CLOCK_GRAPHICS_SIXEL), BINARY_CLOCK_SUCCESS, "sixel init");
+    for (int on = 0; on < 2; on++) {
+        ASSERT_TRUE(graphics.glyph_lengths[on] > 0 && graphics.glyph_lengths[on] < 100, "glyph is short");
+        ASSERT_TRUE(strncmp(graphics.glyphs[on], "\033P0;1;0q\"1;1;16;12", 18) == 0, "glyph header");
+        ASSERT_TRUE(strcmp(graphics.glyphs[on] + graphics.glyph_lengths[on] - 2, "\033\\") == 0, "glyph terminated");
+    }
+    // Skip the raster attributes and the color definition to the pixels
+    const char* body[2] = {strchr(graphics.glyphs[0] + 19, '#'), strchr(graphics.glyphs[1] + 19, '#')};
+    ASSERT_TRUE(strcmp(body[0], body[1]) == 0, "off and on discs have the same pixels");
+    ASSERT_TRUE(strstr(graphics.glyphs[1], "#1;2;100;84;25") != NULL, "on color");
+
+    // Expand the sixel data and count the disc's pixels
+    int pixels_set = 0;
+    int band = 0;
+    int x = 0;
+    bool symmetric = true;
+    int mask[12][16] = {{0}};
+    for (const char* at = body[0] + 2; *at != '\033'; at++) {
+        int run = 1;
+        if (*at == '-') {
+            band++;
+            x = 0;
+            at += 2;
+            continue;
+        }
+        if (*at == '!') {
+            run = (int)strtol(at + 1, (char**)&at, 10);
+        }
+        for (int r = 0; r < run && x < 16; r++, x++) {
+            for (int k = 0; k < 6; k++) {
+                if ((*at - '?') >> k & 1) {
+                    mask[band * 6 + k][x] = 1;
+                    pixels_set++;
+                }
+            }
+        }
+    }
+    for (int y = 0; y < 12; y++) {
+        for (int column = 0; column < 16; column++) {
+            symmetric = symmetric && mask[y][column] == mask[11 - y][15 - column];
+        }
+    }
+    ASSERT_TRUE(pixels_set > 80 && pixels_set < 110, "disc of radius 5.5");
+    ASSERT_TRUE(mask[5][7] == 1 && mask[0][0] == 0 && mask[11][15] == 0, "disc centered");
+    ASSERT_TRUE(symmetric, "disc symmetric");
+
+    length = binary_clock_graphics_begin(&graphics, output, sizeof(output));
+    ASSERT_EQ(count_of(output, length, "\033_G"), 0, "sixel setup uploads nothing");
+    ASSERT_EQ(binary_clock_graphics_end(&graphics, output, sizeof(output)), 6, "sixel teardown only moves the cursor");
+}
+
+void test_ticks(void) {
+    printf("\n=== Testing Ticks ===\n");
+
+    static binary_clock_graphics_t graphics;
+    static char output[BINARY_CLOCK_GRAPHICS_TICK_SIZE];
+    binary_clock_graphics_init(&graphics, BINARY_CLOCK_GRAPHICS_KITTY);
+    binary_clock_graphics_begin(&graphics, output, sizeof(output));
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    size_t length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+    ASSERT_TRUE(length > 0, "first tick encoded");
+    ASSERT_TRUE(length > 14 && strncmp(output + length - 14, "\033[2;7H14:30:45", 14) == 0, "whole time line last");
+    ASSERT_EQ(count_of(output, length, "a=p,i=4267001,"), BINARY_CLOCK_GRAPHICS_LEDS, "every LED placed off");
+    ASSERT_EQ(count_of(output, length, ",z=-1,"), BINARY_CLOCK_GRAPHICS_LEDS, "off LEDs below the text");
+    // 14:30:45 is 001 0100, 011 0000, 100 0101
+    ASSERT_EQ(count_of(output, length, "a=p,i=4267002,"), 7, "lit LEDs placed on");
+    ASSERT_EQ(graphics.stats.leds_drawn, BINARY_CLOCK_GRAPHICS_LEDS, "first tick draws every LED");
+
+    // 14:30:46: seconds units 0101 -> 0110, one LED on and one off
+    state = binary_clock_state_from_epoch(BASE_EPOCH + 1, 0);
+    length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+    ASSERT_EQ(count_of(output, length, "\033_G"), 2, "two LED commands");
+    ASSERT_TRUE(strstr(output, "\033[6;22H\033_Ga=p,i=4267002,p=20,c=2,r=1,q=2\033\\") != NULL,
+                "value-2 LED placed on in its cell");
+    ASSERT_TRUE(strstr(output, "\033_Ga=d,d=i,i=4267002,p=21,q=2\033\\") != NULL, "value-1 LED deleted");
+    ASSERT_TRUE(strcmp(output + length - 8, "\033[2;14H6") == 0, "only the changed digit rewritten");
+    ASSERT_TRUE(length < 100, "a change of two LEDs is under 100 bytes");
+    ASSERT_EQ(graphics.stats.leds_drawn, BINARY_CLOCK_GRAPHICS_LEDS + 2, "two LEDs drawn");
+
+    // The same second again: only the last digit, so a tick is never empty
+    length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+    ASSERT_EQ(count_of(output, length, "\033_G"), 0, "unchanged LEDs not sent");
+    ASSERT_EQ(length, 8, "last digit only");
+
+    // A buffer too small leaves the display as it was
+    state = binary_clock_state_from_epoch(BASE_EPOCH + 2, 0);
+    ASSERT_EQ(binary_clock_graphics_tick(&graphics, &state, output, 20), 0, "small buffer refused");
+    ASSERT_EQ(graphics.stats.ticks, 3, "refused tick not counted");
+    length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+    ASSERT_EQ(count_of(output, length, "\033_G"), 1, "retried tick still sends its change");
+
+    // A new setup draws every LED again
+    binary_clock_graphics_begin(&graphics, output, BINARY_CLOCK_GRAPHICS_TICK_SIZE);
+    length = binary_clock_graphics_tick(&graphics, &state, output, sizeof(output));
+    ASSERT_EQ(count_of(output, length, "a=p,i=4267001,"), BINARY_CLOCK_GRAPHICS_LEDS, "redrawn after setup");
+}
+
+// A day of ticks through the terminal model; returns mismatching seconds
+static long run_day(binary_clock_graphics_protocol_t protocol, double* bytes_per_tick, size_t* largest) {
+    static binary_clock_graphics_t graphics;
+    static char output[BINARY_CLOCK_GRAPHICS_BEGIN_SIZE];
+    static screen_t screen;
+    binary_clock_graphics_init(&graphics, protocol);
+    screen_reset(&screen);
+    size_t length = binary_clock_graphics_begin(&graphics, output, sizeof(output));
+    screen_write(&screen, &graphics, output, length);
+
+    long mismatches = 0;
+    uint64_t bytes = 0;
+    *largest = 0;
+    for (int64_t t = 1700006400; t < 1700006400 + 86400; t++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(t, 0);
+        length = binary_clock_graphics_tick(&graphics, &state, output, BINARY_CLOCK_GRAPHICS_TICK_SIZE);
+        screen_write(&screen, &graphics, output, length);
+        if (t > 1700006400) {
+            bytes += length;
+        }
+        *largest = length > *largest ? length : *largest;
+
+        bool leds[BINARY_CLOCK_GRAPHICS_LEDS];
+        emoji_leds(&state, leds);
+        char time[9];
+        snprintf(time, sizeof(time), "%02d:%02d:%02d", (int)((t / 3600) % 24), (int)((t / 60) % 60), (int)(t % 60));
+        bool same = memcmp(screen.time, time, 8) == 0 && length > 0;
+        for (int led = 0; led < BINARY_CLOCK_GRAPHICS_LEDS; led++) {
+            same = same && screen_led(&screen, led, protocol == BINARY_CLOCK_GRAPHICS_SIXEL) == (leds[led] ? 1 : 0);
+        }
+        mismatches += !same;
+    }
+    mismatches += screen.unknown;
+    *bytes_per_tick = (double)bytes / 86399.0;
+    return mismatches;
+}
+
+void test_day(void) {
+    printf("\n=== Testing a Day of Ticks ===\n");
+
+    double kitty_bytes = 0.0;
+    double sixel_bytes = 0.0;
+    size_t largest = 0;
+    ASSERT_EQ(run_day(BINARY_CLOCK_GRAPHICS_KITTY, &kitty_bytes, &largest), 0, "kitty screen matches every second");
+    ASSERT_TRUE(largest < BINARY_CLOCK_GRAPHICS_TICK_SIZE, "kitty ticks fit the tick size");
+    ASSERT_EQ(run_day(BINARY_CLOCK_GRAPHICS_SIXEL, &sixel_bytes, &largest), 0, "sixel screen matches every second");
+    ASSERT_TRUE(largest < BINARY_CLOCK_GRAPHICS_TICK_SIZE, "sixel ticks fit the tick size");
+
+    // The emoji loop clears the screen and repaints every LED
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    size_t emoji_bytes = 7 + binary_clock_display_render(&state, BINARY_CLOCK_RENDER_EMOJI, frame, sizeof(frame));
+    printf("  bytes per tick: kitty %.1f, sixel %.1f, emoji %lu\n", kitty_bytes, sixel_bytes,
+           (unsigned long)emoji_bytes);
+    ASSERT_TRUE(kitty_bytes * 2 < (double)emoji_bytes, "kitty ticks under half an emoji repaint");
+    ASSERT_TRUE(sixel_bytes < (double)emoji_bytes, "sixel ticks smaller than an emoji repaint");
+}
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_graphics_t graphics;
+    char output[64];
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    ASSERT_EQ(binary_clock_graphics_init(NULL, BINARY_CLOCK_GRAPHICS_KITTY), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL display rejected");
+    ASSERT_EQ(binary_clock_graphics_init(&graphics, (binary_clock_graphics_protocol_t)7), BINARY_CLOCK_ERROR_OUTPUT,
+              "unknown protocol rejected");
+    binary_clock_graphics_init(&graphics, BINARY_CLOCK_GRAPHICS_KITTY);
+    ASSERT_EQ(binary_clock_graphics_begin(&graphics, output, sizeof(output)), 0, "setup needs room for the images");
+    ASSERT_EQ(binary_clock_graphics_begin(NULL, output, sizeof(output)), 0, "NULL display has no setup");
+    ASSERT_EQ(binary_clock_graphics_tick(&graphics, NULL, output, sizeof(output)), 0, "NULL state has no tick");
+    ASSERT_EQ(binary_clock_graphics_tick(NULL, &state, output, sizeof(output)), 0, "NULL display has no tick");
+    ASSERT_EQ(binary_clock_graphics_end(&graphics, NULL, 0), 0, "NULL output has no teardown");
+}
+
+int main(void) {
+    printf("=== Binary Clock Graphics Test Suite ===\n");
+
+    test_detect();
+    test_images();
+    test_ticks();
+    test_day();
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All graphics tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
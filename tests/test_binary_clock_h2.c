@@ -0,0 +1,816 @@
+/**
+ * @file test_binary_clock_h2.c
+ * @brief Test suite for the Binary Clock HTTP/2 server
+ *
+ * Covers frame headers, Huffman coding and HPACK decoding against the
+ * examples of RFC 7541 appendix C, and the encoders. On POSIX systems a
+ * loopback client speaks raw frames to the server: multiplexed queries,
+ * tick streams sharing payloads, flow control, the stream limit and
+ * connection errors.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_h2.h>
+#include <binary_clock_mem.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define H2_EPOCH 1700000000LL  // 2023-11-14 22:13:20 UTC
+
+// Parse a hex string such as "8286 8441" into bytes
+static size_t from_hex(const char* text, uint8_t* output) {
+    size_t length = 0;
+    while (*text != '\0') {
+        if (*text == ' ') {
+            text++;
+            continue;
+        }
+        unsigned value = 0;
+        sscanf(text, "%2x", &value);
+        output[length++] = (uint8_t)value;
+        text += 2;
+    }
+    return length;
+}
+
+// Header fields decoded from a block, joined as "name: value\n"
+typedef struct {
+    char text[1024];
+    size_t length;
+    int count;
+} fields_t;
+
+static void collect(void* context, const char* name, size_t name_length, const char* value, size_t value_length) {
+    fields_t* fields = context;
+    fields->length += (size_t)snprintf(fields->text + fields->length, sizeof(fields->text) - fields->length,
+                                       "%.*s: %.*s\n", (int)name_length, name, (int)value_length, value);
+    fields->count++;
+}
+
+static binary_clock_error_t decode_hex(binary_clock_h2_hpack_t* table, const char* hex, fields_t* fields) {
+    uint8_t block[256];
+    size_t length = from_hex(hex, block);
+    memset(fields, 0, sizeof(*fields));
+    return binary_clock_h2_hpack_decode(table, block, length, collect, fields);
+}
+
+void test_frames(void) {
+    printf("\n=== Testing Frame Headers ===\n");
+
+    uint8_t bytes[BINARY_CLOCK_H2_FRAME_HEADER_SIZE];
+    binary_clock_h2_frame_t frame = {16384, BINARY_CLOCK_H2_HEADERS, 0x25, 0x7ffffffd};
+    ASSERT_EQ(binary_clock_h2_frame_write(bytes, &frame), 9, "frame header is 9 bytes");
+    ASSERT_TRUE(bytes[0] == 0x00 && bytes[1] == 0x40 && bytes[2] == 0x00, "24-bit length, big endian");
+    ASSERT_TRUE(bytes[3] == 0x01 && bytes[4] == 0x25, "type and flags");
+    ASSERT_TRUE(bytes[5] == 0x7f && bytes[8] == 0xfd, "31-bit stream identifier");
+    binary_clock_h2_frame_t read = binary_clock_h2_frame_read(bytes);
+    ASSERT_TRUE(read.length == frame.length && read.type == frame.type && read.flags == frame.flags &&
+                read.stream == frame.stream, "header read back");
+    bytes[5] |= 0x80;
+    ASSERT_EQ(binary_clock_h2_frame_read(bytes).stream, 0x7ffffffd, "reserved bit ignored");
+}
+
+void test_huffman(void) {
+    printf("\n=== Testing Huffman Coding ===\n");
+
+    // RFC 7541 C.4.1
+    uint8_t coded[64];
+    uint8_t expected[64];
+    size_t expected_length = from_hex("f1e3 c2e5 f23a 6ba0 ab90 f4ff", expected);
+    size_t length = binary_clock_h2_huffman_encode("www.example.com", 15, coded, sizeof(coded));
+    ASSERT_EQ(length, 12, "www.example.com takes 12 bytes");
+    ASSERT_TRUE(memcmp(coded, expected, expected_length) == 0, "encoding matches RFC 7541 C.4.1");
+    char text[64];
+    ASSERT_EQ(binary_clock_h2_huffman_decode(coded, length, text, sizeof(text)), 15, "decoded length");
+    ASSERT_TRUE(memcmp(text, "www.example.com", 15) == 0, "decoded text");
+    // RFC 7541 C.4.3
+    expected_length = from_hex("25a8 49e9 5bb8 e8b4 bf", expected);
+    ASSERT_EQ(binary_clock_h2_huffman_decode(expected, expected_length, text, sizeof(text)), 12,
+              "custom-value decoded");
+    ASSERT_TRUE(memcmp(text, "custom-value", 12) == 0, "custom-value text");
+
+    // Every byte, including the 30-bit codes
+    char all[256];
+    for (int i = 0; i < 256; i++) {
+        all[i] = (char)i;
+    }
+    uint8_t all_coded[1024];
+    char all_decoded[256];
+    length = binary_clock_h2_huffman_encode(all, sizeof(all), all_coded, sizeof(all_coded));
+    ASSERT_TRUE(length > 256, "rare bytes take longer codes");
+    ASSERT_EQ(binary_clock_h2_huffman_decode(all_coded, length, all_decoded, sizeof(all_decoded)), 256,
+              "all bytes decoded");
+    ASSERT_TRUE(memcmp(all, all_decoded, 256) == 0, "all bytes round trip");
+    ASSERT_EQ(binary_clock_h2_huffman_encode(all, sizeof(all), all_coded, 100), 0, "small buffer refused");
+    ASSERT_EQ(binary_clock_h2_huffman_decode(all_coded, length, all_decoded, 100), SIZE_MAX,
+              "small output refused");
+
+    // '0' is 00000: three zero bits of padding are not a prefix of EOS
+    uint8_t bad_padding[] = {0x00};
+    ASSERT_EQ(binary_clock_h2_huffman_decode(bad_padding, 1, text, sizeof(text)), SIZE_MAX, "zero padding rejected");
+    uint8_t good_padding[] = {0x07};
+    ASSERT_EQ(binary_clock_h2_huffman_decode(good_padding, 1, text, sizeof(text)), 1, "one padding accepted");
+    uint8_t long_padding[] = {0x07, 0xff};
+    ASSERT_EQ(binary_clock_h2_huffman_decode(long_padding, 2, text, sizeof(text)), SIZE_MAX,
+              "padding over 7 bits rejected");
+    uint8_t eos[] = {0xff, 0xff, 0xff, 0xff};
+    ASSERT_EQ(binary_clock_h2_huffman_decode(eos, 4, text, sizeof(text)), SIZE_MAX, "EOS rejected");
+    ASSERT_EQ(binary_clock_h2_huffman_decode(coded, 0, text, sizeof(text)), 0, "empty string");
+}
+
+void test_hpack(void) {
+    printf("\n=== Testing HPACK Decoding ===\n");
+
+    static binary_clock_h2_hpack_t table;
+    binary_clock_h2_hpack_init(&table);
+    fields_t fields;
+
+    // RFC 7541 C.3: requests without Huffman coding, sharing a table
+    ASSERT_EQ(decode_hex(&table, "8286 8441 0f77 7777 2e65 7861 6d70 6c65 2e63 6f6d", &fields),
+              BINARY_CLOCK_SUCCESS, "C.3.1 decoded");
+    ASSERT_TRUE(strcmp(fields.text, ":method: GET\n:scheme: http\n:path: /\n:authority: www.example.com\n") == 0,
+                "C.3.1 fields");
+    ASSERT_EQ(table.size, 57, "C.3.1 table size");
+    ASSERT_EQ(decode_hex(&table, "8286 84be 5808 6e6f 2d63 6163 6865", &fields), BINARY_CLOCK_SUCCESS,
+              "C.3.2 decoded");
+    ASSERT_TRUE(strstr(fields.text, ":authority: www.example.com\ncache-control: no-cache\n") != NULL,
+                "C.3.2 reuses the dynamic entry");
+    ASSERT_EQ(table.size, 110, "C.3.2 table size");
+    ASSERT_EQ(decode_hex(&table, "8287 85bf 400a 6375 7374 6f6d 2d6b 6579 0c63 7573 746f 6d2d 7661 6c75 65",
+                         &fields), BINARY_CLOCK_SUCCESS, "C.3.3 decoded");
+    ASSERT_TRUE(strcmp(fields.text, ":method: GET\n:scheme: https\n:path: /index.html\n"
+                                    ":authority: www.example.com\ncustom-key: custom-value\n") == 0,
+                "C.3.3 fields");
+    ASSERT_EQ(table.size, 164, "C.3.3 table size");
+    ASSERT_EQ(table.count, 3, "three entries");
+
+    // RFC 7541 C.4: the same requests with Huffman coding
+    binary_clock_h2_hpack_init(&table);
+    decode_hex(&table, "8286 8441 8cf1 e3c2 e5f2 3a6b a0ab 90f4 ff", &fields);
+    decode_hex(&table, "8286 84be 5886 a8eb 1064 9cbf", &fields);
+    ASSERT_TRUE(strstr(fields.text, "cache-control: no-cache") != NULL, "C.4.2 Huffman value");
+    ASSERT_EQ(decode_hex(&table, "8287 85bf 4088 25a8 49e9 5ba9 7d7f 8925 a849 e95b b8e8 b4bf", &fields),
+              BINARY_CLOCK_SUCCESS, "C.4.3 decoded");
+    ASSERT_TRUE(strstr(fields.text, "custom-key: custom-value") != NULL, "C.4.3 Huffman name and value");
+    ASSERT_EQ(table.size, 164, "C.4.3 table size");
+
+    // Size update to 110 bytes keeps the two newest entries (54 + 53)
+    ASSERT_EQ(decode_hex(&table, "3f4f", &fields), BINARY_CLOCK_SUCCESS, "size update accepted");
+    ASSERT_EQ(table.count, 2, "oldest entry evicted");
+    ASSERT_EQ(table.size, 107, "size after eviction");
+    decode_hex(&table, "be", &fields);
+    ASSERT_TRUE(strcmp(fields.text, "custom-key: custom-value\n") == 0, "index 62 is the newest entry");
+    decode_hex(&table, "bf", &fields);
+    ASSERT_TRUE(strcmp(fields.text, "cache-control: no-cache\n") == 0, "index 63 is the next newest");
+    // Insert one more: the 53-byte cache-control entry, now oldest, makes room
+    ASSERT_EQ(decode_hex(&table, "4003 6162 6303 6465 66", &fields), BINARY_CLOCK_SUCCESS, "literal indexed");
+    decode_hex(&table, "be", &fields);
+    ASSERT_TRUE(strcmp(fields.text, "abc: def\n") == 0, "new entry is index 62");
+    ASSERT_EQ(table.count, 2, "table holds two entries");
+    ASSERT_EQ(table.size, 92, "size after the insertion");
+    ASSERT_EQ(decode_hex(&table, "c0", &fields), BINARY_CLOCK_ERROR_OUTPUT, "index past the table rejected");
+    // Literal naming an entry that its own insertion evicts (RFC 7541 4.4)
+    ASSERT_EQ(decode_hex(&table, "7f00 4d 78787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878787878", &fields),
+              BINARY_CLOCK_ERROR_OUTPUT, "truncated literal rejected");
+    binary_clock_h2_hpack_init(&table);
+    decode_hex(&table, "3f45", &fields);  // 100 bytes
+    decode_hex(&table, "4003 6162 6303 6465 66", &fields);  // abc: def, 38 bytes
+    decode_hex(&table, "4003 6768 6903 6a6b 6c", &fields);  // ghi: jkl, 38 bytes
+    ASSERT_EQ(decode_hex(&table, "7f00 0578 7878 7878", &fields), BINARY_CLOCK_SUCCESS,
+              "literal with the name of an entry it evicts");
+    ASSERT_TRUE(strcmp(fields.text, "abc: xxxxx\n") == 0, "name copied before eviction");
+    ASSERT_EQ(table.count, 2, "oldest entry made room");
+
+    // Never-indexed and unindexed literals leave the table alone
+    uint32_t count = table.count;
+    ASSERT_EQ(decode_hex(&table, "1003 6b65 7903 7661 6c 0404 2f62 6172", &fields), BINARY_CLOCK_SUCCESS,
+              "unindexed literals decoded");
+    ASSERT_TRUE(strcmp(fields.text, "key: val\n:path: /bar\n") == 0,
+                "never-indexed and static-name literals");
+    ASSERT_EQ(table.count, count, "table unchanged");
+
+    // An entry larger than the table empties it without an error
+    decode_hex(&table, "3f14", &fields);  // 51 bytes
+    ASSERT_EQ(decode_hex(&table, "400a 3031 3233 3435 3637 3839 0a30 3132 3334 3536 3738 39", &fields),
+              BINARY_CLOCK_SUCCESS, "oversized entry accepted");
+    ASSERT_EQ(table.count, 0, "table emptied");
+    ASSERT_EQ(table.size, 0, "table size zero");
+
+    ASSERT_EQ(decode_hex(&table, "80", &fields), BINARY_CLOCK_ERROR_OUTPUT, "index 0 rejected");
+    ASSERT_EQ(decode_hex(&table, "3fe2 1f", &fields), BINARY_CLOCK_ERROR_OUTPUT,
+              "size update past the setting rejected");
+    ASSERT_EQ(decode_hex(&table, "ff", &fields), BINARY_CLOCK_ERROR_OUTPUT, "truncated integer rejected");
+    ASSERT_EQ(decode_hex(&table, "0003 6162", &fields), BINARY_CLOCK_ERROR_OUTPUT, "truncated string rejected");
+    ASSERT_EQ(decode_hex(&table, "ffff ffff ff0f", &fields), BINARY_CLOCK_ERROR_OUTPUT,
+              "integer over 32 bits rejected");
+    ASSERT_EQ(decode_hex(&table, "", &fields), BINARY_CLOCK_SUCCESS, "empty block");
+}
+
+void test_encoders(void) {
+    printf("\n=== Testing HPACK Encoding ===\n");
+
+    uint8_t block[256];
+    size_t length = binary_clock_h2_hpack_encode_indexed(block, sizeof(block), 2);
+    ASSERT_TRUE(length == 1 && block[0] == 0x82, ":method GET is one byte");
+    length = binary_clock_h2_hpack_encode_indexed(block, sizeof(block), 200);
+    ASSERT_TRUE(length == 2 && block[0] == 0xff && block[1] == 200 - 127, "index over the prefix continues");
+    ASSERT_EQ(binary_clock_h2_hpack_encode_indexed(block, sizeof(block), 0), 0, "index 0 refused");
+
+    static binary_clock_h2_hpack_t table;
+    binary_clock_h2_hpack_init(&table);
+    fields_t fields;
+    memset(&fields, 0, sizeof(fields));
+    length = binary_clock_h2_hpack_encode_indexed(block, sizeof(block), 8);
+    length += binary_clock_h2_hpack_encode_literal(block + length, sizeof(block) - length, 31, NULL,
+                                                   "application/json", 16, true);
+    length += binary_clock_h2_hpack_encode_literal(block + length, sizeof(block) - length, 0, "x-tick",
+                                                   "1700000000", 10, false);
+    length += binary_clock_h2_hpack_encode_literal(block + length, sizeof(block) - length, 0, "x-zone",
+                                                   "Europe/Berlin", 13, true);
+    ASSERT_EQ(binary_clock_h2_hpack_decode(&table, block, length, collect, &fields), BINARY_CLOCK_SUCCESS,
+              "encoded block decodes");
+    ASSERT_TRUE(strcmp(fields.text, ":status: 200\ncontent-type: application/json\nx-tick: 1700000000\n"
+                                    "x-zone: Europe/Berlin\n") == 0, "fields round trip");
+    ASSERT_EQ(table.count, 0, "literals are not indexed");
+    ASSERT_TRUE(length < 1 + 2 + 16 + 1 + 7 + 11 + 1 + 7 + 14, "Huffman shortens the strings");
+    ASSERT_EQ(binary_clock_h2_hpack_encode_literal(block, 4, 31, NULL, "application/json", 16, false), 0,
+              "small buffer refused");
+}
+
+#ifndef _WIN32
+
+// A raw-frame client reading from a nonblocking socket
+typedef struct {
+    int fd;
+    bool closed;
+    size_t length;
+    uint8_t buffer[1 << 18];
+} client_t;
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+static void send_frame(client_t* client, uint8_t type, uint8_t flags, uint32_t stream, const void* payload,
+                       size_t length) {
+    uint8_t frame[BINARY_CLOCK_H2_FRAME_HEADER_SIZE + 1024];
+    binary_clock_h2_frame_t header = {(uint32_t)length, type, flags, stream};
+    binary_clock_h2_frame_write(frame, &header);
+    if (length > 0) {
+        memcpy(frame + BINARY_CLOCK_H2_FRAME_HEADER_SIZE, payload, length);
+    }
+    send(client->fd, frame, BINARY_CLOCK_H2_FRAME_HEADER_SIZE + length, 0);
+}
+
+static void send_setting(client_t* client, uint16_t id, uint32_t value) {
+    uint8_t setting[6] = {(uint8_t)(id >> 8), (uint8_t)id, (uint8_t)(value >> 24), (uint8_t)(value >> 16),
+                          (uint8_t)(value >> 8), (uint8_t)value};
+    send_frame(client, BINARY_CLOCK_H2_SETTINGS, 0, 0, setting, sizeof(setting));
+}
+
+static void send_window_update(client_t* client, uint32_t stream, uint32_t increment) {
+    uint8_t payload[4] = {(uint8_t)(increment >> 24), (uint8_t)(increment >> 16), (uint8_t)(increment >> 8),
+                          (uint8_t)increment};
+    send_frame(client, BINARY_CLOCK_H2_WINDOW_UPDATE, 0, stream, payload, sizeof(payload));
+}
+
+static size_t request_block(const char* method, const char* path, uint8_t* block, size_t size) {
+    size_t length = 0;
+    if (strcmp(method, "GET") == 0) {
+        length += binary_clock_h2_hpack_encode_indexed(block, size, 2);
+    } else {
+        length += binary_clock_h2_hpack_encode_literal(block, size, 2, NULL, method, strlen(method), false);
+    }
+    length += binary_clock_h2_hpack_encode_indexed(block + length, size - length, 6);
+    length += binary_clock_h2_hpack_encode_literal(block + length, size - length, 4, NULL, path, strlen(path), true);
+    return length;
+}
+
+static void send_request(client_t* client, uint32_t stream, const char* method, const char* path) {
+    uint8_t block[512];
+    size_t length = request_block(method, path, block, sizeof(block));
+    send_frame(client, BINARY_CLOCK_H2_HEADERS, BINARY_CLOCK_H2_FLAG_END_HEADERS | BINARY_CLOCK_H2_FLAG_END_STREAM,
+               stream, block, length);
+}
+
+static bool open_client(client_t* client, uint16_t port) {
+    client->fd = connect_client(port);
+    client->closed = false;
+    client->length = 0;
+    if (client->fd < 0) {
+        return false;
+    }
+    send(client->fd, BINARY_CLOCK_H2_PREFACE, BINARY_CLOCK_H2_PREFACE_SIZE, 0);
+    send_frame(client, BINARY_CLOCK_H2_SETTINGS, 0, 0, NULL, 0);
+    return true;
+}
+
+// Poll the server and collect what it sent, for a few rounds
+static void pump(binary_clock_h2_server_t* server, client_t* client, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        binary_clock_h2_server_poll(server, 1);
+        for (;;) {
+            ssize_t got = recv(client->fd, client->buffer + client->length, sizeof(client->buffer) - client->length, 0);
+            if (got > 0) {
+                client->length += (size_t)got;
+                continue;
+            }
+            if (got == 0) {
+                client->closed = true;
+            }
+            break;
+        }
+    }
+}
+
+// Take the next frame of a type off the client's buffer, skipping others;
+// false if none arrived
+static bool next_frame(binary_clock_h2_server_t* server, client_t* client, uint8_t type,
+                       binary_clock_h2_frame_t* frame, uint8_t* payload) {
+    for (int attempt = 0; attempt < 50; attempt++) {
+        size_t position = 0;
+        while (client->length - position >= BINARY_CLOCK_H2_FRAME_HEADER_SIZE) {
+            binary_clock_h2_frame_t found = binary_clock_h2_frame_read(client->buffer + position);
+            size_t size = BINARY_CLOCK_H2_FRAME_HEADER_SIZE + found.length;
+            if (client->length - position < size) {
+                break;
+            }
+            if (found.type == type) {
+                *frame = found;
+                if (payload != NULL) {
+                    memcpy(payload, client->buffer + position + BINARY_CLOCK_H2_FRAME_HEADER_SIZE, found.length);
+                }
+                memmove(client->buffer + position, client->buffer + position + size,
+                        client->length - position - size);
+                client->length -= size;
+                return true;
+            }
+            position += size;
+        }
+        if (client->closed) {
+            return false;
+        }
+        pump(server, client, 2);
+    }
+    return false;
+}
+
+// Collect a whole response body (DATA frames up to END_STREAM) of a stream
+static size_t read_body(binary_clock_h2_server_t* server, client_t* client, uint32_t stream, char* body,
+                        size_t size, bool* ended) {
+    size_t length = 0;
+    *ended = false;
+    binary_clock_h2_frame_t frame;
+    static uint8_t payload[BINARY_CLOCK_H2_MAX_FRAME_SIZE];
+    while (!*ended && next_frame(server, client, BINARY_CLOCK_H2_DATA, &frame, payload)) {
+        if (frame.stream != stream || length + frame.length >= size) {
+            continue;
+        }
+        memcpy(body + length, payload, frame.length);
+        length += frame.length;
+        *ended = (frame.flags & BINARY_CLOCK_H2_FLAG_END_STREAM) != 0;
+    }
+    body[length] = '\0';
+    return length;
+}
+
+static int status_of(binary_clock_h2_hpack_t* table, const uint8_t* block, size_t length, fields_t* fields) {
+    memset(fields, 0, sizeof(*fields));
+    if (binary_clock_h2_hpack_decode(table, block, length, collect, fields) != BINARY_CLOCK_SUCCESS ||
+        strncmp(fields->text, ":status: ", 9) != 0) {
+        return -1;
+    }
+    return atoi(fields->text + 9);
+}
+
+static uint32_t error_code(const uint8_t* payload) {
+    return (uint32_t)payload[0] << 24 | (uint32_t)payload[1] << 16 | (uint32_t)payload[2] << 8 | payload[3];
+}
+
+void test_server(void) {
+    printf("\n=== Testing Loopback Server ===\n");
+
+    binary_clock_query_t query;
+    binary_clock_query_init(&query, 64, ".");
+    binary_clock_h2_server_t server;
+    if (binary_clock_h2_server_open(&server, &query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        printf("  (skipped: cannot listen on loopback)\n");
+        binary_clock_query_free(&query);
+        return;
+    }
+    ASSERT_TRUE(server.port != 0, "ephemeral port bound");
+    size_t queues_before = binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used;
+
+    static client_t client;
+    static binary_clock_h2_hpack_t decoder;
+    static uint8_t payload[BINARY_CLOCK_H2_MAX_FRAME_SIZE];
+    binary_clock_h2_frame_t frame;
+    fields_t fields;
+    char body[4096];
+    char expected[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE];
+    bool ended = false;
+
+    open_client(&client, server.port);
+    binary_clock_h2_hpack_init(&decoder);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_SETTINGS, &frame, payload) && frame.flags == 0,
+                "server settings sent");
+    ASSERT_TRUE(frame.length == 6 && payload[1] == BINARY_CLOCK_H2_SETTINGS_MAX_CONCURRENT_STREAMS &&
+                payload[5] == BINARY_CLOCK_H2_MAX_STREAMS, "stream limit announced");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_SETTINGS, &frame, NULL) &&
+                (frame.flags & BINARY_CLOCK_H2_FLAG_ACK), "client settings acknowledged");
+    ASSERT_EQ(server.connection_count, 1, "connection open");
+    ASSERT_TRUE(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used >=
+                queues_before + sizeof(binary_clock_h2_connection_t), "connection charged to queues");
+
+    // Three queries in one write, answered on their own streams
+    send_request(&client, 1, "GET", "/at?t=1700000000&fmt=binary");
+    send_request(&client, 3, "GET", "/at?t=1700000000&tz=-05:00&fmt=ndjson");
+    send_request(&client, 5, "GET", "/at?t=x");
+    int statuses[3] = {0, 0, 0};
+    for (int i = 0; i < 3 && next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload); i++) {
+        int status = status_of(&decoder, payload, frame.length, &fields);
+        if (frame.stream == 1 || frame.stream == 3 || frame.stream == 5) {
+            statuses[frame.stream / 2] = status;
+        }
+        if (frame.stream == 3) {
+            ASSERT_TRUE(strstr(fields.text, "content-type: ") != NULL, "content type sent");
+        }
+    }
+    ASSERT_TRUE(statuses[0] == 200 && statuses[1] == 200 && statuses[2] == 400, "statuses per stream");
+    size_t expected_length = binary_clock_query_respond(&query, "/at?t=1700000000&fmt=binary", 27, expected,
+                                                        sizeof(expected));
+    const char* expected_body = strstr(expected, "\r\n\r\n");
+    size_t length = read_body(&server, &client, 1, body, sizeof(body), &ended);
+    ASSERT_TRUE(expected_body != NULL && length == expected_length - (size_t)(expected_body + 4 - expected) &&
+                memcmp(body, expected_body + 4, length) == 0, "body is the /at response body");
+    ASSERT_TRUE(ended, "response ends its stream");
+
+    // Methods other than GET
+    send_request(&client, 7, "POST", "/at?t=0");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload) && frame.stream == 7,
+                "POST answered");
+    ASSERT_EQ(status_of(&decoder, payload, frame.length, &fields), 405, "POST is 405");
+
+    // Ping
+    uint8_t ping[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    send_frame(&client, BINARY_CLOCK_H2_PING, 0, 0, ping, sizeof(ping));
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_PING, &frame, payload) &&
+                (frame.flags & BINARY_CLOCK_H2_FLAG_ACK) && memcmp(payload, ping, 8) == 0, "ping echoed");
+
+    // A header block split over HEADERS and CONTINUATION
+    uint8_t block[512];
+    size_t block_length = request_block("GET", "/at?t=1700000001&fmt=binary", block, sizeof(block));
+    send_frame(&client, BINARY_CLOCK_H2_HEADERS, BINARY_CLOCK_H2_FLAG_END_STREAM, 9, block, 3);
+    send_frame(&client, BINARY_CLOCK_H2_CONTINUATION, BINARY_CLOCK_H2_FLAG_END_HEADERS, 9, block + 3,
+               block_length - 3);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload) && frame.stream == 9,
+                "continued header block answered");
+    read_body(&server, &client, 9, body, sizeof(body), &ended);
+    ASSERT_TRUE(strstr(body, "22:13:21") != NULL, "continued request's path used");
+
+    // Padding and priority flags
+    uint8_t padded[600];
+    padded[0] = 4;
+    memset(padded + 1, 0, 5);
+    memcpy(padded + 6, block, block_length);
+    memset(padded + 6 + block_length, 0, 4);
+    send_frame(&client, BINARY_CLOCK_H2_HEADERS,
+               BINARY_CLOCK_H2_FLAG_END_HEADERS | BINARY_CLOCK_H2_FLAG_END_STREAM | BINARY_CLOCK_H2_FLAG_PADDED |
+               BINARY_CLOCK_H2_FLAG_PRIORITY, 11, padded, 6 + block_length + 4);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload) && frame.stream == 11,
+                "padded request with priority answered");
+    read_body(&server, &client, 11, body, sizeof(body), &ended);
+
+    // Tick streams: two follow the same zone and format, one another format
+    send_request(&client, 13, "GET", "/ticks?fmt=binary");
+    send_request(&client, 15, "GET", "/ticks?fmt=binary&tz=UTC");
+    send_request(&client, 17, "GET", "/ticks?tz=%2B05:30&fmt=json");
+    send_request(&client, 19, "GET", "/ticks?fmt=xml");
+    int subscribed = 0;
+    for (int i = 0; i < 4 && next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload); i++) {
+        int status = status_of(&decoder, payload, frame.length, &fields);
+        subscribed += status == 200 && (frame.flags & BINARY_CLOCK_H2_FLAG_END_STREAM) == 0;
+        if (frame.stream == 19) {
+            ASSERT_EQ(status, 400, "unknown tick format is 400");
+        }
+        if (frame.stream == 17) {
+            ASSERT_TRUE(strstr(fields.text, "content-type: application/json") != NULL, "tick content type");
+        }
+    }
+    ASSERT_EQ(subscribed, 3, "tick streams stay open");
+    read_body(&server, &client, 19, body, sizeof(body), &ended);
+
+    binary_clock_h2_stats_t before = server.stats;
+    binary_clock_h2_server_tick(&server, H2_EPOCH);
+    int tick_frames[3] = {0, 0, 0};
+    char tick_body[3][BINARY_CLOCK_RENDER_MAX_SIZE + 1];
+    for (int i = 0; i < 3 && next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, payload); i++) {
+        int index = (int)(frame.stream - 13) / 2;
+        if (index >= 0 && index < 3 && frame.length < sizeof(tick_body[0])) {
+            tick_frames[index]++;
+            memcpy(tick_body[index], payload, frame.length);
+            tick_body[index][frame.length] = '\0';
+            ASSERT_EQ(frame.flags & BINARY_CLOCK_H2_FLAG_END_STREAM, 0, "tick frame keeps the stream open");
+        }
+    }
+    ASSERT_TRUE(tick_frames[0] == 1 && tick_frames[1] == 1 && tick_frames[2] == 1, "one frame per tick stream");
+    ASSERT_EQ(server.stats.payloads_rendered - before.payloads_rendered, 2, "payload rendered once per format");
+    ASSERT_EQ(server.stats.ticks - before.ticks, 3, "three ticks sent");
+    ASSERT_TRUE(strstr(tick_body[0], "22:13:20") != NULL && strcmp(tick_body[0], tick_body[1]) == 0,
+                "shared payload on both streams");
+    ASSERT_TRUE(strstr(tick_body[2], "03:43:20") != NULL, "zone applied to its stream");
+
+    // Reset one tick stream: the next tick skips it
+    uint8_t cancel[4] = {0, 0, 0, BINARY_CLOCK_H2_NO_ERROR};
+    send_frame(&client, BINARY_CLOCK_H2_RST_STREAM, 0, 15, cancel, sizeof(cancel));
+    pump(&server, &client, 3);
+    before = server.stats;
+    binary_clock_h2_server_tick(&server, H2_EPOCH + 1);
+    ASSERT_EQ(server.stats.ticks - before.ticks, 2, "reset stream no longer ticks");
+    while (next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, NULL) && frame.stream != 17) {
+    }
+
+    // Zones: sealed, others are 404 and load nothing; unsealed and full, 503
+    size_t zones = query.zone_count;
+    binary_clock_query_seal_zones(&query);
+    send_request(&client, 21, "GET", "/ticks?tz=%2B01:00");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload) && frame.stream == 21 &&
+                status_of(&decoder, payload, frame.length, &fields) == 404, "zone not served is 404");
+    ASSERT_EQ(query.zone_count, zones, "sealed table loads no zone");
+    query.zones_sealed = false;
+    char name[16];
+    for (int i = 1; query.zone_count < BINARY_CLOCK_QUERY_MAX_ZONES; i++) {
+        sprintf(name, "+%02d:%02d", i / 4, (i % 4) * 15);
+        binary_clock_query_add_zone(&query, name, NULL);
+    }
+    send_request(&client, 23, "GET", "/ticks?tz=%2B16:00");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, payload) && frame.stream == 23 &&
+                status_of(&decoder, payload, frame.length, &fields) == 503, "new zone on a full table is 503");
+    ASSERT_TRUE(query.stats.unavailable == 1 && query.stats.not_found == 1, "zone statuses counted");
+    ASSERT_EQ(server.stats.protocol_errors, 0, "no protocol errors so far");
+    close(client.fd);
+    pump(&server, &client, 3);
+    ASSERT_EQ(server.connection_count, 0, "closed connection dropped");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, queues_before, "connection memory released");
+
+    binary_clock_h2_server_close(&server);
+    ASSERT_EQ(server.listen_fd, -1, "server closed");
+    binary_clock_query_free(&query);
+}
+
+void test_flow_control(void) {
+    printf("\n=== Testing Flow Control ===\n");
+
+    binary_clock_query_t query;
+    binary_clock_query_init(&query, 0, ".");
+    binary_clock_h2_server_t server;
+    if (binary_clock_h2_server_open(&server, &query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        printf("  (skipped: cannot listen on loopback)\n");
+        binary_clock_query_free(&query);
+        return;
+    }
+    static client_t client;
+    static uint8_t payload[BINARY_CLOCK_H2_MAX_FRAME_SIZE];
+    binary_clock_h2_frame_t frame;
+
+    // Streams may take 10 bytes until the client says otherwise
+    open_client(&client, server.port);
+    send_setting(&client, BINARY_CLOCK_H2_SETTINGS_INITIAL_WINDOW_SIZE, 10);
+    send_request(&client, 1, "GET", "/at?t=1700000000&fmt=binary");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, NULL), "headers not held back");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, payload), "first part sent");
+    ASSERT_EQ(frame.length, 10, "body cut at the stream window");
+    ASSERT_EQ(frame.flags & BINARY_CLOCK_H2_FLAG_END_STREAM, 0, "stream not ended yet");
+    pump(&server, &client, 3);
+    ASSERT_TRUE(!next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, NULL), "nothing past the window");
+
+    send_window_update(&client, 1, 20);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, NULL) && frame.length == 20,
+                "window update releases 20 more bytes");
+    send_setting(&client, BINARY_CLOCK_H2_SETTINGS_INITIAL_WINDOW_SIZE, 1000);
+    size_t rest = 0;
+    bool ended = false;
+    while (!ended && next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, NULL)) {
+        rest += frame.length;
+        ended = (frame.flags & BINARY_CLOCK_H2_FLAG_END_STREAM) != 0;
+    }
+    ASSERT_TRUE(ended && rest > 0, "raised initial window finishes the body");
+
+    // A tick that does not fit the window is dropped, not split
+    send_setting(&client, BINARY_CLOCK_H2_SETTINGS_INITIAL_WINDOW_SIZE, 10);
+    send_request(&client, 3, "GET", "/ticks?fmt=binary");
+    next_frame(&server, &client, BINARY_CLOCK_H2_HEADERS, &frame, NULL);
+    binary_clock_h2_server_tick(&server, H2_EPOCH);
+    ASSERT_EQ(server.stats.ticks_dropped, 1, "tick over the window dropped");
+    ASSERT_EQ(server.stats.ticks, 0, "nothing partial sent");
+    send_window_update(&client, 3, 1000);
+    pump(&server, &client, 3);
+    binary_clock_h2_server_tick(&server, H2_EPOCH + 1);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_DATA, &frame, NULL) && frame.stream == 3,
+                "next tick sent once the window allows");
+
+    // The connection window is shared by all streams
+    binary_clock_h2_connection_t* connection = server.connections[0];
+    int32_t window = connection->window;
+    send_window_update(&client, 0, 0x7fffffff - (uint32_t)window);
+    pump(&server, &client, 3);
+    ASSERT_EQ(connection->window, 0x7fffffff, "connection window grown to the maximum");
+    send_window_update(&client, 0, 1);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_GOAWAY, &frame, payload), "overflow ends the connection");
+    ASSERT_EQ(error_code(payload + 4), BINARY_CLOCK_H2_FLOW_CONTROL_ERROR, "flow control error");
+    close(client.fd);
+    pump(&server, &client, 3);
+
+    binary_clock_h2_server_close(&server);
+    binary_clock_query_free(&query);
+}
+
+void test_limits_and_errors(void) {
+    printf("\n=== Testing Limits and Connection Errors ===\n");
+
+    binary_clock_query_t query;
+    binary_clock_query_init(&query, 0, ".");
+    binary_clock_h2_server_t server;
+    if (binary_clock_h2_server_open(&server, &query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        printf("  (skipped: cannot listen on loopback)\n");
+        binary_clock_query_free(&query);
+        return;
+    }
+    static client_t client;
+    static uint8_t payload[BINARY_CLOCK_H2_MAX_FRAME_SIZE];
+    binary_clock_h2_frame_t frame;
+
+    // One stream past the limit is refused
+    open_client(&client, server.port);
+    for (uint32_t i = 0; i <= BINARY_CLOCK_H2_MAX_STREAMS; i++) {
+        send_request(&client, 1 + 2 * i, "GET", "/ticks");
+    }
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_RST_STREAM, &frame, payload), "stream reset");
+    ASSERT_EQ(frame.stream, 1 + 2 * BINARY_CLOCK_H2_MAX_STREAMS, "the stream over the limit");
+    ASSERT_EQ(error_code(payload), BINARY_CLOCK_H2_REFUSED_STREAM, "refused");
+    ASSERT_EQ(server.stats.refused_streams, 1, "refusal counted");
+    ASSERT_EQ(server.connections[0]->stream_count, BINARY_CLOCK_H2_MAX_STREAMS, "limit of streams open");
+    binary_clock_h2_server_tick(&server, H2_EPOCH);
+    ASSERT_EQ(server.stats.payloads_rendered, 1, "64 streams share one payload");
+    ASSERT_EQ(server.stats.ticks, BINARY_CLOCK_H2_MAX_STREAMS, "every stream ticked");
+
+    // Even stream identifiers belong to the server
+    send_request(&client, 200, "GET", "/at?t=0");
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_GOAWAY, &frame, payload), "GOAWAY sent");
+    ASSERT_EQ(error_code(payload), 1 + 2 * BINARY_CLOCK_H2_MAX_STREAMS, "last stream named");
+    ASSERT_EQ(error_code(payload + 4), BINARY_CLOCK_H2_PROTOCOL_ERROR, "protocol error");
+    pump(&server, &client, 5);
+    ASSERT_TRUE(client.closed, "connection closed after GOAWAY");
+    close(client.fd);
+    pump(&server, &client, 2);
+
+    // Bad header block compression
+    open_client(&client, server.port);
+    uint8_t bad_block[] = {0x80};
+    send_frame(&client, BINARY_CLOCK_H2_HEADERS, BINARY_CLOCK_H2_FLAG_END_HEADERS, 1, bad_block, 1);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_GOAWAY, &frame, payload) &&
+                error_code(payload + 4) == BINARY_CLOCK_H2_COMPRESSION_ERROR, "compression error");
+    close(client.fd);
+
+    // A frame interrupting a header block
+    open_client(&client, server.port);
+    send_frame(&client, BINARY_CLOCK_H2_HEADERS, 0, 1, bad_block, 0);
+    send_frame(&client, BINARY_CLOCK_H2_PING, 0, 0, "12345678", 8);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_GOAWAY, &frame, payload) &&
+                error_code(payload + 4) == BINARY_CLOCK_H2_PROTOCOL_ERROR, "missing CONTINUATION is an error");
+    close(client.fd);
+
+    // Oversized frame
+    open_client(&client, server.port);
+    uint8_t huge[BINARY_CLOCK_H2_FRAME_HEADER_SIZE];
+    binary_clock_h2_frame_t huge_frame = {BINARY_CLOCK_H2_MAX_FRAME_SIZE + 1, BINARY_CLOCK_H2_DATA, 0, 1};
+    binary_clock_h2_frame_write(huge, &huge_frame);
+    send(client.fd, huge, sizeof(huge), 0);
+    ASSERT_TRUE(next_frame(&server, &client, BINARY_CLOCK_H2_GOAWAY, &frame, payload) &&
+                error_code(payload + 4) == BINARY_CLOCK_H2_FRAME_SIZE_ERROR, "frame size error");
+    close(client.fd);
+
+    // Not HTTP/2 at all
+    client.fd = connect_client(server.port);
+    client.closed = false;
+    client.length = 0;
+    send(client.fd, "GET / HTTP/1.1\r\n\r\n", 18, 0);
+    pump(&server, &client, 5);
+    ASSERT_TRUE(client.closed, "HTTP/1.1 request closed");
+    close(client.fd);
+
+    pump(&server, &client, 5);
+    ASSERT_EQ(server.connection_count, 0, "failed connections dropped");
+    ASSERT_EQ(server.stats.protocol_errors, 4, "protocol errors counted");
+    char report[256];
+    binary_clock_h2_report(&server, report, sizeof(report));
+    ASSERT_TRUE(strstr(report, "5 connections") != NULL && strstr(report, "(1 refused)") != NULL,
+                "report counts connections and refusals");
+
+    binary_clock_h2_server_close(&server);
+    binary_clock_query_free(&query);
+}
+
+#endif
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    uint8_t block[4] = {0x82};
+    char text[4];
+    ASSERT_EQ(binary_clock_h2_hpack_decode(NULL, block, 1, NULL, NULL), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL table rejected");
+    static binary_clock_h2_hpack_t table;
+    binary_clock_h2_hpack_init(&table);
+    ASSERT_EQ(binary_clock_h2_hpack_decode(&table, block, 1, NULL, NULL), BINARY_CLOCK_SUCCESS,
+              "NULL callback allowed");
+    ASSERT_EQ(binary_clock_h2_huffman_decode(NULL, 1, text, sizeof(text)), SIZE_MAX, "NULL input rejected");
+    ASSERT_EQ(binary_clock_h2_huffman_encode(NULL, 1, block, sizeof(block)), 0, "NULL text rejected");
+    ASSERT_EQ(binary_clock_h2_hpack_encode_literal(block, sizeof(block), 0, NULL, "v", 1, false), 0,
+              "literal needs a name");
+    binary_clock_h2_server_t server;
+    ASSERT_EQ(binary_clock_h2_server_open(&server, NULL, "127.0.0.1", 0), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "server needs a responder");
+    ASSERT_EQ(binary_clock_h2_server_poll(NULL, 0), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL server rejected");
+    ASSERT_EQ(binary_clock_h2_server_tick(NULL, 0), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL server not ticked");
+    ASSERT_EQ(binary_clock_h2_report(NULL, text, sizeof(text)), 0, "NULL server has no report");
+    binary_clock_h2_server_close(NULL);
+}
+
+int main(void) {
+    printf("=== Binary Clock HTTP/2 Test Suite ===\n");
+
+    test_frames();
+    test_huffman();
+    test_hpack();
+    test_encoders();
+#ifndef _WIN32
+    test_server();
+    test_flow_control();
+    test_limits_and_errors();
+#endif
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All HTTP/2 tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,212 @@
+/**
+ * @file test_binary_clock_mem.c
+ * @brief Test suite for Binary Clock memory accounting
+ *
+ * Checks the counters and caps themselves, then that each capped
+ * subsystem switches to its lean mode: scalar kernels for the tuner,
+ * a smaller trace ring, and a fuller address table before it grows.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_mem.h>
+#include <binary_clock_tune.h>
+#include <binary_clock_trace.h>
+#include <binary_clock_admit.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define CACHE_PATH "test_binary_clock_mem.cache"
+
+void test_accounting(void) {
+    printf("\n=== Testing Accounting ===\n");
+
+    binary_clock_mem_reset();
+    binary_clock_mem_usage_t usage = binary_clock_mem_get_usage(BINARY_CLOCK_MEM_CACHES);
+    ASSERT_TRUE(usage.used == 0 && usage.peak == 0 && usage.cap == BINARY_CLOCK_MEM_UNCAPPED,
+                "subsystems start empty and uncapped");
+
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_CACHES, 4096);
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_QUEUES, 100);
+    binary_clock_mem_release(BINARY_CLOCK_MEM_CACHES, 1000);
+    usage = binary_clock_mem_get_usage(BINARY_CLOCK_MEM_CACHES);
+    ASSERT_EQ(usage.used, 3096, "charges and releases counted");
+    ASSERT_EQ(usage.peak, 4096, "peak kept after a release");
+    ASSERT_EQ(binary_clock_mem_total(), 3196, "total sums the subsystems");
+
+    binary_clock_mem_release(BINARY_CLOCK_MEM_QUEUES, 500);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, 0, "over-release stops at zero");
+
+    ASSERT_EQ(binary_clock_mem_set_cap(BINARY_CLOCK_MEM_CACHES, 4000), BINARY_CLOCK_SUCCESS, "cap set");
+    ASSERT_EQ(binary_clock_mem_available(BINARY_CLOCK_MEM_CACHES), 904, "available is the cap minus the used bytes");
+    ASSERT_TRUE(binary_clock_mem_reserve(BINARY_CLOCK_MEM_CACHES, 904), "reserve up to the cap succeeds");
+    ASSERT_TRUE(!binary_clock_mem_reserve(BINARY_CLOCK_MEM_CACHES, 1), "reserve past the cap refused");
+    usage = binary_clock_mem_get_usage(BINARY_CLOCK_MEM_CACHES);
+    ASSERT_TRUE(usage.used == 4000 && usage.lean == 1, "refused reserve charges nothing and counts a lean switch");
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_CACHES, 10);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_CACHES).used, 4010, "charge ignores the cap");
+
+    ASSERT_EQ(binary_clock_mem_set_cap((binary_clock_mem_subsystem_t)9, 1), BINARY_CLOCK_ERROR_OUTPUT,
+              "unknown subsystem rejected");
+    ASSERT_TRUE(!binary_clock_mem_reserve((binary_clock_mem_subsystem_t)9, 1), "unknown subsystem reserves nothing");
+}
+
+void test_names_and_report(void) {
+    printf("\n=== Testing Names and Report ===\n");
+
+    binary_clock_mem_subsystem_t subsystem = BINARY_CLOCK_MEM_TABLES;
+    ASSERT_EQ(binary_clock_mem_subsystem_from_name("registry", &subsystem), BINARY_CLOCK_SUCCESS, "name looked up");
+    ASSERT_EQ(subsystem, BINARY_CLOCK_MEM_REGISTRY, "name maps to its subsystem");
+    ASSERT_EQ(binary_clock_mem_subsystem_from_name("heap", &subsystem), BINARY_CLOCK_ERROR_OUTPUT,
+              "unknown name rejected");
+    ASSERT_TRUE(strcmp(binary_clock_mem_subsystem_name(BINARY_CLOCK_MEM_QUEUES), "queues") == 0, "subsystem named");
+
+    binary_clock_mem_reset();
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_TABLES, 0);
+    binary_clock_mem_reserve(BINARY_CLOCK_MEM_TABLES, 64);
+    binary_clock_mem_charge(BINARY_CLOCK_MEM_CACHES, 4096);
+    char report[BINARY_CLOCK_MEM_REPORT_SIZE];
+    size_t length = binary_clock_mem_report(report, sizeof(report));
+    ASSERT_EQ(length, strlen(report), "report length returned");
+    ASSERT_TRUE(strstr(report, "tables") != NULL && strstr(report, "registry") != NULL &&
+                strstr(report, "total") != NULL, "report lists every subsystem and the total");
+    ASSERT_TRUE(strstr(report, "caches             4096         4096            -        0\n") != NULL,
+                "uncapped row shows used, peak and no cap");
+    ASSERT_TRUE(strstr(report, "tables                0            0            0        1\n") != NULL,
+                "capped row shows the cap and the lean switch");
+
+    char small[32];
+    length = binary_clock_mem_report(small, sizeof(small));
+    ASSERT_TRUE(length == sizeof(small) - 1 && strlen(small) == length, "truncated report stays terminated");
+}
+
+void test_tables_cap(void) {
+    printf("\n=== Testing Tables Cap ===\n");
+
+    binary_clock_mem_reset();
+    binary_clock_tune_t tune;
+    binary_clock_tune_init(&tune);
+    tune.convert = BINARY_CLOCK_TUNE_KERNEL_TABLE;
+    tune.render = BINARY_CLOCK_TUNE_KERNEL_TABLE;
+    binary_clock_tune_save(&tune, CACHE_PATH);
+
+    binary_clock_tune_t loaded;
+    binary_clock_tune_init(&loaded);
+    ASSERT_EQ(binary_clock_tune_load(&loaded, CACHE_PATH), BINARY_CLOCK_SUCCESS, "table decision loaded");
+    ASSERT_TRUE(binary_clock_tune_render_fn(&loaded) == binary_clock_display_render_table, "tables used uncapped");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_TABLES).used, loaded.table_bytes, "tables charged");
+    ASSERT_EQ(loaded.table_bytes, binary_clock_display_table_size() + binary_clock_tune_convert_table_size(),
+              "both kernels' tables counted");
+
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_TABLES, 64);
+    ASSERT_EQ(binary_clock_tune_load(&loaded, CACHE_PATH), BINARY_CLOCK_SUCCESS, "table decision loaded under a cap");
+    ASSERT_TRUE(loaded.tables_capped, "tables over the cap");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_TABLES).used, 0, "earlier charge given back");
+    ASSERT_TRUE(binary_clock_tune_convert_fn(&loaded) == binary_clock_state_from_epoch &&
+                binary_clock_tune_render_fn(&loaded) == binary_clock_display_render,
+                "scalar kernels used over the cap");
+    ASSERT_EQ(loaded.render, BINARY_CLOCK_TUNE_KERNEL_TABLE, "decision kept for the cache");
+
+    char summary[512];
+    binary_clock_tune_describe(&loaded, summary, sizeof(summary));
+    ASSERT_TRUE(strstr(summary, "memory cap") != NULL, "summary says the tables were capped");
+    remove(CACHE_PATH);
+}
+
+void test_queues_cap(void) {
+    printf("\n=== Testing Queues Cap ===\n");
+
+    binary_clock_mem_reset();
+    size_t event = sizeof(binary_clock_trace_event_t);
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_QUEUES, 1000 * event);
+    ASSERT_EQ(binary_clock_trace_start(4096), BINARY_CLOCK_SUCCESS, "trace started under a cap");
+    ASSERT_EQ(binary_clock_trace_get_stats().capacity, 512, "ring halved until it fits");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, 512 * event, "smaller ring charged");
+    binary_clock_trace_stop();
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, 0, "ring released on stop");
+
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_QUEUES, 0);
+    binary_clock_trace_start(4096);
+    ASSERT_EQ(binary_clock_trace_get_stats().capacity, 64, "ring never shrinks below 64 events");
+    binary_clock_trace_stop();
+}
+
+void test_registry_cap(void) {
+    printf("\n=== Testing Registry Cap ===\n");
+
+    binary_clock_admit_limits_t limits = {0, 4, 0, 0};
+    binary_clock_admit_t admit;
+    binary_clock_mem_reset();
+    binary_clock_admit_init(&admit, &limits);
+    for (uint32_t address = 1; address <= 33; address++) {
+        binary_clock_admit_check(&admit, address, 0);
+    }
+    ASSERT_EQ(admit.address_capacity, 128, "uncapped table grows at half load");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_REGISTRY).used, binary_clock_admit_memory(&admit),
+              "table charged to the registry");
+    binary_clock_admit_free(&admit);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_REGISTRY).used, 0, "table released on free");
+
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_REGISTRY, 64 * sizeof(binary_clock_admit_entry_t));
+    binary_clock_admit_init(&admit, &limits);
+    for (uint32_t address = 1; address <= 48; address++) {
+        binary_clock_admit_check(&admit, address, 0);
+    }
+    ASSERT_EQ(admit.address_capacity, 64, "capped table fills to three quarters");
+    ASSERT_EQ(admit.stats.admitted, 48, "every address still admitted");
+    binary_clock_admit_check(&admit, 49, 0);
+    ASSERT_EQ(admit.address_capacity, 128, "table grows past three quarters");
+    ASSERT_TRUE(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_REGISTRY).lean > 0, "lean switches counted");
+    ASSERT_EQ(binary_clock_admit_check(&admit, 7, 0), BINARY_CLOCK_ADMIT_OK, "lookups work in the fuller table");
+    binary_clock_admit_free(&admit);
+}
+
+int main(void) {
+    printf("=== Binary Clock Memory Accounting Test Suite ===\n");
+
+    test_accounting();
+    test_names_and_report();
+    test_tables_cap();
+    test_queues_cap();
+    test_registry_cap();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All memory accounting tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file test_binary_clock_multicast.c
+ * @brief Test suite for the Binary Clock multicast ticks
+ *
+ * Covers the wire format, gap detection and an end-to-end run with many
+ * receivers joined to one group on the loopback interface. The end-to-end
+ * test is skipped where multicast sockets are unavailable.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_multicast.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define TEST_GROUP "239.255.66.68"
+#define TEST_PORT 42671
+#define TEST_RECEIVERS 16
+#define TEST_TICKS 200
+
+void test_wire_format(void) {
+    printf("\n=== Testing Wire Format ===\n");
+
+    binary_clock_tick_t tick = {0x01020304u, 0x143045u, 1700000000123456LL};
+    uint8_t datagram[BINARY_CLOCK_TICK_SIZE];
+    ASSERT_EQ(binary_clock_tick_encode(&tick, datagram), BINARY_CLOCK_SUCCESS, "tick encodes");
+
+    const uint8_t header[] = {'B', 'C', 'L', 'K', 1, 0, 0, 0, 0x00, 0x14, 0x30, 0x45, 0x01, 0x02, 0x03, 0x04};
+    ASSERT_TRUE(memcmp(datagram, header, sizeof(header)) == 0, "magic, version, packed and sequence in network order");
+
+    binary_clock_tick_t decoded = {0};
+    ASSERT_EQ(binary_clock_tick_decode(datagram, sizeof(datagram), &decoded), BINARY_CLOCK_SUCCESS, "tick decodes");
+    ASSERT_TRUE(decoded.sequence == tick.sequence && decoded.packed == tick.packed &&
+                decoded.present_at_us == tick.present_at_us, "round trip preserves every field");
+
+    ASSERT_EQ(binary_clock_tick_decode(datagram, sizeof(datagram) - 1, &decoded),
+              BINARY_CLOCK_ERROR_INVALID_TIME, "short datagram rejected");
+
+    uint8_t corrupt[BINARY_CLOCK_TICK_SIZE];
+    memcpy(corrupt, datagram, sizeof(corrupt));
+    corrupt[0] = 'X';
+    ASSERT_EQ(binary_clock_tick_decode(corrupt, sizeof(corrupt), &decoded),
+              BINARY_CLOCK_ERROR_INVALID_TIME, "wrong magic rejected");
+
+    memcpy(corrupt, datagram, sizeof(corrupt));
+    corrupt[4] = 2;
+    ASSERT_EQ(binary_clock_tick_decode(corrupt, sizeof(corrupt), &decoded),
+              BINARY_CLOCK_ERROR_INVALID_TIME, "unknown version rejected");
+
+    binary_clock_tick_t invalid = {0, 0x246000u, 0};
+    binary_clock_tick_encode(&invalid, corrupt);
+    ASSERT_EQ(binary_clock_tick_decode(corrupt, sizeof(corrupt), &decoded),
+              BINARY_CLOCK_ERROR_INVALID_TIME, "out-of-range packed digits rejected");
+
+    ASSERT_EQ(binary_clock_tick_decode(NULL, 0, &decoded), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL datagram rejected");
+}
+
+void test_gap_detection(void) {
+    printf("\n=== Testing Gap Detection ===\n");
+
+    binary_clock_receiver_t receiver;
+    binary_clock_receiver_reset(&receiver);
+
+    binary_clock_tick_t tick = {100, 0x120000u, 0};
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), 0, "first tick synchronizes");
+    tick.sequence = 101;
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), 0, "next tick in order");
+    tick.sequence = 104;
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), 2, "two missed ticks reported");
+    tick.sequence = 104;
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), -1, "duplicate dropped");
+    tick.sequence = 103;
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), -1, "late tick dropped");
+    ASSERT_TRUE(receiver.stats.applied == 3 && receiver.stats.lost == 2 && receiver.stats.stale == 2,
+                "counters track applied, lost and stale ticks");
+
+    binary_clock_receiver_reset(&receiver);
+    tick.sequence = 0xFFFFFFFFu;
+    binary_clock_receiver_apply(&receiver, &tick);
+    tick.sequence = 0;
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), 0, "sequence wraps without a gap");
+
+    tick.sequence = 100000;
+    binary_clock_receiver_apply(&receiver, &tick);
+    tick.sequence = 0;
+    ASSERT_EQ(binary_clock_receiver_apply(&receiver, &tick), 0, "broadcaster restart resynchronizes");
+    ASSERT_TRUE(receiver.stats.resyncs == 1 && receiver.last.sequence == 0, "restart counted once");
+}
+
+void test_loopback_fanout(void) {
+    printf("\n=== Testing Loopback Fan-out (%d receivers) ===\n", TEST_RECEIVERS);
+
+    binary_clock_broadcaster_t broadcaster;
+    binary_clock_receiver_t receivers[TEST_RECEIVERS];
+    int opened = 0;
+
+    if (binary_clock_broadcaster_open(&broadcaster, TEST_GROUP, TEST_PORT, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        printf("⚠ Skipped: multicast sockets unavailable on this platform\n");
+        return;
+    }
+    for (opened = 0; opened < TEST_RECEIVERS; opened++) {
+        if (binary_clock_receiver_open(&receivers[opened], TEST_GROUP, TEST_PORT, "127.0.0.1") != BINARY_CLOCK_SUCCESS) {
+            break;
+        }
+    }
+    ASSERT_EQ(opened, TEST_RECEIVERS, "all receivers join the same group and port");
+
+    // Send in bursts small enough for the default socket buffers, then drain
+    uint32_t packed = 0x235950u;
+    int sent = 0;
+    int received_all = 1;
+    int in_order = 1;
+    for (int burst = 0; burst < TEST_TICKS / 20; burst++) {
+        uint32_t burst_packed = packed;
+        for (int i = 0; i < 20; i++) {
+            if (binary_clock_broadcaster_send(&broadcaster, packed, 1000000LL * (sent + 1)) == BINARY_CLOCK_SUCCESS) {
+                sent++;
+            }
+            packed = binary_clock_packed_next_second(packed);
+        }
+        for (int r = 0; r < opened; r++) {
+            uint32_t expected = burst_packed;
+            for (int i = 0; i < 20; i++) {
+                binary_clock_tick_t tick;
+                int gap = -1;
+                if (binary_clock_receiver_receive(&receivers[r], &tick, &gap, 1000) != BINARY_CLOCK_SUCCESS) {
+                    received_all = 0;
+                    break;
+                }
+                if (gap != 0 || tick.packed != expected) {
+                    in_order = 0;
+                }
+                expected = binary_clock_packed_next_second(expected);
+            }
+        }
+    }
+    ASSERT_EQ(sent, TEST_TICKS, "every tick sent");
+    ASSERT_TRUE(received_all, "every receiver got every tick");
+    ASSERT_TRUE(in_order, "ticks arrive in order without gaps, across midnight");
+    ASSERT_EQ(receivers[0].stats.applied, TEST_TICKS, "receiver counts applied ticks");
+    ASSERT_EQ(broadcaster.sequence, TEST_TICKS, "broadcaster advanced its sequence");
+
+    binary_clock_tick_t tick;
+    ASSERT_EQ(binary_clock_receiver_receive(&receivers[0], &tick, NULL, 10),
+              BINARY_CLOCK_ERROR_TIMEOUT, "idle receiver times out");
+
+    for (int r = 0; r < opened; r++) {
+        binary_clock_receiver_close(&receivers[r]);
+    }
+    binary_clock_broadcaster_close(&broadcaster);
+    binary_clock_broadcaster_close(&broadcaster);
+    ASSERT_EQ(binary_clock_broadcaster_send(&broadcaster, 0, 0), BINARY_CLOCK_ERROR_NETWORK, "closed broadcaster refuses to send");
+}
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_broadcaster_t broadcaster;
+    binary_clock_receiver_t receiver;
+    ASSERT_EQ(binary_clock_broadcaster_open(NULL, TEST_GROUP, TEST_PORT, NULL, 1),
+              BINARY_CLOCK_ERROR_NULL_POINTER, "NULL broadcaster rejected");
+    ASSERT_EQ(binary_clock_broadcaster_open(&broadcaster, "127.0.0.1", TEST_PORT, NULL, 1),
+              BINARY_CLOCK_ERROR_NETWORK, "unicast address rejected as group");
+    ASSERT_EQ(binary_clock_receiver_open(&receiver, "not-an-address", TEST_PORT, NULL),
+              BINARY_CLOCK_ERROR_NETWORK, "malformed group rejected");
+    ASSERT_EQ(binary_clock_receiver_apply(NULL, NULL), -1, "NULL apply rejected");
+}
+
+int main(void) {
+    printf("=== Binary Clock Multicast Test Suite ===\n");
+
+    test_wire_format();
+    test_gap_detection();
+    test_loopback_fanout();
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All multicast tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,518 @@
+/**
+ * @file test_binary_clock_patch.c
+ * @brief Test suite for Binary Clock patch streams
+ *
+ * Checks the digit fragments, full documents, merge patches, resyncs and
+ * framing. A small RFC 7386 applier plays the client: applying a day of
+ * updates must rebuild the NDJSON document of every second.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_patch.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define BASE_EPOCH 1700006400LL  // Midnight UTC
+
+/* ========================================================================== */
+/* MERGE PATCH CLIENT                                                         */
+/* ========================================================================== */
+
+// Just enough JSON for the clock's documents: objects are trees, every
+// other value (number, string, array) is kept as its text, which is how
+// a merge patch treats it anyway
+#define JSON_NODES 64
+#define JSON_MEMBERS 8
+
+typedef struct {
+    bool object;
+    char key[16];
+    char text[48];
+    int members[JSON_MEMBERS];
+    int count;
+} json_node_t;
+
+typedef struct {
+    json_node_t nodes[JSON_NODES];
+    int used;
+} json_tree_t;
+
+static int json_new(json_tree_t* tree) {
+    if (tree->used >= JSON_NODES) {
+        return -1;
+    }
+    json_node_t* node = &tree->nodes[tree->used];
+    memset(node, 0, sizeof(*node));
+    return tree->used++;
+}
+
+// Parse the value at *text into a new node, -1 on malformed input
+static int json_parse(json_tree_t* tree, const char** text) {
+    int index = json_new(tree);
+    if (index < 0) {
+        return -1;
+    }
+    const char* p = *text;
+    if (*p == '{') {
+        tree->nodes[index].object = true;
+        p++;
+        while (*p != '}') {
+            const char* close = *p == '"' ? strchr(p + 1, '"') : NULL;
+            if (close == NULL || close[1] != ':' || (size_t)(close - p - 1) >= sizeof(tree->nodes[index].key) ||
+                tree->nodes[index].count >= JSON_MEMBERS) {
+                return -1;
+            }
+            const char* value = close + 2;
+            int member = json_parse(tree, &value);
+            if (member < 0) {
+                return -1;
+            }
+            memcpy(tree->nodes[member].key, p + 1, (size_t)(close - p - 1));
+            tree->nodes[index].members[tree->nodes[index].count++] = member;
+            p = value;
+            if (*p == ',') {
+                p++;
+            } else if (*p != '}') {
+                return -1;
+            }
+        }
+        *text = p + 1;
+        return index;
+    }
+    const char* end = p;
+    if (*p == '[') {
+        end = strchr(p, ']');
+        end = end != NULL ? end + 1 : NULL;
+    } else if (*p == '"') {
+        end = strchr(p + 1, '"');
+        end = end != NULL ? end + 1 : NULL;
+    } else {
+        while ((*end >= '0' && *end <= '9') || *end == '-') {
+            end++;
+        }
+    }
+    if (end == NULL || end == p || (size_t)(end - p) >= sizeof(tree->nodes[index].text)) {
+        return -1;
+    }
+    memcpy(tree->nodes[index].text, p, (size_t)(end - p));
+    *text = end;
+    return index;
+}
+
+static int json_copy(json_tree_t* target, const json_tree_t* source, int index) {
+    int copy = json_new(target);
+    if (copy < 0) {
+        return -1;
+    }
+    target->nodes[copy] = source->nodes[index];
+    for (int m = 0; m < source->nodes[index].count; m++) {
+        int member = json_copy(target, source, source->nodes[index].members[m]);
+        if (member < 0) {
+            return -1;
+        }
+        target->nodes[copy].members[m] = member;
+    }
+    return copy;
+}
+
+// RFC 7386 MergePatch(target, patch) for object patches without nulls
+static int json_merge(json_tree_t* target, int into, const json_tree_t* patch, int from) {
+    if (!patch->nodes[from].object) {
+        return -1;
+    }
+    if (!target->nodes[into].object) {
+        target->nodes[into].object = true;
+        target->nodes[into].count = 0;
+    }
+    for (int m = 0; m < patch->nodes[from].count; m++) {
+        const json_node_t* change = &patch->nodes[patch->nodes[from].members[m]];
+        int existing = -1;
+        for (int t = 0; t < target->nodes[into].count; t++) {
+            if (strcmp(target->nodes[target->nodes[into].members[t]].key, change->key) == 0) {
+                existing = target->nodes[into].members[t];
+            }
+        }
+        if (existing >= 0 && change->object) {
+            if (json_merge(target, existing, patch, patch->nodes[from].members[m]) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        int copy = json_copy(target, patch, patch->nodes[from].members[m]);
+        if (copy < 0) {
+            return -1;
+        }
+        if (existing >= 0) {
+            // Replace in place, keeping the member order
+            target->nodes[existing] = target->nodes[copy];
+        } else if (target->nodes[into].count < JSON_MEMBERS) {
+            target->nodes[into].members[target->nodes[into].count++] = copy;
+        } else {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static size_t json_write(const json_tree_t* tree, int index, char* output, size_t length) {
+    const json_node_t* node = &tree->nodes[index];
+    if (!node->object) {
+        memcpy(output + length, node->text, strlen(node->text));
+        return length + strlen(node->text);
+    }
+    output[length++] = '{';
+    for (int m = 0; m < node->count; m++) {
+        const json_node_t* member = &tree->nodes[node->members[m]];
+        length += (size_t)sprintf(output + length, "%s\"%s\":", m > 0 ? "," : "", member->key);
+        length = json_write(tree, node->members[m], output, length);
+    }
+    output[length++] = '}';
+    return length;
+}
+
+typedef struct {
+    json_tree_t document;
+    int root;
+} client_t;
+
+static void client_init(client_t* client) {
+    client->document.used = 0;
+    client->root = json_new(&client->document);
+    client->document.nodes[client->root].object = true;
+}
+
+// Apply one NDJSON update; trees are rebuilt compactly so the pool never fills
+static int client_apply(client_t* client, const char* update, size_t length) {
+    if (length == 0 || update[length - 1] != '\n') {
+        return -1;
+    }
+    static json_tree_t patch;
+    patch.used = 0;
+    const char* text = update;
+    int from = json_parse(&patch, &text);
+    if (from < 0 || text != update + length - 1 || json_merge(&client->document, client->root, &patch, from) != 0) {
+        return -1;
+    }
+    static json_tree_t compact;
+    compact.used = 0;
+    int root = json_copy(&compact, &client->document, client->root);
+    if (root < 0) {
+        return -1;
+    }
+    client->document = compact;
+    client->root = root;
+    return 0;
+}
+
+// The client's document as a JSON line
+static size_t client_document(const client_t* client, char* output) {
+    size_t length = json_write(&client->document, client->root, output, 0);
+    output[length++] = '\n';
+    return length;
+}
+
+/* ========================================================================== */
+/* TESTS                                                                      */
+/* ========================================================================== */
+
+static binary_clock_state_t state_at(int hours, int minutes, int seconds) {
+    return binary_clock_state_from_epoch(BASE_EPOCH + hours * 3600 + minutes * 60 + seconds, 0);
+}
+
+static bool update_is(const char* output, size_t length, const char* expected) {
+    return length == strlen(expected) && memcmp(output, expected, length) == 0;
+}
+
+void test_init(void) {
+    printf("\n=== Testing Initialization ===\n");
+
+    binary_clock_patch_t patch;
+    ASSERT_EQ(binary_clock_patch_init(NULL, BINARY_CLOCK_PATCH_NDJSON, 60), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL encoder rejected");
+    ASSERT_EQ(binary_clock_patch_init(&patch, (binary_clock_patch_framing_t)7, 60), BINARY_CLOCK_ERROR_OUTPUT,
+              "unknown framing rejected");
+    ASSERT_EQ(binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, 60), BINARY_CLOCK_SUCCESS,
+              "encoder initialized");
+    ASSERT_TRUE(!patch.started && patch.resync == 60 && patch.render == binary_clock_display_render,
+                "encoder starts with a full document due");
+
+    ASSERT_TRUE(patch.fragment_lengths[0][2] == 14 && memcmp(patch.fragments[0][2], "\"tens\":[0,1,0]", 14) == 0,
+                "tens fragment is three bits");
+    ASSERT_TRUE(patch.fragment_lengths[5][6] == 17 && memcmp(patch.fragments[5][6], "\"units\":[0,1,1,0]", 17) == 0,
+                "units fragment is four bits");
+    ASSERT_TRUE(patch.fragment_lengths[4][7] == 14 && patch.fragment_lengths[4][8] == 0,
+                "no fragment past a tens digit's bits");
+
+    binary_clock_state_t state = state_at(14, 30, 45);
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    ASSERT_EQ(binary_clock_patch_update(NULL, &state, output, sizeof(output)), (size_t)-1, "NULL encoder fails");
+    ASSERT_EQ(binary_clock_patch_update(&patch, NULL, output, sizeof(output)), (size_t)-1, "NULL state fails");
+    ASSERT_EQ(binary_clock_patch_update(&patch, &state, NULL, sizeof(output)), (size_t)-1, "NULL output fails");
+
+    binary_clock_state_t bad = state;
+    bad.seconds_tens.decimal_value = 9;
+    ASSERT_EQ(binary_clock_patch_update(&patch, &bad, output, sizeof(output)), (size_t)-1,
+              "digit without a fragment fails");
+    ASSERT_TRUE(!patch.started && patch.stats.documents == 0, "failed update leaves the encoder unchanged");
+}
+
+void test_updates(void) {
+    printf("\n=== Testing Documents and Patches ===\n");
+
+    binary_clock_patch_t patch;
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, 0);
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    char expected[BINARY_CLOCK_RENDER_MAX_SIZE];
+
+    binary_clock_state_t state = state_at(14, 30, 45);
+    size_t length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    size_t rendered = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, expected, sizeof(expected));
+    ASSERT_TRUE(length == rendered && memcmp(output, expected, length) == 0,
+                "first update is the NDJSON document");
+    ASSERT_TRUE(patch.started && patch.stats.documents == 1 && patch.stats.patches == 0, "document counted");
+
+    ASSERT_EQ(binary_clock_patch_update(&patch, &state, output, sizeof(output)), 0, "unchanged state sends nothing");
+    ASSERT_EQ(patch.stats.unchanged, 1, "unchanged state counted");
+
+    state = state_at(14, 30, 46);
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length,
+                          "{\"timestamp\":1700058646,\"time\":\"14:30:46\","
+                          "\"binary\":{\"seconds\":{\"units\":[0,1,1,0]}}}\n"),
+                "next second patches the seconds units only");
+    ASSERT_TRUE(length * 2 < rendered, "patch is under half the document");
+
+    state = state_at(14, 30, 50);
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length,
+                          "{\"timestamp\":1700058650,\"time\":\"14:30:50\","
+                          "\"binary\":{\"seconds\":{\"tens\":[1,0,1],\"units\":[0,0,0,0]}}}\n"),
+                "tens rollover patches both seconds digits");
+
+    state = state_at(14, 59, 59);
+    binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    state = state_at(15, 0, 0);
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length,
+                          "{\"timestamp\":1700060400,\"time\":\"15:00:00\",\"binary\":{"
+                          "\"hours\":{\"units\":[0,1,0,1]},"
+                          "\"minutes\":{\"tens\":[0,0,0],\"units\":[0,0,0,0]},"
+                          "\"seconds\":{\"tens\":[0,0,0],\"units\":[0,0,0,0]}}}\n"),
+                "hour rollover patches each changed digit in its group");
+
+    // Same digits a day later: only the timestamp moved
+    state = binary_clock_state_from_epoch(BASE_EPOCH + 86400 + 15 * 3600, 0);
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length, "{\"timestamp\":1700146800}\n"), "timestamp-only patch");
+
+    // A state that is never sent folds into the next patch
+    state = state_at(15, 0, 1);
+    binary_clock_state_t later = state_at(15, 0, 7);
+    length = binary_clock_patch_update(&patch, &later, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length,
+                          "{\"timestamp\":1700060407,\"time\":\"15:00:07\","
+                          "\"binary\":{\"seconds\":{\"units\":[0,1,1,1]}}}\n"),
+                "skipped seconds fold into one patch against the last sent");
+    ASSERT_EQ(patch.stats.documents, 1, "resync 0 sends one document only");
+
+    // Too small a buffer fails without recording anything
+    length = binary_clock_patch_update(&patch, &state, output, 20);
+    ASSERT_EQ(length, (size_t)-1, "buffer too small for the patch fails");
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length,
+                          "{\"timestamp\":1700060401,\"time\":\"15:00:01\","
+                          "\"binary\":{\"seconds\":{\"units\":[0,0,0,1]}}}\n"),
+                "failed update is retried against the same base");
+
+    binary_clock_patch_resync(&patch);
+    state = state_at(15, 0, 2);
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    rendered = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, expected, sizeof(expected));
+    ASSERT_TRUE(length == rendered && memcmp(output, expected, length) == 0, "resync sends a full document");
+
+    binary_clock_patch_t fresh;
+    binary_clock_patch_init(&fresh, BINARY_CLOCK_PATCH_NDJSON, 0);
+    ASSERT_EQ(binary_clock_patch_update(&fresh, &state, output, 40), (size_t)-1,
+              "buffer too small for the document fails");
+    ASSERT_TRUE(!fresh.started, "document still due after the failure");
+}
+
+void test_resync(void) {
+    printf("\n=== Testing Periodic Resync ===\n");
+
+    binary_clock_patch_t patch;
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, 3);
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    char kinds[10];
+    for (int i = 0; i < 9; i++) {
+        binary_clock_state_t state = state_at(12, 0, i);
+        uint64_t documents = patch.stats.documents;
+        binary_clock_patch_update(&patch, &state, output, sizeof(output));
+        kinds[i] = patch.stats.documents != documents ? 'D' : 'p';
+    }
+    kinds[9] = '\0';
+    ASSERT_TRUE(strcmp(kinds, "DppDppDpp") == 0, "resync 3: a document every third update");
+
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, 1);
+    for (int i = 0; i < 5; i++) {
+        binary_clock_state_t state = state_at(12, 0, i);
+        binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    }
+    ASSERT_TRUE(patch.stats.documents == 5 && patch.stats.patches == 0, "resync 1: every update a document");
+
+    // Unchanged states are not updates and do not bring the resync closer
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, 2);
+    binary_clock_state_t state = state_at(12, 0, 0);
+    for (int i = 0; i < 5; i++) {
+        binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    }
+    ASSERT_TRUE(patch.stats.documents == 1 && patch.stats.unchanged == 4, "unchanged states skip the resync count");
+}
+
+void test_sse(void) {
+    printf("\n=== Testing Server-Sent Events Framing ===\n");
+
+    binary_clock_patch_t patch;
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_SSE, 60);
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    char expected[BINARY_CLOCK_PATCH_MAX_SIZE] = "data: ";
+
+    binary_clock_state_t state = state_at(8, 5, 9);
+    size_t length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    size_t rendered = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, expected + 6,
+                                                  sizeof(expected) - 7);
+    expected[6 + rendered] = '\n';
+    ASSERT_TRUE(length == rendered + 7 && memcmp(output, expected, length) == 0,
+                "document is one data line and a blank line");
+
+    state = state_at(8, 5, 10);
+    length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+    ASSERT_TRUE(update_is(output, length,
+                          "data: {\"timestamp\":1700035510,\"time\":\"08:05:10\","
+                          "\"binary\":{\"seconds\":{\"tens\":[0,0,1],\"units\":[0,0,0,0]}}}\n\n"),
+                "patch framed as an event");
+    ASSERT_EQ(patch.stats.bytes, (uint64_t)(rendered + 7 + length), "bytes include the framing");
+
+    // The largest update fits the documented buffer size
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_SSE, 0);
+    state = state_at(23, 59, 59);
+    ASSERT_TRUE(binary_clock_patch_update(&patch, &state, output, BINARY_CLOCK_PATCH_MAX_SIZE) != (size_t)-1,
+                "document fits BINARY_CLOCK_PATCH_MAX_SIZE");
+    state = binary_clock_state_from_epoch(BASE_EPOCH + 86400, 0);
+    ASSERT_TRUE(binary_clock_patch_update(&patch, &state, output, BINARY_CLOCK_PATCH_MAX_SIZE) != (size_t)-1,
+                "midnight patch fits BINARY_CLOCK_PATCH_MAX_SIZE");
+}
+
+void test_client_day(void) {
+    printf("\n=== Testing a Client Applying a Day ===\n");
+
+    binary_clock_patch_t patch;
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, BINARY_CLOCK_PATCH_DEFAULT_RESYNC);
+    static client_t client;
+    static client_t late;
+    client_init(&client);
+    client_init(&late);
+    bool late_joined = false;
+    char output[BINARY_CLOCK_PATCH_MAX_SIZE];
+    char expected[BINARY_CLOCK_RENDER_MAX_SIZE];
+    char document[BINARY_CLOCK_RENDER_MAX_SIZE];
+    long mismatched = 0;
+    long late_mismatched = 0;
+    uint64_t full_bytes = 0;
+
+    for (long second = 0; second <= 86400; second++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + second, 0);
+        size_t length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+        size_t rendered = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, expected,
+                                                      sizeof(expected));
+        full_bytes += rendered;
+        if (length == (size_t)-1 || client_apply(&client, output, length) != 0 ||
+            client_document(&client, document) != rendered || memcmp(document, expected, rendered) != 0) {
+            mismatched++;
+        }
+
+        // A client connecting at 00:01:30 ignores patches until a document
+        bool is_document = patch.since_document == 0;
+        if (second >= 90 && (late_joined || is_document)) {
+            late_joined = true;
+            if (client_apply(&late, output, length) != 0 || client_document(&late, document) != rendered ||
+                memcmp(document, expected, rendered) != 0) {
+                late_mismatched++;
+            }
+        }
+    }
+    printf("  %llu documents, %llu patches, %.1f bytes/update against %.1f for documents\n",
+           (unsigned long long)patch.stats.documents, (unsigned long long)patch.stats.patches,
+           (double)patch.stats.bytes / 86401, (double)full_bytes / 86401);
+    ASSERT_EQ(mismatched, 0, "client rebuilds every second's document");
+    ASSERT_TRUE(late_joined && late_mismatched == 0, "late client is whole from its first document");
+    ASSERT_EQ(patch.stats.documents, (uint64_t)(86401 + 59) / 60, "a document every resync updates");
+    ASSERT_TRUE(patch.stats.bytes * 2 < full_bytes, "stream is under half the NDJSON bytes");
+
+    // Only every seventh second reaches the client: patches still add up
+    binary_clock_patch_init(&patch, BINARY_CLOCK_PATCH_NDJSON, 0);
+    client_init(&client);
+    mismatched = 0;
+    for (long second = 0; second <= 86400; second += 7) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH + second, 0);
+        size_t length = binary_clock_patch_update(&patch, &state, output, sizeof(output));
+        size_t rendered = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_JSON_LINE, expected,
+                                                      sizeof(expected));
+        if (length == (size_t)-1 || client_apply(&client, output, length) != 0 ||
+            client_document(&client, document) != rendered || memcmp(document, expected, rendered) != 0) {
+            mismatched++;
+        }
+    }
+    ASSERT_EQ(mismatched, 0, "sparse states patch correctly");
+}
+
+int main(void) {
+    printf("=== Binary Clock Patch Stream Test Suite ===\n");
+
+    test_init();
+    test_updates();
+    test_resync();
+    test_sse();
+    test_client_day();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All patch stream tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,333 @@
+/**
+ * @file test_binary_clock_pipe.c
+ * @brief Test suite for Binary Clock pipe output
+ *
+ * A forked reader drains the pipe and sends back a byte count and a hash,
+ * so streams far larger than the pipe are checked for lost, repeated or
+ * rewritten bytes in both splice and write modes.
+ */
+
+#define _GNU_SOURCE  // F_GETPIPE_SZ
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <binary_clock_pipe.h>
+#include <binary_clock_mem.h>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/wait.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define FILE_PATH "test_binary_clock_pipe.out"
+
+#ifndef _WIN32
+
+typedef struct {
+    uint64_t bytes;
+    uint64_t hash;
+} digest_t;
+
+static uint64_t hash_bytes(uint64_t hash, const char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)data[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Frame i of a test stream: varying lengths so frames straddle buffers
+static size_t make_frame(char* frame, uint32_t i) {
+    return (size_t)sprintf(frame, "frame %u %.*s\n", i, (int)(i % 37), "abcdefghijklmnopqrstuvwxyz0123456789!");
+}
+
+static digest_t expected_digest(uint32_t frames) {
+    digest_t digest = {0, 14695981039346656037ULL};
+    char frame[64];
+    for (uint32_t i = 0; i < frames; i++) {
+        size_t length = make_frame(frame, i);
+        digest.bytes += length;
+        digest.hash = hash_bytes(digest.hash, frame, length);
+    }
+    return digest;
+}
+
+typedef struct {
+    int fd;
+    int result_fd;
+    pid_t pid;
+} reader_t;
+
+// Fork a reader that drains a fresh pipe, slowly if asked
+static int start_reader(reader_t* reader, int slow) {
+    int data[2], result[2];
+    if (pipe(data) != 0 || pipe(result) != 0) {
+        return -1;
+    }
+    reader->pid = fork();
+    if (reader->pid == 0) {
+        close(data[1]);
+        close(result[0]);
+        digest_t digest = {0, 14695981039346656037ULL};
+        char buffer[4096];
+        ssize_t got;
+        while ((got = read(data[0], buffer, slow ? 512 : sizeof(buffer))) > 0) {
+            digest.bytes += (uint64_t)got;
+            digest.hash = hash_bytes(digest.hash, buffer, (size_t)got);
+        }
+        if (write(result[1], &digest, sizeof(digest)) != (ssize_t)sizeof(digest)) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(data[0]);
+    close(result[1]);
+    reader->fd = data[1];
+    reader->result_fd = result[0];
+    return reader->pid > 0 ? 0 : -1;
+}
+
+static digest_t finish_reader(reader_t* reader) {
+    digest_t digest = {0, 0};
+    close(reader->fd);
+    if (read(reader->result_fd, &digest, sizeof(digest)) != (ssize_t)sizeof(digest)) {
+        digest.bytes = 0;
+    }
+    close(reader->result_fd);
+    waitpid(reader->pid, NULL, 0);
+    return digest;
+}
+
+// Stream frames through a writer, alternating reserve/commit and write
+static void stream_frames(binary_clock_pipe_writer_t* writer, uint32_t frames) {
+    char frame[64];
+    for (uint32_t i = 0; i < frames; i++) {
+        if (i % 2 == 0) {
+            char* space = binary_clock_pipe_writer_reserve(writer, sizeof(frame));
+            if (space != NULL) {
+                binary_clock_pipe_writer_commit(writer, make_frame(space, i));
+            }
+        } else {
+            size_t length = make_frame(frame, i);
+            binary_clock_pipe_writer_write(writer, frame, length);
+        }
+    }
+}
+
+void test_splice_stream(void) {
+    printf("\n=== Testing Spliced Stream ===\n");
+
+    const uint32_t frames = 200000;
+    digest_t expected = expected_digest(frames);
+    binary_clock_mem_reset();
+
+    reader_t reader;
+    ASSERT_EQ(start_reader(&reader, 0), 0, "reader started");
+    binary_clock_pipe_writer_t writer;
+    ASSERT_EQ(binary_clock_pipe_writer_open(&writer, reader.fd, 256 * 1024, true), BINARY_CLOCK_SUCCESS,
+              "writer opened on a pipe");
+#ifdef __linux__
+    ASSERT_TRUE(writer.splice, "pipes are spliced on Linux");
+    ASSERT_TRUE(writer.buffer_size >= 256 * 1024, "pipe enlarged to the requested size");
+    ASSERT_TRUE(writer.buffers[0] != NULL && writer.buffers[1] != NULL, "two buffers for splicing");
+#endif
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, writer.bytes, "buffers charged to queues");
+    ASSERT_EQ(writer.bytes, (writer.splice ? 2 : 1) * (writer.buffer_size + BINARY_CLOCK_PIPE_RESERVE_MAX),
+              "charge matches the buffers and their slack");
+
+    stream_frames(&writer, frames);
+    ASSERT_EQ(binary_clock_pipe_writer_close(&writer), BINARY_CLOCK_SUCCESS, "writer closed");
+    digest_t got = finish_reader(&reader);
+    ASSERT_EQ(got.bytes, expected.bytes, "every byte arrived");
+    ASSERT_TRUE(got.hash == expected.hash, "bytes arrived intact and in order");
+    ASSERT_EQ(writer.stats.bytes, expected.bytes, "bytes counted");
+#ifdef __linux__
+    ASSERT_EQ(writer.stats.spliced, expected.bytes / writer.buffer_size, "every full buffer spliced");
+#endif
+    ASSERT_EQ(writer.stats.written, 1, "only the final partial buffer written");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, 0, "charge released on close");
+}
+
+void test_slow_reader(void) {
+    printf("\n=== Testing Slow Reader ===\n");
+
+    // A reader lagging behind must never see a buffer being refilled
+    const uint32_t frames = 100000;
+    digest_t expected = expected_digest(frames);
+    reader_t reader;
+    start_reader(&reader, 1);
+    binary_clock_pipe_writer_t writer;
+    binary_clock_pipe_writer_open(&writer, reader.fd, 64 * 1024, true);
+    stream_frames(&writer, frames);
+    binary_clock_pipe_writer_close(&writer);
+    digest_t got = finish_reader(&reader);
+    ASSERT_EQ(got.bytes, expected.bytes, "every byte arrived through small reads");
+    ASSERT_TRUE(got.hash == expected.hash, "spliced pages not rewritten while queued");
+}
+
+void test_write_stream(void) {
+    printf("\n=== Testing Written Stream ===\n");
+
+    const uint32_t frames = 100000;
+    digest_t expected = expected_digest(frames);
+    reader_t reader;
+    start_reader(&reader, 0);
+    binary_clock_pipe_writer_t writer;
+    binary_clock_pipe_writer_open(&writer, reader.fd, 0, false);
+    ASSERT_TRUE(!writer.splice, "splicing can be turned off");
+    ASSERT_EQ(writer.buffer_size, BINARY_CLOCK_PIPE_WRITE_BUFFER_SIZE, "write buffer size");
+    ASSERT_TRUE(writer.buffers[1] == NULL, "one buffer without splicing");
+    stream_frames(&writer, frames);
+    binary_clock_pipe_writer_close(&writer);
+    digest_t got = finish_reader(&reader);
+    ASSERT_EQ(got.bytes, expected.bytes, "every byte arrived");
+    ASSERT_TRUE(got.hash == expected.hash, "bytes arrived intact and in order");
+    ASSERT_EQ(writer.stats.spliced, 0, "nothing spliced");
+    ASSERT_EQ(writer.stats.written, (expected.bytes + writer.buffer_size - 1) / writer.buffer_size,
+              "one write per buffer");
+}
+
+void test_file_output(void) {
+    printf("\n=== Testing File Output ===\n");
+
+    const uint32_t frames = 20000;
+    digest_t expected = expected_digest(frames);
+    int fd = open(FILE_PATH, O_CREAT | O_TRUNC | O_RDWR, 0600);
+    ASSERT_TRUE(fd >= 0, "output file created");
+    binary_clock_pipe_writer_t writer;
+    binary_clock_pipe_writer_open(&writer, fd, 0, true);
+    ASSERT_TRUE(!writer.splice, "files are never spliced");
+    stream_frames(&writer, frames);
+    ASSERT_EQ(binary_clock_pipe_writer_close(&writer), BINARY_CLOCK_SUCCESS, "writer closed");
+
+    char buffer[4096];
+    digest_t got = {0, 14695981039346656037ULL};
+    ssize_t length;
+    lseek(fd, 0, SEEK_SET);
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+        got.bytes += (uint64_t)length;
+        got.hash = hash_bytes(got.hash, buffer, (size_t)length);
+    }
+    close(fd);
+    remove(FILE_PATH);
+    ASSERT_EQ(got.bytes, expected.bytes, "file holds every byte");
+    ASSERT_TRUE(got.hash == expected.hash, "file contents intact");
+}
+
+void test_queues_cap(void) {
+    printf("\n=== Testing Queues Cap ===\n");
+
+    binary_clock_mem_reset();
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_QUEUES, 256 * 1024);
+    reader_t reader;
+    start_reader(&reader, 0);
+    int initial = -1;
+#ifdef F_GETPIPE_SZ
+    initial = fcntl(reader.fd, F_GETPIPE_SZ);
+#endif
+    binary_clock_pipe_writer_t writer;
+    binary_clock_pipe_writer_open(&writer, reader.fd, 1024 * 1024, true);
+#ifdef __linux__
+    ASSERT_TRUE(writer.splice, "still spliced over the cap");
+    ASSERT_EQ(writer.buffer_size, (size_t)initial, "pipe kept at its size");
+    ASSERT_TRUE(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).lean > 0, "lean switch counted");
+#endif
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used, writer.bytes, "smaller buffers charged");
+    stream_frames(&writer, 50000);
+    binary_clock_pipe_writer_close(&writer);
+    digest_t got = finish_reader(&reader);
+    ASSERT_EQ(got.bytes, expected_digest(50000).bytes, "lean writer delivers everything");
+    binary_clock_mem_reset();
+}
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_pipe_writer_t writer;
+    ASSERT_EQ(binary_clock_pipe_writer_open(NULL, 1, 0, true), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL writer");
+    ASSERT_EQ(binary_clock_pipe_writer_write(NULL, "x", 1), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL write");
+    ASSERT_EQ(binary_clock_pipe_writer_flush(NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL flush");
+    ASSERT_EQ(binary_clock_pipe_writer_close(NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL close");
+    ASSERT_TRUE(binary_clock_pipe_writer_reserve(NULL, 1) == NULL, "NULL reserve");
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0, "pipe created");
+    binary_clock_pipe_writer_open(&writer, fds[1], 0, false);
+    ASSERT_EQ(binary_clock_pipe_writer_write(&writer, NULL, 1), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL data");
+    ASSERT_TRUE(binary_clock_pipe_writer_reserve(&writer, BINARY_CLOCK_PIPE_RESERVE_MAX + 1) == NULL,
+                "reserve larger than the slack refused");
+    ASSERT_EQ(binary_clock_pipe_writer_write(&writer, "abc", 3), BINARY_CLOCK_SUCCESS, "small write buffered");
+    ASSERT_EQ(writer.stats.system_calls, 0, "nothing sent before a flush");
+    ASSERT_EQ(binary_clock_pipe_writer_commit(&writer, BINARY_CLOCK_PIPE_RESERVE_MAX + 1), BINARY_CLOCK_ERROR_OUTPUT,
+              "commit larger than the slack refused");
+    ASSERT_EQ(writer.used, 3, "refused commit keeps nothing");
+    ASSERT_EQ(binary_clock_pipe_writer_commit(NULL, 1), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL commit");
+
+    // A reader that has gone away fails the flush
+    close(fds[0]);
+    void (*previous)(int) = signal(SIGPIPE, SIG_IGN);
+    ASSERT_EQ(binary_clock_pipe_writer_flush(&writer), BINARY_CLOCK_ERROR_OUTPUT, "flush to a closed pipe fails");
+    ASSERT_EQ(binary_clock_pipe_writer_close(&writer), BINARY_CLOCK_SUCCESS, "close after a failed flush");
+    ASSERT_EQ(binary_clock_pipe_writer_write(&writer, "x", 1), BINARY_CLOCK_ERROR_OUTPUT, "write after close fails");
+    ASSERT_TRUE(binary_clock_pipe_writer_reserve(&writer, 1) == NULL, "reserve after close fails");
+    signal(SIGPIPE, previous);
+    close(fds[1]);
+}
+
+#endif
+
+int main(void) {
+    printf("=== Binary Clock Pipe Output Test Suite ===\n");
+
+#ifndef _WIN32
+    test_splice_stream();
+    test_slow_reader();
+    test_write_stream();
+    test_file_output();
+    test_queues_cap();
+    test_error_handling();
+#endif
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All pipe output tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,363 @@
+/**
+ * @file test_binary_clock_present.c
+ * @brief Test suite for Binary Clock presentation scheduling
+ *
+ * Checks staging and committing of frames and the precision of the wait.
+ * On POSIX systems several child processes commit frames for the same
+ * presentation times, and the spread between their commits is measured.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_present.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/wait.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+// Generous bounds: shared CI runners are noisy, a quiet machine does far better
+#define WAIT_BOUND_US 5000
+#define SPREAD_BOUND_US 5000
+
+#define SPREAD_PROCESSES 4
+#define SPREAD_FRAMES 10
+#define SPREAD_INTERVAL_US 20000
+
+void test_wait_precision(void) {
+    printf("\n=== Testing Wait Precision ===\n");
+
+    int64_t worst = 0;
+    int early = 0;
+    for (int i = 0; i < 10; i++) {
+        int64_t target = binary_clock_present_now_us() + 5000;
+        int64_t woke = binary_clock_present_wait_until_us(target);
+        if (woke < target) {
+            early = 1;
+        }
+        if (woke - target > worst) {
+            worst = woke - target;
+        }
+    }
+    printf("  worst wake-up after target: %lld us\n", (long long)worst);
+    ASSERT_TRUE(!early, "wait never returns before the target");
+    ASSERT_TRUE(worst < WAIT_BOUND_US, "wait ends close to the target");
+
+    int64_t past = binary_clock_present_now_us() - 1000000;
+    ASSERT_TRUE(binary_clock_present_wait_until_us(past) >= past, "past target returns immediately");
+}
+
+void test_stage_and_commit(void) {
+    printf("\n=== Testing Stage and Commit ===\n");
+
+    time_components_t time_comp = {14, 30, 45};
+    binary_clock_state_t state = binary_clock_state_from_time(&time_comp);
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, -1);
+
+    ASSERT_EQ(binary_clock_presenter_commit(&presenter, NULL), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "commit without a staged frame rejected");
+    ASSERT_EQ(binary_clock_presenter_stage(&presenter, NULL, BINARY_CLOCK_RENDER_ASCII, NULL, 0),
+              BINARY_CLOCK_ERROR_NULL_POINTER, "NULL state rejected");
+
+    ASSERT_EQ(binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, "\033[H", 0),
+              BINARY_CLOCK_SUCCESS, "frame staged");
+    char expected[BINARY_CLOCK_RENDER_MAX_SIZE + 8] = "\033[H";
+    size_t rendered = binary_clock_display_render(&state, BINARY_CLOCK_RENDER_COMPACT, expected + 3, sizeof(expected) - 3);
+    ASSERT_TRUE(presenter.staged && presenter.length == rendered + 3 &&
+                memcmp(presenter.frame, expected, presenter.length) == 0, "staged frame is prefix plus rendered state");
+
+    ASSERT_EQ(binary_clock_presenter_commit(&presenter, NULL), BINARY_CLOCK_ERROR_OUTPUT,
+              "write failure reported");
+    ASSERT_TRUE(!presenter.staged && presenter.stats.commits == 0, "failed commit drops the frame");
+
+#ifndef _WIN32
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        ASSERT_TRUE(0, "pipe created");
+        return;
+    }
+    binary_clock_presenter_init(&presenter, pipe_fds[1]);
+
+    int64_t target = binary_clock_present_now_us() + 10000;
+    int64_t error_us = -1;
+    binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, "\033[H", target);
+    ASSERT_EQ(binary_clock_presenter_commit(&presenter, &error_us), BINARY_CLOCK_SUCCESS, "frame committed");
+    ASSERT_TRUE(error_us >= 0 && error_us < WAIT_BOUND_US, "commit error measured from the target");
+
+    char written[BINARY_CLOCK_PRESENT_FRAME_SIZE];
+    ssize_t got = read(pipe_fds[0], written, sizeof(written));
+    ASSERT_TRUE(got == (ssize_t)(rendered + 3) && memcmp(written, expected, (size_t)got) == 0,
+                "whole frame written at once");
+
+    binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, NULL,
+                                 binary_clock_present_now_us() - 1000);
+    binary_clock_presenter_commit(&presenter, NULL);
+    ASSERT_TRUE(presenter.stats.commits == 2 && presenter.stats.late == 1 &&
+                presenter.stats.max_error_us >= 1000, "late commit counted with its error");
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+#endif
+}
+
+void test_virtual_clock(void) {
+    printf("\n=== Testing Virtual Clock ===\n");
+
+    binary_clock_virtual_clock_t clock;
+    binary_clock_virtual_clock_init(&clock, 1000000000LL * 1000000, 0);
+    binary_clock_present_clock_t source = binary_clock_virtual_clock_source(&clock);
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, -1);
+    binary_clock_presenter_set_clock(&presenter, &source);
+
+    ASSERT_EQ(binary_clock_presenter_now_us(&presenter), 1000000000LL * 1000000, "presenter reads the virtual clock");
+
+    // A day of waits at full speed must finish in well under a real second
+    int64_t started = binary_clock_present_now_us();
+    int64_t target = clock.now_us;
+    for (int i = 0; i < 86400; i++) {
+        target += 1000000;
+        source.wait_until_us(target, source.context);
+    }
+    int64_t elapsed = binary_clock_present_now_us() - started;
+    ASSERT_EQ(binary_clock_presenter_now_us(&presenter), target, "wait advances the clock to the target");
+    ASSERT_TRUE(elapsed < 1000000, "full-speed waits take no real time");
+
+#ifndef _WIN32
+    int pipe_fds[2];
+    if (pipe(pipe_fds) == 0) {
+        time_components_t time_comp = {23, 59, 59};
+        binary_clock_state_t state = binary_clock_state_from_time(&time_comp);
+        int64_t error_us = -1;
+        presenter.fd = pipe_fds[1];
+        binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, NULL, target + 1000000);
+        binary_clock_presenter_commit(&presenter, &error_us);
+        ASSERT_TRUE(error_us == 0 && presenter.stats.late == 0, "commit lands exactly on virtual time");
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+    }
+#endif
+
+    // At 1000x a virtual second passes in about a real millisecond
+    binary_clock_virtual_clock_init(&clock, 0, 1000);
+    started = clock.real_origin_us;
+    int64_t reached = source.wait_until_us(1000000, source.context);
+    elapsed = binary_clock_present_now_us() - started;
+    ASSERT_TRUE(reached >= 1000000, "scaled wait reaches the target");
+    ASSERT_TRUE(elapsed >= 1000 && elapsed < 1000 + WAIT_BOUND_US, "scaled wait takes target / speed in real time");
+
+    binary_clock_presenter_set_clock(&presenter, NULL);
+    ASSERT_TRUE(binary_clock_presenter_now_us(&presenter) >= started, "NULL source restores the wall clock");
+}
+
+#ifndef _WIN32
+void test_backlog(void) {
+    printf("\n=== Testing Backlog Skipping ===\n");
+
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        ASSERT_TRUE(0, "pipe created");
+        return;
+    }
+    ASSERT_EQ(binary_clock_present_pending_output(pipe_fds[1]), 0, "empty pipe has nothing queued");
+    char filler[100];
+    memset(filler, 'x', sizeof(filler));
+    ASSERT_TRUE(write(pipe_fds[1], filler, sizeof(filler)) == (ssize_t)sizeof(filler), "backlog written");
+    ASSERT_EQ(binary_clock_present_pending_output(pipe_fds[1]), 100, "unread pipe contents are queued");
+    ASSERT_EQ(binary_clock_present_pending_output(-1), -1, "bad descriptor reports unknown");
+
+    char path[] = "/tmp/test_binary_clock_present_XXXXXX";
+    int file = mkstemp(path);
+    if (file >= 0) {
+        ASSERT_EQ(binary_clock_present_pending_output(file), -1, "regular file reports unknown");
+        close(file);
+        unlink(path);
+    }
+
+    binary_clock_virtual_clock_t clock;
+    binary_clock_virtual_clock_init(&clock, 1000000000LL * 1000000, 0);
+    binary_clock_present_clock_t source = binary_clock_virtual_clock_source(&clock);
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, pipe_fds[1]);
+    binary_clock_presenter_set_clock(&presenter, &source);
+    ASSERT_EQ(presenter.max_backlog, 0, "skipping is off by default");
+
+    time_components_t time_comp = {14, 30, 45};
+    binary_clock_state_t state = binary_clock_state_from_time(&time_comp);
+    int64_t target = clock.now_us + 1000000;
+    binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, NULL, target);
+    binary_clock_presenter_commit(&presenter, NULL);
+    size_t frame = presenter.length;
+    ASSERT_TRUE(presenter.stats.commits == 1 && presenter.stats.skipped == 0 &&
+                binary_clock_present_pending_output(pipe_fds[1]) == (long)(100 + frame),
+                "without a limit the frame queues behind the backlog");
+
+    presenter.max_backlog = 50;
+    int64_t error_us = -1;
+    target += 1000000;
+    binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, NULL, target);
+    ASSERT_EQ(binary_clock_presenter_commit(&presenter, &error_us), BINARY_CLOCK_SUCCESS, "skipped commit succeeds");
+    ASSERT_TRUE(presenter.stats.commits == 1 && presenter.stats.skipped == 1 && !presenter.staged,
+                "frame over the limit skipped and counted");
+    ASSERT_EQ(presenter.stats.last_backlog, (long)(100 + frame), "backlog at the skip recorded");
+    ASSERT_EQ(binary_clock_present_pending_output(pipe_fds[1]), (long)(100 + frame), "skipped frame not written");
+    ASSERT_EQ(error_us, 0, "skipped commit still waits for its time");
+
+    // Drained, the next frame goes out whole
+    char drain[BINARY_CLOCK_PRESENT_FRAME_SIZE + 100];
+    ASSERT_TRUE(read(pipe_fds[0], drain, sizeof(drain)) == (ssize_t)(100 + frame), "reader drains the pipe");
+    target += 1000000;
+    binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, NULL, target);
+    binary_clock_presenter_commit(&presenter, NULL);
+    ASSERT_TRUE(presenter.stats.commits == 2 && presenter.stats.skipped == 1 &&
+                binary_clock_present_pending_output(pipe_fds[1]) == (long)frame, "drained sink gets the next frame");
+    ASSERT_TRUE(read(pipe_fds[0], drain, sizeof(drain)) == (ssize_t)frame, "frame read back");
+
+    // A reader taking one frame for every three presented: the queue stays
+    // within the limit plus one frame, and two frames in three are skipped
+    binary_clock_presenter_init(&presenter, pipe_fds[1]);
+    binary_clock_presenter_set_clock(&presenter, &source);
+    presenter.max_backlog = frame;
+    long worst = 0;
+    for (int i = 0; i < 300; i++) {
+        target += 1000000;
+        binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_COMPACT, NULL, target);
+        binary_clock_presenter_commit(&presenter, NULL);
+        long pending = binary_clock_present_pending_output(pipe_fds[1]);
+        worst = pending > worst ? pending : worst;
+        if (i % 3 == 2 && read(pipe_fds[0], drain, frame) != (ssize_t)frame) {
+            break;
+        }
+    }
+    printf("  slow reader: %llu committed, %llu skipped, worst queue %ld bytes\n",
+           (unsigned long long)presenter.stats.commits, (unsigned long long)presenter.stats.skipped, worst);
+    ASSERT_EQ(presenter.stats.commits + presenter.stats.skipped, 300, "every frame committed or skipped");
+    ASSERT_TRUE(worst <= (long)(2 * frame), "queue bounded by the limit plus a frame");
+    ASSERT_TRUE(presenter.stats.skipped >= 150, "frames the reader cannot take are skipped");
+
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+}
+
+void test_commit_spread(void) {
+    printf("\n=== Testing Commit Spread (%d processes) ===\n", SPREAD_PROCESSES);
+
+    int result_fds[2];
+    if (pipe(result_fds) != 0) {
+        ASSERT_TRUE(0, "result pipe created");
+        return;
+    }
+
+    // Every process commits the same frames for the same presentation times
+    int64_t first_target = binary_clock_present_now_us() + 100000;
+    for (int p = 0; p < SPREAD_PROCESSES; p++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(result_fds[0]);
+            int sink = open("/dev/null", O_WRONLY);
+            binary_clock_presenter_t presenter;
+            binary_clock_presenter_init(&presenter, sink);
+            int64_t commits[SPREAD_FRAMES];
+
+            for (int frame = 0; frame < SPREAD_FRAMES; frame++) {
+                int64_t target = first_target + (int64_t)frame * SPREAD_INTERVAL_US;
+                binary_clock_state_t state = binary_clock_state_from_epoch(target / 1000000, 0);
+                int64_t error_us = 0;
+                binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_EMOJI, "\033[2J\033[H", target);
+                binary_clock_presenter_commit(&presenter, &error_us);
+                commits[frame] = target + error_us;
+            }
+            _exit(write(result_fds[1], commits, sizeof(commits)) == (ssize_t)sizeof(commits) ? 0 : 1);
+        }
+    }
+    close(result_fds[1]);
+
+    int64_t commits[SPREAD_PROCESSES][SPREAD_FRAMES];
+    int complete = 0;
+    for (int p = 0; p < SPREAD_PROCESSES; p++) {
+        if (read(result_fds[0], commits[p], sizeof(commits[p])) == (ssize_t)sizeof(commits[p])) {
+            complete++;
+        }
+    }
+    close(result_fds[0]);
+    while (wait(NULL) > 0) {
+    }
+    ASSERT_EQ(complete, SPREAD_PROCESSES, "every process reported its commits");
+    if (complete != SPREAD_PROCESSES) {
+        return;
+    }
+
+    int64_t worst_spread = 0;
+    int64_t total_spread = 0;
+    for (int frame = 0; frame < SPREAD_FRAMES; frame++) {
+        int64_t earliest = commits[0][frame];
+        int64_t latest = commits[0][frame];
+        for (int p = 1; p < SPREAD_PROCESSES; p++) {
+            earliest = commits[p][frame] < earliest ? commits[p][frame] : earliest;
+            latest = commits[p][frame] > latest ? commits[p][frame] : latest;
+        }
+        total_spread += latest - earliest;
+        worst_spread = latest - earliest > worst_spread ? latest - earliest : worst_spread;
+    }
+    printf("  commit spread: mean %lld us, worst %lld us\n",
+           (long long)(total_spread / SPREAD_FRAMES), (long long)worst_spread);
+    ASSERT_TRUE(worst_spread < SPREAD_BOUND_US, "processes commit each frame together");
+}
+#endif
+
+int main(void) {
+    printf("=== Binary Clock Presentation Test Suite ===\n");
+
+    test_wait_precision();
+    test_stage_and_commit();
+    test_virtual_clock();
+#ifndef _WIN32
+    test_backlog();
+    test_commit_spread();
+#endif
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All presentation tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
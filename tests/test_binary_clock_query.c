@@ -0,0 +1,527 @@
+/**
+ * @file test_binary_clock_query.c
+ * @brief Test suite for Binary Clock queries
+ *
+ * Covers request parsing, the sharded LRU response cache (hits, eviction
+ * order within a shard, the caches cap) and the responder's status codes
+ * and counters. On POSIX systems threads share one cache and a loopback
+ * client queries the server.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_query.h>
+#include <binary_clock_mem.h>
+
+#ifndef _WIN32
+    #include <pthread.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define QUERY_EPOCH 1700000000LL  // 2023-11-14 22:13:20 UTC
+
+static binary_clock_error_t parse(const char* target, binary_clock_query_request_t* request) {
+    return binary_clock_query_parse(target, strlen(target), request);
+}
+
+static size_t respond(binary_clock_query_t* query, const char* target, char* output, size_t size) {
+    size_t length = binary_clock_query_respond(query, target, strlen(target), output, size - 1);
+    output[length] = '\0';
+    return length;
+}
+
+void test_parse(void) {
+    printf("\n=== Testing Request Parsing ===\n");
+
+    binary_clock_query_request_t request;
+    ASSERT_EQ(parse("/at?t=1700000000", &request), BINARY_CLOCK_SUCCESS, "epoch alone parsed");
+    ASSERT_EQ(request.epoch, QUERY_EPOCH, "epoch value");
+    ASSERT_TRUE(strcmp(request.zone, "UTC") == 0, "zone defaults to UTC");
+    ASSERT_EQ(request.format, BINARY_CLOCK_RENDER_JSON, "format defaults to json");
+
+    ASSERT_EQ(parse("/at?fmt=binary&tz=Europe/Berlin&t=-86400", &request), BINARY_CLOCK_SUCCESS,
+              "parameters in any order");
+    ASSERT_EQ(request.epoch, -86400, "negative epoch");
+    ASSERT_TRUE(strcmp(request.zone, "Europe/Berlin") == 0, "zone name");
+    ASSERT_EQ(request.format, BINARY_CLOCK_RENDER_ASCII, "binary is the ASCII render");
+    parse("/at?t=0&tz=%2B05%3a30&fmt=ndjson&x=1", &request);
+    ASSERT_TRUE(strcmp(request.zone, "+05:30") == 0, "escapes decoded");
+    ASSERT_EQ(request.format, BINARY_CLOCK_RENDER_JSON_LINE, "ndjson format");
+    parse("/at?t=0&tz=+09:00", &request);
+    ASSERT_TRUE(strcmp(request.zone, "+09:00") == 0, "a literal plus is kept");
+
+    ASSERT_EQ(parse("/at?tz=UTC", &request), BINARY_CLOCK_ERROR_INVALID_TIME, "missing t rejected");
+    ASSERT_EQ(parse("/at?t=12x", &request), BINARY_CLOCK_ERROR_INVALID_TIME, "malformed t rejected");
+    ASSERT_EQ(parse("/at?t=99999999999999", &request), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "t past year 9999 rejected");
+    ASSERT_EQ(parse("/at?t=0&fmt=xml", &request), BINARY_CLOCK_ERROR_OUTPUT, "unknown format rejected");
+    ASSERT_EQ(parse("/at?t=0&tz=%zz", &request), BINARY_CLOCK_ERROR_OUTPUT, "bad escape rejected");
+    ASSERT_EQ(parse("/now?t=0", &request), BINARY_CLOCK_ERROR_OUTPUT, "other path rejected");
+    ASSERT_EQ(parse("/atx?t=0", &request), BINARY_CLOCK_ERROR_OUTPUT, "path prefix rejected");
+    char target[128] = "/at?t=0&tz=";
+    memset(target + strlen(target), 'A', 80);
+    ASSERT_EQ(parse(target, &request), BINARY_CLOCK_ERROR_OUTPUT, "overlong zone rejected");
+}
+
+// Put a key, returning the shard it landed in (its count or evictions grow)
+static int put_key(binary_clock_query_cache_t* cache, int64_t second) {
+    uint64_t before[BINARY_CLOCK_QUERY_CACHE_SHARDS];
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        before[i] = cache->shards[i].count + cache->shards[i].evictions;
+    }
+    char data[32];
+    int length = sprintf(data, "response %lld", (long long)second);
+    binary_clock_query_cache_put(cache, second, 0, 0, data, (size_t)length);
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        if (cache->shards[i].count + cache->shards[i].evictions != before[i]) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static bool cached(binary_clock_query_cache_t* cache, int64_t second) {
+    char data[64];
+    return binary_clock_query_cache_get(cache, second, 0, 0, data, sizeof(data)) > 0;
+}
+
+void test_cache(void) {
+    printf("\n=== Testing Response Cache ===\n");
+
+    binary_clock_mem_reset();
+    binary_clock_query_cache_t cache;
+    ASSERT_EQ(binary_clock_query_cache_init(&cache, 2 * BINARY_CLOCK_QUERY_CACHE_SHARDS), BINARY_CLOCK_SUCCESS,
+              "cache allocated");
+    ASSERT_EQ(binary_clock_query_cache_get_stats(&cache).capacity, 2 * BINARY_CLOCK_QUERY_CACHE_SHARDS,
+              "entries split over the shards");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_CACHES).used, cache.bytes, "cache charged to the caches");
+
+    char data[64];
+    binary_clock_query_cache_put(&cache, 5, 1, 2, "hello", 5);
+    size_t length = binary_clock_query_cache_get(&cache, 5, 1, 2, data, sizeof(data));
+    ASSERT_TRUE(length == 5 && memcmp(data, "hello", 5) == 0, "cached response returned");
+    ASSERT_EQ(binary_clock_query_cache_get(&cache, 5, 1, 3, data, sizeof(data)), 0, "format is part of the key");
+    ASSERT_EQ(binary_clock_query_cache_get(&cache, 5, 2, 2, data, sizeof(data)), 0, "zone is part of the key");
+    ASSERT_EQ(binary_clock_query_cache_get(&cache, 5, 1, 2, data, 3), 0, "too small a buffer is a miss");
+    binary_clock_query_cache_put(&cache, 5, 1, 2, "world", 5);
+    binary_clock_query_cache_get(&cache, 5, 1, 2, data, sizeof(data));
+    ASSERT_TRUE(memcmp(data, "world", 5) == 0, "put replaces an existing key");
+    binary_clock_query_cache_stats_t stats = binary_clock_query_cache_get_stats(&cache);
+    ASSERT_EQ(stats.hits, 2, "hits counted");
+    ASSERT_EQ(stats.misses, 3, "misses counted");
+    ASSERT_EQ(stats.entries, 1, "one entry held");
+    binary_clock_query_cache_free(&cache);
+
+    // Two entries per shard: the least recently used one of a shard goes
+    binary_clock_query_cache_init(&cache, 2 * BINARY_CLOCK_QUERY_CACHE_SHARDS);
+    int shard = put_key(&cache, 0);
+    int64_t keys[2] = {0, 0};
+    int found = 0;
+    for (int64_t second = 1; second < 10000 && found < 2; second++) {
+        if (put_key(&cache, second) == shard) {
+            keys[found++] = second;
+        }
+    }
+    ASSERT_EQ(found, 2, "keys sharing a shard found");
+    ASSERT_TRUE(!cached(&cache, 0), "oldest entry of a full shard evicted");
+    ASSERT_TRUE(cached(&cache, keys[0]) && cached(&cache, keys[1]), "newer entries kept");
+    cached(&cache, keys[0]);
+    int64_t third = keys[1] + 1;
+    while (put_key(&cache, third) != shard && third < keys[1] + 10000) {
+        third++;
+    }
+    ASSERT_TRUE(cached(&cache, keys[0]), "recently read entry kept");
+    ASSERT_TRUE(!cached(&cache, keys[1]), "least recently used entry evicted");
+    ASSERT_TRUE(cached(&cache, third), "new entry cached");
+    ASSERT_TRUE(binary_clock_query_cache_get_stats(&cache).evictions > 0, "evictions counted");
+    binary_clock_query_cache_free(&cache);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_CACHES).used, 0, "cache released on free");
+
+    // No cache: every lookup misses, puts are dropped
+    binary_clock_query_cache_init(&cache, 0);
+    binary_clock_query_cache_put(&cache, 5, 0, 0, "hello", 5);
+    ASSERT_EQ(binary_clock_query_cache_get(&cache, 5, 0, 0, data, sizeof(data)), 0, "zero entries caches nothing");
+    binary_clock_query_cache_free(&cache);
+
+    // Over the caches cap, fewer entries
+    binary_clock_mem_set_cap(BINARY_CLOCK_MEM_CACHES, 64 * 1024);
+    ASSERT_EQ(binary_clock_query_cache_init(&cache, 4096), BINARY_CLOCK_SUCCESS, "capped cache allocated");
+    stats = binary_clock_query_cache_get_stats(&cache);
+    ASSERT_TRUE(stats.capacity < 4096 && stats.capacity >= BINARY_CLOCK_QUERY_CACHE_SHARDS,
+                "capacity shrunk under the cap");
+    ASSERT_TRUE(cache.bytes <= 64 * 1024, "cache fits the cap");
+    binary_clock_query_cache_free(&cache);
+    binary_clock_mem_reset();
+}
+
+#ifndef _WIN32
+#define CACHE_THREADS 4
+#define CACHE_THREAD_ROUNDS 200000
+
+typedef struct {
+    binary_clock_query_cache_t* cache;
+    unsigned int seed;
+    int gets;
+    int hits;
+    int wrong;
+} cache_worker_t;
+
+// Put and get overlapping keys; a hit must hold the response of its key
+static void* cache_worker(void* arg) {
+    cache_worker_t* worker = arg;
+    for (int round = 0; round < CACHE_THREAD_ROUNDS; round++) {
+        worker->seed = worker->seed * 1103515245u + 12345u;
+        int64_t second = (int64_t)((worker->seed >> 16) % 256);
+        char expected[32];
+        int length = sprintf(expected, "response %lld", (long long)second);
+        char data[64];
+        size_t got = binary_clock_query_cache_get(worker->cache, second, 0, 0, data, sizeof(data));
+        worker->gets++;
+        if (got > 0) {
+            worker->hits++;
+            if (got != (size_t)length || memcmp(data, expected, got) != 0) {
+                worker->wrong++;
+            }
+        } else {
+            binary_clock_query_cache_put(worker->cache, second, 0, 0, expected, (size_t)length);
+        }
+    }
+    return NULL;
+}
+
+// Entries reachable from newest through the LRU list, -1 if it is broken
+static long lru_length(const binary_clock_query_shard_t* shard) {
+    long length = 0;
+    uint32_t newer = BINARY_CLOCK_QUERY_CACHE_NONE;
+    for (uint32_t index = shard->newest; index != BINARY_CLOCK_QUERY_CACHE_NONE;
+         index = shard->entries[index].older) {
+        if (index >= shard->count || shard->entries[index].newer != newer || ++length > (long)shard->count) {
+            return -1;
+        }
+        newer = index;
+    }
+    return newer == shard->oldest ? length : -1;
+}
+
+void test_cache_threads(void) {
+    printf("\n=== Testing Response Cache Across Threads ===\n");
+
+    binary_clock_query_cache_t cache;
+    binary_clock_query_cache_init(&cache, 2 * BINARY_CLOCK_QUERY_CACHE_SHARDS);
+    pthread_t threads[CACHE_THREADS];
+    cache_worker_t workers[CACHE_THREADS];
+    int started = 0;
+    for (int i = 0; i < CACHE_THREADS; i++) {
+        workers[i] = (cache_worker_t){&cache, (unsigned int)(i + 1) * 7919u, 0, 0, 0};
+        if (pthread_create(&threads[i], NULL, cache_worker, &workers[i]) == 0) {
+            started++;
+        }
+    }
+    ASSERT_EQ(started, CACHE_THREADS, "worker threads started");
+    int gets = 0;
+    int hits = 0;
+    int wrong = 0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        gets += workers[i].gets;
+        hits += workers[i].hits;
+        wrong += workers[i].wrong;
+    }
+
+    ASSERT_EQ(wrong, 0, "every hit holds the response of its key");
+    binary_clock_query_cache_stats_t stats = binary_clock_query_cache_get_stats(&cache);
+    ASSERT_EQ(stats.hits, (uint64_t)hits, "no hit lost across threads");
+    ASSERT_EQ(stats.hits + stats.misses, (uint64_t)gets, "every lookup counted once");
+    ASSERT_TRUE(stats.evictions > 0, "shards evicted while shared");
+    bool lists_whole = true;
+    for (int i = 0; i < BINARY_CLOCK_QUERY_CACHE_SHARDS; i++) {
+        lists_whole = lists_whole && lru_length(&cache.shards[i]) == (long)cache.shards[i].count;
+    }
+    ASSERT_TRUE(lists_whole, "every shard's LRU list intact");
+    binary_clock_query_cache_free(&cache);
+
+    // A freed cache has no locks to take: lookups miss, a second free is harmless
+    char data[64];
+    binary_clock_query_cache_put(&cache, 5, 0, 0, "hello", 5);
+    ASSERT_EQ(binary_clock_query_cache_get(&cache, 5, 0, 0, data, sizeof(data)), 0, "freed cache misses");
+    binary_clock_query_cache_free(&cache);
+}
+#endif
+
+void test_responder(void) {
+    printf("\n=== Testing Responder ===\n");
+
+    binary_clock_query_t query;
+    char response[BINARY_CLOCK_QUERY_RESPONSE_MAX_SIZE + 1];
+    ASSERT_EQ(binary_clock_query_init(&query, 256, "."), BINARY_CLOCK_SUCCESS, "responder initialized");
+    ASSERT_EQ(query.zone_count, 1, "UTC preloaded");
+
+    respond(&query, "/at?t=1700000000", response, sizeof(response));
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "query answered 200");
+    ASSERT_TRUE(strstr(response, "Content-Type: application/json\r\n") != NULL, "json content type");
+    ASSERT_TRUE(strstr(response, "\"time\": \"22:13:20\"") != NULL, "UTC time rendered");
+    char* body = strstr(response, "\r\n\r\n");
+    char length_header[64];
+    sprintf(length_header, "Content-Length: %lu\r\n", body != NULL ? (unsigned long)strlen(body + 4) : 0UL);
+    ASSERT_TRUE(strstr(response, length_header) != NULL, "content length matches the body");
+    ASSERT_EQ(query.stats.misses, 1, "first query rendered");
+
+    respond(&query, "/at?t=1700000000", response, sizeof(response));
+    ASSERT_TRUE(strstr(response, "22:13:20") != NULL, "repeat answered");
+    ASSERT_EQ(query.stats.hits, 1, "repeat served from the cache");
+
+    respond(&query, "/at?t=1700000000&tz=%2B09:00&fmt=binary", response, sizeof(response));
+    ASSERT_TRUE(strstr(response, "Time: 07:13:20") != NULL, "fixed zone applied");
+    ASSERT_TRUE(strstr(response, "text/plain; charset=utf-8") != NULL, "text content type");
+    ASSERT_EQ(query.zone_count, 2, "zone loaded on first use");
+    respond(&query, "/at?t=1700000000&tz=+09:00&fmt=binary", response, sizeof(response));
+    ASSERT_EQ(query.stats.hits, 2, "same zone shares cached responses");
+    size_t index = 0;
+    ASSERT_EQ(binary_clock_query_add_zone(&query, "+09:00", &index), BINARY_CLOCK_SUCCESS, "zone added again");
+    ASSERT_EQ(index, 1, "already loaded zone reused");
+
+    respond(&query, "/at?t=oops", response, sizeof(response));
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 400 Bad Request\r\n", 26) == 0, "bad query answered 400");
+    respond(&query, "/", response, sizeof(response));
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 404 Not Found\r\n", 24) == 0, "other path answered 404");
+    respond(&query, "/at?t=0&tz=No/Such_Zone", response, sizeof(response));
+    ASSERT_TRUE(strstr(response, "404 Not Found") != NULL && strstr(response, "unknown zone") != NULL,
+                "unknown zone answered 404");
+    ASSERT_EQ(query.stats.bad_requests, 1, "bad requests counted");
+    ASSERT_EQ(query.stats.not_found, 2, "not found counted");
+    ASSERT_EQ(query.stats.requests, 7, "every request timed");
+    ASSERT_EQ(binary_clock_query_respond(&query, "/at?t=0", 7, response, 16), 0, "too small a buffer refused");
+
+    uint64_t p50 = binary_clock_query_latency_percentile(&query.stats, 50);
+    uint64_t p99 = binary_clock_query_latency_percentile(&query.stats, 99);
+    ASSERT_TRUE(p50 > 0 && p50 <= p99, "latency percentiles ordered");
+    ASSERT_TRUE((p99 & (p99 - 1)) == 0, "percentiles are bucket bounds");
+    char report[BINARY_CLOCK_QUERY_REPORT_SIZE];
+    binary_clock_query_report(&query, report, sizeof(report));
+    ASSERT_TRUE(strstr(report, "8 requests, 40.0% cache hits") != NULL, "report shows requests and hit rate");
+    ASSERT_TRUE(strstr(report, "2 zones loaded") != NULL, "report shows zones");
+    binary_clock_query_free(&query);
+
+    // Every zone slot used
+    binary_clock_query_init(&query, 0, ".");
+    char name[16];
+    binary_clock_error_t error = BINARY_CLOCK_SUCCESS;
+    for (int i = 1; i <= BINARY_CLOCK_QUERY_MAX_ZONES && error == BINARY_CLOCK_SUCCESS; i++) {
+        sprintf(name, "+%02d:%02d", i / 4, (i % 4) * 15);
+        error = binary_clock_query_add_zone(&query, name, NULL);
+    }
+    ASSERT_EQ(error, BINARY_CLOCK_ERROR_OUTPUT, "zone table full");
+    ASSERT_EQ(query.zone_count, BINARY_CLOCK_QUERY_MAX_ZONES, "zones kept up to the limit");
+    respond(&query, "/at?t=0&tz=%2B16:00", response, sizeof(response));
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 503 Service Unavailable\r\n", 34) == 0 &&
+                strstr(response, "zone table full") != NULL, "new zone on a full table answered 503");
+    respond(&query, "/at?t=0&tz=%2B00:15", response, sizeof(response));
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "loaded zones still served when full");
+    ASSERT_TRUE(query.stats.unavailable == 1 && query.stats.not_found == 0, "503 counted apart from 404");
+    binary_clock_query_free(&query);
+
+    // Sealed: only preloaded zones, and requests never take a slot
+    binary_clock_query_init(&query, 0, ".");
+    binary_clock_query_add_zone(&query, "+09:00", NULL);
+    binary_clock_query_seal_zones(&query);
+    respond(&query, "/at?t=1700000000&tz=%2B09:00&fmt=binary", response, sizeof(response));
+    ASSERT_TRUE(strstr(response, "Time: 07:13:20") != NULL, "sealed table serves a preloaded zone");
+    for (int i = 1; i <= 2 * BINARY_CLOCK_QUERY_MAX_ZONES; i++) {
+        char target[64];
+        sprintf(target, "/at?t=0&tz=%%2B%02d:%02d", i / 4, (i % 4) * 15);
+        respond(&query, target, response, sizeof(response));
+    }
+    ASSERT_EQ(query.zone_count, 2, "requests load no zones into a sealed table");
+    respond(&query, "/at?t=0&tz=%2B01:00", response, sizeof(response));
+    ASSERT_TRUE(strstr(response, "404 Not Found") != NULL && strstr(response, "unknown zone") != NULL,
+                "zone not preloaded answered 404");
+    respond(&query, "/at?t=0", response, sizeof(response));
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "UTC always served");
+    index = 99;
+    ASSERT_EQ(binary_clock_query_resolve_zone(&query, "+09:00", &index), 200, "resolve finds a loaded zone");
+    ASSERT_EQ(index, 1, "resolve reports its index");
+    binary_clock_query_free(&query);
+}
+
+#ifndef _WIN32
+
+static int connect_client(uint16_t port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+// Poll the server until it closes the client, collecting the response
+static size_t read_until_closed(binary_clock_query_server_t* server, int fd, char* buffer, size_t size) {
+    size_t received = 0;
+    for (int round = 0; round < 200; round++) {
+        binary_clock_query_server_poll(server, 1);
+        ssize_t got = recv(fd, buffer + received, size - 1 - received, 0);
+        if (got == 0) {
+            break;
+        }
+        if (got > 0) {
+            received += (size_t)got;
+        }
+    }
+    buffer[received] = '\0';
+    return received;
+}
+
+void test_server(void) {
+    printf("\n=== Testing Loopback Server ===\n");
+
+    binary_clock_query_t query;
+    binary_clock_query_init(&query, 64, ".");
+    binary_clock_query_server_t server;
+    if (binary_clock_query_server_open(&server, &query, "127.0.0.1", 0) != BINARY_CLOCK_SUCCESS) {
+        printf("  (skipped: cannot listen on loopback)\n");
+        binary_clock_query_free(&query);
+        return;
+    }
+    ASSERT_TRUE(server.port != 0, "ephemeral port bound");
+
+    char response[4096];
+    int fd = connect_client(server.port);
+    const char request[] = "GET /at?t=1700000000&fmt=ndjson HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    // Sent in two pieces: nothing is answered before the head is complete
+    send(fd, request, 20, 0);
+    binary_clock_query_server_poll(&server, 10);
+    binary_clock_query_server_poll(&server, 10);
+    ASSERT_EQ(query.stats.requests, 0, "partial head not answered");
+    send(fd, request + 20, sizeof(request) - 1 - 20, 0);
+    read_until_closed(&server, fd, response, sizeof(response));
+    close(fd);
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 200 OK\r\n", 17) == 0, "query answered over HTTP");
+    ASSERT_TRUE(strstr(response, "{\"timestamp\":1700000000,\"time\":\"22:13:20\"") != NULL, "ndjson body sent");
+
+    fd = connect_client(server.port);
+    const char post[] = "POST /at?t=0 HTTP/1.1\r\n\r\n";
+    send(fd, post, sizeof(post) - 1, 0);
+    read_until_closed(&server, fd, response, sizeof(response));
+    close(fd);
+    ASSERT_TRUE(strncmp(response, "HTTP/1.1 400 Bad Request\r\n", 26) == 0, "other methods answered 400");
+
+    // Several clients at once, each closed after its answer
+    int fds[8];
+    for (int i = 0; i < 8; i++) {
+        fds[i] = connect_client(server.port);
+        char target[96];
+        int length = sprintf(target, "GET /at?t=%d&tz=-05:00 HTTP/1.0\r\n\r\n", 3600 * i);
+        send(fds[i], target, (size_t)length, 0);
+    }
+    int answered = 0;
+    for (int i = 0; i < 8; i++) {
+        read_until_closed(&server, fds[i], response, sizeof(response));
+        char time[32];
+        sprintf(time, "\"time\": \"%02d:00:00\"", (19 + i) % 24);
+        answered += strstr(response, time) != NULL;
+        close(fds[i]);
+    }
+    ASSERT_EQ(answered, 8, "concurrent clients answered");
+    for (int round = 0; round < 10; round++) {
+        binary_clock_query_server_poll(&server, 1);
+    }
+    ASSERT_EQ(server.connection_count, 0, "answered connections closed");
+    ASSERT_TRUE(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_QUEUES).used > 0, "connection slots charged");
+
+    binary_clock_query_server_close(&server);
+    ASSERT_EQ(server.listen_fd, -1, "server closed");
+    binary_clock_query_free(&query);
+}
+
+#endif
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_query_request_t request;
+    char output[16];
+    ASSERT_EQ(binary_clock_query_parse(NULL, 0, &request), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL target rejected");
+    ASSERT_EQ(binary_clock_query_parse("/at?t=0", 7, NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL request rejected");
+    ASSERT_EQ(binary_clock_query_init(NULL, 0, NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL responder rejected");
+    ASSERT_EQ(binary_clock_query_cache_init(NULL, 0), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL cache rejected");
+    ASSERT_EQ(binary_clock_query_respond(NULL, "/at?t=0", 7, output, sizeof(output)), 0, "NULL responder answers nothing");
+    ASSERT_EQ(binary_clock_query_latency_percentile(NULL, 50), 0, "NULL stats have no latency");
+    ASSERT_EQ(binary_clock_query_report(NULL, output, sizeof(output)), 0, "NULL responder has no report");
+    binary_clock_query_server_t server;
+    ASSERT_EQ(binary_clock_query_server_open(&server, NULL, "127.0.0.1", 0), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "server needs a responder");
+    ASSERT_EQ(binary_clock_query_server_poll(NULL, 0), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL server rejected");
+    binary_clock_query_cache_free(NULL);
+    binary_clock_query_free(NULL);
+    binary_clock_query_server_close(NULL);
+}
+
+int main(void) {
+    printf("=== Binary Clock Query Test Suite ===\n");
+
+    test_parse();
+    test_cache();
+#ifndef _WIN32
+    test_cache_threads();
+#endif
+    test_responder();
+#ifndef _WIN32
+    test_server();
+#endif
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All query tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,284 @@
+/**
+ * @file test_binary_clock_sim.c
+ * @brief Test suite for Binary Clock fleet simulation
+ *
+ * Every clock is checked against the core API: a clock with drift rate r
+ * shows, after n steps, the time n + floor(n * r / 2^32) seconds past its
+ * start. Ranges start off vector boundaries so both kernels are covered.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_sim.h>
+#include <binary_clock_mem.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define BASE_EPOCH 1700000000LL  // 22:13:20 UTC
+
+// LEDs the core API gives for a clock of this layout
+static uint32_t expected_leds(int64_t epoch, int32_t offset, uint8_t layout) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, offset);
+    uint32_t leds = binary_clock_pack_state(&state);
+    if (layout & BINARY_CLOCK_SIM_12_HOUR) {
+        uint32_t hours = (uint32_t)state.hours_tens.decimal_value * 10 + state.hours_units.decimal_value;
+        uint32_t shown = hours % 12 == 0 ? 12 : hours % 12;
+        leds = (leds & 0x00FFFFu) | (shown / 10) << 20 | (shown % 10) << 16;
+        if (hours >= 12) {
+            leds |= BINARY_CLOCK_SIM_PM_BIT;
+        }
+    }
+    return leds;
+}
+
+// Seconds a clock has advanced after steps reference seconds
+static int64_t advanced(int32_t rate, int64_t steps) {
+    int64_t drift = steps * rate;
+    int64_t whole = drift / 4294967296LL;
+    if (drift % 4294967296LL < 0) {
+        whole--;
+    }
+    return steps + whole;
+}
+
+static uint32_t bit_count(uint32_t x) {
+    uint32_t count = 0;
+    for (; x != 0; x &= x - 1) {
+        count++;
+    }
+    return count;
+}
+
+typedef struct {
+    int32_t offset;
+    double drift_ppm;
+    uint8_t layout;
+} clock_spec_t;
+
+static clock_spec_t spec_of(size_t i) {
+    static const double drifts[] = {0.0, 20.0, -20.0, 1000.0, -1000.0, 250000.0, -250000.0, 400000.0, -400000.0};
+    clock_spec_t spec;
+    spec.offset = (int32_t)((i * 7919) % 86400) - 43200;
+    spec.drift_ppm = drifts[i % (sizeof(drifts) / sizeof(drifts[0]))];
+    spec.layout = (uint8_t)(i / 3 % 4);
+    return spec;
+}
+
+// Fleet clocks and their references agree after steps
+static int check_fleet(const binary_clock_sim_t* sim, int64_t steps) {
+    int mismatches = 0;
+    for (size_t i = 0; i < sim->count; i++) {
+        clock_spec_t spec = spec_of(i);
+        uint32_t want = expected_leds(BASE_EPOCH + advanced(sim->rate[i], steps), spec.offset, spec.layout);
+        mismatches += sim->leds[i] != want;
+    }
+    return mismatches;
+}
+
+void test_fleet_against_reference(void) {
+    printf("\n=== Testing Fleet Against Reference ===\n");
+
+    binary_clock_sim_t sim;
+    ASSERT_EQ(binary_clock_sim_init(&sim, 1001, true), BINARY_CLOCK_SUCCESS, "fleet allocated");
+    ASSERT_EQ(sim.capacity % BINARY_CLOCK_SIM_SHARD_ALIGN, 0, "capacity a whole number of shards");
+    ASSERT_TRUE(((size_t)sim.leds | (size_t)sim.phase | (size_t)sim.rate | (size_t)sim.changed |
+                 (size_t)sim.toggles | (size_t)sim.lit | (size_t)sim.layout) % 64 == 0,
+                "arrays start on cache lines");
+    int failures = 0;
+    for (size_t i = 0; i < sim.count; i++) {
+        clock_spec_t spec = spec_of(i);
+        failures += binary_clock_sim_set_clock(&sim, i, BASE_EPOCH, spec.offset, spec.drift_ppm, spec.layout) !=
+                    BINARY_CLOCK_SUCCESS;
+    }
+    ASSERT_EQ(failures, 0, "every clock set");
+    ASSERT_EQ(check_fleet(&sim, 0), 0, "clocks start at their own time");
+    ASSERT_TRUE(sim.rate[1] > 0 && sim.rate[2] < 0 && sim.rate[0] == 0, "drift converted to signed rates");
+
+    binary_clock_sim_step(&sim);
+    ASSERT_EQ(check_fleet(&sim, 1), 0, "one step");
+    binary_clock_sim_step_range(&sim, 0, sim.count, 59);
+    ASSERT_EQ(check_fleet(&sim, 60), 0, "minute boundaries");
+    binary_clock_sim_step_range(&sim, 0, sim.count, 3600 * 25 - 60);
+    ASSERT_EQ(check_fleet(&sim, 3600 * 25), 0, "a day and an hour, through noon and midnight");
+
+    // Stepping in pieces that split vectors gives the same clocks
+    binary_clock_sim_step_range(&sim, 0, 3, 100);
+    binary_clock_sim_step_range(&sim, 3, 514, 100);
+    binary_clock_sim_step_range(&sim, 517, 10000, 100);
+    ASSERT_EQ(check_fleet(&sim, 3600 * 25 + 100), 0, "unaligned ranges");
+    binary_clock_sim_free(&sim);
+}
+
+void test_every_second(void) {
+    printf("\n=== Testing Every Second ===\n");
+
+    // Two undrifted days in each layout, one step at a time, in both kernels
+    binary_clock_sim_t sim;
+    binary_clock_sim_init(&sim, 10, false);
+    for (size_t i = 0; i < sim.count; i++) {
+        binary_clock_sim_set_clock(&sim, i, 0, 0, 0.0, (uint8_t)(i % 2));
+    }
+    int next_mismatch = 0, layout_mismatch = 0;
+    for (int64_t second = 1; second <= 2 * 86400; second++) {
+        uint32_t previous = sim.leds[0];
+        binary_clock_sim_step(&sim);
+        next_mismatch += sim.leds[0] != binary_clock_packed_next_second(previous);
+        for (size_t i = 0; i < sim.count; i++) {
+            layout_mismatch += sim.leds[i] != expected_leds(second, 0, (uint8_t)(i % 2));
+        }
+    }
+    ASSERT_EQ(next_mismatch, 0, "24-hour clocks follow binary_clock_packed_next_second()");
+    ASSERT_EQ(layout_mismatch, 0, "every second of both layouts in both kernels");
+    binary_clock_sim_free(&sim);
+}
+
+void test_changed_masks(void) {
+    printf("\n=== Testing Changed Masks ===\n");
+
+    binary_clock_sim_t sim;
+    binary_clock_sim_init(&sim, 8, true);
+    // 11:59:59 so the next step carries through every digit and flips PM
+    int64_t epoch = 11 * 3600 + 59 * 60 + 59;
+    for (size_t i = 0; i < sim.count; i++) {
+        binary_clock_sim_set_clock(&sim, i, epoch, 0, 0.0, (uint8_t)(i % 4));
+    }
+    binary_clock_sim_step(&sim);
+    ASSERT_EQ(sim.changed[0], 0x115959 ^ 0x120000, "24-hour carry into the hours");
+    ASSERT_EQ(sim.changed[1], (0x115959 ^ 0x120000) | BINARY_CLOCK_SIM_PM_BIT, "12-hour clock lights PM at noon");
+    ASSERT_EQ(sim.changed[2], (0x115959 ^ 0x120000) & 0xFFFF00, "seconds hidden");
+    ASSERT_EQ(sim.changed[5], sim.changed[1], "second vector lane");
+    ASSERT_EQ(sim.leds[1], 0x120000 | BINARY_CLOCK_SIM_PM_BIT, "12:00:00 PM");
+    ASSERT_EQ(sim.toggles[0], bit_count(0x115959 ^ 0x120000), "toggles counted");
+    ASSERT_EQ(sim.lit[0], bit_count(0x120000), "lit LEDs counted");
+    ASSERT_EQ(sim.lit[3], bit_count(0x120000) + 1, "lit PM LED counted");
+
+    binary_clock_sim_step(&sim);
+    ASSERT_EQ(sim.changed[0], 1, "one LED on the next second");
+    ASSERT_EQ(sim.changed[2], 0, "no visible change without seconds");
+    ASSERT_EQ(sim.toggles[2], bit_count((0x115959 ^ 0x120000) & 0xFFFF00), "hidden LEDs never counted");
+
+    // 12-hour clocks go 12:59:59 -> 01:00:00 and 11:59:59 PM -> 12:00:00 AM
+    binary_clock_sim_set_clock(&sim, 1, 12 * 3600 + 59 * 60 + 59, 0, 0.0, BINARY_CLOCK_SIM_12_HOUR);
+    binary_clock_sim_set_clock(&sim, 5, 23 * 3600 + 59 * 60 + 59, 0, 0.0, BINARY_CLOCK_SIM_12_HOUR);
+    binary_clock_sim_step(&sim);
+    ASSERT_EQ(sim.leds[1], 0x010000 | BINARY_CLOCK_SIM_PM_BIT, "01:00:00 PM after 12:59:59 PM");
+    ASSERT_EQ(sim.leds[5], 0x120000, "12:00:00 AM at midnight");
+
+    // A fast clock jumps two seconds, a slow one holds still
+    binary_clock_sim_set_clock(&sim, 0, 59, 0, 400000.0, BINARY_CLOCK_SIM_24_HOUR);
+    binary_clock_sim_set_clock(&sim, 4, 59, 0, -400000.0, BINARY_CLOCK_SIM_24_HOUR);
+    binary_clock_sim_step_range(&sim, 0, sim.count, 3);
+    ASSERT_EQ(sim.leds[0], expected_leds(59 + 4, 0, 0), "fast clock gained a second in three");
+    ASSERT_EQ(sim.leds[4], expected_leds(59 + 1, 0, 0), "slow clock lost two seconds in three");
+    binary_clock_sim_free(&sim);
+}
+
+void test_sharding(void) {
+    printf("\n=== Testing Sharding ===\n");
+
+    binary_clock_sim_t sim;
+    binary_clock_sim_init(&sim, 1000, false);
+    static const unsigned shard_counts[] = {1, 3, 8, 100};
+    for (size_t c = 0; c < sizeof(shard_counts) / sizeof(shard_counts[0]); c++) {
+        unsigned shards = shard_counts[c];
+        size_t covered = 0;
+        int aligned = 1;
+        for (unsigned shard = 0; shard < shards; shard++) {
+            size_t first, count;
+            binary_clock_sim_shard(&sim, shard, shards, &first, &count);
+            if (count > 0) {
+                aligned &= first == covered && first % BINARY_CLOCK_SIM_SHARD_ALIGN == 0;
+                covered += count;
+            }
+        }
+        char message[64];
+        snprintf(message, sizeof(message), "%u shards cover the fleet in order", shards);
+        ASSERT_TRUE(covered == sim.count && aligned, message);
+    }
+    size_t first = 1, count = 1;
+    binary_clock_sim_shard(&sim, 5, 5, &first, &count);
+    ASSERT_TRUE(first == 0 && count == 0, "shard past the end is empty");
+    binary_clock_sim_free(&sim);
+}
+
+void test_memory_and_errors(void) {
+    printf("\n=== Testing Memory and Errors ===\n");
+
+    binary_clock_mem_reset();
+    binary_clock_sim_t sim;
+    binary_clock_sim_init(&sim, 4096, true);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_REGISTRY).used, sim.bytes, "fleet charged to registry");
+    ASSERT_TRUE(sim.bytes >= 4096 * 25, "25 bytes per accumulating clock");
+    binary_clock_sim_free(&sim);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_REGISTRY).used, 0, "charge released on free");
+    binary_clock_sim_init(&sim, 4096, false);
+    ASSERT_TRUE(sim.toggles == NULL && sim.lit == NULL, "no counters unless accumulating");
+    binary_clock_sim_step(&sim);
+    ASSERT_EQ(sim.leds[4095], 0x000001, "clocks start at midnight without drift");
+
+    ASSERT_EQ(binary_clock_sim_init(NULL, 1, false), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL fleet");
+    ASSERT_EQ(binary_clock_sim_set_clock(NULL, 0, 0, 0, 0.0, 0), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL set");
+    ASSERT_EQ(binary_clock_sim_set_clock(&sim, 4096, 0, 0, 0.0, 0), BINARY_CLOCK_ERROR_INVALID_TIME, "index past the end");
+    ASSERT_EQ(binary_clock_sim_set_clock(&sim, 0, 0, 0, 500000.0, 0), BINARY_CLOCK_ERROR_INVALID_TIME, "drift too large");
+    ASSERT_EQ(binary_clock_sim_set_clock(&sim, 0, 0, 0, 0.0 / 0.0, 0), BINARY_CLOCK_ERROR_INVALID_TIME, "NaN drift");
+    ASSERT_EQ(binary_clock_sim_set_clock(&sim, 0, 0, 0, 0.0, 0x80), BINARY_CLOCK_ERROR_INVALID_TIME, "unknown layout");
+    ASSERT_EQ(binary_clock_sim_state(&sim, 4096, 1).timestamp, 0, "state past the end");
+    binary_clock_state_t state = binary_clock_sim_state(&sim, 7, 42);
+    ASSERT_TRUE(state.timestamp == 42 && state.seconds_units.decimal_value == 1, "state of a clock");
+    binary_clock_sim_step_range(&sim, 5000, 10, 1);
+    binary_clock_sim_step_range(NULL, 0, 10, 1);
+    binary_clock_sim_free(&sim);
+    binary_clock_sim_free(&sim);
+    binary_clock_sim_step(&sim);
+    ASSERT_TRUE(sim.block == NULL, "out-of-range, NULL and freed fleets ignored");
+}
+
+int main(void) {
+    printf("=== Binary Clock Fleet Simulation Test Suite ===\n");
+
+    test_fleet_against_reference();
+    test_every_second();
+    test_changed_masks();
+    test_sharding();
+    test_memory_and_errors();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All fleet simulation tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
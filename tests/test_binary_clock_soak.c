@@ -0,0 +1,179 @@
+/**
+ * @file test_binary_clock_soak.c
+ * @brief Test suite for Binary Clock soak checking
+ *
+ * Frames rendered in every format must parse back to the state they show,
+ * and the checker must catch malformed, wrong, skipped and duplicated
+ * frames while counting rollovers and UTC offset changes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_soak.h>
+#include <binary_clock_display.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+// 2023-11-14 23:59:58 UTC
+#define BASE_EPOCH 1700006398LL
+
+// Render the frame for an epoch second, screen-clear prefix included
+static size_t render_frame(int64_t epoch, int32_t offset, binary_clock_render_format_t format, char* frame) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, offset);
+    memcpy(frame, "\033[2J\033[H", 7);
+    return 7 + binary_clock_display_render(&state, format, frame + 7, BINARY_CLOCK_RENDER_MAX_SIZE);
+}
+
+void test_parse_frame(void) {
+    printf("\n=== Testing Frame Parsing ===\n");
+
+    static const binary_clock_render_format_t formats[] = {
+        BINARY_CLOCK_RENDER_EMOJI, BINARY_CLOCK_RENDER_ASCII, BINARY_CLOCK_RENDER_COMPACT,
+        BINARY_CLOCK_RENDER_JSON, BINARY_CLOCK_RENDER_JSON_LINE, BINARY_CLOCK_RENDER_EMOJI_LINE
+    };
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE + 8];
+    int parsed_all = 1;
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        for (int64_t epoch = BASE_EPOCH; epoch < BASE_EPOCH + 86400; epoch += 997) {
+            size_t length = render_frame(epoch, 0, formats[f], frame);
+            binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+            uint32_t packed = 0;
+            int64_t timestamp = 0;
+            if (!binary_clock_soak_parse_frame(frame, length, &packed, &timestamp) ||
+                packed != binary_clock_pack_state(&state)) {
+                parsed_all = 0;
+            }
+        }
+    }
+    ASSERT_TRUE(parsed_all, "every format parses back to its state");
+
+    uint32_t packed = 0;
+    int64_t timestamp = 0;
+    size_t length = render_frame(BASE_EPOCH, 0, BINARY_CLOCK_RENDER_JSON, frame);
+    binary_clock_soak_parse_frame(frame, length, &packed, &timestamp);
+    ASSERT_EQ(timestamp, BASE_EPOCH, "JSON timestamp read back");
+    length = render_frame(BASE_EPOCH, 0, BINARY_CLOCK_RENDER_EMOJI, frame);
+    binary_clock_soak_parse_frame(frame, length, &packed, &timestamp);
+    ASSERT_EQ(timestamp, -1, "emoji frame has no timestamp");
+    ASSERT_EQ(packed, 0x235958, "emoji frame shows 23:59:58");
+
+    ASSERT_TRUE(!binary_clock_soak_parse_frame(frame, length - 10, &packed, NULL), "truncated frame rejected");
+    ASSERT_TRUE(!binary_clock_soak_parse_frame("hello", 5, &packed, NULL), "frame without a time rejected");
+    ASSERT_TRUE(!binary_clock_soak_parse_frame(NULL, 0, &packed, NULL), "NULL frame rejected");
+
+    // Bits that disagree with the text
+    length = render_frame(BASE_EPOCH, 0, BINARY_CLOCK_RENDER_COMPACT, frame);
+    char* last_bit = frame + length - 1;
+    while (*last_bit != '0' && *last_bit != '1') {
+        last_bit--;
+    }
+    *last_bit = *last_bit == '0' ? '1' : '0';
+    ASSERT_TRUE(!binary_clock_soak_parse_frame(frame, length, &packed, NULL), "bits contradicting the text rejected");
+}
+
+void test_check_stream(void) {
+    printf("\n=== Testing Stream Checks ===\n");
+
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE + 8];
+    binary_clock_soak_t soak;
+    binary_clock_soak_init(&soak);
+
+    // Clean run across midnight
+    int clean = 1;
+    for (int64_t epoch = BASE_EPOCH; epoch < BASE_EPOCH + 10; epoch++) {
+        size_t length = render_frame(epoch, 0, BINARY_CLOCK_RENDER_JSON_LINE, frame);
+        clean &= binary_clock_soak_check_frame(&soak, frame, length, epoch, 0);
+    }
+    ASSERT_TRUE(clean && binary_clock_soak_passed(&soak), "clean stream passes");
+    ASSERT_EQ(soak.stats.frames, 10, "frames counted");
+    ASSERT_EQ(soak.stats.rollovers, 1, "midnight rollover counted");
+
+    // Skipped seconds
+    int64_t epoch = BASE_EPOCH + 13;
+    size_t length = render_frame(epoch, 0, BINARY_CLOCK_RENDER_JSON_LINE, frame);
+    ASSERT_TRUE(!binary_clock_soak_check_frame(&soak, frame, length, epoch, 0), "gap fails the frame");
+    ASSERT_EQ(soak.stats.skipped, 3, "skipped seconds counted");
+    ASSERT_EQ(soak.first_failure_epoch, epoch, "first failure recorded");
+
+    // Duplicate second
+    binary_clock_soak_check_frame(&soak, frame, length, epoch, 0);
+    ASSERT_EQ(soak.stats.duplicated, 1, "duplicated second counted");
+
+    // Right order, wrong content
+    length = render_frame(epoch, 0, BINARY_CLOCK_RENDER_JSON_LINE, frame);
+    binary_clock_soak_check_frame(&soak, frame, length, epoch + 1, 0);
+    ASSERT_EQ(soak.stats.mismatched, 1, "stale frame counted as mismatched");
+
+    binary_clock_soak_check_frame(&soak, "garbage", 7, epoch + 2, 0);
+    ASSERT_EQ(soak.stats.malformed, 1, "malformed frame counted");
+    ASSERT_TRUE(!binary_clock_soak_passed(&soak), "failed stream reported");
+    ASSERT_TRUE(strstr(soak.first_failure, "never presented") != NULL, "first failure kept over later ones");
+}
+
+void test_offset_change(void) {
+    printf("\n=== Testing UTC Offset Changes ===\n");
+
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE + 8];
+    binary_clock_soak_t soak;
+    binary_clock_soak_init(&soak);
+
+    // Clocks go back an hour: 01:59:59 +01:00 is followed by 01:00:00 +00:00
+    int64_t change = BASE_EPOCH + 2 + 3600;
+    int passed = 1;
+    for (int64_t epoch = change - 5; epoch < change + 5; epoch++) {
+        int32_t offset = epoch < change ? 3600 : 0;
+        size_t length = render_frame(epoch, offset, BINARY_CLOCK_RENDER_ASCII, frame);
+        passed &= binary_clock_soak_check_frame(&soak, frame, length, epoch, offset);
+    }
+    ASSERT_TRUE(passed, "repeated hour across a DST change passes");
+    ASSERT_EQ(soak.stats.offset_changes, 1, "offset change counted");
+    ASSERT_EQ(soak.stats.rollovers, 0, "offset change is not a rollover");
+}
+
+int main(void) {
+    printf("=== Binary Clock Soak Checker Test Suite ===\n");
+
+    test_parse_frame();
+    test_check_stream();
+    test_offset_change();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All soak checker tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,208 @@
+/**
+ * @file test_binary_clock_spec.c
+ * @brief Test suite for the generated spec serializers
+ *
+ * Round-trips every second of a day through the record and JSON codecs,
+ * and checks that decoders reject what the spec's constraints forbid
+ * without touching their output.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_spec.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+// 14:30:45 UTC
+#define BASE_EPOCH 1700058645LL
+#define DAY_START (BASE_EPOCH - (14 * 3600 + 30 * 60 + 45))
+
+void test_sizes(void) {
+    printf("\n=== Testing Generated Sizes ===\n");
+
+    ASSERT_EQ(BINARY_CLOCK_SPEC_BINARY_VALUE_RECORD_SIZE, 3, "binary value record is 3 bytes");
+    ASSERT_EQ(BINARY_CLOCK_SPEC_STATE_RECORD_SIZE, 6 * 3 + 8, "state record is six values and a timestamp");
+    ASSERT_EQ(BINARY_CLOCK_SPEC_TIME_COMPONENTS_HOURS_MAX, 23, "hours constraint from the spec");
+    ASSERT_EQ(BINARY_CLOCK_SPEC_STATE_HOURS_TENS_BIT_COUNT, 3, "hours tens bit count from the spec");
+    ASSERT_TRUE(BINARY_CLOCK_SPEC_BUDGET_NS_TO_BINARY >= BINARY_CLOCK_SPEC_TYPICAL_NS_TO_BINARY,
+                "budget is at least the typical time");
+}
+
+void test_round_trip(void) {
+    printf("\n=== Testing Round Trips ===\n");
+
+    int record_ok = 0;
+    int json_ok = 0;
+    size_t longest = 0;
+    for (int64_t epoch = DAY_START; epoch < DAY_START + 86400; epoch++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+        binary_clock_state_t decoded;
+
+        uint8_t record[BINARY_CLOCK_SPEC_STATE_RECORD_SIZE];
+        size_t length = binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+        memset(&decoded, 0xff, sizeof(decoded));
+        if (length == sizeof(record) &&
+            binary_clock_spec_decode_state_record(record, length, &decoded) == BINARY_CLOCK_SUCCESS &&
+            memcmp(&decoded, &state, sizeof(state)) == 0) {
+            record_ok++;
+        }
+
+        char json[BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE];
+        length = binary_clock_spec_encode_state_json(&state, json, sizeof(json));
+        longest = length > longest ? length : longest;
+        memset(&decoded, 0xff, sizeof(decoded));
+        if (length > 0 && binary_clock_spec_decode_state_json(json, length, &decoded) == BINARY_CLOCK_SUCCESS &&
+            memcmp(&decoded, &state, sizeof(state)) == 0) {
+            json_ok++;
+        }
+    }
+    ASSERT_EQ(record_ok, 86400, "every second of a day round-trips as a record");
+    ASSERT_EQ(json_ok, 86400, "every second of a day round-trips as JSON");
+    ASSERT_TRUE(longest <= BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE, "JSON stays within its maximum size");
+
+    time_components_t time = {14, 30, 45};
+    time_components_t decoded_time;
+    char json[BINARY_CLOCK_SPEC_TIME_COMPONENTS_JSON_MAX_SIZE + 1];
+    size_t length = binary_clock_spec_encode_time_components_json(&time, json, sizeof(json));
+    json[length] = '\0';
+    ASSERT_TRUE(strcmp(json, "{\"hours\":14,\"minutes\":30,\"seconds\":45}") == 0, "time components JSON text");
+    ASSERT_EQ(binary_clock_spec_decode_time_components_json(json, length, &decoded_time), BINARY_CLOCK_SUCCESS,
+              "time components JSON decodes");
+    ASSERT_TRUE(decoded_time.hours == 14 && decoded_time.minutes == 30 && decoded_time.seconds == 45,
+                "time components JSON round-trips");
+
+    binary_value_t value = binary_clock_to_binary(5, 3);
+    binary_value_t decoded_value;
+    uint8_t record[BINARY_CLOCK_SPEC_BINARY_VALUE_RECORD_SIZE];
+    ASSERT_EQ(binary_clock_spec_encode_binary_value_record(&value, record, sizeof(record)), 3,
+              "binary value record written");
+    ASSERT_EQ(record[1], 0x28, "bits packed most significant first");
+    ASSERT_EQ(binary_clock_spec_decode_binary_value_record(record, sizeof(record), &decoded_value), BINARY_CLOCK_SUCCESS,
+              "binary value record decodes");
+    ASSERT_TRUE(memcmp(&decoded_value, &value, sizeof(value)) == 0, "binary value record round-trips");
+}
+
+void test_constraints(void) {
+    printf("\n=== Testing Constraint Checks ===\n");
+
+    time_components_t time = {9, 9, 9};
+    uint8_t record[BINARY_CLOCK_SPEC_STATE_RECORD_SIZE] = {24, 0, 0};
+    ASSERT_EQ(binary_clock_spec_decode_time_components_record(record, 3, &time), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "hour 24 rejected");
+    ASSERT_EQ(time.hours, 9, "output untouched on error");
+
+    const char* minutes = "{\"hours\":12,\"minutes\":60,\"seconds\":0}";
+    ASSERT_EQ(binary_clock_spec_decode_time_components_json(minutes, strlen(minutes), &time),
+              BINARY_CLOCK_ERROR_INVALID_TIME, "minute 60 rejected in JSON");
+
+    binary_value_t value;
+    uint8_t bad_count[3] = {7, 0, 0};
+    ASSERT_EQ(binary_clock_spec_decode_binary_value_record(bad_count, 3, &value), BINARY_CLOCK_ERROR_INVALID_BIT_COUNT,
+              "bit count 7 rejected");
+
+    // A valid value in the wrong place: hours tens holds 4 bits, not 3
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    binary_clock_state_t decoded;
+    binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+    record[0] = 4;
+    ASSERT_EQ(binary_clock_spec_decode_state_record(record, sizeof(record), &decoded),
+              BINARY_CLOCK_ERROR_INVALID_BIT_COUNT, "state field bit count checked");
+}
+
+void test_malformed(void) {
+    printf("\n=== Testing Malformed Input ===\n");
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    binary_clock_state_t decoded;
+    uint8_t record[BINARY_CLOCK_SPEC_STATE_RECORD_SIZE];
+    binary_clock_spec_encode_state_record(&state, record, sizeof(record));
+    ASSERT_EQ(binary_clock_spec_decode_state_record(record, sizeof(record) - 1, &decoded), BINARY_CLOCK_ERROR_OUTPUT,
+              "short record rejected");
+    record[1] = 0x40;
+    ASSERT_EQ(binary_clock_spec_decode_state_record(record, sizeof(record), &decoded), BINARY_CLOCK_ERROR_OUTPUT,
+              "bit mask beyond six bits rejected");
+
+    char json[BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE];
+    size_t length = binary_clock_spec_encode_state_json(&state, json, sizeof(json));
+    ASSERT_EQ(binary_clock_spec_decode_state_json(json, length - 1, &decoded), BINARY_CLOCK_ERROR_OUTPUT,
+              "truncated JSON rejected");
+    json[length] = ' ';
+    ASSERT_EQ(binary_clock_spec_decode_state_json(json, length + 1, &decoded), BINARY_CLOCK_ERROR_OUTPUT,
+              "trailing bytes rejected");
+    char* bits = strstr(json, "true");
+    bits[0] = 'T';
+    ASSERT_EQ(binary_clock_spec_decode_state_json(json, length, &decoded), BINARY_CLOCK_ERROR_OUTPUT,
+              "misspelt boolean rejected");
+
+    const char* reordered = "{\"minutes\":30,\"hours\":14,\"seconds\":45}";
+    time_components_t time;
+    ASSERT_EQ(binary_clock_spec_decode_time_components_json(reordered, strlen(reordered), &time),
+              BINARY_CLOCK_ERROR_OUTPUT, "only the spec's field order is accepted");
+}
+
+void test_errors(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    uint8_t record[BINARY_CLOCK_SPEC_STATE_RECORD_SIZE];
+    char json[BINARY_CLOCK_SPEC_STATE_JSON_MAX_SIZE];
+    ASSERT_EQ(binary_clock_spec_encode_state_record(NULL, record, sizeof(record)), 0, "NULL state writes nothing");
+    ASSERT_EQ(binary_clock_spec_encode_state_record(&state, record, sizeof(record) - 1), 0,
+              "small record buffer writes nothing");
+    ASSERT_EQ(binary_clock_spec_encode_state_json(&state, json, sizeof(json) - 1), 0,
+              "JSON buffer below the maximum writes nothing");
+    ASSERT_EQ(binary_clock_spec_decode_state_record(NULL, sizeof(record), &state), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL input rejected");
+    ASSERT_EQ(binary_clock_spec_decode_state_json(json, 0, NULL), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL output rejected");
+}
+
+int main(void) {
+    printf("=== Binary Clock Spec Serializers Test Suite ===\n");
+
+    test_sizes();
+    test_round_trip();
+    test_constraints();
+    test_malformed();
+    test_errors();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All spec serializer tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_binary_clock_statusbar.c
+ * @brief Test suite for Binary Clock status bar producers
+ *
+ * Checks the i3bar stream (header once, then comma-continued status
+ * lines), the tmux lines, and that an unchanged text produces nothing.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_statusbar.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(actual, expected, message) \
+    ASSERT_TRUE(strcmp((actual), (expected)) == 0, message)
+
+// 14:30:45 UTC
+#define BASE_EPOCH 1700058645LL
+
+static size_t update(binary_clock_statusbar_t* statusbar, int64_t epoch, char* output) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+    size_t length = binary_clock_statusbar_update(statusbar, &state, output, BINARY_CLOCK_STATUSBAR_MAX_SIZE);
+    if (length != (size_t)-1) {
+        output[length] = '\0';
+    }
+    return length;
+}
+
+void test_i3bar(void) {
+    printf("\n=== Testing i3bar Protocol ===\n");
+
+    binary_clock_statusbar_t statusbar;
+    char output[BINARY_CLOCK_STATUSBAR_MAX_SIZE + 1];
+    ASSERT_EQ(binary_clock_statusbar_init(&statusbar, BINARY_CLOCK_STATUSBAR_I3BAR, BINARY_CLOCK_RENDER_COMPACT),
+              BINARY_CLOCK_SUCCESS, "i3bar producer initialized");
+
+    update(&statusbar, BASE_EPOCH, output);
+    ASSERT_STR_EQ(output,
+                  "{\"version\":1}\n[\n"
+                  "[{\"name\":\"binary_clock\",\"full_text\":\"14:30:45 [001 0100 : 011 0000 : 100 0101]\","
+                  "\"short_text\":\"14:30:45\"}]\n",
+                  "first update carries the header");
+
+    update(&statusbar, BASE_EPOCH + 1, output);
+    ASSERT_STR_EQ(output,
+                  ",[{\"name\":\"binary_clock\",\"full_text\":\"14:30:46 [001 0100 : 011 0000 : 100 0110]\","
+                  "\"short_text\":\"14:30:46\"}]\n",
+                  "later updates continue the array");
+
+    ASSERT_EQ(update(&statusbar, BASE_EPOCH + 1, output), 0, "unchanged text writes nothing");
+    ASSERT_EQ(statusbar.stats.updates, 2, "updates counted");
+    ASSERT_EQ(statusbar.stats.unchanged, 1, "unchanged states counted");
+
+    binary_clock_statusbar_init(&statusbar, BINARY_CLOCK_STATUSBAR_I3BAR, BINARY_CLOCK_RENDER_EMOJI_LINE);
+    update(&statusbar, BASE_EPOCH, output);
+    ASSERT_TRUE(strstr(output, "\"full_text\":\"14:30:45 [🌚🌚🌝 🌚🌝🌚🌚 : 🌚🌝🌝 🌚🌚🌚🌚 : 🌝🌚🌚 🌚🌝🌚🌝]\"") != NULL,
+                "emoji line in full_text");
+}
+
+void test_tmux(void) {
+    printf("\n=== Testing tmux Lines ===\n");
+
+    binary_clock_statusbar_t statusbar;
+    char output[BINARY_CLOCK_STATUSBAR_MAX_SIZE + 1];
+    binary_clock_statusbar_init(&statusbar, BINARY_CLOCK_STATUSBAR_TMUX, BINARY_CLOCK_RENDER_COMPACT);
+
+    update(&statusbar, BASE_EPOCH, output);
+    ASSERT_STR_EQ(output, "14:30:45 [001 0100 : 011 0000 : 100 0101]\n", "one plain line, no header");
+    ASSERT_EQ(update(&statusbar, BASE_EPOCH, output), 0, "same second writes nothing");
+
+    int lines = 0;
+    for (int64_t epoch = BASE_EPOCH + 1; epoch <= BASE_EPOCH + 60; epoch++) {
+        lines += update(&statusbar, epoch, output) > 0;
+    }
+    ASSERT_EQ(lines, 60, "one line per second");
+    ASSERT_EQ(statusbar.stats.bytes, 61 * strlen("14:30:45 [001 0100 : 011 0000 : 100 0101]\n"), "bytes counted");
+
+    // The table kernel produces the same text, so nothing is re-sent
+    statusbar.render = binary_clock_display_render_table;
+    ASSERT_EQ(update(&statusbar, BASE_EPOCH + 60, output), 0, "render kernel swap keeps the text");
+}
+
+void test_errors(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_statusbar_t statusbar;
+    char output[BINARY_CLOCK_STATUSBAR_MAX_SIZE];
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    ASSERT_EQ(binary_clock_statusbar_init(NULL, BINARY_CLOCK_STATUSBAR_TMUX, BINARY_CLOCK_RENDER_COMPACT),
+              BINARY_CLOCK_ERROR_NULL_POINTER, "NULL producer rejected");
+    ASSERT_EQ(binary_clock_statusbar_init(&statusbar, BINARY_CLOCK_STATUSBAR_TMUX, BINARY_CLOCK_RENDER_EMOJI),
+              BINARY_CLOCK_ERROR_OUTPUT, "multi-line format rejected");
+    ASSERT_EQ(binary_clock_statusbar_init(&statusbar, (binary_clock_statusbar_protocol_t)7, BINARY_CLOCK_RENDER_COMPACT),
+              BINARY_CLOCK_ERROR_OUTPUT, "unknown protocol rejected");
+
+    binary_clock_statusbar_init(&statusbar, BINARY_CLOCK_STATUSBAR_I3BAR, BINARY_CLOCK_RENDER_COMPACT);
+    ASSERT_EQ(binary_clock_statusbar_update(&statusbar, NULL, output, sizeof(output)), (size_t)-1,
+              "NULL state rejected");
+    ASSERT_EQ(binary_clock_statusbar_update(&statusbar, &state, output, 40), (size_t)-1, "small buffer rejected");
+    ASSERT_TRUE(!statusbar.started, "rejected update does not count as sent");
+    ASSERT_TRUE(binary_clock_statusbar_update(&statusbar, &state, output, sizeof(output)) > 0,
+                "header still sent after a rejected update");
+}
+
+int main(void) {
+    printf("=== Binary Clock Status Bar Test Suite ===\n");
+
+    test_i3bar();
+    test_tmux();
+    test_errors();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All status bar tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
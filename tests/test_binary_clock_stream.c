@@ -0,0 +1,605 @@
+/**
+ * @file test_binary_clock_stream.c
+ * @brief Test suite for Binary Clock terminal streaming
+ *
+ * Encoded frames are played into a minimal terminal model: a full repaint
+ * followed by any chain of diffs must leave exactly the current screen.
+ * On POSIX systems loopback clients check that synced clients share the
+ * diff, that late joiners and stalled clients are caught up with a full
+ * repaint, and that departed clients are dropped, and that admission
+ * limits turn newcomers away without disturbing established clients.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_stream.h>
+
+#ifndef _WIN32
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+// 2023-11-14 23:59:50 UTC
+#define BASE_EPOCH 1700006390LL
+
+/* ========================================================================== */
+/* TERMINAL MODEL                                                             */
+/* ========================================================================== */
+
+#define TERM_ROWS 32
+#define TERM_COLS 128
+
+// Column-addressed screen; each cell holds one UTF-8 character, and the
+// right half of a double-width emoji holds an empty string
+typedef struct {
+    char cells[TERM_ROWS][TERM_COLS][5];
+    size_t widths[TERM_ROWS];   // Columns in use per row
+    size_t row;
+    size_t col;
+    int escape;                 // 0 none, 1 after ESC, 2 in CSI
+    char params[16];
+    size_t param_length;
+    int telnet;                 // Bytes of a telnet command still to skip
+    char pending[5];            // UTF-8 character being assembled
+    size_t pending_length;
+    size_t pending_needed;
+} term_t;
+
+static void term_init(term_t* term) {
+    memset(term, 0, sizeof(*term));
+}
+
+static void term_truncate(term_t* term, size_t row, size_t col) {
+    if (row < TERM_ROWS && term->widths[row] > col) {
+        term->widths[row] = col;
+    }
+}
+
+static void term_csi(term_t* term, char command) {
+    term->params[term->param_length] = '\0';
+    if (command == 'H') {
+        unsigned long row = 1;
+        unsigned long col = 1;
+        if (term->param_length > 0) {
+            sscanf(term->params, "%lu;%lu", &row, &col);
+        }
+        term->row = row - 1;
+        term->col = col - 1;
+    } else if (command == 'J') {
+        size_t first = term->row + 1;
+        if (strcmp(term->params, "2") == 0) {
+            first = 0;
+        } else {
+            term_truncate(term, term->row, term->col);
+        }
+        for (size_t r = first; r < TERM_ROWS; r++) {
+            term->widths[r] = 0;
+        }
+    } else if (command == 'K') {
+        term_truncate(term, term->row, term->col);
+    }
+}
+
+static void term_put(term_t* term, const char* character, size_t width) {
+    if (term->row >= TERM_ROWS || term->col + width > TERM_COLS) {
+        return;
+    }
+    char (*cells)[5] = term->cells[term->row];
+    // Erased cells in between read back as spaces
+    while (term->widths[term->row] < term->col) {
+        strcpy(cells[term->widths[term->row]++], " ");
+    }
+    strcpy(cells[term->col], character);
+    if (width == 2) {
+        cells[term->col + 1][0] = '\0';
+    }
+    term->col += width;
+    if (term->col > term->widths[term->row]) {
+        term->widths[term->row] = term->col;
+    }
+}
+
+static void term_feed(term_t* term, const char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        char c = data[i];
+        unsigned char byte = (unsigned char)c;
+        if (term->telnet > 0) {
+            term->telnet--;
+        } else if (term->pending_needed > 0) {
+            term->pending[term->pending_length++] = c;
+            if (term->pending_length == term->pending_needed) {
+                term->pending[term->pending_length] = '\0';
+                term_put(term, term->pending, term->pending_needed == 4 ? 2 : 1);
+                term->pending_needed = 0;
+            }
+        } else if (byte == 0xFF) {
+            term->telnet = 2;   // IAC WILL option
+        } else if (term->escape == 1) {
+            term->escape = c == '[' ? 2 : 0;
+            term->param_length = 0;
+        } else if (term->escape == 2) {
+            if ((c >= '0' && c <= '9') || c == ';' || c == '?') {
+                if (term->param_length < sizeof(term->params) - 1) {
+                    term->params[term->param_length++] = c;
+                }
+            } else {
+                term_csi(term, c);
+                term->escape = 0;
+            }
+        } else if (c == '\033') {
+            term->escape = 1;
+        } else if (c == '\r') {
+            term->col = 0;
+        } else if (c == '\n') {
+            term->row++;
+        } else if (byte >= 0xC0) {
+            term->pending[0] = c;
+            term->pending_length = 1;
+            term->pending_needed = byte >= 0xF0 ? 4 : (byte >= 0xE0 ? 3 : 2);
+        } else {
+            char character[2] = {c, '\0'};
+            term_put(term, character, 1);
+        }
+    }
+}
+
+// Whether the terminal shows exactly the rendered screen
+static int term_shows(const term_t* term, const char* screen, size_t length) {
+    size_t row = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= length; i++) {
+        if (i == length || screen[i] == '\n') {
+            if (i == length && start == length) {
+                break;
+            }
+            if (row >= TERM_ROWS) {
+                return 0;
+            }
+            char text[TERM_COLS * 4 + 1];
+            size_t text_length = 0;
+            for (size_t col = 0; col < term->widths[row]; col++) {
+                size_t cell_length = strlen(term->cells[row][col]);
+                memcpy(text + text_length, term->cells[row][col], cell_length);
+                text_length += cell_length;
+            }
+            if (text_length != i - start || memcmp(text, screen + start, text_length) != 0) {
+                return 0;
+            }
+            row++;
+            start = i + 1;
+        }
+    }
+    for (; row < TERM_ROWS; row++) {
+        if (term->widths[row] != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static size_t render(int64_t epoch, binary_clock_render_format_t format, char* screen) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+    return binary_clock_display_render(&state, format, screen, BINARY_CLOCK_RENDER_MAX_SIZE);
+}
+
+/* ========================================================================== */
+/* ENCODING TESTS                                                             */
+/* ========================================================================== */
+
+void test_encode_full(void) {
+    printf("\n=== Testing Full Repaint ===\n");
+
+    char screen[BINARY_CLOCK_RENDER_MAX_SIZE];
+    char frame[BINARY_CLOCK_STREAM_FRAME_MAX_SIZE];
+    size_t length = render(BASE_EPOCH, BINARY_CLOCK_RENDER_EMOJI, screen);
+    size_t encoded = binary_clock_stream_encode_full(screen, length, frame, sizeof(frame));
+
+    ASSERT_TRUE(encoded > length && memcmp(frame, "\033[H\033[2J", 7) == 0, "repaint homes and clears first");
+    int bare_newline = 0;
+    for (size_t i = 0; i < encoded; i++) {
+        if (frame[i] == '\n' && (i == 0 || frame[i - 1] != '\r')) {
+            bare_newline = 1;
+        }
+    }
+    ASSERT_TRUE(!bare_newline, "lines end in CR LF");
+
+    term_t term;
+    term_init(&term);
+    term_feed(&term, "garbage\r\nleft over", 18);
+    term_feed(&term, frame, encoded);
+    ASSERT_TRUE(term_shows(&term, screen, length), "repaint replaces whatever was on screen");
+    ASSERT_EQ(binary_clock_stream_encode_full(screen, length, frame, 16), 0, "small buffer rejected");
+}
+
+void test_encode_diff(void) {
+    printf("\n=== Testing Differential Repaint ===\n");
+
+    static const binary_clock_render_format_t formats[] = {
+        BINARY_CLOCK_RENDER_EMOJI, BINARY_CLOCK_RENDER_ASCII, BINARY_CLOCK_RENDER_JSON
+    };
+    char previous[BINARY_CLOCK_RENDER_MAX_SIZE];
+    char screen[BINARY_CLOCK_RENDER_MAX_SIZE];
+    char frame[BINARY_CLOCK_STREAM_FRAME_MAX_SIZE];
+
+    int converged = 1;
+    size_t full_bytes = 0;
+    size_t diff_bytes = 0;
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        term_t term;
+        term_init(&term);
+        size_t previous_length = render(BASE_EPOCH, formats[f], previous);
+        size_t encoded = binary_clock_stream_encode_full(previous, previous_length, frame, sizeof(frame));
+        term_feed(&term, frame, encoded);
+
+        // Across midnight: every digit and line changes at least once
+        for (int64_t epoch = BASE_EPOCH + 1; epoch < BASE_EPOCH + 100; epoch++) {
+            size_t length = render(epoch, formats[f], screen);
+            encoded = binary_clock_stream_encode_diff(previous, previous_length, screen, length, frame, sizeof(frame));
+            term_feed(&term, frame, encoded);
+            converged &= term_shows(&term, screen, length);
+            if (formats[f] == BINARY_CLOCK_RENDER_EMOJI) {
+                diff_bytes += encoded;
+                full_bytes += binary_clock_stream_encode_full(screen, length, frame, sizeof(frame));
+            }
+            memcpy(previous, screen, length);
+            previous_length = length;
+        }
+    }
+    ASSERT_TRUE(converged, "full repaint plus diffs always shows the current screen");
+    printf("  emoji: %zu diff bytes vs %zu full repaint bytes\n", diff_bytes, full_bytes);
+    ASSERT_TRUE(diff_bytes * 4 < full_bytes, "diffs are a fraction of a repaint");
+
+    size_t length = render(BASE_EPOCH, BINARY_CLOCK_RENDER_ASCII, screen);
+    ASSERT_EQ(binary_clock_stream_encode_diff(screen, length, screen, length, frame, sizeof(frame)), 0,
+              "unchanged screen needs no bytes");
+
+    // Shrinking screens erase the lines they lost
+    size_t previous_length = render(BASE_EPOCH, BINARY_CLOCK_RENDER_JSON, previous);
+    term_t term;
+    term_init(&term);
+    term_feed(&term, frame, binary_clock_stream_encode_full(previous, previous_length, frame, sizeof(frame)));
+    size_t encoded = binary_clock_stream_encode_diff(previous, previous_length, screen, length, frame, sizeof(frame));
+    term_feed(&term, frame, encoded);
+    ASSERT_TRUE(term_shows(&term, screen, length), "format switch diff erases surplus lines");
+    ASSERT_EQ(binary_clock_stream_encode_diff(previous, previous_length, screen, length, frame, 8), (size_t)-1,
+              "small buffer rejected");
+}
+
+/* ========================================================================== */
+/* SERVER TESTS                                                               */
+/* ========================================================================== */
+
+#ifndef _WIN32
+
+#define LOOPBACK_CLIENTS 8
+
+typedef struct {
+    int fd;
+    term_t term;
+    size_t received;
+} test_client_t;
+
+static int connect_client(uint16_t port, int receive_buffer) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd >= 0 && receive_buffer > 0) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receive_buffer, sizeof(receive_buffer));
+    }
+    struct sockaddr_in server = {0};
+    server.sin_family = AF_INET;
+    server.sin_port = htons(port);
+    server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (const struct sockaddr*)&server, sizeof(server)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+// Read everything the server has sent so far into the client's terminal
+static void drain(test_client_t* client) {
+    char buffer[4096];
+    ssize_t got;
+    while ((got = recv(client->fd, buffer, sizeof(buffer), 0)) > 0) {
+        term_feed(&client->term, buffer, (size_t)got);
+        client->received += (size_t)got;
+    }
+}
+
+// Let the server accept and flush until it has nothing left to do
+static void settle(binary_clock_stream_server_t* server, test_client_t* clients, int count) {
+    for (int round = 0; round < 20; round++) {
+        binary_clock_stream_server_poll(server, 5);
+        for (int i = 0; i < count; i++) {
+            drain(&clients[i]);
+        }
+    }
+}
+
+static void tick(binary_clock_stream_server_t* server, int64_t epoch) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+    binary_clock_stream_server_tick(server, &state);
+}
+
+void test_server(void) {
+    printf("\n=== Testing Loopback Server ===\n");
+
+    binary_clock_stream_server_t server;
+    if (binary_clock_stream_server_open(&server, "127.0.0.1", 0, BINARY_CLOCK_RENDER_EMOJI) != BINARY_CLOCK_SUCCESS) {
+        printf("  (skipped: cannot listen on loopback)\n");
+        return;
+    }
+    ASSERT_TRUE(server.port != 0, "ephemeral port resolved");
+
+    test_client_t clients[LOOPBACK_CLIENTS + 1];
+    int connected = 0;
+    for (int i = 0; i < LOOPBACK_CLIENTS; i++) {
+        term_init(&clients[i].term);
+        clients[i].received = 0;
+        // clients[1] will stall: keep its socket buffers small so it fills
+        clients[i].fd = connect_client(server.port, i == 1 ? 1024 : 0);
+        connected += clients[i].fd >= 0;
+    }
+    ASSERT_EQ(connected, LOOPBACK_CLIENTS, "clients connected");
+    settle(&server, clients, LOOPBACK_CLIENTS);
+    ASSERT_EQ(server.client_count, LOOPBACK_CLIENTS, "server accepted every client");
+    int send_buffer = 1024;
+    for (size_t i = 0; i < server.client_count; i++) {
+        struct sockaddr_in peer;
+        socklen_t peer_length = sizeof(peer);
+        struct sockaddr_in local;
+        socklen_t local_length = sizeof(local);
+        getpeername(server.clients[i].fd, (struct sockaddr*)&peer, &peer_length);
+        getsockname(clients[1].fd, (struct sockaddr*)&local, &local_length);
+        if (peer.sin_port == local.sin_port) {
+            setsockopt(server.clients[i].fd, SOL_SOCKET, SO_SNDBUF, &send_buffer, sizeof(send_buffer));
+        }
+    }
+
+    // First tick: everyone needs a full repaint, then diffs only
+    size_t slab_bytes = 0;
+    for (int64_t epoch = BASE_EPOCH; epoch < BASE_EPOCH + 20; epoch++) {
+        tick(&server, epoch);
+        settle(&server, clients, LOOPBACK_CLIENTS);
+        if (epoch == BASE_EPOCH + 2) {
+            slab_bytes = server.pool.bytes;
+        }
+    }
+    ASSERT_EQ(server.stats.full_sends, LOOPBACK_CLIENTS, "one full repaint per client");
+    ASSERT_EQ(server.stats.diff_sends, 19 * LOOPBACK_CLIENTS, "synced clients get the shared diff");
+    ASSERT_TRUE(slab_bytes > 0 && server.pool.bytes == slab_bytes, "frames recycled without new slabs");
+    ASSERT_EQ(binary_clock_stream_server_memory(&server),
+              server.client_capacity * sizeof(binary_clock_stream_client_t) +
+              (server.client_capacity + 1) * sizeof(struct pollfd) + server.pool.bytes,
+              "memory counts client slots, poll set and slabs");
+
+    char screen[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = render(BASE_EPOCH + 19, BINARY_CLOCK_RENDER_EMOJI, screen);
+    int all_current = 1;
+    for (int i = 0; i < LOOPBACK_CLIENTS; i++) {
+        all_current &= term_shows(&clients[i].term, screen, length);
+    }
+    ASSERT_TRUE(all_current, "every terminal shows the current second");
+
+    // A late joiner is painted immediately, without waiting for a tick
+    test_client_t* late = &clients[LOOPBACK_CLIENTS];
+    term_init(&late->term);
+    late->received = 0;
+    late->fd = connect_client(server.port, 0);
+    settle(&server, clients, LOOPBACK_CLIENTS + 1);
+    ASSERT_TRUE(term_shows(&late->term, screen, length), "late joiner sees the current second");
+
+    // A departed client is dropped
+    close(clients[0].fd);
+    clients[0].fd = -1;
+    tick(&server, BASE_EPOCH + 20);
+    settle(&server, clients + 1, LOOPBACK_CLIENTS);
+    ASSERT_EQ(server.client_count, LOOPBACK_CLIENTS, "closed client removed");
+    ASSERT_EQ(server.stats.disconnected, 1, "disconnect counted");
+
+    // A stalled client falls behind, then catches up with a full repaint
+    int64_t epoch = BASE_EPOCH + 21;
+    uint64_t full_before = server.stats.full_sends;
+    // Missing one tick is caught up by the diff; missing several needs a repaint
+    for (; epoch < BASE_EPOCH + 5000 && server.stats.busy < 3; epoch++) {
+        tick(&server, epoch);
+        binary_clock_stream_server_poll(&server, 0);
+        for (int i = 2; i <= LOOPBACK_CLIENTS; i++) {
+            drain(&clients[i]);  // clients[1] never reads
+        }
+    }
+    ASSERT_TRUE(server.stats.busy >= 3, "stalled client detected as busy");
+    length = render(epoch - 1, BINARY_CLOCK_RENDER_EMOJI, screen);
+    for (int round = 0; round < 200 && binary_clock_stream_server_pending(&server); round++) {
+        drain(&clients[1]);
+        binary_clock_stream_server_poll(&server, 5);
+    }
+    drain(&clients[1]);
+    ASSERT_TRUE(server.stats.full_sends > full_before, "stalled client caught up with a full repaint");
+    ASSERT_TRUE(term_shows(&clients[1].term, screen, length), "stalled client shows the current second");
+    printf("  stall: %llu busy ticks, %llu bytes encoded, %llu bytes sent\n",
+           (unsigned long long)server.stats.busy, (unsigned long long)server.stats.encoded_bytes,
+           (unsigned long long)server.stats.sent_bytes);
+
+    for (int i = 1; i <= LOOPBACK_CLIENTS; i++) {
+        close(clients[i].fd);
+    }
+    binary_clock_stream_server_close(&server);
+    ASSERT_EQ(server.listen_fd, -1, "server closed");
+}
+
+// Read whatever a client has been sent until the server closes it
+static size_t read_until_closed(int fd, char* buffer, size_t size) {
+    size_t length = 0;
+    for (int round = 0; round < 200; round++) {
+        ssize_t got = recv(fd, buffer + length, size - 1 - length, 0);
+        if (got == 0) {
+            break;
+        }
+        if (got > 0) {
+            length += (size_t)got;
+        } else {
+            usleep(1000);
+        }
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+void test_admission(void) {
+    printf("\n=== Testing Admission Control ===\n");
+
+    binary_clock_stream_server_t server;
+    if (binary_clock_stream_server_open(&server, "127.0.0.1", 0, BINARY_CLOCK_RENDER_ASCII) != BINARY_CLOCK_SUCCESS) {
+        printf("  (skipped: cannot listen on loopback)\n");
+        return;
+    }
+    tick(&server, BASE_EPOCH);
+
+    // A stampede is accepted in bounded batches, never all in one poll
+    enum { STAMPEDE = BINARY_CLOCK_STREAM_ACCEPT_BATCH + 16 };
+    test_client_t clients[STAMPEDE];
+    for (int i = 0; i < STAMPEDE; i++) {
+        term_init(&clients[i].term);
+        clients[i].received = 0;
+        clients[i].fd = connect_client(server.port, 0);
+    }
+    binary_clock_stream_server_poll(&server, 100);
+    ASSERT_EQ(server.client_count, BINARY_CLOCK_STREAM_ACCEPT_BATCH, "one poll accepts one batch");
+    settle(&server, clients, STAMPEDE);
+    ASSERT_EQ(server.client_count, STAMPEDE, "the rest accepted on later polls");
+    for (int i = 2; i < STAMPEDE; i++) {
+        close(clients[i].fd);
+    }
+    settle(&server, clients, 2);
+    ASSERT_EQ(server.client_count, 2, "stampede left");
+
+    // Over the cap: the newcomer gets the busy notice, established clients stay
+    binary_clock_admit_limits_t limits = {2, 0, 0, 0};
+    ASSERT_EQ(binary_clock_stream_server_set_limits(&server, &limits), BINARY_CLOCK_SUCCESS, "limits set");
+    ASSERT_EQ(server.admit.active, 2, "connected clients counted against the limits");
+    char notice[256];
+    int fd = connect_client(server.port, 0);
+    settle(&server, clients, 2);
+    read_until_closed(fd, notice, sizeof(notice));
+    close(fd);
+    ASSERT_TRUE(strcmp(notice, BINARY_CLOCK_STREAM_BUSY_MESSAGE) == 0, "rejected client told the server is busy");
+    ASSERT_EQ(server.admit.stats.rejected_full, 1, "rejection counted");
+    ASSERT_EQ(server.client_count, 2, "established clients kept");
+    tick(&server, BASE_EPOCH + 1);
+    settle(&server, clients, 2);
+    char screen[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = render(BASE_EPOCH + 1, BINARY_CLOCK_RENDER_ASCII, screen);
+    ASSERT_TRUE(term_shows(&clients[0].term, screen, length) && term_shows(&clients[1].term, screen, length),
+                "established clients still ticked");
+
+    // A departure frees a place; one address may hold only so many
+    close(clients[1].fd);
+    settle(&server, clients, 1);
+    limits.max_per_address = 1;
+    binary_clock_stream_server_set_limits(&server, &limits);
+    fd = connect_client(server.port, 0);
+    settle(&server, clients, 1);
+    read_until_closed(fd, notice, sizeof(notice));
+    close(fd);
+    ASSERT_EQ(server.admit.stats.rejected_address, 1, "second connection from one address rejected");
+    ASSERT_EQ(server.admit.stats.rejected_full, 1, "counters kept when limits change");
+    ASSERT_TRUE(binary_clock_stream_server_memory(&server) >=
+                binary_clock_admit_memory(&server.admit) + server.pool.bytes,
+                "memory counts per-address table");
+
+    binary_clock_stream_server_set_limits(&server, NULL);
+    fd = connect_client(server.port, 0);
+    settle(&server, clients, 1);
+    ASSERT_EQ(server.client_count, 2, "lifted limits admit again");
+    close(fd);
+    close(clients[0].fd);
+    binary_clock_stream_server_close(&server);
+}
+
+#endif
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_stream_server_t server;
+    ASSERT_EQ(binary_clock_stream_server_open(NULL, NULL, 0, BINARY_CLOCK_RENDER_EMOJI),
+              BINARY_CLOCK_ERROR_NULL_POINTER, "NULL server rejected");
+    ASSERT_EQ(binary_clock_stream_server_open(&server, "not-an-address", 0, BINARY_CLOCK_RENDER_EMOJI),
+              BINARY_CLOCK_ERROR_NETWORK, "bad address rejected");
+    ASSERT_EQ(binary_clock_stream_server_tick(&server, NULL), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL state rejected");
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    ASSERT_EQ(binary_clock_stream_server_tick(&server, &state), BINARY_CLOCK_ERROR_NETWORK,
+              "tick on a closed server rejected");
+    ASSERT_EQ(binary_clock_stream_server_poll(&server, 0), BINARY_CLOCK_ERROR_NETWORK,
+              "poll on a closed server rejected");
+    ASSERT_EQ(binary_clock_stream_server_memory(&server), 0, "closed server holds no memory");
+    ASSERT_EQ(binary_clock_stream_server_memory(NULL), 0, "NULL server holds no memory");
+    ASSERT_EQ(binary_clock_stream_server_set_limits(NULL, NULL), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL server limits rejected");
+    binary_clock_stream_server_close(&server);
+}
+
+int main(void) {
+    printf("=== Binary Clock Streaming Test Suite ===\n");
+
+    test_encode_full();
+    test_encode_diff();
+#ifndef _WIN32
+    test_server();
+    test_admission();
+#endif
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All streaming tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
@@ -0,0 +1,273 @@
+/**
+ * @file test_binary_clock_trace.c
+ * @brief Test suite for Binary Clock tracing
+ *
+ * Records spans, writes them as Chrome trace-event JSON and checks that
+ * the output is well formed: begins and ends balance, timestamps are in
+ * order, and the bounded ring keeps the latest events.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_trace.h>
+#include <binary_clock_present.h>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define OUTPUT_SIZE 65536
+
+// Summary of a written trace
+typedef struct {
+    int begins;
+    int ends;
+    int max_depth;
+    bool balanced;              // No end ever closes more spans than are open
+    bool ordered;               // Timestamps never go backwards
+    char first_name[32];        // Name of the first event
+} trace_summary_t;
+
+// Write the current trace into a buffer
+static size_t write_trace(char* output, size_t size) {
+    FILE* file = tmpfile();
+    if (file == NULL) {
+        return 0;
+    }
+    binary_clock_trace_write(file);
+    rewind(file);
+    size_t length = fread(output, 1, size - 1, file);
+    output[length] = '\0';
+    fclose(file);
+    return length;
+}
+
+// Walk the events of a single-threaded trace
+static trace_summary_t summarize(const char* output) {
+    trace_summary_t summary = {0, 0, 0, true, true, ""};
+    double last_ts = 0.0;
+    int depth = 0;
+    const char* event = output;
+    while ((event = strstr(event, "{\"name\":\"")) != NULL) {
+        const char* phase = strstr(event, "\"ph\":\"");
+        const char* ts = strstr(event, "\"ts\":");
+        if (phase == NULL || ts == NULL) {
+            break;
+        }
+        if (summary.begins + summary.ends == 0) {
+            size_t length = strcspn(event + 9, "\"");
+            if (length < sizeof(summary.first_name)) {
+                memcpy(summary.first_name, event + 9, length);
+                summary.first_name[length] = '\0';
+            }
+        }
+        if (phase[6] == 'B') {
+            summary.begins++;
+            depth++;
+            summary.max_depth = depth > summary.max_depth ? depth : summary.max_depth;
+        } else {
+            summary.ends++;
+            if (--depth < 0) {
+                summary.balanced = false;
+            }
+        }
+        double value = atof(ts + 5);
+        if (value < last_ts) {
+            summary.ordered = false;
+        }
+        last_ts = value;
+        event++;
+    }
+    summary.balanced = summary.balanced && depth == 0;
+    return summary;
+}
+
+void test_disabled(void) {
+    printf("\n=== Testing Disabled Tracing ===\n");
+
+    binary_clock_trace_stop();
+    binary_clock_trace_begin("test", "ignored");
+    binary_clock_trace_end("test", "ignored");
+    binary_clock_trace_stats_t stats = binary_clock_trace_get_stats();
+    ASSERT_TRUE(!binary_clock_trace_enabled(), "tracing is off until started");
+    ASSERT_EQ(stats.recorded, 0, "nothing recorded while off");
+
+    char output[OUTPUT_SIZE];
+    write_trace(output, sizeof(output));
+    ASSERT_TRUE(strncmp(output, "{\"traceEvents\":[", 16) == 0 && strstr(output, "\"ph\"") == NULL,
+                "empty trace is an empty event list");
+}
+
+void test_spans(void) {
+    printf("\n=== Testing Spans ===\n");
+
+    ASSERT_EQ(binary_clock_trace_start(100), BINARY_CLOCK_SUCCESS, "tracing started");
+    ASSERT_EQ(binary_clock_trace_get_stats().capacity, 128, "capacity rounded up to a power of two");
+
+    binary_clock_trace_begin("loop", "tick");
+    binary_clock_trace_begin("loop", "state");
+    binary_clock_trace_end("loop", "state");
+    binary_clock_trace_begin("sink", "write");
+    binary_clock_trace_end("sink", "write");
+    binary_clock_trace_end("loop", "tick");
+    ASSERT_EQ(binary_clock_trace_get_stats().recorded, 6, "every begin and end recorded");
+
+    char output[OUTPUT_SIZE];
+    size_t length = write_trace(output, sizeof(output));
+    trace_summary_t summary = summarize(output);
+    ASSERT_EQ(summary.begins, 3, "three begins written");
+    ASSERT_EQ(summary.ends, 3, "three ends written");
+    ASSERT_TRUE(summary.balanced && summary.max_depth == 2, "spans nest");
+    ASSERT_TRUE(summary.ordered, "timestamps in order");
+    ASSERT_TRUE(strstr(output, "{\"name\":\"state\",\"cat\":\"loop\",\"ph\":\"B\",\"ts\":") != NULL,
+                "events carry name, category and phase");
+    ASSERT_TRUE(strstr(output, "\"pid\":") != NULL && strstr(output, "\"tid\":") != NULL,
+                "events carry process and thread ids");
+    ASSERT_TRUE(length > 2 && strcmp(output + length - 3, "}}\n") == 0 &&
+                strstr(output, "\"otherData\":{\"recorded\":6,\"overwritten\":0}") != NULL,
+                "trace object closed with its counters");
+
+    // A span still open when the trace is written is closed at the last event
+    binary_clock_trace_begin("loop", "open");
+    write_trace(output, sizeof(output));
+    summary = summarize(output);
+    ASSERT_TRUE(summary.begins == 4 && summary.balanced, "open span closed in the output");
+    binary_clock_trace_stop();
+}
+
+void test_bounded_ring(void) {
+    printf("\n=== Testing Bounded Ring ===\n");
+
+    binary_clock_trace_start(8);
+    binary_clock_trace_begin("loop", "first");
+    binary_clock_trace_end("loop", "first");
+    for (int i = 0; i < 10; i++) {
+        binary_clock_trace_begin("loop", "tick");
+        binary_clock_trace_begin("loop", "state");
+        binary_clock_trace_end("loop", "state");
+        binary_clock_trace_end("loop", "tick");
+    }
+
+    binary_clock_trace_stats_t stats = binary_clock_trace_get_stats();
+    ASSERT_EQ(stats.recorded, 42, "every event counted");
+    ASSERT_EQ(stats.overwritten, 34, "oldest events overwritten");
+
+    char output[OUTPUT_SIZE];
+    write_trace(output, sizeof(output));
+    trace_summary_t summary = summarize(output);
+    ASSERT_TRUE(summary.begins + summary.ends == 8 && summary.balanced, "latest events kept, balanced");
+    ASSERT_TRUE(strcmp(summary.first_name, "tick") == 0, "oldest kept event is a begin");
+
+    // Cut in the middle of a span: its orphaned end is left out
+    binary_clock_trace_begin("loop", "tick");
+    binary_clock_trace_begin("loop", "state");
+    binary_clock_trace_end("loop", "state");
+    binary_clock_trace_end("loop", "tick");
+    binary_clock_trace_begin("loop", "tick");
+    binary_clock_trace_begin("loop", "state");
+    write_trace(output, sizeof(output));
+    summary = summarize(output);
+    ASSERT_TRUE(summary.balanced, "orphaned ends dropped");
+    ASSERT_TRUE(strstr(output, "\"overwritten\":40") != NULL, "overwritten count written");
+    binary_clock_trace_stop();
+}
+
+void test_presenter_spans(void) {
+    printf("\n=== Testing Presenter Spans ===\n");
+
+    time_components_t time_comp = {12, 34, 56};
+    binary_clock_state_t state = binary_clock_state_from_time(&time_comp);
+    binary_clock_virtual_clock_t clock;
+    binary_clock_virtual_clock_init(&clock, 0, 0);
+    binary_clock_present_clock_t source = binary_clock_virtual_clock_source(&clock);
+    binary_clock_presenter_t presenter;
+    binary_clock_presenter_init(&presenter, -1);
+    binary_clock_presenter_set_clock(&presenter, &source);
+
+    binary_clock_trace_start(0);
+    ASSERT_EQ(binary_clock_trace_get_stats().capacity, BINARY_CLOCK_TRACE_DEFAULT_EVENTS, "default capacity");
+#ifndef _WIN32
+    int pipe_fds[2];
+    if (pipe(pipe_fds) == 0) {
+        presenter.fd = pipe_fds[1];
+    }
+#endif
+    binary_clock_presenter_stage(&presenter, &state, BINARY_CLOCK_RENDER_ASCII, NULL, 1000000);
+    binary_clock_presenter_commit(&presenter, NULL);
+
+    char output[OUTPUT_SIZE];
+    write_trace(output, sizeof(output));
+    trace_summary_t summary = summarize(output);
+    ASSERT_TRUE(strstr(output, "\"name\":\"render\",\"cat\":\"present\"") != NULL, "render recorded");
+    ASSERT_TRUE(strstr(output, "\"name\":\"wait\",\"cat\":\"tick\"") != NULL, "tick wakeup recorded");
+    ASSERT_TRUE(strstr(output, "\"name\":\"write\",\"cat\":\"sink\"") != NULL, "sink write recorded");
+    ASSERT_TRUE(summary.begins == 3 && summary.balanced && summary.ordered, "presenter spans well formed");
+#ifndef _WIN32
+    close(pipe_fds[0]);
+    close(pipe_fds[1]);
+#endif
+    binary_clock_trace_stop();
+}
+
+void test_errors(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    ASSERT_EQ(binary_clock_trace_write(NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL stream rejected");
+    ASSERT_EQ(binary_clock_trace_save(NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL path rejected");
+    ASSERT_EQ(binary_clock_trace_save("/nonexistent-dir/trace.json"), BINARY_CLOCK_ERROR_OUTPUT,
+              "unwritable path reported");
+}
+
+int main(void) {
+    printf("=== Binary Clock Tracing Test Suite ===\n");
+
+    test_disabled();
+    test_spans();
+    test_bounded_ring();
+    test_presenter_spans();
+    test_errors();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All tracing tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
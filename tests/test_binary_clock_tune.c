@@ -0,0 +1,261 @@
+/**
+ * @file test_binary_clock_tune.c
+ * @brief Test suite for Binary Clock autotuning
+ *
+ * The kernels the tuner chooses between must be interchangeable, so the
+ * table kernels are checked against the scalar ones over a whole day.
+ * The tuner itself is checked for a sane choice, a cache that round-trips
+ * and is keyed by CPU model, and a clock source that tracks the wall clock.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_tune.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define CACHE_PATH "test_binary_clock_tune.cache"
+
+static bool same_value(const binary_value_t* a, const binary_value_t* b) {
+    if (a->bit_count != b->bit_count || a->decimal_value != b->decimal_value) {
+        return false;
+    }
+    for (int i = 0; i < a->bit_count; i++) {
+        if (a->bits[i] != b->bits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool same_state(const binary_clock_state_t* a, const binary_clock_state_t* b) {
+    return same_value(&a->hours_tens, &b->hours_tens) && same_value(&a->hours_units, &b->hours_units) &&
+           same_value(&a->minutes_tens, &b->minutes_tens) && same_value(&a->minutes_units, &b->minutes_units) &&
+           same_value(&a->seconds_tens, &b->seconds_tens) && same_value(&a->seconds_units, &b->seconds_units) &&
+           a->timestamp == b->timestamp;
+}
+
+void test_conversion_kernels(void) {
+    printf("\n=== Testing Conversion Kernels ===\n");
+
+    int mismatches = 0;
+    for (int64_t epoch = 1700000000LL; epoch < 1700000000LL + 86400; epoch++) {
+        binary_clock_state_t scalar = binary_clock_state_from_epoch(epoch, 19800);
+        binary_clock_state_t table = binary_clock_tune_state_from_epoch_table(epoch, 19800);
+        mismatches += same_state(&scalar, &table) ? 0 : 1;
+    }
+    ASSERT_EQ(mismatches, 0, "table conversion matches scalar for every second of a day");
+
+    binary_clock_state_t scalar = binary_clock_state_from_epoch(-1, -3600);
+    binary_clock_state_t table = binary_clock_tune_state_from_epoch_table(-1, -3600);
+    ASSERT_TRUE(same_state(&scalar, &table), "table conversion matches scalar before the epoch");
+
+    mismatches = 0;
+    for (int64_t epoch = -86400; epoch < 86400; epoch++) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(epoch, -12600);
+        mismatches += binary_clock_tune_packed_from_epoch(epoch, -12600) == binary_clock_pack_state(&state) ? 0 : 1;
+    }
+    ASSERT_EQ(mismatches, 0, "composed LED mask matches the packed state across midnight and the epoch");
+    ASSERT_EQ(binary_clock_tune_packed_from_epoch(86399, 0), 0x235959, "last second of the day");
+    ASSERT_EQ(binary_clock_tune_packed_from_epoch(INT64_MAX, 3600), 0x163007, "no overflow at INT64_MAX");
+    ASSERT_EQ(binary_clock_tune_packed_from_epoch(INT64_MIN, -86399), 0x082953, "no overflow at INT64_MIN");
+    ASSERT_TRUE(binary_clock_tune_convert_table_size() < 512, "composition tables stay small");
+}
+
+void test_render_kernels(void) {
+    printf("\n=== Testing Render Kernels ===\n");
+
+    int mismatches = 0;
+    for (int64_t epoch = 0; epoch < 86400; epoch += 7) {
+        binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+        for (int format = BINARY_CLOCK_RENDER_EMOJI; format <= BINARY_CLOCK_RENDER_EMOJI_LINE; format++) {
+            char scalar[BINARY_CLOCK_RENDER_MAX_SIZE];
+            char table[BINARY_CLOCK_RENDER_MAX_SIZE];
+            size_t scalar_length = binary_clock_display_render(&state, (binary_clock_render_format_t)format,
+                                                               scalar, sizeof(scalar));
+            size_t table_length = binary_clock_display_render_table(&state, (binary_clock_render_format_t)format,
+                                                                    table, sizeof(table));
+            if (scalar_length == 0 || scalar_length != table_length || memcmp(scalar, table, scalar_length) != 0) {
+                mismatches++;
+            }
+        }
+    }
+    ASSERT_EQ(mismatches, 0, "table render matches scalar in every format");
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(45296, 0);
+    char small[8];
+    ASSERT_EQ(binary_clock_display_render_table(&state, BINARY_CLOCK_RENDER_JSON, small, sizeof(small)), 0,
+              "table render reports a buffer too small");
+}
+
+void test_run(void) {
+    printf("\n=== Testing Measurement ===\n");
+
+    binary_clock_tune_t tune;
+    binary_clock_tune_init(&tune);
+    ASSERT_EQ(tune.clock, BINARY_CLOCK_TUNE_CLOCK_REALTIME, "defaults to the wall clock");
+    ASSERT_TRUE(tune.cpu_model[0] != '\0', "CPU model detected");
+
+    ASSERT_EQ(binary_clock_tune_run(&tune, 4), BINARY_CLOCK_SUCCESS, "measurement runs");
+    ASSERT_TRUE(tune.clock_ns[BINARY_CLOCK_TUNE_CLOCK_REALTIME] > 0.0, "wall clock measured");
+    ASSERT_TRUE(tune.clock_resolution_ns[tune.clock] <= BINARY_CLOCK_TUNE_MAX_RESOLUTION_US * 1000LL,
+                "chosen clock resolves presentation times");
+    ASSERT_TRUE(tune.clock_ns[tune.clock] <= tune.clock_ns[BINARY_CLOCK_TUNE_CLOCK_REALTIME],
+                "chosen clock is no slower than the wall clock");
+    ASSERT_TRUE(tune.convert_ns[tune.convert] <= tune.convert_ns[BINARY_CLOCK_TUNE_KERNEL_SCALAR] &&
+                tune.render_ns[tune.render] <= tune.render_ns[BINARY_CLOCK_TUNE_KERNEL_SCALAR],
+                "chosen kernels are the fastest measured");
+    ASSERT_TRUE(!tune.cached && tune.tuning_ms > 0.0, "measured decision is not marked cached");
+
+    binary_clock_state_t state = binary_clock_tune_convert_fn(&tune)(1700000000LL, 0);
+    char frame[BINARY_CLOCK_RENDER_MAX_SIZE];
+    size_t length = binary_clock_tune_render_fn(&tune)(&state, BINARY_CLOCK_RENDER_JSON, frame, sizeof(frame));
+    ASSERT_TRUE(length > 0 && strstr(frame, "\"timestamp\": 1700000000") != NULL, "chosen kernels work");
+
+    char summary[512];
+    binary_clock_tune_describe(&tune, summary, sizeof(summary));
+    ASSERT_TRUE(strstr(summary, binary_clock_tune_clock_name(tune.clock)) != NULL &&
+                strstr(summary, "ns/read") != NULL, "summary names the choice and timings");
+}
+
+void test_clock_source(void) {
+    printf("\n=== Testing Clock Source ===\n");
+
+    binary_clock_tune_t tune;
+    binary_clock_tune_init(&tune);
+    binary_clock_present_clock_t source = binary_clock_tune_clock_source(&tune);
+    ASSERT_TRUE(source.now_us == NULL, "wall clock choice leaves the presenter default");
+
+    binary_clock_tune_run(&tune, 2);
+    tune.clock = BINARY_CLOCK_TUNE_CLOCK_CYCLES;
+    source = binary_clock_tune_clock_source(&tune);
+    if (source.now_us == NULL) {
+        ASSERT_EQ(tune.clock_ns[BINARY_CLOCK_TUNE_CLOCK_CYCLES], 0.0, "no cycle counter on this host");
+        return;
+    }
+
+    int64_t worst = 0;
+    for (int i = 0; i < 1000; i++) {
+        int64_t wall = binary_clock_present_now_us();
+        int64_t cycles = source.now_us(source.context);
+        int64_t drift = cycles > wall ? cycles - wall : wall - cycles;
+        worst = drift > worst ? drift : worst;
+    }
+    ASSERT_TRUE(worst < 1000, "cycle clock tracks the wall clock within 1 ms");
+
+    int64_t target = binary_clock_present_now_us() + 2000;
+    int64_t woke = source.wait_until_us(target, source.context);
+    ASSERT_TRUE(woke >= target && binary_clock_present_now_us() >= target - 1000,
+                "waits until the target on the cycle clock");
+}
+
+void test_cache(void) {
+    printf("\n=== Testing Cache ===\n");
+
+    binary_clock_tune_t measured;
+    binary_clock_tune_init(&measured);
+    binary_clock_tune_run(&measured, 2);
+    measured.convert = BINARY_CLOCK_TUNE_KERNEL_TABLE;
+    measured.render = BINARY_CLOCK_TUNE_KERNEL_SCALAR;
+    ASSERT_EQ(binary_clock_tune_save(&measured, CACHE_PATH), BINARY_CLOCK_SUCCESS, "decision saved");
+
+    binary_clock_tune_t loaded;
+    binary_clock_tune_init(&loaded);
+    ASSERT_EQ(binary_clock_tune_load(&loaded, CACHE_PATH), BINARY_CLOCK_SUCCESS, "decision loaded");
+    ASSERT_TRUE(loaded.clock == measured.clock && loaded.convert == BINARY_CLOCK_TUNE_KERNEL_TABLE &&
+                loaded.render == BINARY_CLOCK_TUNE_KERNEL_SCALAR, "loaded decision matches the saved one");
+    ASSERT_TRUE(loaded.cached && loaded.tuning_ms == 0.0, "loaded decision is marked cached");
+
+    char summary[512];
+    binary_clock_tune_describe(&loaded, summary, sizeof(summary));
+    ASSERT_TRUE(strstr(summary, "cached") != NULL, "summary says the decision was cached");
+
+    binary_clock_tune_t other;
+    binary_clock_tune_init(&other);
+    snprintf(other.cpu_model, sizeof(other.cpu_model), "Some other CPU");
+    ASSERT_EQ(binary_clock_tune_load(&other, CACHE_PATH), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "cache from another CPU model rejected");
+    ASSERT_EQ(other.convert, BINARY_CLOCK_TUNE_KERNEL_SCALAR, "rejected cache leaves the defaults");
+
+    FILE* file = fopen(CACHE_PATH, "w");
+    if (file != NULL) {
+        fprintf(file, "cpu=%s\nclock=sundial\nconvert=table\nrender=table\n", loaded.cpu_model);
+        fclose(file);
+    }
+    ASSERT_EQ(binary_clock_tune_load(&loaded, CACHE_PATH), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "unknown clock source rejected");
+    remove(CACHE_PATH);
+    ASSERT_EQ(binary_clock_tune_load(&loaded, CACHE_PATH), BINARY_CLOCK_ERROR_OUTPUT, "missing cache reported");
+}
+
+void test_errors(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_tune_t tune;
+    binary_clock_tune_init(&tune);
+    char summary[64];
+    ASSERT_EQ(binary_clock_tune_run(NULL, 0), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL tuner rejected by run");
+    ASSERT_EQ(binary_clock_tune_load(&tune, NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL path rejected by load");
+    ASSERT_EQ(binary_clock_tune_save(NULL, CACHE_PATH), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL tuner rejected by save");
+    ASSERT_EQ(binary_clock_tune_save(&tune, "/nonexistent-dir/tune"), BINARY_CLOCK_ERROR_OUTPUT,
+              "unwritable cache reported");
+    ASSERT_TRUE(binary_clock_tune_convert_fn(NULL) == binary_clock_state_from_epoch, "NULL tuner converts scalar");
+    ASSERT_TRUE(binary_clock_tune_render_fn(NULL) == binary_clock_display_render, "NULL tuner renders scalar");
+    ASSERT_EQ(binary_clock_tune_describe(&tune, summary, sizeof(summary)), sizeof(summary) - 1,
+              "summary truncated to the buffer");
+    ASSERT_TRUE(strcmp(binary_clock_tune_clock_name((binary_clock_tune_clock_t)9), "unknown") == 0,
+                "unknown clock named");
+}
+
+int main(void) {
+    printf("=== Binary Clock Autotuning Test Suite ===\n");
+
+    test_conversion_kernels();
+    test_render_kernels();
+    test_run();
+    test_clock_source();
+    test_cache();
+    test_errors();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All autotuning tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
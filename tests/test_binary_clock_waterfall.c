@@ -0,0 +1,297 @@
+/**
+ * @file test_binary_clock_waterfall.c
+ * @brief Test suite for the Binary Clock waterfall display
+ *
+ * Checks the escape sequences, that every tick has the same size whatever
+ * the history length, and, on a small terminal model that implements the
+ * sequences the waterfall sends, that the screen shows the last N
+ * seconds newest first.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_waterfall.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define ASSERT_STR_EQ(actual, expected, message) \
+    ASSERT_TRUE(strcmp((actual), (expected)) == 0, message)
+
+// 14:30:45 UTC
+#define BASE_EPOCH 1700058645LL
+
+/*
+ * Terminal model: rows of bytes, a cursor, a scroll region, and the
+ * sequences the waterfall uses (ED, CUP, DECSTBM, RI, line feed)
+ */
+#define SCREEN_ROWS 24
+#define SCREEN_WIDTH 256
+
+typedef struct {
+    char text[SCREEN_ROWS + 1][SCREEN_WIDTH];  // 1-based rows
+    int row;
+    int column;
+    int top;
+    int bottom;
+} screen_t;
+
+static void screen_scroll(screen_t* screen, int direction) {
+    if (direction > 0) {
+        memmove(screen->text[screen->top], screen->text[screen->top + 1],
+                (size_t)(screen->bottom - screen->top) * SCREEN_WIDTH);
+        memset(screen->text[screen->bottom], 0, SCREEN_WIDTH);
+    } else {
+        memmove(screen->text[screen->top + 1], screen->text[screen->top],
+                (size_t)(screen->bottom - screen->top) * SCREEN_WIDTH);
+        memset(screen->text[screen->top], 0, SCREEN_WIDTH);
+    }
+}
+
+static void screen_reset(screen_t* screen) {
+    memset(screen, 0, sizeof(*screen));
+    screen->row = 1;
+    screen->top = 1;
+    screen->bottom = SCREEN_ROWS;
+}
+
+static void screen_feed(screen_t* screen, const char* bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        char c = bytes[i];
+        if (c == '\033' && i + 1 < length && bytes[i + 1] == 'M') {
+            if (screen->row == screen->top) {
+                screen_scroll(screen, -1);
+            } else if (screen->row > 1) {
+                screen->row--;
+            }
+            i++;
+        } else if (c == '\033' && i + 1 < length && bytes[i + 1] == '[') {
+            int params[2] = {0, 0};
+            int count = 0;
+            i += 2;
+            while (i < length && ((bytes[i] >= '0' && bytes[i] <= '9') || bytes[i] == ';')) {
+                if (bytes[i] == ';') {
+                    count++;
+                } else if (count < 2) {
+                    params[count] = params[count] * 10 + (bytes[i] - '0');
+                }
+                i++;
+            }
+            char command = i < length ? bytes[i] : '\0';
+            if (command == 'J' && params[0] == 2) {
+                memset(screen->text, 0, sizeof(screen->text));
+            } else if (command == 'H') {
+                screen->row = params[0] > 0 ? params[0] : 1;
+                screen->column = params[1] > 0 ? params[1] - 1 : 0;
+            } else if (command == 'r') {
+                screen->top = params[0] > 0 ? params[0] : 1;
+                screen->bottom = params[1] > 0 ? params[1] : SCREEN_ROWS;
+                screen->row = 1;
+                screen->column = 0;
+            }
+        } else if (c == '\n') {
+            // Line feed with the carriage return a tty adds (onlcr)
+            if (screen->row == screen->bottom) {
+                screen_scroll(screen, 1);
+            } else if (screen->row < SCREEN_ROWS) {
+                screen->row++;
+            }
+            screen->column = 0;
+        } else if (screen->column < SCREEN_WIDTH - 1) {
+            screen->text[screen->row][screen->column++] = c;
+        }
+    }
+}
+
+static size_t row_for(const binary_clock_waterfall_t* waterfall, int64_t epoch, char* output) {
+    binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+    size_t length = binary_clock_display_render(&state, waterfall->format, output, BINARY_CLOCK_RENDER_MAX_SIZE);
+    output[length - 1] = '\0';  // Row text without its line end
+    return length - 1;
+}
+
+void test_sequences(void) {
+    printf("\n=== Testing Escape Sequences ===\n");
+
+    binary_clock_waterfall_t waterfall;
+    char output[BINARY_CLOCK_WATERFALL_TICK_SIZE];
+    ASSERT_EQ(binary_clock_waterfall_init(&waterfall, 20, BINARY_CLOCK_RENDER_EMOJI_LINE), BINARY_CLOCK_SUCCESS,
+              "waterfall initialized");
+    ASSERT_TRUE(waterfall.render == binary_clock_display_render_table, "rows rendered with the glyph tables");
+    ASSERT_STR_EQ(waterfall.prefix, "\033[3;1H\033M", "tick prefix: top row, reverse index");
+    ASSERT_EQ(waterfall.prefix_length, strlen("\033[3;1H\033M"), "prefix length recorded");
+
+    size_t length = binary_clock_waterfall_begin(&waterfall, output, sizeof(output));
+    output[length] = '\0';
+    ASSERT_STR_EQ(output, "\033[2J\033[H🌝 Binary Clock Waterfall 🌚 (newest first)\n\033[3;22r\033[3;1H",
+                  "setup clears, titles and sets rows 3-22 as the region");
+
+    length = binary_clock_waterfall_end(&waterfall, output, sizeof(output));
+    output[length] = '\0';
+    ASSERT_STR_EQ(output, "\033[r\033[23;1H", "teardown restores scrolling below the history");
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    length = binary_clock_waterfall_tick(&waterfall, &state, output, sizeof(output));
+    output[length] = '\0';
+    ASSERT_STR_EQ(output, "\033[3;1H\033M14:30:45 [🌚🌚🌝 🌚🌝🌚🌚 : 🌚🌝🌝 🌚🌚🌚🌚 : 🌝🌚🌚 🌚🌝🌚🌝]\n",
+                  "tick is the prefix and the emoji row");
+
+    binary_clock_waterfall_init(&waterfall, 20, BINARY_CLOCK_RENDER_COMPACT);
+    length = binary_clock_waterfall_tick(&waterfall, &state, output, sizeof(output));
+    output[length] = '\0';
+    ASSERT_STR_EQ(output, "\033[3;1H\033M14:30:45 [001 0100 : 011 0000 : 100 0101]\n",
+                  "tick is the prefix and the binary row");
+}
+
+void test_constant_ticks(void) {
+    printf("\n=== Testing Tick Size ===\n");
+
+    static const uint32_t histories[] = {BINARY_CLOCK_WATERFALL_MIN_ROWS, 20, 500, BINARY_CLOCK_WATERFALL_MAX_ROWS};
+    static const binary_clock_render_format_t formats[] = {BINARY_CLOCK_RENDER_EMOJI_LINE, BINARY_CLOCK_RENDER_COMPACT};
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        size_t first = 0;
+        bool constant = true;
+        bool matches = true;
+        for (size_t h = 0; h < sizeof(histories) / sizeof(histories[0]); h++) {
+            binary_clock_waterfall_t waterfall;
+            binary_clock_waterfall_init(&waterfall, histories[h], formats[f]);
+            // A day and a bit, through every hour and the midnight rollover
+            for (int64_t epoch = BASE_EPOCH; epoch < BASE_EPOCH + 90000; epoch += 7) {
+                binary_clock_state_t state = binary_clock_state_from_epoch(epoch, 0);
+                char output[BINARY_CLOCK_WATERFALL_TICK_SIZE];
+                char expected[BINARY_CLOCK_RENDER_MAX_SIZE];
+                size_t length = binary_clock_waterfall_tick(&waterfall, &state, output, sizeof(output));
+                size_t rendered = binary_clock_display_render(&state, formats[f], expected, sizeof(expected));
+                first = first == 0 ? length : first;
+                constant = constant && length == first;
+                matches = matches && length == waterfall.prefix_length + rendered &&
+                          memcmp(output + waterfall.prefix_length, expected, rendered) == 0;
+            }
+        }
+        ASSERT_TRUE(constant, formats[f] == BINARY_CLOCK_RENDER_COMPACT
+                                  ? "binary ticks are one size for every second and history length"
+                                  : "emoji ticks are one size for every second and history length");
+        ASSERT_TRUE(matches, "table rows match the bit-by-bit renderer");
+    }
+}
+
+void test_screen(void) {
+    printf("\n=== Testing Screen Contents ===\n");
+
+    screen_t screen;
+    binary_clock_waterfall_t waterfall;
+    char output[BINARY_CLOCK_WATERFALL_TICK_SIZE];
+    char expected[BINARY_CLOCK_RENDER_MAX_SIZE];
+    screen_reset(&screen);
+    screen_feed(&screen, "old", 3);
+    binary_clock_waterfall_init(&waterfall, 5, BINARY_CLOCK_RENDER_COMPACT);
+    size_t length = binary_clock_waterfall_begin(&waterfall, output, sizeof(output));
+    screen_feed(&screen, output, length);
+    ASSERT_TRUE(strstr(screen.text[1], "Binary Clock Waterfall") != NULL, "title on the first row");
+    ASSERT_EQ(screen.top, 3, "region starts on row 3");
+    ASSERT_EQ(screen.bottom, 7, "region ends after five rows");
+    ASSERT_EQ(screen.row, 3, "cursor at the top of the region");
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    length = binary_clock_waterfall_tick(&waterfall, &state, output, sizeof(output));
+    screen_feed(&screen, output, length);
+    row_for(&waterfall, BASE_EPOCH, expected);
+    ASSERT_STR_EQ(screen.text[3], expected, "first second on the top row");
+    ASSERT_EQ(screen.text[4][0], '\0', "rows below still empty");
+
+    for (int64_t epoch = BASE_EPOCH + 1; epoch < BASE_EPOCH + 8; epoch++) {
+        state = binary_clock_state_from_epoch(epoch, 0);
+        length = binary_clock_waterfall_tick(&waterfall, &state, output, sizeof(output));
+        screen_feed(&screen, output, length);
+    }
+    bool ordered = true;
+    for (int row = 3; row <= 7; row++) {
+        row_for(&waterfall, BASE_EPOCH + 7 - (row - 3), expected);
+        ordered = ordered && strcmp(screen.text[row], expected) == 0;
+    }
+    ASSERT_TRUE(ordered, "region holds the last five seconds, newest first");
+    ASSERT_EQ(screen.text[8][0], '\0', "oldest rows fall off the region, not onto the screen");
+    ASSERT_TRUE(strstr(screen.text[1], "Binary Clock Waterfall") != NULL, "title never scrolls");
+    ASSERT_EQ(screen.text[2][0], '\0', "blank row under the title kept");
+
+    length = binary_clock_waterfall_end(&waterfall, output, sizeof(output));
+    screen_feed(&screen, output, length);
+    screen_feed(&screen, "bye", 3);
+    ASSERT_EQ(screen.bottom, SCREEN_ROWS, "scrolling restored to the whole screen");
+    ASSERT_STR_EQ(screen.text[8], "bye", "output continues below the history");
+    row_for(&waterfall, BASE_EPOCH + 3, expected);
+    ASSERT_STR_EQ(screen.text[7], expected, "history left on screen");
+}
+
+void test_errors(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_waterfall_t waterfall;
+    char output[BINARY_CLOCK_WATERFALL_TICK_SIZE];
+    binary_clock_state_t state = binary_clock_state_from_epoch(BASE_EPOCH, 0);
+    ASSERT_EQ(binary_clock_waterfall_init(NULL, 20, BINARY_CLOCK_RENDER_COMPACT), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL waterfall rejected");
+    ASSERT_EQ(binary_clock_waterfall_init(&waterfall, 1, BINARY_CLOCK_RENDER_COMPACT), BINARY_CLOCK_ERROR_OUTPUT,
+              "one-row history rejected");
+    ASSERT_EQ(binary_clock_waterfall_init(&waterfall, BINARY_CLOCK_WATERFALL_MAX_ROWS + 1, BINARY_CLOCK_RENDER_COMPACT),
+              BINARY_CLOCK_ERROR_OUTPUT, "oversized history rejected");
+    ASSERT_EQ(binary_clock_waterfall_init(&waterfall, 20, BINARY_CLOCK_RENDER_EMOJI), BINARY_CLOCK_ERROR_OUTPUT,
+              "multi-line format rejected");
+    ASSERT_EQ(binary_clock_waterfall_init(&waterfall, 20, BINARY_CLOCK_RENDER_JSON_LINE), BINARY_CLOCK_ERROR_OUTPUT,
+              "JSON rejected");
+
+    binary_clock_waterfall_init(&waterfall, 20, BINARY_CLOCK_RENDER_COMPACT);
+    ASSERT_EQ(binary_clock_waterfall_tick(&waterfall, NULL, output, sizeof(output)), 0, "NULL state rejected");
+    ASSERT_EQ(binary_clock_waterfall_tick(&waterfall, &state, output, 20), 0, "small tick buffer rejected");
+    ASSERT_EQ(binary_clock_waterfall_tick(&waterfall, &state, output, 4), 0, "buffer under the prefix rejected");
+    ASSERT_EQ(binary_clock_waterfall_begin(&waterfall, output, 16), 0, "small setup buffer rejected");
+    ASSERT_EQ(binary_clock_waterfall_end(NULL, output, sizeof(output)), 0, "NULL teardown rejected");
+}
+
+int main(void) {
+    printf("=== Binary Clock Waterfall Test Suite ===\n");
+
+    test_sequences();
+    test_constant_ticks();
+    test_screen();
+    test_errors();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All waterfall tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
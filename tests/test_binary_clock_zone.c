@@ -0,0 +1,250 @@
+/**
+ * @file test_binary_clock_zone.c
+ * @brief Test suite for Binary Clock time zones
+ *
+ * Zone files are built in memory, so the results do not depend on the
+ * host's tz database: listed transitions, footer rules expanded for later
+ * years in both hemispheres, malformed files, fixed zones and names.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <binary_clock_zone.h>
+#include <binary_clock_mem.h>
+
+// Test counters
+static int tests_run = 0;
+static int tests_passed = 0;
+
+// Test utility macros
+#define ASSERT_EQ(actual, expected, message) \
+    do { \
+        tests_run++; \
+        if ((actual) == (expected)) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s (expected %lld, got %lld)\n", tests_run, message, (long long)(expected), (long long)(actual)); \
+        } \
+    } while(0)
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ Test %d passed: %s\n", tests_run, message); \
+        } else { \
+            printf("✗ Test %d failed: %s\n", tests_run, message); \
+        } \
+    } while(0)
+
+#define ZONE_FILE "test_binary_clock_zone.tzif"
+
+// 2020 transitions of Central European Time
+#define CEST_2020_START 1585443600LL  // 2020-03-29 01:00 UTC
+#define CEST_2020_END 1603587600LL    // 2020-10-25 01:00 UTC
+#define CEST_2024_START 1711846800LL  // 2024-03-31 01:00 UTC
+#define CEST_2024_END 1729990800LL    // 2024-10-27 01:00 UTC
+
+static size_t put_u32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)(value >> 24);
+    out[1] = (uint8_t)(value >> 16);
+    out[2] = (uint8_t)(value >> 8);
+    out[3] = (uint8_t)value;
+    return 4;
+}
+
+static size_t put_header(uint8_t* out, size_t times, size_t types) {
+    memset(out, 0, 44);
+    memcpy(out, "TZif2", 5);
+    put_u32(out + 32, (uint32_t)times);
+    put_u32(out + 36, (uint32_t)types);
+    put_u32(out + 40, 4);
+    return 44;
+}
+
+// Version 2 file: a minimal version 1 block, then the 64-bit data and footer
+static size_t build_tzif(uint8_t* out, const int64_t* times, const uint8_t* indices, size_t count,
+                         const int32_t* offsets, size_t types, const char* footer) {
+    size_t length = put_header(out, 0, 1);
+    length += put_u32(out + length, 0);
+    out[length++] = 0;
+    out[length++] = 0;
+    memcpy(out + length, "UTC", 4);
+    length += 4;
+
+    length += put_header(out + length, count, types);
+    for (size_t i = 0; i < count; i++) {
+        length += put_u32(out + length, (uint32_t)((uint64_t)times[i] >> 32));
+        length += put_u32(out + length, (uint32_t)times[i]);
+    }
+    if (count > 0) {
+        memcpy(out + length, indices, count);
+    }
+    length += count;
+    for (size_t i = 0; i < types; i++) {
+        length += put_u32(out + length, (uint32_t)offsets[i]);
+        out[length++] = 0;
+        out[length++] = 0;
+    }
+    memcpy(out + length, "ABC", 4);
+    length += 4;
+    length += (size_t)sprintf((char*)out + length, "\n%s\n", footer);
+    return length;
+}
+
+void test_transitions(void) {
+    printf("\n=== Testing Transitions and Footer Rules ===\n");
+
+    const int64_t times[2] = {CEST_2020_START, CEST_2020_END};
+    const uint8_t indices[2] = {1, 0};
+    const int32_t offsets[2] = {3600, 7200};
+    uint8_t data[512];
+    size_t length = build_tzif(data, times, indices, 2, offsets, 2, "CET-1CEST,M3.5.0,M10.5.0/3");
+
+    binary_clock_mem_reset();
+    binary_clock_zone_t zone;
+    ASSERT_EQ(binary_clock_zone_parse(&zone, "Europe/Test", data, length), BINARY_CLOCK_SUCCESS, "zone file parsed");
+    ASSERT_TRUE(strcmp(zone.name, "Europe/Test") == 0, "zone named");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 0), 3600, "first type holds before the first transition");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2020_START - 1), 3600, "standard time just before");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2020_START), 7200, "daylight time from the transition");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2020_END), 3600, "standard time again");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2024_START - 1), 3600, "footer rule: before the 2024 change");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2024_START), 7200, "footer rule: last Sunday of March");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2024_END - 1), 7200, "footer rule: end is at 03:00 local");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2024_END), 3600, "footer rule: last Sunday of October");
+    ASSERT_EQ(zone.count, 2 + 2 * (BINARY_CLOCK_ZONE_LAST_YEAR - 2020), "two changes a year through the last year");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 4118000000LL), 3600, "last offset holds after the last year");
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_TABLES).used, binary_clock_zone_memory(&zone),
+              "table charged to the tables");
+    binary_clock_zone_free(&zone);
+    ASSERT_EQ(binary_clock_mem_get_usage(BINARY_CLOCK_MEM_TABLES).used, 0, "table released on free");
+
+    // Southern hemisphere: daylight time spans the new year
+    const int32_t sydney[1] = {36000};
+    length = build_tzif(data, NULL, NULL, 0, sydney, 1, "AEST-10AEDT,M10.1.0,M4.1.0/3");
+    binary_clock_zone_parse(&zone, "Australia/Test", data, length);
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1705276800LL), 39600, "January is daylight time");   // 2024-01-15
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1719792000LL), 36000, "July is standard time");      // 2024-07-01
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1712419199LL), 39600, "daylight time until 03:00"); // 2024-04-06 15:59:59 UTC
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1712419200LL), 36000, "first Sunday of April");
+    binary_clock_zone_free(&zone);
+
+    // Angle-bracket names, a fixed footer and a Julian-day rule
+    const int32_t fixed[1] = {-10800};
+    length = build_tzif(data, NULL, NULL, 0, fixed, 1, "<-03>3");
+    binary_clock_zone_parse(&zone, "America/Test", data, length);
+    ASSERT_TRUE(zone.count == 0 && binary_clock_zone_offset(&zone, 1700000000LL) == -10800,
+                "footer without daylight time adds nothing");
+    binary_clock_zone_free(&zone);
+    const int32_t julian[1] = {0};
+    length = build_tzif(data, NULL, NULL, 0, julian, 1, "XXX0YYY,J60/0,J300/0");
+    binary_clock_zone_parse(&zone, "Etc/Test", data, length);
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1709251200LL), 3600, "J60 is March 1 even in leap years"); // 2024-03-01
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1709251199LL), 0, "before J60");
+    binary_clock_zone_free(&zone);
+}
+
+void test_malformed(void) {
+    printf("\n=== Testing Malformed Files ===\n");
+
+    const int64_t times[2] = {CEST_2020_START, CEST_2020_END};
+    const uint8_t indices[2] = {1, 0};
+    const int32_t offsets[2] = {3600, 7200};
+    uint8_t data[512];
+    size_t length = build_tzif(data, times, indices, 2, offsets, 2, "CET-1CEST,M3.5.0,M10.5.0/3");
+    binary_clock_zone_t zone;
+
+    ASSERT_EQ(binary_clock_zone_parse(&zone, "x", data, 60), BINARY_CLOCK_ERROR_OUTPUT, "truncated file rejected");
+    data[0] = 'X';
+    ASSERT_EQ(binary_clock_zone_parse(&zone, "x", data, length), BINARY_CLOCK_ERROR_OUTPUT, "bad magic rejected");
+    data[0] = 'T';
+
+    size_t index_at = 44 + 4 + 2 + 4 + 44 + 16;
+    data[index_at] = 5;
+    ASSERT_EQ(binary_clock_zone_parse(&zone, "x", data, length), BINARY_CLOCK_ERROR_OUTPUT,
+              "type index out of range rejected");
+    ASSERT_EQ(zone.transitions, NULL, "nothing kept on error");
+    data[index_at] = 1;
+
+    length = build_tzif(data, times, indices, 2, offsets, 2, "CET-1CEST,M13.5.0,M10.5.0");
+    ASSERT_EQ(binary_clock_zone_parse(&zone, "x", data, length), BINARY_CLOCK_SUCCESS,
+              "unusable footer ignored");
+    ASSERT_EQ(zone.count, 2, "only the listed transitions kept");
+    binary_clock_zone_free(&zone);
+}
+
+void test_load(void) {
+    printf("\n=== Testing Loading by Name ===\n");
+
+    binary_clock_zone_t zone;
+    ASSERT_EQ(binary_clock_zone_load(&zone, "UTC", NULL), BINARY_CLOCK_SUCCESS, "UTC needs no file");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1700000000LL), 0, "UTC offset");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "+05:30", NULL), BINARY_CLOCK_SUCCESS, "fixed offset loaded");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 1700000000LL), 19800, "fixed offsets count east positive");
+    binary_clock_zone_load(&zone, "-08", NULL);
+    ASSERT_EQ(binary_clock_zone_offset(&zone, 0), -28800, "hours-only offset");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "+5", NULL), BINARY_CLOCK_ERROR_INVALID_TIME, "one-digit hour rejected");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "+24:00", NULL), BINARY_CLOCK_ERROR_INVALID_TIME, "hour 24 rejected");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "../etc/passwd", "."), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "path outside the directory rejected");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "/etc/passwd", "."), BINARY_CLOCK_ERROR_INVALID_TIME,
+              "absolute path rejected");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "No/Such_Zone", "."), BINARY_CLOCK_ERROR_SYSTEM_TIME,
+              "missing file reported");
+
+    const int64_t times[2] = {CEST_2020_START, CEST_2020_END};
+    const uint8_t indices[2] = {1, 0};
+    const int32_t offsets[2] = {3600, 7200};
+    uint8_t data[512];
+    size_t length = build_tzif(data, times, indices, 2, offsets, 2, "CET-1CEST,M3.5.0,M10.5.0/3");
+    FILE* file = fopen(ZONE_FILE, "wb");
+    if (file != NULL) {
+        fwrite(data, 1, length, file);
+        fclose(file);
+    }
+    ASSERT_EQ(binary_clock_zone_load(&zone, ZONE_FILE, "."), BINARY_CLOCK_SUCCESS, "zone file read from a directory");
+    ASSERT_EQ(binary_clock_zone_offset(&zone, CEST_2024_START), 7200, "file zone offsets");
+    binary_clock_zone_free(&zone);
+    remove(ZONE_FILE);
+}
+
+void test_error_handling(void) {
+    printf("\n=== Testing Error Handling ===\n");
+
+    binary_clock_zone_t zone;
+    uint8_t data[4] = {0};
+    ASSERT_EQ(binary_clock_zone_parse(NULL, "x", data, sizeof(data)), BINARY_CLOCK_ERROR_NULL_POINTER,
+              "NULL zone rejected");
+    ASSERT_EQ(binary_clock_zone_load(&zone, NULL, NULL), BINARY_CLOCK_ERROR_NULL_POINTER, "NULL name rejected");
+    ASSERT_EQ(binary_clock_zone_load(&zone, "", NULL), BINARY_CLOCK_ERROR_INVALID_TIME, "empty name rejected");
+    ASSERT_EQ(binary_clock_zone_offset(NULL, 0), 0, "NULL zone has no offset");
+    ASSERT_EQ(binary_clock_zone_memory(NULL), 0, "NULL zone holds no memory");
+    binary_clock_zone_free(NULL);
+}
+
+int main(void) {
+    printf("=== Binary Clock Time Zone Test Suite ===\n");
+
+    test_transitions();
+    test_malformed();
+    test_load();
+    test_error_handling();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Tests run: %d\n", tests_run);
+    printf("Tests passed: %d\n", tests_passed);
+    printf("Tests failed: %d\n", tests_run - tests_passed);
+    printf("Success rate: %.1f%%\n", tests_run > 0 ? (100.0 * tests_passed / tests_run) : 0.0);
+
+    if (tests_passed == tests_run) {
+        printf("🎉 All time zone tests passed!\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed\n");
+        return 1;
+    }
+}
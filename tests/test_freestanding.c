@@ -0,0 +1,144 @@
+/**
+ * @file test_freestanding.c
+ * @brief Freestanding build test for the Binary Clock core API
+ *
+ * Built with -ffreestanding -nostdlib and BINARY_CLOCK_FREESTANDING, so it
+ * links only against the core API and libgcc. Any accidental dependency on
+ * libc (time(), memset(), printf(), ...) fails the link. Output and exit
+ * use raw Linux system calls (x86_64 and aarch64).
+ */
+
+#include <binary_clock_api.h>
+
+#if !defined(__linux__) || !(defined(__x86_64__) || defined(__aarch64__))
+#error "Freestanding test supports Linux on x86_64 and aarch64 only"
+#endif
+
+/* ========================================================================== */
+/* MINIMAL RUNTIME                                                            */
+/* ========================================================================== */
+
+static long sys_call3(long number, long arg1, long arg2, long arg3) {
+    long result;
+#if defined(__x86_64__)
+    __asm__ volatile ("syscall"
+                      : "=a"(result)
+                      : "a"(number), "D"(arg1), "S"(arg2), "d"(arg3)
+                      : "rcx", "r11", "memory");
+#else
+    register long x8 __asm__("x8") = number;
+    register long x0 __asm__("x0") = arg1;
+    register long x1 __asm__("x1") = arg2;
+    register long x2 __asm__("x2") = arg3;
+    __asm__ volatile ("svc 0" : "+r"(x0) : "r"(x8), "r"(x1), "r"(x2) : "memory");
+    result = x0;
+#endif
+    return result;
+}
+
+#if defined(__x86_64__)
+#define SYS_WRITE 1
+#define SYS_EXIT 60
+__asm__(".globl _start\n"
+        "_start:\n"
+        "    xor %rbp, %rbp\n"
+        "    and $-16, %rsp\n"
+        "    call freestanding_main\n"
+        "    hlt\n");
+#else
+#define SYS_WRITE 64
+#define SYS_EXIT 93
+__asm__(".globl _start\n"
+        "_start:\n"
+        "    mov x29, #0\n"
+        "    bl freestanding_main\n"
+        "    b .\n");
+#endif
+
+static void put_string(const char* str) {
+    size_t length = 0;
+    while (str[length] != '\0') {
+        length++;
+    }
+    sys_call3(SYS_WRITE, 1, (long)str, (long)length);
+}
+
+static void put_number(long value) {
+    char buffer[24];
+    int pos = (int)sizeof(buffer);
+    buffer[--pos] = '\0';
+    do {
+        buffer[--pos] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0 && pos > 0);
+    put_string(buffer + pos);
+}
+
+/* ========================================================================== */
+/* TESTS                                                                      */
+/* ========================================================================== */
+
+static int tests_run = 0;
+static int tests_passed = 0;
+
+#define ASSERT_TRUE(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            put_string("✓ Test "); put_number(tests_run); put_string(" passed: " message "\n"); \
+        } else { \
+            put_string("✗ Test "); put_number(tests_run); put_string(" failed: " message "\n"); \
+        } \
+    } while(0)
+
+static void test_epoch_conversion(void) {
+    put_string("\n=== Testing Epoch Conversion (freestanding) ===\n");
+
+    binary_clock_state_t state = binary_clock_state_from_epoch(1700000000, 0);
+    ASSERT_TRUE(state.timestamp == 1700000000, "timestamp taken from caller");
+    ASSERT_TRUE(binary_clock_pack_state(&state) == 0x221320, "22:13:20 packs to 0x221320");
+    ASSERT_TRUE(state.hours_tens.bit_count == 3 && state.seconds_units.bit_count == 4, "bit counts set");
+}
+
+static void test_incremental_path(void) {
+    put_string("\n=== Testing Packed Incremental Path (freestanding) ===\n");
+
+    // Walk a full day plus one second from midnight by ticks alone
+    uint32_t packed = 0;
+    int mismatches = 0;
+    for (int64_t second = 1; second <= 86400; second++) {
+        packed = binary_clock_packed_next_second(packed);
+        binary_clock_state_t expected = binary_clock_state_from_epoch(second, 0);
+        if (packed != binary_clock_pack_state(&expected)) {
+            mismatches++;
+        }
+    }
+    ASSERT_TRUE(mismatches == 0, "ticks match epoch conversion for a whole day");
+    ASSERT_TRUE(packed == 0, "day wraps back to 00:00:00");
+
+    binary_clock_state_t state = binary_clock_state_from_packed(0x143045, 42);
+    ASSERT_TRUE(state.timestamp == 42 && state.minutes_tens.decimal_value == 3, "state from packed");
+    state = binary_clock_state_from_packed(0x240000, 42);
+    ASSERT_TRUE(state.timestamp == 0, "invalid packed hours rejected");
+}
+
+void freestanding_main(void);
+
+void freestanding_main(void) {
+    put_string("=== Binary Clock Freestanding Test Suite ===\n");
+    put_string("Core API version ");
+    put_string(binary_clock_get_version());
+    put_string("\n");
+
+    test_epoch_conversion();
+    test_incremental_path();
+
+    put_string("\n=== Test Summary ===\nTests run: ");
+    put_number(tests_run);
+    put_string("\nTests passed: ");
+    put_number(tests_passed);
+    put_string("\n");
+
+    sys_call3(SYS_EXIT, tests_passed == tests_run ? 0 : 1, 0, 0);
+}